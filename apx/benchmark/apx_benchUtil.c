@@ -0,0 +1,111 @@
+/*****************************************************************************
+* \file      apx_benchUtil.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Timing and reporting helpers for APX benchmarks
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "apx_benchUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns monotonic time in nanoseconds
+ */
+uint64_t apx_benchUtil_timestamp(void)
+{
+#ifdef _WIN32
+   LARGE_INTEGER frequency;
+   LARGE_INTEGER counter;
+   QueryPerformanceFrequency(&frequency);
+   QueryPerformanceCounter(&counter);
+   return (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0) / (double) frequency.QuadPart);
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ( (uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+/**
+ * Returns number of heap bytes currently allocated by the process. Returns 0 on platforms where this is unknown.
+ */
+size_t apx_benchUtil_heapInUse(void)
+{
+#if defined(__GLIBC__) && ( (__GLIBC__ > 2) || ( (__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33) ) )
+   struct mallinfo2 info = mallinfo2();
+   return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+   struct mallinfo info = mallinfo();
+   return (size_t) (unsigned int) info.uordblks + (size_t) (unsigned int) info.hblkhd;
+#else
+   return 0u;
+#endif
+}
+
+void apx_benchTimer_start(apx_benchTimer_t *self)
+{
+   if (self != 0)
+   {
+      self->elapsedTime = 0u;
+      self->startTime = apx_benchUtil_timestamp();
+   }
+}
+
+uint64_t apx_benchTimer_stop(apx_benchTimer_t *self)
+{
+   if (self != 0)
+   {
+      self->elapsedTime = apx_benchUtil_timestamp() - self->startTime;
+      return self->elapsedTime;
+   }
+   return 0u;
+}
+
+void apx_benchUtil_printHeader(const char *benchName)
+{
+   printf("\n== %s ==\n", benchName);
+}
+
+void apx_benchUtil_printResult(const char *caseName, uint32_t numIterations, uint64_t elapsedTime)
+{
+   double nsPerIteration = (numIterations > 0u)? ( (double) elapsedTime / (double) numIterations) : 0.0;
+   printf("  %-40s %10u iterations %12.1f ns/iteration\n", caseName, (unsigned int) numIterations, nsPerIteration);
+}
+
+void apx_benchUtil_printValue(const char *caseName, const char *valueName, double value)
+{
+   printf("  %-40s %12.2f %s\n", caseName, value, valueName);
+}
@@ -0,0 +1,55 @@
+/*****************************************************************************
+* \file      apx_benchUtil.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Timing and reporting helpers for APX benchmarks
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_BENCH_UTIL_H
+#define APX_BENCH_UTIL_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef struct apx_benchTimer_tag
+{
+   uint64_t startTime; //nanoseconds
+   uint64_t elapsedTime; //nanoseconds
+} apx_benchTimer_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+uint64_t apx_benchUtil_timestamp(void);
+size_t apx_benchUtil_heapInUse(void);
+void apx_benchTimer_start(apx_benchTimer_t *self);
+uint64_t apx_benchTimer_stop(apx_benchTimer_t *self);
+void apx_benchUtil_printHeader(const char *benchName);
+void apx_benchUtil_printResult(const char *caseName, uint32_t numIterations, uint64_t elapsedTime);
+void apx_benchUtil_printValue(const char *caseName, const char *valueName, double value);
+
+#endif //APX_BENCH_UTIL_H
@@ -0,0 +1,156 @@
+/*****************************************************************************
+* \file      bench_apx_bytePortMap.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Compares lookup latency and memory usage of the apx_bytePortMap representations
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_bytePortMap.h"
+#include "apx_benchUtil.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_ITERATIONS 1000000u
+#define NUM_OFFSETS 4096u //must be power of two
+
+typedef struct bench_nodeShape_tag
+{
+   const char *name;
+   apx_portCount_t numPorts;
+   apx_size_t minDataSize;
+   apx_size_t maxDataSize;
+} bench_nodeShape_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_portDataProps_t *createPropsArray(const bench_nodeShape_t *shape);
+static void bench_lookup(const char *shapeName, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType);
+static uint32_t nextRandom(uint32_t *state);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const bench_nodeShape_t m_nodeShapes[] = {
+   {"small node", 32, 1u, 8u},
+   {"signal node", 2000, 1u, 16u},
+   {"large node", 20000, 1u, 32u},
+   {"array node", 64, 512u, 4096u},
+};
+static const char *m_typeNames[] = {"auto", "dense", "interval", "paged"};
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_bytePortMap(void)
+{
+   size_t i;
+   apx_benchUtil_printHeader("bytePortMap (random offset lookup)");
+   for (i = 0u; i < sizeof(m_nodeShapes)/sizeof(m_nodeShapes[0]); i++)
+   {
+      apx_portDataProps_t *props = createPropsArray(&m_nodeShapes[i]);
+      apx_portCount_t numPorts = m_nodeShapes[i].numPorts;
+      bench_lookup(m_nodeShapes[i].name, props, numPorts, APX_BYTE_PORT_MAP_DENSE);
+      bench_lookup(m_nodeShapes[i].name, props, numPorts, APX_BYTE_PORT_MAP_INTERVAL);
+      bench_lookup(m_nodeShapes[i].name, props, numPorts, APX_BYTE_PORT_MAP_PAGED);
+      bench_lookup(m_nodeShapes[i].name, props, numPorts, APX_BYTE_PORT_MAP_AUTO);
+      free(props);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+static apx_portDataProps_t *createPropsArray(const bench_nodeShape_t *shape)
+{
+   apx_portDataProps_t *props = (apx_portDataProps_t*) malloc(shape->numPorts * sizeof(apx_portDataProps_t));
+   uint32_t state = 1u;
+   apx_offset_t offset = 0;
+   apx_portId_t portId;
+   assert(props != 0);
+   for (portId = 0; portId < shape->numPorts; portId++)
+   {
+      apx_size_t dataSize = shape->minDataSize + (nextRandom(&state) % (shape->maxDataSize - shape->minDataSize + 1u));
+      apx_portDataProps_create(&props[portId], APX_REQUIRE_PORT, portId, offset, dataSize);
+      offset += (apx_offset_t) dataSize;
+   }
+   return props;
+}
+
+static void bench_lookup(const char *shapeName, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType)
+{
+   apx_bytePortMap_t bytePortMap;
+   apx_benchTimer_t timer;
+   int32_t *offsets;
+   uint32_t state = 12345u;
+   uint32_t i;
+   int32_t checksum = 0;
+   char caseName[64];
+   if (apx_bytePortMap_createWithType(&bytePortMap, props, numPorts, mapType) != APX_NO_ERROR)
+   {
+      printf("%s: failed to create map\n", shapeName);
+      return;
+   }
+   sprintf(caseName, "%s, %s", shapeName, m_typeNames[apx_bytePortMap_getType(&bytePortMap)]);
+   if (mapType == APX_BYTE_PORT_MAP_AUTO)
+   {
+      strcat(caseName, " (auto)");
+   }
+   offsets = (int32_t*) malloc(NUM_OFFSETS * sizeof(int32_t));
+   assert(offsets != 0);
+   for (i = 0u; i < NUM_OFFSETS; i++)
+   {
+      offsets[i] = (int32_t) (nextRandom(&state) % apx_bytePortMap_length(&bytePortMap));
+   }
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      checksum += apx_bytePortMap_lookup(&bytePortMap, offsets[i & (NUM_OFFSETS - 1u)]);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult(caseName, i, timer.elapsedTime);
+   apx_benchUtil_printValue(caseName, "bytes", (double) apx_bytePortMap_getMemoryUsage(&bytePortMap));
+   if (checksum < 0)
+   {
+      printf("%s: unexpected lookup result\n", caseName);
+   }
+   free(offsets);
+   apx_bytePortMap_destroy(&bytePortMap);
+}
+
+static uint32_t nextRandom(uint32_t *state)
+{
+   *state = (*state * 1103515245u) + 12345u;
+   return (*state >> 8);
+}
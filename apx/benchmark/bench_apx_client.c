@@ -0,0 +1,202 @@
+/*****************************************************************************
+* \file      bench_apx_client.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Compares typed client write entry points against the dtl_dv_t based write path
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <assert.h>
+#include "apx_client.h"
+#include "apx_benchUtil.h"
+#include "dtl_type.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_ITERATIONS 1000000u
+#define ARRAY_LEN 8u
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_client_t *clientFixture_create(void **scalarHandle, void **arrayHandle);
+static void bench_writeScalar_dtl(void);
+static void bench_writeScalar_codec(void);
+static void bench_writeScalar_typed(void);
+static void bench_writeArray_dtl(void);
+static void bench_writeArray_typed(void);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const char *m_apx_definition1 = "APX/1.2\n"
+      "N\"TestNode1\"\n"
+      "P\"VehicleSpeed\"S:=65535\n"
+      "P\"WheelSpeeds\"L[8]:={0, 0, 0, 0, 0, 0, 0, 0}\n"
+      "\n";
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_client(void)
+{
+   apx_benchUtil_printHeader("client (provide-port write without connection)");
+   bench_writeScalar_dtl();
+   bench_writeScalar_codec();
+   bench_writeScalar_typed();
+   bench_writeArray_dtl();
+   bench_writeArray_typed();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static apx_client_t *clientFixture_create(void **scalarHandle, void **arrayHandle)
+{
+   apx_error_t rc;
+   apx_client_t *client = apx_client_new();
+   assert(client != 0);
+   rc = apx_client_buildNode_cstr(client, m_apx_definition1);
+   assert(rc == APX_NO_ERROR);
+   (void) rc;
+   *scalarHandle = apx_client_getPortHandle(client, NULL, "VehicleSpeed");
+   *arrayHandle = apx_client_getPortHandle(client, NULL, "WheelSpeeds");
+   assert( (*scalarHandle != 0) && (*arrayHandle != 0) );
+   return client;
+}
+
+static void bench_writeScalar_dtl(void)
+{
+   void *scalarHandle;
+   void *arrayHandle;
+   apx_benchTimer_t timer;
+   uint32_t i;
+   apx_client_t *client = clientFixture_create(&scalarHandle, &arrayHandle);
+   dtl_sv_t *sv = dtl_sv_new();
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      dtl_sv_set_u32(sv, i & 0xFFFFu);
+      apx_client_writePortData(client, scalarHandle, (dtl_dv_t*) sv);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult("u16 dtl_dv_t", NUM_ITERATIONS, timer.elapsedTime);
+   dtl_dec_ref((dtl_dv_t*) sv);
+   apx_client_delete(client);
+}
+
+static void bench_writeScalar_codec(void)
+{
+   void *scalarHandle;
+   void *arrayHandle;
+   apx_benchTimer_t timer;
+   uint32_t i;
+   apx_client_t *client = clientFixture_create(&scalarHandle, &arrayHandle);
+   apx_portCodec_t *codec = apx_client_createPortCodec(client, scalarHandle, NULL);
+   dtl_sv_t *sv = dtl_sv_new();
+   assert(codec != 0);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      dtl_sv_set_u32(sv, i & 0xFFFFu);
+      apx_portCodec_write(codec, (dtl_dv_t*) sv);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult("u16 dtl_dv_t (port codec)", NUM_ITERATIONS, timer.elapsedTime);
+   dtl_dec_ref((dtl_dv_t*) sv);
+   apx_portCodec_delete(codec);
+   apx_client_delete(client);
+}
+
+static void bench_writeScalar_typed(void)
+{
+   void *scalarHandle;
+   void *arrayHandle;
+   apx_benchTimer_t timer;
+   uint32_t i;
+   apx_client_t *client = clientFixture_create(&scalarHandle, &arrayHandle);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      apx_client_writePortData_u16(client, scalarHandle, (uint16_t) i);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult("u16 typed", NUM_ITERATIONS, timer.elapsedTime);
+   apx_client_delete(client);
+}
+
+static void bench_writeArray_dtl(void)
+{
+   void *scalarHandle;
+   void *arrayHandle;
+   apx_benchTimer_t timer;
+   uint32_t i;
+   uint32_t j;
+   apx_client_t *client = clientFixture_create(&scalarHandle, &arrayHandle);
+   dtl_av_t *av = dtl_av_new();
+   for (j = 0u; j < ARRAY_LEN; j++)
+   {
+      dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_u32(0u), false);
+   }
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      for (j = 0u; j < ARRAY_LEN; j++)
+      {
+         dtl_sv_set_u32((dtl_sv_t*) dtl_av_value(av, (int32_t) j), i + j);
+      }
+      apx_client_writePortData(client, arrayHandle, (dtl_dv_t*) av);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult("u32[8] dtl_dv_t", NUM_ITERATIONS, timer.elapsedTime);
+   dtl_dec_ref((dtl_dv_t*) av);
+   apx_client_delete(client);
+}
+
+static void bench_writeArray_typed(void)
+{
+   void *scalarHandle;
+   void *arrayHandle;
+   apx_benchTimer_t timer;
+   uint32_t values[ARRAY_LEN];
+   uint32_t i;
+   uint32_t j;
+   apx_client_t *client = clientFixture_create(&scalarHandle, &arrayHandle);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      for (j = 0u; j < ARRAY_LEN; j++)
+      {
+         values[j] = i + j;
+      }
+      apx_client_writePortData_u32_array(client, arrayHandle, &values[0], ARRAY_LEN);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult("u32[8] typed", NUM_ITERATIONS, timer.elapsedTime);
+   apx_client_delete(client);
+}
@@ -0,0 +1,311 @@
+/*****************************************************************************
+* \file      bench_apx_dataPlane.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Benchmark for routing throughput of several clients over a multi-threaded server data plane
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_server.h"
+#include "apx_serverTestConnection.h"
+#include "apx_dataPlane.h"
+#include "apx_fileManager.h"
+#include "apx_benchUtil.h"
+#include "numheader.h"
+#include "osmacro.h"
+#include "rmf.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_CLIENT_PAIRS 4u
+#define NUM_WRITES_PER_CLIENT 100000u
+#define DEFINITION_BUF_SIZE 256u
+#define SCRATCH_BUF_SIZE 1024u
+
+/**
+ * Replaces the transmit handler of a receiver connection, counts messages instead of logging them
+ */
+typedef struct msgCounter_tag
+{
+   volatile uint32_t numMessages; //written by the lane running the receiver connection only
+   uint8_t scratch[SCRATCH_BUF_SIZE];
+} msgCounter_t;
+
+typedef struct dataPlaneClient_tag
+{
+   apx_serverTestConnection_t *providerConnection;
+   apx_serverTestConnection_t *receiverConnection;
+   msgCounter_t counter;
+} dataPlaneClient_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void bench_routeOverDataPlane(const char *caseName, int32_t numLanes);
+static apx_serverTestConnection_t *dataPlaneFixture_connect(apx_server_t *server);
+static void dataPlaneFixture_attachNode(apx_server_t *server, apx_serverTestConnection_t *connection, const char *nodeName, const char *definition, apx_size_t outPortDataLen);
+static void dataPlaneFixture_drain(apx_server_t *server, apx_serverTestConnection_t *connection);
+static void dataPlaneFixture_installCounter(apx_serverTestConnection_t *connection, msgCounter_t *counter);
+static uint8_t *msgCounter_getSendBuffer(void *arg, int32_t msgLen);
+static int32_t msgCounter_send(void *arg, int32_t offset, int32_t msgLen);
+static int32_t msgCounter_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
+static THREAD_PROTO(providerTask, arg);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_dataPlane(void)
+{
+   apx_benchUtil_printHeader("data plane (4 provider/receiver client pairs writing concurrently)");
+   bench_routeOverDataPlane("1 lane", 1);
+   bench_routeOverDataPlane("2 lanes", 2);
+   bench_routeOverDataPlane("4 lanes", 4);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Each client pair has its own signal. One thread per provider writes to the provider connection (like the socket
+ * thread of that client would), the lanes of the data plane transmit the routed data on the receiver connections.
+ * The timer stops when every receiver has transmitted all of its messages.
+ */
+static void bench_routeOverDataPlane(const char *caseName, int32_t numLanes)
+{
+   apx_server_t *server;
+   dataPlaneClient_t *clients;
+   THREAD_T threads[NUM_CLIENT_PAIRS];
+#ifdef _WIN32
+   unsigned int threadIds[NUM_CLIENT_PAIRS];
+#endif
+   apx_benchTimer_t timer;
+   uint32_t numMessages = NUM_CLIENT_PAIRS * NUM_WRITES_PER_CLIENT;
+   uint32_t i;
+
+   server = apx_server_new();
+   assert(server != 0);
+   apx_server_setDataPlaneConfig(server, numLanes, true);
+   clients = (dataPlaneClient_t*) malloc(NUM_CLIENT_PAIRS * sizeof(dataPlaneClient_t));
+   assert(clients != 0);
+   //Receivers connect first so that they are spread evenly over the lanes
+   for (i = 0u; i < NUM_CLIENT_PAIRS; i++)
+   {
+      clients[i].receiverConnection = dataPlaneFixture_connect(server);
+   }
+   for (i = 0u; i < NUM_CLIENT_PAIRS; i++)
+   {
+      clients[i].providerConnection = dataPlaneFixture_connect(server);
+   }
+   for (i = 0u; i < NUM_CLIENT_PAIRS; i++)
+   {
+      char nodeName[RMF_MAX_FILE_NAME+1];
+      char definition[DEFINITION_BUF_SIZE];
+      sprintf(nodeName, "Receiver%u", (unsigned int) i);
+      sprintf(definition, "APX/1.2\nN\"%s\"\nR\"Signal%u\"S:=65535\n", nodeName, (unsigned int) i);
+      dataPlaneFixture_attachNode(server, clients[i].receiverConnection, nodeName, definition, 0u);
+      apx_serverTestConnection_onFileOpenMsgReceived(clients[i].receiverConnection, APX_ADDRESS_PORT_DATA_START);
+      dataPlaneFixture_drain(server, clients[i].receiverConnection);
+      sprintf(nodeName, "Provider%u", (unsigned int) i);
+      sprintf(definition, "APX/1.2\nN\"%s\"\nP\"Signal%u\"S:=65535\n", nodeName, (unsigned int) i);
+      dataPlaneFixture_attachNode(server, clients[i].providerConnection, nodeName, definition, UINT16_SIZE);
+      dataPlaneFixture_drain(server, clients[i].providerConnection);
+      dataPlaneFixture_drain(server, clients[i].receiverConnection);
+      dataPlaneFixture_installCounter(clients[i].receiverConnection, &clients[i].counter);
+   }
+
+   apx_benchTimer_start(&timer);
+   apx_dataPlane_start(server->dataPlane);
+   for (i = 0u; i < NUM_CLIENT_PAIRS; i++)
+   {
+#ifdef _WIN32
+      THREAD_CREATE(threads[i], providerTask, (void*) &clients[i], threadIds[i]);
+#else
+      THREAD_CREATE(threads[i], providerTask, (void*) &clients[i]);
+#endif
+   }
+   for (i = 0u; i < NUM_CLIENT_PAIRS; i++)
+   {
+#ifdef _WIN32
+      WaitForSingleObject(threads[i], INFINITE);
+      CloseHandle(threads[i]);
+#else
+      pthread_join(threads[i], (void**) 0);
+#endif
+   }
+   for (i = 0u; i < NUM_CLIENT_PAIRS; i++)
+   {
+      while (clients[i].counter.numMessages < NUM_WRITES_PER_CLIENT)
+      {
+         SLEEP(0);
+      }
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult(caseName, numMessages, timer.elapsedTime);
+   apx_benchUtil_printValue(caseName, "msgs/s", ((double) numMessages * 1E9) / (double) timer.elapsedTime);
+   apx_server_delete(server);
+   free(clients);
+}
+
+static apx_serverTestConnection_t *dataPlaneFixture_connect(apx_server_t *server)
+{
+   apx_serverTestConnection_t *connection = apx_serverTestConnection_new();
+   assert(connection != 0);
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection);
+   apx_serverTestConnection_onProtocolHeaderReceived(connection);
+   dataPlaneFixture_drain(server, connection);
+   return connection;
+}
+
+/**
+ * Performs the client side of the handshake for a node: file info messages followed by the definition (and provide port data when outPortDataLen > 0)
+ */
+static void dataPlaneFixture_attachNode(apx_server_t *server, apx_serverTestConnection_t *connection, const char *nodeName, const char *definition, apx_size_t outPortDataLen)
+{
+   char fileName[RMF_MAX_FILE_NAME+1];
+   rmf_fileInfo_t fileInfo;
+   uint8_t *buffer;
+   apx_size_t definitionLen = (apx_size_t) strlen(definition);
+   sprintf(fileName, "%s.apx", nodeName);
+   rmf_fileInfo_create(&fileInfo, fileName, APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   if (outPortDataLen > 0u)
+   {
+      sprintf(fileName, "%s.out", nodeName);
+      rmf_fileInfo_create(&fileInfo, fileName, APX_ADDRESS_PORT_DATA_START, outPortDataLen, RMF_FILE_TYPE_FIXED);
+      apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   }
+   dataPlaneFixture_drain(server, connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false);
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], definition, definitionLen);
+   apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   free(buffer);
+   dataPlaneFixture_drain(server, connection);
+   if (outPortDataLen > 0u)
+   {
+      uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE];
+      assert(outPortDataLen == UINT16_SIZE);
+      rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_START, false);
+      packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0u, UINT16_SIZE);
+      apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], (int32_t) sizeof(msg));
+   }
+}
+
+/**
+ * The lanes are not started during setup, their workers are run from the calling thread instead
+ */
+static void dataPlaneFixture_drain(apx_server_t *server, apx_serverTestConnection_t *connection)
+{
+   bool isBusy = true;
+   apx_serverTestConnection_runEventLoop(connection);
+   while (isBusy)
+   {
+      uint32_t i;
+      isBusy = false;
+      for (i = 0u; i < apx_dataPlane_getNumLanes(server->dataPlane); i++)
+      {
+         if (apx_dataPlane_runLane(server->dataPlane, (int32_t) i) > 0)
+         {
+            isBusy = true;
+         }
+      }
+   }
+}
+
+static void dataPlaneFixture_installCounter(apx_serverTestConnection_t *connection, msgCounter_t *counter)
+{
+   apx_transmitHandler_t handler;
+   apx_fileManagerWorker_t *worker = &connection->base.base.fileManager.worker;
+   apx_fileManagerWorker_copyTransmitHandler(worker, &handler);
+   handler.arg = counter;
+   handler.getSendBuffer = msgCounter_getSendBuffer;
+   handler.send = msgCounter_send;
+   handler.sendBatch = msgCounter_sendBatch;
+   apx_fileManagerWorker_setTransmitHandler(worker, &handler);
+   counter->numMessages = 0u;
+}
+
+static uint8_t *msgCounter_getSendBuffer(void *arg, int32_t msgLen)
+{
+   msgCounter_t *self = (msgCounter_t*) arg;
+   return (msgLen <= (int32_t) SCRATCH_BUF_SIZE)? &self->scratch[0] : (uint8_t*) 0;
+}
+
+static int32_t msgCounter_send(void *arg, int32_t offset, int32_t msgLen)
+{
+   msgCounter_t *self = (msgCounter_t*) arg;
+   (void) offset;
+   self->numMessages++;
+   return msgLen;
+}
+
+static int32_t msgCounter_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   msgCounter_t *self = (msgCounter_t*) arg;
+   const uint8_t *pNext = data;
+   const uint8_t *pEnd = data + dataLen;
+   uint32_t numMessages = 0u;
+   while (pNext < pEnd)
+   {
+      uint32_t msgLen = 0u;
+      const uint8_t *pResult = numheader_decode32(pNext, pEnd, &msgLen);
+      if ( (pResult == 0) || (pResult == pNext) || (pResult + msgLen > pEnd) )
+      {
+         return -1;
+      }
+      numMessages++;
+      pNext = pResult + msgLen;
+   }
+   self->numMessages += numMessages;
+   return dataLen;
+}
+
+static THREAD_PROTO(providerTask, arg)
+{
+   dataPlaneClient_t *self = (dataPlaneClient_t*) arg;
+   uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE];
+   uint32_t i;
+   rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_START, false);
+   for (i = 0u; i < NUM_WRITES_PER_CLIENT; i++)
+   {
+      packLE(&msg[RMF_LOW_ADDRESS_SIZE], i & 0xFFFFu, UINT16_SIZE);
+      apx_serverTestConnection_onSerializedMsgReceived(self->providerConnection, &msg[0], (int32_t) sizeof(msg));
+   }
+   THREAD_RETURN(0);
+}
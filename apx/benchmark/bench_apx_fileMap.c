@@ -0,0 +1,141 @@
+/*****************************************************************************
+* \file      bench_apx_fileMap.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Measures apx_fileMap address lookup and insertion cost against the number of files
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_fileMap.h"
+#include "apx_benchUtil.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_ITERATIONS 1000000u
+#define NUM_ADDRESSES 4096u //must be power of two
+#define FILE_SLOT_SIZE 1024u //port data files are placed on 1KB boundaries
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void bench_fileCount(uint32_t numFiles);
+static uint32_t nextRandom(uint32_t *state);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const uint32_t m_fileCounts[] = {1u, 10u, 100u, 1000u, 10000u};
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_fileMap(void)
+{
+   size_t i;
+   apx_benchUtil_printHeader("fileMap (random address lookup)");
+   for (i = 0u; i < sizeof(m_fileCounts)/sizeof(m_fileCounts[0]); i++)
+   {
+      bench_fileCount(m_fileCounts[i]);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fills a fileMap with numFiles port data files (like a server connection carrying numFiles/2 nodes)
+ * and measures insertion and lookup of random addresses inside those files.
+ * Consecutive lookups hit different files, so the last-file cache rarely helps.
+ */
+static void bench_fileCount(uint32_t numFiles)
+{
+   apx_fileMap_t fileMap;
+   apx_fileInfo_t fileInfo;
+   apx_benchTimer_t timer;
+   uint32_t *addresses;
+   uint32_t state = 12345u;
+   uint32_t i;
+   uint32_t numFound = 0u;
+   char name[RMF_MAX_FILE_NAME+1];
+   char caseName[64];
+   apx_file_t **files = (apx_file_t**) malloc(numFiles * sizeof(apx_file_t*));
+   assert(files != 0);
+   for (i = 0u; i < numFiles; i++)
+   {
+      sprintf(name, "Node%u%s", (unsigned int) (i / 2u), (i & 1u)? ".in" : ".out");
+      apx_fileInfo_create(&fileInfo, RMF_INVALID_ADDRESS, 1u + (nextRandom(&state) % FILE_SLOT_SIZE), name, RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL);
+      files[i] = apx_file_new(&fileInfo);
+      apx_fileInfo_destroy(&fileInfo);
+      assert(files[i] != 0);
+   }
+   apx_fileMap_create(&fileMap);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < numFiles; i++)
+   {
+      apx_fileMap_insertFile(&fileMap, files[i]);
+   }
+   apx_benchTimer_stop(&timer);
+   sprintf(caseName, "%u files, insert", (unsigned int) numFiles);
+   apx_benchUtil_printResult(caseName, numFiles, timer.elapsedTime);
+
+   addresses = (uint32_t*) malloc(NUM_ADDRESSES * sizeof(uint32_t));
+   assert(addresses != 0);
+   for (i = 0u; i < NUM_ADDRESSES; i++)
+   {
+      apx_file_t *file = files[nextRandom(&state) % numFiles];
+      addresses[i] = file->fileInfo.addressWithoutFlags + (nextRandom(&state) % file->fileInfo.length);
+   }
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      if (apx_fileMap_findByAddress(&fileMap, addresses[i & (NUM_ADDRESSES - 1u)]) != 0)
+      {
+         numFound++;
+      }
+   }
+   apx_benchTimer_stop(&timer);
+   sprintf(caseName, "%u files, findByAddress", (unsigned int) numFiles);
+   apx_benchUtil_printResult(caseName, i, timer.elapsedTime);
+   if (numFound != NUM_ITERATIONS)
+   {
+      printf("%s: unexpected lookup result\n", caseName);
+   }
+   free(addresses);
+   free(files);
+   apx_fileMap_destroy(&fileMap);
+}
+
+static uint32_t nextRandom(uint32_t *state)
+{
+   *state = (*state * 1103515245u) + 12345u;
+   return (*state >> 8);
+}
@@ -0,0 +1,126 @@
+/*****************************************************************************
+* \file      bench_apx_nodeSharing.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Measures memory used by many node instances built from the same definition
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_nodeManager.h"
+#include "apx_definitionCache.h"
+#include "apx_benchUtil.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_NODES 500u
+#define NUM_SIGNALS 32u
+#define DEFINITION_BUF_SIZE 8192u
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void bench_identicalNodes(const char *caseName, bool useDefinitionCache);
+static void nodeSharing_createDefinition(char *buf);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static apx_nodeManager_t *m_nodeManagers[NUM_NODES];
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_nodeSharing(void)
+{
+   apx_benchUtil_printHeader("node sharing (500 node instances built from the same definition)");
+   bench_identicalNodes("private nodeInfo", false);
+   bench_identicalNodes("shared nodeInfo", true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Each node instance lives in its own node manager, the same way each apx_client_t in a process has its own.
+ * bytes/node is the heap growth divided by the number of nodes.
+ */
+static void bench_identicalNodes(const char *caseName, bool useDefinitionCache)
+{
+   char definition[DEFINITION_BUF_SIZE];
+   apx_definitionCache_t definitionCache;
+   apx_benchTimer_t timer;
+   size_t heapBefore;
+   size_t heapAfter;
+   uint32_t i;
+
+   nodeSharing_createDefinition(definition);
+   apx_definitionCache_create(&definitionCache, APX_DEFINITION_CACHE_MAX_ENTRIES);
+   heapBefore = apx_benchUtil_heapInUse();
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_NODES; i++)
+   {
+      apx_error_t rc;
+      m_nodeManagers[i] = apx_nodeManager_new(APX_CLIENT_MODE, false);
+      assert(m_nodeManagers[i] != 0);
+      if (useDefinitionCache)
+      {
+         apx_nodeManager_setDefinitionCache(m_nodeManagers[i], &definitionCache);
+      }
+      rc = apx_nodeManager_buildNode_cstr(m_nodeManagers[i], definition);
+      assert(rc == APX_NO_ERROR);
+      (void) rc;
+   }
+   apx_benchTimer_stop(&timer);
+   heapAfter = apx_benchUtil_heapInUse();
+   apx_benchUtil_printResult(caseName, NUM_NODES, timer.elapsedTime);
+   apx_benchUtil_printValue(caseName, "bytes/node", (double) (heapAfter - heapBefore) / (double) NUM_NODES);
+   for (i = 0u; i < NUM_NODES; i++)
+   {
+      apx_nodeManager_delete(m_nodeManagers[i]);
+   }
+   apx_definitionCache_destroy(&definitionCache);
+}
+
+static void nodeSharing_createDefinition(char *buf)
+{
+   uint32_t i;
+   char *p = buf;
+   p += sprintf(p, "APX/1.2\nN\"SharedNode\"\nT\"Speed_T\"S(0,65535)\n");
+   for (i = 0u; i < NUM_SIGNALS; i++)
+   {
+      p += sprintf(p, "P\"ProvideSignal%u\"S:=65535\n", (unsigned int) i);
+      p += sprintf(p, "R\"RequireSignal%u\"T[0]:=65535\n", (unsigned int) i);
+      p += sprintf(p, "R\"RequireArray%u\"C[4]:={0, 0, 0, 0}\n", (unsigned int) i);
+   }
+   assert( (p - buf) < (ptrdiff_t) DEFINITION_BUF_SIZE);
+}
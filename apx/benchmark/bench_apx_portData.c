@@ -0,0 +1,170 @@
+/*****************************************************************************
+* \file      bench_apx_portData.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Measures port data write throughput while monitoring threads read the same buffer
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_nodeData.h"
+#include "apx_benchUtil.h"
+#include "osmacro.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_WRITES 2000000u
+#define MAX_NUM_READERS 4u
+#define PORT_DATA_LEN 64u //one snapshot, like a text log reading an entire node
+
+typedef struct portDataReader_tag
+{
+   apx_nodeData_t *nodeData;
+   volatile bool isRunning;
+   uint32_t numReads;
+   uint32_t numTornReads; //reads where the snapshot mixed bytes from two different writes, must stay zero
+} portDataReader_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void bench_writeWithReaders(uint32_t numReaders);
+static THREAD_PROTO(readerTask, arg);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const uint32_t m_readerCounts[] = {0u, 1u, 2u, MAX_NUM_READERS};
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_portData(void)
+{
+   size_t i;
+   apx_benchUtil_printHeader("portData (writer throughput with concurrent readers of the same buffer)");
+   for (i = 0u; i < sizeof(m_readerCounts)/sizeof(m_readerCounts[0]); i++)
+   {
+      bench_writeWithReaders(m_readerCounts[i]);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * One thread writes the require-port buffer (like the connection receiving routed data) while numReaders threads
+ * keep reading the whole buffer (like apx_client_readPortData polling from monitoring code).
+ * Every write fills the buffer with a single byte value, so a reader can detect torn snapshots.
+ */
+static void bench_writeWithReaders(uint32_t numReaders)
+{
+   apx_nodeData_t *nodeData;
+   portDataReader_t readers[MAX_NUM_READERS];
+   THREAD_T threads[MAX_NUM_READERS];
+#ifdef _WIN32
+   unsigned int threadIds[MAX_NUM_READERS];
+#endif
+   uint8_t data[PORT_DATA_LEN];
+   apx_benchTimer_t timer;
+   uint32_t numReads = 0u;
+   uint32_t numTornReads = 0u;
+   uint32_t i;
+   char caseName[64];
+
+   nodeData = apx_nodeData_new();
+   assert(nodeData != 0);
+   apx_nodeData_createRequirePortBuffer(nodeData, PORT_DATA_LEN);
+   memset(&data[0], 0, sizeof(data));
+   apx_nodeData_writeRequirePortData(nodeData, &data[0], 0u, PORT_DATA_LEN);
+   for (i = 0u; i < numReaders; i++)
+   {
+      readers[i].nodeData = nodeData;
+      readers[i].isRunning = true;
+      readers[i].numReads = 0u;
+      readers[i].numTornReads = 0u;
+#ifdef _WIN32
+      THREAD_CREATE(threads[i], readerTask, (void*) &readers[i], threadIds[i]);
+#else
+      THREAD_CREATE(threads[i], readerTask, (void*) &readers[i]);
+#endif
+   }
+
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_WRITES; i++)
+   {
+      memset(&data[0], (int) (i & 0xFFu), sizeof(data));
+      apx_nodeData_writeRequirePortData(nodeData, &data[0], 0u, PORT_DATA_LEN);
+   }
+   apx_benchTimer_stop(&timer);
+
+   for (i = 0u; i < numReaders; i++)
+   {
+      readers[i].isRunning = false;
+#ifdef _WIN32
+      WaitForSingleObject(threads[i], INFINITE);
+      CloseHandle(threads[i]);
+#else
+      pthread_join(threads[i], (void**) 0);
+#endif
+      numReads += readers[i].numReads;
+      numTornReads += readers[i].numTornReads;
+   }
+   sprintf(caseName, "%u readers, write", (unsigned int) numReaders);
+   apx_benchUtil_printResult(caseName, NUM_WRITES, timer.elapsedTime);
+   if (numReaders > 0u)
+   {
+      apx_benchUtil_printValue(caseName, "reads", (double) numReads);
+      apx_benchUtil_printValue(caseName, "torn reads", (double) numTornReads);
+   }
+   apx_nodeData_delete(nodeData);
+}
+
+static THREAD_PROTO(readerTask, arg)
+{
+   portDataReader_t *reader = (portDataReader_t*) arg;
+   uint8_t snapshot[PORT_DATA_LEN];
+   while (reader->isRunning)
+   {
+      uint32_t i;
+      apx_nodeData_readRequirePortData(reader->nodeData, &snapshot[0], 0u, PORT_DATA_LEN);
+      for (i = 1u; i < PORT_DATA_LEN; i++)
+      {
+         if (snapshot[i] != snapshot[0])
+         {
+            reader->numTornReads++;
+            break;
+         }
+      }
+      reader->numReads++;
+   }
+   THREAD_RETURN(0);
+}
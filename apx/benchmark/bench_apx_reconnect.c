@@ -0,0 +1,271 @@
+/*****************************************************************************
+* \file      bench_apx_reconnect.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Measures connect/disconnect throughput of the server while several connections reconnect at the same time
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_server.h"
+#include "apx_serverTestConnection.h"
+#include "apx_fileManager.h"
+#include "apx_benchUtil.h"
+#include "osmacro.h"
+#include "rmf.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define MAX_NUM_THREADS 4u
+#define NUM_RECONNECTS_PER_THREAD 200u
+#define NUM_SIGNALS 32u
+#define DEFINITION_BUF_SIZE 2048u
+
+typedef struct reconnectStorm_tag
+{
+   apx_server_t *server;
+   uint32_t threadId;
+   bool useSharedSignals; //when true all threads connect to the same port signatures
+} reconnectStorm_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void bench_reconnectStorm(const char *caseName, uint32_t numThreads, bool useSharedSignals);
+static void bench_providerReconnect(const char *caseName);
+static void reconnectStorm_createDefinition(char *buf, char portType, const char *nodeName, uint32_t signalGroup);
+static apx_serverTestConnection_t *reconnectStorm_connect(apx_server_t *server);
+static void reconnectStorm_attachNode(apx_serverTestConnection_t *connection, const char *nodeName, const char *definition, apx_size_t outPortDataLen);
+static void reconnectStorm_drain(apx_serverTestConnection_t *connection);
+static THREAD_PROTO(reconnectStormTask, arg);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_reconnect(void)
+{
+   apx_benchUtil_printHeader("reconnect storm (requester nodes connecting and disconnecting from provider nodes)");
+   bench_reconnectStorm("1 thread, unrelated signatures", 1u, false);
+   bench_reconnectStorm("4 threads, unrelated signatures", 4u, false);
+   bench_reconnectStorm("1 thread, shared signatures", 1u, true);
+   bench_reconnectStorm("4 threads, shared signatures", 4u, true);
+   apx_benchUtil_printHeader("provider reconnect (require port data resync of a waiting requester node)");
+   bench_providerReconnect("1 requester, 32 signals");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Each thread has its own provider node. The threads then repeatedly connect a requester node to the signals of
+ * their provider (or to the signals of the first provider when useSharedSignals is true) and disconnect it again.
+ */
+static void bench_reconnectStorm(const char *caseName, uint32_t numThreads, bool useSharedSignals)
+{
+   apx_server_t *server;
+   reconnectStorm_t tasks[MAX_NUM_THREADS];
+   THREAD_T threads[MAX_NUM_THREADS];
+#ifdef _WIN32
+   unsigned int threadIds[MAX_NUM_THREADS];
+#endif
+   apx_benchTimer_t timer;
+   uint32_t numReconnects = numThreads * NUM_RECONNECTS_PER_THREAD;
+   uint32_t i;
+   assert(numThreads <= MAX_NUM_THREADS);
+
+   server = apx_server_new();
+   assert(server != 0);
+   for (i = 0u; i < numThreads; i++)
+   {
+      char nodeName[RMF_MAX_FILE_NAME+1];
+      char definition[DEFINITION_BUF_SIZE];
+      apx_serverTestConnection_t *providerConnection = reconnectStorm_connect(server);
+      sprintf(nodeName, "Provider%u", (unsigned int) i);
+      reconnectStorm_createDefinition(definition, 'P', nodeName, i);
+      reconnectStorm_attachNode(providerConnection, nodeName, definition, NUM_SIGNALS * UINT16_SIZE);
+      reconnectStorm_drain(providerConnection);
+      tasks[i].server = server;
+      tasks[i].threadId = i;
+      tasks[i].useSharedSignals = useSharedSignals;
+   }
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < numThreads; i++)
+   {
+#ifdef _WIN32
+      THREAD_CREATE(threads[i], reconnectStormTask, (void*) &tasks[i], threadIds[i]);
+#else
+      THREAD_CREATE(threads[i], reconnectStormTask, (void*) &tasks[i]);
+#endif
+   }
+   for (i = 0u; i < numThreads; i++)
+   {
+#ifdef _WIN32
+      WaitForSingleObject(threads[i], INFINITE);
+      CloseHandle(threads[i]);
+#else
+      pthread_join(threads[i], (void**) 0);
+#endif
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult(caseName, numReconnects, timer.elapsedTime);
+   apx_benchUtil_printValue(caseName, "reconnects/s", ((double) numReconnects * 1E9) / (double) timer.elapsedTime);
+   apx_server_run(server); //cleans up detached connections
+   apx_server_delete(server);
+}
+
+/**
+ * A requester node stays connected while a provider node with the same signals repeatedly connects and disconnects.
+ * Each provider connect resyncs the require port data of the requester, msgs/reconnect shows how many messages that takes.
+ */
+static void bench_providerReconnect(const char *caseName)
+{
+   apx_server_t *server;
+   apx_serverTestConnection_t *requesterConnection;
+   char definition[DEFINITION_BUF_SIZE];
+   apx_benchTimer_t timer;
+   uint32_t i;
+
+   server = apx_server_new();
+   assert(server != 0);
+   requesterConnection = reconnectStorm_connect(server);
+   reconnectStorm_createDefinition(definition, 'R', "Requester", 0u);
+   reconnectStorm_attachNode(requesterConnection, "Requester", definition, 0u);
+   apx_serverTestConnection_onFileOpenMsgReceived(requesterConnection, APX_ADDRESS_PORT_DATA_START);
+   reconnectStorm_drain(requesterConnection);
+   apx_serverTestConnection_clearTransmitLogMsg(requesterConnection);
+   reconnectStorm_createDefinition(definition, 'P', "Provider", 0u);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_RECONNECTS_PER_THREAD; i++)
+   {
+      apx_serverTestConnection_t *providerConnection = reconnectStorm_connect(server);
+      reconnectStorm_attachNode(providerConnection, "Provider", definition, NUM_SIGNALS * UINT16_SIZE);
+      reconnectStorm_drain(providerConnection);
+      reconnectStorm_drain(requesterConnection);
+      apx_server_detachConnection(server, (apx_serverConnectionBase_t*) providerConnection);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult(caseName, NUM_RECONNECTS_PER_THREAD, timer.elapsedTime);
+   apx_benchUtil_printValue(caseName, "reconnects/s", ((double) NUM_RECONNECTS_PER_THREAD * 1E9) / (double) timer.elapsedTime);
+   apx_benchUtil_printValue(caseName, "msgs/reconnect", (double) apx_serverTestConnection_getTransmitLogLen(requesterConnection) / (double) NUM_RECONNECTS_PER_THREAD);
+   apx_server_run(server); //cleans up detached connections
+   apx_server_delete(server);
+}
+
+static void reconnectStorm_createDefinition(char *buf, char portType, const char *nodeName, uint32_t signalGroup)
+{
+   uint32_t i;
+   char *p = buf;
+   p += sprintf(p, "APX/1.2\nN\"%s\"\n", nodeName);
+   for (i = 0u; i < NUM_SIGNALS; i++)
+   {
+      p += sprintf(p, "%c\"Group%uSignal%u\"S:=65535\n", portType, (unsigned int) signalGroup, (unsigned int) i);
+   }
+   assert( (p - buf) < (ptrdiff_t) DEFINITION_BUF_SIZE);
+}
+
+static apx_serverTestConnection_t *reconnectStorm_connect(apx_server_t *server)
+{
+   apx_serverTestConnection_t *connection = apx_serverTestConnection_new();
+   assert(connection != 0);
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection);
+   apx_serverTestConnection_onProtocolHeaderReceived(connection);
+   apx_serverTestConnection_runEventLoop(connection);
+   return connection;
+}
+
+/**
+ * Performs the client side of the handshake for a node: file info messages followed by the definition (and provide port data when outPortDataLen > 0)
+ */
+static void reconnectStorm_attachNode(apx_serverTestConnection_t *connection, const char *nodeName, const char *definition, apx_size_t outPortDataLen)
+{
+   char fileName[RMF_MAX_FILE_NAME+1];
+   rmf_fileInfo_t fileInfo;
+   uint8_t *buffer;
+   apx_size_t definitionLen = (apx_size_t) strlen(definition);
+   sprintf(fileName, "%s.apx", nodeName);
+   rmf_fileInfo_create(&fileInfo, fileName, APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   if (outPortDataLen > 0u)
+   {
+      sprintf(fileName, "%s.out", nodeName);
+      rmf_fileInfo_create(&fileInfo, fileName, APX_ADDRESS_PORT_DATA_START, outPortDataLen, RMF_FILE_TYPE_FIXED);
+      apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   }
+   reconnectStorm_drain(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false);
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], definition, definitionLen);
+   apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   free(buffer);
+   reconnectStorm_drain(connection);
+   if (outPortDataLen > 0u)
+   {
+      buffer = (uint8_t*) malloc(RMF_LOW_ADDRESS_SIZE+outPortDataLen);
+      assert(buffer != 0);
+      rmf_packHeader(&buffer[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_START, false);
+      memset(&buffer[RMF_LOW_ADDRESS_SIZE], 0, outPortDataLen);
+      apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, (int32_t) (RMF_LOW_ADDRESS_SIZE+outPortDataLen));
+      free(buffer);
+   }
+}
+
+static void reconnectStorm_drain(apx_serverTestConnection_t *connection)
+{
+   while (apx_fileManager_run(&connection->base.base.fileManager))
+   {
+   }
+}
+
+static THREAD_PROTO(reconnectStormTask, arg)
+{
+   reconnectStorm_t *self = (reconnectStorm_t*) arg;
+   char nodeName[RMF_MAX_FILE_NAME+1];
+   char definition[DEFINITION_BUF_SIZE];
+   uint32_t i;
+   sprintf(nodeName, "Requester%u", (unsigned int) self->threadId);
+   reconnectStorm_createDefinition(definition, 'R', nodeName, self->useSharedSignals? 0u : self->threadId);
+   for (i = 0u; i < NUM_RECONNECTS_PER_THREAD; i++)
+   {
+      apx_serverTestConnection_t *connection = reconnectStorm_connect(self->server);
+      reconnectStorm_attachNode(connection, nodeName, definition, 0u);
+      apx_serverTestConnection_onFileOpenMsgReceived(connection, APX_ADDRESS_PORT_DATA_START);
+      reconnectStorm_drain(connection);
+      apx_server_detachConnection(self->server, (apx_serverConnectionBase_t*) connection);
+   }
+   THREAD_RETURN(0);
+}
@@ -0,0 +1,203 @@
+/*****************************************************************************
+* \file      bench_apx_routing.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Measures copies and time per routed provide-port write in the server
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_server.h"
+#include "apx_serverTestConnection.h"
+#include "apx_fileManager.h"
+#include "apx_benchUtil.h"
+#include "rmf.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_ITERATIONS 100000u
+#define TRANSMIT_LOG_CLEAR_INTERVAL 1000u
+
+typedef struct routingFixture_tag
+{
+   apx_server_t *server;
+   apx_serverTestConnection_t *providerConnection; //Contains TestNode1
+   apx_serverTestConnection_t *receiverConnection; //Contains TestNode2
+} routingFixture_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void routingFixture_create(routingFixture_t *self);
+static void routingFixture_destroy(routingFixture_t *self);
+static void routingFixture_attachNode(apx_serverTestConnection_t *connection, const char *nodeName, const char *definition, apx_size_t outPortDataLen);
+static void routingFixture_drain(apx_serverTestConnection_t *connection);
+static void bench_routeProvidePortWrites(const char *caseName, bool useDirectPath);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const char *m_apx_definition1 = "APX/1.2\n"
+      "N\"TestNode1\"\n"
+      "P\"VehicleSpeed\"S:=65535\n"
+      "\n";
+
+static const char *m_apx_definition2 = "APX/1.2\n"
+      "N\"TestNode2\"\n"
+      "R\"VehicleSpeed\"S:=65535\n"
+      "\n";
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_routing(void)
+{
+   apx_benchUtil_printHeader("routing (provide-port write to require-port connection)");
+   bench_routeProvidePortWrites("allocator path", false);
+   bench_routeProvidePortWrites("direct path", true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void routingFixture_create(routingFixture_t *self)
+{
+   self->server = apx_server_new();
+   assert(self->server != 0);
+   self->providerConnection = apx_serverTestConnection_new();
+   self->receiverConnection = apx_serverTestConnection_new();
+   assert( (self->providerConnection != 0) && (self->receiverConnection != 0) );
+   apx_server_acceptConnection(self->server, (apx_serverConnectionBase_t*) self->providerConnection);
+   apx_serverTestConnection_onProtocolHeaderReceived(self->providerConnection);
+   apx_serverTestConnection_runEventLoop(self->providerConnection);
+   apx_server_acceptConnection(self->server, (apx_serverConnectionBase_t*) self->receiverConnection);
+   apx_serverTestConnection_onProtocolHeaderReceived(self->receiverConnection);
+   apx_serverTestConnection_runEventLoop(self->receiverConnection);
+
+   routingFixture_attachNode(self->providerConnection, "TestNode1", m_apx_definition1, UINT16_SIZE);
+   routingFixture_attachNode(self->receiverConnection, "TestNode2", m_apx_definition2, 0u);
+   apx_serverTestConnection_onFileOpenMsgReceived(self->receiverConnection, APX_ADDRESS_PORT_DATA_START);
+   routingFixture_drain(self->providerConnection);
+   routingFixture_drain(self->receiverConnection);
+   apx_serverTestConnection_clearTransmitLogMsg(self->receiverConnection);
+}
+
+static void routingFixture_destroy(routingFixture_t *self)
+{
+   apx_server_delete(self->server);
+}
+
+/**
+ * Performs the client side of the handshake for a node: file info messages followed by the definition (and provide port data when outPortDataLen > 0)
+ */
+static void routingFixture_attachNode(apx_serverTestConnection_t *connection, const char *nodeName, const char *definition, apx_size_t outPortDataLen)
+{
+   char fileName[RMF_MAX_FILE_NAME+1];
+   rmf_fileInfo_t fileInfo;
+   uint8_t *buffer;
+   apx_size_t definitionLen = (apx_size_t) strlen(definition);
+   sprintf(fileName, "%s.apx", nodeName);
+   rmf_fileInfo_create(&fileInfo, fileName, APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   if (outPortDataLen > 0u)
+   {
+      sprintf(fileName, "%s.out", nodeName);
+      rmf_fileInfo_create(&fileInfo, fileName, APX_ADDRESS_PORT_DATA_START, outPortDataLen, RMF_FILE_TYPE_FIXED);
+      apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   }
+   routingFixture_drain(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false);
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], definition, definitionLen);
+   apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   free(buffer);
+   routingFixture_drain(connection);
+   if (outPortDataLen > 0u)
+   {
+      uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE];
+      assert(outPortDataLen == UINT16_SIZE);
+      rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_START, false);
+      packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0u, UINT16_SIZE);
+      apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], (int32_t) sizeof(msg));
+   }
+}
+
+static void routingFixture_drain(apx_serverTestConnection_t *connection)
+{
+   while (apx_fileManager_run(&connection->base.base.fileManager))
+   {
+   }
+}
+
+static void bench_routeProvidePortWrites(const char *caseName, bool useDirectPath)
+{
+   routingFixture_t fixture;
+   apx_fileManagerWorker_t *worker;
+   apx_fileManagerWorkerStats_t statsBefore;
+   apx_fileManagerWorkerStats_t statsAfter;
+   apx_benchTimer_t timer;
+   uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE];
+   uint32_t i;
+   double bytesCopiedPerSignal;
+
+   routingFixture_create(&fixture);
+   worker = &fixture.receiverConnection->base.base.fileManager.worker;
+   if (!useDirectPath)
+   {
+      //Without sendBatch the connection falls back to the allocator based path
+      apx_transmitHandler_t handler;
+      apx_fileManagerWorker_copyTransmitHandler(worker, &handler);
+      handler.sendBatch = 0;
+      apx_fileManagerWorker_setTransmitHandler(worker, &handler);
+   }
+   rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_START, false);
+   apx_fileManagerWorker_getStats(worker, &statsBefore);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      packLE(&msg[RMF_LOW_ADDRESS_SIZE], i & 0xFFFFu, UINT16_SIZE);
+      apx_serverTestConnection_onSerializedMsgReceived(fixture.providerConnection, &msg[0], (int32_t) sizeof(msg));
+      routingFixture_drain(fixture.receiverConnection);
+      if ( (i % TRANSMIT_LOG_CLEAR_INTERVAL) == 0u)
+      {
+         apx_serverTestConnection_clearTransmitLogMsg(fixture.receiverConnection);
+      }
+   }
+   apx_benchTimer_stop(&timer);
+   apx_fileManagerWorker_getStats(worker, &statsAfter);
+   apx_benchUtil_printResult(caseName, NUM_ITERATIONS, timer.elapsedTime);
+   //Note that routing also writes the value into the require port data of TestNode2 (server state), that copy is not counted here
+   bytesCopiedPerSignal = (double) (statsAfter.numBytesCopied - statsBefore.numBytesCopied) / (double) NUM_ITERATIONS;
+   apx_benchUtil_printValue(caseName, "transport bytes copied/signal", bytesCopiedPerSignal);
+   apx_benchUtil_printValue(caseName, "transport copies/signal", bytesCopiedPerSignal / (double) UINT16_SIZE);
+   routingFixture_destroy(&fixture);
+}
@@ -0,0 +1,193 @@
+/*****************************************************************************
+* \file      bench_apx_vm.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Compares the byte code interpreter against op table dispatch in apx_vm
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_vm.h"
+#include "apx_compiler.h"
+#include "apx_benchUtil.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_ITERATIONS 1000000u
+#define NUM_RECORD_ELEMENTS 20
+#define RECORD_DATA_SIZE ((NUM_RECORD_ELEMENTS / 2) * (UINT16_SIZE + UINT32_SIZE))
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_dataElement_t *createRecordElement(void);
+static adt_bytes_t *compileProgram(apx_dataElement_t *element, bool isPackProgram);
+static void bench_packRecord(const char *caseName, const adt_bytes_t *program, dtl_hv_t *hv, bool useOpTable);
+static void bench_unpackRecord(const char *caseName, const adt_bytes_t *program, bool useOpTable);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void bench_apx_vm(void)
+{
+   apx_dataElement_t *element = createRecordElement();
+   adt_bytes_t *packProgram = compileProgram(element, true);
+   adt_bytes_t *unpackProgram = compileProgram(element, false);
+   dtl_hv_t *hv = dtl_hv_new();
+   int32_t i;
+   assert( (packProgram != 0) && (unpackProgram != 0) && (hv != 0) );
+   for (i = 0; i < NUM_RECORD_ELEMENTS; i++)
+   {
+      char name[16];
+      sprintf(name, "Element%d", (int) i);
+      dtl_hv_set_cstr(hv, name, (dtl_dv_t*) dtl_sv_make_u32((uint32_t) (i * 1000)), false);
+   }
+   apx_benchUtil_printHeader("vm (record of 20 scalars)");
+   bench_packRecord("pack, interpreter", packProgram, hv, false);
+   bench_packRecord("pack, op table", packProgram, hv, true);
+   bench_unpackRecord("unpack, interpreter", unpackProgram, false);
+   bench_unpackRecord("unpack, op table", unpackProgram, true);
+   dtl_dec_ref(hv);
+   adt_bytes_delete(packProgram);
+   adt_bytes_delete(unpackProgram);
+   apx_dataElement_delete(element);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Record with alternating U16 and U32 elements
+ */
+static apx_dataElement_t *createRecordElement(void)
+{
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_RECORD, 0);
+   int32_t i;
+   assert(element != 0);
+   for (i = 0; i < NUM_RECORD_ELEMENTS; i++)
+   {
+      char name[16];
+      sprintf(name, "Element%d", (int) i);
+      apx_dataElement_appendChild(element, apx_dataElement_new( ((i % 2) == 0)? APX_BASE_TYPE_UINT16 : APX_BASE_TYPE_UINT32, name));
+   }
+   return element;
+}
+
+static adt_bytes_t *compileProgram(apx_dataElement_t *element, bool isPackProgram)
+{
+   adt_bytes_t *program;
+   adt_bytearray_t *compiledProgram = adt_bytearray_new(APX_PROGRAM_GROW_SIZE);
+   apx_compiler_t *compiler = apx_compiler_new();
+   apx_error_t rc;
+   if (isPackProgram)
+   {
+      apx_compiler_begin_packProgram(compiler, compiledProgram);
+      rc = apx_compiler_compilePackDataElement(compiler, element);
+   }
+   else
+   {
+      apx_compiler_begin_unpackProgram(compiler, compiledProgram);
+      rc = apx_compiler_compileUnpackDataElement(compiler, element);
+   }
+   assert(rc == APX_NO_ERROR);
+   (void) rc;
+   apx_compiler_end(compiler);
+   apx_compiler_delete(compiler);
+   program = adt_bytearray_bytes(compiledProgram);
+   adt_bytearray_delete(compiledProgram);
+   return program;
+}
+
+static void bench_packRecord(const char *caseName, const adt_bytes_t *program, dtl_hv_t *hv, bool useOpTable)
+{
+   apx_vm_t vm;
+   apx_benchTimer_t timer;
+   uint8_t dataBuffer[RECORD_DATA_SIZE];
+   uint32_t i;
+   apx_vm_create(&vm);
+   if (apx_vm_selectProgram(&vm, program) != APX_NO_ERROR)
+   {
+      printf("%s: failed to select program\n", caseName);
+      apx_vm_destroy(&vm);
+      return;
+   }
+   apx_vm_enableOpTable(&vm, useOpTable);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      apx_vm_setWriteBuffer(&vm, &dataBuffer[0], (uint32_t) sizeof(dataBuffer));
+      if (apx_vm_packValue(&vm, (dtl_dv_t*) hv) != APX_NO_ERROR)
+      {
+         printf("%s: pack failed\n", caseName);
+         break;
+      }
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult(caseName, i, timer.elapsedTime);
+   apx_vm_destroy(&vm);
+}
+
+static void bench_unpackRecord(const char *caseName, const adt_bytes_t *program, bool useOpTable)
+{
+   apx_vm_t vm;
+   apx_benchTimer_t timer;
+   uint8_t dataBuffer[RECORD_DATA_SIZE];
+   uint32_t i;
+   memset(&dataBuffer[0], 0x5A, sizeof(dataBuffer));
+   apx_vm_create(&vm);
+   if (apx_vm_selectProgram(&vm, program) != APX_NO_ERROR)
+   {
+      printf("%s: failed to select program\n", caseName);
+      apx_vm_destroy(&vm);
+      return;
+   }
+   apx_vm_enableOpTable(&vm, useOpTable);
+   apx_benchTimer_start(&timer);
+   for (i = 0u; i < NUM_ITERATIONS; i++)
+   {
+      dtl_dv_t *dv = (dtl_dv_t*) 0;
+      apx_vm_setReadBuffer(&vm, &dataBuffer[0], (uint32_t) sizeof(dataBuffer));
+      if (apx_vm_unpackValue(&vm, &dv) != APX_NO_ERROR)
+      {
+         printf("%s: unpack failed\n", caseName);
+         break;
+      }
+      dtl_dec_ref(dv);
+   }
+   apx_benchTimer_stop(&timer);
+   apx_benchUtil_printResult(caseName, i, timer.elapsedTime);
+   apx_vm_destroy(&vm);
+}
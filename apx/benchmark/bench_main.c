@@ -0,0 +1,71 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+typedef struct apx_benchEntry_tag
+{
+   const char *name;
+   void (*run)(void);
+} apx_benchEntry_t;
+
+/** APX Client **/
+void bench_apx_client(void);
+
+/** APX Server **/
+void bench_apx_dataPlane(void);
+void bench_apx_reconnect(void);
+void bench_apx_routing(void);
+
+/** APX Common **/
+void bench_apx_bytePortMap(void);
+void bench_apx_fileMap(void);
+void bench_apx_nodeSharing(void);
+void bench_apx_portData(void);
+void bench_apx_vm(void);
+
+static const apx_benchEntry_t m_benchmarks[] = {
+   {"bytePortMap", bench_apx_bytePortMap},
+   {"client", bench_apx_client},
+   {"dataPlane", bench_apx_dataPlane},
+   {"fileMap", bench_apx_fileMap},
+   {"nodeSharing", bench_apx_nodeSharing},
+   {"portData", bench_apx_portData},
+   {"reconnect", bench_apx_reconnect},
+   {"routing", bench_apx_routing},
+   {"vm", bench_apx_vm},
+};
+
+/**
+ * Usage: apx_bench [name]...
+ * Runs all benchmarks when no names are given
+ */
+int main(int argc, char **argv)
+{
+   size_t i;
+   for (i = 0u; i < sizeof(m_benchmarks)/sizeof(m_benchmarks[0]); i++)
+   {
+      bool isSelected = (argc < 2)? true : false;
+      int j;
+      for (j = 1; j < argc; j++)
+      {
+         if (strcmp(argv[j], m_benchmarks[i].name) == 0)
+         {
+            isSelected = true;
+         }
+      }
+      if (isSelected)
+      {
+         m_benchmarks[i].run();
+      }
+   }
+   return 0;
+}
+
+void vfree(void *arg)
+{
+   free(arg);
+}
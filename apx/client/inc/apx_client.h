@@ -34,6 +34,8 @@
 #include "apx_error.h"
 #include "apx_clientConnectionBase.h"
 #include "apx_nodeInstance.h"
+#include "apx_portCodec.h"
+#include "apx_shmChannel.h"
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -45,6 +47,7 @@ struct adt_ary_tag;
 struct adt_list_tag;
 struct adt_hash_tag;
 struct apx_clientEventListener_tag;
+struct apx_definitionCache_tag;
 struct apx_fileManager_tag;
 struct apx_nodeManager_tag;
 struct apx_vm_tag;
@@ -70,8 +73,10 @@ typedef struct apx_client_tag
    apx_clientConnectionBase_t *connection; //message connection
    struct adt_list_tag *eventListeners; //weak references to apx_clientEventListener_t
    struct apx_nodeManager_tag *nodeManager;
-   struct apx_vm_tag *vm;
+   struct apx_vm_tag *vmPool[APX_CLIENT_VM_POOL_SIZE]; //idle virtual machines, protected by vmPoolLock
+   int32_t vmPoolLen;
    SPINLOCK_T lock;
+   SPINLOCK_T vmPoolLock;
    SPINLOCK_T eventListenerLock;
    bool isConnected;
 } apx_client_t;
@@ -97,6 +102,9 @@ apx_error_t apx_client_connect_tcp(apx_client_t *self, const char *address, uint
 # ifndef _WIN32
 apx_error_t apx_client_connect_unix(apx_client_t *self, const char *socketPath);
 # endif
+# if APX_SHM_SUPPORTED
+apx_error_t apx_client_connect_shm(apx_client_t *self, const char *socketPath);
+# endif
 #endif
 void apx_client_disconnect(apx_client_t *self);
 
@@ -109,6 +117,7 @@ void apx_client_attachConnection(apx_client_t *self, apx_clientConnectionBase_t
 apx_clientConnectionBase_t *apx_client_getConnection(apx_client_t *self);
 
 apx_error_t apx_client_buildNode_cstr(apx_client_t *self, const char *definition_text);
+void apx_client_setDefinitionCache(apx_client_t *self, struct apx_definitionCache_tag *definitionCache);
 int32_t apx_client_getLastErrorLine(apx_client_t *self);
 apx_nodeInstance_t *apx_client_getLastAttachedNode(apx_client_t *self);
 struct apx_fileManager_tag *apx_client_getFileManager(apx_client_t *self);
@@ -124,12 +133,49 @@ apx_error_t apx_client_writePortData(apx_client_t *self, void *portHandle, const
 apx_error_t apx_client_writePortData_u8(apx_client_t *self, void *portHandle, uint8_t value);
 apx_error_t apx_client_writePortData_u16(apx_client_t *self, void *portHandle, uint16_t value);
 apx_error_t apx_client_writePortData_u32(apx_client_t *self, void *portHandle, uint32_t value);
+apx_error_t apx_client_writePortData_u64(apx_client_t *self, void *portHandle, uint64_t value);
+apx_error_t apx_client_writePortData_s8(apx_client_t *self, void *portHandle, int8_t value);
+apx_error_t apx_client_writePortData_s16(apx_client_t *self, void *portHandle, int16_t value);
+apx_error_t apx_client_writePortData_s32(apx_client_t *self, void *portHandle, int32_t value);
+apx_error_t apx_client_writePortData_s64(apx_client_t *self, void *portHandle, int64_t value);
+apx_error_t apx_client_writePortData_bool(apx_client_t *self, void *portHandle, bool value);
+apx_error_t apx_client_writePortData_u8_array(apx_client_t *self, void *portHandle, const uint8_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_u16_array(apx_client_t *self, void *portHandle, const uint16_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_u32_array(apx_client_t *self, void *portHandle, const uint32_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_u64_array(apx_client_t *self, void *portHandle, const uint64_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_s8_array(apx_client_t *self, void *portHandle, const int8_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_s16_array(apx_client_t *self, void *portHandle, const int16_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_s32_array(apx_client_t *self, void *portHandle, const int32_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_s64_array(apx_client_t *self, void *portHandle, const int64_t *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_bool_array(apx_client_t *self, void *portHandle, const bool *values, uint32_t arrayLen);
+apx_error_t apx_client_writePortData_bytes(apx_client_t *self, void *portHandle, const uint8_t *data, apx_size_t len);
+apx_error_t apx_client_setPortWriteMode(apx_client_t *self, void *portHandle, apx_portWriteMode_t mode, uint32_t heartbeatInterval);
+uint32_t apx_client_getSuppressedWriteCount(apx_client_t *self, void *portHandle);
+
+/*** Port Codec API ***/
+apx_portCodec_t *apx_client_createPortCodec(apx_client_t *self, void *portHandle, apx_error_t *errorCode);
 
 /*** Port Data Read API ***/
 apx_error_t apx_client_readPortData(apx_client_t *self, void *portHandle, dtl_dv_t **dv);
 apx_error_t apx_client_readPortData_u8(apx_client_t *self, void *portHandle, uint8_t *value);
 apx_error_t apx_client_readPortData_u16(apx_client_t *self, void *portHandle, uint16_t *value);
 apx_error_t apx_client_readPortData_u32(apx_client_t *self, void *portHandle, uint32_t *value);
+apx_error_t apx_client_readPortData_u64(apx_client_t *self, void *portHandle, uint64_t *value);
+apx_error_t apx_client_readPortData_s8(apx_client_t *self, void *portHandle, int8_t *value);
+apx_error_t apx_client_readPortData_s16(apx_client_t *self, void *portHandle, int16_t *value);
+apx_error_t apx_client_readPortData_s32(apx_client_t *self, void *portHandle, int32_t *value);
+apx_error_t apx_client_readPortData_s64(apx_client_t *self, void *portHandle, int64_t *value);
+apx_error_t apx_client_readPortData_bool(apx_client_t *self, void *portHandle, bool *value);
+apx_error_t apx_client_readPortData_u8_array(apx_client_t *self, void *portHandle, uint8_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_u16_array(apx_client_t *self, void *portHandle, uint16_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_u32_array(apx_client_t *self, void *portHandle, uint32_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_u64_array(apx_client_t *self, void *portHandle, uint64_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_s8_array(apx_client_t *self, void *portHandle, int8_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_s16_array(apx_client_t *self, void *portHandle, int16_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_s32_array(apx_client_t *self, void *portHandle, int32_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_s64_array(apx_client_t *self, void *portHandle, int64_t *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_bool_array(apx_client_t *self, void *portHandle, bool *values, uint32_t arrayLen);
+apx_error_t apx_client_readPortData_bytes(apx_client_t *self, void *portHandle, uint8_t *data, apx_size_t len);
 
 #ifdef UNIT_TEST
 void apx_client_run(apx_client_t *self);
@@ -0,0 +1,64 @@
+/*****************************************************************************
+* \file      apx_clientShmConnection.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Client connection using the shared-memory transport
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_CLIENT_SHM_CONNECTION_H
+#define APX_CLIENT_SHM_CONNECTION_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_shmChannel.h"
+#if APX_SHM_SUPPORTED
+#include "adt_bytearray.h"
+#include "apx_clientConnectionBase.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef struct apx_clientShmConnection_tag
+{
+   apx_clientConnectionBase_t base;
+   adt_bytearray_t sendBuffer;
+   adt_bytearray_t receiveBuffer; //holds a partial message when a large message was split over several ring records
+   apx_shmChannel_t channel;
+   int sockFd; //rendezvous socket, kept open to detect when the server goes away
+   THREAD_T receiveThread;
+   bool isChannelValid;
+   bool isThreadRunning;
+   volatile bool isDestroying;
+}apx_clientShmConnection_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_clientShmConnection_create(apx_clientShmConnection_t *self);
+void apx_clientShmConnection_destroy(apx_clientShmConnection_t *self);
+void apx_clientShmConnection_vdestroy(void *arg);
+apx_clientShmConnection_t *apx_clientShmConnection_new(void);
+
+apx_error_t apx_clientShmConnection_connect(apx_clientShmConnection_t *self, const char *socketPath);
+
+#endif //APX_SHM_SUPPORTED
+#endif //APX_CLIENT_SHM_CONNECTION_H
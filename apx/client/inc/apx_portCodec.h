@@ -0,0 +1,74 @@
+/*****************************************************************************
+* \file      apx_portCodec.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Port handle with its own virtual machine for lock-free encode/decode of port data
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_PORT_CODEC_H
+#define APX_PORT_CODEC_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_portDataRef.h"
+#include "apx_vm.h"
+#include "dtl_type.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A port codec binds a private apx_vm_t to a single port handle. The pack (provide port) or unpack (require port)
+ * program is selected once at creation. A codec must only be used by one thread at a time but different codecs
+ * can be used in parallel without any shared lock.
+ */
+typedef struct apx_portCodec_tag
+{
+   apx_vm_t vm;
+   apx_portRef_t *portRef; //weak reference
+   uint8_t *buffer; //strong reference to encode/decode buffer of length dataSize
+   apx_size_t dataSize;
+   bool isProvidePort;
+} apx_portCodec_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_portCodec_create(apx_portCodec_t *self, apx_portRef_t *portRef);
+void apx_portCodec_destroy(apx_portCodec_t *self);
+apx_portCodec_t *apx_portCodec_new(apx_portRef_t *portRef, apx_error_t *errorCode);
+void apx_portCodec_delete(apx_portCodec_t *self);
+void apx_portCodec_vdelete(void *arg);
+
+apx_portRef_t *apx_portCodec_getPortRef(apx_portCodec_t *self);
+apx_error_t apx_portCodec_write(apx_portCodec_t *self, const dtl_dv_t *value);
+apx_error_t apx_portCodec_read(apx_portCodec_t *self, dtl_dv_t **dv);
+
+#endif //APX_PORT_CODEC_H
@@ -35,7 +35,9 @@
 #include "apx_clientInternal.h"
 #include "apx_clientConnectionBase.h"
 #include "apx_clientSocketConnection.h"
+#include "apx_clientShmConnection.h"
 #include "apx_nodeManager.h"
+#include "apx_definitionCache.h"
 #include "apx_fileManager.h"
 #include "apx_parser.h"
 #include "apx_nodeInstance.h"
@@ -61,6 +63,14 @@
 // CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
 #define MAX_STACK_BUFFER_SIZE 256u
+
+//C array handed to apx_client_packFixedArray/apx_client_unpackFixedArray
+typedef struct apx_client_fixedArray_tag
+{
+   void *values;
+   uint32_t arrayLen;
+   uint8_t elemSize;
+} apx_client_fixedArray_t;
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
@@ -68,8 +78,17 @@ static void apx_client_triggerConnectedEventOnListeners(apx_client_t *self, apx_
 static void apx_client_triggerDisconnectedEventOnListeners(apx_client_t *self, apx_clientConnectionBase_t *connection);
 static void apx_client_triggerRequirePortDataWriteEventOnListeners(apx_client_t *self, apx_nodeInstance_t *nodeInstance, apx_portId_t requirePortId, void *portHandle);
 static void apx_client_attachLocalNodesToConnection(apx_client_t *self);
-static apx_error_t apx_client_verifySingleInstructionProgramFromPortRef(apx_portRef_t *portRef, uint8_t opcode, uint8_t variant);
-static apx_error_t apx_client_verifySingleInstructionProgram(const adt_bytes_t *program, uint8_t opcode, uint8_t variant);
+static apx_error_t apx_client_verifyPortLayout(apx_portRef_t *portRef, uint8_t variant, uint32_t arrayLen);
+static apx_error_t apx_client_writeScalar(apx_portRef_t *portRef, uint8_t variant, uint64_t value, uint8_t elemSize);
+static apx_error_t apx_client_readScalar(apx_portRef_t *portRef, uint8_t variant, uint64_t *value, uint8_t elemSize);
+static apx_error_t apx_client_writeFixedArray(apx_portRef_t *portRef, uint8_t variant, const void *values, uint32_t arrayLen, uint8_t elemSize, bool isBoolArray);
+static apx_error_t apx_client_readFixedArray(apx_portRef_t *portRef, uint8_t variant, void *values, uint32_t arrayLen, uint8_t elemSize, bool isBoolArray);
+static void apx_client_packElementLE(uint8_t *dest, uint64_t value, uint8_t elemSize);
+static uint64_t apx_client_unpackElementLE(const uint8_t *src, uint8_t elemSize);
+static void apx_client_packFixedArray(void *arg, uint8_t *dest, apx_size_t len);
+static void apx_client_unpackFixedArray(void *arg, const uint8_t *src, apx_size_t len);
+static apx_vm_t *apx_client_acquireVm(apx_client_t *self);
+static void apx_client_releaseVm(apx_client_t *self, apx_vm_t *vm);
 
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
@@ -93,11 +112,12 @@ apx_error_t apx_client_create(apx_client_t *self)
          return APX_MEM_ERROR;
       }
       self->connection = (apx_clientConnectionBase_t*) 0;
-      self->vm = (apx_vm_t*) 0;
+      self->vmPoolLen = 0;
       //The node manager in this class is the true manager of the nodeInstances. Therefore we set useWeakRef argument to false.
       self->nodeManager = apx_nodeManager_new(APX_CLIENT_MODE, false);
       self->isConnected = false;
       SPINLOCK_INIT(self->lock);
+      SPINLOCK_INIT(self->vmPoolLock);
       SPINLOCK_INIT(self->eventListenerLock);
       return APX_NO_ERROR;
    }
@@ -125,11 +145,12 @@ void apx_client_destroy(apx_client_t *self)
       {
          apx_nodeManager_delete(self->nodeManager);
       }
-      if (self->vm != 0)
+      while (self->vmPoolLen > 0)
       {
-         apx_vm_delete(self->vm);
+         apx_vm_delete(self->vmPool[--self->vmPoolLen]);
       }
       SPINLOCK_DESTROY(self->lock);
+      SPINLOCK_DESTROY(self->vmPoolLock);
       SPINLOCK_DESTROY(self->eventListenerLock);
    }
 }
@@ -245,6 +266,37 @@ apx_error_t apx_client_connect_unix(apx_client_t *self, const char *socketPath)
 }
 # endif
 
+# if APX_SHM_SUPPORTED
+/**
+ * Connects to a server on the same host using the shared-memory transport. socketPath is the server's "shm-file".
+ */
+apx_error_t apx_client_connect_shm(apx_client_t *self, const char *socketPath)
+{
+   if (self != 0)
+   {
+      apx_clientShmConnection_t *shmConnection = apx_clientShmConnection_new();
+      if (shmConnection != 0)
+      {
+         apx_error_t result;
+         apx_client_attachConnection(self, (apx_clientConnectionBase_t*) shmConnection);
+         result = apx_clientShmConnection_connect(shmConnection, socketPath);
+         if (result == APX_NO_ERROR)
+         {
+            SPINLOCK_ENTER(self->lock);
+            self->isConnected = true;
+            SPINLOCK_LEAVE(self->lock);
+         }
+         return result;
+      }
+      else
+      {
+         return APX_MEM_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+# endif
+
 #endif
 
 void apx_client_disconnect(apx_client_t *self)
@@ -349,6 +401,19 @@ apx_error_t apx_client_buildNode_cstr(apx_client_t *self, const char *definition
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Clients in the same process that build nodes from identical definitions can share a definition cache.
+ * Those nodes then share one read-only nodeInfo instead of compiling their own.
+ * The cache must outlive the client.
+ */
+void apx_client_setDefinitionCache(apx_client_t *self, apx_definitionCache_t *definitionCache)
+{
+   if (self != 0)
+   {
+      apx_nodeManager_setDefinitionCache(self->nodeManager, definitionCache);
+   }
+}
+
 int32_t apx_client_getLastErrorLine(apx_client_t *self)
 {
    if (self != 0)
@@ -475,6 +540,7 @@ apx_error_t apx_client_writePortData(apx_client_t *self, void *portHandle, const
       uint8_t stackBuffer[MAX_STACK_BUFFER_SIZE];
       apx_error_t result;
       uint8_t *writeBuffer;
+      apx_vm_t *vm;
       bool isHeapAllocated = false;
       const apx_portDataProps_t *portDataProps;
       apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
@@ -502,48 +568,35 @@ apx_error_t apx_client_writePortData(apx_client_t *self, void *portHandle, const
       {
          writeBuffer = &stackBuffer[0];
       }
-      SPINLOCK_ENTER(self->lock);
-      if (self->vm == 0)
+      vm = apx_client_acquireVm(self);
+      if (vm == 0)
       {
-         self->vm = apx_vm_new();
-         if (self->vm == 0)
-         {
-            SPINLOCK_LEAVE(self->lock);
-            if (isHeapAllocated) free(writeBuffer);
-            return APX_MEM_ERROR;
-         }
+         if (isHeapAllocated) free(writeBuffer);
+         return APX_MEM_ERROR;
       }
-      assert(self->vm != 0);
       portProgram = apx_nodeInstance_getProvidePortPackProgram(portRef->nodeInstance, apx_portRef_getPortId(portRef));
       if (portProgram == 0)
       {
-         SPINLOCK_LEAVE(self->lock);
+         apx_client_releaseVm(self, vm);
          if (isHeapAllocated) free(writeBuffer);
          return APX_INVALID_PROGRAM_ERROR;
       }
-      result = apx_vm_selectProgram(self->vm, portProgram);
-      if (result != APX_NO_ERROR)
+      result = apx_vm_selectCompiledProgram(vm, portProgram, apx_nodeInstance_getProvidePortPackOpTable(portRef->nodeInstance, apx_portRef_getPortId(portRef)));
+      if (result == APX_NO_ERROR)
       {
-         SPINLOCK_LEAVE(self->lock);
-         if (isHeapAllocated) free(writeBuffer);
-         return result;
+         result = apx_vm_setWriteBuffer(vm, writeBuffer, portDataProps->dataSize);
       }
-      result = apx_vm_setWriteBuffer(self->vm, writeBuffer, portDataProps->dataSize);
-      if (result != APX_NO_ERROR)
+      if (result == APX_NO_ERROR)
       {
-         SPINLOCK_LEAVE(self->lock);
-         if (isHeapAllocated) free(writeBuffer);
-         return result;
+         result = apx_vm_packValue(vm, value);
       }
-      result = apx_vm_packValue(self->vm, value);
+      apx_client_releaseVm(self, vm);
       if (result != APX_NO_ERROR)
       {
-         SPINLOCK_LEAVE(self->lock);
          if (isHeapAllocated) free(writeBuffer);
          return result;
       }
-      SPINLOCK_LEAVE(self->lock);
-      result = apx_nodeInstance_writeProvidePortData(portRef->nodeInstance, writeBuffer, portDataProps->offset, portDataProps->dataSize);
+      result = apx_nodeInstance_writeProvidePortDataById(portRef->nodeInstance, apx_portRef_getPortId(portRef), writeBuffer, portDataProps->dataSize);
       if (isHeapAllocated) free(writeBuffer);
       return result;
    }
@@ -552,75 +605,243 @@ apx_error_t apx_client_writePortData(apx_client_t *self, void *portHandle, const
 
 apx_error_t apx_client_writePortData_u8(apx_client_t *self, void *portHandle, uint8_t value)
 {
-   if (self != 0 && portHandle != 0)
+   if ( (self != 0) && (portHandle != 0) )
    {
-      apx_error_t rc;
-      apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
-      rc = apx_client_verifySingleInstructionProgramFromPortRef(portRef, APX_OPCODE_PACK, APX_VARIANT_U8);
-      if (rc == APX_NO_ERROR)
-      {
-         apx_error_t result;
-         SPINLOCK_ENTER(self->lock);
-         result = apx_nodeInstance_writeProvidePortData(portRef->nodeInstance, &value, portRef->portDataProps->offset, UINT8_SIZE);
-         SPINLOCK_LEAVE(self->lock);
-         return result;
-      }
-      else
-      {
-         return rc;
-      }
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_U8, (uint64_t) value, UINT8_SIZE);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
 apx_error_t apx_client_writePortData_u16(apx_client_t *self, void *portHandle, uint16_t value)
 {
-   if (self != 0 && portHandle != 0)
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_U16, (uint64_t) value, UINT16_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_u32(apx_client_t *self, void *portHandle, uint32_t value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_U32, (uint64_t) value, UINT32_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_u64(apx_client_t *self, void *portHandle, uint64_t value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_U64, (uint64_t) value, UINT64_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s8(apx_client_t *self, void *portHandle, int8_t value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_S8, (uint64_t) (uint8_t) value, UINT8_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s16(apx_client_t *self, void *portHandle, int16_t value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_S16, (uint64_t) (uint16_t) value, UINT16_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s32(apx_client_t *self, void *portHandle, int32_t value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_S32, (uint64_t) (uint32_t) value, UINT32_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s64(apx_client_t *self, void *portHandle, int64_t value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_S64, (uint64_t) value, UINT64_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_bool(apx_client_t *self, void *portHandle, bool value)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_client_writeScalar((apx_portRef_t*) portHandle, APX_VARIANT_U8, value? 1u : 0u, UINT8_SIZE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_u8_array(apx_client_t *self, void *portHandle, const uint8_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U8, (const void*) values, arrayLen, UINT8_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_u16_array(apx_client_t *self, void *portHandle, const uint16_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U16, (const void*) values, arrayLen, UINT16_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_u32_array(apx_client_t *self, void *portHandle, const uint32_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U32, (const void*) values, arrayLen, UINT32_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_u64_array(apx_client_t *self, void *portHandle, const uint64_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U64, (const void*) values, arrayLen, UINT64_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s8_array(apx_client_t *self, void *portHandle, const int8_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S8, (const void*) values, arrayLen, UINT8_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s16_array(apx_client_t *self, void *portHandle, const int16_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S16, (const void*) values, arrayLen, UINT16_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s32_array(apx_client_t *self, void *portHandle, const int32_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S32, (const void*) values, arrayLen, UINT32_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_s64_array(apx_client_t *self, void *portHandle, const int64_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S64, (const void*) values, arrayLen, UINT64_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_writePortData_bool_array(apx_client_t *self, void *portHandle, const bool *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_writeFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U8, (const void*) values, arrayLen, UINT8_SIZE, true);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Writes already packed port data, typically a record. len must equal the data size of the port.
+ */
+apx_error_t apx_client_writePortData_bytes(apx_client_t *self, void *portHandle, const uint8_t *data, apx_size_t len)
+{
+   if ( (self != 0) && (portHandle != 0) && (data != 0) )
    {
-      apx_error_t rc;
       apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
-      rc = apx_client_verifySingleInstructionProgramFromPortRef(portRef, APX_OPCODE_PACK, APX_VARIANT_U16);
-      if (rc == APX_NO_ERROR)
+      if (!apx_portRef_isProvidePort(portRef))
       {
-         apx_error_t result;
-         uint8_t packedData[UINT16_SIZE];
-         packLE(&packedData[0], value, UINT16_SIZE);
-         SPINLOCK_ENTER(self->lock);
-         result = apx_nodeInstance_writeProvidePortData(portRef->nodeInstance, &packedData[0], portRef->portDataProps->offset, UINT16_SIZE);
-         SPINLOCK_LEAVE(self->lock);
-         return result;
+         return APX_INVALID_PORT_HANDLE_ERROR;
       }
-      else
+      if (!apx_portDataProps_isPlainOldData(portRef->portDataProps))
       {
-         return rc;
+         return APX_NOT_IMPLEMENTED_ERROR;
       }
+      if (len != portRef->portDataProps->dataSize)
+      {
+         return APX_LENGTH_ERROR;
+      }
+      return apx_nodeInstance_writeProvidePortDataById(portRef->nodeInstance, apx_portRef_getPortId(portRef), data, len);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
-apx_error_t apx_client_writePortData_u32(apx_client_t *self, void *portHandle, uint32_t value)
+/**
+ * Selects how writes to a provide-port are forwarded.
+ * With APX_PORT_WRITE_MODE_ON_CHANGE a write of identical packed bytes updates nothing and is not sent to the server.
+ * heartbeatInterval (milliseconds, 0 to disable) makes sure an unchanged value is still sent periodically.
+ */
+apx_error_t apx_client_setPortWriteMode(apx_client_t *self, void *portHandle, apx_portWriteMode_t mode, uint32_t heartbeatInterval)
 {
-   if (self != 0 && portHandle != 0)
+   if ( (self != 0) && (portHandle != 0) )
    {
-      apx_error_t rc;
       apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
-      rc = apx_client_verifySingleInstructionProgramFromPortRef(portRef, APX_OPCODE_PACK, APX_VARIANT_U32);
-      if (rc == APX_NO_ERROR)
+      if (!apx_portRef_isProvidePort(portRef))
       {
-         apx_error_t result;
-         uint8_t packedData[UINT32_SIZE];
-         packLE(&packedData[0], value, UINT32_SIZE);
-         SPINLOCK_ENTER(self->lock);
-         result = apx_nodeInstance_writeProvidePortData(portRef->nodeInstance, &packedData[0], portRef->portDataProps->offset, UINT32_SIZE);
-         SPINLOCK_LEAVE(self->lock);
-         return result;
+         return APX_INVALID_PORT_HANDLE_ERROR;
       }
-      else
+      return apx_nodeInstance_setProvidePortWriteMode(portRef->nodeInstance, apx_portRef_getPortId(portRef), mode, heartbeatInterval);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Returns number of writes to a provide-port that were suppressed since the data was unchanged
+ */
+uint32_t apx_client_getSuppressedWriteCount(apx_client_t *self, void *portHandle)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
+      if (apx_portRef_isProvidePort(portRef))
       {
-         return rc;
+         return apx_nodeInstance_getProvidePortSuppressedWriteCount(portRef->nodeInstance, apx_portRef_getPortId(portRef));
       }
    }
-   return APX_INVALID_ARGUMENT_ERROR;
+   return 0u;
+}
+
+/*** Port Codec API ***/
+
+/**
+ * Creates a port codec for portHandle. The returned object owns its own virtual machine with the port program
+ * already selected. The caller owns the codec and must delete it with apx_portCodec_delete before the client is destroyed.
+ */
+apx_portCodec_t *apx_client_createPortCodec(apx_client_t *self, void *portHandle, apx_error_t *errorCode)
+{
+   if ( (self != 0) && (portHandle != 0) )
+   {
+      return apx_portCodec_new((apx_portRef_t*) portHandle, errorCode);
+   }
+   if (errorCode != 0)
+   {
+      *errorCode = APX_INVALID_ARGUMENT_ERROR;
+   }
+   return (apx_portCodec_t*) 0;
 }
 
 /*** Port Data Read API ***/
@@ -632,6 +853,7 @@ apx_error_t apx_client_readPortData(apx_client_t *self, void *portHandle, dtl_dv
       uint8_t stackBuffer[MAX_STACK_BUFFER_SIZE];
       apx_error_t result;
       uint8_t *readBuffer;
+      apx_vm_t *vm;
       bool isHeapAllocated = false;
       const apx_portDataProps_t *portDataProps;
       apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
@@ -663,43 +885,32 @@ apx_error_t apx_client_readPortData(apx_client_t *self, void *portHandle, dtl_dv
       result = apx_nodeInstance_readRequirePortData(portRef->nodeInstance, readBuffer, portDataProps->offset, portDataProps->dataSize);
       if (result != APX_NO_ERROR)
       {
+         if (isHeapAllocated) free(readBuffer);
          return result;
       }
-      SPINLOCK_ENTER(self->lock);
-      if (self->vm == 0)
+      vm = apx_client_acquireVm(self);
+      if (vm == 0)
       {
-         self->vm = apx_vm_new();
-         if (self->vm == 0)
-         {
-            SPINLOCK_LEAVE(self->lock);
-            if (isHeapAllocated) free(readBuffer);
-            return APX_MEM_ERROR;
-         }
+         if (isHeapAllocated) free(readBuffer);
+         return APX_MEM_ERROR;
       }
-      assert(self->vm != 0);
       portProgram = apx_nodeInstance_getRequirePortUnpackProgram(portRef->nodeInstance, apx_portRef_getPortId(portRef));
       if (portProgram == 0)
       {
-         SPINLOCK_LEAVE(self->lock);
+         apx_client_releaseVm(self, vm);
          if (isHeapAllocated) free(readBuffer);
          return APX_INVALID_PROGRAM_ERROR;
       }
-      result = apx_vm_selectProgram(self->vm, portProgram);
-      if (result != APX_NO_ERROR)
+      result = apx_vm_selectCompiledProgram(vm, portProgram, apx_nodeInstance_getRequirePortUnpackOpTable(portRef->nodeInstance, apx_portRef_getPortId(portRef)));
+      if (result == APX_NO_ERROR)
       {
-         SPINLOCK_LEAVE(self->lock);
-         if (isHeapAllocated) free(readBuffer);
-         return result;
+         result = apx_vm_setReadBuffer(vm, readBuffer, portDataProps->dataSize);
       }
-      result = apx_vm_setReadBuffer(self->vm, readBuffer, portDataProps->dataSize);
-      if (result != APX_NO_ERROR)
+      if (result == APX_NO_ERROR)
       {
-         SPINLOCK_LEAVE(self->lock);
-         if (isHeapAllocated) free(readBuffer);
-         return result;
+         result = apx_vm_unpackValue(vm, dv);
       }
-      result = apx_vm_unpackValue(self->vm, dv);
-      SPINLOCK_LEAVE(self->lock);
+      apx_client_releaseVm(self, vm);
       if (isHeapAllocated) free(readBuffer);
       return result;
    }
@@ -710,74 +921,239 @@ apx_error_t apx_client_readPortData_u8(apx_client_t *self, void *portHandle, uin
 {
    if ( (self != 0) && (portHandle != 0)  && (value != 0) )
    {
-      apx_error_t rc;
-      apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
-      rc = apx_client_verifySingleInstructionProgramFromPortRef(portRef, APX_OPCODE_UNPACK, APX_VARIANT_U8);
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_U8, &tmp, UINT8_SIZE);
       if (rc == APX_NO_ERROR)
       {
-         SPINLOCK_ENTER(self->lock);
-         rc = apx_nodeInstance_readRequirePortData(portRef->nodeInstance, value, portRef->portDataProps->offset, UINT8_SIZE);
-         SPINLOCK_LEAVE(self->lock);
-         return rc;
+         *value = (uint8_t) tmp;
       }
-      else
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_u16(apx_client_t *self, void *portHandle, uint16_t *value)
+{
+   if ( (self != 0) && (portHandle != 0)  && (value != 0) )
+   {
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_U16, &tmp, UINT16_SIZE);
+      if (rc == APX_NO_ERROR)
       {
-         return rc;
+         *value = (uint16_t) tmp;
       }
+      return rc;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
-apx_error_t apx_client_readPortData_u16(apx_client_t *self, void *portHandle, uint16_t *value)
+apx_error_t apx_client_readPortData_u32(apx_client_t *self, void *portHandle, uint32_t *value)
 {
    if ( (self != 0) && (portHandle != 0)  && (value != 0) )
    {
-      apx_error_t rc;
-      apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
-      rc = apx_client_verifySingleInstructionProgramFromPortRef(portRef, APX_OPCODE_UNPACK, APX_VARIANT_U16);
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_U32, &tmp, UINT32_SIZE);
       if (rc == APX_NO_ERROR)
       {
-         uint8_t packedData[UINT16_SIZE];
-         SPINLOCK_ENTER(self->lock);
-         rc = apx_nodeInstance_readRequirePortData(portRef->nodeInstance, &packedData[0], portRef->portDataProps->offset, UINT16_SIZE);
-         SPINLOCK_LEAVE(self->lock);
-         if (rc == APX_NO_ERROR)
-         {
-            *value = (uint16_t) unpackLE(&packedData[0], UINT16_SIZE);
-         }
-         return rc;
+         *value = (uint32_t) tmp;
       }
-      else
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_u64(apx_client_t *self, void *portHandle, uint64_t *value)
+{
+   if ( (self != 0) && (portHandle != 0)  && (value != 0) )
+   {
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_U64, &tmp, UINT64_SIZE);
+      if (rc == APX_NO_ERROR)
       {
-         return rc;
+         *value = (uint64_t) tmp;
       }
+      return rc;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
-apx_error_t apx_client_readPortData_u32(apx_client_t *self, void *portHandle, uint32_t *value)
+apx_error_t apx_client_readPortData_s8(apx_client_t *self, void *portHandle, int8_t *value)
 {
    if ( (self != 0) && (portHandle != 0)  && (value != 0) )
    {
-      apx_error_t rc;
-      apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
-      rc = apx_client_verifySingleInstructionProgramFromPortRef(portRef, APX_OPCODE_UNPACK, APX_VARIANT_U32);
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_S8, &tmp, UINT8_SIZE);
       if (rc == APX_NO_ERROR)
       {
-         uint8_t packedData[UINT32_SIZE];
-         SPINLOCK_ENTER(self->lock);
-         rc = apx_nodeInstance_readRequirePortData(portRef->nodeInstance, &packedData[0], portRef->portDataProps->offset, UINT32_SIZE);
-         SPINLOCK_LEAVE(self->lock);
-         if (rc == APX_NO_ERROR)
-         {
-            *value = unpackLE(&packedData[0], UINT32_SIZE);
-         }
-         return rc;
+         *value = (int8_t) tmp;
       }
-      else
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s16(apx_client_t *self, void *portHandle, int16_t *value)
+{
+   if ( (self != 0) && (portHandle != 0)  && (value != 0) )
+   {
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_S16, &tmp, UINT16_SIZE);
+      if (rc == APX_NO_ERROR)
+      {
+         *value = (int16_t) tmp;
+      }
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s32(apx_client_t *self, void *portHandle, int32_t *value)
+{
+   if ( (self != 0) && (portHandle != 0)  && (value != 0) )
+   {
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_S32, &tmp, UINT32_SIZE);
+      if (rc == APX_NO_ERROR)
+      {
+         *value = (int32_t) tmp;
+      }
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s64(apx_client_t *self, void *portHandle, int64_t *value)
+{
+   if ( (self != 0) && (portHandle != 0)  && (value != 0) )
+   {
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_S64, &tmp, UINT64_SIZE);
+      if (rc == APX_NO_ERROR)
+      {
+         *value = (int64_t) tmp;
+      }
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_bool(apx_client_t *self, void *portHandle, bool *value)
+{
+   if ( (self != 0) && (portHandle != 0)  && (value != 0) )
+   {
+      uint64_t tmp = 0u;
+      apx_error_t rc = apx_client_readScalar((apx_portRef_t*) portHandle, APX_VARIANT_U8, &tmp, UINT8_SIZE);
+      if (rc == APX_NO_ERROR)
       {
-         return rc;
+         *value = (tmp != 0u);
       }
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_u8_array(apx_client_t *self, void *portHandle, uint8_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U8, (void*) values, arrayLen, UINT8_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_u16_array(apx_client_t *self, void *portHandle, uint16_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U16, (void*) values, arrayLen, UINT16_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_u32_array(apx_client_t *self, void *portHandle, uint32_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U32, (void*) values, arrayLen, UINT32_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_u64_array(apx_client_t *self, void *portHandle, uint64_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U64, (void*) values, arrayLen, UINT64_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s8_array(apx_client_t *self, void *portHandle, int8_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S8, (void*) values, arrayLen, UINT8_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s16_array(apx_client_t *self, void *portHandle, int16_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S16, (void*) values, arrayLen, UINT16_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s32_array(apx_client_t *self, void *portHandle, int32_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S32, (void*) values, arrayLen, UINT32_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_s64_array(apx_client_t *self, void *portHandle, int64_t *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_S64, (void*) values, arrayLen, UINT64_SIZE, false);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_client_readPortData_bool_array(apx_client_t *self, void *portHandle, bool *values, uint32_t arrayLen)
+{
+   if ( (self != 0) && (portHandle != 0) && (values != 0) )
+   {
+      return apx_client_readFixedArray((apx_portRef_t*) portHandle, APX_VARIANT_U8, (void*) values, arrayLen, UINT8_SIZE, true);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Reads port data in its packed form, typically a record. len must equal the data size of the port.
+ */
+apx_error_t apx_client_readPortData_bytes(apx_client_t *self, void *portHandle, uint8_t *data, apx_size_t len)
+{
+   if ( (self != 0) && (portHandle != 0) && (data != 0) )
+   {
+      apx_portRef_t *portRef = (apx_portRef_t*) portHandle;
+      if (apx_portRef_isProvidePort(portRef))
+      {
+         return APX_INVALID_PORT_HANDLE_ERROR;
+      }
+      if (!apx_portDataProps_isPlainOldData(portRef->portDataProps))
+      {
+         return APX_NOT_IMPLEMENTED_ERROR;
+      }
+      if (len != portRef->portDataProps->dataSize)
+      {
+         return APX_LENGTH_ERROR;
+      }
+      return apx_nodeInstance_readRequirePortData(portRef->nodeInstance, data, portRef->portDataProps->offset, len);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
@@ -924,68 +1300,232 @@ static void apx_client_attachLocalNodesToConnection(apx_client_t *self)
    }
 }
 
-static apx_error_t apx_client_verifySingleInstructionProgramFromPortRef(apx_portRef_t *portRef, uint8_t opcode, uint8_t variant)
+/**
+ * Verifies that the port holds exactly one value of the expected variant.
+ * When arrayLen is 0 the value must be a scalar, otherwise it must be a fixed array of length arrayLen.
+ * The check runs against the operation table that nodeInfo compiled once for the port, no byte code is decoded here.
+ */
+static apx_error_t apx_client_verifyPortLayout(apx_portRef_t *portRef, uint8_t variant, uint32_t arrayLen)
 {
-   apx_nodeInfo_t *nodeInfo;
-   const adt_bytes_t *program = 0;
-   nodeInfo = apx_nodeInstance_getNodeInfo(portRef->nodeInstance);
-   assert(nodeInfo != 0);
-
+   const apx_vmOpTable_t *opTable;
+   const apx_vmOp_t *op;
    if (apx_portRef_isProvidePort(portRef))
    {
-      program = apx_nodeInfo_getProvidePortPackProgram(nodeInfo, apx_portRef_getPortId(portRef));
+      opTable = apx_nodeInstance_getProvidePortPackOpTable(portRef->nodeInstance, apx_portRef_getPortId(portRef));
    }
    else
    {
-      program = apx_nodeInfo_getRequirePortUnpackProgram(nodeInfo, apx_portRef_getPortId(portRef));
+      opTable = apx_nodeInstance_getRequirePortUnpackOpTable(portRef->nodeInstance, apx_portRef_getPortId(portRef));
    }
+   if ( (opTable == 0) || (opTable->numOps != 1) || (opTable->isRecord) )
+   {
+      return APX_INVALID_PROGRAM_ERROR;
+   }
+   op = &opTable->ops[0];
+   if ( (op->variant != variant) || ((op->count > 0u) != (arrayLen > 0u)) )
+   {
+      return APX_INVALID_INSTRUCTION_ERROR;
+   }
+   if (op->count != arrayLen)
+   {
+      return APX_LENGTH_ERROR;
+   }
+   return APX_NO_ERROR;
+}
 
-   if (program != 0)
+static apx_error_t apx_client_writeScalar(apx_portRef_t *portRef, uint8_t variant, uint64_t value, uint8_t elemSize)
+{
+   uint8_t packedData[UINT64_SIZE];
+   apx_error_t rc = apx_client_verifyPortLayout(portRef, variant, 0u);
+   if (rc != APX_NO_ERROR)
    {
-      return apx_client_verifySingleInstructionProgram(program, opcode, variant);
+      return rc;
    }
-   else
+   apx_client_packElementLE(&packedData[0], value, elemSize);
+   return apx_nodeInstance_writeProvidePortDataById(portRef->nodeInstance, apx_portRef_getPortId(portRef), &packedData[0], elemSize);
+}
+
+static apx_error_t apx_client_readScalar(apx_portRef_t *portRef, uint8_t variant, uint64_t *value, uint8_t elemSize)
+{
+   uint8_t packedData[UINT64_SIZE];
+   apx_error_t rc = apx_client_verifyPortLayout(portRef, variant, 0u);
+   if (rc != APX_NO_ERROR)
    {
-      return APX_INVALID_PROGRAM_ERROR;
+      return rc;
    }
+   rc = apx_nodeInstance_readRequirePortData(portRef->nodeInstance, &packedData[0], portRef->portDataProps->offset, elemSize);
+   if (rc == APX_NO_ERROR)
+   {
+      *value = apx_client_unpackElementLE(&packedData[0], elemSize);
+   }
+   return rc;
 }
 
-static apx_error_t apx_client_verifySingleInstructionProgram(const adt_bytes_t *program, uint8_t expectedOpcode, uint8_t expectedVariant)
+/**
+ * Packs a fixed array of C values into the port layout.
+ * Byte-sized elements are written straight from the caller's array. Larger elements are packed by
+ * apx_client_packFixedArray into the port's scratch buffer in nodeData, nothing is allocated per call.
+ */
+static apx_error_t apx_client_writeFixedArray(apx_portRef_t *portRef, uint8_t variant, const void *values, uint32_t arrayLen, uint8_t elemSize, bool isBoolArray)
 {
-   if (program != 0)
+   apx_client_fixedArray_t fixedArray;
+   apx_size_t dataSize;
+   apx_error_t rc = apx_client_verifyPortLayout(portRef, variant, arrayLen);
+   if (rc != APX_NO_ERROR)
    {
-      const uint8_t *code;
-      int32_t length;
-      code = adt_bytes_constData(program);
-      length = adt_bytes_length(program);
-      if (length == APX_VM_HEADER_SIZE + APX_VM_INSTRUCTION_SIZE)
+      return rc;
+   }
+   dataSize = arrayLen * elemSize;
+   assert(dataSize == portRef->portDataProps->dataSize);
+   if ( (elemSize == UINT8_SIZE) && (!isBoolArray) )
+   {
+      return apx_nodeInstance_writeProvidePortDataById(portRef->nodeInstance, apx_portRef_getPortId(portRef), (const uint8_t*) values, dataSize);
+   }
+   fixedArray.values = (void*) values;
+   fixedArray.arrayLen = arrayLen;
+   fixedArray.elemSize = elemSize;
+   return apx_nodeInstance_packProvidePortDataById(portRef->nodeInstance, apx_portRef_getPortId(portRef), dataSize, apx_client_packFixedArray, (void*) &fixedArray);
+}
+
+/**
+ * Byte-sized elements are copied straight into the caller's array, other arrays are unpacked in place by apx_client_unpackFixedArray.
+ */
+static apx_error_t apx_client_readFixedArray(apx_portRef_t *portRef, uint8_t variant, void *values, uint32_t arrayLen, uint8_t elemSize, bool isBoolArray)
+{
+   apx_client_fixedArray_t fixedArray;
+   apx_size_t dataSize;
+   apx_error_t rc = apx_client_verifyPortLayout(portRef, variant, arrayLen);
+   if (rc != APX_NO_ERROR)
+   {
+      return rc;
+   }
+   dataSize = arrayLen * elemSize;
+   assert(dataSize == portRef->portDataProps->dataSize);
+   if ( (elemSize == UINT8_SIZE) && (!isBoolArray) )
+   {
+      return apx_nodeInstance_readRequirePortData(portRef->nodeInstance, (uint8_t*) values, portRef->portDataProps->offset, dataSize);
+   }
+   fixedArray.values = values;
+   fixedArray.arrayLen = arrayLen;
+   fixedArray.elemSize = elemSize;
+   return apx_nodeInstance_unpackRequirePortData(portRef->nodeInstance, portRef->portDataProps->offset, dataSize, apx_client_unpackFixedArray, (void*) &fixedArray);
+}
+
+/**
+ * apx_nodeData_packFunc of apx_client_writeFixedArray. Elements of size 1 are bools.
+ */
+static void apx_client_packFixedArray(void *arg, uint8_t *dest, apx_size_t len)
+{
+   const apx_client_fixedArray_t *fixedArray = (const apx_client_fixedArray_t*) arg;
+   uint32_t i;
+   assert(len == fixedArray->arrayLen * fixedArray->elemSize);
+   (void) len;
+   for (i = 0u; i < fixedArray->arrayLen; i++)
+   {
+      uint64_t value;
+      switch(fixedArray->elemSize)
       {
-         uint8_t opcode = 0u;
-         uint8_t variant = 0u;
-         uint8_t flags = 0u;
-         apx_error_t rc = apx_vm_decodeInstruction(code[APX_VM_HEADER_SIZE], &opcode, &variant, &flags);
-         if ( (rc == APX_NO_ERROR) )
-         {
-            if ( (flags == 0) && (opcode == expectedOpcode) && (variant == expectedVariant))
-            {
-               return APX_NO_ERROR;
-            }
-            else
-            {
-               return APX_INVALID_INSTRUCTION_ERROR;
-            }
-         }
-         else
-         {
-            return rc;
-         }
+      case UINT8_SIZE:
+         value = ((const bool*) fixedArray->values)[i]? 1u : 0u;
+         break;
+      case UINT16_SIZE:
+         value = ((const uint16_t*) fixedArray->values)[i];
+         break;
+      case UINT32_SIZE:
+         value = ((const uint32_t*) fixedArray->values)[i];
+         break;
+      default:
+         value = ((const uint64_t*) fixedArray->values)[i];
+         break;
       }
-      else
+      apx_client_packElementLE(&dest[i * fixedArray->elemSize], value, fixedArray->elemSize);
+   }
+}
+
+/**
+ * apx_nodeData_unpackFunc of apx_client_readFixedArray. Elements of size 1 are bools.
+ */
+static void apx_client_unpackFixedArray(void *arg, const uint8_t *src, apx_size_t len)
+{
+   const apx_client_fixedArray_t *fixedArray = (const apx_client_fixedArray_t*) arg;
+   uint32_t i;
+   assert(len == fixedArray->arrayLen * fixedArray->elemSize);
+   (void) len;
+   for (i = 0u; i < fixedArray->arrayLen; i++)
+   {
+      uint64_t value = apx_client_unpackElementLE(&src[i * fixedArray->elemSize], fixedArray->elemSize);
+      switch(fixedArray->elemSize)
       {
-         return APX_INVALID_PROGRAM_ERROR;
+      case UINT8_SIZE:
+         ((bool*) fixedArray->values)[i] = (value != 0u);
+         break;
+      case UINT16_SIZE:
+         ((uint16_t*) fixedArray->values)[i] = (uint16_t) value;
+         break;
+      case UINT32_SIZE:
+         ((uint32_t*) fixedArray->values)[i] = (uint32_t) value;
+         break;
+      default:
+         ((uint64_t*) fixedArray->values)[i] = value;
+         break;
       }
    }
-   return APX_INVALID_ARGUMENT_ERROR;
 }
 
+static void apx_client_packElementLE(uint8_t *dest, uint64_t value, uint8_t elemSize)
+{
+   if (elemSize <= UINT32_SIZE)
+   {
+      packLE(dest, (uint32_t) value, elemSize);
+   }
+   else
+   {
+      packLE(dest, (uint32_t) value, UINT32_SIZE);
+      packLE(dest + UINT32_SIZE, (uint32_t) (value >> 32), UINT32_SIZE);
+   }
+}
 
+static uint64_t apx_client_unpackElementLE(const uint8_t *src, uint8_t elemSize)
+{
+   if (elemSize <= UINT32_SIZE)
+   {
+      return (uint64_t) unpackLE(src, elemSize);
+   }
+   return ((uint64_t) unpackLE(src + UINT32_SIZE, UINT32_SIZE) << 32) | (uint64_t) unpackLE(src, UINT32_SIZE);
+}
+
+/**
+ * Takes an idle virtual machine from the pool, or creates a new one if the pool is empty.
+ * The pool lock is only held while taking the pointer, never while running a program.
+ */
+static apx_vm_t *apx_client_acquireVm(apx_client_t *self)
+{
+   apx_vm_t *vm = (apx_vm_t*) 0;
+   SPINLOCK_ENTER(self->vmPoolLock);
+   if (self->vmPoolLen > 0)
+   {
+      vm = self->vmPool[--self->vmPoolLen];
+   }
+   SPINLOCK_LEAVE(self->vmPoolLock);
+   if (vm == 0)
+   {
+      vm = apx_vm_new();
+   }
+   return vm;
+}
+
+static void apx_client_releaseVm(apx_client_t *self, apx_vm_t *vm)
+{
+   assert(vm != 0);
+   SPINLOCK_ENTER(self->vmPoolLock);
+   if (self->vmPoolLen < APX_CLIENT_VM_POOL_SIZE)
+   {
+      self->vmPool[self->vmPoolLen++] = vm;
+      vm = (apx_vm_t*) 0;
+   }
+   SPINLOCK_LEAVE(self->vmPoolLock);
+   if (vm != 0)
+   {
+      apx_vm_delete(vm);
+   }
+}
@@ -0,0 +1,414 @@
+/*****************************************************************************
+* \file      apx_clientShmConnection.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Client connection using the shared-memory transport
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_clientShmConnection.h"
+#if APX_SHM_SUPPORTED
+#include <errno.h>
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#include <stdio.h> //Debug only
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "apx_logging.h"
+#include "apx_transmitHandler.h"
+#include "numheader.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define SEND_BUFFER_GROW_SIZE 4096 //4KB
+#define RECEIVE_BUFFER_GROW_SIZE 4096 //4KB
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_clientShmConnection_fillTransmitHandler(apx_clientShmConnection_t *self, apx_transmitHandler_t *handler);
+static apx_error_t apx_clientShmConnection_vfillTransmitHandler(void *arg, apx_transmitHandler_t *handler);
+static uint8_t *apx_clientShmConnection_getSendBuffer(void *arg, int32_t msgLen);
+static int32_t apx_clientShmConnection_send(void *arg, int32_t offset, int32_t msgLen);
+static int32_t apx_clientShmConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
+static void apx_clientShmConnection_data(void *arg, const uint8_t *data, uint32_t dataLen);
+static THREAD_PROTO(apx_clientShmConnection_receiveTask, arg);
+static void apx_clientShmConnection_stopThread(apx_clientShmConnection_t *self);
+
+static void apx_clientShmConnection_close(apx_clientShmConnection_t *self);
+static void apx_clientShmConnection_vclose(void *arg);
+static void apx_clientShmConnection_start(apx_clientShmConnection_t *self);
+static void apx_clientShmConnection_vstart(void *arg);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_clientShmConnection_create(apx_clientShmConnection_t *self)
+{
+   if (self != 0)
+   {
+      apx_connectionBaseVTable_t vtable;
+      apx_error_t result;
+      apx_connectionBaseVTable_create(&vtable,
+            apx_clientShmConnection_vdestroy,
+            apx_clientShmConnection_vstart,
+            apx_clientShmConnection_vclose,
+            apx_clientShmConnection_vfillTransmitHandler);
+      result = apx_clientConnectionBase_create(&self->base, &vtable);
+      if (result != APX_NO_ERROR)
+      {
+         return result;
+      }
+      adt_bytearray_create(&self->sendBuffer, SEND_BUFFER_GROW_SIZE);
+      adt_bytearray_create(&self->receiveBuffer, RECEIVE_BUFFER_GROW_SIZE);
+      self->sockFd = -1;
+      self->isChannelValid = false;
+      self->isThreadRunning = false;
+      self->isDestroying = false;
+      apx_connectionBase_start(&self->base.base);///TODO: Don't call start from the constructor
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_clientShmConnection_destroy(apx_clientShmConnection_t *self)
+{
+   if (self != 0)
+   {
+      self->isDestroying = true;
+      apx_clientShmConnection_stopThread(self);
+      apx_clientConnectionBase_destroy(&self->base);
+      adt_bytearray_destroy(&self->sendBuffer);
+      adt_bytearray_destroy(&self->receiveBuffer);
+      if (self->isChannelValid)
+      {
+         apx_shmChannel_destroy(&self->channel);
+         self->isChannelValid = false;
+      }
+      if (self->sockFd >= 0)
+      {
+         close(self->sockFd);
+         self->sockFd = -1;
+      }
+   }
+}
+
+void apx_clientShmConnection_vdestroy(void *arg)
+{
+   apx_clientShmConnection_destroy((apx_clientShmConnection_t*) arg);
+}
+
+apx_clientShmConnection_t *apx_clientShmConnection_new(void)
+{
+   apx_clientShmConnection_t *self = (apx_clientShmConnection_t*) malloc(sizeof(apx_clientShmConnection_t));
+   if (self != 0)
+   {
+      apx_error_t errorCode = apx_clientShmConnection_create(self);
+      if (errorCode != APX_NO_ERROR)
+      {
+         free(self);
+         self = (apx_clientShmConnection_t*) 0;
+      }
+   }
+   return self;
+}
+
+/**
+ * Connects to the shared-memory rendezvous socket of the server, maps the region it hands over and starts the receive thread.
+ */
+apx_error_t apx_clientShmConnection_connect(apx_clientShmConnection_t *self, const char *socketPath)
+{
+   if ( (self != 0) && (socketPath != 0) && (self->sockFd < 0) )
+   {
+      struct sockaddr_un addr;
+      apx_error_t result;
+      if (strlen(socketPath) >= sizeof(addr.sun_path))
+      {
+         return APX_INVALID_ARGUMENT_ERROR;
+      }
+      memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      strcpy(addr.sun_path, socketPath);
+      self->sockFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (self->sockFd < 0)
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      if (connect(self->sockFd, (struct sockaddr*) &addr, sizeof(addr)) != 0)
+      {
+         close(self->sockFd);
+         self->sockFd = -1;
+         return APX_CONNECTION_ERROR;
+      }
+      result = apx_shmChannel_createFromSocket(&self->channel, self->sockFd);
+      if (result != APX_NO_ERROR)
+      {
+         close(self->sockFd);
+         self->sockFd = -1;
+         return result;
+      }
+      self->isChannelValid = true;
+      //The greeting is not an RMF message and must never be routed through the shared window
+      apx_shmChannel_setWindowEnabled(&self->channel, false);
+      if (THREAD_CREATE(self->receiveThread, apx_clientShmConnection_receiveTask, self) != 0)
+      {
+         return APX_THREAD_CREATE_ERROR;
+      }
+      self->isThreadRunning = true;
+      apx_clientConnectionBase_connectedCbk(&self->base);
+      apx_shmChannel_setWindowEnabled(&self->channel, true);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+static apx_error_t apx_clientShmConnection_fillTransmitHandler(apx_clientShmConnection_t *self, apx_transmitHandler_t *handler)
+{
+   if ( (self != 0) && (handler != 0) )
+   {
+      handler->arg = self;
+      handler->send = apx_clientShmConnection_send;
+      handler->getSendAvail = 0;
+      handler->getSendBuffer = apx_clientShmConnection_getSendBuffer;
+      handler->sendBatch = apx_clientShmConnection_sendBatch;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+static apx_error_t apx_clientShmConnection_vfillTransmitHandler(void *arg, apx_transmitHandler_t *handler)
+{
+   return apx_clientShmConnection_fillTransmitHandler((apx_clientShmConnection_t*) arg, handler);
+}
+
+static uint8_t *apx_clientShmConnection_getSendBuffer(void *arg, int32_t msgLen)
+{
+   apx_clientShmConnection_t *self = (apx_clientShmConnection_t*) arg;
+   if (self != 0)
+   {
+      int8_t result=0;
+      int32_t requestedLen;
+      //create a buffer where we have room to encode the message header (the length of the message) in addition to the user requested length
+      int32_t currentLen = adt_bytearray_length(&self->sendBuffer);
+      requestedLen= msgLen + self->base.base.numHeaderLen;
+      if (currentLen<requestedLen)
+      {
+         result = adt_bytearray_resize(&self->sendBuffer, (uint32_t) requestedLen);
+      }
+      if (result == 0)
+      {
+         uint8_t *data = adt_bytearray_data(&self->sendBuffer);
+         assert(data != 0);
+         return &data[self->base.base.numHeaderLen];
+      }
+   }
+   return 0;
+}
+
+/**
+ * Returns the number transmitted (msgLen) or less. On error it returns -1;
+ */
+static int32_t apx_clientShmConnection_send(void *arg, int32_t offset, int32_t msgLen)
+{
+   apx_clientShmConnection_t *self = (apx_clientShmConnection_t*) arg;
+   if ( (self != 0) && (self->isChannelValid) && (offset>=0) && (msgLen>=0) )
+   {
+      int32_t sendBufferLen;
+      uint8_t *sendBuffer = adt_bytearray_data(&self->sendBuffer);
+      sendBufferLen = adt_bytearray_length(&self->sendBuffer);
+      if ((sendBuffer != 0) && (msgLen+self->base.base.numHeaderLen<=sendBufferLen) )
+      {
+         uint8_t header[sizeof(uint32_t)];
+         uint8_t headerLen;
+         uint8_t *headerEnd;
+         uint8_t *pBegin;
+         if (self->base.base.numHeaderLen == (uint8_t) sizeof(uint32_t))
+         {
+            headerEnd = header+numheader_encode32(header, (uint32_t) sizeof(header), msgLen);
+            if (headerEnd>header)
+            {
+               headerLen=(uint8_t) (headerEnd-header);
+            }
+            else
+            {
+               assert(0);
+               return -1; //header buffer too small
+            }
+         }
+         else
+         {
+            return -1; //16-bit header not yet implemented
+         }
+         //place header just before user data begin
+         pBegin = sendBuffer+(self->base.base.numHeaderLen+offset-headerLen); //the part in the parenthesis is where the user data begins
+         memcpy(pBegin, header, headerLen);
+#if APX_DEBUG_ENABLE
+         printf("[CLIENT-SHM] Sending %d+%d bytes\n", (int)headerLen, (int)msgLen);
+#endif
+         if (apx_shmChannel_write(&self->channel, pBegin, (uint32_t) (msgLen+headerLen)) < 0)
+         {
+            return -1;
+         }
+         self->base.base.totalBytesSent+=msgLen+headerLen;
+         return msgLen;
+      }
+      else
+      {
+         assert(0);
+      }
+   }
+   return -1;
+}
+
+/**
+ * Sends one or more messages already framed with numheader by the caller
+ */
+static int32_t apx_clientShmConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   apx_clientShmConnection_t *self = (apx_clientShmConnection_t*) arg;
+   if ( (self != 0) && (self->isChannelValid) && (data != 0) && (dataLen >= 0) )
+   {
+      int32_t result;
+#if APX_DEBUG_ENABLE
+      printf("[CLIENT-SHM] Sending batch of %d bytes\n", (int)dataLen);
+#endif
+      result = apx_shmChannel_write(&self->channel, data, (uint32_t) dataLen);
+      if (result > 0)
+      {
+         self->base.base.totalBytesSent+=dataLen;
+      }
+      return result;
+   }
+   return -1;
+}
+
+static void apx_clientShmConnection_data(void *arg, const uint8_t *data, uint32_t dataLen)
+{
+   apx_clientShmConnection_t *self = (apx_clientShmConnection_t*) arg;
+   uint32_t parseLen = 0u;
+   if (adt_bytearray_length(&self->receiveBuffer) == 0u)
+   {
+      if ( (apx_clientConnectionBase_onDataReceived(&self->base, data, dataLen, &parseLen) == 0) && (parseLen < dataLen) )
+      {
+         adt_bytearray_append(&self->receiveBuffer, data + parseLen, dataLen - parseLen);
+      }
+   }
+   else
+   {
+      adt_bytearray_append(&self->receiveBuffer, data, dataLen);
+      if (apx_clientConnectionBase_onDataReceived(&self->base, adt_bytearray_data(&self->receiveBuffer), adt_bytearray_length(&self->receiveBuffer), &parseLen) == 0)
+      {
+         adt_bytearray_trimLeft(&self->receiveBuffer, adt_bytearray_data(&self->receiveBuffer) + parseLen);
+      }
+   }
+}
+
+static THREAD_PROTO(apx_clientShmConnection_receiveTask, arg)
+{
+   apx_clientShmConnection_t *self = (apx_clientShmConnection_t*) arg;
+   if (self != 0)
+   {
+      for (;;)
+      {
+         (void) apx_shmChannel_read(&self->channel, apx_clientShmConnection_data, self);
+         if (apx_shmChannel_wait(&self->channel, self->sockFd, APX_SHM_WAIT_FOREVER) != APX_NO_ERROR)
+         {
+            break;
+         }
+      }
+#if APX_DEBUG_ENABLE
+      printf("[CLIENT-SHM] Disconnected\n");
+#endif
+      if (!self->isDestroying)
+      {
+         apx_clientConnectionBase_disconnectedCbk(&self->base);
+      }
+   }
+   THREAD_RETURN(0);
+}
+
+static void apx_clientShmConnection_stopThread(apx_clientShmConnection_t *self)
+{
+   if (self->isThreadRunning)
+   {
+      if (pthread_equal(pthread_self(), self->receiveThread) == 0)
+      {
+         void *status;
+         int s;
+         apx_shmChannel_close(&self->channel);
+         s = pthread_join(self->receiveThread, &status);
+         if (s != 0)
+         {
+            APX_LOG_ERROR("[APX_CLIENT_SHM_CONNECTION] pthread_join error %d", s);
+         }
+      }
+      else
+      {
+         APX_LOG_ERROR("[APX_CLIENT_SHM_CONNECTION] pthread_join attempted on pthread_self()");
+      }
+      self->isThreadRunning = false;
+   }
+}
+
+/**
+ * Closes the shared region. The receive thread notices and reports the disconnect.
+ */
+static void apx_clientShmConnection_close(apx_clientShmConnection_t *self)
+{
+   if ( (self != 0) && (self->isChannelValid) )
+   {
+      apx_shmChannel_close(&self->channel);
+      shutdown(self->sockFd, SHUT_RDWR);
+   }
+}
+
+static void apx_clientShmConnection_vclose(void *arg)
+{
+   apx_clientShmConnection_close((apx_clientShmConnection_t*) arg);
+}
+
+static void apx_clientShmConnection_start(apx_clientShmConnection_t *self)
+{
+   apx_clientConnectionBase_start(&self->base);
+}
+
+static void apx_clientShmConnection_vstart(void *arg)
+{
+   apx_clientShmConnection_start((apx_clientShmConnection_t*) arg);
+}
+
+#endif //APX_SHM_SUPPORTED
@@ -84,6 +84,7 @@ static apx_error_t apx_clientSocketConnection_vfillTransmitHandler(void *arg, ap
 static void apx_clientSocketConnection_registerSocketHandler(apx_clientSocketConnection_t *self, SOCKET_TYPE *socketObject);
 static uint8_t *apx_clientSocketConnection_getSendBuffer(void *arg, int32_t msgLen);
 static int32_t apx_clientSocketConnection_send(void *arg, int32_t offset, int32_t msgLen);
+static int32_t apx_clientSocketConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
 static void apx_clientSocketConnection_connected(void *arg, const char *addr, uint16_t port);
 static int8_t apx_clientSocketConnection_data(void *arg, const uint8_t *dataBuf, uint32_t dataLen, uint32_t *parseLen);
 static void apx_clientSocketConnection_disconnected(void *arg);
@@ -247,6 +248,7 @@ static apx_error_t apx_clientSocketConnection_fillTransmitHandler(apx_clientSock
       handler->send = apx_clientSocketConnection_send;
       handler->getSendAvail = 0;
       handler->getSendBuffer = apx_clientSocketConnection_getSendBuffer;
+      handler->sendBatch = apx_clientSocketConnection_sendBatch;
       return APX_NO_ERROR;
    }
    return APX_INVALID_ARGUMENT_ERROR;
@@ -337,10 +339,11 @@ static int32_t apx_clientSocketConnection_send(void *arg, int32_t offset, int32_
          printf("[CLIENT-CONNECTION] Sending %d+%d bytes\n", (int)headerLen, (int)msgLen);
 #endif
          result = SOCKET_SEND(self->socketObject, pBegin, msgLen+headerLen);
-         if (result == 0)
+         if (result != 0)
          {
-            self->base.base.totalBytesSent+=msgLen+headerLen;
+            return -1;
          }
+         self->base.base.totalBytesSent+=msgLen+headerLen;
          return msgLen;
       }
       else
@@ -351,6 +354,28 @@ static int32_t apx_clientSocketConnection_send(void *arg, int32_t offset, int32_
    return -1;
 }
 
+/**
+ * Sends one or more messages already framed with numheader by the caller
+ */
+static int32_t apx_clientSocketConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   apx_clientSocketConnection_t *self = (apx_clientSocketConnection_t*) arg;
+   if ( (self != 0) && (self->socketObject != 0) && (data != 0) && (dataLen >= 0) )
+   {
+#if APX_DEBUG_ENABLE
+      printf("[CLIENT-CONNECTION] Sending batch of %d bytes\n", (int)dataLen);
+#endif
+      int8_t result = SOCKET_SEND(self->socketObject, data, dataLen);
+      if (result != 0)
+      {
+         return -1;
+      }
+      self->base.base.totalBytesSent+=dataLen;
+      return dataLen;
+   }
+   return -1;
+}
+
 static void apx_clientSocketConnection_connected(void *arg, const char *addr, uint16_t port)
 {
    apx_clientSocketConnection_t *self;
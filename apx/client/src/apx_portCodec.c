@@ -0,0 +1,208 @@
+/*****************************************************************************
+* \file      apx_portCodec.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Port handle with its own virtual machine for lock-free encode/decode of port data
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <assert.h>
+#include "apx_portCodec.h"
+#include "apx_nodeInstance.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_portCodec_create(apx_portCodec_t *self, apx_portRef_t *portRef)
+{
+   if ( (self != 0) && (portRef != 0) && (portRef->nodeInstance != 0) && (portRef->portDataProps != 0) )
+   {
+      apx_error_t result;
+      const adt_bytes_t *portProgram;
+      if (!apx_portDataProps_isPlainOldData(portRef->portDataProps))
+      {
+         return APX_NOT_IMPLEMENTED_ERROR; ///TODO: Implement dynamic array and queued signals later
+      }
+      self->portRef = portRef;
+      self->isProvidePort = apx_portRef_isProvidePort(portRef);
+      self->dataSize = portRef->portDataProps->dataSize;
+      if (self->isProvidePort)
+      {
+         portProgram = apx_nodeInstance_getProvidePortPackProgram(portRef->nodeInstance, apx_portRef_getPortId(portRef));
+      }
+      else
+      {
+         portProgram = apx_nodeInstance_getRequirePortUnpackProgram(portRef->nodeInstance, apx_portRef_getPortId(portRef));
+      }
+      if (portProgram == 0)
+      {
+         return APX_INVALID_PROGRAM_ERROR;
+      }
+      self->buffer = (uint8_t*) malloc(self->dataSize);
+      if (self->buffer == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      apx_vm_create(&self->vm);
+      result = apx_vm_selectProgram(&self->vm, portProgram);
+      if (result != APX_NO_ERROR)
+      {
+         apx_vm_destroy(&self->vm);
+         free(self->buffer);
+         return result;
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_portCodec_destroy(apx_portCodec_t *self)
+{
+   if (self != 0)
+   {
+      apx_vm_destroy(&self->vm);
+      if (self->buffer != 0)
+      {
+         free(self->buffer);
+      }
+   }
+}
+
+apx_portCodec_t *apx_portCodec_new(apx_portRef_t *portRef, apx_error_t *errorCode)
+{
+   apx_portCodec_t *self = (apx_portCodec_t*) malloc(sizeof(apx_portCodec_t));
+   if (self != 0)
+   {
+      apx_error_t result = apx_portCodec_create(self, portRef);
+      if (result != APX_NO_ERROR)
+      {
+         free(self);
+         self = (apx_portCodec_t*) 0;
+      }
+      if (errorCode != 0)
+      {
+         *errorCode = result;
+      }
+   }
+   else if (errorCode != 0)
+   {
+      *errorCode = APX_MEM_ERROR;
+   }
+   return self;
+}
+
+void apx_portCodec_delete(apx_portCodec_t *self)
+{
+   if (self != 0)
+   {
+      apx_portCodec_destroy(self);
+      free(self);
+   }
+}
+
+void apx_portCodec_vdelete(void *arg)
+{
+   apx_portCodec_delete((apx_portCodec_t*) arg);
+}
+
+apx_portRef_t *apx_portCodec_getPortRef(apx_portCodec_t *self)
+{
+   if (self != 0)
+   {
+      return self->portRef;
+   }
+   return (apx_portRef_t*) 0;
+}
+
+/**
+ * Packs value using the preselected pack program and writes the result into the provide port data of the node instance.
+ */
+apx_error_t apx_portCodec_write(apx_portCodec_t *self, const dtl_dv_t *value)
+{
+   if ( (self != 0) && (value != 0) )
+   {
+      apx_error_t result;
+      if (!self->isProvidePort)
+      {
+         return APX_INVALID_PORT_HANDLE_ERROR;
+      }
+      result = apx_vm_setWriteBuffer(&self->vm, self->buffer, self->dataSize);
+      if (result == APX_NO_ERROR)
+      {
+         result = apx_vm_packValue(&self->vm, value);
+      }
+      if (result == APX_NO_ERROR)
+      {
+         result = apx_nodeInstance_writeProvidePortDataById(self->portRef->nodeInstance, apx_portRef_getPortId(self->portRef), self->buffer, self->dataSize);
+      }
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Reads the require port data of the node instance and unpacks it using the preselected unpack program.
+ */
+apx_error_t apx_portCodec_read(apx_portCodec_t *self, dtl_dv_t **dv)
+{
+   if ( (self != 0) && (dv != 0) )
+   {
+      apx_error_t result;
+      if (self->isProvidePort)
+      {
+         return APX_INVALID_PORT_HANDLE_ERROR;
+      }
+      result = apx_nodeInstance_readRequirePortData(self->portRef->nodeInstance, self->buffer, self->portRef->portDataProps->offset, self->dataSize);
+      if (result == APX_NO_ERROR)
+      {
+         result = apx_vm_setReadBuffer(&self->vm, self->buffer, self->dataSize);
+      }
+      if (result == APX_NO_ERROR)
+      {
+         result = apx_vm_unpackValue(&self->vm, dv);
+      }
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
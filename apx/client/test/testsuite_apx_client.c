@@ -119,9 +119,16 @@ static const char *m_apx_definition12 = "APX/1.2\n"
       "R\"String8\"a[8]:=\"\342\204\203\"\n" //degrees Centigrade symbol U+2103
       "\n";
 
+static const char *m_apx_definition13 = "APX/1.2\n"
+      "N\"TestNode13\"\n"
+      "P\"TxArray\"S[200]\n"
+      "R\"RxArray\"S[200]\n"
+      "\n";
+
 
 #define UNSIGNED_ARRAY_LEN 3
 #define SIGNED_ARRAY_LEN   4
+#define LARGE_ARRAY_LEN    200
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
@@ -176,6 +183,21 @@ static void test_apx_client_readPortData_dtl_string(CuTest* tc);
 static void test_apx_client_readPortData_dtl_string_unicode_init(CuTest* tc);
 static void test_apx_client_writePortData_dtl_string_inside_record(CuTest* tc);
 static void test_apx_client_readPortData_dtl_string_inside_record(CuTest* tc);
+static void test_apx_client_portCodec_write_u16(CuTest* tc);
+static void test_apx_client_portCodec_read_u32(CuTest* tc);
+static void test_apx_client_portCodec_wrongDirection(CuTest* tc);
+static void test_apx_client_vmPoolReusedAfterWrite(CuTest* tc);
+static void test_apx_client_writePortData_direct_s16(CuTest* tc);
+static void test_apx_client_readPortData_direct_s32(CuTest* tc);
+static void test_apx_client_writePortData_direct_bool(CuTest* tc);
+static void test_apx_client_writePortData_direct_u16_array(CuTest* tc);
+static void test_apx_client_readPortData_direct_u32_array(CuTest* tc);
+static void test_apx_client_writePortData_direct_s16_array(CuTest* tc);
+static void test_apx_client_readPortData_direct_s8_array(CuTest* tc);
+static void test_apx_client_writePortData_direct_bytes(CuTest* tc);
+static void test_apx_client_writePortData_direct_wrongLayout(CuTest* tc);
+static void test_apx_client_portData_direct_largeArray(CuTest* tc);
+static void test_apx_client_writePortData_onChange(CuTest* tc);
 
 
 
@@ -233,6 +255,21 @@ CuSuite* testSuite_apx_client(void)
    SUITE_ADD_TEST(suite, test_apx_client_readPortData_dtl_string_unicode_init);
    SUITE_ADD_TEST(suite, test_apx_client_writePortData_dtl_string_inside_record);
    SUITE_ADD_TEST(suite, test_apx_client_readPortData_dtl_string_inside_record);
+   SUITE_ADD_TEST(suite, test_apx_client_portCodec_write_u16);
+   SUITE_ADD_TEST(suite, test_apx_client_portCodec_read_u32);
+   SUITE_ADD_TEST(suite, test_apx_client_portCodec_wrongDirection);
+   SUITE_ADD_TEST(suite, test_apx_client_vmPoolReusedAfterWrite);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_direct_s16);
+   SUITE_ADD_TEST(suite, test_apx_client_readPortData_direct_s32);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_direct_bool);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_direct_u16_array);
+   SUITE_ADD_TEST(suite, test_apx_client_readPortData_direct_u32_array);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_direct_s16_array);
+   SUITE_ADD_TEST(suite, test_apx_client_readPortData_direct_s8_array);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_direct_bytes);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_direct_wrongLayout);
+   SUITE_ADD_TEST(suite, test_apx_client_portData_direct_largeArray);
+   SUITE_ADD_TEST(suite, test_apx_client_writePortData_onChange);
 
 
 
@@ -2011,3 +2048,389 @@ static void test_apx_client_readPortData_dtl_string_inside_record(CuTest* tc)
 
    apx_client_delete(client);
 }
+
+static void test_apx_client_portCodec_write_u16(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE;
+   void *U16ValueHandle;
+   uint8_t rawData[UINT16_SIZE] = {0, 0};
+   apx_nodeInstance_t *nodeInstance;
+   apx_portCodec_t *codec;
+   apx_error_t errorCode = APX_NO_ERROR;
+   apx_client_t *client = apx_client_new();
+   dtl_sv_t *sv = dtl_sv_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition1));
+   U16ValueHandle = apx_client_getPortHandle(client, NULL, "U16Value");
+   CuAssertPtrNotNull(tc, U16ValueHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+   codec = apx_client_createPortCodec(client, U16ValueHandle, &errorCode);
+   CuAssertIntEquals(tc, APX_NO_ERROR, errorCode);
+   CuAssertPtrNotNull(tc, codec);
+   CuAssertPtrEquals(tc, U16ValueHandle, apx_portCodec_getPortRef(codec));
+
+   dtl_sv_set_u32(sv, 0x1234);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portCodec_write(codec, (dtl_dv_t*) sv));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&rawData[0], UINT16_SIZE));
+
+   dtl_sv_set_u32(sv, 0xABCD);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portCodec_write(codec, (dtl_dv_t*) sv));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0xABCD, unpackLE(&rawData[0], UINT16_SIZE));
+
+   apx_portCodec_delete(codec);
+   apx_client_delete(client);
+   dtl_dec_ref((dtl_dv_t*) sv);
+}
+
+static void test_apx_client_portCodec_read_u32(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE + UINT16_SIZE;
+   void *U32ValueHandle;
+   uint8_t rawData[UINT32_SIZE];
+   apx_nodeInstance_t *nodeInstance;
+   apx_portCodec_t *codec;
+   apx_error_t errorCode = APX_NO_ERROR;
+   dtl_dv_t *dv = 0;
+   bool ok = false;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition2));
+   U32ValueHandle = apx_client_getPortHandle(client, NULL, "U32Value");
+   CuAssertPtrNotNull(tc, U32ValueHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+   codec = apx_client_createPortCodec(client, U32ValueHandle, &errorCode);
+   CuAssertIntEquals(tc, APX_NO_ERROR, errorCode);
+   CuAssertPtrNotNull(tc, codec);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portCodec_read(codec, &dv));
+   CuAssertPtrNotNull(tc, dv);
+   CuAssertUIntEquals(tc, 0xFFFFFFFF, dtl_sv_to_u32((dtl_sv_t*) dv, &ok));
+   CuAssertTrue(tc, ok);
+   dtl_dv_dec_ref(dv);
+   dv = 0;
+   ok = false;
+
+   packLE(rawData, 0x12345678, UINT32_SIZE);
+   apx_nodeInstance_writeRequirePortData(nodeInstance, rawData, offset, UINT32_SIZE);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portCodec_read(codec, &dv));
+   CuAssertPtrNotNull(tc, dv);
+   CuAssertUIntEquals(tc, 0x12345678, dtl_sv_to_u32((dtl_sv_t*) dv, &ok));
+   CuAssertTrue(tc, ok);
+   dtl_dv_dec_ref(dv);
+
+   apx_portCodec_delete(codec);
+   apx_client_delete(client);
+}
+
+static void test_apx_client_portCodec_wrongDirection(CuTest* tc)
+{
+   void *U8ValueHandle;
+   apx_portCodec_t *codec;
+   dtl_dv_t *dv = 0;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition1));
+   U8ValueHandle = apx_client_getPortHandle(client, NULL, "U8Value");
+   codec = apx_client_createPortCodec(client, U8ValueHandle, NULL);
+   CuAssertPtrNotNull(tc, codec);
+   CuAssertIntEquals(tc, APX_INVALID_PORT_HANDLE_ERROR, apx_portCodec_read(codec, &dv));
+   CuAssertPtrEquals(tc, NULL, dv);
+   apx_portCodec_delete(codec);
+   apx_client_delete(client);
+}
+
+static void test_apx_client_vmPoolReusedAfterWrite(CuTest* tc)
+{
+   void *U8ValueHandle;
+   void *U32ValueHandle;
+   apx_client_t *client = apx_client_new();
+   dtl_sv_t *sv = dtl_sv_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition1));
+   U8ValueHandle = apx_client_getPortHandle(client, NULL, "U8Value");
+   U32ValueHandle = apx_client_getPortHandle(client, NULL, "U32Value");
+   CuAssertIntEquals(tc, 0, client->vmPoolLen);
+   dtl_sv_set_u32(sv, 0x12);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData(client, U8ValueHandle, (dtl_dv_t*) sv));
+   CuAssertIntEquals(tc, 1, client->vmPoolLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData(client, U32ValueHandle, (dtl_dv_t*) sv));
+   CuAssertIntEquals(tc, 1, client->vmPoolLen);
+   apx_client_delete(client);
+   dtl_dec_ref((dtl_dv_t*) sv);
+}
+
+static void test_apx_client_writePortData_direct_s16(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE;
+   void *S16ValueHandle;
+   uint8_t rawData[UINT16_SIZE] = {0, 0};
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition5));
+   S16ValueHandle = apx_client_getPortHandle(client, NULL, "S16Value");
+   CuAssertPtrNotNull(tc, S16ValueHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_s16(client, S16ValueHandle, -2));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0xFE, rawData[0]);
+   CuAssertUIntEquals(tc, 0xFF, rawData[1]);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_s16(client, S16ValueHandle, 0x1234));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x34, rawData[0]);
+   CuAssertUIntEquals(tc, 0x12, rawData[1]);
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_readPortData_direct_s32(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE + UINT16_SIZE;
+   void *S32ValueHandle;
+   uint8_t rawData[UINT32_SIZE];
+   int32_t value = 0;
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition6));
+   S32ValueHandle = apx_client_getPortHandle(client, NULL, "S32Value");
+   CuAssertPtrNotNull(tc, S32ValueHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_readPortData_s32(client, S32ValueHandle, &value));
+   CuAssertIntEquals(tc, -1, value);
+   packLE(&rawData[0], (uint32_t) -100000, UINT32_SIZE);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_writeRequirePortData(nodeInstance, &rawData[0], offset, UINT32_SIZE));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_readPortData_s32(client, S32ValueHandle, &value));
+   CuAssertIntEquals(tc, -100000, value);
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_writePortData_direct_bool(CuTest* tc)
+{
+   const uint32_t offset = 0u;
+   void *U8ValueHandle;
+   uint8_t rawData[UINT8_SIZE] = {0xAA};
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition1));
+   U8ValueHandle = apx_client_getPortHandle(client, NULL, "U8Value");
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_bool(client, U8ValueHandle, true));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT8_SIZE));
+   CuAssertUIntEquals(tc, 1u, rawData[0]);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_bool(client, U8ValueHandle, false));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT8_SIZE));
+   CuAssertUIntEquals(tc, 0u, rawData[0]);
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_writePortData_direct_u16_array(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE * UNSIGNED_ARRAY_LEN;
+   void *U16ArrayHandle;
+   uint16_t values[UNSIGNED_ARRAY_LEN] = {0x1234, 0x0000, 0xABCD};
+   uint8_t rawData[UINT16_SIZE * UNSIGNED_ARRAY_LEN];
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition3));
+   U16ArrayHandle = apx_client_getPortHandle(client, NULL, "U16Array");
+   CuAssertPtrNotNull(tc, U16ArrayHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u16_array(client, U16ArrayHandle, &values[0], UNSIGNED_ARRAY_LEN));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, (apx_size_t) sizeof(rawData)));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&rawData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x0000, unpackLE(&rawData[2], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0xABCD, unpackLE(&rawData[4], UINT16_SIZE));
+   CuAssertIntEquals(tc, APX_LENGTH_ERROR, apx_client_writePortData_u16_array(client, U16ArrayHandle, &values[0], UNSIGNED_ARRAY_LEN - 1));
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_readPortData_direct_u32_array(CuTest* tc)
+{
+   const uint32_t offset = (UINT8_SIZE + UINT16_SIZE) * UNSIGNED_ARRAY_LEN;
+   void *U32ArrayHandle;
+   uint32_t values[UNSIGNED_ARRAY_LEN] = {0, 0, 0};
+   uint8_t rawData[UINT32_SIZE * UNSIGNED_ARRAY_LEN];
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition4));
+   U32ArrayHandle = apx_client_getPortHandle(client, NULL, "U32Array");
+   CuAssertPtrNotNull(tc, U32ArrayHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_readPortData_u32_array(client, U32ArrayHandle, &values[0], UNSIGNED_ARRAY_LEN));
+   CuAssertUIntEquals(tc, 0xFFFFFFFF, values[0]);
+   CuAssertUIntEquals(tc, 0xFFFFFFFF, values[2]);
+   packLE(&rawData[0], 0x12345678, UINT32_SIZE);
+   packLE(&rawData[4], 0x0, UINT32_SIZE);
+   packLE(&rawData[8], 0x9ABCDEF0, UINT32_SIZE);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_writeRequirePortData(nodeInstance, &rawData[0], offset, (apx_size_t) sizeof(rawData)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_readPortData_u32_array(client, U32ArrayHandle, &values[0], UNSIGNED_ARRAY_LEN));
+   CuAssertUIntEquals(tc, 0x12345678, values[0]);
+   CuAssertUIntEquals(tc, 0x0, values[1]);
+   CuAssertUIntEquals(tc, 0x9ABCDEF0, values[2]);
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_writePortData_direct_s16_array(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE * SIGNED_ARRAY_LEN;
+   void *S16ArrayHandle;
+   int16_t values[SIGNED_ARRAY_LEN] = {-1, 0, 32767, -32768};
+   uint8_t rawData[UINT16_SIZE * SIGNED_ARRAY_LEN];
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition7));
+   S16ArrayHandle = apx_client_getPortHandle(client, NULL, "S16Array");
+   CuAssertPtrNotNull(tc, S16ArrayHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_s16_array(client, S16ArrayHandle, &values[0], SIGNED_ARRAY_LEN));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, (apx_size_t) sizeof(rawData)));
+   CuAssertUIntEquals(tc, 0xFFFF, unpackLE(&rawData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x0000, unpackLE(&rawData[2], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x7FFF, unpackLE(&rawData[4], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x8000, unpackLE(&rawData[6], UINT16_SIZE));
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_readPortData_direct_s8_array(CuTest* tc)
+{
+   const uint32_t offset = 0u;
+   void *S8ArrayHandle;
+   int8_t values[SIGNED_ARRAY_LEN] = {0, 0, 0, 0};
+   uint8_t rawData[UINT8_SIZE * SIGNED_ARRAY_LEN] = {0x80, 0x7F, 0x00, 0xFE};
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition8));
+   S8ArrayHandle = apx_client_getPortHandle(client, NULL, "S8Array");
+   CuAssertPtrNotNull(tc, S8ArrayHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_writeRequirePortData(nodeInstance, &rawData[0], offset, (apx_size_t) sizeof(rawData)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_readPortData_s8_array(client, S8ArrayHandle, &values[0], SIGNED_ARRAY_LEN));
+   CuAssertIntEquals(tc, -128, values[0]);
+   CuAssertIntEquals(tc, 127, values[1]);
+   CuAssertIntEquals(tc, 0, values[2]);
+   CuAssertIntEquals(tc, -2, values[3]);
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_writePortData_direct_bytes(CuTest* tc)
+{
+   const uint32_t offset = 0u;
+   void *ColorSettingHandle;
+   const uint8_t color[3] = {0x12, 0x34, 0x56};
+   uint8_t rawData[3];
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition9));
+   ColorSettingHandle = apx_client_getPortHandle(client, NULL, "ColorSetting");
+   CuAssertPtrNotNull(tc, ColorSettingHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_bytes(client, ColorSettingHandle, &color[0], (apx_size_t) sizeof(color)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, (apx_size_t) sizeof(rawData)));
+   CuAssertIntEquals(tc, 0, memcmp(&color[0], &rawData[0], sizeof(color)));
+   CuAssertIntEquals(tc, APX_LENGTH_ERROR, apx_client_writePortData_bytes(client, ColorSettingHandle, &color[0], 2u));
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_writePortData_direct_wrongLayout(CuTest* tc)
+{
+   void *U16ValueHandle;
+   void *U8ArrayHandle;
+   uint8_t values[UNSIGNED_ARRAY_LEN] = {1, 2, 3};
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition1));
+   U16ValueHandle = apx_client_getPortHandle(client, NULL, "U16Value");
+   CuAssertIntEquals(tc, APX_INVALID_INSTRUCTION_ERROR, apx_client_writePortData_s16(client, U16ValueHandle, 1));
+   CuAssertIntEquals(tc, APX_INVALID_INSTRUCTION_ERROR, apx_client_writePortData_u32(client, U16ValueHandle, 1u));
+   CuAssertIntEquals(tc, APX_INVALID_INSTRUCTION_ERROR, apx_client_writePortData_u16_array(client, U16ValueHandle, (const uint16_t*) &values[0], 1u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition3));
+   U8ArrayHandle = apx_client_getPortHandle(client, NULL, "U8Array");
+   CuAssertIntEquals(tc, APX_INVALID_INSTRUCTION_ERROR, apx_client_writePortData_u8(client, U8ArrayHandle, 1u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u8_array(client, U8ArrayHandle, &values[0], UNSIGNED_ARRAY_LEN));
+   apx_client_delete(client);
+}
+
+static void test_apx_client_portData_direct_largeArray(CuTest* tc)
+{
+   void *TxArrayHandle;
+   void *RxArrayHandle;
+   uint16_t values[LARGE_ARRAY_LEN];
+   uint8_t rawData[UINT16_SIZE * LARGE_ARRAY_LEN];
+   apx_nodeInstance_t *nodeInstance;
+   uint32_t i;
+   apx_client_t *client = apx_client_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition13));
+   TxArrayHandle = apx_client_getPortHandle(client, NULL, "TxArray");
+   RxArrayHandle = apx_client_getPortHandle(client, NULL, "RxArray");
+   CuAssertPtrNotNull(tc, TxArrayHandle);
+   CuAssertPtrNotNull(tc, RxArrayHandle);
+   nodeInstance = apx_client_getLastAttachedNode(client);
+
+   //Larger than any stack buffer, packed straight into the port data
+   for (i = 0u; i < LARGE_ARRAY_LEN; i++)
+   {
+      values[i] = (uint16_t) (0x1000u + i);
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u16_array(client, TxArrayHandle, &values[0], LARGE_ARRAY_LEN));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], 0u, (apx_size_t) sizeof(rawData)));
+   CuAssertUIntEquals(tc, 0x1000, unpackLE(&rawData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x1000 + LARGE_ARRAY_LEN - 1, unpackLE(&rawData[UINT16_SIZE * (LARGE_ARRAY_LEN - 1)], UINT16_SIZE));
+
+   for (i = 0u; i < LARGE_ARRAY_LEN; i++)
+   {
+      packLE(&rawData[i * UINT16_SIZE], 0x2000u + i, UINT16_SIZE);
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_writeRequirePortData(nodeInstance, &rawData[0], 0u, (apx_size_t) sizeof(rawData)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_readPortData_u16_array(client, RxArrayHandle, &values[0], LARGE_ARRAY_LEN));
+   CuAssertUIntEquals(tc, 0x2000, values[0]);
+   CuAssertUIntEquals(tc, 0x2000 + LARGE_ARRAY_LEN - 1, values[LARGE_ARRAY_LEN - 1]);
+   CuAssertIntEquals(tc, APX_LENGTH_ERROR, apx_client_readPortData_u16_array(client, RxArrayHandle, &values[0], LARGE_ARRAY_LEN - 1));
+
+   apx_client_delete(client);
+}
+
+static void test_apx_client_writePortData_onChange(CuTest* tc)
+{
+   const uint32_t offset = UINT8_SIZE;
+   void *U16ValueHandle;
+   void *U8ValueHandle;
+   uint8_t rawData[UINT16_SIZE] = {0, 0};
+   apx_nodeInstance_t *nodeInstance;
+   apx_client_t *client = apx_client_new();
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_buildNode_cstr(client, m_apx_definition1));
+   U16ValueHandle = apx_client_getPortHandle(client, NULL, "U16Value");
+   U8ValueHandle = apx_client_getPortHandle(client, NULL, "U8Value");
+   nodeInstance = apx_client_getLastAttachedNode(client);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_setPortWriteMode(client, U16ValueHandle, APX_PORT_WRITE_MODE_ON_CHANGE, 0u));
+
+   //Init value is 0xFFFF
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u16(client, U16ValueHandle, 0xffff));
+   CuAssertUIntEquals(tc, 1u, apx_client_getSuppressedWriteCount(client, U16ValueHandle));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u16(client, U16ValueHandle, 0x1234));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readProvidePortData(nodeInstance, &rawData[0], offset, UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x34, rawData[0]);
+   CuAssertUIntEquals(tc, 0x12, rawData[1]);
+   CuAssertUIntEquals(tc, 1u, apx_client_getSuppressedWriteCount(client, U16ValueHandle));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u16(client, U16ValueHandle, 0x1234));
+   CuAssertUIntEquals(tc, 2u, apx_client_getSuppressedWriteCount(client, U16ValueHandle));
+
+   //Ports that have not opted in are never suppressed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u8(client, U8ValueHandle, 7u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_client_writePortData_u8(client, U8ValueHandle, 7u));
+   CuAssertUIntEquals(tc, 0u, apx_client_getSuppressedWriteCount(client, U8ValueHandle));
+
+   apx_client_delete(client);
+}
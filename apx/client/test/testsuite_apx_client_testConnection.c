@@ -301,6 +301,7 @@ static void test_localFileInfoShallBeSentAfterHeaderAcknowledge(CuTest* tc)
    CuAssertIntEquals(tc, dataLen , rmf_deserialize_cmdFileInfo(data, dataLen, &fileInfo));
    CuAssertUIntEquals(tc, APX_ADDRESS_DEFINITION_START, fileInfo.address);
    CuAssertStrEquals(tc, "TestNode1.apx", &fileInfo.name[0]);
+   CuAssertUIntEquals(tc, RMF_DIGEST_TYPE_SHA256, fileInfo.digestType);
 
    cmdType = 0u;
    msg = apx_clientTestConnection_getTransmitLogMsg(connection, 3);
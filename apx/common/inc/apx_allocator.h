@@ -6,6 +6,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "apx_types.h"
 #include "apx_error.h"
+#include "apx_cfg.h"
 
 #ifdef _WIN32
 # ifndef WIN32_LEAN_AND_MEAN
@@ -14,42 +15,54 @@
 #include <Windows.h>
 #else
 #include <pthread.h>
-#include <semaphore.h>
 #endif
 #include "osmacro.h"
-#include "adt_ringbuf.h"
-#include "soa.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#define APX_ALLOCATOR_GRANULARITY 8u //all block sizes are multiples of this value
 
 /**
- * this is a simple small object allocator with built-in garbage collector thread
+ * A size class hands out fixed-size blocks carved from slabs.
+ * Allocation pops from freeList (protected by lock). Free pushes onto remoteFreeList using
+ * compare-and-swap so the thread releasing memory (usually the file manager worker) never takes a lock.
+ * When freeList runs empty the allocating thread takes the entire remoteFreeList in one atomic exchange.
  */
-typedef struct apx_allocator_tag
+typedef struct apx_allocatorSizeClass_tag
 {
-   THREAD_T workerThread; //local worker thread
-   SPINLOCK_T lock;  //variable lock
-   SEMAPHORE_T semaphore; //thread semaphore
-
-   //data object, all read/write accesses to these must be protected by the lock variable above
-   adt_rbfh_t messages; //pending cleanup messages (ringbuffer)
-   bool isRunning; //when false it's time do shut down
-   bool workerThreadValid; //true if workerThread is a valid variable
-   soa_t soa;
+   SPINLOCK_T lock; //protects freeList, slabs, numHits and numMisses
+   void *freeList; //blocks ready for allocation
+   void * volatile remoteFreeList; //blocks returned by apx_allocator_free
+   void *slabs; //linked list of slabs owned by this size class
+   uint32_t blockSize;
+   uint32_t numHits;
+   uint32_t numMisses;
+} apx_allocatorSizeClass_t;
 
-#ifdef _MSC_VER
-   unsigned int threadId;
-#endif
-}apx_allocator_t;
+/**
+ * Per-connection small object allocator with fixed size classes.
+ * Default power-of-two classes are created by apx_allocator_create. Exact size classes for known port data sizes
+ * can be added later using apx_allocator_addSizeClass. Size classes are never removed while the allocator is alive.
+ */
+typedef struct apx_allocator_tag
+{
+   MUTEX_T mutex; //serializes apx_allocator_addSizeClass
+   apx_allocatorSizeClass_t sizeClasses[APX_ALLOCATOR_MAX_SIZE_CLASSES];
+   uint32_t numSizeClasses;
+   volatile uint8_t classIndex[APX_ALLOCATOR_MAX_BLOCK_SIZE / APX_ALLOCATOR_GRANULARITY + 1]; //maps size in granules to smallest fitting size class
+   volatile uint32_t numFrees;
+   volatile uint32_t numLargeAllocs;
+} apx_allocator_t;
 
-//this data structure is used as elements in the ring buffer
-typedef struct rbf_data_tag
+typedef struct apx_allocatorStats_tag
 {
-   uint8_t *ptr;
-   uint32_t size;
-}rbf_data_t;
+   uint32_t numHits; //allocations served from a free list
+   uint32_t numMisses; //allocations that required a new slab
+   uint32_t numLargeAllocs; //allocations larger than APX_ALLOCATOR_MAX_BLOCK_SIZE, served by malloc
+   uint32_t numFrees;
+   uint32_t numSizeClasses;
+} apx_allocatorStats_t;
 
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
@@ -59,17 +72,15 @@ typedef struct rbf_data_tag
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
-apx_error_t apx_allocator_create(apx_allocator_t *self, uint16_t maxPendingMessages);
+apx_error_t apx_allocator_create(apx_allocator_t *self);
 void apx_allocator_destroy(apx_allocator_t *self);
+apx_allocator_t *apx_allocator_new(void);
+void apx_allocator_delete(apx_allocator_t *self);
 
-void apx_allocator_start(apx_allocator_t *self);
-void apx_allocator_stop(apx_allocator_t *self);
+apx_error_t apx_allocator_addSizeClass(apx_allocator_t *self, size_t size);
 uint8_t *apx_allocator_alloc(apx_allocator_t *self, size_t size);
 void apx_allocator_free(apx_allocator_t *self, uint8_t *ptr, size_t size);
-bool apx_allocator_isRunning(apx_allocator_t *self);
-#ifdef UNIT_TEST
-void apx_allocator_processAll(apx_allocator_t *self);
-int32_t apx_allocator_numPendingMessages(apx_allocator_t *self);
-#endif
+void apx_allocator_getStats(apx_allocator_t *self, apx_allocatorStats_t *stats);
+uint32_t apx_allocator_getBlockSize(apx_allocator_t *self, size_t size);
 
 #endif //APX_ALLOCATOR_H
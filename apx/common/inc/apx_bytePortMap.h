@@ -37,10 +37,23 @@
 //////////////////////////////////////////////////////////////////////////////
 // PUBLIC CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+typedef enum apx_bytePortMapType_tag
+{
+   APX_BYTE_PORT_MAP_AUTO,     //select representation based on node shape
+   APX_BYTE_PORT_MAP_DENSE,    //one port ID per byte of port data
+   APX_BYTE_PORT_MAP_INTERVAL, //sorted port start offsets, binary search
+   APX_BYTE_PORT_MAP_PAGED     //port start offsets indexed by a page table
+} apx_bytePortMapType_t;
+
 typedef struct apx_bytePortMap_tag
 {
-   apx_portId_t *mapData;
+   apx_portId_t *mapData; //DENSE: port ID per byte. PAGED: first port ID of each page
+   apx_offset_t *portOffsets; //INTERVAL and PAGED: start offset of each port followed by mapLen
    int32_t mapLen;
+   int32_t numPages;
+   apx_portCount_t numPorts;
+   uint8_t pageShift;
+   uint8_t mapType; //apx_bytePortMapType_t
 }apx_bytePortMap_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -48,10 +61,15 @@ typedef struct apx_bytePortMap_tag
 //////////////////////////////////////////////////////////////////////////////
 apx_error_t apx_bytePortMap_create(apx_bytePortMap_t *self, const apx_portDataProps_t *propsArray, apx_portCount_t numPorts);
 void apx_bytePortMap_destroy(apx_bytePortMap_t *self);
+apx_error_t apx_bytePortMap_createWithType(apx_bytePortMap_t *self, const apx_portDataProps_t *propsArray, apx_portCount_t numPorts, apx_bytePortMapType_t mapType);
 apx_bytePortMap_t *apx_bytePortMap_new(const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_error_t *errorCode);
+apx_bytePortMap_t *apx_bytePortMap_newWithType(const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType, apx_error_t *errorCode);
 void apx_bytePortMap_delete(apx_bytePortMap_t *self);
 
 apx_portId_t apx_bytePortMap_lookup(const apx_bytePortMap_t *self, int32_t offset);
 apx_size_t apx_bytePortMap_length(const apx_bytePortMap_t *self);
+apx_bytePortMapType_t apx_bytePortMap_getType(const apx_bytePortMap_t *self);
+apx_size_t apx_bytePortMap_getMemoryUsage(const apx_bytePortMap_t *self);
+apx_bytePortMapType_t apx_bytePortMap_selectType(apx_size_t mapLen, apx_portCount_t numPorts);
 
 #endif //APX_BYTE_PORT_MAP_H
@@ -35,6 +35,46 @@
 # define APX_MAX_NUM_MESSAGES 1000
 #endif
 
+#ifndef APX_WORKER_MAX_BATCH_SIZE
+# define APX_WORKER_MAX_BATCH_SIZE 65536 //max number of bytes the file manager worker collects before flushing, 0 disables batching
+#endif
+
+#ifndef APX_WORKER_MAX_BATCH_LATENCY
+# define APX_WORKER_MAX_BATCH_LATENCY 0 //max number of milliseconds the file manager worker waits for more messages before flushing
+#endif
+
+#ifndef APX_WORKER_COALESCE_ENABLE
+# define APX_WORKER_COALESCE_ENABLE 0 //when 1, dynamic data writes to an address still waiting in the file manager worker queue are merged (latest value wins)
+#endif
+
+#ifndef APX_WORKER_COALESCE_MAX_UPDATE_RATE
+# define APX_WORKER_COALESCE_MAX_UPDATE_RATE 0 //max number of coalesced data messages per second sent by one connection, 0 means unlimited
+#endif
+
+#ifndef APX_WORKER_COALESCE_BURST
+# define APX_WORKER_COALESCE_BURST 16 //number of coalesced data messages that can be sent back-to-back before rate shaping kicks in
+#endif
+
+#ifndef APX_WORKER_BACKPRESSURE_POLICY
+# define APX_WORKER_BACKPRESSURE_POLICY 0 //what a connection does when its consumer cannot keep up, see apx_backpressurePolicy_t
+#endif
+
+#ifndef APX_WORKER_QUEUE_HIGH_WATER_MARK
+# define APX_WORKER_QUEUE_HIGH_WATER_MARK 1000 //number of queued messages where APX_WORKER_BACKPRESSURE_POLICY kicks in
+#endif
+
+#ifndef APX_WORKER_MAX_FRAGMENT_SIZE
+# define APX_WORKER_MAX_FRAGMENT_SIZE 16384 //larger dynamic data writes are sent as several RMF messages using the more bit. Keep below 32763 (16-bit numheader)
+#endif
+
+#ifndef APX_WRITE_COALESCER_INLINE_SIZE
+# define APX_WRITE_COALESCER_INLINE_SIZE 16 //pending writes up to this many bytes are stored without heap allocation
+#endif
+
+#ifndef APX_CLIENT_VM_POOL_SIZE
+# define APX_CLIENT_VM_POOL_SIZE 8 //number of idle virtual machines apx_client keeps for apx_client_writePortData/apx_client_readPortData
+#endif
+
 #ifndef APX_DEBUG_ENABLE
 # define APX_DEBUG_ENABLE 0
 #endif
@@ -43,6 +83,50 @@
 # define APX_MAX_NUM_EVENTS 1000
 #endif
 
+#ifndef APX_MPSC_RING_SPIN_COUNT
+# define APX_MPSC_RING_SPIN_COUNT 1000 //number of times a consumer polls an empty message queue before blocking on its semaphore
+#endif
+
+#ifndef APX_ALLOCATOR_MAX_BLOCK_SIZE
+# define APX_ALLOCATOR_MAX_BLOCK_SIZE 1024 //largest block served by the connection allocator, larger requests go directly to malloc
+#endif
+
+#ifndef APX_ALLOCATOR_MAX_SIZE_CLASSES
+# define APX_ALLOCATOR_MAX_SIZE_CLASSES 32 //max number of size classes (default power-of-two classes plus classes derived from port data sizes)
+#endif
+
+#ifndef APX_ALLOCATOR_SLAB_SIZE
+# define APX_ALLOCATOR_SLAB_SIZE 4096 //number of bytes the allocator requests from malloc when a size class runs out of blocks
+#endif
+
+#ifndef APX_SOCKET_REACTOR_MAX_THREADS
+# define APX_SOCKET_REACTOR_MAX_THREADS 64 //upper limit for the number of epoll threads in the socket server reactor
+#endif
+
+#ifndef APX_SOCKET_REACTOR_MAX_EVENTS
+# define APX_SOCKET_REACTOR_MAX_EVENTS 64 //max number of events each reactor thread handles per call to epoll_wait
+#endif
+
+#ifndef APX_SOCKET_REACTOR_READ_SIZE
+# define APX_SOCKET_REACTOR_READ_SIZE 4096 //minimum free space in a socket receive buffer before calling recv
+#endif
+
+#ifndef APX_SOCKET_REACTOR_MAX_PENDING_SEND
+# define APX_SOCKET_REACTOR_MAX_PENDING_SEND (4u*1024u*1024u) //max number of bytes a reactor socket buffers for a peer that does not read, 0 means unlimited
+#endif
+
+#ifndef APX_BYTE_PORT_MAP_DENSE_MAX_LEN
+# define APX_BYTE_PORT_MAP_DENSE_MAX_LEN 4096 //port data sizes up to this many bytes always use one port ID per byte in apx_bytePortMap
+#endif
+
+#ifndef APX_BYTE_PORT_MAP_PAGED_MIN_PORTS
+# define APX_BYTE_PORT_MAP_PAGED_MIN_PORTS 1024 //nodes with at least this many ports use a page table on top of the sorted offsets in apx_bytePortMap
+#endif
+
+#ifndef APX_PORT_SIGNATURE_MAP_NUM_STRIPES
+# define APX_PORT_SIGNATURE_MAP_NUM_STRIPES 16 //number of independently locked stripes in apx_portSignatureMap. Must be a power of two, max 32
+#endif
+
 #define APX_MAX_DEFINITION_LEN 0x400000 //4MB
 
 
@@ -53,6 +137,38 @@
 
 #define APX_SERVER_MAX_CONCURRENT_CONNECTIONS 4000 //maximum number of connections the server will accept
 
+#ifndef APX_DATA_PLANE_MAX_LANES
+# define APX_DATA_PLANE_MAX_LANES 64 //upper limit for the number of worker threads (lanes) in the server data plane
+#endif
+
+#ifndef APX_DATA_PLANE_MAILBOX_SIZE
+# define APX_DATA_PLANE_MAILBOX_SIZE 1024 //initial capacity (number of scheduled workers) of each lane mailbox
+#endif
+
+#ifndef APX_DATA_PLANE_RUN_BUDGET
+# define APX_DATA_PLANE_RUN_BUDGET 256 //max number of worker messages a lane processes before moving on to the next scheduled connection
+#endif
+
+#ifndef APX_SHM_RING_SIZE
+# define APX_SHM_RING_SIZE 262144 //size in bytes of each notification ring in the shared-memory transport. Must be a power of two
+#endif
+
+#ifndef APX_SHM_WINDOW_SIZE
+# define APX_SHM_WINDOW_SIZE 65536 //size in bytes of the shared port data window in each direction. Writes outside of it are sent inline through the ring
+#endif
+
+#ifndef APX_SHM_WRITE_TIMEOUT_MS
+# define APX_SHM_WRITE_TIMEOUT_MS 5000 //how long a writer waits for ring space before giving up on the peer
+#endif
+
+#ifndef APX_DEFINITION_CACHE_MAX_ENTRIES
+# define APX_DEFINITION_CACHE_MAX_ENTRIES 1024 //number of distinct node definitions the server keeps built, keyed by definition digest. 0 disables the cache
+#endif
+
+#ifndef APX_DEFINITION_CACHE_NUM_BUCKETS
+# define APX_DEFINITION_CACHE_NUM_BUCKETS 256 //hash buckets in the server definition cache. Must be a power of two
+#endif
+
 #define APX_SMALL_DATA_SIZE  8u
 
 #endif //APX_CFG_H
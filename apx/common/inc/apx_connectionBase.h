@@ -117,6 +117,12 @@ void apx_connectionBase_attachNodeInstance(apx_connectionBase_t *self, apx_nodeI
 apx_error_t apx_connectionBase_processMessage(apx_connectionBase_t *self, const uint8_t *msgBuf, int32_t msgLen);
 uint8_t *apx_connectionBase_alloc(apx_connectionBase_t *self, size_t size);
 void apx_connectionBase_free(apx_connectionBase_t *self, uint8_t *ptr, size_t size);
+void apx_connectionBase_addAllocatorSizeClasses(apx_connectionBase_t *self, const apx_nodeInfo_t *nodeInfo);
+void apx_connectionBase_getAllocatorStats(apx_connectionBase_t *self, apx_allocatorStats_t *stats);
+void apx_connectionBase_setCoalesceConfig(apx_connectionBase_t *self, bool isEnabled, uint32_t maxUpdateRate);
+void apx_connectionBase_setBackpressureConfig(apx_connectionBase_t *self, apx_backpressurePolicy_t policy, uint32_t queueHighWaterMark);
+void apx_connectionBase_setWorkerScheduler(apx_connectionBase_t *self, apx_fileManagerWorker_scheduleFunc *scheduleFunc, void *arg);
+void apx_connectionBase_getWorkerStats(apx_connectionBase_t *self, apx_fileManagerWorkerStats_t *stats);
 
 
 /*** Internal Callback API ***/
@@ -53,10 +53,14 @@ typedef struct apx_dataElement_tag
    union {
       uint32_t u32;
       int32_t  s32;
+      uint64_t u64;
+      int64_t  s64;
    }lowerLimit;
    union {
       uint32_t u32;
       int32_t  s32;
+      uint64_t u64;
+      int64_t  s64;
    }upperLimit;
    adt_ary_t *childElements; //NULL for all cases except when baseType is exactly == APX_BASE_TYPE_RECORD. Contains strong references to apx_dataElement_t
    union {
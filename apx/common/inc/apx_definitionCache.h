@@ -0,0 +1,102 @@
+/*****************************************************************************
+* \file      apx_definitionCache.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Cache of built node definitions, keyed by definition digest
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_DEFINITION_CACHE_H
+#define APX_DEFINITION_CACHE_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <pthread.h>
+#endif
+#include "osmacro.h"
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_cfg.h"
+#include "apx_nodeInfo.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef struct apx_definitionCacheEntry_tag
+{
+   struct apx_definitionCacheEntry_tag *next; //next entry in the same bucket
+   struct apx_definitionCacheEntry_tag *older; //towards the least recently used entry
+   struct apx_definitionCacheEntry_tag *newer; //towards the most recently used entry
+   apx_nodeInfo_t *nodeInfo; //strong reference (see apx_nodeInfo_ref)
+   uint32_t definitionLen;
+   uint8_t digest[APX_CHECKSUMLEN_SHA256];
+} apx_definitionCacheEntry_t;
+
+typedef struct apx_definitionCacheStats_tag
+{
+   uint32_t numEntries;
+   uint32_t numHits;
+   uint32_t numMisses;
+   uint32_t numEvictions;
+   uint32_t numImageLoads; //misses that were served from a compiled node image on disk
+   uint32_t numImageSaves;
+} apx_definitionCacheStats_t;
+
+/**
+ * Maps the SHA256 digest of an APX definition to the read-only apx_nodeInfo built from it.
+ * When full, the least recently used entry is evicted. Node instances already using an evicted nodeInfo keep their own reference.
+ * With an image directory set, misses are looked up among the compiled node images in that directory (see apx_nodeImage.h)
+ * and newly inserted nodeInfos are saved there, so the next process start doesn't need to parse and compile them again.
+ * All functions are thread-safe.
+ */
+typedef struct apx_definitionCache_tag
+{
+   apx_definitionCacheEntry_t *buckets[APX_DEFINITION_CACHE_NUM_BUCKETS];
+   apx_definitionCacheEntry_t *oldest;
+   apx_definitionCacheEntry_t *newest;
+   uint32_t maxEntries;
+   apx_definitionCacheStats_t stats;
+   char *imageDirectory; //optional
+   apx_mode_t imageMode; //mode of nodeInfos loaded from imageDirectory
+   MUTEX_T lock;
+} apx_definitionCache_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_definitionCache_create(apx_definitionCache_t *self, uint32_t maxEntries);
+void apx_definitionCache_destroy(apx_definitionCache_t *self);
+apx_definitionCache_t *apx_definitionCache_new(uint32_t maxEntries);
+void apx_definitionCache_delete(apx_definitionCache_t *self);
+
+apx_error_t apx_definitionCache_setImageDirectory(apx_definitionCache_t *self, const char *directory, apx_mode_t mode);
+apx_nodeInfo_t *apx_definitionCache_find(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen);
+apx_error_t apx_definitionCache_insert(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen, apx_nodeInfo_t *nodeInfo);
+void apx_definitionCache_clear(apx_definitionCache_t *self);
+void apx_definitionCache_getStats(apx_definitionCache_t *self, apx_definitionCacheStats_t *stats);
+
+#endif //APX_DEFINITION_CACHE_H
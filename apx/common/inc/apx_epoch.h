@@ -0,0 +1,78 @@
+/*****************************************************************************
+* \file      apx_epoch.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Epoch based reclamation of data structures published to lock-free readers
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_EPOCH_H
+#define APX_EPOCH_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_types.h"
+#include "apx_error.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef void (apx_epochReclaimFunc)(void *arg);
+
+typedef struct apx_epochRetired_tag
+{
+   struct apx_epochRetired_tag *next;
+   void *arg;
+   apx_epochReclaimFunc *reclaim;
+   uint32_t epoch; //epoch when the object was retired
+} apx_epochRetired_t;
+
+/**
+ * Readers bracket every access to a published pointer with apx_epoch_enter/apx_epoch_exit. They never block.
+ * The writer replaces the published pointer and hands the old object to apx_epoch_retire.
+ * Retired objects are reclaimed once the global epoch has advanced twice, which only happens
+ * after all readers that could have seen the old pointer have exited.
+ * Calls to retire, reclaim and synchronize must be serialized by the caller.
+ */
+typedef struct apx_epoch_tag
+{
+   volatile uint32_t globalEpoch;
+   volatile uint32_t numReaders[2]; //number of active readers that entered during an even/odd epoch
+   apx_epochRetired_t *retired; //linked list of objects waiting for reclamation, newest first (writer only)
+   uint32_t numRetired;
+} apx_epoch_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_epoch_create(apx_epoch_t *self);
+void apx_epoch_destroy(apx_epoch_t *self);
+apx_epoch_t *apx_epoch_new(void);
+void apx_epoch_delete(apx_epoch_t *self);
+
+uint32_t apx_epoch_enter(apx_epoch_t *self);
+void apx_epoch_exit(apx_epoch_t *self, uint32_t epoch);
+apx_error_t apx_epoch_retire(apx_epoch_t *self, void *arg, apx_epochReclaimFunc *reclaim);
+uint32_t apx_epoch_reclaim(apx_epoch_t *self);
+void apx_epoch_synchronize(apx_epoch_t *self);
+uint32_t apx_epoch_getNumRetired(const apx_epoch_t *self);
+
+#endif //APX_EPOCH_H
@@ -43,7 +43,7 @@
 # include <semaphore.h>
 #endif
 #include "osmacro.h"
-#include "adt_ringbuf.h"
+#include "apx_mpscRing.h"
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -53,10 +53,7 @@
 
 typedef struct apx_eventLoop_tag
 {
-   SPINLOCK_T lock;
-   SEMAPHORE_T semaphore;
-   adt_rbfh_t pendingEvents;
-   bool exitFlag;
+   apx_mpscRing_t pendingEvents; //interrupted by apx_eventLoop_exit
 } apx_eventLoop_t;
 
 
@@ -73,6 +70,7 @@ void apx_eventLoop_append(apx_eventLoop_t *self, apx_event_t *event);
 void apx_eventLoop_run(apx_eventLoop_t *self, apx_eventHandlerFunc_t *eventHandler, void *eventHandlerArg);
 void apx_eventLoop_exit(apx_eventLoop_t *self);
 uint16_t apx_eventLoop_numPendingEvents(apx_eventLoop_t *self);
+void apx_eventLoop_getStats(apx_eventLoop_t *self, apx_mpscRingStats_t *stats);
 #ifdef UNIT_TEST
 void apx_eventLoop_runAll(apx_eventLoop_t *self, apx_eventHandlerFunc_t *eventHandler, void *eventHandlerArg);
 #endif
@@ -64,6 +64,7 @@ typedef struct apx_fileManagerShared_tag
    bool isConnected;
    SPINLOCK_T lock;
    apx_allocatorFreeFunc *freeAllocatedMemory;
+   apx_voidPtrFunc *overloadNotify; //called by the worker when the remote side has stopped consuming messages
 } apx_fileManagerShared_t;
 
 
@@ -86,5 +87,6 @@ void apx_fileManagerShared_freeAllocatedMemory(apx_fileManagerShared_t *self, ui
 void apx_fileManagerShared_connect(apx_fileManagerShared_t *self);
 void apx_fileManagerShared_disconnect(apx_fileManagerShared_t *self);
 bool apx_fileManagerShared_isConnected(apx_fileManagerShared_t *self);
+void apx_fileManagerShared_overloadNotify(apx_fileManagerShared_t *self);
 
 #endif //APX_FILE_MANAGER_SHARED_H
@@ -40,6 +40,9 @@
 #define ADT_RBFS_ENABLE 1
 #endif
 #include "adt_ringbuf.h"
+#include "apx_mpscRing.h"
+#include "apx_writeCoalescer.h"
+#include "adt_bytearray.h"
 #include "rmf.h"
 #ifndef _WIN32
 #include <semaphore.h>
@@ -49,19 +52,75 @@
 // PUBLIC CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
 //forward declaration
+struct apx_fileManagerWorker_tag;
+
+typedef apx_error_t (apx_fileManagerWorker_scheduleFunc)(void *arg, struct apx_fileManagerWorker_tag *worker);
+
+typedef struct apx_fileManagerWorkerStats_tag
+{
+   uint32_t numFlushes; //number of times a batch was sent
+   uint32_t numMessages; //total number of messages sent in batches
+   uint32_t maxMessagesPerFlush; //largest number of messages sent in a single batch
+   uint32_t numBytesCopied; //payload bytes of dynamic data copied on the way from caller to transmit handler
+   uint32_t queueDepth; //number of messages currently waiting in the message queue
+   uint32_t maxQueueDepth; //largest number of messages seen waiting in the message queue
+   uint32_t numWakeups; //number of times a caller had to wake up the (parked) worker thread
+   uint32_t numParks; //number of times the worker thread went to sleep waiting for messages
+   uint32_t numCoalescedWrites; //number of dynamic data writes merged into a write that was still waiting to be sent
+   uint32_t numRateLimitWaits; //number of times the worker (thread or scheduler) had to wait for the maximum update rate
+   uint32_t queueHighWaterMark; //configured high-water mark (0 when no backpressure policy is active)
+   uint32_t numHighWaterMarkHits; //number of dynamic data writes that found the queue at or above queueHighWaterMark
+   uint32_t numDroppedMessages; //number of dynamic data writes discarded by the backpressure policy
+   uint32_t numOverloads; //number of times the worker gave up on the connection because its consumer could not keep up
+   uint32_t numTransmitErrors; //number of batches the transmit handler failed to send (not included in numFlushes/numMessages)
+   uint32_t numTransmitOverloads; //number of sends the transmit handler refused with APX_TRANSMIT_HANDLER_WOULD_BLOCK
+} apx_fileManagerWorkerStats_t;
 
 typedef struct apx_fileManagerWorker_tag
 {
    apx_fileManagerShared_t *shared; //weak reference (do not delete on destruction)
    MUTEX_T mutex; //for locking variables in this object
-   SPINLOCK_T lock; //used exclusively by workerThread message queue
+   SPINLOCK_T lock; //protects transmitHandler, batch configuration, directBuffer and stats
    THREAD_T workerThread; //local transmit thread
-   SEMAPHORE_T semaphore; //thread semaphore
-   adt_rbfh_t messages; //pending actions
+   apx_mpscRing_t messages; //pending actions. Lock-free, callers only wake up workerThread when it is parked
    bool workerThreadValid; //Differences in Linux and Windows doesn't make it obvious if workerThread is valid without this flag
    apx_transmitHandler_t transmitHandler;
    int8_t numHeaderSize; //Number of bits used in numHeader (16 or 32)
    apx_mode_t mode; //server or client mode?
+   adt_bytearray_t batchBuffer; //numheader-framed messages waiting to be flushed using transmitHandler.sendBatch
+   int32_t batchLen; //number of bytes in use in batchBuffer
+   int32_t batchMsgCount; //number of messages in batchBuffer
+   int32_t batchHeaderLen; //numheader length reserved for the message currently being written into batchBuffer
+   int32_t batchMsgLen; //message length reserved for the message currently being written into batchBuffer
+   int32_t maxBatchSize; //flush threshold in bytes. 0 disables batching
+   uint32_t maxBatchLatency; //milliseconds to wait for more messages before flushing a batch
+   bool isBatching; //true while worker thread is collecting messages into batchBuffer
+   adt_bytearray_t directBuffer; //numheader-framed data messages serialized by the caller (protected by lock)
+   int32_t directLen; //number of bytes in use in directBuffer (protected by lock)
+   adt_bytearray_t directSendBuffer; //previous directBuffer, now owned by worker thread
+   int32_t directSendLen; //number of bytes in use in directSendBuffer
+   int32_t directSendPos; //number of bytes in directSendBuffer already sent (or dropped)
+   int32_t directSpanLen; //number of bytes after directSendPos waiting to be sent
+   int32_t directSpanMsgCount; //number of messages in the pending span
+   apx_writeCoalescer_t coalescer; //newest bytes of dynamic data writes waiting in the message queue (protected by lock)
+   adt_bytearray_t coalescedSendBuffer; //bytes taken out of coalescer by the worker thread
+   bool isCoalescing; //when true dynamic data writes are merged while queued
+   uint32_t maxUpdateRate; //max number of coalesced data messages per second, 0 means unlimited
+   uint32_t rateTokens; //number of coalesced data messages that can be sent right now (worker thread only)
+   uint32_t rateRefillTime; //tick count (milliseconds) when rateTokens was last refilled (worker thread only)
+   apx_backpressurePolicy_t backpressurePolicy; //what happens to dynamic data writes once queueHighWaterMark is reached
+   uint32_t queueHighWaterMark; //number of queued messages where backpressurePolicy kicks in, 0 disables it
+   bool isOverloaded; //set once the worker has given up on the connection (protected by lock)
+   apx_fileManagerWorkerStats_t stats; //protected by lock
+   apx_fileManagerWorker_scheduleFunc *scheduleFunc; //when set, messages are processed by an external scheduler instead of workerThread
+   void *scheduleArg;
+   volatile uint32_t isScheduled; //1 while the worker waits in (or is being run by) the external scheduler
+   volatile uint32_t isExited; //set once the external scheduler has processed APX_MSG_EXIT
+   volatile uint32_t isRunningScheduled; //1 while the scheduler thread is inside apx_fileManagerWorker_runScheduled
+   apx_msg_t deferredMsg; //coalesced data message held back by maxUpdateRate (scheduler thread only)
+   bool hasDeferredMsg;
+   struct apx_fileManagerWorker_tag *schedulerNext; //list link owned by the external scheduler while isScheduled is set
+   uint32_t schedulerWakeupTime; //owned by the external scheduler while isScheduled is set
 #ifdef _WIN32
    unsigned int threadId;
 #endif
@@ -84,6 +143,10 @@ void apx_fileManagerWorker_setTransmitHandler(apx_fileManagerWorker_t *self, apx
 void apx_fileManagerWorker_copyTransmitHandler(apx_fileManagerWorker_t *self, apx_transmitHandler_t *handler);
 void apx_fileManagerWorker_setNumHeaderSize(apx_fileManagerWorker_t *self, uint8_t bits);
 uint16_t apx_fileManagerWorker_getNumPendingMessages(apx_fileManagerWorker_t *self);
+void apx_fileManagerWorker_setBatchConfig(apx_fileManagerWorker_t *self, int32_t maxBatchSize, uint32_t maxBatchLatency);
+void apx_fileManagerWorker_setCoalesceConfig(apx_fileManagerWorker_t *self, bool isEnabled, uint32_t maxUpdateRate);
+void apx_fileManagerWorker_setBackpressureConfig(apx_fileManagerWorker_t *self, apx_backpressurePolicy_t policy, uint32_t queueHighWaterMark);
+void apx_fileManagerWorker_getStats(apx_fileManagerWorker_t *self, apx_fileManagerWorkerStats_t *stats);
 
 //Message API
 void apx_fileManagerWorker_sendFileInfoMsg(apx_fileManagerWorker_t *self, apx_fileInfo_t *fileInfo);
@@ -91,10 +154,17 @@ void apx_fileManagerWorker_sendFileOpenMsg(apx_fileManagerWorker_t *self, uint32
 apx_error_t apx_fileManagerWorker_sendHeaderAckMsg(apx_fileManagerWorker_t *self);
 apx_error_t apx_fileManagerWorker_sendConstData(apx_fileManagerWorker_t *self, uint32_t address, uint32_t len, apx_file_read_const_data_func *readFunc, void *arg);
 apx_error_t apx_fileManagerWorker_sendDynamicData(apx_fileManagerWorker_t *self, uint32_t address, uint32_t len, uint8_t *data);
+apx_error_t apx_fileManagerWorker_sendDynamicDataDirect(apx_fileManagerWorker_t *self, uint32_t address, uint32_t len, const uint8_t *data);
+apx_error_t apx_fileManagerWorker_sendDynamicDataCoalesced(apx_fileManagerWorker_t *self, uint32_t address, uint32_t len, const uint8_t *data);
+
+//Scheduler API
+void apx_fileManagerWorker_setScheduler(apx_fileManagerWorker_t *self, apx_fileManagerWorker_scheduleFunc *scheduleFunc, void *arg);
+bool apx_fileManagerWorker_runScheduled(apx_fileManagerWorker_t *self, uint32_t maxMessages, uint32_t *delayMs);
 
 //UNIT TEST API
 #ifdef UNIT_TEST
 bool apx_fileManagerWorker_run(apx_fileManagerWorker_t *self);
+bool apx_fileManagerWorker_runBatch(apx_fileManagerWorker_t *self);
 int32_t apx_fileManagerWorker_numPendingMessages(apx_fileManagerWorker_t *self);
 #endif
 
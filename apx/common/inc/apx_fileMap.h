@@ -14,8 +14,10 @@
 //////////////////////////////////////////////////////////////////////////////
 typedef struct apx_fileMap_tag
 {
-   adt_list_t fileList; //list of apx_file_t automatically sorted by address
-   apx_file_t *lastFile; //Last accessed file (for caching repeated access requests)
+   apx_file_t **fileList; //strong references to apx_file_t, sorted by address so lookups can use binary search
+   int32_t curLen; //number of files in fileList
+   int32_t allocLen; //allocated length of fileList
+   int32_t lastIndex; //Index of last accessed file (for caching repeated access requests)
 } apx_fileMap_t;
 
 
@@ -30,7 +32,7 @@ apx_file_t *apx_fileMap_findByAddress(apx_fileMap_t *self, uint32_t address);
 apx_file_t *apx_fileMap_findByName(apx_fileMap_t *self, const char *name);
 int32_t apx_fileMap_length(const apx_fileMap_t *self);
 void apx_fileMap_clear_weak(apx_fileMap_t *self);
-adt_list_t *apx_fileMap_getList(apx_fileMap_t *self);
+apx_file_t *apx_fileMap_get(apx_fileMap_t *self, int32_t index);
 bool apx_fileMap_exist(apx_fileMap_t *self, apx_file_t *file);
 adt_ary_t *apx_fileMap_makeFileInfoArray(apx_fileMap_t *self);
 
@@ -0,0 +1,103 @@
+/*****************************************************************************
+* \file      apx_mpscRing.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Lock-free multi-producer/single-consumer ring with adaptive consumer wakeup
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_MPSC_RING_H
+#define APX_MPSC_RING_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_types.h"
+#include "apx_error.h"
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <pthread.h>
+# include <semaphore.h>
+#endif
+#include "osmacro.h"
+#include "adt_ringbuf.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define APX_MPSC_RING_WAIT_FOREVER 0xFFFFFFFFu
+
+typedef struct apx_mpscRingStats_tag
+{
+   uint32_t depth; //number of elements currently waiting to be consumed
+   uint32_t maxDepth; //largest depth observed by the consumer
+   uint32_t numWakeups; //number of times a producer had to post the semaphore of a parked consumer
+   uint32_t numParks; //number of times the consumer blocked on the semaphore
+   uint32_t numOverflows; //number of elements that did not fit in the ring and were placed in the overflow queue
+} apx_mpscRingStats_t;
+
+/**
+ * Fixed element size ring buffer. Any number of threads may push, only one thread may pop/wait.
+ * Producers never take a lock and only make a system call when the consumer is parked on its semaphore.
+ * When the ring is full, elements go to a spinlock protected overflow queue until the consumer has caught up.
+ */
+typedef struct apx_mpscRing_tag
+{
+   uint8_t *slots; //capacity*slotSize bytes, each slot starts with a uint32_t sequence number followed by the element
+   uint32_t capacity; //power of two
+   uint32_t elemSize;
+   uint32_t slotSize;
+   volatile uint32_t tail; //next position to reserve (shared by producers)
+   volatile uint32_t head; //next position to read (written by consumer only)
+   volatile uint32_t isParked; //1 while the consumer is blocked (or about to block) on semaphore
+   volatile uint32_t isInterrupted;
+   volatile uint32_t overflowCount; //number of elements in overflow
+   SPINLOCK_T overflowLock;
+   adt_rbfh_t overflow;
+   SEMAPHORE_T semaphore;
+   volatile uint32_t numWakeups;
+   volatile uint32_t numOverflows;
+   uint32_t maxDepth; //consumer only
+   uint32_t numParks; //consumer only
+} apx_mpscRing_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_mpscRing_create(apx_mpscRing_t *self, uint32_t elemSize, uint32_t minCapacity);
+void apx_mpscRing_destroy(apx_mpscRing_t *self);
+apx_mpscRing_t *apx_mpscRing_new(uint32_t elemSize, uint32_t minCapacity);
+void apx_mpscRing_delete(apx_mpscRing_t *self);
+//Producer API
+apx_error_t apx_mpscRing_push(apx_mpscRing_t *self, const void *elem);
+void apx_mpscRing_interrupt(apx_mpscRing_t *self);
+//Consumer API
+bool apx_mpscRing_pop(apx_mpscRing_t *self, void *elem);
+bool apx_mpscRing_wait(apx_mpscRing_t *self, uint32_t timeoutMs);
+bool apx_mpscRing_isInterrupted(apx_mpscRing_t *self);
+//Monitoring API
+uint32_t apx_mpscRing_length(apx_mpscRing_t *self);
+void apx_mpscRing_getStats(apx_mpscRing_t *self, apx_mpscRingStats_t *stats);
+
+#endif //APX_MPSC_RING_H
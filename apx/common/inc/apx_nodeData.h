@@ -31,6 +31,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "apx_types.h"
 #include "apx_error.h"
+#include "apx_portWriteFilter.h"
 #ifndef APX_EMBEDDED
 #  ifndef _WIN32
      //Linux-based system
@@ -48,6 +49,17 @@
 struct apx_nodeInstance_tag;
 struct apx_portDataProps_tag;
 
+/**
+ * Called by apx_nodeData_writeProvidePortDataFiltered for a write that shall be forwarded to the remote side.
+ * It runs while providePortDataLock is still held, so forwards reach the connection in the same order as their data reached the buffer.
+ * It must not call back into the same apx_nodeData_t.
+ */
+typedef apx_error_t (apx_nodeData_forwardFunc)(void *arg, const uint8_t *data, uint32_t offset, apx_size_t len);
+//fills len bytes of port data at dest, called by apx_nodeData_packProvidePortDataFiltered while providePortDataLock is held
+typedef void (apx_nodeData_packFunc)(void *arg, uint8_t *dest, apx_size_t len);
+//reads len bytes of port data at src, see apx_nodeData_unpackRequirePortData
+typedef void (apx_nodeData_unpackFunc)(void *arg, const uint8_t *src, apx_size_t len);
+
 typedef struct apx_nodeDataBuffers_tag
 {
    uint8_t *definitionDataBuf;
@@ -77,14 +89,19 @@ typedef struct apx_nodeData_tag
    uint8_t definitionChecksumData[APX_CHECKSUMLEN_SHA256];
    apx_connectionCount_t *requirePortConnectionCount; //Number of active connections to each require-port
    apx_connectionCount_t *providePortConnectionCount; //Number of active connections to each provide-port
+   apx_portWriteFilter_t *providePortWriteFilters; //Write filter of each provide-port, protected by providePortDataLock. Only used in client mode.
+   uint8_t *providePortPackBuf; //scratch buffer of apx_nodeData_packProvidePortDataFiltered, protected by providePortDataLock. Only used in client mode.
+   apx_size_t providePortPackBufLen; //size of the largest provide-port
    uint32_t portConnectionsTotal; //Total number of active port connections
    apx_portCount_t numRequirePorts; //Number of require-ports in this node
    apx_portCount_t numProvidePorts; //Number of provide-ports in this node
 #ifndef APX_EMBEDDED
-   SPINLOCK_T requirePortDataLock;
-   SPINLOCK_T providePortDataLock;
+   SPINLOCK_T requirePortDataLock; //serializes writers of requirePortDataBuf, readers never take it
+   SPINLOCK_T providePortDataLock; //serializes writers of providePortDataBuf and access to providePortWriteFilters, readers of the buffer never take it
    SPINLOCK_T definitionDataLock;
    SPINLOCK_T internalLock;
+   volatile uint32_t requirePortDataSequence; //seqlock counter of requirePortDataBuf, odd while a write is in progress
+   volatile uint32_t providePortDataSequence; //seqlock counter of providePortDataBuf, odd while a write is in progress
 #endif
    struct apx_nodeInstance_tag *parent; //pointer to parent nodeInstance (weak reference)
 } apx_nodeData_t;
@@ -122,6 +139,7 @@ apx_error_t apx_nodeData_createRequirePortBuffer(apx_nodeData_t *self, apx_size_
 apx_size_t apx_nodeData_getRequirePortDataLen(apx_nodeData_t *self);
 apx_error_t apx_nodeData_writeRequirePortData(apx_nodeData_t *self, const uint8_t *src, uint32_t offset, apx_size_t len);
 apx_error_t apx_nodeData_readRequirePortData(apx_nodeData_t *self, uint8_t *dest, uint32_t offset, apx_size_t len);
+apx_error_t apx_nodeData_unpackRequirePortData(apx_nodeData_t *self, uint32_t offset, apx_size_t len, apx_nodeData_unpackFunc *unpackFunc, void *unpackArg);
 
 
 #ifndef APX_EMBEDDED
@@ -131,6 +149,18 @@ apx_size_t apx_nodeData_getProvidePortDataLen(apx_nodeData_t *self);
 apx_error_t apx_nodeData_writeProvidePortData(apx_nodeData_t *self, const uint8_t *src, uint32_t offset, apx_size_t len);
 apx_error_t apx_nodeData_readProvidePortData(apx_nodeData_t *self, uint8_t *dest, uint32_t offset, apx_size_t len);
 
+////////////////// Provide-port Write Filter API //////////////////
+#ifndef APX_EMBEDDED
+apx_error_t apx_nodeData_createProvidePortWriteFilterBuffer(apx_nodeData_t *self, apx_portCount_t numProvidePorts);
+apx_error_t apx_nodeData_createProvidePortPackBuffer(apx_nodeData_t *self, apx_size_t bufferLen);
+#endif
+apx_error_t apx_nodeData_setProvidePortWriteMode(apx_nodeData_t *self, apx_portId_t portId, apx_portWriteMode_t mode, uint32_t heartbeatInterval);
+apx_error_t apx_nodeData_writeProvidePortDataFiltered(apx_nodeData_t *self, apx_portId_t portId, const uint8_t *src, uint32_t offset, apx_size_t len,
+      apx_nodeData_forwardFunc *forwardFunc, void *forwardArg, bool *isForwarded);
+apx_error_t apx_nodeData_packProvidePortDataFiltered(apx_nodeData_t *self, apx_portId_t portId, uint32_t offset, apx_size_t len,
+      apx_nodeData_packFunc *packFunc, void *packArg, apx_nodeData_forwardFunc *forwardFunc, void *forwardArg);
+uint32_t apx_nodeData_getProvidePortSuppressedWriteCount(apx_nodeData_t *self, apx_portId_t portId);
+
 apx_error_t apx_nodeData_updatePortDataDirect(apx_nodeData_t *destNodeData, const struct apx_portDataProps_tag *destDatProps,
       apx_nodeData_t *srcNodeData, const struct apx_portDataProps_tag *srcDataProps);
 
@@ -0,0 +1,74 @@
+/*****************************************************************************
+* \file      apx_nodeImage.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Versioned binary image of a compiled node, stored on disk next to (instead of) its text definition
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_NODE_IMAGE_H
+#define APX_NODE_IMAGE_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_nodeInfo.h"
+#include "adt_bytearray.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Image layout (all integers are little endian):
+ *
+ *  offset  size  field
+ *  0       4     magic "APXI"
+ *  4       2     version (APX_NODE_IMAGE_VERSION)
+ *  6       2     header size
+ *  8       4     length of the text definition the image was compiled from
+ *  12      4     number of require ports
+ *  16      4     number of provide ports
+ *  20      4     body length
+ *  24      32    SHA256 of the text definition
+ *  56      32    SHA256 of the body
+ *  88      -     body
+ *
+ * The body is a sequence of length-prefixed (u32) blobs: node name, then pack program, unpack program and port signature
+ * of each require port, then the same for each provide port, then require port init data and provide port init data.
+ * Port data properties, byte port maps and signature IDs are derived from the programs when the image is loaded.
+ */
+#define APX_NODE_IMAGE_VERSION 1u
+#define APX_NODE_IMAGE_HEADER_SIZE 88u
+#define APX_NODE_IMAGE_FILE_SUFFIX ".apxi"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_nodeImage_write(adt_bytearray_t *image, const apx_nodeInfo_t *nodeInfo, const uint8_t *definitionDigest, uint32_t definitionLen);
+apx_nodeInfo_t *apx_nodeImage_read(const uint8_t *imageData, size_t imageLen, const uint8_t *definitionDigest, uint32_t definitionLen, apx_mode_t mode, apx_error_t *errorCode);
+apx_error_t apx_nodeImage_saveFile(const char *path, const apx_nodeInfo_t *nodeInfo, const uint8_t *definitionDigest, uint32_t definitionLen);
+apx_nodeInfo_t *apx_nodeImage_loadFile(const char *path, const uint8_t *definitionDigest, uint32_t definitionLen, apx_mode_t mode, apx_error_t *errorCode);
+char *apx_nodeImage_makeFilePath(const char *directory, const uint8_t *definitionDigest);
+
+#endif //APX_NODE_IMAGE_H
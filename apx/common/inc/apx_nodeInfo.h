@@ -34,6 +34,7 @@
 #include "apx_error.h"
 #include "apx_portDataProps.h"
 #include "apx_bytePortMap.h"
+#include "apx_vmOpTable.h"
 #include "adt_bytes.h"
 #include "apx_compiler.h"
 
@@ -43,6 +44,11 @@
 //forward declaration
 struct apx_node_tag;
 
+/**
+ * Compiled, read-only information about an APX node. It's never modified after apx_nodeInfo_build returns, which allows
+ * any number of node instances built from the same definition to share a single nodeInfo (see apx_definitionCache_t).
+ * Per-instance data such as port data buffers and connector tables is kept in apx_nodeInstance_t.
+ */
 typedef struct apx_nodeInfo_tag
 {
    char *name; //Name of the APX node
@@ -54,15 +60,20 @@ typedef struct apx_nodeInfo_tag
    adt_bytes_t **providePortPackPrograms; //Strong reference to adt_bytes_t*;length of array: numProvidePorts
    adt_bytes_t **requirePortUnpackPrograms; //Strong reference to adt_bytes_t*;length of array: numRequirePorts
    adt_bytes_t **providePortUnpackPrograms; //Strong reference to adt_bytes_t*;length of array: numProvidePorts
+   apx_vmOpTable_t **requirePortUnpackOpTables; //compiled from requirePortUnpackPrograms (client mode only), NULL entry when program has no fixed data layout; length of array: numRequirePorts
+   apx_vmOpTable_t **providePortPackOpTables; //compiled from providePortPackPrograms (client mode only), NULL entry when program has no fixed data layout; length of array: numProvidePorts
    adt_bytes_t *requirePortInitData; //Calculated init data for requirePorts
    adt_bytes_t *providePortInitData; //Calculated init data for providePorts
    char **requirePortSignatures; //array of derived port signatures strings (used in server mode); length of array: numRequirePorts
    char **providePortSignatures; //array of derived port signatures strings (used in server mode); length of array: numProvidePorts
+   apx_signatureId_t *requirePortSignatureIds; //interned requirePortSignatures (server mode only); length of array: numRequirePorts
+   apx_signatureId_t *providePortSignatureIds; //interned providePortSignatures (server mode only); length of array: numProvidePorts
    apx_portCount_t numRequirePorts;
    apx_portCount_t numProvidePorts;
    apx_size_t requirePortDataLen; //Cached result from apx_nodeInfo_calcRequirePortDataLen
    apx_size_t providePortDataLen; //Cached result from apx_nodeInfo_calcProvidePortDataLen
    apx_mode_t mode; //The mode this nodeInfo was built for
+   uint32_t refCount; //Number of owners (node instances, definition cache). Use apx_nodeInfo_ref/apx_nodeInfo_release once shared
 } apx_nodeInfo_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -76,8 +87,12 @@ void apx_nodeInfo_create(apx_nodeInfo_t *self);
 void apx_nodeInfo_destroy(apx_nodeInfo_t *self);
 apx_nodeInfo_t *apx_nodeInfo_new(void);
 void apx_nodeInfo_delete(apx_nodeInfo_t *self);
+apx_nodeInfo_t *apx_nodeInfo_ref(apx_nodeInfo_t *self);
+void apx_nodeInfo_release(apx_nodeInfo_t *self);
 
 apx_error_t apx_nodeInfo_build(apx_nodeInfo_t *self, const struct apx_node_tag *parseTree, apx_compiler_t *compiler, apx_mode_t mode, apx_programType_t *errProgramType, apx_uniquePortId_t *errPortId);
+apx_error_t apx_nodeInfo_prepareLoad(apx_nodeInfo_t *self, apx_mode_t mode, apx_portCount_t numRequirePorts, apx_portCount_t numProvidePorts);
+apx_error_t apx_nodeInfo_completeLoad(apx_nodeInfo_t *self);
 apx_nodeInfo_t *apx_nodeInfo_make_from_cstr(const char *apx_definition, apx_mode_t mode); //Utility function only meant for unit testing
 const char *apx_nodeInfo_getName(const apx_nodeInfo_t *self);
 apx_portCount_t apx_nodeInfo_getNumRequirePorts(const apx_nodeInfo_t *self);
@@ -88,6 +103,8 @@ const adt_bytes_t* apx_nodeInfo_getRequirePortPackProgram(const apx_nodeInfo_t *
 const adt_bytes_t* apx_nodeInfo_getProvidePortPackProgram(const apx_nodeInfo_t *self, apx_portId_t portId);
 const adt_bytes_t* apx_nodeInfo_getRequirePortUnpackProgram(const apx_nodeInfo_t *self, apx_portId_t portId);
 const adt_bytes_t* apx_nodeInfo_getProvidePortUnpackProgram(const apx_nodeInfo_t *self, apx_portId_t portId);
+const apx_vmOpTable_t* apx_nodeInfo_getRequirePortUnpackOpTable(const apx_nodeInfo_t *self, apx_portId_t portId);
+const apx_vmOpTable_t* apx_nodeInfo_getProvidePortPackOpTable(const apx_nodeInfo_t *self, apx_portId_t portId);
 apx_portId_t apx_nodeInfo_findProvidePortIdFromByteOffset(const apx_nodeInfo_t *self, apx_offset_t offset);
 apx_portId_t apx_nodeInfo_findRequirePortIdFromByteOffset(const apx_nodeInfo_t *self, apx_offset_t offset);
 apx_uniquePortId_t apx_nodeInfo_findPortIdByName(const apx_nodeInfo_t *self, const char *name);
@@ -105,6 +122,8 @@ apx_size_t apx_nodeInfo_getProvidePortInitDataSize(const apx_nodeInfo_t *self);
 const uint8_t *apx_nodeInfo_getProvidePortInitDataPtr(const apx_nodeInfo_t *self);
 const char *apx_nodeInfo_getRequirePortSignature(const apx_nodeInfo_t *self, apx_portId_t portId);
 const char *apx_nodeInfo_getProvidePortSignature(const apx_nodeInfo_t *self, apx_portId_t portId);
+apx_signatureId_t apx_nodeInfo_getRequirePortSignatureId(const apx_nodeInfo_t *self, apx_portId_t portId);
+apx_signatureId_t apx_nodeInfo_getProvidePortSignatureId(const apx_nodeInfo_t *self, apx_portId_t portId);
 adt_str_t *apx_nodeInfo_getRequirePortName(const apx_nodeInfo_t *self, apx_portId_t portId);
 adt_str_t *apx_nodeInfo_getProvidePortName(const apx_nodeInfo_t *self, apx_portId_t portId);
 
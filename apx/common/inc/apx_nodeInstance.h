@@ -40,6 +40,8 @@
 #include "apx_error.h"
 #include "apx_parser.h"
 #include "apx_portConnectorChangeTable.h"
+#include "apx_routingPlan.h"
+#include "apx_epoch.h"
 #ifdef _WIN32
 # ifndef WIN32_LEAN_AND_MEAN
 # define WIN32_LEAN_AND_MEAN
@@ -74,7 +76,11 @@ typedef struct apx_nodeInstance_tag
    apx_mode_t mode;
    apx_requirePortDataState_t requirePortDataState;
    apx_providePortDataState_t providePortDataState;
-   MUTEX_T connectorTableLock;
+   apx_routingPlan_t * volatile routingPlan; //Immutable compiled snapshot of connectorTable, read by routers without locking. Only used in server mode.
+   bool isRoutingPlanValid; //false when connectorTable has changed since routingPlan was published, protected by connectorTableLock
+   apx_epoch_t routingEpoch; //reclaims replaced routing plans once no router references them
+   MUTEX_T connectorTableLock; //serializes writers of connectorTable and routingPlan
+   uint32_t portSignatureStripes; //bit mask of apx_portSignatureMap stripes used by the port signatures of this node. Only used in server mode.
 } apx_nodeInstance_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -98,6 +104,7 @@ apx_error_t apx_nodeInstance_createDefinitionBuffer(apx_nodeInstance_t *self, ap
 apx_error_t apx_nodeInstance_createPortDataBuffers(apx_nodeInstance_t *self);
 
 apx_error_t apx_nodeInstance_buildNodeInfo(apx_nodeInstance_t *self, apx_programType_t *errProgramType, apx_uniquePortId_t *errPortId);
+apx_error_t apx_nodeInstance_attachNodeInfo(apx_nodeInstance_t *self, apx_nodeInfo_t *nodeInfo);
 apx_nodeInfo_t *apx_nodeInstane_getNodeInfo(apx_nodeInstance_t *self);
 apx_error_t apx_nodeInstance_buildPortRefs(apx_nodeInstance_t *self);
 apx_portRef_t *apx_nodeInstance_getPortRef(apx_nodeInstance_t *self, apx_uniquePortId_t portId);
@@ -111,6 +118,7 @@ void apx_nodeInstance_registerRequirePortFileHandler(apx_nodeInstance_t *self, a
 const char *apx_nodeInstance_getName(apx_nodeInstance_t *self);
 void apx_nodeInstance_cleanParseTree(apx_nodeInstance_t *self);
 apx_nodeInfo_t *apx_nodeInstance_getNodeInfo(apx_nodeInstance_t *self);
+uint32_t apx_nodeInstance_getPortSignatureStripes(const apx_nodeInstance_t *self);
 apx_portCount_t apx_nodeInstance_getNumProvidePorts(apx_nodeInstance_t *self);
 apx_portCount_t apx_nodeInstance_getNumRequirePorts(apx_nodeInstance_t *self);
 apx_error_t apx_nodeInstance_fillProvidePortDataFileInfo(apx_nodeInstance_t *self, apx_fileInfo_t *fileInfo);
@@ -131,8 +139,13 @@ adt_str_t *apx_nodeInstance_getProvidePortName(apx_nodeInstance_t *self, apx_por
 apx_error_t apx_nodeInstance_writeDefinitionData(apx_nodeInstance_t *self, const uint8_t *src, uint32_t offset, uint32_t len);
 apx_error_t apx_nodeInstance_readDefinitionData(apx_nodeInstance_t *self, uint8_t *dest, uint32_t offset, uint32_t len);
 apx_error_t apx_nodeInstance_writeProvidePortData(apx_nodeInstance_t *self, const uint8_t *src, uint32_t offset, apx_size_t len);
+apx_error_t apx_nodeInstance_writeProvidePortDataById(apx_nodeInstance_t *self, apx_portId_t providePortId, const uint8_t *src, apx_size_t len);
+apx_error_t apx_nodeInstance_packProvidePortDataById(apx_nodeInstance_t *self, apx_portId_t providePortId, apx_size_t len, apx_nodeData_packFunc *packFunc, void *packArg);
+apx_error_t apx_nodeInstance_setProvidePortWriteMode(apx_nodeInstance_t *self, apx_portId_t providePortId, apx_portWriteMode_t mode, uint32_t heartbeatInterval);
+uint32_t apx_nodeInstance_getProvidePortSuppressedWriteCount(apx_nodeInstance_t *self, apx_portId_t providePortId);
 apx_error_t apx_nodeInstance_readProvidePortData(apx_nodeInstance_t *self, uint8_t *dest, uint32_t offset, apx_size_t len);
 apx_error_t apx_nodeInstance_readRequirePortData(apx_nodeInstance_t *self, uint8_t *dest, uint32_t offset, uint32_t len);
+apx_error_t apx_nodeInstance_unpackRequirePortData(apx_nodeInstance_t *self, uint32_t offset, apx_size_t len, apx_nodeData_unpackFunc *unpackFunc, void *unpackArg);
 apx_error_t apx_nodeInstance_writeRequirePortData(apx_nodeInstance_t *self, const uint8_t *src, uint32_t offset, apx_size_t len);
 
 /********** ConnectorTable API  ************/
@@ -142,6 +155,7 @@ void apx_nodeInstance_unlockPortConnectorTable(apx_nodeInstance_t *self);
 apx_portConnectorList_t *apx_nodeInstance_getProvidePortConnectors(apx_nodeInstance_t *self, apx_portId_t portId);
 apx_error_t apx_nodeInstance_insertProvidePortConnector(apx_nodeInstance_t *self, apx_portId_t portId, apx_portRef_t *requirePortRef);
 apx_error_t apx_nodeInstance_removeProvidePortConnector(apx_nodeInstance_t *self, apx_portId_t portId, apx_portRef_t *requirePortRef);
+void apx_nodeInstance_synchronizeRouting(apx_nodeInstance_t *self);
 
 /********** Port Connector Change API  ************/
 apx_portConnectorChangeTable_t* apx_nodeInstance_getRequirePortConnectorChanges(apx_nodeInstance_t *self, bool autoCreate);
@@ -156,11 +170,14 @@ apx_error_t apx_nodeInstance_handleRequirePortWasConnectedToProvidePort(apx_port
 apx_error_t apx_nodeInstance_handleProvidePortWasConnectedToRequirePort(apx_portRef_t *providePortRef, apx_portRef_t *requirePortRef);
 apx_error_t apx_nodeInstance_handleRequirePortWasDisconnectedFromProvidePort(apx_portRef_t *requirePortRef, apx_portRef_t *providePortRef);
 apx_error_t apx_nodeInstance_sendRequirePortDataToFileManager(apx_nodeInstance_t *self);
+apx_error_t apx_nodeInstance_sendRequirePortDataRange(apx_nodeInstance_t *self, uint32_t offset, apx_size_t len);
 apx_error_t apx_nodeInstance_routeProvidePortDataToReceivers(apx_nodeInstance_t *self, const uint8_t *src, uint32_t offset, apx_size_t len);
 void apx_nodeInstance_clearConnectorTable(apx_nodeInstance_t *self);
 
 /********** Port Program API ***************/
 const adt_bytes_t *apx_nodeInstance_getProvidePortPackProgram(apx_nodeInstance_t *self, apx_portId_t providePortId);
 const adt_bytes_t *apx_nodeInstance_getRequirePortUnpackProgram(apx_nodeInstance_t *self, apx_portId_t requirePortId);
+const apx_vmOpTable_t *apx_nodeInstance_getProvidePortPackOpTable(apx_nodeInstance_t *self, apx_portId_t providePortId);
+const apx_vmOpTable_t *apx_nodeInstance_getRequirePortUnpackOpTable(apx_nodeInstance_t *self, apx_portId_t requirePortId);
 
 #endif //APX_NODE_INSTANCE_H
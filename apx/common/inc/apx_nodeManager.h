@@ -48,7 +48,7 @@
 // PUBLIC CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
 //forward declarations
-
+struct apx_definitionCache_tag;
 
 typedef struct apx_nodeManager_tag
 {
@@ -57,6 +57,7 @@ typedef struct apx_nodeManager_tag
    adt_hash_t nodeInstanceMap; //references to apx_nodeInstance objects. Key is the node name, value is of type apx_nodeInstance_t*
    SPINLOCK_T lock; //locking mechanism
    apx_nodeInstance_t *lastAttached; //weak reference
+   struct apx_definitionCache_tag *definitionCache; //weak reference, optional. Shares nodeInfo between identical nodes
    apx_mode_t mode;
 } apx_nodeManager_t;
 
@@ -71,6 +72,7 @@ void apx_nodeManager_delete(apx_nodeManager_t *self);
 /********** Client mode API  ************/
 apx_error_t apx_nodeManager_buildNode_cstr(apx_nodeManager_t *self, const char *definition_text); //used when useWeakRef: false
 apx_error_t apx_nodeManager_attachNode(apx_nodeManager_t *self, apx_nodeInstance_t *nodeInstance); //Used when useWeakRef: true
+void apx_nodeManager_setDefinitionCache(apx_nodeManager_t *self, struct apx_definitionCache_tag *definitionCache);
 
 /********** Server mode API  ************/
 apx_nodeInstance_t *apx_nodeManager_createNode(apx_nodeManager_t *self, const char *nodeName);
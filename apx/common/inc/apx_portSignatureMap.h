@@ -29,19 +29,50 @@
 //////////////////////////////////////////////////////////////////////////////
 // INCLUDES
 //////////////////////////////////////////////////////////////////////////////
-#include "adt_hash.h"
 #include "apx_types.h"
 #include "apx_error.h"
+#include "apx_cfg.h"
 #include "apx_portSignatureMapEntry.h"
+#include "osmacro.h"
 //////////////////////////////////////////////////////////////////////////////
 // PUBLIC CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
 //Forward declaration
 struct apx_nodeInstance_tag;
+struct apx_nodeInfo_tag;
 
+#if ( (APX_PORT_SIGNATURE_MAP_NUM_STRIPES < 1) || (APX_PORT_SIGNATURE_MAP_NUM_STRIPES > 32) || ((APX_PORT_SIGNATURE_MAP_NUM_STRIPES & (APX_PORT_SIGNATURE_MAP_NUM_STRIPES - 1)) != 0) )
+# error "APX_PORT_SIGNATURE_MAP_NUM_STRIPES must be a power of two between 1 and 32"
+#endif
+
+#if (APX_PORT_SIGNATURE_MAP_NUM_STRIPES == 32)
+# define APX_PORT_SIGNATURE_MAP_ALL_STRIPES 0xFFFFFFFFu
+#else
+# define APX_PORT_SIGNATURE_MAP_ALL_STRIPES ((1u << APX_PORT_SIGNATURE_MAP_NUM_STRIPES) - 1u)
+#endif
+
+typedef struct apx_portSignatureMapSlot_tag
+{
+   apx_signatureId_t signatureId; //APX_INVALID_SIGNATURE_ID marks an empty slot
+   apx_portSignatureMapEntry_t *entry; //strong reference
+} apx_portSignatureMapSlot_t;
+
+typedef struct apx_portSignatureMapStripe_tag
+{
+   apx_portSignatureMapSlot_t *slots; //open addressing hash table keyed by interned port signature id (linear probing)
+   uint32_t capacity; //number of slots, always zero or a power of two
+   uint32_t length; //number of used slots
+   MUTEX_T lock; //protects slots and all entries stored in it
+} apx_portSignatureMapStripe_t;
+
+/**
+ * The map is partitioned into stripes based on a hash of the port signature. Each stripe has its own lock.
+ * The map never takes any locks internally. Callers select the stripes they need (a bit mask with one bit per stripe),
+ * take them using apx_portSignatureMap_lockStripes and hold them while calling connect/disconnect/find.
+ */
 typedef struct apx_portSignatureMap_tag
 {
-   adt_hash_t internalMap; //strong references to apx_portSignatureMapEntry_t. The hash key is the portSignature string.
+   apx_portSignatureMapStripe_t stripes[APX_PORT_SIGNATURE_MAP_NUM_STRIPES];
 } apx_portSignatureMap_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -53,11 +84,17 @@ apx_portSignatureMap_t *apx_portSignatureMap_new(void);
 void apx_portSignatureMap_delete(apx_portSignatureMap_t *self);
 
 apx_portSignatureMapEntry_t *apx_portSignatureMap_find(apx_portSignatureMap_t *self, const char *portSignature);
+apx_portSignatureMapEntry_t *apx_portSignatureMap_findById(apx_portSignatureMap_t *self, apx_signatureId_t signatureId);
 int32_t apx_portSignatureMap_length(apx_portSignatureMap_t *self);
 apx_error_t apx_portSignatureMap_connectProvidePorts(apx_portSignatureMap_t *self, struct apx_nodeInstance_tag *nodeInstance);
 apx_error_t apx_portSignatureMap_connectRequirePorts(apx_portSignatureMap_t *self, struct apx_nodeInstance_tag *nodeInstance);
 apx_error_t apx_portSignatureMap_disconnectProvidePorts(apx_portSignatureMap_t *self, struct apx_nodeInstance_tag *nodeInstance);
 apx_error_t apx_portSignatureMap_disconnectRequirePorts(apx_portSignatureMap_t *self, struct apx_nodeInstance_tag *nodeInstance);
+uint32_t apx_portSignatureMap_getStripeIndex(apx_signatureId_t signatureId);
+uint32_t apx_portSignatureMap_calcStripeMask(struct apx_nodeInfo_tag *nodeInfo);
+uint32_t apx_portSignatureMap_calcAffectedStripes(apx_portSignatureMap_t *self, struct apx_nodeInstance_tag *nodeInstance);
+void apx_portSignatureMap_lockStripes(apx_portSignatureMap_t *self, uint32_t stripeMask);
+void apx_portSignatureMap_unlockStripes(apx_portSignatureMap_t *self, uint32_t stripeMask);
 
 
 #endif //APX_PORT_SIGNATURE_MAP_H
@@ -0,0 +1,62 @@
+/*****************************************************************************
+* \file      apx_portWriteFilter.h
+* \author    agent
+* \date      2026-10-18
+* \brief     On-change suppression of provide-port writes
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_PORT_WRITE_FILTER_H
+#define APX_PORT_WRITE_FILTER_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_types.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Write filter state of one provide-port.
+ * In APX_PORT_WRITE_MODE_ON_CHANGE a write is only forwarded to the remote side when the packed bytes differ
+ * from what is already in the provide-port buffer. When heartbeatInterval is non-zero an unchanged value is
+ * still forwarded once heartbeatInterval milliseconds have passed since the last forwarded write.
+ * The filter holds no lock of its own, apx_nodeData protects it with providePortDataLock.
+ */
+typedef struct apx_portWriteFilter_tag
+{
+   uint32_t heartbeatInterval; //milliseconds, 0 disables the heartbeat
+   uint32_t lastForwardTime; //tick count (milliseconds) of the last forwarded write
+   uint32_t numSuppressedWrites; //number of writes that were not forwarded since the data was unchanged
+   uint32_t numHeartbeatWrites; //number of unchanged writes that were forwarded by the heartbeat
+   apx_portWriteMode_t mode;
+} apx_portWriteFilter_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_portWriteFilter_create(apx_portWriteFilter_t *self);
+void apx_portWriteFilter_setMode(apx_portWriteFilter_t *self, apx_portWriteMode_t mode, uint32_t heartbeatInterval, uint32_t now);
+bool apx_portWriteFilter_update(apx_portWriteFilter_t *self, bool isChanged, uint32_t now);
+uint32_t apx_portWriteFilter_getTickCount(void);
+
+#endif //APX_PORT_WRITE_FILTER_H
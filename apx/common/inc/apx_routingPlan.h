@@ -0,0 +1,88 @@
+/*****************************************************************************
+* \file      apx_routingPlan.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Flat routing table from provide-port data offsets to connected require ports
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_ROUTING_PLAN_H
+#define APX_ROUTING_PLAN_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_portDataRef.h"
+#include "apx_portConnectorList.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+struct apx_nodeInstance_tag;
+
+typedef struct apx_routingPlanEntry_tag
+{
+   struct apx_nodeInstance_tag *destNodeInstance; //weak reference to node instance owning the require port
+   uint32_t destOffset; //offset of require port in require port data of destNodeInstance
+   apx_size_t dataSize;
+} apx_routingPlanEntry_t;
+
+typedef struct apx_routingPlanRange_tag
+{
+   uint32_t offset; //offset of provide port in provide port data
+   apx_size_t dataSize;
+   int32_t beginEntry; //index of first entry in entries array
+   int32_t endEntry; //index after last entry in entries array
+} apx_routingPlanRange_t;
+
+/**
+ * Compiled form of a connectorTable. Contains one range for each provide port that has at least one connector, sorted by offset.
+ * The entries of all ranges are stored back-to-back in a single array.
+ */
+typedef struct apx_routingPlan_tag
+{
+   apx_routingPlanRange_t *ranges; //strong reference to array of length numRanges
+   apx_routingPlanEntry_t *entries; //strong reference to array of length numEntries
+   int32_t numRanges;
+   int32_t numEntries;
+} apx_routingPlan_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_routingPlan_create(apx_routingPlan_t *self);
+void apx_routingPlan_destroy(apx_routingPlan_t *self);
+apx_routingPlan_t *apx_routingPlan_new(void);
+void apx_routingPlan_delete(apx_routingPlan_t *self);
+void apx_routingPlan_vdelete(void *arg);
+
+apx_error_t apx_routingPlan_build(apx_routingPlan_t *self, const apx_portRef_t *providePortRefs, apx_portConnectorList_t *connectorTable, apx_portCount_t numProvidePorts);
+void apx_routingPlan_clear(apx_routingPlan_t *self);
+const apx_routingPlanRange_t *apx_routingPlan_findFirstRange(const apx_routingPlan_t *self, uint32_t offset);
+const apx_routingPlanRange_t *apx_routingPlan_rangeEnd(const apx_routingPlan_t *self);
+const apx_routingPlanEntry_t *apx_routingPlan_getEntry(const apx_routingPlan_t *self, int32_t index);
+
+#endif //APX_ROUTING_PLAN_H
@@ -0,0 +1,57 @@
+/*****************************************************************************
+* \file      apx_sha256.h
+* \author    agent
+* \date      2026-10-18
+* \brief     SHA-256 message digest (FIPS 180-4)
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_SHA256_H
+#define APX_SHA256_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define APX_SHA256_BLOCK_SIZE  64u
+#define APX_SHA256_DIGEST_SIZE 32u
+
+typedef struct apx_sha256_tag
+{
+   uint32_t state[8];
+   uint64_t totalLen; //total number of bytes hashed so far
+   uint8_t block[APX_SHA256_BLOCK_SIZE]; //partial block waiting for more data
+   uint32_t blockLen;
+} apx_sha256_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_sha256_init(apx_sha256_t *self);
+void apx_sha256_update(apx_sha256_t *self, const uint8_t *data, size_t len);
+void apx_sha256_final(apx_sha256_t *self, uint8_t *digest);
+void apx_sha256_calc(const uint8_t *data, size_t len, uint8_t *digest);
+
+#endif //APX_SHA256_H
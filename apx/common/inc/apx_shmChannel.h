@@ -0,0 +1,138 @@
+/*****************************************************************************
+* \file      apx_shmChannel.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Shared-memory transport channel for same-host APX connections
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_SHM_CHANNEL_H
+#define APX_SHM_CHANNEL_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stdbool.h>
+#include "apx_error.h"
+
+#ifdef __linux__
+# define APX_SHM_SUPPORTED 1
+#else
+# define APX_SHM_SUPPORTED 0
+#endif
+
+#if APX_SHM_SUPPORTED
+#include <pthread.h>
+#include "osmacro.h"
+#include "apx_cfg.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define APX_SHM_CACHE_LINE_SIZE 64u
+#define APX_SHM_MAGIC 0x41505853u //"APXS"
+#define APX_SHM_VERSION 1u
+
+#define APX_SHM_DIRECTION_SERVER_TO_CLIENT 0u
+#define APX_SHM_DIRECTION_CLIENT_TO_SERVER 1u
+#define APX_SHM_NUM_DIRECTIONS 2u
+#define APX_SHM_NUM_HANDLES 3u //memfd followed by one eventfd per direction
+
+#define APX_SHM_WAIT_FOREVER -1
+
+//called with one or more complete numheader framed messages, exactly as they would have arrived on a socket
+typedef void (apx_shmChannelDataFunc_t)(void *arg, const uint8_t *data, uint32_t dataLen);
+
+/**
+ * One direction of the channel as it is laid out in shared memory.
+ * The ring holds notification records of (address,len). When address has APX_SHM_INLINE_FLAG set the record is
+ * followed by len bytes of numheader framed stream data, otherwise it refers to len bytes at address in window.
+ */
+typedef struct apx_shmDirection_tag
+{
+   volatile uint32_t head; //next write position, only written by the producer
+   uint8_t headPad[APX_SHM_CACHE_LINE_SIZE - sizeof(uint32_t)];
+   volatile uint32_t tail; //next read position, only written by the consumer
+   volatile uint32_t isParked; //set by the consumer before it blocks on its eventfd
+   uint8_t tailPad[APX_SHM_CACHE_LINE_SIZE - 2*sizeof(uint32_t)];
+   volatile uint32_t windowSeq; //seqlock protecting window, odd while the producer is copying data into it
+   uint8_t seqPad[APX_SHM_CACHE_LINE_SIZE - sizeof(uint32_t)];
+   uint8_t ring[APX_SHM_RING_SIZE];
+   uint8_t window[APX_SHM_WINDOW_SIZE]; //mirrors the port data address range of the producer (address 0 and up)
+} apx_shmDirection_t;
+
+typedef struct apx_shmRegion_tag
+{
+   uint32_t magic;
+   uint32_t version;
+   uint32_t ringSize;
+   uint32_t windowSize;
+   volatile uint32_t isClosed;
+   uint8_t pad[APX_SHM_CACHE_LINE_SIZE - 5*sizeof(uint32_t)];
+   apx_shmDirection_t direction[APX_SHM_NUM_DIRECTIONS];
+} apx_shmRegion_t;
+
+typedef struct apx_shmChannelStats_tag
+{
+   uint32_t numWindowWrites; //messages written through the shared window
+   uint32_t numInlineWrites; //ring records carrying stream data
+   uint32_t numWakeups; //number of times the consumer had to be woken through its eventfd
+} apx_shmChannelStats_t;
+
+typedef struct apx_shmChannel_tag
+{
+   apx_shmRegion_t *region;
+   apx_shmDirection_t *tx;
+   apx_shmDirection_t *rx;
+   int memFd;
+   int eventFd[APX_SHM_NUM_DIRECTIONS]; //eventFd[i] wakes the consumer of region->direction[i]
+   uint8_t txIndex;
+   uint8_t rxIndex;
+   bool isWindowEnabled; //when false all messages are sent inline
+   bool isProtocolError; //set when the receive ring holds something the peer can't have written correctly, the channel is then closed
+   bool isWindowStalled; //set when the peer left the window seqlock odd for too long, apx_shmChannel_wait then checks the peer socket before the record is retried
+   MUTEX_T txLock; //serializes producers within this process
+   uint8_t *rxBuffer; //private copy of one received message, either window data with headers in front or an inline payload
+   apx_shmChannelStats_t stats;
+} apx_shmChannel_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_shmChannel_create(apx_shmChannel_t *self);
+apx_error_t apx_shmChannel_createFromHandles(apx_shmChannel_t *self, const int *handles);
+apx_error_t apx_shmChannel_createFromSocket(apx_shmChannel_t *self, int sockFd);
+void apx_shmChannel_destroy(apx_shmChannel_t *self);
+apx_shmChannel_t *apx_shmChannel_new(void);
+void apx_shmChannel_delete(apx_shmChannel_t *self);
+
+apx_error_t apx_shmChannel_sendHandles(apx_shmChannel_t *self, int sockFd);
+void apx_shmChannel_getHandles(apx_shmChannel_t *self, int *handles);
+void apx_shmChannel_setWindowEnabled(apx_shmChannel_t *self, bool isEnabled);
+int32_t apx_shmChannel_write(apx_shmChannel_t *self, const uint8_t *data, uint32_t dataLen);
+int32_t apx_shmChannel_read(apx_shmChannel_t *self, apx_shmChannelDataFunc_t *dataFunc, void *arg);
+apx_error_t apx_shmChannel_wait(apx_shmChannel_t *self, int peerFd, int32_t timeoutMs);
+void apx_shmChannel_close(apx_shmChannel_t *self);
+bool apx_shmChannel_isClosed(apx_shmChannel_t *self);
+void apx_shmChannel_getStats(apx_shmChannel_t *self, apx_shmChannelStats_t *stats);
+
+#endif //APX_SHM_SUPPORTED
+#endif //APX_SHM_CHANNEL_H
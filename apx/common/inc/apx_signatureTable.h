@@ -0,0 +1,71 @@
+/*****************************************************************************
+* \file      apx_signatureTable.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Interning table for derived port signatures
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_SIGNATURE_TABLE_H
+#define APX_SIGNATURE_TABLE_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "adt_hash.h"
+#include "apx_types.h"
+#include "osmacro.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef struct apx_signatureTableEntry_tag
+{
+   apx_signatureId_t id;
+   uint32_t refCount; //number of port signatures (in all nodeInfo objects) currently using this id
+} apx_signatureTableEntry_t;
+
+/**
+ * Interns derived port signature strings. Each unique signature is given a 64-bit id the first time it's seen.
+ * The id stays the same as long as at least one reference to the signature exists. Ids are never reused.
+ * All functions are thread-safe.
+ */
+typedef struct apx_signatureTable_tag
+{
+   adt_hash_t internalMap; //strong references to apx_signatureTableEntry_t. The hash key is the port signature string.
+   apx_signatureId_t nextId;
+   MUTEX_T lock;
+} apx_signatureTable_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_signatureTable_create(apx_signatureTable_t *self);
+void apx_signatureTable_destroy(apx_signatureTable_t *self);
+apx_signatureTable_t *apx_signatureTable_new(void);
+void apx_signatureTable_delete(apx_signatureTable_t *self);
+
+apx_signatureId_t apx_signatureTable_intern(apx_signatureTable_t *self, const char *signature);
+void apx_signatureTable_release(apx_signatureTable_t *self, const char *signature);
+apx_signatureId_t apx_signatureTable_find(apx_signatureTable_t *self, const char *signature);
+int32_t apx_signatureTable_length(apx_signatureTable_t *self);
+apx_signatureTable_t *apx_signatureTable_getGlobal(void);
+
+#endif //APX_SIGNATURE_TABLE_H
@@ -13,6 +13,7 @@
 //////////////////////////////////////////////////////////////////////////////
 // CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#define APX_TRANSMIT_HANDLER_WOULD_BLOCK (-2) //send/sendBatch refused the data because too much is already waiting to be sent, nothing was sent
 
 typedef struct apx_transmitHandler_tag
 {
@@ -27,6 +28,7 @@ typedef struct apx_transmitHandler_tag
    //New API
    uint8_t* (*getMsgBuffer)(void *arg, int32_t *maxMsgLen, int32_t *sendAvail); //Returns a pointer to a message buffer, maxMsgLen is the maximum allowed message length, sendAvail is the number of bytes free in the underlying send buffer
    int32_t (*sendMsg)(void *arg, int32_t offset, int32_t msgLen); //Sends one message. Returns number of bytes consumed from underlying send buffer. MsgBuffer is free to use again after this call.
+   int32_t (*sendBatch)(void *arg, const uint8_t *data, int32_t dataLen); //Optional. Sends one or more messages that are already framed with numheader. Returns dataLen on success, -1 on error or APX_TRANSMIT_HANDLER_WOULD_BLOCK.
 } apx_transmitHandler_t;
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
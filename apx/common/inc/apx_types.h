@@ -26,6 +26,7 @@ typedef APX_CONNECTION_COUNT_TYPE apx_connectionCount_t;
 typedef uint8_t apx_mode_t; //APX_NO_MODE, APX_CLIENT_MODE, APX_SERVER_MODE
 typedef uint16_t apx_eventId_t;
 typedef uint8_t apx_programType_t; //APX_PACK_PROGRAM, APX_UNPACK_PROGRAM
+typedef uint64_t apx_signatureId_t; //Interned port signature, see apx_signatureTable
 typedef uint8_t apx_fileType_t;
 
 typedef struct apx_dataWriteCmd_tag
@@ -88,6 +89,7 @@ typedef struct apx_dataWriteCmd_tag
 #define APX_PORT_ID_PROVIDE_PORT 0x80000000 //used inside an uint32_t to carry either a provide port ID and a require port ID.
 #define APX_PORT_ID_MASK         0x7FFFFFFF //used to clear the port flag (ready to cast it into an int32_t)
 #define APX_INVALID_PORT_ID      0xFFFFFFFF //Pattern used when there is no valid port id
+#define APX_INVALID_SIGNATURE_ID ((apx_signatureId_t) 0u)
 
 #define APX_BASE_TYPE_NONE     -1
 #define APX_BASE_TYPE_UINT8    0 //'C' (uint8)
@@ -103,6 +105,8 @@ typedef struct apx_dataWriteCmd_tag
 #define APX_BASE_TYPE_REF_ID   10 //type ID
 #define APX_BASE_TYPE_REF_NAME 11 //type name
 #define APX_BASE_TYPE_REF_PTR  12 //pointer to type (this is achieved only after derived has been called on data signature)
+#define APX_BASE_TYPE_FLOAT32  13 //'f' (IEEE-754 single precision)
+#define APX_BASE_TYPE_FLOAT64  14 //'d' (IEEE-754 double precision)
 typedef int8_t apx_baseType_t;
 
 #define APX_UNPACK_PROGRAM   ((apx_programType_t) 0)
@@ -116,6 +120,8 @@ typedef int8_t apx_baseType_t;
 #define SINT16_SIZE  2u
 #define SINT32_SIZE  4u
 #define SINT64_SIZE  8u
+#define FLOAT32_SIZE 4u
+#define FLOAT64_SIZE 8u
 #define BOOL_SIZE    sizeof(bool)
 
 
@@ -169,6 +175,16 @@ typedef uint8_t apx_providePortDataState_t;
 #define APX_PROVIDE_PORT_DATA_STATE_CONNECTED                     ((apx_providePortDataState_t) 3u)
 #define APX_PROVIDE_PORT_DATA_STATE_DISCONNECTED                  ((apx_providePortDataState_t) 4u)
 
+typedef uint8_t apx_portWriteMode_t;
+#define APX_PORT_WRITE_MODE_ALWAYS     ((apx_portWriteMode_t) 0u) //Every write is forwarded to the remote side
+#define APX_PORT_WRITE_MODE_ON_CHANGE  ((apx_portWriteMode_t) 1u) //Writes of unchanged data are suppressed (see apx_portWriteFilter)
+
+typedef uint8_t apx_backpressurePolicy_t;
+#define APX_BACKPRESSURE_POLICY_NONE        ((apx_backpressurePolicy_t) 0u) //Writes fail with APX_BUFFER_FULL_ERROR once the message queue is full
+#define APX_BACKPRESSURE_POLICY_DROP_OLDEST ((apx_backpressurePolicy_t) 1u) //Queued data messages are discarded while the queue is above its high-water mark
+#define APX_BACKPRESSURE_POLICY_COALESCE    ((apx_backpressurePolicy_t) 2u) //Writes switch to latest-value-wins coalescing while the queue is above its high-water mark
+#define APX_BACKPRESSURE_POLICY_DISCONNECT  ((apx_backpressurePolicy_t) 3u) //The connection is closed when the queue reaches its high-water mark
+
 typedef uint8_t apx_resource_type_t;
 #define APX_RESOURCE_TYPE_UNKNOWN ((apx_resource_type_t) 0) //Unknown
 #define APX_RESOURCE_TYPE_IPV4    ((apx_resource_type_t) 1) //Seems to be an IPv4 address
@@ -35,6 +35,7 @@
 #include "apx_error.h"
 #include "apx_vmSerializer.h"
 #include "apx_vmDeserializer.h"
+#include "apx_vmOpTable.h"
 #include "dtl_type.h"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -54,6 +55,10 @@ typedef struct apx_vm_tag
    uint8_t expectedNext; //The opcode(s) to expect next
    bool isArray;
    apx_dynLenType_t dynLenType;
+   apx_vmOpTable_t opTable; //flat operation table compiled by apx_vm_selectProgram
+   const apx_vmOpTable_t *activeOpTable; //weak reference to opTable or to a precompiled table, only valid when hasOpTable is true
+   bool hasOpTable; //true when selected program has a fixed data layout
+   bool isOpTableEnabled; //set to false to force byte code interpretation
 } apx_vm_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -64,6 +69,7 @@ void apx_vm_destroy(apx_vm_t *self);
 apx_vm_t* apx_vm_new(void);
 void apx_vm_delete(apx_vm_t *self);
 apx_error_t apx_vm_selectProgram(apx_vm_t *self, const adt_bytes_t *program);
+apx_error_t apx_vm_selectCompiledProgram(apx_vm_t *self, const adt_bytes_t *program, const apx_vmOpTable_t *opTable);
 uint8_t apx_vm_getProgType(apx_vm_t *self);
 apx_size_t apx_vm_getProgDataSize(apx_vm_t *self);
 apx_error_t apx_vm_setWriteBuffer(apx_vm_t *self, uint8_t *buffer, uint32_t bufSize);
@@ -71,6 +77,8 @@ apx_error_t apx_vm_setReadBuffer(apx_vm_t *self, const uint8_t *buffer, uint32_t
 apx_error_t apx_vm_packValue(apx_vm_t *self, const dtl_dv_t *dv);
 apx_error_t apx_vm_unpackValue(apx_vm_t *self, dtl_dv_t **dv);
 apx_error_t apx_vm_writeNullValue(apx_vm_t *self);
+void apx_vm_enableOpTable(apx_vm_t *self, bool enable);
+bool apx_vm_hasOpTable(apx_vm_t *self);
 #ifdef UNIT_TEST
 apx_size_t apx_vm_getBytesWritten(apx_vm_t *self);
 apx_size_t apx_vm_getBytesRead(apx_vm_t *self);
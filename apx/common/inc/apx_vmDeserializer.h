@@ -106,6 +106,10 @@ apx_error_t apx_vmDeserializer_unpackU32(apx_vmDeserializer_t *self, uint32_t *u
 apx_error_t apx_vmDeserializer_unpackS8(apx_vmDeserializer_t *self, int8_t *s8Value);
 apx_error_t apx_vmDeserializer_unpackS16(apx_vmDeserializer_t *self, int16_t *s16Value);
 apx_error_t apx_vmDeserializer_unpackS32(apx_vmDeserializer_t *self, int32_t *s32Value);
+apx_error_t apx_vmDeserializer_unpackU64(apx_vmDeserializer_t *self, uint64_t *u64Value);
+apx_error_t apx_vmDeserializer_unpackS64(apx_vmDeserializer_t *self, int64_t *s64Value);
+apx_error_t apx_vmDeserializer_unpackFloat32(apx_vmDeserializer_t *self, float *f32Value);
+apx_error_t apx_vmDeserializer_unpackFloat64(apx_vmDeserializer_t *self, double *f64Value);
 apx_error_t apx_vmDeserializer_unpackFixedStr(apx_vmDeserializer_t *self, adt_str_t *str, int32_t readLen);
 apx_error_t apx_vmDeserializer_unpackBytes(apx_vmDeserializer_t *self, adt_bytes_t **data, int32_t readLen);
 
@@ -118,6 +122,10 @@ apx_error_t apx_vmDeserializer_unpackU32Value(apx_vmDeserializer_t *self, uint32
 apx_error_t apx_vmDeserializer_unpackS8Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmDeserializer_unpackS16Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmDeserializer_unpackS32Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmDeserializer_unpackU64Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmDeserializer_unpackS64Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmDeserializer_unpackFloat32Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmDeserializer_unpackFloat64Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmDeserializer_unpackStrValue(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmDeserializer_unpackBytesValue(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType);
 
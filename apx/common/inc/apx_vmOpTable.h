@@ -0,0 +1,76 @@
+/*****************************************************************************
+* \file      apx_vmOpTable.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Flat, pre-resolved operation table for fixed-layout VM programs
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_VM_OP_TABLE_H
+#define APX_VM_OP_TABLE_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_vmdefs.h"
+#include "dtl_type.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+typedef struct apx_vmOp_tag
+{
+   const char *key; //record element name (weak reference into the program byte code). NULL when value is not a record
+   apx_size_t offset; //byte offset into the data buffer
+   uint32_t count; //0 for scalar, array length for fixed arrays
+   uint8_t width; //element size in bytes
+   uint8_t variant; //APX_VARIANT_U8 ... APX_VARIANT_FLOAT64
+} apx_vmOp_t;
+
+/**
+ * Program byte code translated into a flat list of (offset, width, signedness, count) operations.
+ * Only available for programs with a fixed data layout: scalars and fixed arrays of integer/float types,
+ * optionally placed as elements of a single (non-nested, non-array) record.
+ */
+typedef struct apx_vmOpTable_tag
+{
+   apx_vmOp_t *ops;
+   int32_t numOps;
+   int32_t capacity;
+   apx_size_t dataSize;
+   bool isRecord;
+} apx_vmOpTable_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_vmOpTable_create(apx_vmOpTable_t *self);
+void apx_vmOpTable_destroy(apx_vmOpTable_t *self);
+apx_vmOpTable_t *apx_vmOpTable_new(void);
+void apx_vmOpTable_delete(apx_vmOpTable_t *self);
+apx_error_t apx_vmOpTable_compile(apx_vmOpTable_t *self, const uint8_t *progBegin, const uint8_t *progEnd);
+void apx_vmOpTable_clear(apx_vmOpTable_t *self);
+apx_error_t apx_vmOpTable_pack(const apx_vmOpTable_t *self, uint8_t *pDest, apx_size_t bufSize, const dtl_dv_t *dv);
+apx_error_t apx_vmOpTable_unpack(const apx_vmOpTable_t *self, const uint8_t *pSrc, apx_size_t bufSize, dtl_dv_t **dv);
+
+#endif //APX_VM_OP_TABLE_H
@@ -108,6 +108,10 @@ apx_error_t apx_vmSerializer_packU32(apx_vmSerializer_t *self, uint32_t u32Value
 apx_error_t apx_vmSerializer_packS8(apx_vmSerializer_t *self, int8_t s8Value);
 apx_error_t apx_vmSerializer_packS16(apx_vmSerializer_t *self, int16_t s16Value);
 apx_error_t apx_vmSerializer_packS32(apx_vmSerializer_t *self, int32_t s32Value);
+apx_error_t apx_vmSerializer_packU64(apx_vmSerializer_t *self, uint64_t u64Value);
+apx_error_t apx_vmSerializer_packS64(apx_vmSerializer_t *self, int64_t s64Value);
+apx_error_t apx_vmSerializer_packFloat32(apx_vmSerializer_t *self, float f32Value);
+apx_error_t apx_vmSerializer_packFloat64(apx_vmSerializer_t *self, double f64Value);
 apx_error_t apx_vmSerializer_packFixedStr(apx_vmSerializer_t *self, const adt_str_t *str, int32_t writeLen);
 apx_error_t apx_vmSerializer_packBytes(apx_vmSerializer_t *self, const adt_bytes_t *bytes);
 apx_error_t apx_vmSerializer_packNull(apx_vmSerializer_t *self, int32_t writeLen);
@@ -119,6 +123,10 @@ apx_error_t apx_vmSerializer_packValueAsU32(apx_vmSerializer_t *self, uint32_t a
 apx_error_t apx_vmSerializer_packValueAsS8(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmSerializer_packValueAsS16(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmSerializer_packValueAsS32(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmSerializer_packValueAsU64(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmSerializer_packValueAsS64(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmSerializer_packValueAsFloat32(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
+apx_error_t apx_vmSerializer_packValueAsFloat64(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmSerializer_packValueAsString(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType);
 apx_error_t apx_vmSerializer_packValueAsBytes(apx_vmSerializer_t *self, bool autoPopState);
 
@@ -105,8 +105,14 @@ OP CODES
 4: FLOW_CTRL     : 1 variant
    1: ARRAY_NEXT
 
-5: UNPACK2 (reserved for 16 additional data types)
-6: PACK2 (reserved for 16 additional data types)
+5: UNPACK2   : 2 variants (room for 16 additional data types)
+   0: FLOAT32
+   1: FLOAT64
+
+6: PACK2     : 2 variants (room for 16 additional data types)
+   0: FLOAT32
+   1: FLOAT64
+
 7: INVALID
 
 */
@@ -150,6 +156,19 @@ typedef uint8_t apx_vmVariant_t;
 //APX_OPCODE_FLOW_CTRL variants
 #define APX_VARIANT_ARRAY_NEXT      0u
 
+//OPCODE UNPACK2
+#define APX_OPCODE_UNPACK2          5u
+//OPCODE PACK2
+#define APX_OPCODE_PACK2            6u
+//UNPACK2/PACK2 VARIANTS (uses same flag as APX_OPCODE_UNPACK/APX_OPCODE_PACK)
+#define APX_VARIANT2_FLOAT32        0u
+#define APX_VARIANT2_FLOAT64        1u
+
+//The VM folds UNPACK2/PACK2 into UNPACK/PACK by moving their variants into the range 16..31
+#define APX_VARIANT2_OFFSET         16u
+#define APX_VARIANT_FLOAT32         (APX_VARIANT2_OFFSET + APX_VARIANT2_FLOAT32)
+#define APX_VARIANT_FLOAT64         (APX_VARIANT2_OFFSET + APX_VARIANT2_FLOAT64)
+
 #define APX_OPCODE_INVALID          7u
 
 
@@ -0,0 +1,90 @@
+/*****************************************************************************
+* \file      apx_writeCoalescer.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Latest-value-wins table of pending dynamic data writes
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_WRITE_COALESCER_H
+#define APX_WRITE_COALESCER_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_cfg.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef struct apx_writeCoalescerEntry_tag
+{
+   uint32_t address;
+   uint32_t len;
+   uint32_t capacity; //size of heapData, 0 while inlineData is used
+   uint32_t sequence; //order in which entries were created, the message queued for the entry is in the same order
+   uint8_t *heapData;
+   uint8_t inlineData[APX_WRITE_COALESCER_INLINE_SIZE];
+   bool isUsed;
+   bool hasNewerOverlap; //set once an entry created later overlaps this one, no more writes are merged into it
+} apx_writeCoalescerEntry_t;
+
+/**
+ * Holds the newest bytes of every write that is still waiting to be sent, keyed by its start address.
+ * A write to an address that already has a pending entry overwrites that entry instead of creating a new message.
+ * Writes are expected to cover whole ports (same address, same length). When a write at the same address is longer
+ * than the pending one the entry grows, bytes beyond the end of a shorter write keep their pending value.
+ * A write is never merged into an entry that overlaps another entry created later, that would send its bytes ahead of
+ * older bytes for the same range. Such a write gets a new entry at the same address instead. Entries are flagged when a
+ * newer overlapping entry shows up, so the merge decision itself is a flag check. Entries sharing an address are taken
+ * oldest first, which matches the order of their queued messages.
+ * The table holds no lock of its own, apx_fileManagerWorker protects it with its spinlock.
+ */
+typedef struct apx_writeCoalescer_tag
+{
+   apx_writeCoalescerEntry_t *entries; //open-addressing hash table using linear probing
+   uint32_t *order; //slots of used entries sorted by address, then by sequence. Used to find overlapping entries
+   uint32_t capacity; //always a power of 2
+   uint32_t length;
+   uint32_t maxLen; //longest entry stored since the table was last empty, limits how far back overlaps are searched
+   uint32_t numWrites; //total number of writes
+   uint32_t numMerged; //number of writes that were merged into a pending entry
+   uint32_t nextSequence;
+} apx_writeCoalescer_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+void apx_writeCoalescer_create(apx_writeCoalescer_t *self);
+void apx_writeCoalescer_destroy(apx_writeCoalescer_t *self);
+apx_writeCoalescer_t *apx_writeCoalescer_new(void);
+void apx_writeCoalescer_delete(apx_writeCoalescer_t *self);
+
+apx_error_t apx_writeCoalescer_write(apx_writeCoalescer_t *self, uint32_t address, const uint8_t *data, uint32_t len, bool *isMerged);
+int32_t apx_writeCoalescer_getLength(const apx_writeCoalescer_t *self, uint32_t address);
+int32_t apx_writeCoalescer_take(apx_writeCoalescer_t *self, uint32_t address, uint8_t *dest, uint32_t destLen);
+void apx_writeCoalescer_remove(apx_writeCoalescer_t *self, uint32_t address);
+void apx_writeCoalescer_removeNewest(apx_writeCoalescer_t *self, uint32_t address);
+void apx_writeCoalescer_clear(apx_writeCoalescer_t *self);
+uint32_t apx_writeCoalescer_length(const apx_writeCoalescer_t *self);
+
+#endif //APX_WRITE_COALESCER_H
@@ -1,16 +1,11 @@
 //////////////////////////////////////////////////////////////////////////////
 // INCLUDES
 //////////////////////////////////////////////////////////////////////////////
-#include <errno.h>
 #include <malloc.h>
 #include <assert.h>
 #include <string.h>
 #include <stdio.h>
-#ifdef _MSC_VER
-#include <process.h>
-#endif
 #include "apx_allocator.h"
-#include "apx_logging.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -19,16 +14,41 @@
 //////////////////////////////////////////////////////////////////////////////
 // CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#if (APX_ALLOCATOR_MAX_BLOCK_SIZE % APX_ALLOCATOR_GRANULARITY) != 0
+# error "APX_ALLOCATOR_MAX_BLOCK_SIZE must be a multiple of APX_ALLOCATOR_GRANULARITY"
+#endif
+#if (APX_ALLOCATOR_MAX_SIZE_CLASSES > 255)
+# error "APX_ALLOCATOR_MAX_SIZE_CLASSES must fit in uint8_t"
+#endif
+
+#define NUM_GRANULES (APX_ALLOCATOR_MAX_BLOCK_SIZE / APX_ALLOCATOR_GRANULARITY + 1)
+#define INVALID_CLASS_INDEX 0xFFu
+#define SLAB_HEADER_SIZE 16u //keeps blocks 16-byte aligned relative to the malloc result
+#define NEXT_BLOCK(p) (*((void**) (p)))
+
+#ifdef _MSC_VER
+# define ATOMIC_LOAD_PTR(p) InterlockedCompareExchangePointer((PVOID volatile*) (p), 0, 0)
+# define ATOMIC_EXCHANGE_PTR(p, v) InterlockedExchangePointer((PVOID volatile*) (p), (v))
+# define ATOMIC_CAS_PTR(p, expected, desired) (InterlockedCompareExchangePointer((PVOID volatile*) (p), (desired), (expected)) == (expected))
+# define ATOMIC_INCREMENT(p) ((void) InterlockedIncrement((volatile LONG*) (p)))
+# define ATOMIC_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+# define MEMORY_FENCE() MemoryBarrier()
+#else
+# define ATOMIC_LOAD_PTR(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define ATOMIC_EXCHANGE_PTR(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+# define ATOMIC_CAS_PTR(p, expected, desired) __sync_bool_compare_and_swap((p), (expected), (desired))
+# define ATOMIC_INCREMENT(p) ((void) __atomic_fetch_add((p), 1u, __ATOMIC_RELAXED))
+# define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+# define MEMORY_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
-#ifndef UNIT_TEST
-static int8_t apx_allocator_startThread(apx_allocator_t *self);
-static THREAD_PROTO(threadTask,arg);
-#endif
-static bool apx_allocator_processEvent(apx_allocator_t *self);
-
+static apx_allocatorSizeClass_t *apx_allocator_findSizeClass(apx_allocator_t *self, size_t size);
+static void apx_allocatorSizeClass_create(apx_allocatorSizeClass_t *self, uint32_t blockSize);
+static void apx_allocatorSizeClass_destroy(apx_allocatorSizeClass_t *self);
+static void *apx_allocatorSizeClass_newSlab(apx_allocatorSizeClass_t *self);
 
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
@@ -42,32 +62,22 @@ static bool apx_allocator_processEvent(apx_allocator_t *self);
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
-apx_error_t apx_allocator_create(apx_allocator_t *self, uint16_t maxPendingMessages)
+apx_error_t apx_allocator_create(apx_allocator_t *self)
 {
    if (self != 0)
    {
-      size_t elemSize = sizeof(rbf_data_t);
-      adt_buf_err_t bufResult;
-
-      bufResult = adt_rbfh_createEx(&self->messages, (uint8_t) elemSize, ADT_RBFSH_MIN_NUM_ELEMS_DEFAULT, maxPendingMessages);
-      if (bufResult != BUF_E_OK)
+      uint32_t blockSize;
+      MUTEX_INIT(self->mutex);
+      self->numSizeClasses = 0u;
+      self->numFrees = 0u;
+      self->numLargeAllocs = 0u;
+      memset((void*) &self->classIndex[0], INVALID_CLASS_INDEX, sizeof(self->classIndex));
+      for (blockSize = APX_ALLOCATOR_GRANULARITY; blockSize < APX_ALLOCATOR_MAX_BLOCK_SIZE; blockSize <<= 1)
       {
-         return APX_MEM_ERROR;
+         (void) apx_allocator_addSizeClass(self, blockSize);
       }
-
-#ifdef _WIN32
-      self->workerThread = INVALID_HANDLE_VALUE;
-#else
-      self->workerThread = 0;
-#endif
-      self->workerThreadValid=false;
-      SPINLOCK_INIT(self->lock);
-#ifndef UNIT_TEST
-      SEMAPHORE_CREATE(self->semaphore);
-#endif
-      self->isRunning = false;
-      soa_init(&self->soa);
-      return APX_NO_ERROR;
+      //The largest class guarantees that every size up to APX_ALLOCATOR_MAX_BLOCK_SIZE has a class
+      return apx_allocator_addSizeClass(self, APX_ALLOCATOR_MAX_BLOCK_SIZE);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
@@ -76,71 +86,98 @@ void apx_allocator_destroy(apx_allocator_t *self)
 {
    if (self != 0)
    {
-      adt_rbfh_destroy(&self->messages);
-      soa_destroy(&self->soa);
-#ifndef UNIT_TEST
-      SEMAPHORE_DESTROY(self->semaphore);
-#endif
-      SPINLOCK_DESTROY(self->lock);
+      uint32_t i;
+      for (i = 0u; i < self->numSizeClasses; i++)
+      {
+         apx_allocatorSizeClass_destroy(&self->sizeClasses[i]);
+      }
+      self->numSizeClasses = 0u;
+      MUTEX_DESTROY(self->mutex);
    }
 }
 
-void apx_allocator_start(apx_allocator_t *self)
+apx_allocator_t *apx_allocator_new(void)
 {
-#ifndef UNIT_TEST
-   if( (self != 0) && (self->workerThreadValid == false) )
+   apx_allocator_t *self = (apx_allocator_t*) malloc(sizeof(apx_allocator_t));
+   if (self != 0)
    {
-      apx_allocator_startThread(self);
+      apx_error_t result = apx_allocator_create(self);
+      if (result != APX_NO_ERROR)
+      {
+         apx_allocator_destroy(self);
+         free(self);
+         self = (apx_allocator_t*) 0;
+      }
    }
-#endif
+   return self;
 }
 
-void apx_allocator_stop(apx_allocator_t *self)
+void apx_allocator_delete(apx_allocator_t *self)
 {
-   if( (self != 0) && (self->workerThreadValid == true) )
+   if (self != 0)
    {
-#ifdef _MSC_VER
-      DWORD result;
-#endif
-      rbf_data_t data = {0,0}; //sending a null-pointer with size 0 should wake up the workerThread
-      //1. enqueue message
-      SPINLOCK_ENTER(self->lock);
-      self->isRunning = false;
-      adt_rbfh_insert(&self->messages,(const uint8_t*) &data);
-      SPINLOCK_LEAVE(self->lock);
-      //2. wake workerThread
-#ifndef UNIT_TEST
-      SEMAPHORE_POST(self->semaphore);
-#endif
-#ifdef _MSC_VER
-      result = WaitForSingleObject(self->workerThread, 5000);
-      if (result == WAIT_TIMEOUT)
-      {
-         APX_LOG_ERROR("[APX_ALLOCATOR] timeout while joining workerThread");
-      }
-      else if (result == WAIT_FAILED)
-      {
-         DWORD lastError = GetLastError();
-         APX_LOG_ERROR("[APX_ALLOCATOR]  joining workerThread failed with %d", (int)lastError);         
-      }
-      CloseHandle(self->workerThread);
-      self->workerThread = INVALID_HANDLE_VALUE;
-#else
-      if(pthread_equal(pthread_self(),self->workerThread) == 0)
+      apx_allocator_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Adds a size class with block size equal to size (rounded up to APX_ALLOCATOR_GRANULARITY).
+ * This is typically called with the port data sizes of a node once its nodeInfo has been built, making sure
+ * that every dynamic data write for that node is served from an exactly sized block.
+ * Adding a size class that already exists, or one larger than APX_ALLOCATOR_MAX_BLOCK_SIZE, does nothing.
+ * Returns APX_BUFFER_FULL_ERROR when APX_ALLOCATOR_MAX_SIZE_CLASSES has been reached, the allocator remains fully
+ * functional in that case but may serve some sizes from a larger class.
+ * It's safe to call this while other threads are allocating and freeing.
+ */
+apx_error_t apx_allocator_addSizeClass(apx_allocator_t *self, size_t size)
+{
+   apx_error_t retval = APX_NO_ERROR;
+   uint32_t blockSize;
+   uint32_t numGranules;
+   uint32_t classIndex;
+   uint32_t i;
+   if ( (self == 0) || (size == 0u) )
+   {
+      return APX_INVALID_ARGUMENT_ERROR;
+   }
+   if (size > APX_ALLOCATOR_MAX_BLOCK_SIZE)
+   {
+      return APX_NO_ERROR; //served by malloc
+   }
+   numGranules = (uint32_t) ((size + APX_ALLOCATOR_GRANULARITY - 1u) / APX_ALLOCATOR_GRANULARITY);
+   blockSize = numGranules * APX_ALLOCATOR_GRANULARITY;
+   MUTEX_LOCK(self->mutex);
+   classIndex = self->classIndex[numGranules];
+   if ( (classIndex != INVALID_CLASS_INDEX) && (self->sizeClasses[classIndex].blockSize == blockSize) )
+   {
+      //already exists
+   }
+   else if (self->numSizeClasses >= APX_ALLOCATOR_MAX_SIZE_CLASSES)
+   {
+      retval = APX_BUFFER_FULL_ERROR;
+   }
+   else
+   {
+      classIndex = self->numSizeClasses++;
+      apx_allocatorSizeClass_create(&self->sizeClasses[classIndex], blockSize);
+      //The new class must be fully initialized before other threads can find it through classIndex
+      MEMORY_FENCE();
+      for (i = numGranules; i > 0u; i--)
       {
-         void *status;
-         int s = pthread_join(self->workerThread, &status);
-         if (s != 0)
+         uint8_t current = self->classIndex[i];
+         if ( (current == INVALID_CLASS_INDEX) || (self->sizeClasses[current].blockSize > blockSize) )
          {
-            APX_LOG_ERROR("[APX_ALLOCATOR] pthread_join error %d\n",s);
+            self->classIndex[i] = (uint8_t) classIndex;
+         }
+         else
+         {
+            break; //smaller sizes already have an equal or better fit
          }
       }
-      else
-      {
-         APX_LOG_ERROR("[APX_ALLOCATOR] pthread_join attempted on pthread_self()\n");
-      }
-#endif
    }
+   MUTEX_UNLOCK(self->mutex);
+   return retval;
 }
 
 uint8_t *apx_allocator_alloc(apx_allocator_t *self, size_t size)
@@ -148,187 +185,176 @@ uint8_t *apx_allocator_alloc(apx_allocator_t *self, size_t size)
    uint8_t *data = 0;
    if ( (self != 0) && (size > 0) )
    {
-      if (size <= SOA_SMALL_OBJECT_MAX_SIZE)
+      if (size <= APX_ALLOCATOR_MAX_BLOCK_SIZE)
       {
-         //use the small object allocator
-         SPINLOCK_ENTER(self->lock);
-         data = (uint8_t*) soa_alloc(&self->soa, size);
-         SPINLOCK_LEAVE(self->lock);
+         apx_allocatorSizeClass_t *sizeClass = apx_allocator_findSizeClass(self, size);
+         void *block;
+         SPINLOCK_ENTER(sizeClass->lock);
+         block = sizeClass->freeList;
+         if (block == 0)
+         {
+            //take ownership of everything freed since the last refill
+            block = ATOMIC_EXCHANGE_PTR(&sizeClass->remoteFreeList, (void*) 0);
+         }
+         if (block != 0)
+         {
+            sizeClass->freeList = NEXT_BLOCK(block);
+            sizeClass->numHits++;
+         }
+         else
+         {
+            block = apx_allocatorSizeClass_newSlab(sizeClass);
+            if (block != 0)
+            {
+               sizeClass->numMisses++;
+            }
+         }
+         SPINLOCK_LEAVE(sizeClass->lock);
+         data = (uint8_t*) block;
       }
       else
       {
          //use the default allocator
          data = (uint8_t*) malloc(size);
+         if (data != 0)
+         {
+            ATOMIC_INCREMENT(&self->numLargeAllocs);
+         }
       }
    }
    return data;
 }
 
+/**
+ * Returns memory previously received from apx_allocator_alloc. size must be the same value that was used in the call to
+ * apx_allocator_alloc. Small blocks are pushed onto a lock-free list, making this function safe to call from any thread
+ * without blocking.
+ */
 void apx_allocator_free(apx_allocator_t *self, uint8_t *ptr, size_t size)
 {
-   if (self != 0)
-   {
-      rbf_data_t data;
-      data.ptr=ptr;
-      data.size=(uint32_t) size;
-      //1. enqueue message
-      SPINLOCK_ENTER(self->lock);
-      adt_rbfh_insert(&self->messages,(const uint8_t*) &data);
-      SPINLOCK_LEAVE(self->lock);
-#ifndef UNIT_TEST
-      //2. wake worker thread
-      SEMAPHORE_POST(self->semaphore);
-#endif
-   }
-}
-
-bool apx_allocator_isRunning(apx_allocator_t *self)
-{
-   if ( self != 0)
+   if ( (self != 0) && (ptr != 0) )
    {
-      return self->isRunning;
+      if (size <= APX_ALLOCATOR_MAX_BLOCK_SIZE)
+      {
+         apx_allocatorSizeClass_t *sizeClass = apx_allocator_findSizeClass(self, size);
+         void *head;
+         do
+         {
+            head = ATOMIC_LOAD_PTR(&sizeClass->remoteFreeList);
+            NEXT_BLOCK(ptr) = head;
+         } while (!ATOMIC_CAS_PTR(&sizeClass->remoteFreeList, head, (void*) ptr));
+      }
+      else
+      {
+         free(ptr);
+      }
+      ATOMIC_INCREMENT(&self->numFrees);
    }
-   return false;
 }
 
-#ifdef UNIT_TEST
-void apx_allocator_processAll(apx_allocator_t *self)
+void apx_allocator_getStats(apx_allocator_t *self, apx_allocatorStats_t *stats)
 {
-   bool result = true;
-   while(result)
+   if ( (self != 0) && (stats != 0) )
    {
-      result = apx_allocator_processEvent(self);
+      uint32_t i;
+      uint32_t numSizeClasses;
+      memset(stats, 0, sizeof(apx_allocatorStats_t));
+      MUTEX_LOCK(self->mutex);
+      numSizeClasses = self->numSizeClasses;
+      MUTEX_UNLOCK(self->mutex);
+      for (i = 0u; i < numSizeClasses; i++)
+      {
+         apx_allocatorSizeClass_t *sizeClass = &self->sizeClasses[i];
+         SPINLOCK_ENTER(sizeClass->lock);
+         stats->numHits += sizeClass->numHits;
+         stats->numMisses += sizeClass->numMisses;
+         SPINLOCK_LEAVE(sizeClass->lock);
+      }
+      stats->numLargeAllocs = ATOMIC_LOAD(&self->numLargeAllocs);
+      stats->numFrees = ATOMIC_LOAD(&self->numFrees);
+      stats->numSizeClasses = numSizeClasses;
    }
 }
 
-int32_t apx_allocator_numPendingMessages(apx_allocator_t *self)
+/**
+ * Returns the block size that would be used to serve an allocation of size bytes.
+ * Returns 0 for sizes that are served by malloc.
+ */
+uint32_t apx_allocator_getBlockSize(apx_allocator_t *self, size_t size)
 {
-   if (self != 0)
+   if ( (self != 0) && (size > 0u) && (size <= APX_ALLOCATOR_MAX_BLOCK_SIZE) )
    {
-      return adt_rbfh_length(&self->messages);
+      return apx_allocator_findSizeClass(self, size)->blockSize;
    }
-   return -1;
+   return 0u;
 }
-#endif
 
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
-#ifndef UNIT_TEST
-static int8_t apx_allocator_startThread(apx_allocator_t *self)
+static apx_allocatorSizeClass_t *apx_allocator_findSizeClass(apx_allocator_t *self, size_t size)
 {
-   if( self != 0){
-   self->isRunning = true;
-   self->workerThreadValid = true;
-#ifdef _WIN32
-      THREAD_CREATE(self->workerThread,threadTask,self,self->threadId);
-      if(self->workerThread == INVALID_HANDLE_VALUE){
-         self->workerThreadValid = false;
-         return -1;
-      }
-#else
-      int rc = THREAD_CREATE(self->workerThread,threadTask,self);
-      if(rc != 0){
-         self->workerThreadValid = false;
-         return -1;
-      }
-#endif
-      //from this point forward all access to self must be protected by spin lock
-      return 0;
-   }
-   errno = EINVAL;
-   return -1;
+   uint8_t classIndex = self->classIndex[(size + APX_ALLOCATOR_GRANULARITY - 1u) / APX_ALLOCATOR_GRANULARITY];
+   assert(classIndex < self->numSizeClasses);
+   return &self->sizeClasses[classIndex];
 }
 
-static THREAD_PROTO(threadTask,arg)
+static void apx_allocatorSizeClass_create(apx_allocatorSizeClass_t *self, uint32_t blockSize)
 {
-   if(arg!=0)
-   {
-
-      apx_allocator_t *self;
-      uint32_t messages_processed=0;
-      self = (apx_allocator_t*) arg;
-      for(;;)
-      {
-#ifdef _MSC_VER
-         DWORD result = WaitForSingleObject(self->semaphore, INFINITE);
-         if (result == WAIT_OBJECT_0)
-#else
-         int result = sem_wait(&self->semaphore);
-         if (result == 0)
-#endif
-         {
-            bool result;
-            messages_processed++;
-            result = apx_allocator_processEvent(self);
-            if (!result)
-            {
-               break;
-            }
-         }
-         else
-         {
-#ifdef _MSC_VER
-            DWORD lastError = GetLastError();
-            APX_LOG_ERROR("[APX_ALLOCATOR]: failure while waiting for semaphore, lastError=%d", lastError);
-#else
-            APX_LOG_ERROR("[APX_ALLOCATOR]: failure while waiting for semaphore, errno=%d", errno);
-#endif
-            break;
-         }
-      }
-      //APX_LOG_DEBUG("[APX_ALLOCATOR]: messages_processed: %u\n", messages_processed);
-   }
-   THREAD_RETURN(0);
+   SPINLOCK_INIT(self->lock);
+   self->freeList = (void*) 0;
+   self->remoteFreeList = (void*) 0;
+   self->slabs = (void*) 0;
+   self->blockSize = blockSize;
+   self->numHits = 0u;
+   self->numMisses = 0u;
 }
-#endif //UNIT_TEST
 
-static bool apx_allocator_processEvent(apx_allocator_t *self)
+static void apx_allocatorSizeClass_destroy(apx_allocatorSizeClass_t *self)
 {
-   bool retval = true;
-   uint8_t rc;
-   rbf_data_t data;
-   bool delayedFree = false;
-   SPINLOCK_ENTER(self->lock);
-   rc = adt_rbfh_remove(&self->messages,(uint8_t*) &data);
-   if (rc == BUF_E_OK)
+   void *slab = self->slabs;
+   while (slab != 0)
    {
-      if (data.ptr != 0)
-      {
-         if (data.size<=SOA_SMALL_OBJECT_MAX_SIZE)
-         {
-            soa_free(&self->soa,data.ptr,data.size);
-         }
-         else
-         {
-            delayedFree = true;
-         }
-      }
-      else
-      {
-         retval = false;
-      }
+      void *next = NEXT_BLOCK(slab);
+      free(slab);
+      slab = next;
    }
-   else
+   self->slabs = (void*) 0;
+   self->freeList = (void*) 0;
+   self->remoteFreeList = (void*) 0;
+   SPINLOCK_DESTROY(self->lock);
+}
+
+/**
+ * Allocates a new slab, returns its first block and moves the remaining blocks into freeList.
+ * Caller must hold the size class lock.
+ */
+static void *apx_allocatorSizeClass_newSlab(apx_allocatorSizeClass_t *self)
+{
+   uint32_t numBlocks = (APX_ALLOCATOR_SLAB_SIZE - SLAB_HEADER_SIZE) / self->blockSize;
+   uint8_t *slab;
+   uint8_t *first;
+   uint32_t i;
+   if (numBlocks == 0u)
    {
-      retval = false;
+      numBlocks = 1u;
    }
-   SPINLOCK_LEAVE(self->lock);
-
-   if (delayedFree == true)
+   slab = (uint8_t*) malloc(SLAB_HEADER_SIZE + numBlocks * self->blockSize);
+   if (slab == 0)
    {
-      free(data.ptr);
+      return (void*) 0;
    }
-   else if ( (rc == BUF_E_OK) && (data.ptr == 0) )
+   NEXT_BLOCK(slab) = self->slabs;
+   self->slabs = (void*) slab;
+   first = slab + SLAB_HEADER_SIZE;
+   for (i = 1u; i < numBlocks; i++)
    {
-      retval = false; //NULL data pointer is a valid exit message
+      uint8_t *block = first + i * self->blockSize;
+      NEXT_BLOCK(block) = (i + 1u < numBlocks) ? (void*) (block + self->blockSize) : self->freeList;
    }
-   else
+   if (numBlocks > 1u)
    {
-      //Already handled by soa_free or bufResult != E_BUF_OK
+      self->freeList = (void*) (first + self->blockSize);
    }
-   return retval;
+   return (void*) first;
 }
-
-
-
@@ -43,6 +43,9 @@
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
 static apx_error_t apx_bytePortMap_build(apx_bytePortMap_t *self, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_size_t mapLen);
+static apx_error_t apx_bytePortMap_buildOffsets(apx_bytePortMap_t *self, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_size_t mapLen);
+static apx_error_t apx_bytePortMap_buildPageTable(apx_bytePortMap_t *self);
+static int32_t apx_bytePortMap_searchOffsets(const apx_offset_t *offsets, int32_t first, int32_t last, int32_t offset);
 
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL VARIABLES
@@ -53,17 +56,46 @@ static apx_error_t apx_bytePortMap_build(apx_bytePortMap_t *self, const apx_port
 // GLOBAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
 apx_error_t apx_bytePortMap_create(apx_bytePortMap_t *self, const apx_portDataProps_t *props, apx_portCount_t numPorts)
+{
+   return apx_bytePortMap_createWithType(self, props, numPorts, APX_BYTE_PORT_MAP_AUTO);
+}
+
+apx_error_t apx_bytePortMap_createWithType(apx_bytePortMap_t *self, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType)
 {
    apx_error_t retval = APX_INVALID_ARGUMENT_ERROR;
-   if ( (self != 0) && (props != 0) && (numPorts > 0))
+   if ( (self != 0) && (props != 0) && (numPorts > 0) && (mapType <= APX_BYTE_PORT_MAP_PAGED) )
    {
-      retval = APX_NO_ERROR;
+      apx_size_t mapLen;
       self->mapData = (apx_portId_t*) 0;
+      self->portOffsets = (apx_offset_t*) 0;
       self->mapLen = 0;
-      apx_size_t mapLen = apx_portDataProps_sumDataSize(props, numPorts);
+      self->numPages = 0;
+      self->numPorts = numPorts;
+      self->pageShift = 0u;
+      mapLen = apx_portDataProps_sumDataSize(props, numPorts);
+      if (mapType == APX_BYTE_PORT_MAP_AUTO)
+      {
+         mapType = apx_bytePortMap_selectType(mapLen, numPorts);
+      }
+      self->mapType = (uint8_t) mapType;
       if (mapLen > 0)
       {
-         retval = apx_bytePortMap_build(self, props, numPorts, mapLen);
+         if (mapType == APX_BYTE_PORT_MAP_DENSE)
+         {
+            retval = apx_bytePortMap_build(self, props, numPorts, mapLen);
+         }
+         else
+         {
+            retval = apx_bytePortMap_buildOffsets(self, props, numPorts, mapLen);
+            if ( (retval == APX_NO_ERROR) && (mapType == APX_BYTE_PORT_MAP_PAGED) )
+            {
+               retval = apx_bytePortMap_buildPageTable(self);
+            }
+         }
+         if (retval != APX_NO_ERROR)
+         {
+            apx_bytePortMap_destroy(self);
+         }
       }
       else
       {
@@ -75,18 +107,32 @@ apx_error_t apx_bytePortMap_create(apx_bytePortMap_t *self, const apx_portDataPr
 
 void apx_bytePortMap_destroy(apx_bytePortMap_t *self)
 {
-   if ( (self != 0) && (self->mapData != 0) )
+   if (self != 0)
    {
-      free(self->mapData);
+      if (self->mapData != 0)
+      {
+         free(self->mapData);
+         self->mapData = (apx_portId_t*) 0;
+      }
+      if (self->portOffsets != 0)
+      {
+         free(self->portOffsets);
+         self->portOffsets = (apx_offset_t*) 0;
+      }
    }
 }
 
 apx_bytePortMap_t *apx_bytePortMap_new(const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_error_t *errorCode)
+{
+   return apx_bytePortMap_newWithType(props, numPorts, APX_BYTE_PORT_MAP_AUTO, errorCode);
+}
+
+apx_bytePortMap_t *apx_bytePortMap_newWithType(const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType, apx_error_t *errorCode)
 {
    apx_bytePortMap_t *self = (apx_bytePortMap_t*) malloc(sizeof(apx_bytePortMap_t));
    if (self != 0)
    {
-      apx_error_t result = apx_bytePortMap_create(self, props, numPorts);
+      apx_error_t result = apx_bytePortMap_createWithType(self, props, numPorts, mapType);
       if (result != APX_NO_ERROR)
       {
          free(self);
@@ -114,7 +160,21 @@ apx_portId_t apx_bytePortMap_lookup(const apx_bytePortMap_t *self, int32_t offse
 {
    if ( (self != 0) && (offset >= 0) && (offset < self->mapLen) )
    {
-      return self->mapData[offset];
+      switch(self->mapType)
+      {
+      case APX_BYTE_PORT_MAP_DENSE:
+         return self->mapData[offset];
+      case APX_BYTE_PORT_MAP_INTERVAL:
+         return (apx_portId_t) apx_bytePortMap_searchOffsets(self->portOffsets, 0, self->numPorts - 1, offset);
+      case APX_BYTE_PORT_MAP_PAGED:
+         {
+            int32_t page = offset >> self->pageShift;
+            int32_t last = (page + 1 < self->numPages)? self->mapData[page + 1] : self->numPorts - 1;
+            return (apx_portId_t) apx_bytePortMap_searchOffsets(self->portOffsets, self->mapData[page], last, offset);
+         }
+      default:
+         break;
+      }
    }
    return -1;
 }
@@ -129,6 +189,59 @@ apx_size_t apx_bytePortMap_length(const apx_bytePortMap_t *self)
    return 0;
 }
 
+apx_bytePortMapType_t apx_bytePortMap_getType(const apx_bytePortMap_t *self)
+{
+   if (self != 0)
+   {
+      return (apx_bytePortMapType_t) self->mapType;
+   }
+   return APX_BYTE_PORT_MAP_AUTO;
+}
+
+/**
+ * Returns number of bytes used by the map, including the map object itself
+ */
+apx_size_t apx_bytePortMap_getMemoryUsage(const apx_bytePortMap_t *self)
+{
+   apx_size_t retval = 0u;
+   if (self != 0)
+   {
+      retval = (apx_size_t) sizeof(apx_bytePortMap_t);
+      switch(self->mapType)
+      {
+      case APX_BYTE_PORT_MAP_DENSE:
+         retval += (apx_size_t) (self->mapLen * sizeof(apx_portId_t));
+         break;
+      case APX_BYTE_PORT_MAP_PAGED:
+         retval += (apx_size_t) (self->numPages * sizeof(apx_portId_t));
+         //fall through
+      case APX_BYTE_PORT_MAP_INTERVAL:
+         retval += (apx_size_t) ( (self->numPorts + 1) * sizeof(apx_offset_t) );
+         break;
+      default:
+         break;
+      }
+   }
+   return retval;
+}
+
+/**
+ * Small maps and maps where the average port is only a couple of bytes use one port ID per byte.
+ * Everything else stores the sorted start offset of each port, adding a page table when there are many ports.
+ */
+apx_bytePortMapType_t apx_bytePortMap_selectType(apx_size_t mapLen, apx_portCount_t numPorts)
+{
+   if ( (numPorts <= 0) || (mapLen <= APX_BYTE_PORT_MAP_DENSE_MAX_LEN) || (mapLen <= 2u * ((apx_size_t) numPorts + 1u)) )
+   {
+      return APX_BYTE_PORT_MAP_DENSE;
+   }
+   if (numPorts >= APX_BYTE_PORT_MAP_PAGED_MIN_PORTS)
+   {
+      return APX_BYTE_PORT_MAP_PAGED;
+   }
+   return APX_BYTE_PORT_MAP_INTERVAL;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
@@ -164,3 +277,81 @@ static apx_error_t apx_bytePortMap_build(apx_bytePortMap_t *self, const apx_port
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
+
+static apx_error_t apx_bytePortMap_buildOffsets(apx_bytePortMap_t *self, const apx_portDataProps_t *propsArray, apx_portCount_t numPorts, apx_size_t mapLen)
+{
+   if ( (self != 0) && (propsArray != 0) && (numPorts > 0) && (mapLen > 0u) )
+   {
+      apx_portId_t portId;
+      apx_offset_t offset = 0;
+      self->portOffsets = (apx_offset_t*) malloc( ( (apx_size_t) numPorts + 1u) * sizeof(apx_offset_t));
+      if (self->portOffsets == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      self->mapLen = mapLen;
+      for (portId=0; portId < numPorts; portId++)
+      {
+         self->portOffsets[portId] = offset;
+         offset += (apx_offset_t) propsArray[portId].dataSize;
+      }
+      assert(offset == (apx_offset_t) mapLen);
+      self->portOffsets[numPorts] = offset;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * The page size is the largest power of two not exceeding the average port size.
+ * Each entry holds the port that contains the first byte of the page,
+ * which limits the binary search in lookup to the ports that start inside that page.
+ */
+static apx_error_t apx_bytePortMap_buildPageTable(apx_bytePortMap_t *self)
+{
+   int32_t page;
+   int32_t portId = 0;
+   int32_t averageSize = self->mapLen / self->numPorts;
+   self->pageShift = 0u;
+   while ( (averageSize >> (self->pageShift + 1u)) > 0)
+   {
+      self->pageShift++;
+   }
+   self->numPages = ( (self->mapLen - 1) >> self->pageShift) + 1;
+   self->mapData = (apx_portId_t*) malloc( (apx_size_t) self->numPages * sizeof(apx_portId_t));
+   if (self->mapData == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   for (page = 0; page < self->numPages; page++)
+   {
+      int32_t pageStart = page << self->pageShift;
+      while (self->portOffsets[portId + 1] <= pageStart)
+      {
+         portId++;
+      }
+      self->mapData[page] = (apx_portId_t) portId;
+   }
+   return APX_NO_ERROR;
+}
+
+/**
+ * Returns the last port in [first, last] whose start offset is less than or equal to offset.
+ * Ports with zero data size share start offset with the next port and are thereby skipped.
+ */
+static int32_t apx_bytePortMap_searchOffsets(const apx_offset_t *offsets, int32_t first, int32_t last, int32_t offset)
+{
+   while (first < last)
+   {
+      int32_t middle = first + ( (last - first + 1) / 2 );
+      if (offsets[middle] <= offset)
+      {
+         first = middle;
+      }
+      else
+      {
+         last = middle - 1;
+      }
+   }
+   return first;
+}
@@ -293,6 +293,24 @@ static apx_error_t apx_compiler_compileDataElement(apx_compiler_t *self, apx_dat
          variant = APX_VARIANT_S32;
          elemSize = UINT32_SIZE;
          break;
+      case APX_BASE_TYPE_UINT64:
+         variant = APX_VARIANT_U64;
+         elemSize = UINT64_SIZE;
+         break;
+      case APX_BASE_TYPE_SINT64:
+         variant = APX_VARIANT_S64;
+         elemSize = SINT64_SIZE;
+         break;
+      case APX_BASE_TYPE_FLOAT32:
+         variant = APX_VARIANT2_FLOAT32;
+         elemSize = FLOAT32_SIZE;
+         opcode = (opcode == APX_OPCODE_PACK)? APX_OPCODE_PACK2 : APX_OPCODE_UNPACK2;
+         break;
+      case APX_BASE_TYPE_FLOAT64:
+         variant = APX_VARIANT2_FLOAT64;
+         elemSize = FLOAT64_SIZE;
+         opcode = (opcode == APX_OPCODE_PACK)? APX_OPCODE_PACK2 : APX_OPCODE_UNPACK2;
+         break;
       case APX_BASE_TYPE_RECORD:
          variant = APX_VARIANT_RECORD;
          break;
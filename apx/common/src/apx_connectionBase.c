@@ -108,7 +108,7 @@ apx_error_t apx_connectionBase_create(apx_connectionBase_t *self, apx_mode_t mod
       self->totalBytesReceived = 0u;
       self->totalBytesSent = 0u;
       self->mode = mode;
-      rc = apx_allocator_create(&self->allocator, APX_MAX_NUM_MESSAGES);
+      rc = apx_allocator_create(&self->allocator);
       if (rc != APX_NO_ERROR)
       {
          return rc;
@@ -146,7 +146,6 @@ apx_error_t apx_connectionBase_create(apx_connectionBase_t *self, apx_mode_t mod
       }
       adt_list_create(&self->connectionEventListeners, apx_connectionEventListener_vdelete);
       MUTEX_INIT(self->eventListenerMutex);
-      apx_allocator_start(&self->allocator);
       return rc;
    }
    return APX_INVALID_ARGUMENT_ERROR;
@@ -161,7 +160,6 @@ void apx_connectionBase_destroy(apx_connectionBase_t *self)
       apx_nodeManager_destroy(&self->nodeManager);
       MUTEX_DESTROY(self->eventListenerMutex);
       adt_list_destroy(&self->connectionEventListeners);
-      apx_allocator_stop(&self->allocator);
       apx_allocator_destroy(&self->allocator);
    }
 }
@@ -243,6 +241,10 @@ void apx_connectionBase_attachNodeInstance(apx_connectionBase_t *self, apx_nodeI
       numProvidePorts = apx_nodeInstance_getNumProvidePorts(nodeInstance);
       apx_nodeManager_attachNode(&self->nodeManager, nodeInstance);
       apx_nodeInstance_setConnection(nodeInstance, self);
+      if (apx_nodeInstance_getNodeInfo(nodeInstance) != 0)
+      {
+         apx_connectionBase_addAllocatorSizeClasses(self, apx_nodeInstance_getNodeInfo(nodeInstance));
+      }
       if (numProvidePorts > 0)
       {
          rc = apx_nodeInstance_fillProvidePortDataFileInfo(nodeInstance, &fileInfo);
@@ -299,6 +301,93 @@ void apx_connectionBase_free(apx_connectionBase_t *self, uint8_t *ptr, size_t si
    }
 }
 
+/**
+ * Adds exact allocator size classes for every port data size in nodeInfo as well as for the complete port data files.
+ * These are the sizes used by apx_connectionBase_alloc when port data is written.
+ */
+void apx_connectionBase_addAllocatorSizeClasses(apx_connectionBase_t *self, const apx_nodeInfo_t *nodeInfo)
+{
+   if ( (self != 0) && (nodeInfo != 0) )
+   {
+      apx_portCount_t numRequirePorts = apx_nodeInfo_getNumRequirePorts(nodeInfo);
+      apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
+      apx_portId_t portId;
+      for (portId = 0; portId < numRequirePorts; portId++)
+      {
+         apx_portDataProps_t *props = apx_nodeInfo_getRequirePortDataProps(nodeInfo, portId);
+         if ( (props != 0) && (props->dataSize > 0u) )
+         {
+            (void) apx_allocator_addSizeClass(&self->allocator, props->dataSize);
+         }
+      }
+      for (portId = 0; portId < numProvidePorts; portId++)
+      {
+         apx_portDataProps_t *props = apx_nodeInfo_getProvidePortDataProps(nodeInfo, portId);
+         if ( (props != 0) && (props->dataSize > 0u) )
+         {
+            (void) apx_allocator_addSizeClass(&self->allocator, props->dataSize);
+         }
+      }
+      if (numRequirePorts > 0)
+      {
+         (void) apx_allocator_addSizeClass(&self->allocator, apx_nodeInfo_getRequirePortDataLen(nodeInfo));
+      }
+      if (numProvidePorts > 0)
+      {
+         (void) apx_allocator_addSizeClass(&self->allocator, apx_nodeInfo_getProvidePortDataLen(nodeInfo));
+      }
+   }
+}
+
+void apx_connectionBase_getAllocatorStats(apx_connectionBase_t *self, apx_allocatorStats_t *stats)
+{
+   if (self != 0)
+   {
+      apx_allocator_getStats(&self->allocator, stats);
+   }
+}
+
+/**
+ * Enables latest-value-wins coalescing of port data sent on this connection, see apx_fileManagerWorker_setCoalesceConfig
+ */
+void apx_connectionBase_setCoalesceConfig(apx_connectionBase_t *self, bool isEnabled, uint32_t maxUpdateRate)
+{
+   if (self != 0)
+   {
+      apx_fileManagerWorker_setCoalesceConfig(&self->fileManager.worker, isEnabled, maxUpdateRate);
+   }
+}
+
+/**
+ * Selects what this connection does when its remote side cannot keep up, see apx_fileManagerWorker_setBackpressureConfig
+ */
+void apx_connectionBase_setBackpressureConfig(apx_connectionBase_t *self, apx_backpressurePolicy_t policy, uint32_t queueHighWaterMark)
+{
+   if (self != 0)
+   {
+      apx_fileManagerWorker_setBackpressureConfig(&self->fileManager.worker, policy, queueHighWaterMark);
+   }
+}
+
+/**
+ * Lets an external scheduler run the transmit side of this connection, see apx_fileManagerWorker_setScheduler
+ */
+void apx_connectionBase_setWorkerScheduler(apx_connectionBase_t *self, apx_fileManagerWorker_scheduleFunc *scheduleFunc, void *arg)
+{
+   if (self != 0)
+   {
+      apx_fileManagerWorker_setScheduler(&self->fileManager.worker, scheduleFunc, arg);
+   }
+}
+
+void apx_connectionBase_getWorkerStats(apx_connectionBase_t *self, apx_fileManagerWorkerStats_t *stats)
+{
+   if (self != 0)
+   {
+      apx_fileManagerWorker_getStats(&self->fileManager.worker, stats);
+   }
+}
+
 
 /*** Internal Callback API ***/
 //Callbacks triggered due to events happening remotely
@@ -425,8 +514,14 @@ apx_error_t apx_connectionBase_updateProvidePortDataDirect(apx_connectionBase_t
          {
             uint8_t *dataBuf;
             uint32_t address;
+            apx_error_t result;
             uint32_t startAddress = apx_file_getStartAddress(file);
             address = startAddress + offset;
+            result = apx_fileManager_writeDynamicDataDirect(&self->fileManager, address, len, data);
+            if (result != APX_NOT_IMPLEMENTED_ERROR)
+            {
+               return result;
+            }
             dataBuf = apx_allocator_alloc(&self->allocator, len);
             if (dataBuf == 0)
             {
@@ -470,8 +565,14 @@ apx_error_t apx_connectionBase_updateRequirePortDataDirect(apx_connectionBase_t
          {
             uint8_t *dataBuf;
             uint32_t address;
+            apx_error_t result;
             uint32_t startAddress = apx_file_getStartAddress(file);
             address = startAddress + offset;
+            result = apx_fileManager_writeDynamicDataDirect(&self->fileManager, address, len, data);
+            if (result != APX_NOT_IMPLEMENTED_ERROR)
+            {
+               return result;
+            }
             dataBuf = apx_allocator_alloc(&self->allocator, len);
             if (dataBuf == 0)
             {
@@ -988,6 +1089,7 @@ static void apx_connectionBase_stopWorkerThread(apx_connectionBase_t *self)
 static apx_error_t apx_connectionBase_initTransmitHandler(apx_connectionBase_t *self)
 {
    apx_transmitHandler_t handler;
+   memset(&handler, 0, sizeof(handler));
    if (self->vtable.fillTransmitHandler != 0)
    {
       apx_error_t rc = self->vtable.fillTransmitHandler((void*) self, &handler);
@@ -49,6 +49,8 @@
 static apx_error_t apx_dataElement_calcDynLenType(apx_dataElement_t *self);
 static dtl_dv_t *apx_dataElement_makeU32InitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode);
 static dtl_dv_t *apx_dataElement_makeS32InitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode);
+static dtl_dv_t *apx_dataElement_makeNumericInitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode);
+static dtl_sv_t *apx_dataElement_convertNumericScalar(apx_baseType_t baseType, const dtl_sv_t *sv);
 static dtl_dv_t *apx_dataElement_makeStringInitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode);
 static dtl_dv_t *apx_dataElement_makeHashInitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode);
 static dtl_dv_t *apx_dataElement_makeHashInitValueFromArray(apx_dataElement_t *self, dtl_av_t *av, apx_error_t *errorCode);
@@ -352,6 +354,18 @@ apx_error_t apx_dataElement_calcPackLen(apx_dataElement_t *self, apx_size_t *pac
          case APX_BASE_TYPE_SINT32:
             elemLen = (uint32_t) sizeof(int32_t);
             break;
+         case APX_BASE_TYPE_UINT64:
+            elemLen = (uint32_t) UINT64_SIZE;
+            break;
+         case APX_BASE_TYPE_SINT64:
+            elemLen = (uint32_t) SINT64_SIZE;
+            break;
+         case APX_BASE_TYPE_FLOAT32:
+            elemLen = (uint32_t) FLOAT32_SIZE;
+            break;
+         case APX_BASE_TYPE_FLOAT64:
+            elemLen = (uint32_t) FLOAT64_SIZE;
+            break;
          case APX_BASE_TYPE_STRING:
             elemLen = (uint32_t) sizeof(uint8_t);
             break;
@@ -471,6 +485,11 @@ dtl_dv_t *apx_dataElement_makeProperInitValueFromDynamicValue(apx_dataElement_t
          return apx_dataElement_makeS32InitValueFromDynamicValue(self, dv, errorCode);
       case APX_BASE_TYPE_SINT32:
          return apx_dataElement_makeS32InitValueFromDynamicValue(self, dv, errorCode);
+      case APX_BASE_TYPE_UINT64:
+      case APX_BASE_TYPE_SINT64:
+      case APX_BASE_TYPE_FLOAT32:
+      case APX_BASE_TYPE_FLOAT64:
+         return apx_dataElement_makeNumericInitValueFromDynamicValue(self, dv, errorCode);
       case APX_BASE_TYPE_STRING:
          return apx_dataElement_makeStringInitValueFromDynamicValue(self, dv, errorCode);
       case APX_BASE_TYPE_RECORD:
@@ -682,6 +701,118 @@ static dtl_dv_t *apx_dataElement_makeS32InitValueFromDynamicValue(apx_dataElemen
    return (dtl_dv_t*) retval;
 }
 
+/**
+ * Init values for 64-bit integer and floating point base types
+ */
+static dtl_dv_t *apx_dataElement_makeNumericInitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode)
+{
+   dtl_dv_t *retval = (dtl_dv_t*) 0;
+   if ( (self != 0) && (dv != 0) && (errorCode != 0) )
+   {
+      *errorCode = APX_NO_ERROR;
+      if ( (self->arrayLen == 0) && (dtl_dv_type((dtl_dv_t*) dv) == DTL_DV_SCALAR) )
+      {
+         retval = (dtl_dv_t*) apx_dataElement_convertNumericScalar(self->baseType, (const dtl_sv_t*) dv);
+         if (retval == 0)
+         {
+            *errorCode = APX_INIT_VALUE_ERROR;
+         }
+      }
+      else if ( (self->arrayLen > 0) && (dtl_dv_type((dtl_dv_t*) dv) == DTL_DV_ARRAY) )
+      {
+         dtl_av_t *av = (dtl_av_t*) dv;
+         int32_t arrayLen = dtl_av_length(av);
+         if ( ((int32_t) self->arrayLen) != arrayLen)
+         {
+            *errorCode = APX_LENGTH_ERROR;
+         }
+         else
+         {
+            dtl_av_t *av_retval = dtl_av_new();
+            if (av_retval == 0)
+            {
+               *errorCode = APX_MEM_ERROR;
+            }
+            else
+            {
+               int32_t i;
+               for(i=0; i < arrayLen; i++)
+               {
+                  dtl_dv_t *childValue = dtl_av_value(av, i);
+                  dtl_sv_t *createdValue = (dtl_sv_t*) 0;
+                  if ( (childValue != 0) && (dtl_dv_type(childValue) == DTL_DV_SCALAR) )
+                  {
+                     createdValue = apx_dataElement_convertNumericScalar(self->baseType, (const dtl_sv_t*) childValue);
+                  }
+                  if (createdValue == 0)
+                  {
+                     *errorCode = APX_INIT_VALUE_ERROR;
+                     dtl_dec_ref(av_retval);
+                     av_retval = (dtl_av_t*) 0;
+                     break;
+                  }
+                  dtl_av_push(av_retval, (dtl_dv_t*) createdValue, false);
+               }
+            }
+            retval = (dtl_dv_t*) av_retval;
+         }
+      }
+      else
+      {
+         *errorCode = APX_INIT_VALUE_ERROR;
+      }
+   }
+   return retval;
+}
+
+static dtl_sv_t *apx_dataElement_convertNumericScalar(apx_baseType_t baseType, const dtl_sv_t *sv)
+{
+   bool isOk = false;
+   dtl_sv_t *retval = (dtl_sv_t*) 0;
+   switch(baseType)
+   {
+   case APX_BASE_TYPE_UINT64:
+      {
+         uint64_t u64Value = dtl_sv_to_u64(sv, &isOk);
+         if (isOk)
+         {
+            retval = dtl_sv_make_u64(u64Value);
+         }
+      }
+      break;
+   case APX_BASE_TYPE_SINT64:
+      {
+         int64_t s64Value = dtl_sv_to_i64(sv, &isOk);
+         if (isOk)
+         {
+            retval = dtl_sv_make_i64(s64Value);
+         }
+      }
+      break;
+   case APX_BASE_TYPE_FLOAT32:
+      {
+         float fltValue = dtl_sv_to_flt(sv, &isOk);
+         if (isOk)
+         {
+            retval = dtl_sv_make_flt(fltValue);
+         }
+      }
+      break;
+   case APX_BASE_TYPE_FLOAT64:
+      {
+         double dblValue = dtl_sv_to_dbl(sv, &isOk);
+         if (isOk)
+         {
+            retval = dtl_sv_make_dbl(dblValue);
+         }
+      }
+      break;
+   default:
+      break;
+   }
+   return retval;
+}
+
 static dtl_dv_t *apx_dataElement_makeStringInitValueFromDynamicValue(apx_dataElement_t *self, dtl_dv_t *dv, apx_error_t *errorCode)
 {
    dtl_dv_t *retval = (dtl_dv_t*) 0;
@@ -230,7 +230,8 @@ const char *apx_dataSignature_getDerivedString(apx_dataSignature_t *self)
       apx_dataElement_t *dataElement = self->dataElement;
       if (dataElement->baseType != APX_BASE_TYPE_NONE)
       {
-         if (dataElement->baseType < APX_BASE_TYPE_RECORD)
+         if ( (dataElement->baseType < APX_BASE_TYPE_RECORD) || (dataElement->baseType == APX_BASE_TYPE_FLOAT32) ||
+              (dataElement->baseType == APX_BASE_TYPE_FLOAT64) )
          {
             return self->raw;
          }
@@ -461,6 +462,9 @@ static const uint8_t *parseType(apx_dataSignature_t *self, const uint8_t *pBegin
    case 'L':
       pDataElement->baseType=APX_BASE_TYPE_UINT32;
       break;
+   case 'U':
+      pDataElement->baseType=APX_BASE_TYPE_UINT64;
+      break;
    case 'T':
       pDataElement->baseType=APX_BASE_TYPE_REF_ID; //assume type ID reference until we have parsed further into the string
       break;
@@ -476,6 +480,15 @@ static const uint8_t *parseType(apx_dataSignature_t *self, const uint8_t *pBegin
    case 'l':
       pDataElement->baseType=APX_BASE_TYPE_SINT32;
       break;
+   case 'u':
+      pDataElement->baseType=APX_BASE_TYPE_SINT64;
+      break;
+   case 'f':
+      pDataElement->baseType=APX_BASE_TYPE_FLOAT32;
+      break;
+   case 'd':
+      pDataElement->baseType=APX_BASE_TYPE_FLOAT64;
+      break;
    case '{':
       apx_dataElement_initRecordType(pDataElement);
       //TODO: implement child record parsing here
@@ -591,12 +604,20 @@ static const uint8_t *parseLimit(apx_dataSignature_t *self, const uint8_t *pBegi
                      pDataElement->lowerLimit.u32 = (uint32_t) min; //TODO: implement support for unsigned parsing of min/max
                      pDataElement->upperLimit.u32 = (uint32_t) max;
                      break;
+                  case APX_BASE_TYPE_UINT64:
+                     pDataElement->lowerLimit.u64 = (uint64_t) min;
+                     pDataElement->upperLimit.u64 = (uint64_t) max;
+                     break;
                   case APX_BASE_TYPE_SINT8:
                   case APX_BASE_TYPE_SINT16:
                   case APX_BASE_TYPE_SINT32:
                      pDataElement->lowerLimit.s32 = min;
                      pDataElement->upperLimit.s32 = max;
                      break;
+                  case APX_BASE_TYPE_SINT64:
+                     pDataElement->lowerLimit.s64 = min;
+                     pDataElement->upperLimit.s64 = max;
+                     break;
                   case APX_BASE_TYPE_STRING:
                      break;
                   default:
@@ -0,0 +1,386 @@
+/*****************************************************************************
+* \file      apx_definitionCache.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Cache of built node definitions, keyed by definition digest
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#include "apx_definitionCache.h"
+#include "apx_nodeImage.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#if ( (APX_DEFINITION_CACHE_NUM_BUCKETS & (APX_DEFINITION_CACHE_NUM_BUCKETS - 1)) != 0 )
+# error "APX_DEFINITION_CACHE_NUM_BUCKETS must be a power of two"
+#endif
+#define BUCKET_MASK ((uint32_t) (APX_DEFINITION_CACHE_NUM_BUCKETS - 1))
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static uint32_t apx_definitionCache_bucketIndex(const uint8_t *digest);
+static apx_definitionCacheEntry_t *apx_definitionCache_lookup(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen);
+static apx_error_t apx_definitionCache_insertInternal(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen, apx_nodeInfo_t *nodeInfo);
+static apx_nodeInfo_t *apx_definitionCache_loadImage(apx_definitionCache_t *self, char *imagePath, const uint8_t *digest, uint32_t definitionLen);
+static void apx_definitionCache_unlinkAge(apx_definitionCache_t *self, apx_definitionCacheEntry_t *entry);
+static void apx_definitionCache_linkNewest(apx_definitionCache_t *self, apx_definitionCacheEntry_t *entry);
+static void apx_definitionCache_evictOldest(apx_definitionCache_t *self);
+static void apx_definitionCache_clearInternal(apx_definitionCache_t *self);
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_definitionCache_create(apx_definitionCache_t *self, uint32_t maxEntries)
+{
+   if (self != 0)
+   {
+      memset(&self->buckets[0], 0, sizeof(self->buckets));
+      self->oldest = (apx_definitionCacheEntry_t*) 0;
+      self->newest = (apx_definitionCacheEntry_t*) 0;
+      self->maxEntries = maxEntries;
+      memset(&self->stats, 0, sizeof(self->stats));
+      self->imageDirectory = (char*) 0;
+      self->imageMode = APX_CLIENT_MODE;
+      MUTEX_INIT(self->lock);
+   }
+}
+
+void apx_definitionCache_destroy(apx_definitionCache_t *self)
+{
+   if (self != 0)
+   {
+      MUTEX_LOCK(self->lock);
+      apx_definitionCache_clearInternal(self);
+      MUTEX_UNLOCK(self->lock);
+      MUTEX_DESTROY(self->lock);
+      if (self->imageDirectory != 0)
+      {
+         free(self->imageDirectory);
+      }
+   }
+}
+
+apx_definitionCache_t *apx_definitionCache_new(uint32_t maxEntries)
+{
+   apx_definitionCache_t *self = (apx_definitionCache_t*) malloc(sizeof(apx_definitionCache_t));
+   if (self != 0)
+   {
+      apx_definitionCache_create(self, maxEntries);
+   }
+   return self;
+}
+
+void apx_definitionCache_delete(apx_definitionCache_t *self)
+{
+   if (self != 0)
+   {
+      apx_definitionCache_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Sets the directory where compiled node images are loaded from and saved to. NULL turns it off.
+ * mode is the mode of nodeInfos loaded from the directory, it must match the users of the cache.
+ */
+apx_error_t apx_definitionCache_setImageDirectory(apx_definitionCache_t *self, const char *directory, apx_mode_t mode)
+{
+   if ( (self != 0) && ( (mode == APX_CLIENT_MODE) || (mode == APX_SERVER_MODE) ) )
+   {
+      char *copy = (char*) 0;
+      if (directory != 0)
+      {
+         copy = STRDUP(directory);
+         if (copy == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      MUTEX_LOCK(self->lock);
+      if (self->imageDirectory != 0)
+      {
+         free(self->imageDirectory);
+      }
+      self->imageDirectory = copy;
+      self->imageMode = mode;
+      MUTEX_UNLOCK(self->lock);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Returns a new reference to the cached nodeInfo (the caller must call apx_nodeInfo_release) or NULL on cache miss.
+ * definitionLen is compared as well as a cheap guard against a mismatching digest.
+ */
+apx_nodeInfo_t *apx_definitionCache_find(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen)
+{
+   apx_nodeInfo_t *retval = (apx_nodeInfo_t*) 0;
+   if ( (self != 0) && (digest != 0) )
+   {
+      apx_definitionCacheEntry_t *entry;
+      char *imagePath = (char*) 0;
+      MUTEX_LOCK(self->lock);
+      entry = apx_definitionCache_lookup(self, digest, definitionLen);
+      if (entry != 0)
+      {
+         self->stats.numHits++;
+         if (entry != self->newest)
+         {
+            apx_definitionCache_unlinkAge(self, entry);
+            apx_definitionCache_linkNewest(self, entry);
+         }
+         retval = apx_nodeInfo_ref(entry->nodeInfo);
+      }
+      else
+      {
+         self->stats.numMisses++;
+         if ( (self->imageDirectory != 0) && (self->maxEntries > 0u) )
+         {
+            imagePath = apx_nodeImage_makeFilePath(self->imageDirectory, digest);
+         }
+      }
+      MUTEX_UNLOCK(self->lock);
+      if (imagePath != 0)
+      {
+         retval = apx_definitionCache_loadImage(self, imagePath, digest, definitionLen);
+      }
+   }
+   return retval;
+}
+
+/**
+ * Adds a reference to nodeInfo under the given digest. Inserting a digest that is already cached does nothing.
+ * nodeInfo must not be modified after it has been inserted.
+ */
+apx_error_t apx_definitionCache_insert(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen, apx_nodeInfo_t *nodeInfo)
+{
+   if ( (self != 0) && (digest != 0) && (nodeInfo != 0) )
+   {
+      apx_error_t retval = APX_NO_ERROR;
+      char *imagePath = (char*) 0;
+      if (self->maxEntries == 0u)
+      {
+         return APX_NO_ERROR;
+      }
+      MUTEX_LOCK(self->lock);
+      if (apx_definitionCache_lookup(self, digest, definitionLen) == 0)
+      {
+         retval = apx_definitionCache_insertInternal(self, digest, definitionLen, nodeInfo);
+         if ( (retval == APX_NO_ERROR) && (self->imageDirectory != 0) )
+         {
+            imagePath = apx_nodeImage_makeFilePath(self->imageDirectory, digest);
+         }
+      }
+      MUTEX_UNLOCK(self->lock);
+      if (imagePath != 0)
+      {
+         //The cache works without the image, a failed save only means the next process start has to compile the definition again
+         if (apx_nodeImage_saveFile(imagePath, nodeInfo, digest, definitionLen) == APX_NO_ERROR)
+         {
+            MUTEX_LOCK(self->lock);
+            self->stats.numImageSaves++;
+            MUTEX_UNLOCK(self->lock);
+         }
+         free(imagePath);
+      }
+      return retval;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_definitionCache_clear(apx_definitionCache_t *self)
+{
+   if (self != 0)
+   {
+      MUTEX_LOCK(self->lock);
+      apx_definitionCache_clearInternal(self);
+      MUTEX_UNLOCK(self->lock);
+   }
+}
+
+void apx_definitionCache_getStats(apx_definitionCache_t *self, apx_definitionCacheStats_t *stats)
+{
+   if ( (self != 0) && (stats != 0) )
+   {
+      MUTEX_LOCK(self->lock);
+      *stats = self->stats;
+      MUTEX_UNLOCK(self->lock);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The digest is a cryptographic hash, its leading bytes are already uniformly distributed.
+ */
+static uint32_t apx_definitionCache_bucketIndex(const uint8_t *digest)
+{
+   uint32_t hash = ( ((uint32_t) digest[0]) << 24) | ( ((uint32_t) digest[1]) << 16) | ( ((uint32_t) digest[2]) << 8) | ((uint32_t) digest[3]);
+   return hash & BUCKET_MASK;
+}
+
+static apx_definitionCacheEntry_t *apx_definitionCache_lookup(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen)
+{
+   apx_definitionCacheEntry_t *entry = self->buckets[apx_definitionCache_bucketIndex(digest)];
+   while (entry != 0)
+   {
+      if ( (entry->definitionLen == definitionLen) && (memcmp(&entry->digest[0], digest, APX_CHECKSUMLEN_SHA256) == 0) )
+      {
+         return entry;
+      }
+      entry = entry->next;
+   }
+   return (apx_definitionCacheEntry_t*) 0;
+}
+
+static apx_error_t apx_definitionCache_insertInternal(apx_definitionCache_t *self, const uint8_t *digest, uint32_t definitionLen, apx_nodeInfo_t *nodeInfo)
+{
+   apx_definitionCacheEntry_t *entry = (apx_definitionCacheEntry_t*) malloc(sizeof(apx_definitionCacheEntry_t));
+   if (entry != 0)
+   {
+      uint32_t bucketIndex = apx_definitionCache_bucketIndex(digest);
+      if (self->stats.numEntries >= self->maxEntries)
+      {
+         apx_definitionCache_evictOldest(self);
+      }
+      memcpy(&entry->digest[0], digest, APX_CHECKSUMLEN_SHA256);
+      entry->definitionLen = definitionLen;
+      entry->nodeInfo = apx_nodeInfo_ref(nodeInfo);
+      entry->next = self->buckets[bucketIndex];
+      self->buckets[bucketIndex] = entry;
+      apx_definitionCache_linkNewest(self, entry);
+      self->stats.numEntries++;
+      return APX_NO_ERROR;
+   }
+   return APX_MEM_ERROR;
+}
+
+/**
+ * Runs without holding the lock since it reads from disk. Takes ownership of imagePath.
+ * If another thread inserted the same digest in the meantime, that entry wins.
+ */
+static apx_nodeInfo_t *apx_definitionCache_loadImage(apx_definitionCache_t *self, char *imagePath, const uint8_t *digest, uint32_t definitionLen)
+{
+   apx_nodeInfo_t *nodeInfo = apx_nodeImage_loadFile(imagePath, digest, definitionLen, self->imageMode, (apx_error_t*) 0);
+   free(imagePath);
+   if (nodeInfo != 0)
+   {
+      apx_definitionCacheEntry_t *entry;
+      MUTEX_LOCK(self->lock);
+      self->stats.numImageLoads++;
+      entry = apx_definitionCache_lookup(self, digest, definitionLen);
+      if (entry != 0)
+      {
+         apx_nodeInfo_release(nodeInfo);
+         nodeInfo = apx_nodeInfo_ref(entry->nodeInfo);
+      }
+      else
+      {
+         (void) apx_definitionCache_insertInternal(self, digest, definitionLen, nodeInfo);
+      }
+      MUTEX_UNLOCK(self->lock);
+   }
+   return nodeInfo;
+}
+
+static void apx_definitionCache_unlinkAge(apx_definitionCache_t *self, apx_definitionCacheEntry_t *entry)
+{
+   if (entry->older != 0)
+   {
+      entry->older->newer = entry->newer;
+   }
+   else
+   {
+      self->oldest = entry->newer;
+   }
+   if (entry->newer != 0)
+   {
+      entry->newer->older = entry->older;
+   }
+   else
+   {
+      self->newest = entry->older;
+   }
+}
+
+static void apx_definitionCache_linkNewest(apx_definitionCache_t *self, apx_definitionCacheEntry_t *entry)
+{
+   entry->newer = (apx_definitionCacheEntry_t*) 0;
+   entry->older = self->newest;
+   if (self->newest != 0)
+   {
+      self->newest->newer = entry;
+   }
+   else
+   {
+      self->oldest = entry;
+   }
+   self->newest = entry;
+}
+
+static void apx_definitionCache_evictOldest(apx_definitionCache_t *self)
+{
+   apx_definitionCacheEntry_t *victim = self->oldest;
+   if (victim != 0)
+   {
+      apx_definitionCacheEntry_t **pp = &self->buckets[apx_definitionCache_bucketIndex(&victim->digest[0])];
+      while (*pp != victim)
+      {
+         assert(*pp != 0);
+         pp = &(*pp)->next;
+      }
+      *pp = victim->next;
+      apx_definitionCache_unlinkAge(self, victim);
+      apx_nodeInfo_release(victim->nodeInfo);
+      free(victim);
+      self->stats.numEntries--;
+      self->stats.numEvictions++;
+   }
+}
+
+static void apx_definitionCache_clearInternal(apx_definitionCache_t *self)
+{
+   apx_definitionCacheEntry_t *entry = self->oldest;
+   while (entry != 0)
+   {
+      apx_definitionCacheEntry_t *newer = entry->newer;
+      apx_nodeInfo_release(entry->nodeInfo);
+      free(entry);
+      entry = newer;
+   }
+   memset(&self->buckets[0], 0, sizeof(self->buckets));
+   self->oldest = (apx_definitionCacheEntry_t*) 0;
+   self->newest = (apx_definitionCacheEntry_t*) 0;
+   self->stats.numEntries = 0u;
+}
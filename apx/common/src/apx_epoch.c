@@ -0,0 +1,274 @@
+/*****************************************************************************
+* \file      apx_epoch.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Epoch based reclamation of data structures published to lock-free readers
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <assert.h>
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <sched.h>
+#endif
+#include "apx_epoch.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _MSC_VER
+# define ATOMIC_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+# define ATOMIC_STORE(p, v) ((void) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+# define ATOMIC_INCREMENT(p) ((void) InterlockedIncrement((volatile LONG*) (p)))
+# define ATOMIC_DECREMENT(p) ((void) InterlockedDecrement((volatile LONG*) (p)))
+# define THREAD_YIELD() SwitchToThread()
+#else
+# define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+# define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+# define ATOMIC_INCREMENT(p) ((void) __atomic_fetch_add((p), 1u, __ATOMIC_SEQ_CST))
+# define ATOMIC_DECREMENT(p) ((void) __atomic_fetch_sub((p), 1u, __ATOMIC_RELEASE))
+# define THREAD_YIELD() sched_yield()
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static bool apx_epoch_tryAdvance(apx_epoch_t *self);
+static void apx_epoch_waitGracePeriod(apx_epoch_t *self);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_epoch_create(apx_epoch_t *self)
+{
+   if (self != 0)
+   {
+      self->globalEpoch = 0u;
+      self->numReaders[0] = 0u;
+      self->numReaders[1] = 0u;
+      self->retired = (apx_epochRetired_t*) 0;
+      self->numRetired = 0u;
+   }
+}
+
+/**
+ * Reclaims all retired objects. There must be no active readers when calling this function.
+ */
+void apx_epoch_destroy(apx_epoch_t *self)
+{
+   if (self != 0)
+   {
+      apx_epochRetired_t *node = self->retired;
+      while (node != 0)
+      {
+         apx_epochRetired_t *next = node->next;
+         node->reclaim(node->arg);
+         free(node);
+         node = next;
+      }
+      self->retired = (apx_epochRetired_t*) 0;
+      self->numRetired = 0u;
+   }
+}
+
+apx_epoch_t *apx_epoch_new(void)
+{
+   apx_epoch_t *self = (apx_epoch_t*) malloc(sizeof(apx_epoch_t));
+   if (self != 0)
+   {
+      apx_epoch_create(self);
+   }
+   return self;
+}
+
+void apx_epoch_delete(apx_epoch_t *self)
+{
+   if (self != 0)
+   {
+      apx_epoch_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Marks the calling thread as reader. Returns the epoch that must be passed to apx_epoch_exit.
+ */
+uint32_t apx_epoch_enter(apx_epoch_t *self)
+{
+   uint32_t epoch = 0u;
+   if (self != 0)
+   {
+      for (;;)
+      {
+         epoch = ATOMIC_LOAD(&self->globalEpoch);
+         ATOMIC_INCREMENT(&self->numReaders[epoch & 1u]);
+         if (ATOMIC_LOAD(&self->globalEpoch) == epoch)
+         {
+            break;
+         }
+         //The writer advanced the epoch between the load and the increment, retry in the new epoch
+         ATOMIC_DECREMENT(&self->numReaders[epoch & 1u]);
+      }
+   }
+   return epoch;
+}
+
+void apx_epoch_exit(apx_epoch_t *self, uint32_t epoch)
+{
+   if (self != 0)
+   {
+      ATOMIC_DECREMENT(&self->numReaders[epoch & 1u]);
+   }
+}
+
+/**
+ * Schedules reclaim(arg) to be called once no reader can reference arg anymore.
+ * The caller must already have removed all published pointers to arg.
+ */
+apx_error_t apx_epoch_retire(apx_epoch_t *self, void *arg, apx_epochReclaimFunc *reclaim)
+{
+   if ( (self != 0) && (reclaim != 0) )
+   {
+      apx_epochRetired_t *node = (apx_epochRetired_t*) malloc(sizeof(apx_epochRetired_t));
+      if (node == 0)
+      {
+         //Out of memory, wait for the readers instead of deferring the reclamation
+         apx_epoch_waitGracePeriod(self);
+         reclaim(arg);
+         return APX_NO_ERROR;
+      }
+      node->arg = arg;
+      node->reclaim = reclaim;
+      node->epoch = ATOMIC_LOAD(&self->globalEpoch);
+      node->next = self->retired;
+      self->retired = node;
+      self->numRetired++;
+      (void) apx_epoch_reclaim(self);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Advances the epoch if possible and reclaims retired objects no reader can reference. Never blocks.
+ * Returns the number of objects still waiting for reclamation.
+ */
+uint32_t apx_epoch_reclaim(apx_epoch_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t epoch;
+      apx_epochRetired_t **pNode;
+      if (self->retired == 0)
+      {
+         return 0u;
+      }
+      (void) apx_epoch_tryAdvance(self);
+      epoch = ATOMIC_LOAD(&self->globalEpoch);
+      pNode = &self->retired;
+      while (*pNode != 0)
+      {
+         apx_epochRetired_t *node = *pNode;
+         if ( (epoch - node->epoch) >= 2u)
+         {
+            *pNode = node->next;
+            node->reclaim(node->arg);
+            free(node);
+            self->numRetired--;
+         }
+         else
+         {
+            pNode = &node->next;
+         }
+      }
+      return self->numRetired;
+   }
+   return 0u;
+}
+
+/**
+ * Waits until all retired objects have been reclaimed.
+ * Must not be called from inside an apx_epoch_enter/apx_epoch_exit section on the same object.
+ */
+void apx_epoch_synchronize(apx_epoch_t *self)
+{
+   if (self != 0)
+   {
+      while (apx_epoch_reclaim(self) > 0u)
+      {
+         THREAD_YIELD();
+      }
+   }
+}
+
+uint32_t apx_epoch_getNumRetired(const apx_epoch_t *self)
+{
+   if (self != 0)
+   {
+      return self->numRetired;
+   }
+   return 0u;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The epoch can move from N to N+1 when all readers that entered during epoch N-1 have exited.
+ * New readers only enter the current epoch, an object retired in epoch N is therefore safe to reclaim in epoch N+2.
+ */
+static bool apx_epoch_tryAdvance(apx_epoch_t *self)
+{
+   uint32_t epoch = ATOMIC_LOAD(&self->globalEpoch);
+   if (ATOMIC_LOAD(&self->numReaders[(epoch + 1u) & 1u]) == 0u)
+   {
+      ATOMIC_STORE(&self->globalEpoch, epoch + 1u);
+      return true;
+   }
+   return false;
+}
+
+static void apx_epoch_waitGracePeriod(apx_epoch_t *self)
+{
+   uint32_t startEpoch = ATOMIC_LOAD(&self->globalEpoch);
+   while ( (ATOMIC_LOAD(&self->globalEpoch) - startEpoch) < 2u)
+   {
+      if (!apx_epoch_tryAdvance(self))
+      {
+         THREAD_YIELD();
+      }
+   }
+}
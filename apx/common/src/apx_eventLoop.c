@@ -53,15 +53,7 @@ apx_error_t apx_eventLoop_create(apx_eventLoop_t *self)
 {
    if (self != 0)
    {
-      adt_buf_err_t result = adt_rbfh_create(&self->pendingEvents, (uint8_t) APX_EVENT_SIZE);
-      if (result != BUF_E_OK)
-      {
-         return APX_MEM_ERROR;
-      }
-      self->exitFlag = false;
-      SPINLOCK_INIT(self->lock);
-      SEMAPHORE_CREATE(self->semaphore);
-      return APX_NO_ERROR;
+      return apx_mpscRing_create(&self->pendingEvents, (uint32_t) APX_EVENT_SIZE, APX_MAX_NUM_EVENTS);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
@@ -70,8 +62,7 @@ void apx_eventLoop_destroy(apx_eventLoop_t *self)
 {
    if (self != 0)
    {
-      SPINLOCK_DESTROY(self->lock);
-      adt_rbfh_destroy(&self->pendingEvents);
+      apx_mpscRing_destroy(&self->pendingEvents);
    }
 }
 
@@ -101,53 +92,33 @@ void apx_eventLoop_delete(apx_eventLoop_t *self)
 
 void apx_eventLoop_append(apx_eventLoop_t *self, apx_event_t *event)
 {
-   SPINLOCK_ENTER(self->lock);
-   adt_rbfh_insert(&self->pendingEvents, (const uint8_t*) event);
-   SPINLOCK_LEAVE(self->lock);
-#ifndef UNIT_TEST
-   SEMAPHORE_POST(self->semaphore);
-#endif
+   apx_mpscRing_push(&self->pendingEvents, event);
 }
 
 void apx_eventLoop_exit(apx_eventLoop_t *self)
 {
    if (self != 0)
    {
-      SPINLOCK_ENTER(self->lock);
-      self->exitFlag = true;
-      SPINLOCK_LEAVE(self->lock);
-      SEMAPHORE_POST(self->semaphore);
+      apx_mpscRing_interrupt(&self->pendingEvents);
    }
 }
 
 /**
- * Executes events in an infinite loop. This function will only return when self->exitFlag is set to true
+ * Executes events in an infinite loop. This function will only return after apx_eventLoop_exit has been called.
+ * Events still pending at that time are not processed.
  */
 void apx_eventLoop_run(apx_eventLoop_t *self, apx_eventHandlerFunc_t *eventHandler, void *eventHandlerArg)
 {
-   bool exitFlag = false;
-   while(exitFlag == false)
+   while(apx_mpscRing_isInterrupted(&self->pendingEvents) == false)
    {
       apx_event_t event;
-#ifdef _MSC_VER
-      DWORD result = WaitForSingleObject(self->semaphore, INFINITE);
-      if (result == WAIT_OBJECT_0)
-#else
-      int result = sem_wait(&self->semaphore);
-      if (result == 0)
-#endif
+      if (apx_mpscRing_pop(&self->pendingEvents, &event))
+      {
+         apx_eventLoop_processEvent(self, &event, eventHandler, eventHandlerArg);
+      }
+      else
       {
-         SPINLOCK_ENTER(self->lock);
-         exitFlag = self->exitFlag;
-         if (exitFlag == false)
-         {
-            adt_rbfh_remove(&self->pendingEvents,(uint8_t*) &event);
-         }
-         SPINLOCK_LEAVE(self->lock);
-         if (exitFlag == false)
-         {
-            apx_eventLoop_processEvent(self, &event, eventHandler, eventHandlerArg);
-         }
+         apx_mpscRing_wait(&self->pendingEvents, APX_MPSC_RING_WAIT_FOREVER);
       }
    }
 }
@@ -156,11 +127,19 @@ uint16_t apx_eventLoop_numPendingEvents(apx_eventLoop_t *self)
 {
    if (self != 0)
    {
-      return adt_rbfh_length(&self->pendingEvents);
+      return (uint16_t) apx_mpscRing_length(&self->pendingEvents);
    }
    return 0;
 }
 
+void apx_eventLoop_getStats(apx_eventLoop_t *self, apx_mpscRingStats_t *stats)
+{
+   if (self != 0)
+   {
+      apx_mpscRing_getStats(&self->pendingEvents, stats);
+   }
+}
+
 
 
 #ifdef UNIT_TEST
@@ -172,8 +151,7 @@ void apx_eventLoop_runAll(apx_eventLoop_t *self, apx_eventHandlerFunc_t *eventHa
    while(true)
    {
       apx_event_t event;
-      uint8_t rc = adt_rbfh_remove(&self->pendingEvents,(uint8_t*) &event);
-      if (rc == BUF_E_OK)
+      if (apx_mpscRing_pop(&self->pendingEvents, &event))
       {
          apx_eventLoop_processEvent(self, &event, eventHandler, eventHandlerArg);
       }
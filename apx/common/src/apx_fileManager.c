@@ -49,6 +49,7 @@ static apx_error_t apx_fileManager_processDataMsg(apx_fileManager_t *self, uint3
 static apx_error_t apx_fileManager_processFileInfoMsg(apx_fileManager_t *self, const uint8_t *msgBuf, int32_t msgLen);
 static apx_error_t apx_fileManager_processFileOpenMsg(apx_fileManager_t *self, const uint8_t *msgBuf, int32_t msgLen);
 static void apx_fileManager_freeAllocatedMemory(void *arg, uint8_t *ptr, uint32_t size);
+static void apx_fileManager_overloadNotify(void *arg);
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
 //////////////////////////////////////////////////////////////////////////////
@@ -71,6 +72,7 @@ apx_error_t apx_fileManager_create(apx_fileManager_t *self, uint8_t mode, struct
          {
             self->shared.arg = (void*) self;
             self->shared.freeAllocatedMemory = apx_fileManager_freeAllocatedMemory;
+            self->shared.overloadNotify = apx_fileManager_overloadNotify;
             result = apx_fileManagerWorker_create(&self->worker, &self->shared, mode);
             if (result != APX_NO_ERROR)
             {
@@ -362,6 +364,23 @@ apx_error_t apx_fileManager_writeDynamicData(apx_fileManager_t *self, uint32_t a
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Same as apx_fileManager_writeDynamicData but data is serialized directly into the transmit path (the caller keeps ownership of data).
+ * Returns APX_NOT_IMPLEMENTED_ERROR when the transmit handler doesn't support it.
+ */
+apx_error_t apx_fileManager_writeDynamicDataDirect(apx_fileManager_t *self, uint32_t address, apx_size_t len, const uint8_t *data)
+{
+   if ( (self != 0) && (data != 0) && (len <= APX_MAX_FILE_SIZE) )
+   {
+      if (address >= RMF_CMD_START_ADDR)
+      {
+         return APX_INVALID_ADDRESS_ERROR;
+      }
+      return apx_fileManagerWorker_sendDynamicDataDirect(&self->worker, address, len, data);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 void apx_fileManager_disconnectNotify(apx_fileManager_t *self)
 {
    if (self != 0)
@@ -506,3 +525,16 @@ static void apx_fileManager_freeAllocatedMemory(void *arg, uint8_t *ptr, uint32_
    }
 }
 
+/**
+ * The remote side stopped consuming messages (APX_BACKPRESSURE_POLICY_DISCONNECT), close the connection.
+ * Called from the thread that made the write, the worker thread may still be blocked in the transmit handler.
+ */
+static void apx_fileManager_overloadNotify(void *arg)
+{
+   apx_fileManager_t *self = (apx_fileManager_t*) arg;
+   if ( (self != 0) && (self->parentConnection != 0) )
+   {
+      apx_connectionBase_close(self->parentConnection);
+   }
+}
+
@@ -58,6 +58,7 @@ apx_error_t apx_fileManagerShared_create(apx_fileManagerShared_t *self)
       self->connectionId = APX_INVALID_CONNECTION_ID;
       self->arg = (void*) 0;
       self->freeAllocatedMemory = (apx_allocatorFreeFunc*) 0;
+      self->overloadNotify = (apx_voidPtrFunc*) 0;
       self->isConnected = false;
       SPINLOCK_INIT(self->lock);
       apx_fileMap_create(&self->localFileMap);
@@ -270,6 +271,14 @@ bool apx_fileManagerShared_isConnected(apx_fileManagerShared_t *self)
    return false;
 }
 
+void apx_fileManagerShared_overloadNotify(apx_fileManagerShared_t *self)
+{
+   if ( (self != 0) && (self->overloadNotify != 0) )
+   {
+      self->overloadNotify(self->arg);
+   }
+}
+
 
 
 //////////////////////////////////////////////////////////////////////////////
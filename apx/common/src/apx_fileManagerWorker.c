@@ -30,12 +30,16 @@
 #include <string.h>
 #ifdef _WIN32
 #include <process.h>
+#else
+#include <time.h>
+#include <unistd.h> //needed for SLEEP macro
 #endif
 #include "apx_types.h"
 //BEGIN TEMPORARY INCLUDES
 #include <stdio.h>
 //END TEMPORARY INCLUDES
 #include "apx_fileManagerWorker.h"
+#include "numheader.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -50,6 +54,27 @@
 #define DYN_STATIC static
 #endif
 
+#define BATCH_BUFFER_GROW_SIZE 4096 //4KB
+#define SCHEDULED_STOP_TIMEOUT 5000 //milliseconds
+
+#ifdef _MSC_VER
+# define ATOMIC_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+# define ATOMIC_STORE(p, v) ((void) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+# define ATOMIC_EXCHANGE(p, v) ((uint32_t) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+#else
+# define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define ATOMIC_EXCHANGE(p, v) __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+
+#ifndef UNIT_TEST
+#ifdef _MSC_VER
+typedef DWORD apx_workerDeadline_t;
+#else
+typedef struct timespec apx_workerDeadline_t;
+#endif
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
@@ -60,14 +85,41 @@ static apx_error_t apx_fileManagerWorker_starThread(apx_fileManagerWorker_t *sel
 
 static void apx_fileManagerWorker_stopThread(apx_fileManagerWorker_t *self);
 static THREAD_PROTO(workerThread,arg);
+static void workerThread_setDeadline(apx_fileManagerWorker_t *self, apx_workerDeadline_t *deadline);
+static bool workerThread_waitForNextMessage(apx_fileManagerWorker_t *self, const apx_workerDeadline_t *deadline, apx_msg_t *msg);
+static uint32_t workerThread_remainingTime(const apx_workerDeadline_t *deadline);
+static void workerThread_waitForSendSlot(apx_fileManagerWorker_t *self);
 #endif
+static uint32_t workerThread_getTickCount(void);
+static bool workerThread_takeSendSlot(apx_fileManagerWorker_t *self, uint32_t *waitTime);
+static bool workerThread_nextScheduledMessage(apx_fileManagerWorker_t *self, apx_msg_t *msg);
+static bool workerThread_isBatchEnabled(apx_fileManagerWorker_t *self);
+static void workerThread_beginBatch(apx_fileManagerWorker_t *self);
+static void workerThread_endBatch(apx_fileManagerWorker_t *self);
+static apx_error_t workerThread_flushBatch(apx_fileManagerWorker_t *self);
+static apx_error_t workerThread_flushDirectSpan(apx_fileManagerWorker_t *self);
+static void workerThread_swapDirectBuffers(apx_fileManagerWorker_t *self);
+static void workerThread_updateFlushStats(apx_fileManagerWorker_t *self, int32_t msgCount, bool isSent);
+static void workerThread_handleTransmitOverload(apx_fileManagerWorker_t *self, int32_t msgCount, bool isDataOnly);
+static uint8_t *workerThread_getSendBuffer(apx_fileManagerWorker_t *self, int32_t msgLen);
+static int32_t workerThread_send(apx_fileManagerWorker_t *self, int32_t msgLen);
+static int32_t apx_fileManagerWorker_encodeNumHeader(apx_fileManagerWorker_t *self, uint8_t *buf, int32_t msgLen);
 static bool workerThread_processMessage(apx_fileManagerWorker_t *self, apx_msg_t *msg);
 static void workerThread_sendFileInfo(apx_fileManagerWorker_t *self, apx_msg_t *msg);
 static void workerThread_sendFileOpen(apx_fileManagerWorker_t *self, apx_msg_t *msg);
 static void workerThread_sendAcknowledge(apx_fileManagerWorker_t *self);
 static apx_error_t workerThread_sendFileConstData(apx_fileManagerWorker_t *self, apx_msg_t *msg);
 static apx_error_t workerThread_sendFileDynData(apx_fileManagerWorker_t *self, apx_msg_t *msg);
-static apx_error_t apx_fileManagerWorker_processRingBufErrorCode(adt_buf_err_t errorCode);
+static apx_error_t workerThread_sendFileDataDirect(apx_fileManagerWorker_t *self, apx_msg_t *msg);
+static apx_error_t workerThread_sendFileCoalescedData(apx_fileManagerWorker_t *self, apx_msg_t *msg);
+static bool apx_fileManagerWorker_applyBackpressure(apx_fileManagerWorker_t *self, bool *useCoalescer);
+static bool workerThread_isDataMessage(const apx_msg_t *msg);
+static bool workerThread_isShedding(apx_fileManagerWorker_t *self);
+static void workerThread_dropDataMessage(apx_fileManagerWorker_t *self, apx_msg_t *msg);
+static void workerThread_skipFileDataDirect(apx_fileManagerWorker_t *self, int32_t frameLen);
+static int32_t apx_fileManagerWorker_serializeDataFrames(apx_fileManagerWorker_t *self, uint8_t *buf, uint32_t address, uint32_t len, const uint8_t *data);
+static apx_error_t apx_fileManagerWorker_pushMessage(apx_fileManagerWorker_t *self, const apx_msg_t *msg);
+static void apx_fileManagerWorker_stopScheduled(apx_fileManagerWorker_t *self);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -80,20 +132,16 @@ apx_error_t apx_fileManagerWorker_create(apx_fileManagerWorker_t *self, apx_file
 {
    if (self != 0)
    {
-      adt_buf_err_t bufResult;
-
-      bufResult = adt_rbfh_create(&self->messages, (uint8_t) RMF_MSG_SIZE);
-
-      if (bufResult != BUF_E_OK)
+      apx_error_t result = apx_mpscRing_create(&self->messages, RMF_MSG_SIZE, APX_MAX_NUM_MESSAGES);
+      if (result != APX_NO_ERROR)
       {
-         return APX_MEM_ERROR;
+         return result;
       }
 
       self->mode = mode;
       self->shared = shared;
       MUTEX_INIT(self->mutex);
       SPINLOCK_INIT(self->lock);
-      SEMAPHORE_CREATE(self->semaphore);
 #ifdef _WIN32
       self->workerThread = INVALID_HANDLE_VALUE;
 #else
@@ -101,6 +149,39 @@ apx_error_t apx_fileManagerWorker_create(apx_fileManagerWorker_t *self, apx_file
 #endif
       self->workerThreadValid=false;
       self->numHeaderSize = 0u;
+      adt_bytearray_create(&self->batchBuffer, BATCH_BUFFER_GROW_SIZE);
+      self->batchLen = 0;
+      self->batchMsgCount = 0;
+      self->batchHeaderLen = 0;
+      self->batchMsgLen = 0;
+      self->isBatching = false;
+      self->maxBatchSize = APX_WORKER_MAX_BATCH_SIZE;
+      self->maxBatchLatency = APX_WORKER_MAX_BATCH_LATENCY;
+      adt_bytearray_create(&self->directBuffer, BATCH_BUFFER_GROW_SIZE);
+      adt_bytearray_create(&self->directSendBuffer, BATCH_BUFFER_GROW_SIZE);
+      self->directLen = 0;
+      self->directSendLen = 0;
+      self->directSendPos = 0;
+      self->directSpanLen = 0;
+      self->directSpanMsgCount = 0;
+      apx_writeCoalescer_create(&self->coalescer);
+      adt_bytearray_create(&self->coalescedSendBuffer, BATCH_BUFFER_GROW_SIZE);
+      self->isCoalescing = (APX_WORKER_COALESCE_ENABLE != 0)? true : false;
+      self->maxUpdateRate = APX_WORKER_COALESCE_MAX_UPDATE_RATE;
+      self->rateTokens = APX_WORKER_COALESCE_BURST;
+      self->rateRefillTime = 0u;
+      self->backpressurePolicy = (apx_backpressurePolicy_t) APX_WORKER_BACKPRESSURE_POLICY;
+      self->queueHighWaterMark = APX_WORKER_QUEUE_HIGH_WATER_MARK;
+      self->isOverloaded = false;
+      memset(&self->stats, 0, sizeof(apx_fileManagerWorkerStats_t));
+      self->scheduleFunc = (apx_fileManagerWorker_scheduleFunc*) 0;
+      self->scheduleArg = (void*) 0;
+      self->isScheduled = 0u;
+      self->isExited = 0u;
+      self->isRunningScheduled = 0u;
+      self->hasDeferredMsg = false;
+      self->schedulerNext = (struct apx_fileManagerWorker_tag*) 0;
+      self->schedulerWakeupTime = 0u;
 
       apx_fileManagerWorker_setTransmitHandler(self, 0);
       return APX_NO_ERROR;
@@ -116,10 +197,18 @@ void apx_fileManagerWorker_destroy(apx_fileManagerWorker_t *self)
       {
          //apx_fileManagerWorker_stop(self);
       }
+      if (self->scheduleFunc != 0)
+      {
+         apx_fileManagerWorker_stopScheduled(self);
+      }
       MUTEX_DESTROY(self->mutex);
       SPINLOCK_DESTROY(self->lock);
-      SEMAPHORE_DESTROY(self->semaphore);
-      adt_rbfh_destroy(&self->messages);
+      apx_mpscRing_destroy(&self->messages);
+      adt_bytearray_destroy(&self->batchBuffer);
+      adt_bytearray_destroy(&self->directBuffer);
+      adt_bytearray_destroy(&self->directSendBuffer);
+      apx_writeCoalescer_destroy(&self->coalescer);
+      adt_bytearray_destroy(&self->coalescedSendBuffer);
    }
 }
 
@@ -127,6 +216,10 @@ apx_error_t apx_fileManagerWorker_start(apx_fileManagerWorker_t *self)
 {
    if (self != 0)
    {
+      if (self->scheduleFunc != 0)
+      {
+         return APX_NO_ERROR;
+      }
 #ifndef UNIT_TEST
       return apx_fileManagerWorker_starThread(self);
 #else
@@ -140,8 +233,15 @@ void apx_fileManagerWorker_stop(apx_fileManagerWorker_t *self)
 {
    if (self != 0)
    {
+      if (self->scheduleFunc != 0)
+      {
+         apx_fileManagerWorker_stopScheduled(self);
+      }
 #ifndef UNIT_TEST
-      apx_fileManagerWorker_stopThread(self);
+      else
+      {
+         apx_fileManagerWorker_stopThread(self);
+      }
 #endif
    }
 }
@@ -189,13 +289,81 @@ uint16_t apx_fileManagerWorker_getNumPendingMessages(apx_fileManagerWorker_t *se
 {
    if (self != 0)
    {
-      uint16_t retval;
+      return (uint16_t) apx_mpscRing_length(&self->messages);
+   }
+   return 0u;
+}
+
+/**
+ * Sets the batching parameters used by the worker thread. maxBatchSize is the number of bytes collected before a flush is forced
+ * (0 disables batching). maxBatchLatency is the maximum number of milliseconds a batch is held open waiting for more messages.
+ * Batching is only used when the transmit handler implements sendBatch.
+ */
+void apx_fileManagerWorker_setBatchConfig(apx_fileManagerWorker_t *self, int32_t maxBatchSize, uint32_t maxBatchLatency)
+{
+   if ( (self != 0) && (maxBatchSize >= 0) )
+   {
+      SPINLOCK_ENTER(self->lock);
+      self->maxBatchSize = maxBatchSize;
+      self->maxBatchLatency = maxBatchLatency;
+      SPINLOCK_LEAVE(self->lock);
+   }
+}
+
+/**
+ * Enables latest-value-wins coalescing of dynamic data writes. A write to an address that is still waiting in the message
+ * queue replaces the bytes of the queued write instead of adding a new message.
+ * maxUpdateRate limits the number of coalesced data messages per second sent by this connection (0 means unlimited).
+ * While the worker thread waits for the rate limit, new writes keep merging into the queued ones, a slow consumer
+ * therefore never has more pending writes than there are distinct addresses.
+ * Set this before data starts flowing, messages queued in the other mode are still sent as queued.
+ */
+void apx_fileManagerWorker_setCoalesceConfig(apx_fileManagerWorker_t *self, bool isEnabled, uint32_t maxUpdateRate)
+{
+   if (self != 0)
+   {
       SPINLOCK_ENTER(self->lock);
-      retval = adt_rbfh_length(&self->messages);
+      self->isCoalescing = isEnabled;
+      self->maxUpdateRate = maxUpdateRate;
+      SPINLOCK_LEAVE(self->lock);
+   }
+}
+
+/**
+ * Selects what happens to dynamic data writes once queueHighWaterMark messages are waiting to be sent.
+ * DROP_OLDEST: the worker thread discards queued data messages until the queue is back below the high-water mark.
+ *              While the worker thread is blocked in the transmit handler, new writes are discarded at twice the high-water mark.
+ * COALESCE: writes go through the write coalescer until everything that was merged has been sent.
+ * DISCONNECT: the first write that finds the queue at the high-water mark marks the connection as disconnected and asks
+ *             the owner to close it, later writes are discarded.
+ * Writes discarded by a policy are reported as successful to the caller, a slow consumer never makes a producer fail.
+ */
+void apx_fileManagerWorker_setBackpressureConfig(apx_fileManagerWorker_t *self, apx_backpressurePolicy_t policy, uint32_t queueHighWaterMark)
+{
+   if (self != 0)
+   {
+      SPINLOCK_ENTER(self->lock);
+      self->backpressurePolicy = policy;
+      self->queueHighWaterMark = queueHighWaterMark;
       SPINLOCK_LEAVE(self->lock);
-      return retval;
    }
-   return 0u;
+}
+
+void apx_fileManagerWorker_getStats(apx_fileManagerWorker_t *self, apx_fileManagerWorkerStats_t *stats)
+{
+   if ( (self != 0) && (stats != 0) )
+   {
+      apx_mpscRingStats_t queueStats;
+      SPINLOCK_ENTER(self->lock);
+      memcpy(stats, &self->stats, sizeof(apx_fileManagerWorkerStats_t));
+      stats->queueHighWaterMark = (self->backpressurePolicy != APX_BACKPRESSURE_POLICY_NONE)? self->queueHighWaterMark : 0u;
+      SPINLOCK_LEAVE(self->lock);
+      apx_mpscRing_getStats(&self->messages, &queueStats);
+      stats->queueDepth = queueStats.depth;
+      stats->maxQueueDepth = queueStats.maxDepth;
+      stats->numWakeups = queueStats.numWakeups;
+      stats->numParks = queueStats.numParks;
+   }
 }
 
 //Message API
@@ -209,12 +377,7 @@ void apx_fileManagerWorker_sendFileInfoMsg(apx_fileManagerWorker_t *self, apx_fi
    {
       apx_msg_t msg = {APX_MSG_SEND_FILEINFO, 0, 0, {0}, 0};
       msg.msgData3.ptr = (void*) fileInfo;
-      SPINLOCK_ENTER(self->lock);
-      adt_rbfh_insert(&self->messages, (const uint8_t*) &msg);
-      SPINLOCK_LEAVE(self->lock);
-   #ifndef UNIT_TEST
-      SEMAPHORE_POST(self->semaphore);
-   #endif
+      apx_fileManagerWorker_pushMessage(self, &msg);
    }
 }
 
@@ -224,12 +387,7 @@ void apx_fileManagerWorker_sendFileOpenMsg(apx_fileManagerWorker_t *self, uint32
    {
       apx_msg_t msg = {APX_MSG_SEND_FILE_OPEN, 0, 0, {0}, 0};
       msg.msgData1 = address;
-      SPINLOCK_ENTER(self->lock);
-      adt_rbfh_insert(&self->messages, (const uint8_t*) &msg);
-      SPINLOCK_LEAVE(self->lock);
-   #ifndef UNIT_TEST
-      SEMAPHORE_POST(self->semaphore);
-   #endif
+      apx_fileManagerWorker_pushMessage(self, &msg);
    }
 }
 
@@ -242,13 +400,7 @@ apx_error_t apx_fileManagerWorker_sendConstData(apx_fileManagerWorker_t *self, u
       msg.msgData2 = len;
       msg.msgData3.ptr = readFunc;
       msg.msgData4 = arg;
-      SPINLOCK_ENTER(self->lock);
-      adt_rbfh_insert(&self->messages, (const uint8_t*) &msg);
-      SPINLOCK_LEAVE(self->lock);
-   #ifndef UNIT_TEST
-      SEMAPHORE_POST(self->semaphore);
-   #endif
-      return APX_NO_ERROR;
+      return apx_fileManagerWorker_pushMessage(self, &msg);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
@@ -257,25 +409,129 @@ apx_error_t apx_fileManagerWorker_sendDynamicData(apx_fileManagerWorker_t *self,
 {
    if ( (self != 0) && (data != 0) )
    {
-      adt_buf_err_t result;
       apx_msg_t msg = {APX_MSG_SEND_FILE_DYN_DATA, 0, 0, {0}, 0};
+      bool useCoalescer;
+      if (apx_fileManagerWorker_applyBackpressure(self, &useCoalescer))
+      {
+         apx_fileManagerShared_freeAllocatedMemory(self->shared, data, len);
+         return APX_NO_ERROR;
+      }
+      if (useCoalescer)
+      {
+         apx_error_t rc = apx_fileManagerWorker_sendDynamicDataCoalesced(self, address, len, data);
+         if (rc == APX_NO_ERROR)
+         {
+            apx_fileManagerShared_freeAllocatedMemory(self->shared, data, len);
+         }
+         return rc;
+      }
       msg.msgData1 = address;
       msg.msgData2 = len;
       msg.msgData3.ptr = data;
+      //The copy the caller made when it allocated data is added to stats by the worker thread
+      return apx_fileManagerWorker_pushMessage(self, &msg);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Serializes numheader, RMF header and data straight into directBuffer, which the worker thread later passes as-is to
+ * transmitHandler.sendBatch. Unlike apx_fileManagerWorker_sendDynamicData, data is copied exactly once and the caller keeps ownership of it.
+ * Writes larger than APX_WORKER_MAX_FRAGMENT_SIZE are split into several RMF messages using the more bit. All fragments
+ * belong to the same queued message so nothing else can be sent in between them.
+ * Returns APX_NOT_IMPLEMENTED_ERROR when the transmit handler has no sendBatch function, use apx_fileManagerWorker_sendDynamicData in that case.
+ */
+apx_error_t apx_fileManagerWorker_sendDynamicDataDirect(apx_fileManagerWorker_t *self, uint32_t address, uint32_t len, const uint8_t *data)
+{
+   if ( (self != 0) && (data != 0) )
+   {
+      apx_error_t retval = APX_NO_ERROR;
+      uint32_t numFragments = (len > APX_WORKER_MAX_FRAGMENT_SIZE)? (len + APX_WORKER_MAX_FRAGMENT_SIZE - 1u) / APX_WORKER_MAX_FRAGMENT_SIZE : 1u;
+      int32_t maxFramesLen = (int32_t) (numFragments * (sizeof(uint32_t) + RMF_HIGH_ADDRESS_SIZE) + len);
+      bool useCoalescer;
+      if (apx_fileManagerWorker_applyBackpressure(self, &useCoalescer))
+      {
+         return APX_NO_ERROR;
+      }
+      if (useCoalescer)
+      {
+         return apx_fileManagerWorker_sendDynamicDataCoalesced(self, address, len, data);
+      }
       SPINLOCK_ENTER(self->lock);
-      result = adt_rbfh_insert(&self->messages, (const uint8_t*) &msg);
-      SPINLOCK_LEAVE(self->lock);
-      if (result == BUF_E_OK)
+      if (self->transmitHandler.sendBatch == 0)
       {
-#ifndef UNIT_TEST
-         SEMAPHORE_POST(self->semaphore);
-#endif
+         retval = APX_NOT_IMPLEMENTED_ERROR;
       }
       else
       {
-         return apx_fileManagerWorker_processRingBufErrorCode(result);
+         int32_t requiredLen = self->directLen + maxFramesLen;
+         if ( ( (int32_t) adt_bytearray_length(&self->directBuffer) < requiredLen) &&
+               (adt_bytearray_resize(&self->directBuffer, (uint32_t) requiredLen) != 0) )
+         {
+            retval = APX_MEM_ERROR;
+         }
+         else
+         {
+            int32_t frameLen = apx_fileManagerWorker_serializeDataFrames(self, adt_bytearray_data(&self->directBuffer) + self->directLen, address, len, data);
+            if (frameLen <= 0)
+            {
+               retval = APX_MSG_TOO_LARGE_ERROR;
+            }
+            else
+            {
+               apx_msg_t msg = {APX_MSG_SEND_FILE_DATA_DIRECT, 0, 0, {0}, 0};
+               msg.msgData1 = address;
+               msg.msgData2 = (uint32_t) frameLen;
+               //pushed while holding lock so that frames in directBuffer stay in the same order as their messages
+               retval = apx_fileManagerWorker_pushMessage(self, &msg);
+               if (retval == APX_NO_ERROR)
+               {
+                  self->directLen += frameLen;
+                  self->stats.numBytesCopied += len;
+               }
+            }
+         }
+      }
+      SPINLOCK_LEAVE(self->lock);
+      return retval;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Latest-value-wins version of apx_fileManagerWorker_sendDynamicData. data is copied into the write coalescer,
+ * a message is only queued when no write to the same address is already waiting to be sent (or when merging into it would
+ * reorder overlapping writes). The caller keeps ownership of data.
+ */
+apx_error_t apx_fileManagerWorker_sendDynamicDataCoalesced(apx_fileManagerWorker_t *self, uint32_t address, uint32_t len, const uint8_t *data)
+{
+   if ( (self != 0) && (data != 0) )
+   {
+      bool isMerged = false;
+      apx_error_t retval;
+      SPINLOCK_ENTER(self->lock);
+      retval = apx_writeCoalescer_write(&self->coalescer, address, data, len, &isMerged);
+      if (retval == APX_NO_ERROR)
+      {
+         self->stats.numBytesCopied += len;
+         if (isMerged)
+         {
+            self->stats.numCoalescedWrites++;
+         }
+         else
+         {
+            apx_msg_t msg = {APX_MSG_SEND_FILE_COALESCED_DATA, 0, 0, {0}, 0};
+            msg.msgData1 = address;
+            //pushed while holding lock so that the worker thread never sees the message before the entry
+            retval = apx_fileManagerWorker_pushMessage(self, &msg);
+            if (retval != APX_NO_ERROR)
+            {
+               apx_writeCoalescer_removeNewest(&self->coalescer, address);
+            }
+         }
       }
-      return APX_NO_ERROR;
+      SPINLOCK_LEAVE(self->lock);
+      return retval;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
@@ -284,24 +540,110 @@ apx_error_t apx_fileManagerWorker_sendHeaderAckMsg(apx_fileManagerWorker_t *self
 {
    if ( (self != 0) )
    {
-      adt_buf_err_t result;
       apx_msg_t msg = {APX_MSG_SEND_ACKNOWLEDGE, 0, 0, {0}, 0};
-      SPINLOCK_ENTER(self->lock);
-      result = adt_rbfh_insert(&self->messages, (const uint8_t*) &msg);
-      SPINLOCK_LEAVE(self->lock);
-      if (result == BUF_E_OK)
+      return apx_fileManagerWorker_pushMessage(self, &msg);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+//Scheduler API
+
+/**
+ * Hands the processing of messages to an external scheduler (such as the server data plane) instead of workerThread.
+ * scheduleFunc is called by the thread that pushes a message while the worker is idle. The scheduler must then call
+ * apx_fileManagerWorker_runScheduled, from one thread at a time, until it returns false.
+ * The scheduler thread never waits for maxUpdateRate (see apx_fileManagerWorker_setCoalesceConfig), runScheduled
+ * returns a delay instead and the scheduler keeps the worker until it has passed.
+ * When scheduleFunc fails the worker counts as idle again, the next message pushed retries.
+ * Must be called before apx_fileManagerWorker_start.
+ */
+void apx_fileManagerWorker_setScheduler(apx_fileManagerWorker_t *self, apx_fileManagerWorker_scheduleFunc *scheduleFunc, void *arg)
+{
+   if (self != 0)
+   {
+      assert(self->workerThreadValid == false);
+      self->scheduleFunc = scheduleFunc;
+      self->scheduleArg = arg;
+   }
+}
+
+/**
+ * Processes at most maxMessages pending messages as one batch.
+ * Returns true when the worker has more messages and must be run again, the scheduler keeps it queued in that case.
+ * delayMs is then set to the number of milliseconds the scheduler shall wait before running it again, this is 0 unless
+ * maxUpdateRate held back a message.
+ * Returns false when the worker is idle or has processed APX_MSG_EXIT, the scheduler is notified again by the next push.
+ */
+bool apx_fileManagerWorker_runScheduled(apx_fileManagerWorker_t *self, uint32_t maxMessages, uint32_t *delayMs)
+{
+   bool retval = false;
+   if ( (self != 0) && (delayMs != 0) )
+   {
+      apx_msg_t msg;
+      bool isRunning = true;
+      bool isBatching;
+      bool isBudgetUsed = false;
+      bool isRateLimited = false;
+      uint32_t numProcessed = 0u;
+      ATOMIC_STORE(&self->isRunningScheduled, 1u);
+      *delayMs = 0u;
+      isBatching = workerThread_isBatchEnabled(self);
+      if (isBatching)
       {
-#ifndef UNIT_TEST
-         SEMAPHORE_POST(self->semaphore);
-#endif
+         workerThread_beginBatch(self);
+      }
+      while (workerThread_nextScheduledMessage(self, &msg))
+      {
+         if ( (msg.msgType == APX_MSG_SEND_FILE_COALESCED_DATA) && (!workerThread_takeSendSlot(self, delayMs)) )
+         {
+            //Writes arriving until the scheduler runs the worker again merge into the held back message
+            self->deferredMsg = msg;
+            self->hasDeferredMsg = true;
+            SPINLOCK_ENTER(self->lock);
+            self->stats.numRateLimitWaits++;
+            SPINLOCK_LEAVE(self->lock);
+            isRateLimited = true;
+            break;
+         }
+         //APX_MSG_EXIT must be seen even when the transmit handler has been removed
+         isRunning = (msg.msgType != APX_MSG_EXIT) && workerThread_processMessage(self, &msg);
+         numProcessed++;
+         if (!isRunning)
+         {
+            break;
+         }
+         if ( (numProcessed >= maxMessages) || (isBatching && (self->batchLen + self->directSpanLen >= self->maxBatchSize)) )
+         {
+            isBudgetUsed = true;
+            break;
+         }
+      }
+      if (isBatching)
+      {
+         workerThread_endBatch(self);
+      }
+      if (!isRunning)
+      {
+         //isScheduled stays set, the scheduler is never notified about this worker again
+         ATOMIC_STORE(&self->isExited, 1u);
+      }
+      else if (isBudgetUsed || isRateLimited)
+      {
+         retval = true;
       }
       else
       {
-         return apx_fileManagerWorker_processRingBufErrorCode(result);
+         (void) ATOMIC_EXCHANGE(&self->isScheduled, 0u);
+         //A producer that pushed after the last pop saw isScheduled set and did not notify the scheduler, check again
+         if ( (apx_mpscRing_length(&self->messages) > 0u) && (ATOMIC_EXCHANGE(&self->isScheduled, 1u) == 0u) )
+         {
+            retval = true;
+         }
       }
-      return APX_NO_ERROR;
+      //Must be the last access to self, apx_fileManagerWorker_stopScheduled lets the worker be destroyed once this is cleared
+      ATOMIC_STORE(&self->isRunningScheduled, 0u);
    }
-   return APX_INVALID_ARGUMENT_ERROR;
+   return retval;
 }
 
 
@@ -310,23 +652,57 @@ apx_error_t apx_fileManagerWorker_sendHeaderAckMsg(apx_fileManagerWorker_t *self
 #ifdef UNIT_TEST
 bool apx_fileManagerWorker_run(apx_fileManagerWorker_t *self)
 {
-   if (self != 0)
+   if ( (self != 0) && (self->scheduleFunc == 0) )
    {
-      while (adt_rbfh_length(&self->messages) > 0)
+      apx_msg_t msg;
+      if (apx_mpscRing_pop(&self->messages, &msg))
       {
-         apx_msg_t msg;
-         adt_rbfh_remove(&self->messages,(uint8_t*) &msg);
          return workerThread_processMessage(self, &msg);
       }
    }
    return false;
 }
 
+/**
+ * Processes all pending messages as one batch (same as one wakeup of the worker thread)
+ */
+bool apx_fileManagerWorker_runBatch(apx_fileManagerWorker_t *self)
+{
+   bool retval = false;
+   if ( (self != 0) && (self->scheduleFunc == 0) && (apx_mpscRing_length(&self->messages) > 0u) )
+   {
+      bool isBatching = workerThread_isBatchEnabled(self);
+      retval = true;
+      if (isBatching)
+      {
+         workerThread_beginBatch(self);
+      }
+      while (retval == true)
+      {
+         apx_msg_t msg;
+         if (!apx_mpscRing_pop(&self->messages, &msg))
+         {
+            break;
+         }
+         retval = workerThread_processMessage(self, &msg);
+         if ( isBatching && (self->batchLen + self->directSpanLen >= self->maxBatchSize) )
+         {
+            break;
+         }
+      }
+      if (isBatching)
+      {
+         workerThread_endBatch(self);
+      }
+   }
+   return retval;
+}
+
 int32_t apx_fileManagerWorker_numPendingMessages(apx_fileManagerWorker_t *self)
 {
    if (self != 0)
    {
-      return (int32_t) adt_rbfh_length(&self->messages);
+      return (int32_t) apx_mpscRing_length(&self->messages);
    }
    return -1;
 }
@@ -408,10 +784,7 @@ static void apx_fileManagerWorker_stopThread(apx_fileManagerWorker_t *self)
          DWORD result;
    #endif
          apx_msg_t msg = {APX_MSG_EXIT,0,0,{0}}; //{msgType, sender, msgData1, msgData2, msgData3}
-         SPINLOCK_ENTER(self->lock);
-         adt_rbfh_insert(&self->messages,(const uint8_t*) &msg);
-         SPINLOCK_LEAVE(self->lock);
-         SEMAPHORE_POST(self->semaphore);
+         apx_mpscRing_push(&self->messages, &msg);
    #ifdef _MSC_VER
          result = WaitForSingleObject(self->workerThread, 5000);
          if (result == WAIT_TIMEOUT)
@@ -457,42 +830,214 @@ static THREAD_PROTO(workerThread,arg)
 
       while(isRunning == true)
       {
-         //printf("[%u] Waiting for semaphore\n", fmid);
-#ifdef _MSC_VER
-         DWORD result = WaitForSingleObject(self->semaphore, INFINITE);
-         if (result == WAIT_OBJECT_0)
-#else
-
-         int result = sem_wait(&self->semaphore);
-         if (result == 0)
-#endif
+         if (!apx_mpscRing_pop(&self->messages, &msg))
          {
-            //printf("[%u] Semaphore wait success\n", fmid);
-            SPINLOCK_ENTER(self->lock);
-            adt_rbfh_remove(&self->messages,(uint8_t*) &msg);
-            SPINLOCK_LEAVE(self->lock);
-            if (!workerThread_processMessage(self, &msg))
+            //spins briefly before sleeping, callers only make a system call to wake this thread up when it sleeps
+            apx_mpscRing_wait(&self->messages, APX_MPSC_RING_WAIT_FOREVER);
+            continue;
+         }
+         if (workerThread_isBatchEnabled(self))
+         {
+            apx_workerDeadline_t deadline;
+            workerThread_setDeadline(self, &deadline);
+            workerThread_beginBatch(self);
+            isRunning = workerThread_processMessage(self, &msg);
+            messages_processed++;
+            while ( (isRunning == true) && (self->batchLen + self->directSpanLen < self->maxBatchSize) && workerThread_waitForNextMessage(self, &deadline, &msg) )
             {
-               isRunning = false;
+               isRunning = workerThread_processMessage(self, &msg);
+               messages_processed++;
             }
-            messages_processed++;
+            workerThread_endBatch(self);
          }
          else
          {
-            printf("Failed to wait for semaphore\n");
+            if (!workerThread_processMessage(self, &msg))
+            {
+               isRunning = false;
+            }
+            messages_processed++;
          }
       }
       //printf("[%u]: messages_processed: %u\n",fmid, messages_processed);
    }
    THREAD_RETURN(0);
 }
+
+/**
+ * Sleeps until workerThread_takeSendSlot hands out a token, writes arriving in the meantime merge into the queued ones.
+ * Only used by workerThread, an external scheduler gets the wait time from apx_fileManagerWorker_runScheduled instead.
+ */
+static void workerThread_waitForSendSlot(apx_fileManagerWorker_t *self)
+{
+   uint32_t waitTime;
+   while (!workerThread_takeSendSlot(self, &waitTime))
+   {
+      SPINLOCK_ENTER(self->lock);
+      self->stats.numRateLimitWaits++;
+      SPINLOCK_LEAVE(self->lock);
+      if (self->isBatching)
+      {
+         //don't hold already collected messages while waiting
+         workerThread_flushDirectSpan(self);
+         workerThread_flushBatch(self);
+      }
+      SLEEP(waitTime);
+   }
+}
+
+static void workerThread_setDeadline(apx_fileManagerWorker_t *self, apx_workerDeadline_t *deadline)
+{
+#ifdef _MSC_VER
+   *deadline = GetTickCount() + self->maxBatchLatency;
+#else
+   clock_gettime(CLOCK_REALTIME, deadline);
+   deadline->tv_sec += (time_t) (self->maxBatchLatency / 1000u);
+   deadline->tv_nsec += (long) (self->maxBatchLatency % 1000u) * 1000000L;
+   if (deadline->tv_nsec >= 1000000000L)
+   {
+      deadline->tv_sec++;
+      deadline->tv_nsec -= 1000000000L;
+   }
+#endif
+}
+
+/**
+ * Removes the next message from the message queue, waiting for it no longer than until deadline.
+ * Returns true if msg was updated.
+ */
+static bool workerThread_waitForNextMessage(apx_fileManagerWorker_t *self, const apx_workerDeadline_t *deadline, apx_msg_t *msg)
+{
+   uint32_t timeout;
+   if (apx_mpscRing_pop(&self->messages, msg))
+   {
+      return true;
+   }
+   if (self->maxBatchLatency == 0u)
+   {
+      return false;
+   }
+   timeout = workerThread_remainingTime(deadline);
+   if ( (timeout > 0u) && apx_mpscRing_wait(&self->messages, timeout) )
+   {
+      return apx_mpscRing_pop(&self->messages, msg);
+   }
+   return false;
+}
+
+/**
+ * Returns number of milliseconds until deadline (rounded up), 0 if the deadline has passed
+ */
+static uint32_t workerThread_remainingTime(const apx_workerDeadline_t *deadline)
+{
+#ifdef _MSC_VER
+   DWORD now = GetTickCount();
+   return ( (int32_t) (*deadline - now) > 0)? (uint32_t) (*deadline - now) : 0u;
+#else
+   struct timespec now;
+   int64_t remainingNs;
+   clock_gettime(CLOCK_REALTIME, &now);
+   remainingNs = ((int64_t) (deadline->tv_sec - now.tv_sec)) * 1000000000LL + (int64_t) (deadline->tv_nsec - now.tv_nsec);
+   return (remainingNs > 0)? (uint32_t) ((remainingNs + 999999LL) / 1000000LL) : 0u;
+#endif
+}
 #endif //UNIT_TEST
 
+static uint32_t workerThread_getTickCount(void)
+{
+#ifdef _MSC_VER
+   return (uint32_t) GetTickCount();
+#else
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (uint32_t) ( ((uint64_t) now.tv_sec) * 1000u + ((uint64_t) now.tv_nsec) / 1000000u );
+#endif
+}
+
+/**
+ * Token bucket implementing maxUpdateRate. Holds up to APX_WORKER_COALESCE_BURST tokens, one token is used per coalesced message.
+ * Returns false when no token is available, waitTime is then set to the number of milliseconds until the next one.
+ */
+static bool workerThread_takeSendSlot(apx_fileManagerWorker_t *self, uint32_t *waitTime)
+{
+   uint32_t maxUpdateRate = self->maxUpdateRate;
+   uint32_t now;
+   uint32_t elapsed;
+   uint32_t newTokens;
+   uint32_t interval;
+   if (maxUpdateRate == 0u)
+   {
+      return true;
+   }
+   now = workerThread_getTickCount();
+   elapsed = now - self->rateRefillTime;
+   newTokens = (uint32_t) ( ((uint64_t) elapsed * maxUpdateRate) / 1000u );
+   if (newTokens > 0u)
+   {
+      self->rateTokens += newTokens;
+      if (self->rateTokens > APX_WORKER_COALESCE_BURST)
+      {
+         self->rateTokens = APX_WORKER_COALESCE_BURST;
+      }
+      //only advance by the time actually converted into tokens so that fractions are not lost
+      self->rateRefillTime += (uint32_t) ( ((uint64_t) newTokens * 1000u) / maxUpdateRate );
+      if ( (uint32_t) (now - self->rateRefillTime) > 1000u )
+      {
+         self->rateRefillTime = now;
+      }
+   }
+   if (self->rateTokens > 0u)
+   {
+      self->rateTokens--;
+      return true;
+   }
+   interval = (1000u + maxUpdateRate - 1u) / maxUpdateRate;
+   elapsed = now - self->rateRefillTime;
+   *waitTime = (elapsed < interval)? (interval - elapsed) : 1u;
+   return false;
+}
+
+/**
+ * The message held back by the rate limit goes first, it was popped before the ones still in the queue
+ */
+static bool workerThread_nextScheduledMessage(apx_fileManagerWorker_t *self, apx_msg_t *msg)
+{
+   if (self->hasDeferredMsg)
+   {
+      *msg = self->deferredMsg;
+      self->hasDeferredMsg = false;
+      return true;
+   }
+   return apx_mpscRing_pop(&self->messages, msg);
+}
+
 static bool workerThread_processMessage(apx_fileManagerWorker_t *self, apx_msg_t *msg)
 {
    bool retval = true;
    uint32_t connectionId = apx_fileManagerShared_getConnectionId(self->shared);
-   if (self->transmitHandler.send != 0)
+   if ( workerThread_isDataMessage(msg) && workerThread_isShedding(self) )
+   {
+      workerThread_dropDataMessage(self, msg);
+   }
+   else if (msg->msgType == APX_MSG_SEND_FILE_DATA_DIRECT)
+   {
+      //Always processed, even without transmit handler, in order to keep directSendBuffer in sync with the message queue
+      apx_error_t rc = workerThread_sendFileDataDirect(self, msg);
+      if (rc != APX_NO_ERROR)
+      {
+         printf("[WORKER] workerThread_sendFileDataDirect failed with error: %d\n", (int) rc);
+      }
+   }
+   else if (msg->msgType == APX_MSG_SEND_FILE_COALESCED_DATA)
+   {
+      //Always processed, even without transmit handler, in order to release the entry in the coalescer
+      apx_error_t rc = workerThread_sendFileCoalescedData(self, msg);
+      if (rc != APX_NO_ERROR)
+      {
+         printf("[WORKER] workerThread_sendFileCoalescedData failed with error: %d\n", (int) rc);
+      }
+   }
+   else if (self->transmitHandler.send != 0)
    {
       apx_error_t rc;
       switch(msg->msgType)
@@ -525,8 +1070,6 @@ static bool workerThread_processMessage(apx_fileManagerWorker_t *self, apx_msg_t
             printf("[WORKER] workerThread_sendFileDyntData failed with error: %d\n", (int) rc);
          }
          break;
-      case APX_MSG_SEND_FILE_DATA_DIRECT:
-         break;
       case APX_MSG_SEND_ERROR_CODE:
          break;
       default:
@@ -548,13 +1091,13 @@ static void workerThread_sendFileInfo(apx_fileManagerWorker_t *self, apx_msg_t *
    assert(self->transmitHandler.send != 0);
    if (apx_fileManagerShared_isConnected(self->shared) )
    {
-      msgBuf = self->transmitHandler.getSendBuffer(self->transmitHandler.arg, msgSize);
+      msgBuf = workerThread_getSendBuffer(self, msgSize);
       if (msgBuf != 0)
       {
          int32_t result = apx_fileManagerWorker_serializeFileInfo(msgBuf, msgSize, fileInfo);
          if (result > 0)
          {
-            self->transmitHandler.send(self->transmitHandler.arg, 0, result);
+            workerThread_send(self, result);
          }
       }
    }
@@ -575,7 +1118,7 @@ static void workerThread_sendFileOpen(apx_fileManagerWorker_t *self, apx_msg_t *
       assert(self->transmitHandler.send != 0);
       if (apx_fileManagerShared_isConnected(self->shared) )
       {
-         msgBuf = self->transmitHandler.getSendBuffer(self->transmitHandler.arg, msgSize);
+         msgBuf = workerThread_getSendBuffer(self, msgSize);
          if (msgBuf != 0)
          {
             int32_t result = rmf_packHeader(msgBuf, msgSize, RMF_CMD_START_ADDR, false);
@@ -587,7 +1130,7 @@ static void workerThread_sendFileOpen(apx_fileManagerWorker_t *self, apx_msg_t *
                result = rmf_serialize_cmdOpenFile(msgBuf, RMF_CMD_FILE_OPEN_LEN, &cmd);
                if (result == RMF_CMD_FILE_OPEN_LEN)
                {
-                  self->transmitHandler.send(self->transmitHandler.arg, 0, msgSize);
+                  workerThread_send(self, msgSize);
                }
             }
          }
@@ -629,7 +1172,7 @@ static apx_error_t workerThread_sendFileConstData(apx_fileManagerWorker_t *self,
       msgSize = headerSize + dataSize;
       if (apx_fileManagerShared_isConnected(self->shared) )
       {
-         msgBuf = self->transmitHandler.getSendBuffer(self->transmitHandler.arg, msgSize);
+         msgBuf = workerThread_getSendBuffer(self, msgSize);
          if (msgBuf != 0)
          {
             int32_t result = rmf_packHeader(msgBuf, msgSize, address, false);
@@ -639,7 +1182,7 @@ static apx_error_t workerThread_sendFileConstData(apx_fileManagerWorker_t *self,
                apx_error_t rc = readFunc(arg, file, offset, &msgBuf[headerSize], dataSize);
                if (rc == APX_NO_ERROR)
                {
-                  result = self->transmitHandler.send(self->transmitHandler.arg, 0, msgSize);
+                  result = workerThread_send(self, msgSize);
    #if APX_DEBUG_ENABLE
                   printf("[WORKER] Bytes transmitted: %d\n", result);
    #endif
@@ -679,16 +1222,19 @@ static apx_error_t workerThread_sendFileDynData(apx_fileManagerWorker_t *self, a
       assert(self->shared != 0);
       if (apx_fileManagerShared_isConnected(self->shared) )
       {
-         msgBuf = self->transmitHandler.getSendBuffer(self->transmitHandler.arg, msgSize);
+         msgBuf = workerThread_getSendBuffer(self, msgSize);
          if (msgBuf != 0)
          {
             int32_t result = rmf_packHeader(msgBuf, msgSize, address, false);
             if (result == headerSize)
             {
                memcpy(&msgBuf[headerSize], dataPtr, dataSize);
+               SPINLOCK_ENTER(self->lock);
+               self->stats.numBytesCopied += 2u * dataSize; //the copy made by the caller when it allocated dataPtr plus the one above
+               SPINLOCK_LEAVE(self->lock);
                assert(self->shared != 0);
                apx_fileManagerShared_freeAllocatedMemory(self->shared, dataPtr, dataSize);
-               result = self->transmitHandler.send(self->transmitHandler.arg, 0, msgSize);
+               result = workerThread_send(self, msgSize);
    #if APX_DEBUG_ENABLE
 //               printf("[WORKER] Bytes transmitted: %d/%d \n", result, msgSize);
    #endif
@@ -705,6 +1251,9 @@ static apx_error_t workerThread_sendFileDynData(apx_fileManagerWorker_t *self, a
       }
       else
       {
+         SPINLOCK_ENTER(self->lock);
+         self->stats.numBytesCopied += dataSize; //the copy made by the caller when it allocated dataPtr
+         SPINLOCK_LEAVE(self->lock);
          apx_fileManagerShared_freeAllocatedMemory(self->shared, dataPtr, dataSize);
       }
       return APX_NO_ERROR;
@@ -712,6 +1261,221 @@ static apx_error_t workerThread_sendFileDynData(apx_fileManagerWorker_t *self, a
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Sends the newest bytes written to msgData1. The entry is removed from the coalescer only now,
+ * so every write that arrived while the message was queued (or while waiting for the rate limit) is included.
+ */
+static apx_error_t workerThread_sendFileCoalescedData(apx_fileManagerWorker_t *self, apx_msg_t *msg)
+{
+   int32_t headerSize;
+   int32_t msgSize;
+   int32_t dataSize;
+   uint8_t *msgBuf;
+   uint32_t address = msg->msgData1;
+   assert(self->shared != 0);
+   if ( (self->transmitHandler.send == 0) || (!apx_fileManagerShared_isConnected(self->shared)) )
+   {
+      SPINLOCK_ENTER(self->lock);
+      apx_writeCoalescer_remove(&self->coalescer, address);
+      SPINLOCK_LEAVE(self->lock);
+      return APX_NO_ERROR;
+   }
+#ifndef UNIT_TEST
+   if (self->scheduleFunc == 0)
+   {
+      workerThread_waitForSendSlot(self);
+   }
+#endif
+   SPINLOCK_ENTER(self->lock);
+   dataSize = apx_writeCoalescer_getLength(&self->coalescer, address);
+   if (dataSize >= 0)
+   {
+      if ( ( (int32_t) adt_bytearray_length(&self->coalescedSendBuffer) < dataSize) &&
+           (adt_bytearray_resize(&self->coalescedSendBuffer, (uint32_t) dataSize) != 0) )
+      {
+         apx_writeCoalescer_remove(&self->coalescer, address);
+         dataSize = -2;
+      }
+      else
+      {
+         dataSize = apx_writeCoalescer_take(&self->coalescer, address, adt_bytearray_data(&self->coalescedSendBuffer), (uint32_t) dataSize);
+         assert(dataSize >= 0);
+         self->stats.numBytesCopied += (uint32_t) dataSize;
+      }
+   }
+   SPINLOCK_LEAVE(self->lock);
+   if (dataSize < 0)
+   {
+      return (dataSize == -1)? APX_NO_ERROR : APX_MEM_ERROR;
+   }
+   headerSize = (address <= RMF_DATA_LOW_MAX_ADDR)? RMF_LOW_ADDRESS_SIZE : RMF_HIGH_ADDRESS_SIZE;
+   msgSize = headerSize + dataSize;
+   msgBuf = workerThread_getSendBuffer(self, msgSize);
+   if (msgBuf != 0)
+   {
+      int32_t result = rmf_packHeader(msgBuf, msgSize, address, false);
+      if (result == headerSize)
+      {
+         memcpy(&msgBuf[headerSize], adt_bytearray_constData(&self->coalescedSendBuffer), (size_t) dataSize);
+         result = workerThread_send(self, msgSize);
+         if (result != msgSize)
+         {
+            return APX_TRANSMIT_ERROR;
+         }
+      }
+   }
+   else
+   {
+      return APX_MISSING_BUFFER_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+/**
+ * The message was already serialized by apx_fileManagerWorker_sendDynamicDataDirect, msgData2 holds its length in bytes (including numheader).
+ * Consecutive messages are sent as one contiguous span directly out of directSendBuffer.
+ */
+static apx_error_t workerThread_sendFileDataDirect(apx_fileManagerWorker_t *self, apx_msg_t *msg)
+{
+   int32_t frameLen = (int32_t) msg->msgData2;
+   if (self->batchLen > 0)
+   {
+      //messages already in batchBuffer must be sent first to preserve message order
+      workerThread_flushBatch(self);
+   }
+   if (self->directSendPos + self->directSpanLen >= self->directSendLen)
+   {
+      workerThread_flushDirectSpan(self);
+      workerThread_swapDirectBuffers(self);
+   }
+   assert(self->directSendPos + self->directSpanLen + frameLen <= self->directSendLen);
+   self->directSpanLen += frameLen;
+   self->directSpanMsgCount++;
+   if (!self->isBatching)
+   {
+      return workerThread_flushDirectSpan(self);
+   }
+   return APX_NO_ERROR;
+}
+
+/**
+ * Applies backpressurePolicy to a dynamic data write that is about to be queued.
+ * Returns true when the write shall be discarded. useCoalescer is set to true when the write shall go through the write coalescer.
+ */
+static bool apx_fileManagerWorker_applyBackpressure(apx_fileManagerWorker_t *self, bool *useCoalescer)
+{
+   bool isDiscarded = false;
+   bool isOverloadTriggered = false;
+   uint32_t depth;
+   *useCoalescer = self->isCoalescing;
+   if ( (self->backpressurePolicy == APX_BACKPRESSURE_POLICY_NONE) || (self->queueHighWaterMark == 0u) )
+   {
+      return false;
+   }
+   depth = apx_mpscRing_length(&self->messages);
+   if ( (depth < self->queueHighWaterMark) && (self->backpressurePolicy != APX_BACKPRESSURE_POLICY_COALESCE) )
+   {
+      return false;
+   }
+   SPINLOCK_ENTER(self->lock);
+   if (depth >= self->queueHighWaterMark)
+   {
+      self->stats.numHighWaterMarkHits++;
+   }
+   switch(self->backpressurePolicy)
+   {
+   case APX_BACKPRESSURE_POLICY_DROP_OLDEST:
+      //Only the worker thread can remove the oldest messages, this limit protects memory while it is stuck in the transmit handler
+      isDiscarded = (depth >= self->queueHighWaterMark * 2u)? true : false;
+      break;
+   case APX_BACKPRESSURE_POLICY_COALESCE:
+      //Keeps coalescing until every merged write has been sent, a write queued behind a pending entry would otherwise be
+      //overtaken by later writes merged into that entry
+      if ( (depth >= self->queueHighWaterMark) || (apx_writeCoalescer_length(&self->coalescer) > 0u) )
+      {
+         *useCoalescer = true;
+      }
+      break;
+   case APX_BACKPRESSURE_POLICY_DISCONNECT:
+      if (!self->isOverloaded)
+      {
+         self->isOverloaded = true;
+         self->stats.numOverloads++;
+         isOverloadTriggered = true;
+      }
+      isDiscarded = true;
+      break;
+   default:
+      break;
+   }
+   if (isDiscarded)
+   {
+      self->stats.numDroppedMessages++;
+   }
+   SPINLOCK_LEAVE(self->lock);
+   if (isOverloadTriggered)
+   {
+      //the worker thread discards everything still queued once the connection is marked as disconnected
+      apx_fileManagerShared_disconnect(self->shared);
+      apx_fileManagerShared_overloadNotify(self->shared);
+   }
+   return isDiscarded;
+}
+
+static bool workerThread_isDataMessage(const apx_msg_t *msg)
+{
+   return ( (msg->msgType == APX_MSG_SEND_FILE_DATA_DIRECT) || (msg->msgType == APX_MSG_SEND_FILE_COALESCED_DATA) ||
+            (msg->msgType == APX_MSG_SEND_FILE_DYN_DATA) )? true : false;
+}
+
+/**
+ * True while APX_BACKPRESSURE_POLICY_DROP_OLDEST wants the worker thread to discard data messages
+ */
+static bool workerThread_isShedding(apx_fileManagerWorker_t *self)
+{
+   return ( (self->backpressurePolicy == APX_BACKPRESSURE_POLICY_DROP_OLDEST) && (self->queueHighWaterMark > 0u) &&
+            (apx_mpscRing_length(&self->messages) >= self->queueHighWaterMark) )? true : false;
+}
+
+static void workerThread_dropDataMessage(apx_fileManagerWorker_t *self, apx_msg_t *msg)
+{
+   SPINLOCK_ENTER(self->lock);
+   if (msg->msgType == APX_MSG_SEND_FILE_COALESCED_DATA)
+   {
+      apx_writeCoalescer_remove(&self->coalescer, msg->msgData1);
+   }
+   else if (msg->msgType == APX_MSG_SEND_FILE_DYN_DATA)
+   {
+      self->stats.numBytesCopied += msg->msgData2; //the copy made by the caller when it allocated data
+   }
+   self->stats.numDroppedMessages++;
+   SPINLOCK_LEAVE(self->lock);
+   if (msg->msgType == APX_MSG_SEND_FILE_DATA_DIRECT)
+   {
+      workerThread_skipFileDataDirect(self, (int32_t) msg->msgData2);
+   }
+   else if (msg->msgType == APX_MSG_SEND_FILE_DYN_DATA)
+   {
+      apx_fileManagerShared_freeAllocatedMemory(self->shared, (uint8_t*) msg->msgData3.ptr, msg->msgData2);
+   }
+}
+
+/**
+ * Same bookkeeping as workerThread_sendFileDataDirect but the frame is never sent.
+ * Frames already in the pending span are older and are sent first.
+ */
+static void workerThread_skipFileDataDirect(apx_fileManagerWorker_t *self, int32_t frameLen)
+{
+   if (self->directSendPos + self->directSpanLen >= self->directSendLen)
+   {
+      workerThread_flushDirectSpan(self);
+      workerThread_swapDirectBuffers(self);
+   }
+   workerThread_flushDirectSpan(self);
+   assert(self->directSendPos + frameLen <= self->directSendLen);
+   self->directSendPos += frameLen;
+}
+
 static void workerThread_sendAcknowledge(apx_fileManagerWorker_t *self)
 {
    const int32_t msgSize = RMF_CMD_ADDRESS_LEN+RMF_CMD_ACK_LEN;
@@ -720,7 +1484,7 @@ static void workerThread_sendAcknowledge(apx_fileManagerWorker_t *self)
    assert(self->transmitHandler.send != 0);
    if (apx_fileManagerShared_isConnected(self->shared) )
    {
-      msgBuf = self->transmitHandler.getSendBuffer(self->transmitHandler.arg, msgSize);
+      msgBuf = workerThread_getSendBuffer(self, msgSize);
       if (msgBuf != 0)
       {
          int32_t result = rmf_packHeader(msgBuf, msgSize, RMF_CMD_START_ADDR, false);
@@ -729,18 +1493,361 @@ static void workerThread_sendAcknowledge(apx_fileManagerWorker_t *self)
             result = rmf_serialize_acknowledge(msgBuf+RMF_CMD_ADDRESS_LEN, RMF_CMD_ACK_LEN);
             if (result == RMF_CMD_ACK_LEN)
             {
-               self->transmitHandler.send(self->transmitHandler.arg, 0, msgSize);
+               workerThread_send(self, msgSize);
+            }
+         }
+      }
+   }
+}
+
+static bool workerThread_isBatchEnabled(apx_fileManagerWorker_t *self)
+{
+   return ( (self->maxBatchSize > 0) && (self->transmitHandler.sendBatch != 0) )? true : false;
+}
+
+static void workerThread_beginBatch(apx_fileManagerWorker_t *self)
+{
+   self->batchLen = 0;
+   self->batchMsgCount = 0;
+   self->isBatching = true;
+}
+
+static void workerThread_endBatch(apx_fileManagerWorker_t *self)
+{
+   workerThread_flushDirectSpan(self);
+   workerThread_flushBatch(self);
+   self->isBatching = false;
+}
+
+/**
+ * Sends all messages collected in batchBuffer using a single call to transmitHandler.sendBatch.
+ */
+static apx_error_t workerThread_flushBatch(apx_fileManagerWorker_t *self)
+{
+   apx_error_t retval = APX_NO_ERROR;
+   if (self->batchLen > 0)
+   {
+      int32_t result;
+      assert(self->transmitHandler.sendBatch != 0);
+      result = self->transmitHandler.sendBatch(self->transmitHandler.arg, adt_bytearray_constData(&self->batchBuffer), self->batchLen);
+      if (result == APX_TRANSMIT_HANDLER_WOULD_BLOCK)
+      {
+         //the batch can carry more than data messages, it cannot be skipped without breaking the stream
+         retval = APX_BUFFER_FULL_ERROR;
+         workerThread_handleTransmitOverload(self, self->batchMsgCount, false);
+      }
+      else
+      {
+         if (result != self->batchLen)
+         {
+            retval = APX_TRANSMIT_ERROR;
+         }
+         workerThread_updateFlushStats(self, self->batchMsgCount, retval == APX_NO_ERROR);
+      }
+#if APX_DEBUG_ENABLE
+      printf("[WORKER] Flushed %d messages (%d bytes)\n", (int) self->batchMsgCount, (int) self->batchLen);
+#endif
+   }
+   self->batchLen = 0;
+   self->batchMsgCount = 0;
+   return retval;
+}
+
+/**
+ * Sends the pending span of directSendBuffer using a single call to transmitHandler.sendBatch.
+ * The span is dropped when there is no one to send it to.
+ */
+static apx_error_t workerThread_flushDirectSpan(apx_fileManagerWorker_t *self)
+{
+   apx_error_t retval = APX_NO_ERROR;
+   if (self->directSpanLen > 0)
+   {
+      if ( (self->transmitHandler.sendBatch != 0) && apx_fileManagerShared_isConnected(self->shared) )
+      {
+         const uint8_t *data = adt_bytearray_constData(&self->directSendBuffer) + self->directSendPos;
+         int32_t result = self->transmitHandler.sendBatch(self->transmitHandler.arg, data, self->directSpanLen);
+         if (result == APX_TRANSMIT_HANDLER_WOULD_BLOCK)
+         {
+            retval = APX_BUFFER_FULL_ERROR;
+            workerThread_handleTransmitOverload(self, self->directSpanMsgCount, true);
+         }
+         else
+         {
+            if (result != self->directSpanLen)
+            {
+               retval = APX_TRANSMIT_ERROR;
             }
+            workerThread_updateFlushStats(self, self->directSpanMsgCount, retval == APX_NO_ERROR);
          }
       }
+      self->directSendPos += self->directSpanLen;
+      self->directSpanLen = 0;
+      self->directSpanMsgCount = 0;
+   }
+   return retval;
+}
+
+/**
+ * Called when all of directSendBuffer has been consumed. Takes ownership of everything written into directBuffer so far
+ * and hands the (now empty) directSendBuffer back to the producer side.
+ */
+static void workerThread_swapDirectBuffers(apx_fileManagerWorker_t *self)
+{
+   adt_bytearray_t tmp;
+   SPINLOCK_ENTER(self->lock);
+   memcpy(&tmp, &self->directSendBuffer, sizeof(adt_bytearray_t));
+   memcpy(&self->directSendBuffer, &self->directBuffer, sizeof(adt_bytearray_t));
+   memcpy(&self->directBuffer, &tmp, sizeof(adt_bytearray_t));
+   self->directSendLen = self->directLen;
+   self->directLen = 0;
+   SPINLOCK_LEAVE(self->lock);
+   self->directSendPos = 0;
+}
+
+static void workerThread_updateFlushStats(apx_fileManagerWorker_t *self, int32_t msgCount, bool isSent)
+{
+   SPINLOCK_ENTER(self->lock);
+   if (isSent)
+   {
+      self->stats.numFlushes++;
+      self->stats.numMessages += (uint32_t) msgCount;
+      if ( (uint32_t) msgCount > self->stats.maxMessagesPerFlush)
+      {
+         self->stats.maxMessagesPerFlush = (uint32_t) msgCount;
+      }
+   }
+   else
+   {
+      self->stats.numTransmitErrors++;
+   }
+   SPINLOCK_LEAVE(self->lock);
+}
+
+/**
+ * Called when the transmit handler refused msgCount messages because its consumer is not keeping up.
+ * Refused data messages are dropped unless backpressurePolicy is APX_BACKPRESSURE_POLICY_DISCONNECT.
+ * Anything else cannot be dropped without corrupting the stream, so the connection is given up as overloaded.
+ */
+static void workerThread_handleTransmitOverload(apx_fileManagerWorker_t *self, int32_t msgCount, bool isDataOnly)
+{
+   bool isOverloadTriggered = false;
+   SPINLOCK_ENTER(self->lock);
+   self->stats.numTransmitOverloads++;
+   if ( isDataOnly && (self->backpressurePolicy != APX_BACKPRESSURE_POLICY_DISCONNECT) )
+   {
+      self->stats.numDroppedMessages += (uint32_t) msgCount;
+   }
+   else if (!self->isOverloaded)
+   {
+      self->isOverloaded = true;
+      self->stats.numOverloads++;
+      isOverloadTriggered = true;
+   }
+   SPINLOCK_LEAVE(self->lock);
+   if (isOverloadTriggered)
+   {
+      apx_fileManagerShared_disconnect(self->shared);
+      apx_fileManagerShared_overloadNotify(self->shared);
    }
 }
 
-static apx_error_t apx_fileManagerWorker_processRingBufErrorCode(adt_buf_err_t errorCode)
+/**
+ * Returns a buffer for a message of length msgLen.
+ * While batching, the buffer is reserved at the end of batchBuffer (after its numheader), otherwise it is provided by the transmit handler.
+ */
+static uint8_t *workerThread_getSendBuffer(apx_fileManagerWorker_t *self, int32_t msgLen)
 {
-   if (errorCode == BUF_E_OVERFLOW)
+   if (self->isBatching)
+   {
+      uint8_t header[sizeof(uint32_t)];
+      uint8_t *data;
+      int32_t requiredLen;
+      int32_t headerLen = apx_fileManagerWorker_encodeNumHeader(self, header, msgLen);
+      if (headerLen <= 0)
+      {
+         return (uint8_t*) 0;
+      }
+      if (self->directSpanLen > 0)
+      {
+         //direct messages received earlier must be sent first to preserve message order
+         workerThread_flushDirectSpan(self);
+      }
+      if ( (self->batchLen > 0) && (self->batchLen + headerLen + msgLen > self->maxBatchSize) )
+      {
+         //message does not fit in the current batch, send what we have so far and start a new one
+         workerThread_flushBatch(self);
+      }
+      requiredLen = self->batchLen + headerLen + msgLen;
+      if ( (int32_t) adt_bytearray_length(&self->batchBuffer) < requiredLen)
+      {
+         if (adt_bytearray_resize(&self->batchBuffer, (uint32_t) requiredLen) != 0)
+         {
+            return (uint8_t*) 0;
+         }
+      }
+      data = adt_bytearray_data(&self->batchBuffer);
+      assert(data != 0);
+      memcpy(&data[self->batchLen], header, headerLen);
+      self->batchHeaderLen = headerLen;
+      self->batchMsgLen = msgLen;
+      return &data[self->batchLen + headerLen];
+   }
+   return self->transmitHandler.getSendBuffer(self->transmitHandler.arg, msgLen);
+}
+
+/**
+ * Sends (or while batching, appends to batchBuffer) the message previously written into the buffer from workerThread_getSendBuffer.
+ * Returns msgLen on success.
+ */
+static int32_t workerThread_send(apx_fileManagerWorker_t *self, int32_t msgLen)
+{
+   if (self->isBatching)
+   {
+      uint8_t *data = adt_bytearray_data(&self->batchBuffer);
+      assert(data != 0);
+      assert(msgLen <= self->batchMsgLen);
+      if (msgLen != self->batchMsgLen)
+      {
+         //message turned out shorter than reserved, the numheader might need fewer bytes
+         uint8_t header[sizeof(uint32_t)];
+         int32_t headerLen = apx_fileManagerWorker_encodeNumHeader(self, header, msgLen);
+         if (headerLen <= 0)
+         {
+            return -1;
+         }
+         if (headerLen != self->batchHeaderLen)
+         {
+            memmove(&data[self->batchLen + headerLen], &data[self->batchLen + self->batchHeaderLen], msgLen);
+         }
+         memcpy(&data[self->batchLen], header, headerLen);
+         self->batchHeaderLen = headerLen;
+      }
+      self->batchLen += self->batchHeaderLen + msgLen;
+      self->batchMsgCount++;
+      return msgLen;
+   }
+   else
+   {
+      int32_t result = self->transmitHandler.send(self->transmitHandler.arg, 0, msgLen);
+      if (result == APX_TRANSMIT_HANDLER_WOULD_BLOCK)
+      {
+         workerThread_handleTransmitOverload(self, 1, false);
+      }
+      return result;
+   }
+}
+
+/**
+ * Writes data into buf as numheader-framed RMF messages of at most APX_WORKER_MAX_FRAGMENT_SIZE data bytes each.
+ * All messages but the last one have the more bit set. Returns number of bytes written to buf, 0 on failure.
+ */
+static int32_t apx_fileManagerWorker_serializeDataFrames(apx_fileManagerWorker_t *self, uint8_t *buf, uint32_t address, uint32_t len, const uint8_t *data)
+{
+   int32_t pos = 0;
+   uint32_t offset = 0u;
+   do
+   {
+      uint32_t fragmentAddress = address + offset;
+      uint32_t fragmentLen = len - offset;
+      int32_t rmfHeaderLen = (fragmentAddress <= RMF_DATA_LOW_MAX_ADDR)? RMF_LOW_ADDRESS_SIZE : RMF_HIGH_ADDRESS_SIZE;
+      int32_t msgLen;
+      int32_t headerLen;
+      bool moreBit = false;
+      if (fragmentLen > APX_WORKER_MAX_FRAGMENT_SIZE)
+      {
+         fragmentLen = APX_WORKER_MAX_FRAGMENT_SIZE;
+         moreBit = true;
+      }
+      msgLen = rmfHeaderLen + (int32_t) fragmentLen;
+      headerLen = apx_fileManagerWorker_encodeNumHeader(self, &buf[pos], msgLen);
+      if (headerLen <= 0)
+      {
+         return 0;
+      }
+      pos += headerLen;
+      rmf_packHeader(&buf[pos], msgLen, fragmentAddress, moreBit);
+      memcpy(&buf[pos + rmfHeaderLen], &data[offset], fragmentLen);
+      pos += msgLen;
+      offset += fragmentLen;
+   } while (offset < len);
+   return pos;
+}
+
+/**
+ * Queues msg and, when an external scheduler is used and the worker is idle, tells the scheduler to run the worker.
+ * When the scheduler cannot take the worker, msg stays queued and its error is returned. isScheduled is cleared
+ * so that the next push retries, otherwise no push would ever notify the scheduler again.
+ */
+static apx_error_t apx_fileManagerWorker_pushMessage(apx_fileManagerWorker_t *self, const apx_msg_t *msg)
+{
+   apx_error_t retval = apx_mpscRing_push(&self->messages, msg);
+   if ( (retval == APX_NO_ERROR) && (self->scheduleFunc != 0) && (ATOMIC_EXCHANGE(&self->isScheduled, 1u) == 0u) )
+   {
+      retval = self->scheduleFunc(self->scheduleArg, self);
+      if (retval != APX_NO_ERROR)
+      {
+         ATOMIC_STORE(&self->isScheduled, 0u);
+      }
+   }
+   return retval;
+}
+
+/**
+ * Makes sure the scheduler no longer references this worker. When the worker is queued (or running) in the scheduler,
+ * APX_MSG_EXIT is placed after the pending messages and the caller waits until the scheduler has processed it.
+ * In both cases the caller also waits until apx_fileManagerWorker_runScheduled has returned, it may still be
+ * checking the message queue after clearing isScheduled.
+ */
+static void apx_fileManagerWorker_stopScheduled(apx_fileManagerWorker_t *self)
+{
+   uint32_t elapsed = 0u;
+   if (ATOMIC_LOAD(&self->isExited) == 0u)
+   {
+      if (ATOMIC_EXCHANGE(&self->isScheduled, 1u) == 0u)
+      {
+         //Idle worker, nothing will queue it in the scheduler now that isScheduled is set
+         ATOMIC_STORE(&self->isExited, 1u);
+      }
+      else
+      {
+         apx_msg_t msg = {APX_MSG_EXIT, 0, 0, {0}, 0};
+         //The scheduler may have gone idle since isScheduled was read, pushMessage notifies it again in that case
+         if ( (apx_fileManagerWorker_pushMessage(self, &msg) != APX_NO_ERROR) && (ATOMIC_EXCHANGE(&self->isScheduled, 1u) == 0u) )
+         {
+            //The scheduler did not take the worker, it is idle like above
+            ATOMIC_STORE(&self->isExited, 1u);
+         }
+         for (; ATOMIC_LOAD(&self->isExited) == 0u; elapsed++)
+         {
+            if (elapsed >= SCHEDULED_STOP_TIMEOUT)
+            {
+               fprintf(stderr, "[APX_FILE_MANAGER] timeout while waiting for scheduler to stop worker\n");
+               return;
+            }
+            SLEEP(1);
+         }
+      }
+   }
+   for (; ATOMIC_LOAD(&self->isRunningScheduled) != 0u; elapsed++)
+   {
+      if (elapsed >= SCHEDULED_STOP_TIMEOUT)
+      {
+         fprintf(stderr, "[APX_FILE_MANAGER] timeout while waiting for scheduler to leave worker\n");
+         break;
+      }
+      SLEEP(1);
+   }
+}
+
+static int32_t apx_fileManagerWorker_encodeNumHeader(apx_fileManagerWorker_t *self, uint8_t *buf, int32_t msgLen)
+{
+   if (msgLen < 0)
+   {
+      return -1;
+   }
+   if (self->numHeaderSize == 16)
    {
-      return APX_BUFFER_FULL_ERROR;
+      return numheader_encode16(buf, (int32_t) sizeof(uint16_t), (uint16_t) msgLen);
    }
-   return APX_MEM_ERROR;
+   return numheader_encode32(buf, (int32_t) sizeof(uint32_t), (uint32_t) msgLen);
 }
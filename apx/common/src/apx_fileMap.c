@@ -25,12 +25,17 @@
 #define USER_DATA_START      0x20000000 //512MB, this must be a power of 2
 #define USER_DATA_END        0x3FFFFC00 //Start of remote file cmd message area
 #define USER_DATA_BOUNDARY   0x100000u //1MB, this must be a power of 2
+#define FILE_LIST_MIN_ALLOC_LEN 16
 
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
 static int8_t apx_fileMap_autoInsertFile(apx_fileMap_t *self, apx_file_t *pFile, uint32_t start_address, uint32_t end_address, uint32_t address_boundary);
 static int8_t apx_fileMap_insertFileInternal(apx_fileMap_t *self, apx_file_t *pFile);
+static int32_t apx_fileMap_upperBound(const apx_fileMap_t *self, uint32_t address);
+static int32_t apx_fileMap_indexOf(const apx_fileMap_t *self, const apx_file_t *pFile);
+static int8_t apx_fileMap_insertAt(apx_fileMap_t *self, apx_file_t *pFile, int32_t index);
+static void apx_fileMap_removeAt(apx_fileMap_t *self, int32_t index);
 
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
@@ -48,15 +53,26 @@ void apx_fileMap_create(apx_fileMap_t *self)
 {
    if (self != 0)
    {
-      adt_list_create(&self->fileList, apx_file_vdelete);
-      self->lastFile = (apx_file_t*) 0;
+      self->fileList = (apx_file_t**) 0;
+      self->curLen = 0;
+      self->allocLen = 0;
+      self->lastIndex = -1;
    }
 }
 void apx_fileMap_destroy(apx_fileMap_t *self)
 {
    if (self !=0)
    {
-      adt_list_destroy(&self->fileList);
+      int32_t i;
+      for (i = 0; i < self->curLen; i++)
+      {
+         apx_file_delete(self->fileList[i]);
+      }
+      if (self->fileList != 0)
+      {
+         free(self->fileList);
+      }
+      apx_fileMap_create(self);
    }
 }
 
@@ -91,100 +107,95 @@ int8_t apx_fileMap_insertFile(apx_fileMap_t *self, apx_file_t *pFile)
 
 
 /**
- * removes pFile from self->fileList
+ * removes pFile from self->fileList without deleting it
  */
 int8_t apx_fileMap_removeFile(apx_fileMap_t *self, apx_file_t *pFile)
 {
    if ( (self != 0) && (pFile != 0) )
    {
-      //TODO: fix adt_list_remove so that it returns success/failure
-      self->lastFile = (apx_file_t*) 0;
-      adt_list_remove(&self->fileList, pFile);
-      return 0;
+      int32_t index = apx_fileMap_indexOf(self, pFile);
+      if (index >= 0)
+      {
+         apx_fileMap_removeAt(self, index);
+         return 0;
+      }
    }
    return -1;
 }
 
 apx_file_t *apx_fileMap_findByAddress(apx_fileMap_t *self, uint32_t address)
 {
-   apx_file_t *retval=0;
    if (self != 0)
    {
-      if (self->lastFile != 0)
+      uint32_t startAddress;
+      uint32_t endAddress;
+      int32_t index;
+      apx_file_t *pFile;
+      if (self->lastIndex >= 0)
       {
-         uint32_t startAddress;
-         uint32_t endAddress;
-         startAddress = self->lastFile->fileInfo.address & RMF_ADDRESS_MASK_INTERNAL;
-         endAddress = startAddress + self->lastFile->fileInfo.length;
+         assert(self->lastIndex < self->curLen);
+         pFile = self->fileList[self->lastIndex];
+         startAddress = pFile->fileInfo.addressWithoutFlags;
+         endAddress = startAddress + pFile->fileInfo.length;
          if ( (address >= startAddress) && (address < endAddress) )
          {
-            retval = self->lastFile;
+            return pFile;
          }
       }
-      if (retval == 0)
+      //the only file that can contain address is the last one starting at or before it
+      index = apx_fileMap_upperBound(self, address) - 1;
+      if (index >= 0)
       {
-         adt_list_elem_t *pIter = adt_list_iter_first(&self->fileList);
-         while(pIter != 0)
-         {
-            uint32_t startAddress;
-            uint32_t endAddress;
-            apx_file_t *pFile = (apx_file_t*) pIter->pItem;
-            assert(pFile != 0);
-            startAddress = pFile->fileInfo.address & RMF_ADDRESS_MASK_INTERNAL;
-            endAddress = startAddress + pFile->fileInfo.length;
-            if ( (address>=startAddress) && (address<endAddress) )
-            {
-               retval = pFile;
-               break;
-            }
-            pIter = adt_list_iter_next(pIter);
-         }
-         if (retval != 0)
+         pFile = self->fileList[index];
+         startAddress = pFile->fileInfo.addressWithoutFlags;
+         endAddress = startAddress + pFile->fileInfo.length;
+         if (address < endAddress)
          {
-            self->lastFile = retval;
+            self->lastIndex = index;
+            return pFile;
          }
       }
    }
-   return retval;
+   return (apx_file_t*) 0;
 }
 
 apx_file_t *apx_fileMap_findByName(apx_fileMap_t *self, const char *name)
 {
-   apx_file_t *retval=0;
    if (self != 0)
    {
-      adt_list_elem_t *pIter = adt_list_iter_first(&self->fileList);
-      while(pIter != 0)
+      int32_t i;
+      for (i = 0; i < self->curLen; i++)
       {
-         apx_file_t *pFile = (apx_file_t*) pIter->pItem;
+         apx_file_t *pFile = self->fileList[i];
          assert(pFile != 0);
          if ( (strcmp(pFile->fileInfo.name, name)==0) )
          {
-            retval = pFile;
-            break;
+            return pFile;
          }
-         pIter = adt_list_iter_next(pIter);
       }
    }
-   return retval;
+   return (apx_file_t*) 0;
 }
 
 int32_t apx_fileMap_length(const apx_fileMap_t *self)
 {
    if (self != 0)
    {
-      return adt_list_length((adt_list_t*) &self->fileList);
+      return self->curLen;
    }
    return -1;
 }
 
-adt_list_t *apx_fileMap_getList(apx_fileMap_t *self)
+/**
+ * Returns file at index. Files are ordered by address.
+ */
+apx_file_t *apx_fileMap_get(apx_fileMap_t *self, int32_t index)
 {
-   if (self != 0)
+   if ( (self != 0) && (index >= 0) && (index < self->curLen) )
    {
-      return &self->fileList;
+      return self->fileList[index];
    }
-   return (adt_list_t*) 0;
+   return (apx_file_t*) 0;
 }
 
 /**
@@ -195,25 +206,16 @@ void  apx_fileMap_clear_weak(apx_fileMap_t *self)
 {
    if (self != 0)
    {
-      adt_list_destructor_enable(&self->fileList, false);
-      adt_list_clear(&self->fileList);
-      adt_list_destructor_enable(&self->fileList, true);
+      self->curLen = 0;
+      self->lastIndex = -1;
    }
 }
 
 bool apx_fileMap_exist(apx_fileMap_t *self, apx_file_t *file)
 {
-   if (self != 0)
+   if ( (self != 0) && (file != 0) )
    {
-      adt_list_elem_t *pIter = adt_list_iter_first(&self->fileList);
-      while(pIter != 0)
-      {
-         if (file == (apx_file_t*) pIter->pItem)
-         {
-            return true;
-         }
-         pIter = adt_list_iter_next(pIter);
-      }
+      return (apx_fileMap_indexOf(self, file) >= 0)? true : false;
    }
    return false;
 }
@@ -225,12 +227,10 @@ adt_ary_t *apx_fileMap_makeFileInfoArray(apx_fileMap_t *self)
       adt_ary_t *array = adt_ary_new(apx_fileInfo_vdelete);
       if (array != 0)
       {
-         adt_list_elem_t *pIter = adt_list_iter_first(&self->fileList);
-         while(pIter != 0)
+         int32_t i;
+         for (i = 0; i < self->curLen; i++)
          {
-            apx_fileInfo_t *fileInfo;
-            apx_file_t *file = (apx_file_t*) pIter->pItem;
-            fileInfo = apx_fileInfo_clone(&file->fileInfo);
+            apx_fileInfo_t *fileInfo = apx_fileInfo_clone(&self->fileList[i]->fileInfo);
             if (fileInfo == 0)
             {
                adt_ary_delete(array);
@@ -238,7 +238,6 @@ adt_ary_t *apx_fileMap_makeFileInfoArray(apx_fileMap_t *self)
                break;
             }
             adt_ary_push(array, fileInfo);
-            pIter = adt_list_iter_next(pIter);
          }
       }
       return array;
@@ -255,130 +254,134 @@ adt_ary_t *apx_fileMap_makeFileInfoArray(apx_fileMap_t *self)
  */
 static int8_t apx_fileMap_autoInsertFile(apx_fileMap_t *self, apx_file_t *pFile, uint32_t start_address, uint32_t end_address, uint32_t address_boundary)
 {
-   if (adt_list_is_empty(&self->fileList))
+   uint32_t placement_address = start_address;
+   //index of the last file starting before end_address
+   int32_t found = apx_fileMap_upperBound(self, end_address - 1u) - 1;
+   if ( (found >= 0) && (self->fileList[found]->fileInfo.addressWithoutFlags >= start_address) )
    {
-      apx_fileInfo_setAddress(&pFile->fileInfo, start_address);
-   }
-   else
-   {
-      adt_list_elem_t *pIter=0;
-      adt_list_elem_t *pFound=0;
-      uint32_t placement_address = start_address;
-      pIter = adt_list_iter_first(&self->fileList);
-      while(pIter != 0)
+      uint32_t other_end_address;
+      uint32_t other_start_address;
+      apx_file_t *pOther = self->fileList[found];
+      other_start_address=pOther->fileInfo.addressWithoutFlags;
+      other_end_address=other_start_address + pOther->fileInfo.length;
+      //check if address_boundary is a power of two. If not, we need to use another slower method to calculate new placement_address
+      assert(address_boundary != 0);
+      if ((address_boundary & (address_boundary-1)) == 0)
       {
-         apx_file_t *pOther;
-         pOther = (apx_file_t*) pIter->pItem;
-         assert(pOther != 0);
-
-         if( pOther->fileInfo.addressWithoutFlags >= end_address)
-         {
-            break; //we have passed into the next area, break and use latest seen value of pFound
-         }
-         else if(pOther->fileInfo.addressWithoutFlags >= start_address)
-         {
-            pFound = pIter; //update pFound
-         }
-         else
-         {
-            //MISRA
-         }
-         pIter = adt_list_iter_next(pIter);
+         //address_boundary is a power of 2, use faster method
+         placement_address  = (other_end_address + (address_boundary-1)) & (~(address_boundary-1)); //note that address_boundary must be a power of 2 for this code to work
       }
-      if (pFound != 0)
+      else
       {
-         uint32_t other_end_address;
-         uint32_t other_start_address;
-         apx_file_t *pOther = (apx_file_t*) pFound->pItem;
-         assert(pOther != 0);
-         other_start_address=pOther->fileInfo.addressWithoutFlags;
-         other_end_address=other_start_address + pOther->fileInfo.length;
-         //check if address_boundary is a power of two. If not, we need to use another slower method to calculate new placement_address
-         assert(address_boundary != 0);
-         if ((address_boundary & (address_boundary-1)) == 0)
-         {
-            //address_boundary is a power of 2, use faster method
-            placement_address  = (other_end_address + (address_boundary-1)) & (~(address_boundary-1)); //note that address_boundary must be a power of 2 for this code to work
-         }
-         else
-         {
-            //use slower method
-            assert(0); ///TODO: implement this
-         }
+         //use slower method
+         assert(0); ///TODO: implement this
+      }
 
-         if (placement_address >= end_address)
-         {
-            //memory map full, cannot fit any more files into this region
-            errno = ENOMEM;
-            return -1;
-         }
+      if (placement_address >= end_address)
+      {
+         //memory map full, cannot fit any more files into this region
+         errno = ENOMEM;
+         return -1;
       }
-      apx_fileInfo_setAddress(&pFile->fileInfo, placement_address);
    }
+   apx_fileInfo_setAddress(&pFile->fileInfo, placement_address);
    assert(pFile->fileInfo.addressWithoutFlags<RMF_CMD_START_ADDR);
    return apx_fileMap_insertFileInternal(self, pFile);
 }
 
 static int8_t apx_fileMap_insertFileInternal(apx_fileMap_t *self, apx_file_t *pFile)
 {
-   self->lastFile = (apx_file_t*) 0;
-   if (adt_list_is_empty(&self->fileList))
+   uint32_t start_address = pFile->fileInfo.addressWithoutFlags;
+   uint32_t end_address = start_address + pFile->fileInfo.length;
+   int32_t index = apx_fileMap_upperBound(self, start_address);
+   if (index > 0)
+   {
+      //check if there is room to fit this file after the previous file
+      apx_file_t *pLast = self->fileList[index-1];
+      if (pLast->fileInfo.addressWithoutFlags + pLast->fileInfo.length > start_address)
+      {
+         //address collision between pLast and pFile, reject insertion of pFile
+         errno = EADDRINUSE; /* Address already in use */
+         return -1;
+      }
+   }
+   if ( (index < self->curLen) && (end_address > self->fileList[index]->fileInfo.addressWithoutFlags) )
    {
-      adt_list_insert(&self->fileList, pFile);
+      //address collision between next file and pFile, reject insertion of pFile
+      errno = EFBIG; /* File too large */
+      return -1;
    }
-   else
+   return apx_fileMap_insertAt(self, pFile, index);
+}
+
+/**
+ * Returns index of the first file with a start address greater than address (self->curLen if there is none)
+ */
+static int32_t apx_fileMap_upperBound(const apx_fileMap_t *self, uint32_t address)
+{
+   int32_t low = 0;
+   int32_t high = self->curLen;
+   while (low < high)
    {
-      apx_file_t *pLast=0;
-      apx_file_t *pCurrent=0;
-      adt_list_elem_t *pIter = adt_list_iter_first(&self->fileList);
-      while(pIter != 0)
+      int32_t mid = low + ((high - low) / 2);
+      if (self->fileList[mid]->fileInfo.addressWithoutFlags > address)
       {
-         pCurrent = (apx_file_t*) pIter->pItem;
-         assert(pCurrent != 0);
-         if( pCurrent->fileInfo.addressWithoutFlags > pFile->fileInfo.addressWithoutFlags)
-         {
-            //try to fit pFile in before pCurrent;
-            break;
-         }
-         pLast = pCurrent;
-         pIter = adt_list_iter_next(pIter);
+         high = mid;
       }
-      if (pIter != 0)
+      else
       {
-         uint32_t start_address;
-         uint32_t end_address;
-         assert(pCurrent != 0);
-         assert( ((apx_file_t*) pIter->pItem) == pCurrent);
-         if (pLast != 0)
-         {
-            //check if there is room to fit this file between pLast and pFile
-            uint32_t start_address;
-            uint32_t end_address;
-            start_address = pLast->fileInfo.addressWithoutFlags;
-            end_address = start_address+pLast->fileInfo.length;
-            if (end_address > pFile->fileInfo.addressWithoutFlags)
-            {
-               //address collision between pLast and pFile, reject insertion of pFile
-               errno = EADDRINUSE; /* Address already in use */
-               return -1;
-            }
-         }
-         start_address = pFile->fileInfo.addressWithoutFlags;
-         end_address = start_address+pFile->fileInfo.length;
-         if (end_address > pCurrent->fileInfo.addressWithoutFlags)
-         {
-            //address collision between pCurrent and pFile, reject insertion of pFile
-            errno = EFBIG; /* File too large */
-            return -1;
-         }
-         //it should now be safe to insert the file before pIter
-         adt_list_insert_before(&self->fileList, pIter, pFile);
+         low = mid + 1;
       }
-      else
+   }
+   return low;
+}
+
+static int32_t apx_fileMap_indexOf(const apx_fileMap_t *self, const apx_file_t *pFile)
+{
+   //start addresses are unique within the map
+   int32_t index = apx_fileMap_upperBound(self, pFile->fileInfo.addressWithoutFlags) - 1;
+   if ( (index >= 0) && (self->fileList[index] == pFile) )
+   {
+      return index;
+   }
+   return -1;
+}
+
+/**
+ * inserts pFile at index and moves everything at index (and forward) ahead one slot
+ */
+static int8_t apx_fileMap_insertAt(apx_fileMap_t *self, apx_file_t *pFile, int32_t index)
+{
+   assert( (index >= 0) && (index <= self->curLen) );
+   if (self->curLen == self->allocLen)
+   {
+      int32_t allocLen = (self->allocLen == 0)? FILE_LIST_MIN_ALLOC_LEN : self->allocLen * 2;
+      apx_file_t **fileList = (apx_file_t**) realloc(self->fileList, ((size_t) allocLen) * sizeof(apx_file_t*));
+      if (fileList == 0)
       {
-         //insert pFile at end of list
-         adt_list_insert(&self->fileList, pFile);
+         errno = ENOMEM;
+         return -1;
       }
+      self->fileList = fileList;
+      self->allocLen = allocLen;
    }
+   if (index < self->curLen)
+   {
+      memmove(&self->fileList[index+1], &self->fileList[index], ((size_t) (self->curLen - index)) * sizeof(apx_file_t*));
+   }
+   self->fileList[index] = pFile;
+   self->curLen++;
+   self->lastIndex = -1;
    return 0;
 }
+
+static void apx_fileMap_removeAt(apx_fileMap_t *self, int32_t index)
+{
+   assert( (index >= 0) && (index < self->curLen) );
+   if (index < self->curLen - 1)
+   {
+      memmove(&self->fileList[index], &self->fileList[index+1], ((size_t) (self->curLen - index - 1)) * sizeof(apx_file_t*));
+   }
+   self->curLen--;
+   self->lastIndex = -1;
+}
@@ -0,0 +1,433 @@
+/*****************************************************************************
+* \file      apx_mpscRing.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Lock-free multi-producer/single-consumer ring with adaptive consumer wakeup
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <time.h>
+#endif
+#include "apx_mpscRing.h"
+#include "apx_cfg.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define SEQUENCE_SIZE ((uint32_t) sizeof(uint32_t))
+#define SLOT_ALIGNMENT 8u
+
+#ifdef _MSC_VER
+# define ATOMIC_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+# define ATOMIC_STORE(p, v) ((void) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+# define ATOMIC_EXCHANGE(p, v) ((uint32_t) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+# define ATOMIC_CAS(p, expected, desired) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), (LONG) (desired), (LONG) (expected)) == (expected))
+# define ATOMIC_INCREMENT(p) ((void) InterlockedIncrement((volatile LONG*) (p)))
+# define CPU_RELAX() YieldProcessor()
+#else
+# define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define ATOMIC_EXCHANGE(p, v) __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+# define ATOMIC_CAS(p, expected, desired) apx_mpscRing_cas((p), (expected), (desired))
+# define ATOMIC_INCREMENT(p) ((void) __atomic_fetch_add((p), 1u, __ATOMIC_RELAXED))
+# if defined(__i386__) || defined(__x86_64__)
+#  define CPU_RELAX() __builtin_ia32_pause()
+# elif defined(__aarch64__) || defined(__arm__)
+#  define CPU_RELAX() __asm__ __volatile__("yield")
+# else
+#  define CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+# endif
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+#ifndef _MSC_VER
+static bool apx_mpscRing_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired);
+#endif
+static uint8_t *apx_mpscRing_slotAt(apx_mpscRing_t *self, uint32_t pos);
+static bool apx_mpscRing_hasData(apx_mpscRing_t *self);
+static apx_error_t apx_mpscRing_pushOverflow(apx_mpscRing_t *self, const void *elem);
+static void apx_mpscRing_wakeup(apx_mpscRing_t *self);
+static bool apx_mpscRing_semaphoreWait(apx_mpscRing_t *self, uint32_t timeoutMs);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_mpscRing_create(apx_mpscRing_t *self, uint32_t elemSize, uint32_t minCapacity)
+{
+   if ( (self != 0) && (elemSize > 0u) && (elemSize <= UINT8_MAX) && (minCapacity > 0u) && (minCapacity <= 0x80000000u) )
+   {
+      uint32_t i;
+      uint32_t capacity = 1u;
+      while (capacity < minCapacity)
+      {
+         capacity <<= 1;
+      }
+      self->elemSize = elemSize;
+      self->slotSize = ((SEQUENCE_SIZE + elemSize + SLOT_ALIGNMENT - 1u) / SLOT_ALIGNMENT) * SLOT_ALIGNMENT;
+      self->capacity = capacity;
+      self->slots = (uint8_t*) malloc(capacity * self->slotSize);
+      if (self->slots == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      if (adt_rbfh_create(&self->overflow, (uint8_t) elemSize) != BUF_E_OK)
+      {
+         free(self->slots);
+         self->slots = (uint8_t*) 0;
+         return APX_MEM_ERROR;
+      }
+      for (i = 0u; i < capacity; i++)
+      {
+         *((volatile uint32_t*) apx_mpscRing_slotAt(self, i)) = i;
+      }
+      self->tail = 0u;
+      self->head = 0u;
+      self->isParked = 0u;
+      self->isInterrupted = 0u;
+      self->overflowCount = 0u;
+      self->numWakeups = 0u;
+      self->numOverflows = 0u;
+      self->maxDepth = 0u;
+      self->numParks = 0u;
+      SPINLOCK_INIT(self->overflowLock);
+      SEMAPHORE_CREATE(self->semaphore);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_mpscRing_destroy(apx_mpscRing_t *self)
+{
+   if ( (self != 0) && (self->slots != 0) )
+   {
+      free(self->slots);
+      self->slots = (uint8_t*) 0;
+      adt_rbfh_destroy(&self->overflow);
+      SPINLOCK_DESTROY(self->overflowLock);
+      SEMAPHORE_DESTROY(self->semaphore);
+   }
+}
+
+apx_mpscRing_t *apx_mpscRing_new(uint32_t elemSize, uint32_t minCapacity)
+{
+   apx_mpscRing_t *self = (apx_mpscRing_t*) malloc(sizeof(apx_mpscRing_t));
+   if (self != 0)
+   {
+      apx_error_t result = apx_mpscRing_create(self, elemSize, minCapacity);
+      if (result != APX_NO_ERROR)
+      {
+         free(self);
+         self = (apx_mpscRing_t*) 0;
+      }
+   }
+   return self;
+}
+
+void apx_mpscRing_delete(apx_mpscRing_t *self)
+{
+   if (self != 0)
+   {
+      apx_mpscRing_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Copies elemSize bytes from elem into the ring. Safe to call from any number of threads.
+ * The consumer is only signaled (using its semaphore) when it is parked.
+ */
+apx_error_t apx_mpscRing_push(apx_mpscRing_t *self, const void *elem)
+{
+   if ( (self != 0) && (elem != 0) )
+   {
+      uint8_t *slot = (uint8_t*) 0;
+      uint32_t pos;
+      if (ATOMIC_LOAD(&self->overflowCount) > 0u)
+      {
+         //keeps order of elements until the consumer has emptied the overflow queue
+         return apx_mpscRing_pushOverflow(self, elem);
+      }
+      pos = ATOMIC_LOAD(&self->tail);
+      for (;;)
+      {
+         int32_t diff;
+         slot = apx_mpscRing_slotAt(self, pos);
+         diff = (int32_t) (ATOMIC_LOAD((volatile uint32_t*) slot) - pos);
+         if (diff == 0)
+         {
+            if (ATOMIC_CAS(&self->tail, pos, pos + 1u))
+            {
+               break;
+            }
+            pos = ATOMIC_LOAD(&self->tail);
+         }
+         else if (diff < 0)
+         {
+            return apx_mpscRing_pushOverflow(self, elem);
+         }
+         else
+         {
+            pos = ATOMIC_LOAD(&self->tail);
+         }
+      }
+      memcpy(slot + SEQUENCE_SIZE, elem, self->elemSize);
+      ATOMIC_STORE((volatile uint32_t*) slot, pos + 1u);
+      apx_mpscRing_wakeup(self);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Makes apx_mpscRing_wait return false from now on, waking the consumer if it is parked
+ */
+void apx_mpscRing_interrupt(apx_mpscRing_t *self)
+{
+   if (self != 0)
+   {
+      (void) ATOMIC_EXCHANGE(&self->isInterrupted, 1u);
+      apx_mpscRing_wakeup(self);
+   }
+}
+
+/**
+ * Consumer only. Copies the oldest element into elem, returns false when there is nothing to read.
+ * The overflow queue is only read once the ring is empty. A slot that is reserved but not yet published
+ * holds an element that is older than anything in the overflow queue, the consumer must wait for it.
+ */
+bool apx_mpscRing_pop(apx_mpscRing_t *self, void *elem)
+{
+   if ( (self != 0) && (elem != 0) )
+   {
+      uint32_t pos = self->head;
+      uint8_t *slot = apx_mpscRing_slotAt(self, pos);
+      if (ATOMIC_LOAD((volatile uint32_t*) slot) == (pos + 1u))
+      {
+         uint32_t depth = ATOMIC_LOAD(&self->tail) - pos;
+         if (depth > self->maxDepth)
+         {
+            self->maxDepth = depth;
+         }
+         memcpy(elem, slot + SEQUENCE_SIZE, self->elemSize);
+         ATOMIC_STORE((volatile uint32_t*) slot, pos + self->capacity);
+         ATOMIC_STORE(&self->head, pos + 1u);
+         return true;
+      }
+      if ( (ATOMIC_LOAD(&self->tail) == pos) && (ATOMIC_LOAD(&self->overflowCount) > 0u) )
+      {
+         bool retval = false;
+         SPINLOCK_ENTER(self->overflowLock);
+         if (adt_rbfh_remove(&self->overflow, (uint8_t*) elem) == BUF_E_OK)
+         {
+            ATOMIC_STORE(&self->overflowCount, self->overflowCount - 1u);
+            retval = true;
+         }
+         SPINLOCK_LEAVE(self->overflowLock);
+         return retval;
+      }
+   }
+   return false;
+}
+
+/**
+ * Consumer only. Waits until there is something to pop, the timeout expires or the ring is interrupted.
+ * Polls the ring APX_MPSC_RING_SPIN_COUNT times before parking on the semaphore.
+ * Returns true when an element is available.
+ */
+bool apx_mpscRing_wait(apx_mpscRing_t *self, uint32_t timeoutMs)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      for (i = 0u; i < APX_MPSC_RING_SPIN_COUNT; i++)
+      {
+         if (apx_mpscRing_hasData(self))
+         {
+            return true;
+         }
+         if (ATOMIC_LOAD(&self->isInterrupted) != 0u)
+         {
+            return false;
+         }
+         CPU_RELAX();
+      }
+      if (timeoutMs == 0u)
+      {
+         return apx_mpscRing_hasData(self);
+      }
+      (void) ATOMIC_EXCHANGE(&self->isParked, 1u);
+      //A producer that published before isParked was set will not post the semaphore, check again before blocking
+      if ( (!apx_mpscRing_hasData(self)) && (ATOMIC_LOAD(&self->isInterrupted) == 0u) )
+      {
+         self->numParks++;
+         if (apx_mpscRing_semaphoreWait(self, timeoutMs))
+         {
+            return apx_mpscRing_hasData(self);
+         }
+      }
+      if (ATOMIC_EXCHANGE(&self->isParked, 0u) == 0u)
+      {
+         //a producer cleared isParked and is posting the semaphore, consume that post so the next wait does not return early
+         (void) apx_mpscRing_semaphoreWait(self, APX_MPSC_RING_WAIT_FOREVER);
+      }
+      return apx_mpscRing_hasData(self);
+   }
+   return false;
+}
+
+bool apx_mpscRing_isInterrupted(apx_mpscRing_t *self)
+{
+   if (self != 0)
+   {
+      return (ATOMIC_LOAD(&self->isInterrupted) != 0u)? true : false;
+   }
+   return false;
+}
+
+/**
+ * Returns the number of elements waiting to be consumed. Only a snapshot when producers are active.
+ */
+uint32_t apx_mpscRing_length(apx_mpscRing_t *self)
+{
+   if (self != 0)
+   {
+      return (ATOMIC_LOAD(&self->tail) - ATOMIC_LOAD(&self->head)) + ATOMIC_LOAD(&self->overflowCount);
+   }
+   return 0u;
+}
+
+void apx_mpscRing_getStats(apx_mpscRing_t *self, apx_mpscRingStats_t *stats)
+{
+   if ( (self != 0) && (stats != 0) )
+   {
+      stats->depth = apx_mpscRing_length(self);
+      stats->maxDepth = self->maxDepth;
+      stats->numWakeups = ATOMIC_LOAD(&self->numWakeups);
+      stats->numParks = self->numParks;
+      stats->numOverflows = ATOMIC_LOAD(&self->numOverflows);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+#ifndef _MSC_VER
+static bool apx_mpscRing_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired)
+{
+   return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#endif
+
+static uint8_t *apx_mpscRing_slotAt(apx_mpscRing_t *self, uint32_t pos)
+{
+   return self->slots + ((pos & (self->capacity - 1u)) * self->slotSize);
+}
+
+static bool apx_mpscRing_hasData(apx_mpscRing_t *self)
+{
+   uint32_t pos = self->head;
+   if (ATOMIC_LOAD((volatile uint32_t*) apx_mpscRing_slotAt(self, pos)) == (pos + 1u))
+   {
+      return true;
+   }
+   return ( (ATOMIC_LOAD(&self->tail) == pos) && (ATOMIC_LOAD(&self->overflowCount) > 0u) )? true : false;
+}
+
+static apx_error_t apx_mpscRing_pushOverflow(apx_mpscRing_t *self, const void *elem)
+{
+   adt_buf_err_t result;
+   SPINLOCK_ENTER(self->overflowLock);
+   result = adt_rbfh_insert(&self->overflow, (const uint8_t*) elem);
+   if (result == BUF_E_OK)
+   {
+      ATOMIC_STORE(&self->overflowCount, self->overflowCount + 1u);
+   }
+   SPINLOCK_LEAVE(self->overflowLock);
+   if (result != BUF_E_OK)
+   {
+      return (result == BUF_E_OVERFLOW)? APX_BUFFER_FULL_ERROR : APX_MEM_ERROR;
+   }
+   ATOMIC_INCREMENT(&self->numOverflows);
+   apx_mpscRing_wakeup(self);
+   return APX_NO_ERROR;
+}
+
+/**
+ * Posts the semaphore only if the consumer is parked. The exchange guarantees a single post per park.
+ */
+static void apx_mpscRing_wakeup(apx_mpscRing_t *self)
+{
+   if (ATOMIC_EXCHANGE(&self->isParked, 0u) != 0u)
+   {
+      ATOMIC_INCREMENT(&self->numWakeups);
+      SEMAPHORE_POST(self->semaphore);
+   }
+}
+
+static bool apx_mpscRing_semaphoreWait(apx_mpscRing_t *self, uint32_t timeoutMs)
+{
+#ifdef _MSC_VER
+   DWORD timeout = (timeoutMs == APX_MPSC_RING_WAIT_FOREVER)? INFINITE : (DWORD) timeoutMs;
+   return (WaitForSingleObject(self->semaphore, timeout) == WAIT_OBJECT_0)? true : false;
+#else
+   int result;
+   if (timeoutMs == APX_MPSC_RING_WAIT_FOREVER)
+   {
+      do
+      {
+         result = sem_wait(&self->semaphore);
+      } while ( (result != 0) && (errno == EINTR) );
+   }
+   else
+   {
+      struct timespec deadline;
+      clock_gettime(CLOCK_REALTIME, &deadline);
+      deadline.tv_sec += (time_t) (timeoutMs / 1000u);
+      deadline.tv_nsec += (long) (timeoutMs % 1000u) * 1000000L;
+      if (deadline.tv_nsec >= 1000000000L)
+      {
+         deadline.tv_sec++;
+         deadline.tv_nsec -= 1000000000L;
+      }
+      do
+      {
+         result = sem_timedwait(&self->semaphore, &deadline);
+      } while ( (result != 0) && (errno == EINTR) );
+   }
+   return (result == 0)? true : false;
+#endif
+}
@@ -38,10 +38,44 @@
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#ifndef APX_EMBEDDED
+/*
+ * Port data buffers are protected by seqlocks. Writers serialize among themselves using the port data spinlock,
+ * make the sequence counter odd, copy and make it even again. Readers never take a lock, they copy the data
+ * and start over if the sequence counter was odd or changed while they were copying.
+ */
+# ifdef _MSC_VER
+#  define SEQUENCE_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+#  define SEQUENCE_STORE(p, v) ((void) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+#  define SEQUENCE_READ_FENCE() MemoryBarrier()
+#  define SEQUENCE_WRITE_FENCE() MemoryBarrier()
+#  define CPU_RELAX() YieldProcessor()
+# else
+#  define SEQUENCE_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#  define SEQUENCE_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#  define SEQUENCE_READ_FENCE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#  define SEQUENCE_WRITE_FENCE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#  if defined(__i386__) || defined(__x86_64__)
+#   define CPU_RELAX() __builtin_ia32_pause()
+#  elif defined(__aarch64__) || defined(__arm__)
+#   define CPU_RELAX() __asm__ __volatile__("yield")
+#  else
+#   define CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+#  endif
+# endif
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
+#ifndef APX_EMBEDDED
+static uint32_t apx_nodeData_readBegin(volatile uint32_t *sequence);
+static bool apx_nodeData_readRetry(volatile uint32_t *sequence, uint32_t start);
+static void apx_nodeData_writeBegin(volatile uint32_t *sequence);
+static void apx_nodeData_writeEnd(volatile uint32_t *sequence);
+#endif
+static apx_error_t apx_nodeData_writeProvidePortDataInternal(apx_nodeData_t *self, apx_portId_t portId, const uint8_t *src, apx_nodeData_packFunc *packFunc,
+      void *packArg, uint32_t offset, apx_size_t len, apx_nodeData_forwardFunc *forwardFunc, void *forwardArg, bool *isForwarded);
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -88,6 +122,9 @@ void apx_nodeData_create(apx_nodeData_t *self, apx_nodeDataBuffers_t *buffers)
          self->definitionChecksumType = APX_CHECKSUM_NONE;
          memset(&self->definitionChecksumData[0], 0, APX_CHECKSUMLEN_SHA256);
       }
+      self->providePortWriteFilters = (apx_portWriteFilter_t*) 0;
+      self->providePortPackBuf = (uint8_t*) 0;
+      self->providePortPackBufLen = 0u;
       self->portConnectionsTotal  = 0u;
       self->parent = (apx_nodeInstance_t*) 0;
 #ifndef APX_EMBEDDED
@@ -95,6 +132,8 @@ void apx_nodeData_create(apx_nodeData_t *self, apx_nodeDataBuffers_t *buffers)
       SPINLOCK_INIT(self->providePortDataLock);
       SPINLOCK_INIT(self->definitionDataLock);
       SPINLOCK_INIT(self->internalLock);
+      self->requirePortDataSequence = 0u;
+      self->providePortDataSequence = 0u;
 #endif
    }
 }
@@ -126,6 +165,14 @@ void apx_nodeData_destroy(apx_nodeData_t *self)
          {
             free(self->providePortConnectionCount);
          }
+         if (self->providePortWriteFilters != 0)
+         {
+            free(self->providePortWriteFilters);
+         }
+         if (self->providePortPackBuf != 0)
+         {
+            free(self->providePortPackBuf);
+         }
       }
       SPINLOCK_DESTROY(self->requirePortDataLock);
       SPINLOCK_DESTROY(self->providePortDataLock);
@@ -337,20 +384,22 @@ apx_error_t apx_nodeData_writeRequirePortData(apx_nodeData_t *self, const uint8_
    apx_error_t retval = APX_NO_ERROR;
    if (self != 0)
    {
-#ifndef APX_EMBEDDED
-   SPINLOCK_ENTER(self->requirePortDataLock);
-#endif
    if ( (offset+len) > self->requirePortDataLen)
    {
       retval = APX_INVALID_ARGUMENT_ERROR;
    }
    else
    {
+#ifndef APX_EMBEDDED
+      SPINLOCK_ENTER(self->requirePortDataLock);
+      apx_nodeData_writeBegin(&self->requirePortDataSequence);
+#endif
       memcpy(&self->requirePortDataBuf[offset], src, len);
-   }
 #ifndef APX_EMBEDDED
-   SPINLOCK_LEAVE(self->requirePortDataLock);
+      apx_nodeData_writeEnd(&self->requirePortDataSequence);
+      SPINLOCK_LEAVE(self->requirePortDataLock);
 #endif
+   }
    }
    else
    {
@@ -364,20 +413,58 @@ apx_error_t apx_nodeData_readRequirePortData(apx_nodeData_t *self, uint8_t *dest
    apx_error_t retval = APX_NO_ERROR;
    if( (self != 0) && (dest != 0) )
    {
-#ifndef APX_EMBEDDED
-      SPINLOCK_ENTER(self->requirePortDataLock);
-#endif
       if ( (offset+len) > self->requirePortDataLen)
       {
          retval = APX_INVALID_ARGUMENT_ERROR;
       }
       else
       {
+#ifndef APX_EMBEDDED
+         uint32_t sequence;
+         do
+         {
+            sequence = apx_nodeData_readBegin(&self->requirePortDataSequence);
+            memcpy(dest, &self->requirePortDataBuf[offset], len);
+         } while (apx_nodeData_readRetry(&self->requirePortDataSequence, sequence));
+#else
          memcpy(dest, &self->requirePortDataBuf[offset], len);
+#endif
+      }
+   }
+   else
+   {
+      retval = APX_INVALID_ARGUMENT_ERROR;
+   }
+   return retval;
+}
+
+/**
+ * Lets unpackFunc read require-port data straight from the buffer, without copying it first.
+ * unpackFunc runs again when a writer changed the data while it was reading (seqlock retry), it must therefore only
+ * write to memory owned by the caller and must not assume that a previous call saw consistent data.
+ */
+apx_error_t apx_nodeData_unpackRequirePortData(apx_nodeData_t *self, uint32_t offset, apx_size_t len, apx_nodeData_unpackFunc *unpackFunc, void *unpackArg)
+{
+   apx_error_t retval = APX_NO_ERROR;
+   if( (self != 0) && (unpackFunc != 0) )
+   {
+      if ( (offset+len) > self->requirePortDataLen)
+      {
+         retval = APX_INVALID_ARGUMENT_ERROR;
       }
+      else
+      {
 #ifndef APX_EMBEDDED
-      SPINLOCK_LEAVE(self->requirePortDataLock);
+         uint32_t sequence;
+         do
+         {
+            sequence = apx_nodeData_readBegin(&self->requirePortDataSequence);
+            unpackFunc(unpackArg, &self->requirePortDataBuf[offset], len);
+         } while (apx_nodeData_readRetry(&self->requirePortDataSequence, sequence));
+#else
+         unpackFunc(unpackArg, &self->requirePortDataBuf[offset], len);
 #endif
+      }
    }
    else
    {
@@ -418,20 +505,22 @@ apx_error_t apx_nodeData_writeProvidePortData(apx_nodeData_t *self, const uint8_
    apx_error_t retval = APX_NO_ERROR;
    if (self != 0)
    {
-#ifndef APX_EMBEDDED
-   SPINLOCK_ENTER(self->providePortDataLock);
-#endif
    if ( (offset+len) > self->providePortDataLen)
    {
       retval = APX_INVALID_ARGUMENT_ERROR;
    }
    else
    {
+#ifndef APX_EMBEDDED
+      SPINLOCK_ENTER(self->providePortDataLock);
+      apx_nodeData_writeBegin(&self->providePortDataSequence);
+#endif
       memcpy(&self->providePortDataBuf[offset], src, len);
-   }
 #ifndef APX_EMBEDDED
-   SPINLOCK_LEAVE(self->providePortDataLock);
+      apx_nodeData_writeEnd(&self->providePortDataSequence);
+      SPINLOCK_LEAVE(self->providePortDataLock);
 #endif
+   }
    }
    else
    {
@@ -445,20 +534,23 @@ apx_error_t apx_nodeData_readProvidePortData(apx_nodeData_t *self, uint8_t *dest
    apx_error_t retval = APX_NO_ERROR;
    if( (self != 0) && (dest != 0) )
    {
-#ifndef APX_EMBEDDED
-      SPINLOCK_ENTER(self->providePortDataLock);
-#endif
       if ( (offset+len) > self->providePortDataLen)
       {
          retval = APX_INVALID_ARGUMENT_ERROR;
       }
       else
       {
-         memcpy(dest, &self->providePortDataBuf[offset], len);
-      }
 #ifndef APX_EMBEDDED
-      SPINLOCK_LEAVE(self->providePortDataLock);
+         uint32_t sequence;
+         do
+         {
+            sequence = apx_nodeData_readBegin(&self->providePortDataSequence);
+            memcpy(dest, &self->providePortDataBuf[offset], len);
+         } while (apx_nodeData_readRetry(&self->providePortDataSequence, sequence));
+#else
+         memcpy(dest, &self->providePortDataBuf[offset], len);
 #endif
+      }
    }
    else
    {
@@ -480,15 +572,19 @@ apx_error_t apx_nodeData_updatePortDataDirect(apx_nodeData_t *destNodeData, cons
          assert(destNodeData->requirePortDataBuf != 0);
          assert(srcNodeData->providePortDataBuf != 0);
 #ifndef APX_EMBEDDED
+         //Only the destination is written, the source is read like any other reader without blocking its writer
+         uint32_t sequence;
          SPINLOCK_ENTER(destNodeData->requirePortDataLock);
-         SPINLOCK_ENTER(srcNodeData->providePortDataLock);
-#endif
-
-         memcpy(&destNodeData->requirePortDataBuf[destDatProps->offset], &srcNodeData->providePortDataBuf[srcDataProps->offset], srcDataProps->dataSize);
-
-#ifndef APX_EMBEDDED
-         SPINLOCK_LEAVE(srcNodeData->providePortDataLock);
+         apx_nodeData_writeBegin(&destNodeData->requirePortDataSequence);
+         do
+         {
+            sequence = apx_nodeData_readBegin(&srcNodeData->providePortDataSequence);
+            memcpy(&destNodeData->requirePortDataBuf[destDatProps->offset], &srcNodeData->providePortDataBuf[srcDataProps->offset], srcDataProps->dataSize);
+         } while (apx_nodeData_readRetry(&srcNodeData->providePortDataSequence, sequence));
+         apx_nodeData_writeEnd(&destNodeData->requirePortDataSequence);
          SPINLOCK_LEAVE(destNodeData->requirePortDataLock);
+#else
+         memcpy(&destNodeData->requirePortDataBuf[destDatProps->offset], &srcNodeData->providePortDataBuf[srcDataProps->offset], srcDataProps->dataSize);
 #endif
          return APX_NO_ERROR;
       }
@@ -520,6 +616,121 @@ struct apx_nodeInstance_tag *apx_nodeData_getNodeInstance(apx_nodeData_t *self)
    return (struct apx_nodeInstance_tag*) 0;
 }
 
+////////////////// Provide-port Write Filter API //////////////////
+
+#ifndef APX_EMBEDDED
+apx_error_t apx_nodeData_createProvidePortWriteFilterBuffer(apx_nodeData_t *self, apx_portCount_t numProvidePorts)
+{
+   if (self != 0)
+   {
+      apx_portId_t portId;
+      apx_portWriteFilter_t *writeFilters = (apx_portWriteFilter_t*) malloc(numProvidePorts*sizeof(apx_portWriteFilter_t));
+      if (writeFilters == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      for (portId = 0; portId < numProvidePorts; portId++)
+      {
+         apx_portWriteFilter_create(&writeFilters[portId]);
+      }
+      self->providePortWriteFilters = writeFilters;
+      self->numProvidePorts = numProvidePorts;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * bufferLen shall be the data size of the largest provide-port
+ */
+apx_error_t apx_nodeData_createProvidePortPackBuffer(apx_nodeData_t *self, apx_size_t bufferLen)
+{
+   if ( (self != 0) && (bufferLen > 0u) )
+   {
+      uint8_t *packBuf = (uint8_t*) malloc(bufferLen);
+      if (packBuf == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      self->providePortPackBuf = packBuf;
+      self->providePortPackBufLen = bufferLen;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+#endif //APX_EMBEDDED
+
+apx_error_t apx_nodeData_setProvidePortWriteMode(apx_nodeData_t *self, apx_portId_t portId, apx_portWriteMode_t mode, uint32_t heartbeatInterval)
+{
+   if ( (self != 0) && (portId >= 0) && (portId < self->numProvidePorts) &&
+        ( (mode == APX_PORT_WRITE_MODE_ALWAYS) || (mode == APX_PORT_WRITE_MODE_ON_CHANGE) ) )
+   {
+      uint32_t now = apx_portWriteFilter_getTickCount();
+      if (self->providePortWriteFilters == 0)
+      {
+         return APX_NULL_PTR_ERROR;
+      }
+#ifndef APX_EMBEDDED
+      SPINLOCK_ENTER(self->providePortDataLock);
+#endif
+      apx_portWriteFilter_setMode(&self->providePortWriteFilters[portId], mode, heartbeatInterval, now);
+#ifndef APX_EMBEDDED
+      SPINLOCK_LEAVE(self->providePortDataLock);
+#endif
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Writes data of a single provide-port and runs it through the write filter of that port.
+ * In on-change mode the compare and the copy happen under the same lock, unchanged data leaves the buffer untouched.
+ * When the write shall be forwarded to the remote side, forwardFunc (optional) is called before the lock is released.
+ * Two writers of the same port can therefore never forward in the opposite order of their writes, which in on-change mode
+ * would leave the remote side with a stale value that no later (identical) write corrects.
+ * isForwarded (optional) is set to true when the write was forwarded.
+ */
+apx_error_t apx_nodeData_writeProvidePortDataFiltered(apx_nodeData_t *self, apx_portId_t portId, const uint8_t *src, uint32_t offset, apx_size_t len,
+      apx_nodeData_forwardFunc *forwardFunc, void *forwardArg, bool *isForwarded)
+{
+   if ( (self != 0) && (src != 0) )
+   {
+      return apx_nodeData_writeProvidePortDataInternal(self, portId, src, (apx_nodeData_packFunc*) 0, (void*) 0, offset, len, forwardFunc, forwardArg, isForwarded);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Same as apx_nodeData_writeProvidePortDataFiltered except that packFunc produces the new port data.
+ * It is called under providePortDataLock and packs into a scratch buffer owned by this object (see apx_nodeData_createProvidePortPackBuffer),
+ * callers converting C values into port data therefore need no buffer of their own, however large the port.
+ */
+apx_error_t apx_nodeData_packProvidePortDataFiltered(apx_nodeData_t *self, apx_portId_t portId, uint32_t offset, apx_size_t len,
+      apx_nodeData_packFunc *packFunc, void *packArg, apx_nodeData_forwardFunc *forwardFunc, void *forwardArg)
+{
+   if ( (self != 0) && (packFunc != 0) )
+   {
+      return apx_nodeData_writeProvidePortDataInternal(self, portId, (const uint8_t*) 0, packFunc, packArg, offset, len, forwardFunc, forwardArg, (bool*) 0);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+uint32_t apx_nodeData_getProvidePortSuppressedWriteCount(apx_nodeData_t *self, apx_portId_t portId)
+{
+   uint32_t retval = 0u;
+   if ( (self != 0) && (self->providePortWriteFilters != 0) && (portId >= 0) && (portId < self->numProvidePorts) )
+   {
+#ifndef APX_EMBEDDED
+      SPINLOCK_ENTER(self->providePortDataLock);
+#endif
+      retval = self->providePortWriteFilters[portId].numSuppressedWrites;
+#ifndef APX_EMBEDDED
+      SPINLOCK_LEAVE(self->providePortDataLock);
+#endif
+   }
+   return retval;
+}
+
 ////////////////// Port Connection Count API //////////////////
 #ifndef APX_EMBEDDED
 apx_error_t apx_nodeData_createRequirePortConnectionCountBuffer(apx_nodeData_t *self, apx_portCount_t numRequirePorts)
@@ -686,5 +897,133 @@ uint32_t apx_nodeData_getConnectionId(apx_nodeData_t *self)
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
+#ifndef APX_EMBEDDED
+/**
+ * Waits until no write is in progress and returns the sequence number the read started at
+ */
+static uint32_t apx_nodeData_readBegin(volatile uint32_t *sequence)
+{
+   uint32_t start = SEQUENCE_LOAD(sequence);
+   while ( (start & 1u) != 0u)
+   {
+      CPU_RELAX();
+      start = SEQUENCE_LOAD(sequence);
+   }
+   return start;
+}
 
+/**
+ * Returns true when a writer touched the buffer since readBegin, the data just read must then be read again
+ */
+static bool apx_nodeData_readRetry(volatile uint32_t *sequence, uint32_t start)
+{
+   SEQUENCE_READ_FENCE();
+   return (SEQUENCE_LOAD(sequence) != start);
+}
+
+/**
+ * Caller must hold the write lock of the buffer
+ */
+static void apx_nodeData_writeBegin(volatile uint32_t *sequence)
+{
+   *sequence = *sequence + 1u;
+   SEQUENCE_WRITE_FENCE();
+}
+
+static void apx_nodeData_writeEnd(volatile uint32_t *sequence)
+{
+   SEQUENCE_STORE(sequence, *sequence + 1u);
+}
+#endif
 
+/**
+ * Exactly one of src and packFunc is set. With packFunc, the data is packed into providePortPackBuf while the lock is held.
+ */
+static apx_error_t apx_nodeData_writeProvidePortDataInternal(apx_nodeData_t *self, apx_portId_t portId, const uint8_t *src, apx_nodeData_packFunc *packFunc,
+      void *packArg, uint32_t offset, apx_size_t len, apx_nodeData_forwardFunc *forwardFunc, void *forwardArg, bool *isForwarded)
+{
+   apx_error_t retval = APX_NO_ERROR;
+   if (portId >= 0)
+   {
+      apx_portWriteFilter_t *writeFilter = 0;
+      uint32_t now = 0u;
+      bool isForwardNeeded = false;
+      if ( (self->providePortWriteFilters != 0) && (portId < self->numProvidePorts) )
+      {
+         writeFilter = &self->providePortWriteFilters[portId];
+         if (writeFilter->mode == APX_PORT_WRITE_MODE_ALWAYS)
+         {
+            writeFilter = 0; //Skip the compare when the port has not opted in
+         }
+         else
+         {
+            now = apx_portWriteFilter_getTickCount();
+         }
+      }
+#ifndef APX_EMBEDDED
+      SPINLOCK_ENTER(self->providePortDataLock);
+#endif
+      if ( (offset+len) > self->providePortDataLen)
+      {
+         retval = APX_INVALID_ARGUMENT_ERROR;
+      }
+      else if ( (packFunc != 0) && ( (self->providePortPackBuf == 0) || (len > self->providePortPackBufLen) ) )
+      {
+         retval = APX_BUFFER_BOUNDARY_ERROR;
+      }
+      else if (writeFilter == 0)
+      {
+         if (packFunc != 0)
+         {
+            packFunc(packArg, self->providePortPackBuf, len);
+            src = self->providePortPackBuf;
+         }
+#ifndef APX_EMBEDDED
+         apx_nodeData_writeBegin(&self->providePortDataSequence);
+#endif
+         memcpy(&self->providePortDataBuf[offset], src, len);
+#ifndef APX_EMBEDDED
+         apx_nodeData_writeEnd(&self->providePortDataSequence);
+#endif
+         isForwardNeeded = true;
+      }
+      else
+      {
+         //Writers are serialized by the lock, the compare sees the latest data without a sequence check
+         bool isChanged;
+         if (packFunc != 0)
+         {
+            packFunc(packArg, self->providePortPackBuf, len);
+            src = self->providePortPackBuf;
+         }
+         isChanged = (memcmp(&self->providePortDataBuf[offset], src, len) != 0);
+         if (isChanged)
+         {
+#ifndef APX_EMBEDDED
+            apx_nodeData_writeBegin(&self->providePortDataSequence);
+#endif
+            memcpy(&self->providePortDataBuf[offset], src, len);
+#ifndef APX_EMBEDDED
+            apx_nodeData_writeEnd(&self->providePortDataSequence);
+#endif
+         }
+         isForwardNeeded = apx_portWriteFilter_update(writeFilter, isChanged, now);
+      }
+      if ( isForwardNeeded && (forwardFunc != 0) )
+      {
+         retval = forwardFunc(forwardArg, src, offset, len);
+      }
+#ifndef APX_EMBEDDED
+      SPINLOCK_LEAVE(self->providePortDataLock);
+#endif
+      if (isForwarded != 0)
+      {
+         *isForwarded = isForwardNeeded;
+      }
+   }
+   else
+   {
+      retval = APX_INVALID_ARGUMENT_ERROR;
+   }
+   return retval;
+}
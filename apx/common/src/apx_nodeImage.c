@@ -0,0 +1,563 @@
+/*****************************************************************************
+* \file      apx_nodeImage.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Versioned binary image of a compiled node, stored on disk next to (instead of) its text definition
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+#include "apx_nodeImage.h"
+#include "apx_sha256.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define MAGIC_OFFSET 0u
+#define VERSION_OFFSET 4u
+#define HEADER_SIZE_OFFSET 6u
+#define DEFINITION_LEN_OFFSET 8u
+#define NUM_REQUIRE_PORTS_OFFSET 12u
+#define NUM_PROVIDE_PORTS_OFFSET 16u
+#define BODY_LEN_OFFSET 20u
+#define DEFINITION_DIGEST_OFFSET 24u
+#define BODY_DIGEST_OFFSET 56u
+
+static const uint8_t m_magic[4] = {'A', 'P', 'X', 'I'};
+
+typedef struct apx_nodeImageReader_tag
+{
+   const uint8_t *next;
+   const uint8_t *end;
+} apx_nodeImageReader_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_nodeImage_appendBlob(adt_bytearray_t *image, const uint8_t *data, uint32_t dataLen);
+static apx_error_t apx_nodeImage_appendBytes(adt_bytearray_t *image, const adt_bytes_t *bytes);
+static apx_error_t apx_nodeImage_appendString(adt_bytearray_t *image, const char *str);
+static apx_error_t apx_nodeImage_appendPorts(adt_bytearray_t *image, adt_bytes_t **packPrograms, adt_bytes_t **unpackPrograms, char **portSignatures, apx_portCount_t numPorts);
+static apx_error_t apx_nodeImage_readHeader(const uint8_t *imageData, size_t imageLen, const uint8_t *definitionDigest, uint32_t definitionLen, uint32_t *numRequirePorts, uint32_t *numProvidePorts);
+static apx_error_t apx_nodeImage_readBody(apx_nodeInfo_t *nodeInfo, apx_nodeImageReader_t *reader);
+static apx_error_t apx_nodeImage_readPorts(apx_nodeImageReader_t *reader, adt_bytes_t **packPrograms, adt_bytes_t **unpackPrograms, char **portSignatures, apx_portCount_t numPorts);
+static apx_error_t apx_nodeImage_readBlob(apx_nodeImageReader_t *reader, const uint8_t **data, uint32_t *dataLen);
+static apx_error_t apx_nodeImage_readBytes(apx_nodeImageReader_t *reader, adt_bytes_t **bytes);
+static apx_error_t apx_nodeImage_readString(apx_nodeImageReader_t *reader, char **str);
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Appends the image of nodeInfo to image. definitionDigest is the SHA256 of the text definition nodeInfo was built from.
+ */
+apx_error_t apx_nodeImage_write(adt_bytearray_t *image, const apx_nodeInfo_t *nodeInfo, const uint8_t *definitionDigest, uint32_t definitionLen)
+{
+   if ( (image != 0) && (nodeInfo != 0) && (definitionDigest != 0) && (nodeInfo->name != 0) )
+   {
+      uint8_t header[APX_NODE_IMAGE_HEADER_SIZE];
+      uint32_t headerStart = adt_bytearray_length(image);
+      uint32_t bodyStart;
+      uint8_t *imageHeader;
+      apx_error_t rc;
+      memset(&header[0], 0, sizeof(header));
+      if (adt_bytearray_append(image, &header[0], (uint32_t) sizeof(header)) != ADT_NO_ERROR)
+      {
+         return APX_MEM_ERROR;
+      }
+      bodyStart = adt_bytearray_length(image);
+      rc = apx_nodeImage_appendString(image, nodeInfo->name);
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_appendPorts(image, nodeInfo->requirePortPackPrograms, nodeInfo->requirePortUnpackPrograms, nodeInfo->requirePortSignatures, nodeInfo->numRequirePorts);
+      }
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_appendPorts(image, nodeInfo->providePortPackPrograms, nodeInfo->providePortUnpackPrograms, nodeInfo->providePortSignatures, nodeInfo->numProvidePorts);
+      }
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_appendBytes(image, nodeInfo->requirePortInitData);
+      }
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_appendBytes(image, nodeInfo->providePortInitData);
+      }
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+      imageHeader = adt_bytearray_data(image) + headerStart;
+      memcpy(&imageHeader[MAGIC_OFFSET], &m_magic[0], sizeof(m_magic));
+      packLE(&imageHeader[VERSION_OFFSET], APX_NODE_IMAGE_VERSION, UINT16_SIZE);
+      packLE(&imageHeader[HEADER_SIZE_OFFSET], APX_NODE_IMAGE_HEADER_SIZE, UINT16_SIZE);
+      packLE(&imageHeader[DEFINITION_LEN_OFFSET], definitionLen, UINT32_SIZE);
+      packLE(&imageHeader[NUM_REQUIRE_PORTS_OFFSET], (uint32_t) nodeInfo->numRequirePorts, UINT32_SIZE);
+      packLE(&imageHeader[NUM_PROVIDE_PORTS_OFFSET], (uint32_t) nodeInfo->numProvidePorts, UINT32_SIZE);
+      packLE(&imageHeader[BODY_LEN_OFFSET], adt_bytearray_length(image) - bodyStart, UINT32_SIZE);
+      memcpy(&imageHeader[DEFINITION_DIGEST_OFFSET], definitionDigest, APX_SHA256_DIGEST_SIZE);
+      apx_sha256_calc(adt_bytearray_data(image) + bodyStart, adt_bytearray_length(image) - bodyStart, &imageHeader[BODY_DIGEST_OFFSET]);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Creates a nodeInfo from an image without parsing or compiling anything.
+ * Returns NULL when the image is damaged, has an unsupported version or wasn't compiled from the definition with the given digest.
+ */
+apx_nodeInfo_t *apx_nodeImage_read(const uint8_t *imageData, size_t imageLen, const uint8_t *definitionDigest, uint32_t definitionLen, apx_mode_t mode, apx_error_t *errorCode)
+{
+   apx_nodeInfo_t *nodeInfo = (apx_nodeInfo_t*) 0;
+   apx_error_t rc = APX_INVALID_ARGUMENT_ERROR;
+   if ( (imageData != 0) && (definitionDigest != 0) )
+   {
+      uint32_t numRequirePorts = 0u;
+      uint32_t numProvidePorts = 0u;
+      rc = apx_nodeImage_readHeader(imageData, imageLen, definitionDigest, definitionLen, &numRequirePorts, &numProvidePorts);
+      if (rc == APX_NO_ERROR)
+      {
+         nodeInfo = apx_nodeInfo_new();
+         if (nodeInfo == 0)
+         {
+            rc = APX_MEM_ERROR;
+         }
+         else
+         {
+            rc = apx_nodeInfo_prepareLoad(nodeInfo, mode, (apx_portCount_t) numRequirePorts, (apx_portCount_t) numProvidePorts);
+            if (rc == APX_NO_ERROR)
+            {
+               apx_nodeImageReader_t reader;
+               reader.next = imageData + APX_NODE_IMAGE_HEADER_SIZE;
+               reader.end = reader.next + unpackLE(&imageData[BODY_LEN_OFFSET], UINT32_SIZE);
+               rc = apx_nodeImage_readBody(nodeInfo, &reader);
+            }
+            if (rc == APX_NO_ERROR)
+            {
+               rc = apx_nodeInfo_completeLoad(nodeInfo);
+            }
+            if (rc != APX_NO_ERROR)
+            {
+               apx_nodeInfo_release(nodeInfo);
+               nodeInfo = (apx_nodeInfo_t*) 0;
+            }
+         }
+      }
+   }
+   if (errorCode != 0)
+   {
+      *errorCode = rc;
+   }
+   return nodeInfo;
+}
+
+/**
+ * Writes the image to a temporary file and renames it into place, so readers never see a partially written image.
+ */
+apx_error_t apx_nodeImage_saveFile(const char *path, const apx_nodeInfo_t *nodeInfo, const uint8_t *definitionDigest, uint32_t definitionLen)
+{
+   if ( (path != 0) && (nodeInfo != 0) && (definitionDigest != 0) )
+   {
+      adt_bytearray_t image;
+      apx_error_t rc;
+      adt_bytearray_create(&image, ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+      rc = apx_nodeImage_write(&image, nodeInfo, definitionDigest, definitionLen);
+      if (rc == APX_NO_ERROR)
+      {
+         size_t pathLen = strlen(path);
+         char *tmpPath = (char*) malloc(pathLen + 5u);
+         if (tmpPath != 0)
+         {
+            FILE *fh;
+            memcpy(tmpPath, path, pathLen);
+            memcpy(tmpPath + pathLen, ".tmp", 5u);
+            fh = fopen(tmpPath, "wb");
+            if (fh != 0)
+            {
+               size_t imageLen = (size_t) adt_bytearray_length(&image);
+               size_t written = fwrite(adt_bytearray_constData(&image), 1u, imageLen, fh);
+               if ( (fclose(fh) != 0) || (written != imageLen) )
+               {
+                  rc = APX_INVALID_WRITE_ERROR;
+               }
+#ifdef _WIN32
+               else if (MoveFileExA(tmpPath, path, MOVEFILE_REPLACE_EXISTING) == 0)
+#else
+               else if (rename(tmpPath, path) != 0)
+#endif
+               {
+                  rc = APX_INVALID_WRITE_ERROR;
+               }
+               if (rc != APX_NO_ERROR)
+               {
+                  remove(tmpPath);
+               }
+            }
+            else
+            {
+               rc = APX_FILE_NOT_OPEN_ERROR;
+            }
+            free(tmpPath);
+         }
+         else
+         {
+            rc = APX_MEM_ERROR;
+         }
+      }
+      adt_bytearray_destroy(&image);
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Maps the image file read-only into memory and creates a nodeInfo from it (see apx_nodeImage_read).
+ * errorCode is set to APX_FILE_NOT_FOUND_ERROR when there is no image at path.
+ */
+apx_nodeInfo_t *apx_nodeImage_loadFile(const char *path, const uint8_t *definitionDigest, uint32_t definitionLen, apx_mode_t mode, apx_error_t *errorCode)
+{
+   apx_nodeInfo_t *nodeInfo = (apx_nodeInfo_t*) 0;
+   apx_error_t rc = APX_INVALID_ARGUMENT_ERROR;
+   if ( (path != 0) && (definitionDigest != 0) )
+   {
+#ifdef _WIN32
+      HANDLE fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+      rc = APX_FILE_NOT_FOUND_ERROR;
+      if (fileHandle != INVALID_HANDLE_VALUE)
+      {
+         LARGE_INTEGER fileSize;
+         rc = APX_READ_ERROR;
+         if (GetFileSizeEx(fileHandle, &fileSize) != 0)
+         {
+            if (fileSize.QuadPart >= (LONGLONG) APX_NODE_IMAGE_HEADER_SIZE)
+            {
+               HANDLE mappingHandle = CreateFileMappingA(fileHandle, 0, PAGE_READONLY, 0, 0, 0);
+               if (mappingHandle != 0)
+               {
+                  const uint8_t *imageData = (const uint8_t*) MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+                  if (imageData != 0)
+                  {
+                     nodeInfo = apx_nodeImage_read(imageData, (size_t) fileSize.QuadPart, definitionDigest, definitionLen, mode, &rc);
+                     UnmapViewOfFile(imageData);
+                  }
+                  CloseHandle(mappingHandle);
+               }
+            }
+            else
+            {
+               rc = APX_INVALID_FILE_ERROR;
+            }
+         }
+         CloseHandle(fileHandle);
+      }
+#else
+      int fd = open(path, O_RDONLY);
+      rc = APX_FILE_NOT_FOUND_ERROR;
+      if (fd >= 0)
+      {
+         struct stat fileStat;
+         rc = APX_READ_ERROR;
+         if (fstat(fd, &fileStat) == 0)
+         {
+            if (fileStat.st_size >= (off_t) APX_NODE_IMAGE_HEADER_SIZE)
+            {
+               void *mem = mmap(0, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+               if (mem != MAP_FAILED)
+               {
+                  nodeInfo = apx_nodeImage_read((const uint8_t*) mem, (size_t) fileStat.st_size, definitionDigest, definitionLen, mode, &rc);
+                  munmap(mem, (size_t) fileStat.st_size);
+               }
+            }
+            else
+            {
+               rc = APX_INVALID_FILE_ERROR;
+            }
+         }
+         close(fd);
+      }
+#endif
+   }
+   if (errorCode != 0)
+   {
+      *errorCode = rc;
+   }
+   return nodeInfo;
+}
+
+/**
+ * Returns "<directory>/<hex digest>.apxi" in a new string that the caller must free.
+ */
+char *apx_nodeImage_makeFilePath(const char *directory, const uint8_t *definitionDigest)
+{
+   if ( (directory != 0) && (definitionDigest != 0) )
+   {
+      static const char hexDigits[] = "0123456789abcdef";
+      size_t directoryLen = strlen(directory);
+      size_t suffixLen = strlen(APX_NODE_IMAGE_FILE_SUFFIX);
+      char *path = (char*) malloc(directoryLen + 1u + APX_SHA256_DIGEST_SIZE * 2u + suffixLen + 1u);
+      if (path != 0)
+      {
+         char *p = path;
+         uint32_t i;
+         memcpy(p, directory, directoryLen);
+         p += directoryLen;
+         *p++ = '/';
+         for (i = 0u; i < APX_SHA256_DIGEST_SIZE; i++)
+         {
+            *p++ = hexDigits[definitionDigest[i] >> 4];
+            *p++ = hexDigits[definitionDigest[i] & 0x0Fu];
+         }
+         memcpy(p, APX_NODE_IMAGE_FILE_SUFFIX, suffixLen + 1u);
+      }
+      return path;
+   }
+   return (char*) 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_nodeImage_appendBlob(adt_bytearray_t *image, const uint8_t *data, uint32_t dataLen)
+{
+   uint8_t lengthField[UINT32_SIZE];
+   packLE(&lengthField[0], dataLen, UINT32_SIZE);
+   if (adt_bytearray_append(image, &lengthField[0], UINT32_SIZE) != ADT_NO_ERROR)
+   {
+      return APX_MEM_ERROR;
+   }
+   if ( (dataLen > 0u) && (adt_bytearray_append(image, data, dataLen) != ADT_NO_ERROR) )
+   {
+      return APX_MEM_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_nodeImage_appendBytes(adt_bytearray_t *image, const adt_bytes_t *bytes)
+{
+   if (bytes == 0)
+   {
+      return apx_nodeImage_appendBlob(image, (const uint8_t*) 0, 0u);
+   }
+   return apx_nodeImage_appendBlob(image, adt_bytes_constData(bytes), adt_bytes_length(bytes));
+}
+
+static apx_error_t apx_nodeImage_appendString(adt_bytearray_t *image, const char *str)
+{
+   return apx_nodeImage_appendBlob(image, (const uint8_t*) str, (uint32_t) strlen(str));
+}
+
+static apx_error_t apx_nodeImage_appendPorts(adt_bytearray_t *image, adt_bytes_t **packPrograms, adt_bytes_t **unpackPrograms, char **portSignatures, apx_portCount_t numPorts)
+{
+   apx_portId_t portId;
+   if ( (numPorts > 0) && ( (packPrograms == 0) || (unpackPrograms == 0) || (portSignatures == 0) ) )
+   {
+      return APX_NULL_PTR_ERROR;
+   }
+   for (portId = 0; portId < numPorts; portId++)
+   {
+      apx_error_t rc;
+      if ( (packPrograms[portId] == 0) || (unpackPrograms[portId] == 0) || (portSignatures[portId] == 0) )
+      {
+         return APX_NULL_PTR_ERROR;
+      }
+      rc = apx_nodeImage_appendBytes(image, packPrograms[portId]);
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_appendBytes(image, unpackPrograms[portId]);
+      }
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_appendString(image, portSignatures[portId]);
+      }
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_nodeImage_readHeader(const uint8_t *imageData, size_t imageLen, const uint8_t *definitionDigest, uint32_t definitionLen, uint32_t *numRequirePorts, uint32_t *numProvidePorts)
+{
+   uint8_t bodyDigest[APX_SHA256_DIGEST_SIZE];
+   uint32_t bodyLen;
+   if ( (imageLen < APX_NODE_IMAGE_HEADER_SIZE) || (memcmp(&imageData[MAGIC_OFFSET], &m_magic[0], sizeof(m_magic)) != 0) )
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   if ( (unpackLE(&imageData[VERSION_OFFSET], UINT16_SIZE) != APX_NODE_IMAGE_VERSION) ||
+        (unpackLE(&imageData[HEADER_SIZE_OFFSET], UINT16_SIZE) != APX_NODE_IMAGE_HEADER_SIZE) )
+   {
+      return APX_UNSUPPORTED_ERROR;
+   }
+   if ( (unpackLE(&imageData[DEFINITION_LEN_OFFSET], UINT32_SIZE) != definitionLen) ||
+        (memcmp(&imageData[DEFINITION_DIGEST_OFFSET], definitionDigest, APX_SHA256_DIGEST_SIZE) != 0) )
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   bodyLen = unpackLE(&imageData[BODY_LEN_OFFSET], UINT32_SIZE);
+   if ( (size_t) bodyLen > (imageLen - APX_NODE_IMAGE_HEADER_SIZE) )
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   apx_sha256_calc(&imageData[APX_NODE_IMAGE_HEADER_SIZE], bodyLen, &bodyDigest[0]);
+   if (memcmp(&imageData[BODY_DIGEST_OFFSET], &bodyDigest[0], APX_SHA256_DIGEST_SIZE) != 0)
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   *numRequirePorts = unpackLE(&imageData[NUM_REQUIRE_PORTS_OFFSET], UINT32_SIZE);
+   *numProvidePorts = unpackLE(&imageData[NUM_PROVIDE_PORTS_OFFSET], UINT32_SIZE);
+   //each port takes at least three length fields in the body
+   if ( ( (uint64_t) *numRequirePorts + (uint64_t) *numProvidePorts) * (3u * UINT32_SIZE) > (uint64_t) bodyLen )
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_nodeImage_readBody(apx_nodeInfo_t *nodeInfo, apx_nodeImageReader_t *reader)
+{
+   apx_error_t rc = apx_nodeImage_readString(reader, &nodeInfo->name);
+   if (rc == APX_NO_ERROR)
+   {
+      rc = apx_nodeImage_readPorts(reader, nodeInfo->requirePortPackPrograms, nodeInfo->requirePortUnpackPrograms, nodeInfo->requirePortSignatures, nodeInfo->numRequirePorts);
+   }
+   if (rc == APX_NO_ERROR)
+   {
+      rc = apx_nodeImage_readPorts(reader, nodeInfo->providePortPackPrograms, nodeInfo->providePortUnpackPrograms, nodeInfo->providePortSignatures, nodeInfo->numProvidePorts);
+   }
+   if (rc == APX_NO_ERROR)
+   {
+      rc = apx_nodeImage_readBytes(reader, &nodeInfo->requirePortInitData);
+   }
+   if (rc == APX_NO_ERROR)
+   {
+      rc = apx_nodeImage_readBytes(reader, &nodeInfo->providePortInitData);
+   }
+   if ( (rc == APX_NO_ERROR) && (reader->next != reader->end) )
+   {
+      rc = APX_INVALID_FILE_ERROR;
+   }
+   return rc;
+}
+
+static apx_error_t apx_nodeImage_readPorts(apx_nodeImageReader_t *reader, adt_bytes_t **packPrograms, adt_bytes_t **unpackPrograms, char **portSignatures, apx_portCount_t numPorts)
+{
+   apx_portId_t portId;
+   for (portId = 0; portId < numPorts; portId++)
+   {
+      apx_error_t rc = apx_nodeImage_readBytes(reader, &packPrograms[portId]);
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_readBytes(reader, &unpackPrograms[portId]);
+      }
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_nodeImage_readString(reader, &portSignatures[portId]);
+      }
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_nodeImage_readBlob(apx_nodeImageReader_t *reader, const uint8_t **data, uint32_t *dataLen)
+{
+   uint32_t len;
+   if ( (reader->end - reader->next) < (ptrdiff_t) UINT32_SIZE)
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   len = unpackLE(reader->next, UINT32_SIZE);
+   reader->next += UINT32_SIZE;
+   if ( (size_t) (reader->end - reader->next) < (size_t) len)
+   {
+      return APX_INVALID_FILE_ERROR;
+   }
+   *data = reader->next;
+   *dataLen = len;
+   reader->next += len;
+   return APX_NO_ERROR;
+}
+
+/**
+ * An empty blob leaves *bytes as NULL
+ */
+static apx_error_t apx_nodeImage_readBytes(apx_nodeImageReader_t *reader, adt_bytes_t **bytes)
+{
+   const uint8_t *data = (const uint8_t*) 0;
+   uint32_t dataLen = 0u;
+   apx_error_t rc = apx_nodeImage_readBlob(reader, &data, &dataLen);
+   if ( (rc == APX_NO_ERROR) && (dataLen > 0u) )
+   {
+      *bytes = adt_bytes_new(data, dataLen);
+      if (*bytes == 0)
+      {
+         rc = APX_MEM_ERROR;
+      }
+   }
+   return rc;
+}
+
+static apx_error_t apx_nodeImage_readString(apx_nodeImageReader_t *reader, char **str)
+{
+   const uint8_t *data = (const uint8_t*) 0;
+   uint32_t dataLen = 0u;
+   apx_error_t rc = apx_nodeImage_readBlob(reader, &data, &dataLen);
+   if (rc == APX_NO_ERROR)
+   {
+      if ( (dataLen == 0u) || (memchr(data, 0, dataLen) != 0) )
+      {
+         return APX_INVALID_FILE_ERROR;
+      }
+      *str = (char*) malloc(dataLen + 1u);
+      if (*str == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      memcpy(*str, data, dataLen);
+      (*str)[dataLen] = '\0';
+   }
+   return rc;
+}
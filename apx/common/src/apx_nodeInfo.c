@@ -30,9 +30,16 @@
 #include <malloc.h>
 #include <assert.h>
 #include <string.h>
+#ifdef _MSC_VER
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#endif
 #include "apx_node.h"
 #include "apx_parser.h"
 #include "apx_nodeInfo.h"
+#include "apx_signatureTable.h"
 #include "apx_vm.h"
 #include "bstr.h"
 #include <stdio.h> //DEBUG ONLY
@@ -43,22 +50,35 @@
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#ifdef _MSC_VER
+# define ATOMIC_INCREMENT(p) ((void) InterlockedIncrement((volatile LONG*) (p)))
+# define ATOMIC_DECREMENT(p) ((uint32_t) InterlockedDecrement((volatile LONG*) (p)))
+#else
+# define ATOMIC_INCREMENT(p) ((void) __atomic_fetch_add((p), 1u, __ATOMIC_RELAXED))
+# define ATOMIC_DECREMENT(p) __atomic_sub_fetch((p), 1u, __ATOMIC_ACQ_REL)
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
 static apx_error_t apx_nodeInfo_allocateMemory(apx_nodeInfo_t *self);
 static void apx_nodeInfo_freeMemory(apx_nodeInfo_t *self);
-static void apx_nodeInfo_createRequirePortDataProps(apx_nodeInfo_t *self);
-static void apx_nodeInfo_createProvidePortDataProps(apx_nodeInfo_t *self);
+static apx_error_t apx_nodeInfo_createRequirePortDataProps(apx_nodeInfo_t *self);
+static apx_error_t apx_nodeInfo_createProvidePortDataProps(apx_nodeInfo_t *self);
+static apx_error_t apx_nodeInfo_initBytePortMap(apx_nodeInfo_t *self);
 static apx_error_t apx_nodeInfo_initClientBytePortMap(apx_nodeInfo_t *self);
 static apx_error_t apx_nodeInfo_initServerBytePortMap(apx_nodeInfo_t *self);
+static apx_error_t apx_nodeInfo_compileOpTables(apx_nodeInfo_t *self);
+static apx_error_t apx_nodeInfo_compilePortOpTables(adt_bytes_t **programs, apx_portCount_t numPorts, apx_vmOpTable_t ***opTables);
+static void apx_nodeInfo_deletePortOpTables(apx_vmOpTable_t ***opTables, apx_portCount_t numPorts);
 static apx_error_t apx_nodeInfo_compilePortPrograms(apx_nodeInfo_t *self, apx_compiler_t *compiler, const apx_node_t *node, apx_programType_t *errProgramType, apx_uniquePortId_t *errPortId);
 static apx_error_t apx_nodeInfo_createRequirePortInitData(apx_nodeInfo_t *self, const apx_node_t *node);
 static apx_error_t apx_nodeInfo_createProvidePortInitData(apx_nodeInfo_t *self, const apx_node_t *node);
 static uint8_t* apx_nodeInfo_createInitDataBuf(apx_size_t dataSize, adt_bytes_t **packPrograms, const adt_ary_t *ports, apx_portCount_t numPorts, apx_error_t *errorCode);
 static apx_error_t apx_nodeInfo_buildRequirePortSignatures(apx_nodeInfo_t *self, const apx_node_t *node);
 static apx_error_t apx_nodeInfo_buildProvidePortSignatures(apx_nodeInfo_t *self, const apx_node_t *node);
+static apx_error_t apx_nodeInfo_internPortSignatures(char **portSignatures, apx_portCount_t numPorts, apx_signatureId_t **signatureIds);
+static void apx_nodeInfo_releasePortSignatures(char **portSignatures, apx_portCount_t numPorts, apx_signatureId_t **signatureIds);
 
 //////////////////////////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
@@ -86,6 +106,7 @@ apx_nodeInfo_t *apx_nodeInfo_new(void)
    if (self != 0)
    {
       apx_nodeInfo_create(self);
+      self->refCount = 1u;
    }
    return self;
 }
@@ -99,6 +120,32 @@ void apx_nodeInfo_delete(apx_nodeInfo_t *self)
    }
 }
 
+/**
+ * Adds an owner to a nodeInfo created with apx_nodeInfo_new. A shared nodeInfo must be treated as read-only.
+ */
+apx_nodeInfo_t *apx_nodeInfo_ref(apx_nodeInfo_t *self)
+{
+   if (self != 0)
+   {
+      ATOMIC_INCREMENT(&self->refCount);
+   }
+   return self;
+}
+
+/**
+ * Removes an owner. The last owner deletes the object.
+ */
+void apx_nodeInfo_release(apx_nodeInfo_t *self)
+{
+   if (self != 0)
+   {
+      if (ATOMIC_DECREMENT(&self->refCount) == 0u)
+      {
+         apx_nodeInfo_delete(self);
+      }
+   }
+}
+
 apx_error_t apx_nodeInfo_build(apx_nodeInfo_t *self, const struct apx_node_tag *parseTree, apx_compiler_t *compiler, apx_mode_t mode, apx_programType_t *errProgramType, apx_uniquePortId_t *errPortId)
 {
    if ( (self != 0) && (parseTree != 0) && (compiler != 0) && ( (mode == APX_CLIENT_MODE) || (mode == APX_SERVER_MODE) ) )
@@ -125,15 +172,18 @@ apx_error_t apx_nodeInfo_build(apx_nodeInfo_t *self, const struct apx_node_tag *
          apx_nodeInfo_freeMemory(self);
          return errorCode;
       }
-      apx_nodeInfo_createRequirePortDataProps(self);
-      apx_nodeInfo_createProvidePortDataProps(self);
-      if(mode == APX_CLIENT_MODE)
+      errorCode = apx_nodeInfo_createRequirePortDataProps(self);
+      if (errorCode == APX_NO_ERROR)
       {
-         errorCode = apx_nodeInfo_initClientBytePortMap(self);
+         errorCode = apx_nodeInfo_createProvidePortDataProps(self);
       }
-      else
+      if (errorCode == APX_NO_ERROR)
       {
-         errorCode = apx_nodeInfo_initServerBytePortMap(self);
+         errorCode = apx_nodeInfo_initBytePortMap(self);
+      }
+      if (errorCode == APX_NO_ERROR)
+      {
+         errorCode = apx_nodeInfo_compileOpTables(self);
       }
       if (errorCode != APX_NO_ERROR)
       {
@@ -149,6 +199,10 @@ apx_error_t apx_nodeInfo_build(apx_nodeInfo_t *self, const struct apx_node_tag *
             return errorCode;
          }
          errorCode = apx_nodeInfo_buildRequirePortSignatures(self, parseTree);
+         if ( (errorCode == APX_NO_ERROR) && (mode == APX_SERVER_MODE) )
+         {
+            errorCode = apx_nodeInfo_internPortSignatures(self->requirePortSignatures, self->numRequirePorts, &self->requirePortSignatureIds);
+         }
          if (errorCode != 0)
          {
             apx_nodeInfo_freeMemory(self);
@@ -164,6 +218,10 @@ apx_error_t apx_nodeInfo_build(apx_nodeInfo_t *self, const struct apx_node_tag *
             return errorCode;
          }
          errorCode = apx_nodeInfo_buildProvidePortSignatures(self, parseTree);
+         if ( (errorCode == APX_NO_ERROR) && (mode == APX_SERVER_MODE) )
+         {
+            errorCode = apx_nodeInfo_internPortSignatures(self->providePortSignatures, self->numProvidePorts, &self->providePortSignatureIds);
+         }
          if (errorCode != 0)
          {
             apx_nodeInfo_freeMemory(self);
@@ -177,6 +235,129 @@ apx_error_t apx_nodeInfo_build(apx_nodeInfo_t *self, const struct apx_node_tag *
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * First step of loading a nodeInfo from a compiled node image (see apx_nodeImage.h).
+ * Allocates the port tables. The caller then fills in name, port programs, port signatures and init data.
+ */
+apx_error_t apx_nodeInfo_prepareLoad(apx_nodeInfo_t *self, apx_mode_t mode, apx_portCount_t numRequirePorts, apx_portCount_t numProvidePorts)
+{
+   if ( (self != 0) && ( (mode == APX_CLIENT_MODE) || (mode == APX_SERVER_MODE) ) && (numRequirePorts >= 0) && (numProvidePorts >= 0) )
+   {
+      apx_error_t errorCode;
+      if ( (self->numRequirePorts != 0) || (self->numProvidePorts != 0) || (self->name != 0) )
+      {
+         return APX_INVALID_STATE_ERROR;
+      }
+      self->mode = mode;
+      self->numRequirePorts = numRequirePorts;
+      self->numProvidePorts = numProvidePorts;
+      errorCode = apx_nodeInfo_allocateMemory(self);
+      if (errorCode != APX_NO_ERROR)
+      {
+         return errorCode;
+      }
+      if (numRequirePorts > 0)
+      {
+         size_t allocSize = numRequirePorts * sizeof(char*);
+         self->requirePortSignatures = (char**) malloc(allocSize);
+         if (self->requirePortSignatures == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+         memset(self->requirePortSignatures, 0, allocSize);
+      }
+      if (numProvidePorts > 0)
+      {
+         size_t allocSize = numProvidePorts * sizeof(char*);
+         self->providePortSignatures = (char**) malloc(allocSize);
+         if (self->providePortSignatures == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+         memset(self->providePortSignatures, 0, allocSize);
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Last step of loading a nodeInfo from a compiled node image.
+ * Derives everything that isn't stored in the image (port data properties, byte port map, signature IDs) from the loaded programs.
+ * On failure the caller must release the nodeInfo, it's left partially built.
+ */
+apx_error_t apx_nodeInfo_completeLoad(apx_nodeInfo_t *self)
+{
+   if (self != 0)
+   {
+      apx_error_t errorCode;
+      apx_portId_t portId;
+      if (self->name == 0)
+      {
+         return APX_NAME_MISSING_ERROR;
+      }
+      for (portId = 0; portId < self->numRequirePorts; portId++)
+      {
+         if ( (self->requirePortPackPrograms[portId] == 0) || (self->requirePortUnpackPrograms[portId] == 0) )
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
+         if (self->requirePortSignatures[portId] == 0)
+         {
+            return APX_PORT_SIGNATURE_ERROR;
+         }
+      }
+      for (portId = 0; portId < self->numProvidePorts; portId++)
+      {
+         if ( (self->providePortPackPrograms[portId] == 0) || (self->providePortUnpackPrograms[portId] == 0) )
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
+         if (self->providePortSignatures[portId] == 0)
+         {
+            return APX_PORT_SIGNATURE_ERROR;
+         }
+      }
+      errorCode = apx_nodeInfo_createRequirePortDataProps(self);
+      if (errorCode == APX_NO_ERROR)
+      {
+         errorCode = apx_nodeInfo_createProvidePortDataProps(self);
+      }
+      if (errorCode == APX_NO_ERROR)
+      {
+         errorCode = apx_nodeInfo_initBytePortMap(self);
+      }
+      if (errorCode == APX_NO_ERROR)
+      {
+         errorCode = apx_nodeInfo_compileOpTables(self);
+      }
+      if (errorCode != APX_NO_ERROR)
+      {
+         return errorCode;
+      }
+      self->requirePortDataLen = apx_nodeInfo_calcRequirePortDataLen(self);
+      self->providePortDataLen = apx_nodeInfo_calcProvidePortDataLen(self);
+      if ( (apx_nodeInfo_getRequirePortInitDataSize(self) != self->requirePortDataLen) ||
+           (apx_nodeInfo_getProvidePortInitDataSize(self) != self->providePortDataLen) )
+      {
+         return APX_LENGTH_ERROR;
+      }
+      if (self->mode == APX_SERVER_MODE)
+      {
+         if (self->numRequirePorts > 0)
+         {
+            errorCode = apx_nodeInfo_internPortSignatures(self->requirePortSignatures, self->numRequirePorts, &self->requirePortSignatureIds);
+         }
+         if ( (errorCode == APX_NO_ERROR) && (self->numProvidePorts > 0) )
+         {
+            errorCode = apx_nodeInfo_internPortSignatures(self->providePortSignatures, self->numProvidePorts, &self->providePortSignatureIds);
+         }
+      }
+      return errorCode;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_nodeInfo_t *apx_nodeInfo_make_from_cstr(const char *apx_definition, apx_mode_t mode)
 {
    apx_nodeInfo_t *self = (apx_nodeInfo_t*) 0;
@@ -295,6 +476,32 @@ const adt_bytes_t* apx_nodeInfo_getProvidePortUnpackProgram(const apx_nodeInfo_t
    return (const adt_bytes_t*) 0;
 }
 
+/**
+ * Returns the operation table compiled from the require port unpack program.
+ * Returns NULL in server mode or when the program doesn't have a fixed data layout.
+ */
+const apx_vmOpTable_t* apx_nodeInfo_getRequirePortUnpackOpTable(const apx_nodeInfo_t *self, apx_portId_t portId)
+{
+   if ( (self != 0) && (portId < self->numRequirePorts) && (self->requirePortUnpackOpTables != 0) )
+   {
+      return self->requirePortUnpackOpTables[portId];
+   }
+   return (const apx_vmOpTable_t*) 0;
+}
+
+/**
+ * Returns the operation table compiled from the provide port pack program.
+ * Returns NULL in server mode or when the program doesn't have a fixed data layout.
+ */
+const apx_vmOpTable_t* apx_nodeInfo_getProvidePortPackOpTable(const apx_nodeInfo_t *self, apx_portId_t portId)
+{
+   if ( (self != 0) && (portId < self->numProvidePorts) && (self->providePortPackOpTables != 0) )
+   {
+      return self->providePortPackOpTables[portId];
+   }
+   return (const apx_vmOpTable_t*) 0;
+}
+
 apx_portId_t apx_nodeInfo_findProvidePortIdFromByteOffset(const apx_nodeInfo_t *self, apx_offset_t offset)
 {
    if ( (self != 0) && (offset >=0) && (self->serverBytePortMap != 0))
@@ -485,6 +692,36 @@ const char *apx_nodeInfo_getProvidePortSignature(const apx_nodeInfo_t *self, apx
    return (const char*) 0;
 }
 
+/**
+ * Returns the interned id of the require port signature. Only available in server mode.
+ */
+apx_signatureId_t apx_nodeInfo_getRequirePortSignatureId(const apx_nodeInfo_t *self, apx_portId_t portId)
+{
+   if ( (self != 0) && (portId >= 0) && (portId < self->numRequirePorts) )
+   {
+      if (self->requirePortSignatureIds != 0)
+      {
+         return self->requirePortSignatureIds[portId];
+      }
+   }
+   return APX_INVALID_SIGNATURE_ID;
+}
+
+/**
+ * Returns the interned id of the provide port signature. Only available in server mode.
+ */
+apx_signatureId_t apx_nodeInfo_getProvidePortSignatureId(const apx_nodeInfo_t *self, apx_portId_t portId)
+{
+   if ( (self != 0) && (portId >= 0) && (portId < self->numProvidePorts) )
+   {
+      if (self->providePortSignatureIds != 0)
+      {
+         return self->providePortSignatureIds[portId];
+      }
+   }
+   return APX_INVALID_SIGNATURE_ID;
+}
+
 adt_str_t *apx_nodeInfo_getRequirePortName(const apx_nodeInfo_t *self, apx_portId_t portId)
 {
    if ( (self != 0) && (portId >= 0) && (portId < self->numRequirePorts) )
@@ -640,6 +877,8 @@ static void apx_nodeInfo_freeMemory(apx_nodeInfo_t *self)
          free(self->providePortUnpackPrograms);
          self->providePortUnpackPrograms = 0;
       }
+      apx_nodeInfo_deletePortOpTables(&self->requirePortUnpackOpTables, self->numRequirePorts);
+      apx_nodeInfo_deletePortOpTables(&self->providePortPackOpTables, self->numProvidePorts);
       if (self->clientBytePortMap != 0)
       {
          apx_bytePortMap_delete(self->clientBytePortMap);
@@ -660,6 +899,8 @@ static void apx_nodeInfo_freeMemory(apx_nodeInfo_t *self)
       {
          free(self->name);
       }
+      apx_nodeInfo_releasePortSignatures(self->requirePortSignatures, self->numRequirePorts, &self->requirePortSignatureIds);
+      apx_nodeInfo_releasePortSignatures(self->providePortSignatures, self->numProvidePorts, &self->providePortSignatureIds);
       if (self->requirePortSignatures != 0)
       {
          apx_portId_t portId;
@@ -689,7 +930,10 @@ static void apx_nodeInfo_freeMemory(apx_nodeInfo_t *self)
    }
 }
 
-static void apx_nodeInfo_createRequirePortDataProps(apx_nodeInfo_t *self)
+/**
+ * Programs loaded from a compiled node image haven't been produced by the compiler in this process, so a bad header is reported instead of asserted.
+ */
+static apx_error_t apx_nodeInfo_createRequirePortDataProps(apx_nodeInfo_t *self)
 {
    if (self->numRequirePorts > 0)
    {
@@ -700,19 +944,25 @@ static void apx_nodeInfo_createRequirePortDataProps(apx_nodeInfo_t *self)
          apx_portDataProps_t *props = &self->requirePortDataProps[portId];
          apx_size_t dataSize = 0u;
          uint8_t programFlags = 0u;
-         //apx_port_t *port = apx_node_getRequirePort(node, portId);
          const adt_bytes_t *program = apx_nodeInfo_getRequirePortUnpackProgram(self, portId);
          assert(program != 0);
          apx_error_t rc = apx_vm_decodeProgramDataProps(program, &dataSize, &programFlags);
-         assert(rc == APX_NO_ERROR);
-         assert(dataSize > 0);
+         if (rc != APX_NO_ERROR)
+         {
+            return rc;
+         }
+         if (dataSize == 0u)
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
          apx_portDataProps_create(props, APX_REQUIRE_PORT, portId, offset, dataSize);
          offset += dataSize;
       }
    }
+   return APX_NO_ERROR;
 }
 
-static void apx_nodeInfo_createProvidePortDataProps(apx_nodeInfo_t *self)
+static apx_error_t apx_nodeInfo_createProvidePortDataProps(apx_nodeInfo_t *self)
 {
    if (self->numProvidePorts > 0)
    {
@@ -723,16 +973,31 @@ static void apx_nodeInfo_createProvidePortDataProps(apx_nodeInfo_t *self)
          apx_portDataProps_t *props = &self->providePortDataProps[portId];
          apx_size_t dataSize = 0u;
          uint8_t programFlags = 0u;
-         //apx_port_t *port = apx_node_getRequirePort(node, portId);
          const adt_bytes_t *program = apx_nodeInfo_getProvidePortPackProgram(self, portId);
          assert(program != 0);
          apx_error_t rc = apx_vm_decodeProgramDataProps(program, &dataSize, &programFlags);
-         assert(rc == APX_NO_ERROR);
-         assert(dataSize > 0u);
+         if (rc != APX_NO_ERROR)
+         {
+            return rc;
+         }
+         if (dataSize == 0u)
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
          apx_portDataProps_create(props, APX_PROVIDE_PORT, portId, offset, dataSize);
          offset += dataSize;
       }
    }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_nodeInfo_initBytePortMap(apx_nodeInfo_t *self)
+{
+   if (self->mode == APX_CLIENT_MODE)
+   {
+      return apx_nodeInfo_initClientBytePortMap(self);
+   }
+   return apx_nodeInfo_initServerBytePortMap(self);
 }
 
 static apx_error_t apx_nodeInfo_initClientBytePortMap(apx_nodeInfo_t *self)
@@ -771,6 +1036,78 @@ static apx_error_t apx_nodeInfo_initServerBytePortMap(apx_nodeInfo_t *self)
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Compiles the programs used by the client on every port read/write into operation tables once,
+ * so that the VM can select them without recompiling (see apx_vm_selectCompiledProgram).
+ */
+static apx_error_t apx_nodeInfo_compileOpTables(apx_nodeInfo_t *self)
+{
+   apx_error_t errorCode = APX_NO_ERROR;
+   if (self->mode == APX_CLIENT_MODE)
+   {
+      errorCode = apx_nodeInfo_compilePortOpTables(self->requirePortUnpackPrograms, self->numRequirePorts, &self->requirePortUnpackOpTables);
+      if (errorCode == APX_NO_ERROR)
+      {
+         errorCode = apx_nodeInfo_compilePortOpTables(self->providePortPackPrograms, self->numProvidePorts, &self->providePortPackOpTables);
+      }
+   }
+   return errorCode;
+}
+
+/**
+ * Programs without a fixed data layout fail to compile, those ports get a NULL entry and keep using the byte code interpreter.
+ */
+static apx_error_t apx_nodeInfo_compilePortOpTables(adt_bytes_t **programs, apx_portCount_t numPorts, apx_vmOpTable_t ***opTables)
+{
+   if ( (programs != 0) && (numPorts > 0) )
+   {
+      apx_portId_t portId;
+      size_t allocSize = numPorts * sizeof(apx_vmOpTable_t*);
+      *opTables = (apx_vmOpTable_t**) malloc(allocSize);
+      if (*opTables == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      memset(*opTables, 0, allocSize);
+      for (portId = 0; portId < numPorts; portId++)
+      {
+         const uint8_t *progBegin = adt_bytes_constData(programs[portId]);
+         const uint8_t *progEnd = progBegin + adt_bytes_length(programs[portId]);
+         apx_vmOpTable_t *opTable = apx_vmOpTable_new();
+         if (opTable == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+         if (apx_vmOpTable_compile(opTable, progBegin, progEnd) == APX_NO_ERROR)
+         {
+            (*opTables)[portId] = opTable;
+         }
+         else
+         {
+            apx_vmOpTable_delete(opTable);
+         }
+      }
+   }
+   return APX_NO_ERROR;
+}
+
+static void apx_nodeInfo_deletePortOpTables(apx_vmOpTable_t ***opTables, apx_portCount_t numPorts)
+{
+   if (*opTables != 0)
+   {
+      apx_portId_t portId;
+      for (portId = 0; portId < numPorts; portId++)
+      {
+         if ((*opTables)[portId] != 0)
+         {
+            apx_vmOpTable_delete((*opTables)[portId]);
+         }
+      }
+      free(*opTables);
+      *opTables = 0;
+   }
+}
+
 
 static apx_error_t apx_nodeInfo_compilePortPrograms(apx_nodeInfo_t *self, apx_compiler_t *compiler, const apx_node_t *node, apx_programType_t *errProgramType, apx_uniquePortId_t *errPortId)
 {
@@ -1106,3 +1443,49 @@ static apx_error_t apx_nodeInfo_buildProvidePortSignatures(apx_nodeInfo_t *self,
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
+
+/**
+ * Interns all port signatures in the global signature table. Ids that were interned before a failure are released by apx_nodeInfo_freeMemory.
+ */
+static apx_error_t apx_nodeInfo_internPortSignatures(char **portSignatures, apx_portCount_t numPorts, apx_signatureId_t **signatureIds)
+{
+   apx_portId_t portId;
+   apx_signatureTable_t *signatureTable = apx_signatureTable_getGlobal();
+   size_t allocSize = numPorts * sizeof(apx_signatureId_t);
+   assert(portSignatures != 0);
+   assert(allocSize > 0u);
+   *signatureIds = (apx_signatureId_t*) malloc(allocSize);
+   if (*signatureIds == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   memset(*signatureIds, 0, allocSize);
+   for(portId = 0; portId < ((apx_portId_t) numPorts); portId++)
+   {
+      (*signatureIds)[portId] = apx_signatureTable_intern(signatureTable, portSignatures[portId]);
+      if ((*signatureIds)[portId] == APX_INVALID_SIGNATURE_ID)
+      {
+         return APX_MEM_ERROR;
+      }
+   }
+   return APX_NO_ERROR;
+}
+
+static void apx_nodeInfo_releasePortSignatures(char **portSignatures, apx_portCount_t numPorts, apx_signatureId_t **signatureIds)
+{
+   if (*signatureIds != 0)
+   {
+      apx_portId_t portId;
+      apx_signatureTable_t *signatureTable = apx_signatureTable_getGlobal();
+      assert(portSignatures != 0);
+      for(portId = 0; portId < ((apx_portId_t) numPorts); portId++)
+      {
+         if ((*signatureIds)[portId] != APX_INVALID_SIGNATURE_ID)
+         {
+            apx_signatureTable_release(signatureTable, portSignatures[portId]);
+         }
+      }
+      free(*signatureIds);
+      *signatureIds = (apx_signatureId_t*) 0;
+   }
+}
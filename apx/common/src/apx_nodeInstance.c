@@ -31,6 +31,7 @@
 #include <stdio.h> //DEBUG ONLY
 #include "apx_nodeInstance.h"
 #include "apx_connectionBase.h"
+#include "apx_portSignatureMap.h"
 #include "apx_util.h"
 #include "rmf.h"
 
@@ -44,6 +45,14 @@
 //////////////////////////////////////////////////////////////////////////////
 #define STACK_DATA_BUF_SIZE 256
 
+#ifdef _MSC_VER
+# define ATOMIC_LOAD_PTR(p) InterlockedCompareExchangePointer((PVOID volatile*) (p), 0, 0)
+# define ATOMIC_EXCHANGE_PTR(p, v) InterlockedExchangePointer((PVOID volatile*) (p), (v))
+#else
+# define ATOMIC_LOAD_PTR(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+# define ATOMIC_EXCHANGE_PTR(p, v) __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+
 typedef apx_portDataProps_t* (apx_getPortDataPropsFunc)(const apx_nodeInfo_t *self, apx_portId_t portId);
 
 //////////////////////////////////////////////////////////////////////////////
@@ -52,13 +61,17 @@ typedef apx_portDataProps_t* (apx_getPortDataPropsFunc)(const apx_nodeInfo_t *se
 static apx_error_t apx_nodeInstance_definitionFileWriteNotify(void *arg, apx_file_t *file, uint32_t offset, const uint8_t *src, uint32_t len);
 static apx_error_t apx_nodeInstance_definitionFileOpenNotify(void *arg, struct apx_file_tag *file);
 static apx_error_t apx_nodeInstance_definitionFileReadData(void *arg, apx_file_t*file, uint32_t offset, uint8_t *dest, uint32_t len);
-static apx_error_t apx_nodeInstance_createFileInfo(apx_nodeInstance_t *self, const char *fileExtension, uint32_t fileSize, apx_fileInfo_t *fileInfo);
+static apx_error_t apx_nodeInstance_createFileInfo(apx_nodeInstance_t *self, const char *fileExtension, uint32_t fileSize, uint16_t digestType, const uint8_t *digestData, apx_fileInfo_t *fileInfo);
+static void apx_nodeInstance_nodeInfoReady(apx_nodeInstance_t *self);
 static apx_error_t apx_nodeInstance_providePortDataFileWriteNotify(void *arg, apx_file_t *file, uint32_t offset, const uint8_t *src, uint32_t len);
 static apx_error_t apx_nodeInstance_providePortDataFileOpenNotify(void *arg, struct apx_file_tag *file);
 static apx_error_t apx_nodeInstance_requirePortDataFileWriteNotify(void *arg, apx_file_t *file, uint32_t offset, const uint8_t *src, uint32_t len);
 static apx_error_t apx_nodeInstance_requirePortDataFileOpenNotify(void *arg, struct apx_file_tag *file);
 static void apx_nodeInstance_initPortRefs(apx_nodeInstance_t *self, apx_portRef_t *portRefs, apx_portCount_t numPorts, uint32_t portIdMask, apx_getPortDataPropsFunc *getPortDataProps);
 static apx_error_t apx_nodeInstance_routeProvidePortDataToRequirePortByRef(apx_portRef_t *providePortRef, apx_portRef_t *requirePortRef);
+static apx_error_t apx_nodeInstance_publishRoutingPlan(apx_nodeInstance_t *self);
+static apx_error_t apx_nodeInstance_forwardProvidePortData(void *arg, const uint8_t *data, uint32_t offset, apx_size_t len);
+static apx_size_t apx_nodeInstance_calcMaxProvidePortDataSize(apx_nodeInfo_t *nodeInfo);
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -77,6 +90,9 @@ void apx_nodeInstance_create(apx_nodeInstance_t *self, apx_mode_t mode)
       self->mode = mode;
       self->requirePortDataState = APX_REQUIRE_PORT_DATA_STATE_INIT;
       self->providePortDataState = APX_PROVIDE_PORT_DATE_STATE_INIT;
+      self->routingPlan = (apx_routingPlan_t*) 0;
+      self->isRoutingPlanValid = false;
+      apx_epoch_create(&self->routingEpoch);
       MUTEX_INIT(self->connectorTableLock);
    }
 }
@@ -107,7 +123,7 @@ void apx_nodeInstance_destroy(apx_nodeInstance_t *self)
       }
       if (self->nodeInfo != 0)
       {
-         apx_nodeInfo_delete(self->nodeInfo);
+         apx_nodeInfo_release(self->nodeInfo);
       }
       if (self->nodeData != 0)
       {
@@ -131,6 +147,12 @@ void apx_nodeInstance_destroy(apx_nodeInstance_t *self)
       {
          apx_portConnectorChangeTable_delete(self->providePortChanges);
       }
+      if (self->routingPlan != 0)
+      {
+         apx_routingPlan_delete(self->routingPlan);
+         self->routingPlan = (apx_routingPlan_t*) 0;
+      }
+      apx_epoch_destroy(&self->routingEpoch);
       MUTEX_DESTROY(self->connectorTableLock);
    }
 }
@@ -282,6 +304,18 @@ apx_error_t apx_nodeInstance_createPortDataBuffers(apx_nodeInstance_t *self)
             }
          }
       }
+      if ( (retval == APX_NO_ERROR) && (self->mode == APX_CLIENT_MODE) )
+      {
+         apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
+         if (numProvidePorts > 0)
+         {
+            retval = apx_nodeData_createProvidePortWriteFilterBuffer(nodeData, numProvidePorts);
+            if ( (retval == APX_NO_ERROR) && (providePortDataLen > 0u) )
+            {
+               retval = apx_nodeData_createProvidePortPackBuffer(nodeData, apx_nodeInstance_calcMaxProvidePortDataSize(nodeInfo));
+            }
+         }
+      }
       if ( (retval == APX_NO_ERROR) && (requirePortDataLen > 0u))
       {
          retval = apx_nodeData_createRequirePortBuffer(nodeData, requirePortDataLen);
@@ -361,9 +395,13 @@ apx_error_t apx_nodeInstance_buildNodeInfo(apx_nodeInstance_t *self, apx_program
          apx_compiler_destroy(&compiler);
          if (rc != APX_NO_ERROR)
          {
-            apx_nodeInfo_delete(self->nodeInfo);
+            apx_nodeInfo_release(self->nodeInfo);
             self->nodeInfo = 0;
          }
+         else
+         {
+            apx_nodeInstance_nodeInfoReady(self);
+         }
          return rc;
       }
       return APX_NULL_PTR_ERROR;
@@ -371,6 +409,25 @@ apx_error_t apx_nodeInstance_buildNodeInfo(apx_nodeInstance_t *self, apx_program
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Uses an already built nodeInfo instead of parsing and compiling the definition.
+ * The node instance takes a new reference to nodeInfo, the caller keeps its own.
+ */
+apx_error_t apx_nodeInstance_attachNodeInfo(apx_nodeInstance_t *self, apx_nodeInfo_t *nodeInfo)
+{
+   if ( (self != 0) && (nodeInfo != 0) )
+   {
+      if ( (self->nodeInfo != 0) || (nodeInfo->mode != self->mode) )
+      {
+         return APX_INVALID_STATE_ERROR;
+      }
+      self->nodeInfo = apx_nodeInfo_ref(nodeInfo);
+      apx_nodeInstance_nodeInfoReady(self);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_nodeInfo_t *apx_nodeInstane_getNodeInfo(apx_nodeInstance_t *self)
 {
    if (self != 0)
@@ -584,7 +641,7 @@ apx_error_t apx_nodeInstance_fillProvidePortDataFileInfo(apx_nodeInstance_t *sel
          uint32_t fileSize;
          fileSize = (uint32_t) apx_nodeInfo_getProvidePortInitDataSize(self->nodeInfo);
          assert(fileSize > 0);
-         return apx_nodeInstance_createFileInfo(self, APX_OUTDATA_FILE_EXT, fileSize, fileInfo);
+         return apx_nodeInstance_createFileInfo(self, APX_OUTDATA_FILE_EXT, fileSize, RMF_DIGEST_TYPE_NONE, (const uint8_t*) 0, fileInfo);
       }
       return APX_NULL_PTR_ERROR;
    }
@@ -598,9 +655,17 @@ apx_error_t apx_nodeInstance_fillDefinitionFileInfo(apx_nodeInstance_t *self, ap
       if (self->nodeData != 0)
       {
          uint32_t fileSize;
+         uint16_t digestType = RMF_DIGEST_TYPE_NONE;
+         const uint8_t *digestData = (const uint8_t*) 0;
          fileSize = (uint32_t) apx_nodeData_getDefinitionDataLen(self->nodeData);
          assert(fileSize > 0);
-         return apx_nodeInstance_createFileInfo(self, APX_DEFINITION_FILE_EXT, fileSize, fileInfo);
+         if (apx_nodeData_getDefinitionChecksumType(self->nodeData) == APX_CHECKSUM_SHA256)
+         {
+            //lets the server recognize definitions it has already built
+            digestType = RMF_DIGEST_TYPE_SHA256;
+            digestData = apx_nodeData_getDefinitionChecksumData(self->nodeData);
+         }
+         return apx_nodeInstance_createFileInfo(self, APX_DEFINITION_FILE_EXT, fileSize, digestType, digestData, fileInfo);
       }
       return APX_NULL_PTR_ERROR;
    }
@@ -644,6 +709,18 @@ apx_nodeInfo_t *apx_nodeInstance_getNodeInfo(apx_nodeInstance_t *self)
    return (apx_nodeInfo_t*) 0;
 }
 
+/**
+ * Returns the bit mask of portSignatureMap stripes this node has ports in. It's calculated once when nodeInfo is built.
+ */
+uint32_t apx_nodeInstance_getPortSignatureStripes(const apx_nodeInstance_t *self)
+{
+   if (self != 0)
+   {
+      return self->portSignatureStripes;
+   }
+   return 0u;
+}
+
 void apx_nodeInstance_setProvidePortDataState(apx_nodeInstance_t *self, apx_providePortDataState_t state)
 {
    if (self != 0)
@@ -791,6 +868,75 @@ apx_error_t apx_nodeInstance_writeProvidePortData(apx_nodeInstance_t *self, cons
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Writes the complete data of one provide-port.
+ * Unlike apx_nodeInstance_writeProvidePortData this respects the write mode of the port,
+ * in on-change mode the write is not forwarded to remote side when the data is unchanged.
+ * The forward is queued before the port data lock is released, see apx_nodeData_writeProvidePortDataFiltered.
+ */
+apx_error_t apx_nodeInstance_writeProvidePortDataById(apx_nodeInstance_t *self, apx_portId_t providePortId, const uint8_t *src, apx_size_t len)
+{
+   if ( (self != 0) && (src != 0) )
+   {
+      if ( (self->nodeData != 0) && (self->nodeInfo != 0) )
+      {
+         const apx_portDataProps_t *portDataProps = apx_nodeInfo_getProvidePortDataProps(self->nodeInfo, providePortId);
+         if (portDataProps == 0)
+         {
+            return APX_INVALID_ARGUMENT_ERROR;
+         }
+         return apx_nodeData_writeProvidePortDataFiltered(self->nodeData, providePortId, src, portDataProps->offset, len,
+               apx_nodeInstance_forwardProvidePortData, (void*) self, (bool*) 0);
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Same as apx_nodeInstance_writeProvidePortDataById except that packFunc writes the port data (len bytes) into a buffer owned by nodeData.
+ * Only available in client mode.
+ */
+apx_error_t apx_nodeInstance_packProvidePortDataById(apx_nodeInstance_t *self, apx_portId_t providePortId, apx_size_t len, apx_nodeData_packFunc *packFunc, void *packArg)
+{
+   if ( (self != 0) && (packFunc != 0) )
+   {
+      if ( (self->nodeData != 0) && (self->nodeInfo != 0) )
+      {
+         const apx_portDataProps_t *portDataProps = apx_nodeInfo_getProvidePortDataProps(self->nodeInfo, providePortId);
+         if (portDataProps == 0)
+         {
+            return APX_INVALID_ARGUMENT_ERROR;
+         }
+         return apx_nodeData_packProvidePortDataFiltered(self->nodeData, providePortId, portDataProps->offset, len,
+               packFunc, packArg, apx_nodeInstance_forwardProvidePortData, (void*) self);
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Enables (APX_PORT_WRITE_MODE_ON_CHANGE) or disables (APX_PORT_WRITE_MODE_ALWAYS) suppression of unchanged writes.
+ * A heartbeatInterval > 0 (milliseconds) forwards an unchanged value anyway when nothing has been forwarded for that long.
+ * Only available in client mode.
+ */
+apx_error_t apx_nodeInstance_setProvidePortWriteMode(apx_nodeInstance_t *self, apx_portId_t providePortId, apx_portWriteMode_t mode, uint32_t heartbeatInterval)
+{
+   if ( (self != 0) && (self->nodeData != 0) )
+   {
+      return apx_nodeData_setProvidePortWriteMode(self->nodeData, providePortId, mode, heartbeatInterval);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+uint32_t apx_nodeInstance_getProvidePortSuppressedWriteCount(apx_nodeInstance_t *self, apx_portId_t providePortId)
+{
+   if ( (self != 0) && (self->nodeData != 0) )
+   {
+      return apx_nodeData_getProvidePortSuppressedWriteCount(self->nodeData, providePortId);
+   }
+   return 0u;
+}
+
 apx_error_t apx_nodeInstance_readProvidePortData(apx_nodeInstance_t *self, uint8_t *dest, uint32_t offset, apx_size_t len)
 {
    if ( (self != 0) && (dest != 0) )
@@ -826,6 +972,25 @@ apx_error_t apx_nodeInstance_readRequirePortData(apx_nodeInstance_t *self, uint8
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Lets unpackFunc read require-port data in place, see apx_nodeData_unpackRequirePortData
+ */
+apx_error_t apx_nodeInstance_unpackRequirePortData(apx_nodeInstance_t *self, uint32_t offset, apx_size_t len, apx_nodeData_unpackFunc *unpackFunc, void *unpackArg)
+{
+   if ( (self != 0) && (unpackFunc != 0) )
+   {
+      if (self->nodeData != 0)
+      {
+         return apx_nodeData_unpackRequirePortData(self->nodeData, offset, len, unpackFunc, unpackArg);
+      }
+      else
+      {
+         return APX_NULL_PTR_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_error_t apx_nodeInstance_writeRequirePortData(apx_nodeInstance_t *self, const uint8_t *src, uint32_t offset, apx_size_t len)
 {
    if ( (self != 0) && (src != 0) )
@@ -883,10 +1048,18 @@ void apx_nodeInstance_lockPortConnectorTable(apx_nodeInstance_t *self)
    }
 }
 
+/**
+ * Publishes a new routing plan to the routers when connectorTable was changed while the lock was held.
+ * When publishing fails routers keep using the previous plan until the next call succeeds.
+ */
 void apx_nodeInstance_unlockPortConnectorTable(apx_nodeInstance_t *self)
 {
    if ( (self != 0) && (self->connectorTable != 0) )
    {
+      if (!self->isRoutingPlanValid)
+      {
+         (void) apx_nodeInstance_publishRoutingPlan(self);
+      }
       MUTEX_UNLOCK(self->connectorTableLock);
    }
 }
@@ -910,7 +1083,8 @@ apx_portConnectorList_t *apx_nodeInstance_getProvidePortConnectors(apx_nodeInsta
 
 /**
  * Creates a new connector from this nodes' P-Port to another nodes' R-port.
- * The caller of this function must have previously have called apx_nodeInstance_lockPortConnectorTable on this object
+ * The caller of this function must have previously have called apx_nodeInstance_lockPortConnectorTable on this object.
+ * Routers see the new connector after apx_nodeInstance_unlockPortConnectorTable.
  */
 apx_error_t apx_nodeInstance_insertProvidePortConnector(apx_nodeInstance_t *self, apx_portId_t portId, apx_portRef_t *requirePortRef)
 {
@@ -924,6 +1098,7 @@ apx_error_t apx_nodeInstance_insertProvidePortConnector(apx_nodeInstance_t *self
          if (self->connectorTable != 0)
          {
             apx_portConnectorList_t *connectors = &self->connectorTable[portId];
+            self->isRoutingPlanValid = false;
             return apx_portConnectorList_insert(connectors, requirePortRef);
          }
          return APX_NULL_PTR_ERROR;
@@ -935,7 +1110,8 @@ apx_error_t apx_nodeInstance_insertProvidePortConnector(apx_nodeInstance_t *self
 
 /**
  * Undo action previously performed by apx_nodeInstance_insertProvidePortConnector.
- * The caller must have previously called apx_nodeInstance_lockPortConnectorTable on this object
+ * The caller must have previously called apx_nodeInstance_lockPortConnectorTable on this object.
+ * Routers may keep using the removed connector until apx_nodeInstance_synchronizeRouting returns.
  */
 apx_error_t apx_nodeInstance_removeProvidePortConnector(apx_nodeInstance_t *self, apx_portId_t portId, apx_portRef_t *requirePortRef)
 {
@@ -950,6 +1126,7 @@ apx_error_t apx_nodeInstance_removeProvidePortConnector(apx_nodeInstance_t *self
          {
             apx_portConnectorList_t *connectors = &self->connectorTable[portId];
             apx_portConnectorList_remove(connectors, requirePortRef);
+            self->isRoutingPlanValid = false;
             return APX_NO_ERROR;
          }
          return APX_NULL_PTR_ERROR;
@@ -959,6 +1136,21 @@ apx_error_t apx_nodeInstance_removeProvidePortConnector(apx_nodeInstance_t *self
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Waits until no router uses a routing plan older than the one currently published.
+ * Call this before deleting a node instance that was just removed from the connectors of this node.
+ * Must not be called from a router of this node instance.
+ */
+void apx_nodeInstance_synchronizeRouting(apx_nodeInstance_t *self)
+{
+   if (self != 0)
+   {
+      MUTEX_LOCK(self->connectorTableLock);
+      apx_epoch_synchronize(&self->routingEpoch);
+      MUTEX_UNLOCK(self->connectorTableLock);
+   }
+}
+
 /********** Port Connection Changes API  ************/
 apx_portConnectorChangeTable_t* apx_nodeInstance_getRequirePortConnectorChanges(apx_nodeInstance_t *self, bool autoCreate)
 {
@@ -1068,6 +1260,15 @@ apx_error_t apx_nodeInstance_handleRequirePortDataDisconnected(apx_nodeInstance_
             assert(entry->count == 0);
          }
       }
+      //The caller is about to release this node instance, routers of the provide nodes must no longer reference it
+      for (requirePortId = 0; requirePortId < numRequirePorts; requirePortId++)
+      {
+         apx_portConnectorChangeEntry_t *entry = apx_portConnectorChangeTable_getEntry(connectorChanges, requirePortId);
+         if (entry->count == -1)
+         {
+            apx_nodeInstance_synchronizeRouting(entry->data.portRef->nodeInstance);
+         }
+      }
       return APX_NO_ERROR;
    }
    return APX_INVALID_ARGUMENT_ERROR;
@@ -1112,21 +1313,17 @@ apx_error_t apx_nodeInstance_handleRequirePortWasConnectedToProvidePort(apx_port
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Call once per connector after it has been inserted using apx_nodeInstance_insertProvidePortConnector and the
+ * connector table has been unlocked. Copying the current value after the new routing plan has been published
+ * guarantees the require port either receives this copy or the routed value of any concurrent write.
+ */
 apx_error_t apx_nodeInstance_handleProvidePortWasConnectedToRequirePort(apx_portRef_t *providePortRef, apx_portRef_t *requirePortRef)
 {
    if ( (requirePortRef != 0) && (providePortRef != 0) )
    {
       apx_error_t rc;
-      apx_nodeInstance_t *provideNodeInstance;
-      provideNodeInstance = providePortRef->nodeInstance;
-      apx_portId_t providePortId = apx_portRef_getPortId(providePortRef);
-      assert(provideNodeInstance != 0);
-      assert(providePortId >= 0u);
-      rc = apx_nodeInstance_insertProvidePortConnector(provideNodeInstance, providePortId, requirePortRef);
-      if (rc != APX_NO_ERROR)
-      {
-         return rc;
-      }
+      assert(providePortRef->nodeInstance != 0);
       rc = apx_nodeInstance_routeProvidePortDataToRequirePortByRef(providePortRef, requirePortRef);
       if (rc != APX_NO_ERROR)
       {
@@ -1151,17 +1348,11 @@ apx_error_t apx_nodeInstance_sendRequirePortDataToFileManager(apx_nodeInstance_t
 {
    if ( self != 0 )
    {
-      uint8_t *dataBuf;
       size_t bufSize;
       apx_size_t fileSize;
-      uint32_t fileStartAddress;
-      apx_error_t rc;
       apx_file_t *file;
-      apx_fileManager_t *fileManager;
       file = self->requirePortDataFile;
       assert(file != 0);
-      fileManager = apx_file_getFileManager(file);
-      assert(fileManager != 0);
       assert(self->nodeData != 0);
       if (self->connection == 0)
       {
@@ -1169,7 +1360,6 @@ apx_error_t apx_nodeInstance_sendRequirePortDataToFileManager(apx_nodeInstance_t
       }
       bufSize = (size_t) apx_nodeData_getRequirePortDataLen(self->nodeData);
       fileSize = apx_file_getFileSize(file);
-      fileStartAddress = apx_file_getStartAddress(file);
       assert(fileSize > 0);
       if (fileSize != bufSize)
       {
@@ -1186,84 +1376,119 @@ apx_error_t apx_nodeInstance_sendRequirePortDataToFileManager(apx_nodeInstance_t
       {
          return APX_FILE_TOO_LARGE_ERROR;
       }
-      dataBuf = apx_connectionBase_alloc(self->connection, bufSize);
-      if (dataBuf == 0)
+      return apx_nodeInstance_sendRequirePortDataRange(self, 0u, fileSize);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Sends require port data in range [offset, offset+len) to the remote side as a single write.
+ * The range is typically the span of require ports that were connected by the same provide node.
+ * Large ranges are fragmented by the file manager worker.
+ */
+apx_error_t apx_nodeInstance_sendRequirePortDataRange(apx_nodeInstance_t *self, uint32_t offset, apx_size_t len)
+{
+   if ( self != 0 )
+   {
+      uint8_t stackBuf[STACK_DATA_BUF_SIZE];
+      uint8_t *dataBuf = &stackBuf[0];
+      apx_error_t rc;
+      assert(self->nodeData != 0);
+      if ( (self->connection == 0) || (self->requirePortDataFile == 0) )
       {
-         return APX_MEM_ERROR;
+         return APX_NOT_CONNECTED_ERROR;
       }
-      rc = apx_nodeData_readRequirePortData(self->nodeData, dataBuf, 0u, bufSize);
-      if (rc != APX_NO_ERROR)
+      if (len == 0u)
       {
-         apx_connectionBase_free(self->connection, dataBuf, bufSize);
+         return APX_NO_ERROR;
       }
-      return apx_fileManager_writeDynamicData(fileManager, fileStartAddress, fileSize, dataBuf);
+      if (len > STACK_DATA_BUF_SIZE)
+      {
+         dataBuf = (uint8_t*) malloc(len);
+         if (dataBuf == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      rc = apx_nodeData_readRequirePortData(self->nodeData, dataBuf, offset, len);
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_connectionBase_updateRequirePortDataDirect(self->connection, self->requirePortDataFile, dataBuf, offset, len);
+      }
+      if (dataBuf != &stackBuf[0])
+      {
+         free(dataBuf);
+      }
+      return rc;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Writes provide port data in range [offset, offset+len) to all connected require ports.
+ * The write may span several provide ports and may start or end in the middle of a port, each connected require port
+ * receives the part of the write that overlaps its provide port.
+ * Routing never takes connectorTableLock, it uses the most recently published routing plan.
+ * A receiver that fails does not stop the write from reaching the others, the first error is returned.
+ */
 apx_error_t apx_nodeInstance_routeProvidePortDataToReceivers(apx_nodeInstance_t *self, const uint8_t *src, uint32_t offset, apx_size_t len)
 {
-   if ( (self != 0) )
+   if ( (self != 0) && (src != 0) )
    {
+      apx_error_t retval = APX_NO_ERROR;
       uint32_t endOffset;
+      uint32_t epoch;
+      const apx_routingPlan_t *routingPlan;
       assert(self->nodeInfo != 0);
       assert(self->connectorTable != 0);
       endOffset = offset + len;
-      MUTEX_LOCK(self->connectorTableLock);
-      while(offset < endOffset)
+      epoch = apx_epoch_enter(&self->routingEpoch);
+      routingPlan = (const apx_routingPlan_t*) ATOMIC_LOAD_PTR(&self->routingPlan);
+      if (routingPlan != 0)
       {
-         apx_error_t rc;
-         int32_t numConnectors;
-         int32_t connectorId;
-         apx_portId_t providerPortId;
-         apx_portConnectorList_t *portConnectors;
-         const apx_portDataProps_t *providePortDataProps;
-         providerPortId = apx_nodeInfo_findProvidePortIdFromByteOffset(self->nodeInfo, offset);
-         if (providerPortId < 0)
-         {
-            printf("[APX_NODEINSTANCE] detected write on invalid offset %d\n", offset);
-            break;
-         }
-         providePortDataProps = apx_nodeInfo_getProvidePortDataProps(self->nodeInfo, providerPortId);
-         assert(providePortDataProps != 0);
-         offset += providePortDataProps->dataSize; ///TODO: Verify if this also works for complex data
-         portConnectors = &self->connectorTable[providerPortId];
-         numConnectors = apx_portConnectorList_length(portConnectors);
-         for(connectorId = 0; connectorId < numConnectors; connectorId++)
+         const apx_routingPlanRange_t *range = apx_routingPlan_findFirstRange(routingPlan, offset);
+         const apx_routingPlanRange_t *rangeEnd = apx_routingPlan_rangeEnd(routingPlan);
+         for (; (range < rangeEnd) && (range->offset < endOffset); range++)
          {
-            const apx_portDataProps_t *requireePortDataProps;
-            apx_portRef_t *requirePortRef = apx_portConnectorList_get(portConnectors, connectorId);
-            requireePortDataProps = requirePortRef->portDataProps;
-            if (apx_portDataProps_isPlainOldData(requireePortDataProps))
+            int32_t entryId;
+            uint32_t beginOffset = (range->offset > offset)? range->offset : offset;
+            uint32_t rangeEndOffset = range->offset + range->dataSize;
+            uint32_t dataLen = ( (rangeEndOffset < endOffset)? rangeEndOffset : endOffset) - beginOffset;
+            uint32_t portOffset = beginOffset - range->offset; //non-zero when write starts in the middle of this port
+            const uint8_t *data = src + (beginOffset - offset);
+            for (entryId = range->beginEntry; entryId < range->endEntry; entryId++)
             {
-               if (requireePortDataProps->dataSize != len)
+               const apx_routingPlanEntry_t *entry = &routingPlan->entries[entryId];
+               apx_error_t rc = apx_nodeInstance_writeRequirePortData(entry->destNodeInstance, data, entry->destOffset + portOffset, dataLen);
+               if ( (rc != APX_NO_ERROR) && (retval == APX_NO_ERROR) )
                {
-                  MUTEX_UNLOCK(self->connectorTableLock);
-                  return APX_LENGTH_ERROR;
-               }
-               rc = apx_nodeInstance_writeRequirePortData(requirePortRef->nodeInstance, src, requireePortDataProps->offset, requireePortDataProps->dataSize);
-               if (rc != APX_NO_ERROR)
-               {
-                  MUTEX_UNLOCK(self->connectorTableLock);
-                  return rc;
+                  retval = rc;
                }
             }
          }
       }
-
-      MUTEX_UNLOCK(self->connectorTableLock);
-      return APX_NO_ERROR;
+      apx_epoch_exit(&self->routingEpoch, epoch);
+      return retval;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
 void apx_nodeInstance_clearConnectorTable(apx_nodeInstance_t *self)
 {
-   if (self != 0)
+   if ( (self != 0) && (self->connectorTable != 0) )
    {
-      MUTEX_LOCK(self->connectorTableLock);
-      apx_portConnectorList_clear(self->connectorTable);
-      MUTEX_UNLOCK(self->connectorTableLock);
+      apx_portId_t portId;
+      apx_portCount_t numProvidePorts;
+      assert(self->nodeInfo != 0);
+      numProvidePorts = apx_nodeInfo_getNumProvidePorts(self->nodeInfo);
+      apx_nodeInstance_lockPortConnectorTable(self);
+      for (portId = 0; portId < numProvidePorts; portId++)
+      {
+         apx_portConnectorList_clear(&self->connectorTable[portId]);
+      }
+      self->isRoutingPlanValid = false;
+      apx_nodeInstance_unlockPortConnectorTable(self);
+      apx_nodeInstance_synchronizeRouting(self);
    }
 }
 
@@ -1288,6 +1513,26 @@ const adt_bytes_t *apx_nodeInstance_getRequirePortUnpackProgram(apx_nodeInstance
    return (const adt_bytes_t*) 0;
 }
 
+const apx_vmOpTable_t *apx_nodeInstance_getProvidePortPackOpTable(apx_nodeInstance_t *self, apx_portId_t providePortId)
+{
+   if (self != 0)
+   {
+      assert(self->nodeInfo != 0);
+      return apx_nodeInfo_getProvidePortPackOpTable(self->nodeInfo, providePortId);
+   }
+   return (const apx_vmOpTable_t*) 0;
+}
+
+const apx_vmOpTable_t *apx_nodeInstance_getRequirePortUnpackOpTable(apx_nodeInstance_t *self, apx_portId_t requirePortId)
+{
+   if (self != 0)
+   {
+      assert(self->nodeInfo != 0);
+      return apx_nodeInfo_getRequirePortUnpackOpTable(self->nodeInfo, requirePortId);
+   }
+   return (const apx_vmOpTable_t*) 0;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
@@ -1351,7 +1596,7 @@ static apx_error_t apx_nodeInstance_definitionFileReadData(void *arg, apx_file_t
 }
 
 
-static apx_error_t apx_nodeInstance_createFileInfo(apx_nodeInstance_t *self, const char *fileExtension, uint32_t fileSize, apx_fileInfo_t *fileInfo)
+static apx_error_t apx_nodeInstance_createFileInfo(apx_nodeInstance_t *self, const char *fileExtension, uint32_t fileSize, uint16_t digestType, const uint8_t *digestData, apx_fileInfo_t *fileInfo)
 {
    if ( (self != 0) && (fileInfo != 0))
    {
@@ -1368,11 +1613,24 @@ static apx_error_t apx_nodeInstance_createFileInfo(apx_nodeInstance_t *self, con
       }
       strcpy(fileName, nodeName);
       strcat(fileName, fileExtension);
-      return apx_fileInfo_create(fileInfo, RMF_INVALID_ADDRESS, fileSize, fileName, RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, (const uint8_t*) 0);
+      return apx_fileInfo_create(fileInfo, RMF_INVALID_ADDRESS, fileSize, fileName, RMF_FILE_TYPE_FIXED, digestType, digestData);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+static void apx_nodeInstance_nodeInfoReady(apx_nodeInstance_t *self)
+{
+   assert(self->nodeInfo != 0);
+   if (self->mode == APX_SERVER_MODE)
+   {
+      self->portSignatureStripes = apx_portSignatureMap_calcStripeMask(self->nodeInfo);
+   }
+   if (self->connection != 0)
+   {
+      apx_connectionBase_addAllocatorSizeClasses(self->connection, self->nodeInfo);
+   }
+}
+
 static apx_error_t apx_nodeInstance_providePortDataFileWriteNotify(void *arg, apx_file_t *file, uint32_t offset, const uint8_t *src, uint32_t len)
 {
    apx_nodeInstance_t *self = (apx_nodeInstance_t*) arg;
@@ -1533,9 +1791,9 @@ static apx_error_t apx_nodeInstance_routeProvidePortDataToRequirePortByRef(apx_p
                providePortDataBuf,
                requirePortDataProps->offset,
                requirePortDataProps->dataSize);
+         if (isDataBufMalloced) free(providePortDataBuf);
          if (rc != APX_NO_ERROR)
          {
-            if (isDataBufMalloced) free(providePortDataBuf);
             return rc;
          }
       }
@@ -1551,3 +1809,62 @@ static apx_error_t apx_nodeInstance_routeProvidePortDataToRequirePortByRef(apx_p
    return APX_NO_ERROR;
 }
 
+/**
+ * Builds a new routing plan from connectorTable and publishes it to the routers.
+ * The previous plan is reclaimed once no router references it.
+ * The caller must hold connectorTableLock.
+ */
+static apx_error_t apx_nodeInstance_publishRoutingPlan(apx_nodeInstance_t *self)
+{
+   apx_error_t rc;
+   apx_routingPlan_t *oldPlan;
+   apx_routingPlan_t *newPlan = apx_routingPlan_new();
+   assert(self->nodeInfo != 0);
+   if (newPlan == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   rc = apx_routingPlan_build(newPlan, self->providePortReferences, self->connectorTable, apx_nodeInfo_getNumProvidePorts(self->nodeInfo));
+   if (rc != APX_NO_ERROR)
+   {
+      apx_routingPlan_delete(newPlan);
+      return rc;
+   }
+   oldPlan = (apx_routingPlan_t*) ATOMIC_EXCHANGE_PTR(&self->routingPlan, newPlan);
+   self->isRoutingPlanValid = true;
+   if (oldPlan != 0)
+   {
+      rc = apx_epoch_retire(&self->routingEpoch, oldPlan, apx_routingPlan_vdelete);
+   }
+   return rc;
+}
+
+/**
+ * Forwards a provide-port write to the remote side. Called with the port data lock held (apx_nodeData_forwardFunc).
+ */
+static apx_error_t apx_nodeInstance_forwardProvidePortData(void *arg, const uint8_t *data, uint32_t offset, apx_size_t len)
+{
+   apx_nodeInstance_t *self = (apx_nodeInstance_t*) arg;
+   if (self->connection != 0)
+   {
+      assert(self->providePortDataFile != 0);
+      return apx_connectionBase_updateProvidePortDataDirect(self->connection, self->providePortDataFile, data, offset, len);
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_size_t apx_nodeInstance_calcMaxProvidePortDataSize(apx_nodeInfo_t *nodeInfo)
+{
+   apx_size_t retval = 0u;
+   apx_portId_t portId;
+   apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
+   for (portId = 0; portId < numProvidePorts; portId++)
+   {
+      const apx_portDataProps_t *portDataProps = apx_nodeInfo_getProvidePortDataProps(nodeInfo, portId);
+      if ( (portDataProps != 0) && (portDataProps->dataSize > retval) )
+      {
+         retval = portDataProps->dataSize;
+      }
+   }
+   return retval;
+}
@@ -32,6 +32,8 @@
 #include <assert.h>
 #include <stdio.h>
 #include "apx_nodeManager.h"
+#include "apx_sha256.h"
+#include "apx_definitionCache.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -44,6 +46,7 @@
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_nodeManager_buildNodeInfo(apx_nodeManager_t *self, apx_nodeInstance_t *nodeInstance, const uint8_t *digest, apx_size_t definitionLen);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -77,6 +80,7 @@ void apx_nodeManager_create(apx_nodeManager_t *self, apx_mode_t mode, bool useWe
       apx_istream_create(&self->apx_istream, &apx_istream_handler);
       apx_parser_create(&self->parser);
       self->lastAttached = (apx_nodeInstance_t*) 0;
+      self->definitionCache = (apx_definitionCache_t*) 0;
       self->mode = mode;
       adt_hash_create(&self->nodeInstanceMap, instanceMapDestructor);
       SPINLOCK_INIT(self->lock);
@@ -126,9 +130,8 @@ apx_error_t apx_nodeManager_buildNode_cstr(apx_nodeManager_t *self, const char *
          apx_nodeInstance_t *nodeInstance = apx_nodeInstance_new(self->mode);
          if (nodeInstance != 0)
          {
-            apx_programType_t errProgramType;
-            apx_uniquePortId_t errPortId;
             apx_error_t rc;
+            uint8_t digest[APX_SHA256_DIGEST_SIZE];
             apx_nodeData_t *nodeData = apx_nodeInstance_getNodeData(nodeInstance);
 
             rc = apx_nodeData_createDefinitionBuffer(nodeData, definition_len );
@@ -143,13 +146,9 @@ apx_error_t apx_nodeManager_buildNode_cstr(apx_nodeManager_t *self, const char *
                apx_nodeInstance_delete(nodeInstance);
                return rc;
             }
-            rc = apx_nodeInstance_parseDefinition(nodeInstance, &self->parser);
-            if (rc != APX_NO_ERROR)
-            {
-               apx_nodeInstance_delete(nodeInstance);
-               return rc;
-            }
-            rc = apx_nodeInstance_buildNodeInfo(nodeInstance, &errProgramType, &errPortId);
+            apx_sha256_calc((const uint8_t*) definition_text, definition_len, &digest[0]);
+            apx_nodeData_setDefinitionChecksumData(nodeData, APX_CHECKSUM_SHA256, &digest[0]);
+            rc = apx_nodeManager_buildNodeInfo(self, nodeInstance, &digest[0], definition_len);
             if (rc != APX_NO_ERROR)
             {
                apx_nodeInstance_delete(nodeInstance);
@@ -211,6 +210,19 @@ apx_error_t apx_nodeManager_attachNode(apx_nodeManager_t *self, apx_nodeInstance
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * When set, apx_nodeManager_buildNode_cstr reuses the nodeInfo of any earlier node built from the exact same definition text
+ * instead of parsing and compiling it again. Each node instance still gets its own port data buffers and port references.
+ * A cache can be shared by any number of node managers, as long as they all use the same mode.
+ */
+void apx_nodeManager_setDefinitionCache(apx_nodeManager_t *self, apx_definitionCache_t *definitionCache)
+{
+   if (self != 0)
+   {
+      self->definitionCache = definitionCache;
+   }
+}
+
 /********** Server mode API  ************/
 
 apx_nodeInstance_t *apx_nodeManager_createNode(apx_nodeManager_t *self, const char *nodeName)
@@ -317,4 +329,38 @@ int32_t apx_nodeManager_getLastErrorLine(apx_nodeManager_t *self)
 // PRIVATE FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Attaches a shared nodeInfo from the definition cache. On a cache miss the definition is parsed and compiled
+ * and the result is added to the cache.
+ */
+static apx_error_t apx_nodeManager_buildNodeInfo(apx_nodeManager_t *self, apx_nodeInstance_t *nodeInstance, const uint8_t *digest, apx_size_t definitionLen)
+{
+   apx_programType_t errProgramType;
+   apx_uniquePortId_t errPortId;
+   apx_error_t rc;
+   if (self->definitionCache != 0)
+   {
+      apx_nodeInfo_t *nodeInfo = apx_definitionCache_find(self->definitionCache, digest, (uint32_t) definitionLen);
+      if (nodeInfo != 0)
+      {
+         rc = apx_nodeInstance_attachNodeInfo(nodeInstance, nodeInfo);
+         apx_nodeInfo_release(nodeInfo);
+         return rc;
+      }
+   }
+   rc = apx_nodeInstance_parseDefinition(nodeInstance, &self->parser);
+   if (rc != APX_NO_ERROR)
+   {
+      return rc;
+   }
+   rc = apx_nodeInstance_buildNodeInfo(nodeInstance, &errProgramType, &errPortId);
+   if ( (rc == APX_NO_ERROR) && (self->definitionCache != 0) )
+   {
+      apx_nodeInfo_t *nodeInfo = apx_nodeInstance_getNodeInfo(nodeInstance);
+      assert(nodeInfo != 0);
+      (void) apx_definitionCache_insert(self->definitionCache, digest, (uint32_t) definitionLen, nodeInfo);
+   }
+   return rc;
+}
+
 
@@ -32,24 +32,34 @@
 #include <stdio.h> //DEBUG ONLY
 #include "apx_portSignatureMap.h"
 #include "apx_nodeInstance.h"
+#include "apx_signatureTable.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
 //////////////////////////////////////////////////////////////////////////////
 // CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#define STRIPE_MIN_CAPACITY 16u
 
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
 static apx_error_t apx_portSignatureMap_connectRequirePortsInternal(apx_portSignatureMap_t *self, apx_nodeInstance_t *nodeInstance, apx_nodeInfo_t *nodeInfo);
 static apx_error_t apx_portSignatureMap_connectProvidePortsInternal(apx_portSignatureMap_t *self, apx_nodeInstance_t *nodeInstance, apx_nodeInfo_t *nodeInfo);
-static apx_error_t apx_portSignatureMap_insert(apx_portSignatureMap_t *self, const char *portSignature, apx_portRef_t *portRef);
-static apx_portSignatureMapEntry_t *apx_portSignatureMap_createNewEntry(apx_portSignatureMap_t *self, const char *portSignature);
+static apx_error_t apx_portSignatureMap_insert(apx_portSignatureMap_t *self, apx_signatureId_t signatureId, apx_portRef_t *portRef);
+static apx_portSignatureMapEntry_t *apx_portSignatureMap_createNewEntry(apx_portSignatureMap_t *self, apx_signatureId_t signatureId);
 static apx_error_t apx_portSignatureMap_disconnectRequirePortsInternal(apx_portSignatureMap_t *self, apx_nodeInstance_t *nodeInstance, apx_nodeInfo_t *nodeInfo);
 static apx_error_t apx_portSignatureMap_disconnectProvidePortsInternal(apx_portSignatureMap_t *self, apx_nodeInstance_t *nodeInstance, apx_nodeInfo_t *nodeInfo);
-static apx_error_t apx_portSignatureMap_remove(apx_portSignatureMap_t *self, const char *portSignature, apx_portRef_t *portRef);
-static void apx_portSignatureMap_deleteEntry(apx_portSignatureMap_t *self, const char *portSignature);
+static apx_error_t apx_portSignatureMap_remove(apx_portSignatureMap_t *self, apx_signatureId_t signatureId, apx_portRef_t *portRef);
+static void apx_portSignatureMap_deleteEntry(apx_portSignatureMap_t *self, apx_signatureId_t signatureId);
+static uint64_t apx_portSignatureMap_hash(apx_signatureId_t signatureId);
+static apx_portSignatureMapStripe_t *apx_portSignatureMap_getStripe(apx_portSignatureMap_t *self, apx_signatureId_t signatureId);
+static apx_portSignatureMapSlot_t *apx_portSignatureMap_findSlot(apx_portSignatureMapStripe_t *stripe, apx_signatureId_t signatureId);
+static apx_error_t apx_portSignatureMap_insertSlot(apx_portSignatureMapStripe_t *stripe, apx_signatureId_t signatureId, apx_portSignatureMapEntry_t *entry);
+static apx_portSignatureMapEntry_t *apx_portSignatureMap_removeSlot(apx_portSignatureMapStripe_t *stripe, apx_signatureId_t signatureId);
+static apx_error_t apx_portSignatureMap_growStripe(apx_portSignatureMapStripe_t *stripe);
+static uint32_t apx_portSignatureMap_calcAffectedStripesInternal(apx_portSignatureMap_t *self, apx_signatureId_t signatureId);
+static uint32_t apx_portSignatureMap_calcPortRefListStripes(adt_list_t *portRefList);
 
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL VARIABLES
@@ -62,33 +72,89 @@ void apx_portSignatureMap_create(apx_portSignatureMap_t *self)
 {
    if (self != 0)
    {
-      adt_hash_create(&self->internalMap, apx_portSignatureMapEntry_vdelete);
+      int32_t i;
+      for (i = 0; i < APX_PORT_SIGNATURE_MAP_NUM_STRIPES; i++)
+      {
+         self->stripes[i].slots = (apx_portSignatureMapSlot_t*) 0;
+         self->stripes[i].capacity = 0u;
+         self->stripes[i].length = 0u;
+         MUTEX_INIT(self->stripes[i].lock);
+      }
    }
 }
 
 void apx_portSignatureMap_destroy(apx_portSignatureMap_t *self)
 {
-   adt_hash_destroy(&self->internalMap);
+   if (self != 0)
+   {
+      int32_t i;
+      for (i = 0; i < APX_PORT_SIGNATURE_MAP_NUM_STRIPES; i++)
+      {
+         apx_portSignatureMapStripe_t *stripe = &self->stripes[i];
+         if (stripe->slots != 0)
+         {
+            uint32_t j;
+            for (j = 0u; j < stripe->capacity; j++)
+            {
+               if (stripe->slots[j].signatureId != APX_INVALID_SIGNATURE_ID)
+               {
+                  apx_portSignatureMapEntry_delete(stripe->slots[j].entry);
+               }
+            }
+            free(stripe->slots);
+         }
+         MUTEX_DESTROY(stripe->lock);
+      }
+   }
 }
 
+/**
+ * Finds entry using the port signature string. This is a convenience function, connect and disconnect use the interned ids.
+ * Note: Caller must hold the stripe lock of portSignature
+ */
 apx_portSignatureMapEntry_t *apx_portSignatureMap_find(apx_portSignatureMap_t *self, const char *portSignature)
 {
    if ( (self != 0) && (portSignature != 0) )
    {
-      void **ppResult = adt_hash_get(&self->internalMap, portSignature);
-      if (ppResult != 0)
+      apx_signatureId_t signatureId = apx_signatureTable_find(apx_signatureTable_getGlobal(), portSignature);
+      if (signatureId != APX_INVALID_SIGNATURE_ID)
+      {
+         return apx_portSignatureMap_findById(self, signatureId);
+      }
+   }
+   return (apx_portSignatureMapEntry_t*) 0;
+}
+
+/**
+ * Note: Caller must hold the stripe lock of signatureId
+ */
+apx_portSignatureMapEntry_t *apx_portSignatureMap_findById(apx_portSignatureMap_t *self, apx_signatureId_t signatureId)
+{
+   if ( (self != 0) && (signatureId != APX_INVALID_SIGNATURE_ID) )
+   {
+      apx_portSignatureMapSlot_t *slot = apx_portSignatureMap_findSlot(apx_portSignatureMap_getStripe(self, signatureId), signatureId);
+      if (slot != 0)
       {
-         return (apx_portSignatureMapEntry_t*) *ppResult;
+         return slot->entry;
       }
    }
    return (apx_portSignatureMapEntry_t*) 0;
 }
 
+/**
+ * Note: Caller must hold all stripe locks
+ */
 int32_t apx_portSignatureMap_length(apx_portSignatureMap_t *self)
 {
    if (self != 0)
    {
-      return adt_hash_length(&self->internalMap);
+      int32_t i;
+      int32_t retval = 0;
+      for (i = 0; i < APX_PORT_SIGNATURE_MAP_NUM_STRIPES; i++)
+      {
+         retval += (int32_t) self->stripes[i].length;
+      }
+      return retval;
    }
    return -1;
 }
@@ -182,6 +248,101 @@ apx_error_t apx_portSignatureMap_disconnectRequirePorts(apx_portSignatureMap_t *
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Returns the index of the stripe where signatureId is stored
+ */
+uint32_t apx_portSignatureMap_getStripeIndex(apx_signatureId_t signatureId)
+{
+   return (uint32_t) (apx_portSignatureMap_hash(signatureId) & (APX_PORT_SIGNATURE_MAP_NUM_STRIPES - 1u));
+}
+
+/**
+ * Returns a bit mask of all stripes used by the port signatures of nodeInfo.
+ * The result only depends on the port signatures which means it can be calculated once and cached.
+ */
+uint32_t apx_portSignatureMap_calcStripeMask(struct apx_nodeInfo_tag *nodeInfo)
+{
+   uint32_t stripeMask = 0u;
+   if (nodeInfo != 0)
+   {
+      apx_portId_t portId;
+      apx_portCount_t numRequirePorts = apx_nodeInfo_getNumRequirePorts(nodeInfo);
+      apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
+      for(portId = 0; portId < numRequirePorts; portId++)
+      {
+         stripeMask |= (1u << apx_portSignatureMap_getStripeIndex(apx_nodeInfo_getRequirePortSignatureId(nodeInfo, portId)));
+      }
+      for(portId = 0; portId < numProvidePorts; portId++)
+      {
+         stripeMask |= (1u << apx_portSignatureMap_getStripeIndex(apx_nodeInfo_getProvidePortSignatureId(nodeInfo, portId)));
+      }
+   }
+   return stripeMask;
+}
+
+/**
+ * Returns the union of the stripe masks of nodeInstance and all nodes currently sharing a port signature with it.
+ * These are the nodes whose port connector change tables can be modified when nodeInstance connects or disconnects.
+ * Note: Caller must hold the stripe locks of nodeInstance
+ */
+uint32_t apx_portSignatureMap_calcAffectedStripes(apx_portSignatureMap_t *self, struct apx_nodeInstance_tag *nodeInstance)
+{
+   uint32_t stripeMask = 0u;
+   if ( (self != 0) && (nodeInstance != 0) )
+   {
+      apx_nodeInfo_t *nodeInfo = apx_nodeInstance_getNodeInfo(nodeInstance);
+      stripeMask = apx_nodeInstance_getPortSignatureStripes(nodeInstance);
+      if (nodeInfo != 0)
+      {
+         apx_portId_t portId;
+         apx_portCount_t numRequirePorts = apx_nodeInfo_getNumRequirePorts(nodeInfo);
+         apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
+         for(portId = 0; portId < numRequirePorts; portId++)
+         {
+            stripeMask |= apx_portSignatureMap_calcAffectedStripesInternal(self, apx_nodeInfo_getRequirePortSignatureId(nodeInfo, portId));
+         }
+         for(portId = 0; portId < numProvidePorts; portId++)
+         {
+            stripeMask |= apx_portSignatureMap_calcAffectedStripesInternal(self, apx_nodeInfo_getProvidePortSignatureId(nodeInfo, portId));
+         }
+      }
+   }
+   return stripeMask;
+}
+
+/**
+ * Locks all stripes in stripeMask. Stripes are always taken in ascending order to prevent deadlocks.
+ */
+void apx_portSignatureMap_lockStripes(apx_portSignatureMap_t *self, uint32_t stripeMask)
+{
+   if (self != 0)
+   {
+      int32_t i;
+      for (i = 0; i < APX_PORT_SIGNATURE_MAP_NUM_STRIPES; i++)
+      {
+         if ( (stripeMask & (1u << i)) != 0u)
+         {
+            MUTEX_LOCK(self->stripes[i].lock);
+         }
+      }
+   }
+}
+
+void apx_portSignatureMap_unlockStripes(apx_portSignatureMap_t *self, uint32_t stripeMask)
+{
+   if (self != 0)
+   {
+      int32_t i;
+      for (i = APX_PORT_SIGNATURE_MAP_NUM_STRIPES - 1; i >= 0; i--)
+      {
+         if ( (stripeMask & (1u << i)) != 0u)
+         {
+            MUTEX_UNLOCK(self->stripes[i].lock);
+         }
+      }
+   }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
@@ -191,12 +352,12 @@ static apx_error_t apx_portSignatureMap_connectRequirePortsInternal(apx_portSign
    apx_portCount_t numRequirePorts = apx_nodeInfo_getNumRequirePorts(nodeInfo);
    for(portId = 0; portId < numRequirePorts; portId++)
    {
-      const char *portSignature;
+      apx_signatureId_t signatureId;
       apx_error_t rc;
       apx_portRef_t *portRef;
-      portSignature = apx_nodeInfo_getRequirePortSignature(nodeInfo, portId);
+      signatureId = apx_nodeInfo_getRequirePortSignatureId(nodeInfo, portId);
       portRef = apx_nodeInstance_getRequirePortRef(nodeInstance, portId);
-      rc = apx_portSignatureMap_insert(self, portSignature, portRef);
+      rc = apx_portSignatureMap_insert(self, signatureId, portRef);
       if (rc != APX_NO_ERROR)
       {
          return rc;
@@ -211,12 +372,12 @@ static apx_error_t apx_portSignatureMap_connectProvidePortsInternal(apx_portSign
    apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
    for(portId = 0; portId < numProvidePorts; portId++)
    {
-      const char *portSignature;
+      apx_signatureId_t signatureId;
       apx_error_t rc;
       apx_portRef_t *portRef;
-      portSignature = apx_nodeInfo_getProvidePortSignature(nodeInfo, portId);
+      signatureId = apx_nodeInfo_getProvidePortSignatureId(nodeInfo, portId);
       portRef = apx_nodeInstance_getProvidePortRef(nodeInstance, portId);
-      rc = apx_portSignatureMap_insert(self, portSignature, portRef);
+      rc = apx_portSignatureMap_insert(self, signatureId, portRef);
       if (rc != APX_NO_ERROR)
       {
          return rc;
@@ -225,17 +386,19 @@ static apx_error_t apx_portSignatureMap_connectProvidePortsInternal(apx_portSign
    return APX_NO_ERROR;
 }
 
-static apx_error_t apx_portSignatureMap_insert(apx_portSignatureMap_t *self, const char *portSignature, apx_portRef_t *portRef)
+static apx_error_t apx_portSignatureMap_insert(apx_portSignatureMap_t *self, apx_signatureId_t signatureId, apx_portRef_t *portRef)
 {
    apx_portSignatureMapEntry_t *entry;
    assert(self != 0);
-   assert(portSignature != 0);
-   assert(strlen(portSignature) > 0);
    assert(portRef != 0);
-   entry = apx_portSignatureMap_find(self, portSignature);
+   if (signatureId == APX_INVALID_SIGNATURE_ID)
+   {
+      return APX_PORT_SIGNATURE_ERROR; //nodeInfo was not built in server mode
+   }
+   entry = apx_portSignatureMap_findById(self, signatureId);
    if (entry == 0)
    {
-      entry = apx_portSignatureMap_createNewEntry(self, portSignature);
+      entry = apx_portSignatureMap_createNewEntry(self, signatureId);
       if (entry == 0)
       {
          return APX_MEM_ERROR;
@@ -255,12 +418,16 @@ static apx_error_t apx_portSignatureMap_insert(apx_portSignatureMap_t *self, con
    return APX_NO_ERROR;
 }
 
-static apx_portSignatureMapEntry_t *apx_portSignatureMap_createNewEntry(apx_portSignatureMap_t *self, const char *portSignature)
+static apx_portSignatureMapEntry_t *apx_portSignatureMap_createNewEntry(apx_portSignatureMap_t *self, apx_signatureId_t signatureId)
 {
    apx_portSignatureMapEntry_t *entry = apx_portSignatureMapEntry_new();
    if (entry != 0)
    {
-      adt_hash_set(&self->internalMap, portSignature, entry);
+      if (apx_portSignatureMap_insertSlot(apx_portSignatureMap_getStripe(self, signatureId), signatureId, entry) != APX_NO_ERROR)
+      {
+         apx_portSignatureMapEntry_delete(entry);
+         entry = (apx_portSignatureMapEntry_t*) 0;
+      }
    }
    return entry;
 }
@@ -271,12 +438,12 @@ static apx_error_t apx_portSignatureMap_disconnectRequirePortsInternal(apx_portS
    apx_portCount_t numRequirePorts = apx_nodeInfo_getNumRequirePorts(nodeInfo);
    for(portId = 0; portId < numRequirePorts; portId++)
    {
-      const char *portSignature;
+      apx_signatureId_t signatureId;
       apx_error_t rc;
       apx_portRef_t *portRef;
-      portSignature = apx_nodeInfo_getRequirePortSignature(nodeInfo, portId);
+      signatureId = apx_nodeInfo_getRequirePortSignatureId(nodeInfo, portId);
       portRef = apx_nodeInstance_getRequirePortRef(nodeInstance, portId);
-      rc = apx_portSignatureMap_remove(self, portSignature, portRef);
+      rc = apx_portSignatureMap_remove(self, signatureId, portRef);
       if (rc != APX_NO_ERROR)
       {
          return rc;
@@ -291,12 +458,12 @@ static apx_error_t apx_portSignatureMap_disconnectProvidePortsInternal(apx_portS
    apx_portCount_t numProvidePorts = apx_nodeInfo_getNumProvidePorts(nodeInfo);
    for(portId = 0; portId < numProvidePorts; portId++)
    {
-      const char *portSignature;
+      apx_signatureId_t signatureId;
       apx_error_t rc;
       apx_portRef_t *portRef;
-      portSignature = apx_nodeInfo_getProvidePortSignature(nodeInfo, portId);
+      signatureId = apx_nodeInfo_getProvidePortSignatureId(nodeInfo, portId);
       portRef = apx_nodeInstance_getProvidePortRef(nodeInstance, portId);
-      rc = apx_portSignatureMap_remove(self, portSignature, portRef);
+      rc = apx_portSignatureMap_remove(self, signatureId, portRef);
       if (rc != APX_NO_ERROR)
       {
          return rc;
@@ -306,14 +473,12 @@ static apx_error_t apx_portSignatureMap_disconnectProvidePortsInternal(apx_portS
 }
 
 
-static apx_error_t apx_portSignatureMap_remove(apx_portSignatureMap_t *self, const char *portSignature, apx_portRef_t *portRef)
+static apx_error_t apx_portSignatureMap_remove(apx_portSignatureMap_t *self, apx_signatureId_t signatureId, apx_portRef_t *portRef)
 {
    apx_portSignatureMapEntry_t *entry;
    assert(self != 0);
-   assert(portSignature != 0);
-   assert(strlen(portSignature) > 0);
    assert(portRef != 0);
-   entry = apx_portSignatureMap_find(self, portSignature);
+   entry = apx_portSignatureMap_findById(self, signatureId);
    if (entry == 0)
    {
       return APX_NOT_FOUND_ERROR;
@@ -331,19 +496,180 @@ static apx_error_t apx_portSignatureMap_remove(apx_portSignatureMap_t *self, con
    }
    if (apx_portSignatureMapEntry_isEmpty(entry))
    {
-      apx_portSignatureMap_deleteEntry(self, portSignature);
+      apx_portSignatureMap_deleteEntry(self, signatureId);
    }
    return APX_NO_ERROR;
 }
 
-static void apx_portSignatureMap_deleteEntry(apx_portSignatureMap_t *self, const char *portSignature)
+static void apx_portSignatureMap_deleteEntry(apx_portSignatureMap_t *self, apx_signatureId_t signatureId)
 {
-   if ( (self != 0) && (portSignature != 0) )
+   if (self != 0)
    {
-      apx_portSignatureMapEntry_t *entry = (apx_portSignatureMapEntry_t*) adt_hash_remove(&self->internalMap, portSignature);
+      apx_portSignatureMapEntry_t *entry = apx_portSignatureMap_removeSlot(apx_portSignatureMap_getStripe(self, signatureId), signatureId);
       if (entry != 0)
       {
          apx_portSignatureMapEntry_delete(entry);
       }
    }
 }
+
+/**
+ * Signature ids are handed out sequentially, mix the bits before using them for stripe and slot selection (splitmix64 finalizer).
+ * The low bits select the stripe, the high bits select the slot within the stripe.
+ */
+static uint64_t apx_portSignatureMap_hash(apx_signatureId_t signatureId)
+{
+   uint64_t x = (uint64_t) signatureId;
+   x ^= (x >> 30);
+   x *= 0xBF58476D1CE4E5B9ull;
+   x ^= (x >> 27);
+   x *= 0x94D049BB133111EBull;
+   x ^= (x >> 31);
+   return x;
+}
+
+static apx_portSignatureMapStripe_t *apx_portSignatureMap_getStripe(apx_portSignatureMap_t *self, apx_signatureId_t signatureId)
+{
+   return &self->stripes[apx_portSignatureMap_getStripeIndex(signatureId)];
+}
+
+static apx_portSignatureMapSlot_t *apx_portSignatureMap_findSlot(apx_portSignatureMapStripe_t *stripe, apx_signatureId_t signatureId)
+{
+   if (stripe->length > 0u)
+   {
+      uint32_t mask = stripe->capacity - 1u;
+      uint32_t i = ((uint32_t) (apx_portSignatureMap_hash(signatureId) >> 32)) & mask;
+      for (;;)
+      {
+         apx_portSignatureMapSlot_t *slot = &stripe->slots[i];
+         if (slot->signatureId == signatureId)
+         {
+            return slot;
+         }
+         else if (slot->signatureId == APX_INVALID_SIGNATURE_ID)
+         {
+            break;
+         }
+         i = (i + 1u) & mask;
+      }
+   }
+   return (apx_portSignatureMapSlot_t*) 0;
+}
+
+static apx_error_t apx_portSignatureMap_insertSlot(apx_portSignatureMapStripe_t *stripe, apx_signatureId_t signatureId, apx_portSignatureMapEntry_t *entry)
+{
+   uint32_t mask;
+   uint32_t i;
+   //Keep load factor at or below 3/4
+   if ( ((stripe->length + 1u) * 4u) > (stripe->capacity * 3u) )
+   {
+      apx_error_t rc = apx_portSignatureMap_growStripe(stripe);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+   }
+   mask = stripe->capacity - 1u;
+   i = ((uint32_t) (apx_portSignatureMap_hash(signatureId) >> 32)) & mask;
+   while (stripe->slots[i].signatureId != APX_INVALID_SIGNATURE_ID)
+   {
+      assert(stripe->slots[i].signatureId != signatureId);
+      i = (i + 1u) & mask;
+   }
+   stripe->slots[i].signatureId = signatureId;
+   stripe->slots[i].entry = entry;
+   stripe->length++;
+   return APX_NO_ERROR;
+}
+
+/**
+ * Removes signatureId using backward shift deletion which keeps probe sequences intact without tombstones
+ */
+static apx_portSignatureMapEntry_t *apx_portSignatureMap_removeSlot(apx_portSignatureMapStripe_t *stripe, apx_signatureId_t signatureId)
+{
+   apx_portSignatureMapSlot_t *slot = apx_portSignatureMap_findSlot(stripe, signatureId);
+   apx_portSignatureMapEntry_t *entry = (apx_portSignatureMapEntry_t*) 0;
+   if (slot != 0)
+   {
+      uint32_t mask = stripe->capacity - 1u;
+      uint32_t hole = (uint32_t) (slot - stripe->slots);
+      uint32_t i = hole;
+      entry = slot->entry;
+      for (;;)
+      {
+         uint32_t home;
+         i = (i + 1u) & mask;
+         if (stripe->slots[i].signatureId == APX_INVALID_SIGNATURE_ID)
+         {
+            break;
+         }
+         home = ((uint32_t) (apx_portSignatureMap_hash(stripe->slots[i].signatureId) >> 32)) & mask;
+         //Move slot i into the hole unless its home position lies cyclically in (hole, i]
+         if ( ((i - home) & mask) >= ((i - hole) & mask) )
+         {
+            stripe->slots[hole] = stripe->slots[i];
+            hole = i;
+         }
+      }
+      stripe->slots[hole].signatureId = APX_INVALID_SIGNATURE_ID;
+      stripe->slots[hole].entry = (apx_portSignatureMapEntry_t*) 0;
+      stripe->length--;
+   }
+   return entry;
+}
+
+static apx_error_t apx_portSignatureMap_growStripe(apx_portSignatureMapStripe_t *stripe)
+{
+   uint32_t newCapacity = (stripe->capacity == 0u)? STRIPE_MIN_CAPACITY : stripe->capacity * 2u;
+   uint32_t oldCapacity = stripe->capacity;
+   apx_portSignatureMapSlot_t *oldSlots = stripe->slots;
+   apx_portSignatureMapSlot_t *newSlots = (apx_portSignatureMapSlot_t*) malloc(newCapacity * sizeof(apx_portSignatureMapSlot_t));
+   uint32_t i;
+   if (newSlots == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   memset(newSlots, 0, newCapacity * sizeof(apx_portSignatureMapSlot_t));
+   stripe->slots = newSlots;
+   stripe->capacity = newCapacity;
+   stripe->length = 0u;
+   for (i = 0u; i < oldCapacity; i++)
+   {
+      if (oldSlots[i].signatureId != APX_INVALID_SIGNATURE_ID)
+      {
+         apx_error_t rc = apx_portSignatureMap_insertSlot(stripe, oldSlots[i].signatureId, oldSlots[i].entry);
+         assert(rc == APX_NO_ERROR); //cannot grow again during rehash
+         (void) rc;
+      }
+   }
+   if (oldSlots != 0)
+   {
+      free(oldSlots);
+   }
+   return APX_NO_ERROR;
+}
+
+static uint32_t apx_portSignatureMap_calcAffectedStripesInternal(apx_portSignatureMap_t *self, apx_signatureId_t signatureId)
+{
+   uint32_t stripeMask = 0u;
+   apx_portSignatureMapEntry_t *entry = apx_portSignatureMap_findById(self, signatureId);
+   if (entry != 0)
+   {
+      stripeMask |= apx_portSignatureMap_calcPortRefListStripes(&entry->requirePortRef);
+      stripeMask |= apx_portSignatureMap_calcPortRefListStripes(&entry->providePortRef);
+   }
+   return stripeMask;
+}
+
+static uint32_t apx_portSignatureMap_calcPortRefListStripes(adt_list_t *portRefList)
+{
+   uint32_t stripeMask = 0u;
+   adt_list_elem_t *iter;
+   for(iter = adt_list_iter_first(portRefList); iter != 0; iter = adt_list_iter_next(iter))
+   {
+      apx_portRef_t *portRef = (apx_portRef_t*) iter->pItem;
+      assert(portRef != 0);
+      stripeMask |= apx_nodeInstance_getPortSignatureStripes(portRef->nodeInstance);
+   }
+   return stripeMask;
+}
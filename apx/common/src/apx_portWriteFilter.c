@@ -0,0 +1,124 @@
+/*****************************************************************************
+* \file      apx_portWriteFilter.c
+* \author    agent
+* \date      2026-10-18
+* \brief     On-change suppression of provide-port writes
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <time.h>
+#endif
+#include "apx_portWriteFilter.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_portWriteFilter_create(apx_portWriteFilter_t *self)
+{
+   if (self != 0)
+   {
+      self->heartbeatInterval = 0u;
+      self->lastForwardTime = 0u;
+      self->numSuppressedWrites = 0u;
+      self->numHeartbeatWrites = 0u;
+      self->mode = APX_PORT_WRITE_MODE_ALWAYS;
+   }
+}
+
+/**
+ * Changes write mode. The heartbeat period starts over from now.
+ */
+void apx_portWriteFilter_setMode(apx_portWriteFilter_t *self, apx_portWriteMode_t mode, uint32_t heartbeatInterval, uint32_t now)
+{
+   if (self != 0)
+   {
+      self->mode = mode;
+      self->heartbeatInterval = heartbeatInterval;
+      self->lastForwardTime = now;
+   }
+}
+
+/**
+ * Called for every write to the port. isChanged tells if the new data differs from the current port data.
+ * Returns true if the write shall be forwarded to the remote side.
+ */
+bool apx_portWriteFilter_update(apx_portWriteFilter_t *self, bool isChanged, uint32_t now)
+{
+   if ( (self == 0) || (self->mode == APX_PORT_WRITE_MODE_ALWAYS) )
+   {
+      return true;
+   }
+   if (isChanged)
+   {
+      self->lastForwardTime = now;
+      return true;
+   }
+   if ( (self->heartbeatInterval > 0u) && ( (uint32_t) (now - self->lastForwardTime) >= self->heartbeatInterval) )
+   {
+      self->lastForwardTime = now;
+      self->numHeartbeatWrites++;
+      return true;
+   }
+   self->numSuppressedWrites++;
+   return false;
+}
+
+/**
+ * Returns a millisecond tick count from a monotonic clock. Wraps around after 49 days.
+ */
+uint32_t apx_portWriteFilter_getTickCount(void)
+{
+#ifdef _WIN32
+   return (uint32_t) GetTickCount();
+#else
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (uint32_t) ( ((uint64_t) now.tv_sec) * 1000u + ((uint64_t) now.tv_nsec) / 1000000u );
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,224 @@
+/*****************************************************************************
+* \file      apx_routingPlan.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Flat routing table from provide-port data offsets to connected require ports
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <assert.h>
+#include "apx_routingPlan.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_routingPlan_create(apx_routingPlan_t *self)
+{
+   if (self != 0)
+   {
+      self->ranges = (apx_routingPlanRange_t*) 0;
+      self->entries = (apx_routingPlanEntry_t*) 0;
+      self->numRanges = 0;
+      self->numEntries = 0;
+   }
+}
+
+void apx_routingPlan_destroy(apx_routingPlan_t *self)
+{
+   apx_routingPlan_clear(self);
+}
+
+apx_routingPlan_t *apx_routingPlan_new(void)
+{
+   apx_routingPlan_t *self = (apx_routingPlan_t*) malloc(sizeof(apx_routingPlan_t));
+   if (self != 0)
+   {
+      apx_routingPlan_create(self);
+   }
+   return self;
+}
+
+void apx_routingPlan_delete(apx_routingPlan_t *self)
+{
+   if (self != 0)
+   {
+      apx_routingPlan_destroy(self);
+      free(self);
+   }
+}
+
+void apx_routingPlan_vdelete(void *arg)
+{
+   apx_routingPlan_delete((apx_routingPlan_t*) arg);
+}
+
+/**
+ * Compiles connectorTable into a flat routing plan, replacing any previous content.
+ * Connectors to require ports that are not plain old data are not part of the plan.
+ * The caller must hold the lock protecting connectorTable.
+ */
+apx_error_t apx_routingPlan_build(apx_routingPlan_t *self, const apx_portRef_t *providePortRefs, apx_portConnectorList_t *connectorTable, apx_portCount_t numProvidePorts)
+{
+   if ( (self != 0) && (providePortRefs != 0) && (connectorTable != 0) )
+   {
+      apx_portId_t portId;
+      int32_t numRanges = 0;
+      int32_t numEntries = 0;
+      apx_routingPlan_clear(self);
+      for (portId = 0; portId < numProvidePorts; portId++)
+      {
+         int32_t numConnectors = apx_portConnectorList_length(&connectorTable[portId]);
+         if (numConnectors > 0)
+         {
+            numRanges++;
+            numEntries += numConnectors;
+         }
+      }
+      if (numRanges == 0)
+      {
+         return APX_NO_ERROR;
+      }
+      self->ranges = (apx_routingPlanRange_t*) malloc(numRanges * sizeof(apx_routingPlanRange_t));
+      self->entries = (apx_routingPlanEntry_t*) malloc(numEntries * sizeof(apx_routingPlanEntry_t));
+      if ( (self->ranges == 0) || (self->entries == 0) )
+      {
+         apx_routingPlan_clear(self);
+         return APX_MEM_ERROR;
+      }
+      for (portId = 0; portId < numProvidePorts; portId++)
+      {
+         apx_portConnectorList_t *portConnectors = &connectorTable[portId];
+         int32_t numConnectors = apx_portConnectorList_length(portConnectors);
+         if (numConnectors > 0)
+         {
+            int32_t connectorId;
+            const apx_portDataProps_t *providePortDataProps = providePortRefs[portId].portDataProps;
+            apx_routingPlanRange_t *range = &self->ranges[self->numRanges];
+            assert(providePortDataProps != 0);
+            //ports are laid out in port ID order, make sure ranges stay sorted by offset
+            assert( (self->numRanges == 0) || (range[-1].offset < (uint32_t) providePortDataProps->offset) );
+            range->offset = (uint32_t) providePortDataProps->offset;
+            range->dataSize = providePortDataProps->dataSize;
+            range->beginEntry = self->numEntries;
+            for (connectorId = 0; connectorId < numConnectors; connectorId++)
+            {
+               apx_portRef_t *requirePortRef = apx_portConnectorList_get(portConnectors, connectorId);
+               const apx_portDataProps_t *requirePortDataProps = requirePortRef->portDataProps;
+               if (apx_portDataProps_isPlainOldData(requirePortDataProps))
+               {
+                  apx_routingPlanEntry_t *entry = &self->entries[self->numEntries++];
+                  assert(requirePortDataProps->dataSize == providePortDataProps->dataSize);
+                  entry->destNodeInstance = requirePortRef->nodeInstance;
+                  entry->destOffset = (uint32_t) requirePortDataProps->offset;
+                  entry->dataSize = requirePortDataProps->dataSize;
+               }
+            }
+            range->endEntry = self->numEntries;
+            self->numRanges++;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_routingPlan_clear(apx_routingPlan_t *self)
+{
+   if (self != 0)
+   {
+      if (self->ranges != 0)
+      {
+         free(self->ranges);
+         self->ranges = (apx_routingPlanRange_t*) 0;
+      }
+      if (self->entries != 0)
+      {
+         free(self->entries);
+         self->entries = (apx_routingPlanEntry_t*) 0;
+      }
+      self->numRanges = 0;
+      self->numEntries = 0;
+   }
+}
+
+/**
+ * Returns the first range that ends after offset (binary search).
+ * Returns the same value as apx_routingPlan_rangeEnd when no such range exists.
+ */
+const apx_routingPlanRange_t *apx_routingPlan_findFirstRange(const apx_routingPlan_t *self, uint32_t offset)
+{
+   if (self != 0)
+   {
+      int32_t low = 0;
+      int32_t high = self->numRanges;
+      while (low < high)
+      {
+         int32_t mid = low + ( (high - low) / 2);
+         const apx_routingPlanRange_t *range = &self->ranges[mid];
+         if (range->offset + range->dataSize <= offset)
+         {
+            low = mid + 1;
+         }
+         else
+         {
+            high = mid;
+         }
+      }
+      return &self->ranges[low];
+   }
+   return (const apx_routingPlanRange_t*) 0;
+}
+
+const apx_routingPlanRange_t *apx_routingPlan_rangeEnd(const apx_routingPlan_t *self)
+{
+   if (self != 0)
+   {
+      return &self->ranges[self->numRanges];
+   }
+   return (const apx_routingPlanRange_t*) 0;
+}
+
+const apx_routingPlanEntry_t *apx_routingPlan_getEntry(const apx_routingPlan_t *self, int32_t index)
+{
+   if ( (self != 0) && (index >= 0) && (index < self->numEntries) )
+   {
+      return &self->entries[index];
+   }
+   return (const apx_routingPlanEntry_t*) 0;
+}
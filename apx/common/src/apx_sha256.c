@@ -0,0 +1,207 @@
+/*****************************************************************************
+* \file      apx_sha256.c
+* \author    agent
+* \date      2026-10-18
+* \brief     SHA-256 message digest (FIPS 180-4)
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+#include "apx_sha256.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32u - (n))))
+#define CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define BSIG0(x) (ROTR(x, 2u) ^ ROTR(x, 13u) ^ ROTR(x, 22u))
+#define BSIG1(x) (ROTR(x, 6u) ^ ROTR(x, 11u) ^ ROTR(x, 25u))
+#define SSIG0(x) (ROTR(x, 7u) ^ ROTR(x, 18u) ^ ((x) >> 3u))
+#define SSIG1(x) (ROTR(x, 17u) ^ ROTR(x, 19u) ^ ((x) >> 10u))
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void apx_sha256_transform(apx_sha256_t *self, const uint8_t *block);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const uint32_t m_k[64] =
+{
+   0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+   0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+   0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+   0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+   0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+   0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+   0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+   0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_sha256_init(apx_sha256_t *self)
+{
+   if (self != 0)
+   {
+      self->state[0] = 0x6a09e667u;
+      self->state[1] = 0xbb67ae85u;
+      self->state[2] = 0x3c6ef372u;
+      self->state[3] = 0xa54ff53au;
+      self->state[4] = 0x510e527fu;
+      self->state[5] = 0x9b05688cu;
+      self->state[6] = 0x1f83d9abu;
+      self->state[7] = 0x5be0cd19u;
+      self->totalLen = 0u;
+      self->blockLen = 0u;
+   }
+}
+
+void apx_sha256_update(apx_sha256_t *self, const uint8_t *data, size_t len)
+{
+   if ( (self != 0) && ( (data != 0) || (len == 0u) ) )
+   {
+      self->totalLen += (uint64_t) len;
+      if (self->blockLen > 0u)
+      {
+         size_t chunkLen = APX_SHA256_BLOCK_SIZE - self->blockLen;
+         if (chunkLen > len)
+         {
+            chunkLen = len;
+         }
+         memcpy(&self->block[self->blockLen], data, chunkLen);
+         self->blockLen += (uint32_t) chunkLen;
+         data += chunkLen;
+         len -= chunkLen;
+         if (self->blockLen < APX_SHA256_BLOCK_SIZE)
+         {
+            return;
+         }
+         apx_sha256_transform(self, &self->block[0]);
+         self->blockLen = 0u;
+      }
+      while (len >= APX_SHA256_BLOCK_SIZE)
+      {
+         apx_sha256_transform(self, data);
+         data += APX_SHA256_BLOCK_SIZE;
+         len -= APX_SHA256_BLOCK_SIZE;
+      }
+      if (len > 0u)
+      {
+         memcpy(&self->block[0], data, len);
+         self->blockLen = (uint32_t) len;
+      }
+   }
+}
+
+void apx_sha256_final(apx_sha256_t *self, uint8_t *digest)
+{
+   if ( (self != 0) && (digest != 0) )
+   {
+      uint64_t bitLen = self->totalLen << 3u;
+      uint32_t i;
+      self->block[self->blockLen++] = 0x80u;
+      if (self->blockLen > (APX_SHA256_BLOCK_SIZE - 8u))
+      {
+         memset(&self->block[self->blockLen], 0, APX_SHA256_BLOCK_SIZE - self->blockLen);
+         apx_sha256_transform(self, &self->block[0]);
+         self->blockLen = 0u;
+      }
+      memset(&self->block[self->blockLen], 0, (APX_SHA256_BLOCK_SIZE - 8u) - self->blockLen);
+      for (i = 0u; i < 8u; i++)
+      {
+         self->block[APX_SHA256_BLOCK_SIZE - 1u - i] = (uint8_t) (bitLen >> (i * 8u));
+      }
+      apx_sha256_transform(self, &self->block[0]);
+      for (i = 0u; i < 8u; i++)
+      {
+         digest[i * 4u] = (uint8_t) (self->state[i] >> 24u);
+         digest[i * 4u + 1u] = (uint8_t) (self->state[i] >> 16u);
+         digest[i * 4u + 2u] = (uint8_t) (self->state[i] >> 8u);
+         digest[i * 4u + 3u] = (uint8_t) self->state[i];
+      }
+      self->blockLen = 0u;
+   }
+}
+
+void apx_sha256_calc(const uint8_t *data, size_t len, uint8_t *digest)
+{
+   apx_sha256_t ctx;
+   apx_sha256_init(&ctx);
+   apx_sha256_update(&ctx, data, len);
+   apx_sha256_final(&ctx, digest);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void apx_sha256_transform(apx_sha256_t *self, const uint8_t *block)
+{
+   uint32_t w[64];
+   uint32_t a, b, c, d, e, f, g, h;
+   uint32_t i;
+   for (i = 0u; i < 16u; i++)
+   {
+      w[i] = ( ((uint32_t) block[i * 4u]) << 24u) | ( ((uint32_t) block[i * 4u + 1u]) << 16u) |
+             ( ((uint32_t) block[i * 4u + 2u]) << 8u) | ((uint32_t) block[i * 4u + 3u]);
+   }
+   for (i = 16u; i < 64u; i++)
+   {
+      w[i] = SSIG1(w[i - 2u]) + w[i - 7u] + SSIG0(w[i - 15u]) + w[i - 16u];
+   }
+   a = self->state[0];
+   b = self->state[1];
+   c = self->state[2];
+   d = self->state[3];
+   e = self->state[4];
+   f = self->state[5];
+   g = self->state[6];
+   h = self->state[7];
+   for (i = 0u; i < 64u; i++)
+   {
+      uint32_t t1 = h + BSIG1(e) + CH(e, f, g) + m_k[i] + w[i];
+      uint32_t t2 = BSIG0(a) + MAJ(a, b, c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+   }
+   self->state[0] += a;
+   self->state[1] += b;
+   self->state[2] += c;
+   self->state[3] += d;
+   self->state[4] += e;
+   self->state[5] += f;
+   self->state[6] += g;
+   self->state[7] += h;
+}
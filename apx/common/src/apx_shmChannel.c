@@ -0,0 +1,831 @@
+/*****************************************************************************
+* \file      apx_shmChannel.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Shared-memory transport channel for same-host APX connections
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE //needed for memfd_create
+#endif
+#include "apx_shmChannel.h"
+#if APX_SHM_SUPPORTED
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include "numheader.h"
+#include "rmf.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define RING_MASK (APX_SHM_RING_SIZE - 1u)
+#define RECORD_ALIGN 8u
+#define INLINE_FLAG 0x80000000u
+#define WRAP_MARKER 0xFFFFFFFFu
+#define MAX_INLINE_CHUNK (APX_SHM_RING_SIZE / 4u)
+#define RX_HEADER_RESERVE 8u //room for numheader32 + rmf high address header in front of window data
+#define RX_BUFFER_SIZE (RX_HEADER_RESERVE + ((APX_SHM_WINDOW_SIZE > MAX_INLINE_CHUNK)? APX_SHM_WINDOW_SIZE : MAX_INLINE_CHUNK))
+#define SPIN_LIMIT 64u
+#define WINDOW_SPIN_LIMIT 1024u //a producer holds the window seqlock for one memcpy, after this many yields it has probably crashed
+#define WINDOW_STALL_WAIT_MS 1 //poll timeout used by apx_shmChannel_wait while a window read is stalled
+#define HANDSHAKE_BYTE 'S'
+
+#define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_LOAD_SEQ(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define ATOMIC_STORE_SEQ(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+
+#if (APX_SHM_RING_SIZE & (APX_SHM_RING_SIZE - 1)) != 0
+#error "APX_SHM_RING_SIZE must be a power of two"
+#endif
+
+typedef struct apx_shmRecord_tag
+{
+   uint32_t address;
+   uint32_t len;
+} apx_shmRecord_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_shmChannel_createCommon(apx_shmChannel_t *self, uint8_t txIndex);
+static apx_error_t apx_shmChannel_writeRecord(apx_shmChannel_t *self, uint32_t address, const uint8_t *data, uint32_t len);
+static apx_error_t apx_shmChannel_writeInline(apx_shmChannel_t *self, const uint8_t *data, uint32_t len);
+static apx_error_t apx_shmChannel_writeWindow(apx_shmChannel_t *self, uint32_t address, const uint8_t *data, uint32_t len);
+static bool apx_shmChannel_isWindowMessage(apx_shmChannel_t *self, const uint8_t *msgBuf, uint32_t msgLen, rmf_msg_t *rmfMsg);
+static apx_error_t apx_shmChannel_readWindow(apx_shmChannel_t *self, uint32_t address, uint32_t len, const uint8_t **msgBegin, uint32_t *msgLen);
+static int32_t apx_shmChannel_protocolError(apx_shmChannel_t *self);
+static void apx_shmChannel_notify(apx_shmChannel_t *self);
+static void apx_shmChannel_signal(int fd);
+static void apx_shmChannel_closeHandles(int *handles, uint32_t numHandles);
+static uint32_t apx_shmChannel_recordSize(uint32_t payloadLen);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates a new shared region (server side). Its handles are passed to the client using apx_shmChannel_sendHandles.
+ */
+apx_error_t apx_shmChannel_create(apx_shmChannel_t *self)
+{
+   if (self != 0)
+   {
+      apx_error_t result;
+      uint32_t i;
+      void *mem;
+      self->memFd = memfd_create("apx_shm", MFD_CLOEXEC);
+      if (self->memFd < 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      if (ftruncate(self->memFd, (off_t) sizeof(apx_shmRegion_t)) != 0)
+      {
+         close(self->memFd);
+         return APX_MEM_ERROR;
+      }
+      mem = mmap(0, sizeof(apx_shmRegion_t), PROT_READ | PROT_WRITE, MAP_SHARED, self->memFd, 0);
+      if (mem == MAP_FAILED)
+      {
+         close(self->memFd);
+         return APX_MEM_ERROR;
+      }
+      self->region = (apx_shmRegion_t*) mem; //freshly truncated memfd pages are zero-filled
+      for (i = 0u; i < APX_SHM_NUM_DIRECTIONS; i++)
+      {
+         self->eventFd[i] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+         if (self->eventFd[i] < 0)
+         {
+            apx_shmChannel_closeHandles(&self->eventFd[0], i);
+            munmap(self->region, sizeof(apx_shmRegion_t));
+            close(self->memFd);
+            return APX_MEM_ERROR;
+         }
+      }
+      self->region->magic = APX_SHM_MAGIC;
+      self->region->version = APX_SHM_VERSION;
+      self->region->ringSize = APX_SHM_RING_SIZE;
+      self->region->windowSize = APX_SHM_WINDOW_SIZE;
+      result = apx_shmChannel_createCommon(self, APX_SHM_DIRECTION_SERVER_TO_CLIENT);
+      if (result != APX_NO_ERROR)
+      {
+         apx_shmChannel_closeHandles(&self->eventFd[0], APX_SHM_NUM_DIRECTIONS);
+         munmap(self->region, sizeof(apx_shmRegion_t));
+         close(self->memFd);
+      }
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Attaches to an existing region (client side). On success the channel takes ownership of all handles.
+ */
+apx_error_t apx_shmChannel_createFromHandles(apx_shmChannel_t *self, const int *handles)
+{
+   if ( (self != 0) && (handles != 0) )
+   {
+      apx_error_t result;
+      struct stat st;
+      void *mem;
+      if ( (fstat(handles[0], &st) != 0) || (st.st_size < (off_t) sizeof(apx_shmRegion_t)) )
+      {
+         return APX_INVALID_ARGUMENT_ERROR;
+      }
+      mem = mmap(0, sizeof(apx_shmRegion_t), PROT_READ | PROT_WRITE, MAP_SHARED, handles[0], 0);
+      if (mem == MAP_FAILED)
+      {
+         return APX_MEM_ERROR;
+      }
+      self->region = (apx_shmRegion_t*) mem;
+      if ( (self->region->magic != APX_SHM_MAGIC) || (self->region->version != APX_SHM_VERSION) ||
+           (self->region->ringSize != APX_SHM_RING_SIZE) || (self->region->windowSize != APX_SHM_WINDOW_SIZE) )
+      {
+         munmap(self->region, sizeof(apx_shmRegion_t));
+         return APX_UNSUPPORTED_ERROR;
+      }
+      self->memFd = handles[0];
+      self->eventFd[APX_SHM_DIRECTION_SERVER_TO_CLIENT] = handles[1];
+      self->eventFd[APX_SHM_DIRECTION_CLIENT_TO_SERVER] = handles[2];
+      result = apx_shmChannel_createCommon(self, APX_SHM_DIRECTION_CLIENT_TO_SERVER);
+      if (result != APX_NO_ERROR)
+      {
+         munmap(self->region, sizeof(apx_shmRegion_t));
+      }
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Receives the handles sent by apx_shmChannel_sendHandles on the rendezvous socket and attaches to the region.
+ */
+apx_error_t apx_shmChannel_createFromSocket(apx_shmChannel_t *self, int sockFd)
+{
+   if ( (self != 0) && (sockFd >= 0) )
+   {
+      int handles[APX_SHM_NUM_HANDLES];
+      char control[CMSG_SPACE(sizeof(handles))];
+      struct msghdr msg;
+      struct iovec iov;
+      struct cmsghdr *cmsg;
+      uint8_t payload = 0u;
+      ssize_t rc;
+      apx_error_t result;
+      memset(&msg, 0, sizeof(msg));
+      memset(control, 0, sizeof(control));
+      iov.iov_base = &payload;
+      iov.iov_len = sizeof(payload);
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      do
+      {
+         rc = recvmsg(sockFd, &msg, MSG_CMSG_CLOEXEC);
+      } while ( (rc < 0) && (errno == EINTR) );
+      if ( (rc != (ssize_t) sizeof(payload)) || (payload != HANDSHAKE_BYTE) )
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      cmsg = CMSG_FIRSTHDR(&msg);
+      if ( (cmsg == 0) || (cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_RIGHTS) ||
+           (cmsg->cmsg_len != CMSG_LEN(sizeof(handles))) )
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      memcpy(handles, CMSG_DATA(cmsg), sizeof(handles));
+      result = apx_shmChannel_createFromHandles(self, handles);
+      if (result != APX_NO_ERROR)
+      {
+         apx_shmChannel_closeHandles(&handles[0], APX_SHM_NUM_HANDLES);
+      }
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_shmChannel_destroy(apx_shmChannel_t *self)
+{
+   if (self != 0)
+   {
+      apx_shmChannel_close(self);
+      munmap(self->region, sizeof(apx_shmRegion_t));
+      close(self->memFd);
+      apx_shmChannel_closeHandles(&self->eventFd[0], APX_SHM_NUM_DIRECTIONS);
+      MUTEX_DESTROY(self->txLock);
+      free(self->rxBuffer);
+   }
+}
+
+apx_shmChannel_t *apx_shmChannel_new(void)
+{
+   apx_shmChannel_t *self = (apx_shmChannel_t*) malloc(sizeof(apx_shmChannel_t));
+   if (self != 0)
+   {
+      apx_error_t result = apx_shmChannel_create(self);
+      if (result != APX_NO_ERROR)
+      {
+         free(self);
+         self = (apx_shmChannel_t*) 0;
+      }
+   }
+   return self;
+}
+
+void apx_shmChannel_delete(apx_shmChannel_t *self)
+{
+   if (self != 0)
+   {
+      apx_shmChannel_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Passes the memfd and both eventfds to the peer as SCM_RIGHTS ancillary data.
+ */
+apx_error_t apx_shmChannel_sendHandles(apx_shmChannel_t *self, int sockFd)
+{
+   if ( (self != 0) && (sockFd >= 0) )
+   {
+      int handles[APX_SHM_NUM_HANDLES];
+      char control[CMSG_SPACE(sizeof(handles))];
+      struct msghdr msg;
+      struct iovec iov;
+      struct cmsghdr *cmsg;
+      uint8_t payload = HANDSHAKE_BYTE;
+      ssize_t rc;
+      apx_shmChannel_getHandles(self, &handles[0]);
+      memset(&msg, 0, sizeof(msg));
+      memset(control, 0, sizeof(control));
+      iov.iov_base = &payload;
+      iov.iov_len = sizeof(payload);
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(handles));
+      memcpy(CMSG_DATA(cmsg), handles, sizeof(handles));
+      do
+      {
+         rc = sendmsg(sockFd, &msg, MSG_NOSIGNAL);
+      } while ( (rc < 0) && (errno == EINTR) );
+      return (rc == (ssize_t) sizeof(payload))? APX_NO_ERROR : APX_CONNECTION_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_shmChannel_getHandles(apx_shmChannel_t *self, int *handles)
+{
+   if ( (self != 0) && (handles != 0) )
+   {
+      handles[0] = self->memFd;
+      handles[1] = self->eventFd[APX_SHM_DIRECTION_SERVER_TO_CLIENT];
+      handles[2] = self->eventFd[APX_SHM_DIRECTION_CLIENT_TO_SERVER];
+   }
+}
+
+/**
+ * When disabled, every message is sent inline through the ring. The client keeps the window disabled until its greeting has been sent.
+ */
+void apx_shmChannel_setWindowEnabled(apx_shmChannel_t *self, bool isEnabled)
+{
+   if (self != 0)
+   {
+      MUTEX_LOCK(self->txLock);
+      self->isWindowEnabled = isEnabled;
+      MUTEX_UNLOCK(self->txLock);
+   }
+}
+
+/**
+ * Writes one or more numheader framed messages (same format as apx_transmitHandler_t.sendBatch).
+ * Unfragmented port data writes that fit inside the window are copied into the shared window and only an (address,len)
+ * notification is queued. All other messages are queued inline. Consecutive inline messages share one ring record.
+ * Returns dataLen on success or -1 on failure.
+ */
+int32_t apx_shmChannel_write(apx_shmChannel_t *self, const uint8_t *data, uint32_t dataLen)
+{
+   if ( (self != 0) && (data != 0) )
+   {
+      apx_error_t result = APX_NO_ERROR;
+      const uint8_t *pNext = data;
+      const uint8_t *pEnd = data + dataLen;
+      const uint8_t *pInline = data;
+      MUTEX_LOCK(self->txLock);
+      while ( (pNext < pEnd) && (result == APX_NO_ERROR) )
+      {
+         uint32_t msgLen = 0u;
+         rmf_msg_t rmfMsg;
+         const uint8_t *pMsg = numheader_decode32(pNext, pEnd, &msgLen);
+         if ( (pMsg == pNext) || (msgLen > (uint32_t) (pEnd - pMsg)) )
+         {
+            break; //not a complete message, the remainder is sent inline as-is
+         }
+         if (apx_shmChannel_isWindowMessage(self, pMsg, msgLen, &rmfMsg))
+         {
+            if (pInline < pNext)
+            {
+               result = apx_shmChannel_writeInline(self, pInline, (uint32_t) (pNext - pInline));
+            }
+            if (result == APX_NO_ERROR)
+            {
+               result = apx_shmChannel_writeWindow(self, rmfMsg.address, rmfMsg.data, (uint32_t) rmfMsg.dataLen);
+            }
+            pInline = pMsg + msgLen;
+         }
+         pNext = pMsg + msgLen;
+      }
+      if ( (result == APX_NO_ERROR) && (pInline < pEnd) )
+      {
+         result = apx_shmChannel_writeInline(self, pInline, (uint32_t) (pEnd - pInline));
+      }
+      MUTEX_UNLOCK(self->txLock);
+      return (result == APX_NO_ERROR)? (int32_t) dataLen : -1;
+   }
+   return -1;
+}
+
+/**
+ * Consumes all records currently in the receive ring. Window notifications are turned back into
+ * numheader framed RMF messages using a torn-free copy of the window, so dataFunc always sees a regular byte stream.
+ * The ring lives in memory the peer can write to. Positions and record fields are validated before use, and each record
+ * field is read only once. A violation is a protocol error: the channel is closed and -1 is returned.
+ * Payloads are copied into rxBuffer before dataFunc sees them, so the peer can't change data that has already been parsed.
+ * If the peer never finishes a window write, reading stops at that record and it is retried after apx_shmChannel_wait.
+ * Returns number of records consumed.
+ */
+int32_t apx_shmChannel_read(apx_shmChannel_t *self, apx_shmChannelDataFunc_t *dataFunc, void *arg)
+{
+   if ( (self != 0) && (dataFunc != 0) && (!self->isProtocolError) )
+   {
+      apx_shmDirection_t *rx = self->rx;
+      uint32_t tail = rx->tail;
+      uint32_t head = ATOMIC_LOAD(&rx->head);
+      int32_t numRecords = 0;
+      if ( ( (tail & (RECORD_ALIGN - 1u)) != 0u) || ( (head - tail) > APX_SHM_RING_SIZE) )
+      {
+         return apx_shmChannel_protocolError(self);
+      }
+      while (tail != head)
+      {
+         uint32_t pos = tail & RING_MASK;
+         const apx_shmRecord_t *record = (const apx_shmRecord_t*) &rx->ring[pos];
+         uint32_t address = ((const volatile apx_shmRecord_t*) record)->address;
+         uint32_t len = ((const volatile apx_shmRecord_t*) record)->len;
+         uint32_t step;
+         if (address == WRAP_MARKER)
+         {
+            step = APX_SHM_RING_SIZE - pos;
+         }
+         else if ( (address & INLINE_FLAG) != 0u)
+         {
+            if ( (len > MAX_INLINE_CHUNK) || (len > (APX_SHM_RING_SIZE - pos - sizeof(apx_shmRecord_t)) ) )
+            {
+               return apx_shmChannel_protocolError(self);
+            }
+            step = apx_shmChannel_recordSize(len);
+         }
+         else
+         {
+            if ( (len == 0u) || (address >= APX_SHM_WINDOW_SIZE) || (len > (APX_SHM_WINDOW_SIZE - address)) )
+            {
+               return apx_shmChannel_protocolError(self);
+            }
+            step = apx_shmChannel_recordSize(0u);
+         }
+         if (step > (head - tail))
+         {
+            return apx_shmChannel_protocolError(self);
+         }
+         if (address != WRAP_MARKER)
+         {
+            if ( (address & INLINE_FLAG) != 0u)
+            {
+               memcpy(self->rxBuffer, &rx->ring[pos + sizeof(apx_shmRecord_t)], len);
+               dataFunc(arg, self->rxBuffer, len);
+            }
+            else
+            {
+               const uint8_t *msgBegin = 0;
+               uint32_t msgLen = 0u;
+               if (apx_shmChannel_readWindow(self, address, len, &msgBegin, &msgLen) == APX_BUSY_ERROR)
+               {
+                  self->isWindowStalled = true;
+                  break;
+               }
+               if (msgLen > 0u)
+               {
+                  dataFunc(arg, msgBegin, msgLen);
+               }
+            }
+            numRecords++;
+         }
+         tail += step;
+         ATOMIC_STORE(&rx->tail, tail);
+         if (tail == head)
+         {
+            head = ATOMIC_LOAD(&rx->head);
+            if ( (head - tail) > APX_SHM_RING_SIZE)
+            {
+               return apx_shmChannel_protocolError(self);
+            }
+         }
+      }
+      return numRecords;
+   }
+   return -1;
+}
+
+/**
+ * Blocks until the receive ring has data, the timeout expires or the channel is closed.
+ * peerFd (optional, -1 to skip) is the rendezvous socket. The peer never writes to it after the handshake so any
+ * activity on it means that the peer has gone away.
+ * While a window read is stalled the receive ring is never empty, so the socket is polled for at most WINDOW_STALL_WAIT_MS instead.
+ * Returns APX_CONNECTION_ERROR when the channel is closed, the peer is gone or a protocol error was detected by apx_shmChannel_read.
+ */
+apx_error_t apx_shmChannel_wait(apx_shmChannel_t *self, int peerFd, int32_t timeoutMs)
+{
+   if (self != 0)
+   {
+      struct pollfd fds[2];
+      apx_shmDirection_t *rx = self->rx;
+      int eventFd = self->eventFd[self->rxIndex];
+      nfds_t numFds = 1u;
+      uint32_t i;
+      bool isStalled = self->isWindowStalled;
+      if (self->isProtocolError)
+      {
+         //isClosed is in shared memory, the peer could clear it again
+         return APX_CONNECTION_ERROR;
+      }
+      self->isWindowStalled = false;
+      if (isStalled)
+      {
+         if ( (timeoutMs < 0) || (timeoutMs > WINDOW_STALL_WAIT_MS) )
+         {
+            timeoutMs = WINDOW_STALL_WAIT_MS;
+         }
+      }
+      else
+      {
+         for (i = 0u; i < SPIN_LIMIT; i++)
+         {
+            //a short spin avoids the eventfd round-trip when the producer is in the middle of a burst
+            if (ATOMIC_LOAD(&rx->head) != rx->tail)
+            {
+               return APX_NO_ERROR;
+            }
+            sched_yield();
+         }
+      }
+      ATOMIC_STORE_SEQ(&rx->isParked, 1u);
+      if (ATOMIC_LOAD(&self->region->isClosed) != 0u)
+      {
+         ATOMIC_STORE(&rx->isParked, 0u);
+         return APX_CONNECTION_ERROR;
+      }
+      if ( (!isStalled) && (ATOMIC_LOAD_SEQ(&rx->head) != rx->tail) )
+      {
+         ATOMIC_STORE(&rx->isParked, 0u);
+         return APX_NO_ERROR;
+      }
+      fds[0].fd = eventFd;
+      fds[0].events = POLLIN;
+      fds[0].revents = 0;
+      if (peerFd >= 0)
+      {
+         fds[1].fd = peerFd;
+         fds[1].events = POLLIN;
+         fds[1].revents = 0;
+         numFds++;
+      }
+      if (poll(&fds[0], numFds, timeoutMs) < 0)
+      {
+         fds[0].revents = 0;
+         fds[1].revents = 0;
+      }
+      ATOMIC_STORE(&rx->isParked, 0u);
+      if ( (fds[0].revents & POLLIN) != 0)
+      {
+         uint64_t value;
+         ssize_t rc = read(eventFd, &value, sizeof(value));
+         (void) rc;
+      }
+      if ( (peerFd >= 0) && ( (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) != 0) )
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      if (ATOMIC_LOAD(&self->region->isClosed) != 0u)
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Marks the region as closed and wakes both consumers. Writers waiting for ring space give up.
+ */
+void apx_shmChannel_close(apx_shmChannel_t *self)
+{
+   if ( (self != 0) && (self->region != 0) )
+   {
+      uint32_t i;
+      ATOMIC_STORE_SEQ(&self->region->isClosed, 1u);
+      for (i = 0u; i < APX_SHM_NUM_DIRECTIONS; i++)
+      {
+         apx_shmChannel_signal(self->eventFd[i]);
+      }
+   }
+}
+
+bool apx_shmChannel_isClosed(apx_shmChannel_t *self)
+{
+   if ( (self != 0) && (self->region != 0) )
+   {
+      return (ATOMIC_LOAD(&self->region->isClosed) != 0u);
+   }
+   return true;
+}
+
+void apx_shmChannel_getStats(apx_shmChannel_t *self, apx_shmChannelStats_t *stats)
+{
+   if ( (self != 0) && (stats != 0) )
+   {
+      MUTEX_LOCK(self->txLock);
+      memcpy(stats, &self->stats, sizeof(apx_shmChannelStats_t));
+      MUTEX_UNLOCK(self->txLock);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_shmChannel_createCommon(apx_shmChannel_t *self, uint8_t txIndex)
+{
+   self->txIndex = txIndex;
+   self->rxIndex = (uint8_t) (APX_SHM_NUM_DIRECTIONS - 1u - txIndex);
+   self->tx = &self->region->direction[self->txIndex];
+   self->rx = &self->region->direction[self->rxIndex];
+   self->isWindowEnabled = true;
+   self->isProtocolError = false;
+   self->isWindowStalled = false;
+   memset(&self->stats, 0, sizeof(self->stats));
+   self->rxBuffer = (uint8_t*) malloc(RX_BUFFER_SIZE);
+   if (self->rxBuffer == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   MUTEX_INIT(self->txLock);
+   return APX_NO_ERROR;
+}
+
+/**
+ * Reserves room for one record in the transmit ring, waiting for the consumer when the ring is full.
+ * Caller must hold txLock.
+ */
+static apx_error_t apx_shmChannel_writeRecord(apx_shmChannel_t *self, uint32_t address, const uint8_t *data, uint32_t len)
+{
+   apx_shmDirection_t *tx = self->tx;
+   uint32_t recordSize = apx_shmChannel_recordSize( (data != 0)? len : 0u); //window notifications carry no payload
+   uint32_t head = tx->head;
+   uint32_t pos;
+   uint32_t numSpins = 0u;
+   uint32_t elapsedMs = 0u;
+   apx_shmRecord_t *record;
+   for (;;)
+   {
+      uint32_t tail = ATOMIC_LOAD(&tx->tail);
+      uint32_t contiguous = APX_SHM_RING_SIZE - (head & RING_MASK);
+      uint32_t needed = (contiguous < recordSize)? contiguous + recordSize : recordSize;
+      if ( (APX_SHM_RING_SIZE - (head - tail)) >= needed)
+      {
+         break;
+      }
+      if (ATOMIC_LOAD(&self->region->isClosed) != 0u)
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      apx_shmChannel_notify(self); //make sure the consumer is draining
+      if (numSpins < SPIN_LIMIT)
+      {
+         numSpins++;
+         sched_yield();
+      }
+      else
+      {
+         if (elapsedMs >= APX_SHM_WRITE_TIMEOUT_MS)
+         {
+            return APX_BUFFER_FULL_ERROR;
+         }
+         SLEEP(1);
+         elapsedMs++;
+      }
+   }
+   pos = head & RING_MASK;
+   if ( (APX_SHM_RING_SIZE - pos) < recordSize)
+   {
+      record = (apx_shmRecord_t*) &tx->ring[pos];
+      record->address = WRAP_MARKER;
+      record->len = 0u;
+      head += APX_SHM_RING_SIZE - pos;
+      pos = 0u;
+   }
+   record = (apx_shmRecord_t*) &tx->ring[pos];
+   record->address = address;
+   record->len = len;
+   if (data != 0)
+   {
+      memcpy(&tx->ring[pos + sizeof(apx_shmRecord_t)], data, len);
+   }
+   ATOMIC_STORE_SEQ(&tx->head, head + recordSize);
+   apx_shmChannel_notify(self);
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_shmChannel_writeInline(apx_shmChannel_t *self, const uint8_t *data, uint32_t len)
+{
+   while (len > 0u)
+   {
+      uint32_t chunkLen = (len > MAX_INLINE_CHUNK)? MAX_INLINE_CHUNK : len;
+      apx_error_t result = apx_shmChannel_writeRecord(self, INLINE_FLAG, data, chunkLen);
+      if (result != APX_NO_ERROR)
+      {
+         return result;
+      }
+      self->stats.numInlineWrites++;
+      data += chunkLen;
+      len -= chunkLen;
+   }
+   return APX_NO_ERROR;
+}
+
+/**
+ * Copies data into the shared window under the window seqlock and queues an (address,len) notification.
+ * If the consumer falls behind it will see the latest value of the window, which is the right semantics for port data.
+ */
+static apx_error_t apx_shmChannel_writeWindow(apx_shmChannel_t *self, uint32_t address, const uint8_t *data, uint32_t len)
+{
+   apx_shmDirection_t *tx = self->tx;
+   uint32_t seq = tx->windowSeq;
+   __atomic_store_n(&tx->windowSeq, seq + 1u, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+   memcpy(&tx->window[address], data, len);
+   ATOMIC_STORE(&tx->windowSeq, seq + 2u);
+   self->stats.numWindowWrites++;
+   return apx_shmChannel_writeRecord(self, address, (const uint8_t*) 0, len);
+}
+
+static bool apx_shmChannel_isWindowMessage(apx_shmChannel_t *self, const uint8_t *msgBuf, uint32_t msgLen, rmf_msg_t *rmfMsg)
+{
+   if ( (self->isWindowEnabled) && (msgLen > 0u) && (rmf_unpackMsg(msgBuf, (int32_t) msgLen, rmfMsg) > 0) )
+   {
+      return ( (!rmfMsg->more_bit) && (rmfMsg->dataLen > 0) && (rmfMsg->address < APX_SHM_WINDOW_SIZE) &&
+               ((uint32_t) rmfMsg->dataLen <= (APX_SHM_WINDOW_SIZE - rmfMsg->address)) );
+   }
+   return false;
+}
+
+/**
+ * Takes a consistent copy of window[address..address+len) and prepends numheader and rmf headers.
+ * On success *msgLen is the total message length (including numheader), or 0 if the notification is invalid.
+ * Returns APX_BUSY_ERROR when the window stays locked for WINDOW_SPIN_LIMIT attempts. The peer may have crashed while
+ * writing it, which only the rendezvous socket can tell, so the caller must go back to apx_shmChannel_wait.
+ */
+static apx_error_t apx_shmChannel_readWindow(apx_shmChannel_t *self, uint32_t address, uint32_t len, const uint8_t **msgBegin, uint32_t *msgLen)
+{
+   apx_shmDirection_t *rx = self->rx;
+   uint8_t *pData = &self->rxBuffer[RX_HEADER_RESERVE];
+   uint8_t numHeader[sizeof(uint32_t)];
+   int32_t rmfHeaderLen;
+   int32_t numHeaderLen;
+   uint32_t numSpins = 0u;
+   *msgLen = 0u;
+   if ( (len == 0u) || (address >= APX_SHM_WINDOW_SIZE) || (len > (APX_SHM_WINDOW_SIZE - address)) )
+   {
+      return APX_NO_ERROR;
+   }
+   for (;;)
+   {
+      uint32_t seq1 = ATOMIC_LOAD(&rx->windowSeq);
+      uint32_t seq2;
+      if ( (seq1 & 1u) != 0u)
+      {
+         if ( (ATOMIC_LOAD(&self->region->isClosed) != 0u) || (++numSpins >= WINDOW_SPIN_LIMIT) )
+         {
+            return APX_BUSY_ERROR;
+         }
+         sched_yield();
+         continue;
+      }
+      memcpy(pData, &rx->window[address], len);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      seq2 = __atomic_load_n(&rx->windowSeq, __ATOMIC_RELAXED);
+      if (seq1 == seq2)
+      {
+         break;
+      }
+   }
+   rmfHeaderLen = rmf_packHeaderBeforeData(pData, RMF_MAX_HEADER_SIZE, address, false);
+   numHeaderLen = numheader_encode32(&numHeader[0], (int32_t) sizeof(numHeader), len + (uint32_t) rmfHeaderLen);
+   if ( (rmfHeaderLen <= 0) || (numHeaderLen <= 0) )
+   {
+      return APX_NO_ERROR;
+   }
+   *msgBegin = pData - rmfHeaderLen - numHeaderLen;
+   memcpy((uint8_t*) *msgBegin, &numHeader[0], (size_t) numHeaderLen);
+   *msgLen = len + (uint32_t) rmfHeaderLen + (uint32_t) numHeaderLen;
+   return APX_NO_ERROR;
+}
+
+/**
+ * The peer has written something to the receive ring that a well-behaved producer never writes.
+ * Nothing after it can be trusted, close the channel so that both receive threads drop the connection.
+ */
+static int32_t apx_shmChannel_protocolError(apx_shmChannel_t *self)
+{
+   self->isProtocolError = true;
+   apx_shmChannel_close(self);
+   return -1;
+}
+
+/**
+ * Wakes the consumer of the transmit direction if it is parked on its eventfd.
+ */
+static void apx_shmChannel_notify(apx_shmChannel_t *self)
+{
+   if (ATOMIC_LOAD_SEQ(&self->tx->isParked) != 0u)
+   {
+      self->stats.numWakeups++;
+      apx_shmChannel_signal(self->eventFd[self->txIndex]);
+   }
+}
+
+static void apx_shmChannel_signal(int fd)
+{
+   uint64_t value = 1u;
+   ssize_t rc = write(fd, &value, sizeof(value));
+   (void) rc; //EAGAIN means that the counter is already non-zero, the consumer is woken either way
+}
+
+static void apx_shmChannel_closeHandles(int *handles, uint32_t numHandles)
+{
+   uint32_t i;
+   for (i = 0u; i < numHandles; i++)
+   {
+      if (handles[i] >= 0)
+      {
+         close(handles[i]);
+      }
+   }
+}
+
+static uint32_t apx_shmChannel_recordSize(uint32_t payloadLen)
+{
+   return (uint32_t) ((sizeof(apx_shmRecord_t) + payloadLen + (RECORD_ALIGN - 1u)) & ~(RECORD_ALIGN - 1u));
+}
+
+#endif //APX_SHM_SUPPORTED
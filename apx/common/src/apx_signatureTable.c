@@ -0,0 +1,250 @@
+/*****************************************************************************
+* \file      apx_signatureTable.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Interning table for derived port signatures
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <assert.h>
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <sched.h>
+#endif
+#include "apx_signatureTable.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _MSC_VER
+# define ATOMIC_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+# define ATOMIC_STORE(p, v) ((void) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+# define ATOMIC_CAS(p, expected, desired) (InterlockedCompareExchange((volatile LONG*) (p), (LONG) (desired), (LONG) (expected)) == (LONG) (expected))
+# define THREAD_YIELD() SwitchToThread()
+#else
+# define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define ATOMIC_CAS(p, expected, desired) apx_signatureTable_cas((p), (expected), (desired))
+# define THREAD_YIELD() sched_yield()
+#endif
+
+#define GLOBAL_TABLE_UNINITIALIZED 0u
+#define GLOBAL_TABLE_INITIALIZING  1u
+#define GLOBAL_TABLE_READY         2u
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void apx_signatureTable_vdeleteEntry(void *arg);
+#ifndef _MSC_VER
+static bool apx_signatureTable_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired);
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static apx_signatureTable_t m_globalTable;
+static volatile uint32_t m_globalTableState = GLOBAL_TABLE_UNINITIALIZED;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_signatureTable_create(apx_signatureTable_t *self)
+{
+   if (self != 0)
+   {
+      adt_hash_create(&self->internalMap, apx_signatureTable_vdeleteEntry);
+      self->nextId = APX_INVALID_SIGNATURE_ID + 1u;
+      MUTEX_INIT(self->lock);
+   }
+}
+
+void apx_signatureTable_destroy(apx_signatureTable_t *self)
+{
+   if (self != 0)
+   {
+      adt_hash_destroy(&self->internalMap);
+      MUTEX_DESTROY(self->lock);
+   }
+}
+
+apx_signatureTable_t *apx_signatureTable_new(void)
+{
+   apx_signatureTable_t *self = (apx_signatureTable_t*) malloc(sizeof(apx_signatureTable_t));
+   if (self != 0)
+   {
+      apx_signatureTable_create(self);
+   }
+   return self;
+}
+
+void apx_signatureTable_delete(apx_signatureTable_t *self)
+{
+   if (self != 0)
+   {
+      apx_signatureTable_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Returns the id of signature, assigning a new id if this is the first reference to it.
+ * Every successful call must be matched by a call to apx_signatureTable_release.
+ * Returns APX_INVALID_SIGNATURE_ID on memory allocation failure.
+ */
+apx_signatureId_t apx_signatureTable_intern(apx_signatureTable_t *self, const char *signature)
+{
+   apx_signatureId_t retval = APX_INVALID_SIGNATURE_ID;
+   if ( (self != 0) && (signature != 0) )
+   {
+      void **ppResult;
+      MUTEX_LOCK(self->lock);
+      ppResult = adt_hash_get(&self->internalMap, signature);
+      if (ppResult != 0)
+      {
+         apx_signatureTableEntry_t *entry = (apx_signatureTableEntry_t*) *ppResult;
+         assert(entry != 0);
+         entry->refCount++;
+         retval = entry->id;
+      }
+      else
+      {
+         apx_signatureTableEntry_t *entry = (apx_signatureTableEntry_t*) malloc(sizeof(apx_signatureTableEntry_t));
+         if (entry != 0)
+         {
+            entry->id = self->nextId++;
+            entry->refCount = 1u;
+            adt_hash_set(&self->internalMap, signature, entry);
+            retval = entry->id;
+         }
+      }
+      MUTEX_UNLOCK(self->lock);
+   }
+   return retval;
+}
+
+/**
+ * Drops one reference to signature. The signature is removed from the table when the last reference is released.
+ */
+void apx_signatureTable_release(apx_signatureTable_t *self, const char *signature)
+{
+   if ( (self != 0) && (signature != 0) )
+   {
+      void **ppResult;
+      MUTEX_LOCK(self->lock);
+      ppResult = adt_hash_get(&self->internalMap, signature);
+      if (ppResult != 0)
+      {
+         apx_signatureTableEntry_t *entry = (apx_signatureTableEntry_t*) *ppResult;
+         assert( (entry != 0) && (entry->refCount > 0u) );
+         if (--entry->refCount == 0u)
+         {
+            entry = (apx_signatureTableEntry_t*) adt_hash_remove(&self->internalMap, signature);
+            apx_signatureTable_vdeleteEntry(entry);
+         }
+      }
+      MUTEX_UNLOCK(self->lock);
+   }
+}
+
+/**
+ * Returns the current id of signature without adding a reference, or APX_INVALID_SIGNATURE_ID when it's not in the table
+ */
+apx_signatureId_t apx_signatureTable_find(apx_signatureTable_t *self, const char *signature)
+{
+   apx_signatureId_t retval = APX_INVALID_SIGNATURE_ID;
+   if ( (self != 0) && (signature != 0) )
+   {
+      void **ppResult;
+      MUTEX_LOCK(self->lock);
+      ppResult = adt_hash_get(&self->internalMap, signature);
+      if (ppResult != 0)
+      {
+         retval = ((apx_signatureTableEntry_t*) *ppResult)->id;
+      }
+      MUTEX_UNLOCK(self->lock);
+   }
+   return retval;
+}
+
+int32_t apx_signatureTable_length(apx_signatureTable_t *self)
+{
+   if (self != 0)
+   {
+      int32_t retval;
+      MUTEX_LOCK(self->lock);
+      retval = adt_hash_length(&self->internalMap);
+      MUTEX_UNLOCK(self->lock);
+      return retval;
+   }
+   return -1;
+}
+
+/**
+ * Returns the process-wide table used by apx_nodeInfo. It's created by the first caller.
+ */
+apx_signatureTable_t *apx_signatureTable_getGlobal(void)
+{
+   if (ATOMIC_LOAD(&m_globalTableState) != GLOBAL_TABLE_READY)
+   {
+      if (ATOMIC_CAS(&m_globalTableState, GLOBAL_TABLE_UNINITIALIZED, GLOBAL_TABLE_INITIALIZING))
+      {
+         apx_signatureTable_create(&m_globalTable);
+         ATOMIC_STORE(&m_globalTableState, GLOBAL_TABLE_READY);
+      }
+      else
+      {
+         while (ATOMIC_LOAD(&m_globalTableState) != GLOBAL_TABLE_READY)
+         {
+            THREAD_YIELD();
+         }
+      }
+   }
+   return &m_globalTable;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void apx_signatureTable_vdeleteEntry(void *arg)
+{
+   if (arg != 0)
+   {
+      free(arg);
+   }
+}
+
+#ifndef _MSC_VER
+static bool apx_signatureTable_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired)
+{
+   return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
@@ -44,12 +44,15 @@
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_vm_acceptProgram(apx_vm_t *self, const adt_bytes_t *program);
 static void apx_vm_prepareForPackUnpackInstruction(apx_vm_t *self);
 static apx_error_t apx_vm_execProg(apx_vm_t *self);
 static apx_error_t apx_vm_executePackInstruction(apx_vm_t *self, uint8_t variant);
 static apx_error_t apx_vm_executeUnpackInstruction(apx_vm_t *self, uint8_t variant);
 static apx_error_t apx_vm_executeArrayInstruction(apx_vm_t *self, uint8_t variant, bool isDynamicArray);
 static apx_error_t apx_vm_executeDataControlInstruction(apx_vm_t *self, uint8_t variant, bool isLastElement);
+static apx_error_t apx_vm_packValueFromOpTable(apx_vm_t *self, const dtl_dv_t *dv);
+static apx_error_t apx_vm_unpackValueFromOpTable(apx_vm_t *self, dtl_dv_t **dv);
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
 //////////////////////////////////////////////////////////////////////////////
@@ -72,6 +75,10 @@ void apx_vm_create(apx_vm_t *self)
       self->arrayLen = 0u;
       self->isArray = false;
       self->dynLenType = APX_DYN_LEN_NONE;
+      apx_vmOpTable_create(&self->opTable);
+      self->activeOpTable = (const apx_vmOpTable_t*) 0;
+      self->hasOpTable = false;
+      self->isOpTableEnabled = true;
    }
 }
 
@@ -81,6 +88,7 @@ void apx_vm_destroy(apx_vm_t *self)
    {
       apx_vmSerializer_destroy(&self->serializer);
       apx_vmDeserializer_destroy(&self->deserializer);
+      apx_vmOpTable_destroy(&self->opTable);
    }
 }
 
@@ -105,35 +113,40 @@ void apx_vm_delete(apx_vm_t *self)
 
 /**
  * Accepts a byte-code program by parsing the program header to see if its valid.
+ * Programs with a fixed data layout are also translated into a flat operation table which is used instead of the interpreter.
  * Returns APX_NO_ERROR on success
  */
 apx_error_t apx_vm_selectProgram(apx_vm_t *self, const adt_bytes_t *program)
 {
    if ( (self != 0) && (program != 0) )
    {
-      uint8_t majorVersion = 0u;
-      uint8_t minorVersion = 0u;
-      apx_error_t rc;
-      uint32_t programLength = adt_bytes_length(program);
-      if (programLength < APX_VM_HEADER_SIZE)
-      {
-         return APX_LENGTH_ERROR;
-      }
-      rc = apx_vm_decodeProgramHeader(program, &majorVersion, &minorVersion, &self->progType, &self->progDataSize);
-      if (rc != APX_NO_ERROR)
+      apx_error_t rc = apx_vm_acceptProgram(self, program);
+      if (rc == APX_NO_ERROR)
       {
-         return rc;
+         self->hasOpTable = (apx_vmOpTable_compile(&self->opTable, self->progBegin, self->progEnd) == APX_NO_ERROR);
+         self->activeOpTable = self->hasOpTable? &self->opTable : (const apx_vmOpTable_t*) 0;
       }
-      if( (majorVersion == APX_VM_MAJOR_VERSION) && (minorVersion == APX_VM_MINOR_VERSION) )
-      {
-         self->progBegin = adt_bytes_constData(program);
-         self->progEnd = self->progBegin+programLength;
-      }
-      else
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Same as apx_vm_selectProgram but uses an operation table that was already compiled from the same program
+ * (see apx_nodeInfo_getProvidePortPackOpTable). Nothing is compiled here which makes it cheap enough to call on every port access.
+ * opTable is a weak reference and can be NULL for programs without a fixed data layout.
+ */
+apx_error_t apx_vm_selectCompiledProgram(apx_vm_t *self, const adt_bytes_t *program, const apx_vmOpTable_t *opTable)
+{
+   if ( (self != 0) && (program != 0) )
+   {
+      apx_error_t rc = apx_vm_acceptProgram(self, program);
+      if (rc == APX_NO_ERROR)
       {
-         return APX_UNSUPPORTED_ERROR;
+         self->hasOpTable = (opTable != 0);
+         self->activeOpTable = opTable;
       }
-      return APX_NO_ERROR;
+      return rc;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
@@ -183,6 +196,10 @@ apx_error_t apx_vm_packValue(apx_vm_t *self, const dtl_dv_t *dv)
       {
          return APX_INVALID_PROGRAM_ERROR;
       }
+      else if (self->hasOpTable && self->isOpTableEnabled)
+      {
+         return apx_vm_packValueFromOpTable(self, dv);
+      }
       else
       {
          apx_error_t rc = apx_vmSerializer_setValue(&self->serializer, dv);
@@ -208,6 +225,10 @@ apx_error_t apx_vm_unpackValue(apx_vm_t *self, dtl_dv_t **dv)
       {
          return APX_INVALID_PROGRAM_ERROR;
       }
+      else if (self->hasOpTable && self->isOpTableEnabled)
+      {
+         return apx_vm_unpackValueFromOpTable(self, dv);
+      }
       else
       {
          apx_error_t rc = apx_vm_execProg(self);
@@ -238,6 +259,26 @@ apx_error_t apx_vm_writeNullValue(apx_vm_t *self)
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * The flat operation table is enabled by default. Disabling it forces all values through the byte code interpreter.
+ */
+void apx_vm_enableOpTable(apx_vm_t *self, bool enable)
+{
+   if (self != 0)
+   {
+      self->isOpTableEnabled = enable;
+   }
+}
+
+bool apx_vm_hasOpTable(apx_vm_t *self)
+{
+   if (self != 0)
+   {
+      return self->hasOpTable;
+   }
+   return false;
+}
+
 #ifdef UNIT_TEST
 apx_size_t apx_vm_getBytesWritten(apx_vm_t *self)
 {
@@ -332,6 +373,11 @@ static apx_error_t apx_vm_execProg(apx_vm_t *self)
       uint8_t instruction = *self->progNext++;
 
       (void) apx_vm_decodeInstruction(instruction, &opcode, &variant, &flags);
+      if ( (opcode == APX_OPCODE_PACK2) || (opcode == APX_OPCODE_UNPACK2) )
+      {
+         opcode = (opcode == APX_OPCODE_PACK2)? APX_OPCODE_PACK : APX_OPCODE_UNPACK;
+         variant += APX_VARIANT2_OFFSET;
+      }
       if (opcode != self->expectedNext)
       {
          retval = APX_INVALID_STATE_ERROR;
@@ -411,6 +457,68 @@ static apx_error_t apx_vm_execProg(apx_vm_t *self)
    return retval;
 }
 
+/**
+ * Parses the program header and makes program the selected program. Doesn't touch the operation table.
+ */
+static apx_error_t apx_vm_acceptProgram(apx_vm_t *self, const adt_bytes_t *program)
+{
+   uint8_t majorVersion = 0u;
+   uint8_t minorVersion = 0u;
+   apx_error_t rc;
+   uint32_t programLength = adt_bytes_length(program);
+   if (programLength < APX_VM_HEADER_SIZE)
+   {
+      return APX_LENGTH_ERROR;
+   }
+   rc = apx_vm_decodeProgramHeader(program, &majorVersion, &minorVersion, &self->progType, &self->progDataSize);
+   if (rc != APX_NO_ERROR)
+   {
+      return rc;
+   }
+   if( (majorVersion == APX_VM_MAJOR_VERSION) && (minorVersion == APX_VM_MINOR_VERSION) )
+   {
+      self->progBegin = adt_bytes_constData(program);
+      self->progEnd = self->progBegin+programLength;
+   }
+   else
+   {
+      return APX_UNSUPPORTED_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_vm_packValueFromOpTable(apx_vm_t *self, const dtl_dv_t *dv)
+{
+   apx_error_t rc;
+   apx_vmWriteBuf_t *buf = &self->serializer.buf;
+   if (!self->serializer.hasValidWriteBuf)
+   {
+      return APX_MISSING_BUFFER_ERROR;
+   }
+   rc = apx_vmOpTable_pack(self->activeOpTable, buf->pNext, (apx_size_t) (buf->pEnd - buf->pNext), dv);
+   if (rc == APX_NO_ERROR)
+   {
+      buf->pNext += self->activeOpTable->dataSize;
+   }
+   return rc;
+}
+
+static apx_error_t apx_vm_unpackValueFromOpTable(apx_vm_t *self, dtl_dv_t **dv)
+{
+   apx_error_t rc;
+   apx_vmReadBuf_t *buf = &self->deserializer.buf;
+   if (!self->deserializer.hasValidReadBuf)
+   {
+      return APX_MISSING_BUFFER_ERROR;
+   }
+   rc = apx_vmOpTable_unpack(self->activeOpTable, buf->pNext, (apx_size_t) (buf->pEnd - buf->pNext), dv);
+   if (rc == APX_NO_ERROR)
+   {
+      buf->pNext += self->activeOpTable->dataSize;
+   }
+   return rc;
+}
+
 static apx_error_t apx_vm_executePackInstruction(apx_vm_t *self, uint8_t variant)
 {
    apx_error_t rc;
@@ -434,6 +542,18 @@ static apx_error_t apx_vm_executePackInstruction(apx_vm_t *self, uint8_t variant
    case APX_VARIANT_S32:
       rc = apx_vmSerializer_packValueAsS32(&self->serializer, self->maxArrayLen, self->dynLenType);
       break;
+   case APX_VARIANT_U64:
+      rc = apx_vmSerializer_packValueAsU64(&self->serializer, self->maxArrayLen, self->dynLenType);
+      break;
+   case APX_VARIANT_S64:
+      rc = apx_vmSerializer_packValueAsS64(&self->serializer, self->maxArrayLen, self->dynLenType);
+      break;
+   case APX_VARIANT_FLOAT32:
+      rc = apx_vmSerializer_packValueAsFloat32(&self->serializer, self->maxArrayLen, self->dynLenType);
+      break;
+   case APX_VARIANT_FLOAT64:
+      rc = apx_vmSerializer_packValueAsFloat64(&self->serializer, self->maxArrayLen, self->dynLenType);
+      break;
    case APX_VARIANT_STR:
       rc = apx_vmSerializer_packValueAsString(&self->serializer, self->maxArrayLen, self->dynLenType);
       break;
@@ -489,6 +609,18 @@ static apx_error_t apx_vm_executeUnpackInstruction(apx_vm_t *self, uint8_t varia
    case APX_VARIANT_S32:
       rc = apx_vmDeserializer_unpackS32Value(&self->deserializer, self->maxArrayLen, self->dynLenType);
       break;
+   case APX_VARIANT_U64:
+      rc = apx_vmDeserializer_unpackU64Value(&self->deserializer, self->maxArrayLen, self->dynLenType);
+      break;
+   case APX_VARIANT_S64:
+      rc = apx_vmDeserializer_unpackS64Value(&self->deserializer, self->maxArrayLen, self->dynLenType);
+      break;
+   case APX_VARIANT_FLOAT32:
+      rc = apx_vmDeserializer_unpackFloat32Value(&self->deserializer, self->maxArrayLen, self->dynLenType);
+      break;
+   case APX_VARIANT_FLOAT64:
+      rc = apx_vmDeserializer_unpackFloat64Value(&self->deserializer, self->maxArrayLen, self->dynLenType);
+      break;
    case APX_VARIANT_STR:
       rc = apx_vmDeserializer_unpackStrValue(&self->deserializer, self->maxArrayLen, self->dynLenType);
       break;
@@ -54,6 +54,10 @@ static apx_error_t apx_vmDeserializer_unpackValueU32(apx_vmDeserializer_t *self,
 static apx_error_t apx_vmDeserializer_unpackValueS8(apx_vmDeserializer_t *self, dtl_sv_t **sv);
 static apx_error_t apx_vmDeserializer_unpackValueS16(apx_vmDeserializer_t *self, dtl_sv_t **sv);
 static apx_error_t apx_vmDeserializer_unpackValueS32(apx_vmDeserializer_t *self, dtl_sv_t **sv);
+static apx_error_t apx_vmDeserializer_unpackValueU64(apx_vmDeserializer_t *self, dtl_sv_t **sv);
+static apx_error_t apx_vmDeserializer_unpackValueS64(apx_vmDeserializer_t *self, dtl_sv_t **sv);
+static apx_error_t apx_vmDeserializer_unpackValueFloat32(apx_vmDeserializer_t *self, dtl_sv_t **sv);
+static apx_error_t apx_vmDeserializer_unpackValueFloat64(apx_vmDeserializer_t *self, dtl_sv_t **sv);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -379,6 +383,112 @@ apx_error_t apx_vmDeserializer_unpackS32(apx_vmDeserializer_t *self, int32_t *s3
 }
 
 
+apx_error_t apx_vmDeserializer_unpackU64(apx_vmDeserializer_t *self, uint64_t *u64Value)
+{
+   if ( (self != 0) && (u64Value != 0))
+   {
+      if (self->hasValidReadBuf)
+      {
+         if (self->buf.pNext+7u < self->buf.pEnd)
+         {
+            uint64_t tmp = (uint64_t) unpackLE(self->buf.pNext, UINT32_SIZE);
+            tmp |= ((uint64_t) unpackLE(self->buf.pNext+UINT32_SIZE, UINT32_SIZE)) << 32;
+            self->buf.pNext += UINT64_SIZE;
+            *u64Value = tmp;
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmDeserializer_unpackS64(apx_vmDeserializer_t *self, int64_t *s64Value)
+{
+   if ( (self != 0) && (s64Value != 0))
+   {
+      if (self->hasValidReadBuf)
+      {
+         if (self->buf.pNext+7u < self->buf.pEnd)
+         {
+            uint64_t tmp = (uint64_t) unpackLE(self->buf.pNext, UINT32_SIZE);
+            tmp |= ((uint64_t) unpackLE(self->buf.pNext+UINT32_SIZE, UINT32_SIZE)) << 32;
+            self->buf.pNext += SINT64_SIZE;
+            *s64Value = (int64_t) tmp;
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmDeserializer_unpackFloat32(apx_vmDeserializer_t *self, float *f32Value)
+{
+   if ( (self != 0) && (f32Value != 0))
+   {
+      if (self->hasValidReadBuf)
+      {
+         if (self->buf.pNext+3u < self->buf.pEnd)
+         {
+            uint32_t tmp = unpackU32LE(self->buf.pNext);
+            memcpy(f32Value, &tmp, FLOAT32_SIZE);
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmDeserializer_unpackFloat64(apx_vmDeserializer_t *self, double *f64Value)
+{
+   if ( (self != 0) && (f64Value != 0))
+   {
+      if (self->hasValidReadBuf)
+      {
+         if (self->buf.pNext+7u < self->buf.pEnd)
+         {
+            uint64_t tmp = (uint64_t) unpackLE(self->buf.pNext, UINT32_SIZE);
+            tmp |= ((uint64_t) unpackLE(self->buf.pNext+UINT32_SIZE, UINT32_SIZE)) << 32;
+            self->buf.pNext += FLOAT64_SIZE;
+            memcpy(f64Value, &tmp, FLOAT64_SIZE);
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_error_t apx_vmDeserializer_unpackFixedStr(apx_vmDeserializer_t *self, adt_str_t *str, int32_t readLen)
 {
    if ( (self != 0) && (str != 0) && (readLen > 0) )
@@ -538,6 +648,42 @@ apx_error_t apx_vmDeserializer_unpackS32Value(apx_vmDeserializer_t *self, uint32
 
 
 
+apx_error_t apx_vmDeserializer_unpackU64Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmDeserializer_unpackValueInternal(self, maxArrayLen, dynLenType, APX_VARIANT_U64);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmDeserializer_unpackS64Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmDeserializer_unpackValueInternal(self, maxArrayLen, dynLenType, APX_VARIANT_S64);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmDeserializer_unpackFloat32Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmDeserializer_unpackValueInternal(self, maxArrayLen, dynLenType, APX_VARIANT_FLOAT32);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmDeserializer_unpackFloat64Value(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmDeserializer_unpackValueInternal(self, maxArrayLen, dynLenType, APX_VARIANT_FLOAT64);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_error_t apx_vmDeserializer_unpackStrValue(apx_vmDeserializer_t *self, uint32_t maxArrayLen, apx_dynLenType_t dynLenType)
 {
    if (self != 0)
@@ -750,6 +896,18 @@ static apx_error_t apx_vmDeserializer_unpackValueInternal(apx_vmDeserializer_t *
    case APX_VARIANT_S32:
       elemSize = SINT32_SIZE;
       break;
+   case APX_VARIANT_U64:
+      elemSize = UINT64_SIZE;
+      break;
+   case APX_VARIANT_S64:
+      elemSize = SINT64_SIZE;
+      break;
+   case APX_VARIANT_FLOAT32:
+      elemSize = FLOAT32_SIZE;
+      break;
+   case APX_VARIANT_FLOAT64:
+      elemSize = FLOAT64_SIZE;
+      break;
    }
    if (elemSize == 0u)
    {
@@ -787,6 +945,18 @@ static apx_error_t apx_vmDeserializer_unpackValueInternal(apx_vmDeserializer_t *
          case APX_VARIANT_S32:
             rc = apx_vmDeserializer_unpackValueS32(self, &state->value.sv);
             break;
+         case APX_VARIANT_U64:
+            rc = apx_vmDeserializer_unpackValueU64(self, &state->value.sv);
+            break;
+         case APX_VARIANT_S64:
+            rc = apx_vmDeserializer_unpackValueS64(self, &state->value.sv);
+            break;
+         case APX_VARIANT_FLOAT32:
+            rc = apx_vmDeserializer_unpackValueFloat32(self, &state->value.sv);
+            break;
+         case APX_VARIANT_FLOAT64:
+            rc = apx_vmDeserializer_unpackValueFloat64(self, &state->value.sv);
+            break;
          }
 
          if (rc != APX_NO_ERROR)
@@ -836,6 +1006,18 @@ static apx_error_t apx_vmDeserializer_unpackValueInternal(apx_vmDeserializer_t *
             case APX_VARIANT_S32:
                rc = apx_vmDeserializer_unpackValueS32(self, &childValue);
                break;
+            case APX_VARIANT_U64:
+               rc = apx_vmDeserializer_unpackValueU64(self, &childValue);
+               break;
+            case APX_VARIANT_S64:
+               rc = apx_vmDeserializer_unpackValueS64(self, &childValue);
+               break;
+            case APX_VARIANT_FLOAT32:
+               rc = apx_vmDeserializer_unpackValueFloat32(self, &childValue);
+               break;
+            case APX_VARIANT_FLOAT64:
+               rc = apx_vmDeserializer_unpackValueFloat64(self, &childValue);
+               break;
             }
 
             if (rc != APX_NO_ERROR)
@@ -1017,3 +1199,111 @@ static apx_error_t apx_vmDeserializer_unpackValueS32(apx_vmDeserializer_t *self,
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
+
+static apx_error_t apx_vmDeserializer_unpackValueU64(apx_vmDeserializer_t *self, dtl_sv_t **sv)
+{
+   if (sv != 0)
+   {
+      uint64_t u64Value;
+      apx_error_t rc = apx_vmDeserializer_unpackU64(self, &u64Value);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+      if (*sv != 0)
+      {
+         dtl_sv_set_u64(*sv, u64Value);
+      }
+      else
+      {
+         *sv = dtl_sv_make_u64(u64Value);
+         if (*sv == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+static apx_error_t apx_vmDeserializer_unpackValueS64(apx_vmDeserializer_t *self, dtl_sv_t **sv)
+{
+   if (sv != 0)
+   {
+      int64_t s64Value;
+      apx_error_t rc = apx_vmDeserializer_unpackS64(self, &s64Value);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+      if (*sv != 0)
+      {
+         dtl_sv_set_i64(*sv, s64Value);
+      }
+      else
+      {
+         *sv = dtl_sv_make_i64(s64Value);
+         if (*sv == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+static apx_error_t apx_vmDeserializer_unpackValueFloat32(apx_vmDeserializer_t *self, dtl_sv_t **sv)
+{
+   if (sv != 0)
+   {
+      float f32Value;
+      apx_error_t rc = apx_vmDeserializer_unpackFloat32(self, &f32Value);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+      if (*sv != 0)
+      {
+         dtl_sv_set_flt(*sv, f32Value);
+      }
+      else
+      {
+         *sv = dtl_sv_make_flt(f32Value);
+         if (*sv == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+static apx_error_t apx_vmDeserializer_unpackValueFloat64(apx_vmDeserializer_t *self, dtl_sv_t **sv)
+{
+   if (sv != 0)
+   {
+      double f64Value;
+      apx_error_t rc = apx_vmDeserializer_unpackFloat64(self, &f64Value);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+      if (*sv != 0)
+      {
+         dtl_sv_set_dbl(*sv, f64Value);
+      }
+      else
+      {
+         *sv = dtl_sv_make_dbl(f64Value);
+         if (*sv == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
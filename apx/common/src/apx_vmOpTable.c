@@ -0,0 +1,609 @@
+/*****************************************************************************
+* \file      apx_vmOpTable.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Flat, pre-resolved operation table for fixed-layout VM programs
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#include "apx_vmOpTable.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define APX_VM_OP_TABLE_MIN_CAPACITY 8
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_vmOpTable_compileInternal(apx_vmOpTable_t *self, const uint8_t *progBegin, const uint8_t *progEnd);
+static apx_error_t apx_vmOpTable_append(apx_vmOpTable_t *self, const char *key, apx_size_t offset, uint32_t count, uint8_t width, uint8_t variant);
+static uint8_t apx_vmOpTable_variantWidth(uint8_t variant);
+static void apx_vmOpTable_decodeInstruction(uint8_t instruction, uint8_t *opcode, uint8_t *variant, uint8_t *flags);
+static apx_error_t apx_vmOpTable_packScalar(const apx_vmOp_t *op, uint8_t *pDest, const dtl_sv_t *sv);
+static dtl_sv_t *apx_vmOpTable_unpackScalar(const apx_vmOp_t *op, const uint8_t *pSrc);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_vmOpTable_create(apx_vmOpTable_t *self)
+{
+   if (self != 0)
+   {
+      self->ops = (apx_vmOp_t*) 0;
+      self->numOps = 0;
+      self->capacity = 0;
+      self->dataSize = 0u;
+      self->isRecord = false;
+   }
+}
+
+void apx_vmOpTable_destroy(apx_vmOpTable_t *self)
+{
+   if ( (self != 0) && (self->ops != 0) )
+   {
+      free(self->ops);
+      self->ops = (apx_vmOp_t*) 0;
+      self->capacity = 0;
+      self->numOps = 0;
+   }
+}
+
+apx_vmOpTable_t *apx_vmOpTable_new(void)
+{
+   apx_vmOpTable_t *self = (apx_vmOpTable_t*) malloc(sizeof(apx_vmOpTable_t));
+   if (self != 0)
+   {
+      apx_vmOpTable_create(self);
+   }
+   return self;
+}
+
+void apx_vmOpTable_delete(apx_vmOpTable_t *self)
+{
+   if (self != 0)
+   {
+      apx_vmOpTable_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Translates program byte code into a flat operation table.
+ * Returns APX_UNSUPPORTED_ERROR when the program does not have a fixed data layout (strings, dynamic arrays, nested records etc.).
+ * In that case the caller must keep using the byte code interpreter.
+ * The table keeps weak references to record element names inside the program, the program must therefore outlive the table.
+ */
+apx_error_t apx_vmOpTable_compile(apx_vmOpTable_t *self, const uint8_t *progBegin, const uint8_t *progEnd)
+{
+   if ( (self != 0) && (progBegin != 0) && (progEnd != 0) && (progBegin <= progEnd) )
+   {
+      apx_error_t rc;
+      apx_vmOpTable_clear(self);
+      rc = apx_vmOpTable_compileInternal(self, progBegin, progEnd);
+      if (rc != APX_NO_ERROR)
+      {
+         apx_vmOpTable_clear(self);
+      }
+      return rc;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Removes all operations but keeps the allocated memory for reuse
+ */
+void apx_vmOpTable_clear(apx_vmOpTable_t *self)
+{
+   if (self != 0)
+   {
+      self->numOps = 0;
+      self->dataSize = 0u;
+      self->isRecord = false;
+   }
+}
+
+apx_error_t apx_vmOpTable_pack(const apx_vmOpTable_t *self, uint8_t *pDest, apx_size_t bufSize, const dtl_dv_t *dv)
+{
+   if ( (self != 0) && (pDest != 0) && (dv != 0) )
+   {
+      int32_t i;
+      if (self->numOps == 0)
+      {
+         return APX_INVALID_PROGRAM_ERROR;
+      }
+      if (bufSize < self->dataSize)
+      {
+         return APX_BUFFER_BOUNDARY_ERROR;
+      }
+      if ( self->isRecord && (dtl_dv_type(dv) != DTL_DV_HASH) )
+      {
+         return APX_DV_TYPE_ERROR;
+      }
+      for (i = 0; i < self->numOps; i++)
+      {
+         const apx_vmOp_t *op = &self->ops[i];
+         const dtl_dv_t *value = dv;
+         uint8_t *p = pDest + op->offset;
+         apx_error_t rc;
+         if (self->isRecord)
+         {
+            value = dtl_hv_get_cstr((dtl_hv_t*) dv, op->key);
+            if (value == 0)
+            {
+               return APX_NOT_FOUND_ERROR;
+            }
+         }
+         if (op->count == 0u)
+         {
+            if (dtl_dv_type(value) != DTL_DV_SCALAR)
+            {
+               return APX_DV_TYPE_ERROR;
+            }
+            rc = apx_vmOpTable_packScalar(op, p, (const dtl_sv_t*) value);
+            if (rc != APX_NO_ERROR)
+            {
+               return rc;
+            }
+         }
+         else
+         {
+            uint32_t j;
+            const dtl_av_t *av = (const dtl_av_t*) value;
+            if (dtl_dv_type(value) != DTL_DV_ARRAY)
+            {
+               return APX_DV_TYPE_ERROR;
+            }
+            if ( ((uint32_t) dtl_av_length(av)) != op->count )
+            {
+               return APX_LENGTH_ERROR;
+            }
+            for (j = 0u; j < op->count; j++)
+            {
+               const dtl_dv_t *childValue = dtl_av_value(av, (int32_t) j);
+               if ( (childValue == 0) || (dtl_dv_type(childValue) != DTL_DV_SCALAR) )
+               {
+                  return APX_VALUE_ERROR;
+               }
+               rc = apx_vmOpTable_packScalar(op, p, (const dtl_sv_t*) childValue);
+               if (rc != APX_NO_ERROR)
+               {
+                  return rc;
+               }
+               p += op->width;
+            }
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * On success, *dv contains a new value owned by the caller
+ */
+apx_error_t apx_vmOpTable_unpack(const apx_vmOpTable_t *self, const uint8_t *pSrc, apx_size_t bufSize, dtl_dv_t **dv)
+{
+   if ( (self != 0) && (pSrc != 0) && (dv != 0) )
+   {
+      int32_t i;
+      dtl_hv_t *hv = (dtl_hv_t*) 0;
+      dtl_dv_t *value = (dtl_dv_t*) 0;
+      *dv = (dtl_dv_t*) 0;
+      if (self->numOps == 0)
+      {
+         return APX_INVALID_PROGRAM_ERROR;
+      }
+      if (bufSize < self->dataSize)
+      {
+         return APX_BUFFER_BOUNDARY_ERROR;
+      }
+      if (self->isRecord)
+      {
+         hv = dtl_hv_new();
+         if (hv == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      for (i = 0; i < self->numOps; i++)
+      {
+         const apx_vmOp_t *op = &self->ops[i];
+         const uint8_t *p = pSrc + op->offset;
+         if (op->count == 0u)
+         {
+            value = (dtl_dv_t*) apx_vmOpTable_unpackScalar(op, p);
+         }
+         else
+         {
+            uint32_t j;
+            dtl_av_t *av = dtl_av_new();
+            if (av != 0)
+            {
+               for (j = 0u; j < op->count; j++)
+               {
+                  dtl_sv_t *sv = apx_vmOpTable_unpackScalar(op, p);
+                  if (sv == 0)
+                  {
+                     dtl_dec_ref(av);
+                     av = (dtl_av_t*) 0;
+                     break;
+                  }
+                  dtl_av_push(av, (dtl_dv_t*) sv, false);
+                  p += op->width;
+               }
+            }
+            value = (dtl_dv_t*) av;
+         }
+         if (value == 0)
+         {
+            if (hv != 0)
+            {
+               dtl_dec_ref(hv);
+            }
+            return APX_MEM_ERROR;
+         }
+         if (hv != 0)
+         {
+            dtl_hv_set_cstr(hv, op->key, value, false);
+         }
+      }
+      *dv = (hv != 0)? (dtl_dv_t*) hv : value;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+static apx_error_t apx_vmOpTable_compileInternal(apx_vmOpTable_t *self, const uint8_t *progBegin, const uint8_t *progEnd)
+{
+   const uint8_t *pNext;
+   const char *key = (const char*) 0;
+   bool isLastElement = false;
+   apx_size_t offset = 0u;
+   apx_size_t progDataSize;
+   uint8_t expectedOpcode;
+   uint8_t expectedOpcode2;
+   if ( (progEnd - progBegin) < APX_VM_HEADER_SIZE)
+   {
+      return APX_LENGTH_ERROR;
+   }
+   if (progBegin[0] != APX_VM_MAGIC_NUMBER)
+   {
+      return APX_INVALID_PROGRAM_ERROR;
+   }
+   if ( (progBegin[3] & APX_VM_HEADER_FLAG_DYNAMIC) != 0u)
+   {
+      return APX_UNSUPPORTED_ERROR;
+   }
+   if ( (progBegin[3] & 0x0Fu) == APX_VM_HEADER_PACK_PROG)
+   {
+      expectedOpcode = APX_OPCODE_PACK;
+      expectedOpcode2 = APX_OPCODE_PACK2;
+   }
+   else
+   {
+      expectedOpcode = APX_OPCODE_UNPACK;
+      expectedOpcode2 = APX_OPCODE_UNPACK2;
+   }
+   progDataSize = (apx_size_t) unpackLE(&progBegin[APX_VM_HEADER_DATA_OFFSET], UINT32_SIZE);
+   pNext = progBegin + APX_VM_HEADER_SIZE;
+   while (pNext < progEnd)
+   {
+      uint8_t opcode, variant, flags, width;
+      uint32_t count = 0u;
+      apx_error_t rc;
+      apx_vmOpTable_decodeInstruction(*pNext++, &opcode, &variant, &flags);
+      if (opcode == APX_OPCODE_DATA_CTRL)
+      {
+         const uint8_t *pNameEnd;
+         if ( (!self->isRecord) || (variant != APX_VARIANT_RECORD_SELECT) || (key != 0) || isLastElement)
+         {
+            return APX_INVALID_INSTRUCTION_ERROR;
+         }
+         pNameEnd = (const uint8_t*) memchr(pNext, 0, (size_t) (progEnd - pNext));
+         if ( (pNameEnd == 0) || (pNameEnd == pNext) )
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
+         key = (const char*) pNext;
+         isLastElement = ((flags & APX_LAST_FIELD_FLAG) != 0u);
+         pNext = pNameEnd + 1;
+         continue;
+      }
+      if (opcode == expectedOpcode2)
+      {
+         variant = (uint8_t) (variant + APX_VARIANT2_OFFSET);
+      }
+      else if (opcode != expectedOpcode)
+      {
+         return APX_INVALID_INSTRUCTION_ERROR;
+      }
+      if (variant == APX_VARIANT_RECORD)
+      {
+         if ( self->isRecord || (self->numOps > 0) || ((flags & APX_ARRAY_FLAG) != 0u) )
+         {
+            return APX_UNSUPPORTED_ERROR; //nested records and arrays of records stay with the interpreter
+         }
+         self->isRecord = true;
+         continue;
+      }
+      if (self->isRecord && (key == 0) )
+      {
+         return APX_INVALID_PROGRAM_ERROR;
+      }
+      width = apx_vmOpTable_variantWidth(variant);
+      if (width == 0u)
+      {
+         return APX_UNSUPPORTED_ERROR;
+      }
+      if ( (flags & APX_ARRAY_FLAG) != 0u)
+      {
+         uint8_t opcode2, variant2, flags2;
+         uint8_t lenSize;
+         if (pNext >= progEnd)
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
+         apx_vmOpTable_decodeInstruction(*pNext++, &opcode2, &variant2, &flags2);
+         if (opcode2 != APX_OPCODE_ARRAY)
+         {
+            return APX_INVALID_INSTRUCTION_ERROR;
+         }
+         if ( (flags2 & APX_DYN_ARRAY_FLAG) != 0u)
+         {
+            return APX_UNSUPPORTED_ERROR;
+         }
+         switch(variant2)
+         {
+         case APX_VARIANT_U8:
+            lenSize = UINT8_SIZE;
+            break;
+         case APX_VARIANT_U16:
+            lenSize = UINT16_SIZE;
+            break;
+         case APX_VARIANT_U32:
+            lenSize = UINT32_SIZE;
+            break;
+         default:
+            return APX_INVALID_INSTRUCTION_ERROR;
+         }
+         if ( (pNext + lenSize) > progEnd)
+         {
+            return APX_INVALID_PROGRAM_ERROR;
+         }
+         count = unpackLE(pNext, lenSize);
+         pNext += lenSize;
+         if (count == 0u)
+         {
+            return APX_LENGTH_ERROR;
+         }
+      }
+      rc = apx_vmOpTable_append(self, key, offset, count, width, variant);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+      offset += ((apx_size_t) width) * ( (count == 0u)? 1u : count);
+      key = (const char*) 0;
+   }
+   if ( (self->numOps == 0) || (self->isRecord && (!isLastElement) ) || (key != 0) )
+   {
+      return APX_INVALID_PROGRAM_ERROR;
+   }
+   if (offset != progDataSize)
+   {
+      return APX_LENGTH_ERROR;
+   }
+   self->dataSize = offset;
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_vmOpTable_append(apx_vmOpTable_t *self, const char *key, apx_size_t offset, uint32_t count, uint8_t width, uint8_t variant)
+{
+   apx_vmOp_t *op;
+   if (self->numOps >= self->capacity)
+   {
+      int32_t newCapacity = (self->capacity == 0)? APX_VM_OP_TABLE_MIN_CAPACITY : self->capacity*2;
+      apx_vmOp_t *ops = (apx_vmOp_t*) realloc(self->ops, ((size_t) newCapacity) * sizeof(apx_vmOp_t));
+      if (ops == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      self->ops = ops;
+      self->capacity = newCapacity;
+   }
+   op = &self->ops[self->numOps++];
+   op->key = key;
+   op->offset = offset;
+   op->count = count;
+   op->width = width;
+   op->variant = variant;
+   return APX_NO_ERROR;
+}
+
+static uint8_t apx_vmOpTable_variantWidth(uint8_t variant)
+{
+   switch(variant)
+   {
+   case APX_VARIANT_U8:
+      return UINT8_SIZE;
+   case APX_VARIANT_U16:
+      return UINT16_SIZE;
+   case APX_VARIANT_U32:
+      return UINT32_SIZE;
+   case APX_VARIANT_U64:
+      return UINT64_SIZE;
+   case APX_VARIANT_S8:
+      return SINT8_SIZE;
+   case APX_VARIANT_S16:
+      return SINT16_SIZE;
+   case APX_VARIANT_S32:
+      return SINT32_SIZE;
+   case APX_VARIANT_S64:
+      return SINT64_SIZE;
+   case APX_VARIANT_FLOAT32:
+      return FLOAT32_SIZE;
+   case APX_VARIANT_FLOAT64:
+      return FLOAT64_SIZE;
+   default:
+      break;
+   }
+   return 0u;
+}
+
+static void apx_vmOpTable_decodeInstruction(uint8_t instruction, uint8_t *opcode, uint8_t *variant, uint8_t *flags)
+{
+   *opcode = instruction & APX_INST_OPCODE_MASK;
+   *variant = (instruction >> APX_INST_VARIANT_SHIFT) & APX_INST_VARIANT_MASK;
+   *flags = (instruction >> APX_INST_FLAG_SHIFT) & APX_INST_FLAG_MASK;
+}
+
+static apx_error_t apx_vmOpTable_packScalar(const apx_vmOp_t *op, uint8_t *pDest, const dtl_sv_t *sv)
+{
+   bool valueOk = false;
+   switch(op->variant)
+   {
+   case APX_VARIANT_U8:
+   case APX_VARIANT_U16:
+   case APX_VARIANT_U32:
+      {
+         uint32_t u32Value = dtl_sv_to_u32(sv, &valueOk);
+         if (valueOk)
+         {
+            packLE(pDest, u32Value, op->width);
+         }
+      }
+      break;
+   case APX_VARIANT_S8:
+   case APX_VARIANT_S16:
+   case APX_VARIANT_S32:
+      {
+         int32_t s32Value = dtl_sv_to_i32(sv, &valueOk);
+         if (valueOk)
+         {
+            packLE(pDest, (uint32_t) s32Value, op->width);
+         }
+      }
+      break;
+   case APX_VARIANT_U64:
+   case APX_VARIANT_S64:
+      {
+         uint64_t u64Value = (op->variant == APX_VARIANT_U64)? dtl_sv_to_u64(sv, &valueOk) : (uint64_t) dtl_sv_to_i64(sv, &valueOk);
+         if (valueOk)
+         {
+            packLE(pDest, (uint32_t) (u64Value & 0xFFFFFFFFu), UINT32_SIZE);
+            packLE(pDest+UINT32_SIZE, (uint32_t) (u64Value >> 32), UINT32_SIZE);
+         }
+      }
+      break;
+   case APX_VARIANT_FLOAT32:
+      {
+         float f32Value = dtl_sv_to_flt(sv, &valueOk);
+         if (valueOk)
+         {
+            uint32_t tmp;
+            memcpy(&tmp, &f32Value, FLOAT32_SIZE);
+            packLE(pDest, tmp, UINT32_SIZE);
+         }
+      }
+      break;
+   case APX_VARIANT_FLOAT64:
+      {
+         double f64Value = dtl_sv_to_dbl(sv, &valueOk);
+         if (valueOk)
+         {
+            uint64_t tmp;
+            memcpy(&tmp, &f64Value, FLOAT64_SIZE);
+            packLE(pDest, (uint32_t) (tmp & 0xFFFFFFFFu), UINT32_SIZE);
+            packLE(pDest+UINT32_SIZE, (uint32_t) (tmp >> 32), UINT32_SIZE);
+         }
+      }
+      break;
+   default:
+      return APX_UNSUPPORTED_ERROR;
+   }
+   return valueOk? APX_NO_ERROR : APX_VALUE_ERROR;
+}
+
+static dtl_sv_t *apx_vmOpTable_unpackScalar(const apx_vmOp_t *op, const uint8_t *pSrc)
+{
+   switch(op->variant)
+   {
+   case APX_VARIANT_U8:
+   case APX_VARIANT_U16:
+   case APX_VARIANT_U32:
+      return dtl_sv_make_u32(unpackLE(pSrc, op->width));
+   case APX_VARIANT_S8:
+      return dtl_sv_make_i32((int32_t) ((int8_t) *pSrc));
+   case APX_VARIANT_S16:
+      return dtl_sv_make_i32((int32_t) ((int16_t) unpackLE(pSrc, SINT16_SIZE)));
+   case APX_VARIANT_S32:
+      return dtl_sv_make_i32((int32_t) unpackLE(pSrc, SINT32_SIZE));
+   case APX_VARIANT_U64:
+   case APX_VARIANT_S64:
+   case APX_VARIANT_FLOAT64:
+      {
+         uint64_t tmp = (uint64_t) unpackLE(pSrc, UINT32_SIZE);
+         tmp |= ((uint64_t) unpackLE(pSrc+UINT32_SIZE, UINT32_SIZE)) << 32;
+         if (op->variant == APX_VARIANT_U64)
+         {
+            return dtl_sv_make_u64(tmp);
+         }
+         else if (op->variant == APX_VARIANT_S64)
+         {
+            return dtl_sv_make_i64((int64_t) tmp);
+         }
+         else
+         {
+            double f64Value;
+            memcpy(&f64Value, &tmp, FLOAT64_SIZE);
+            return dtl_sv_make_dbl(f64Value);
+         }
+      }
+   case APX_VARIANT_FLOAT32:
+      {
+         float f32Value;
+         uint32_t tmp = unpackLE(pSrc, UINT32_SIZE);
+         memcpy(&f32Value, &tmp, FLOAT32_SIZE);
+         return dtl_sv_make_flt(f32Value);
+      }
+   default:
+      break;
+   }
+   return (dtl_sv_t*) 0;
+}
@@ -55,6 +55,10 @@ static apx_error_t apx_vmSerializer_packValueU32(apx_vmSerializer_t *self, const
 static apx_error_t apx_vmSerializer_packValueS8(apx_vmSerializer_t *self, const dtl_sv_t *sv);
 static apx_error_t apx_vmSerializer_packValueS16(apx_vmSerializer_t *self, const dtl_sv_t *sv);
 static apx_error_t apx_vmSerializer_packValueS32(apx_vmSerializer_t *self, const dtl_sv_t *sv);
+static apx_error_t apx_vmSerializer_packValueU64(apx_vmSerializer_t *self, const dtl_sv_t *sv);
+static apx_error_t apx_vmSerializer_packValueS64(apx_vmSerializer_t *self, const dtl_sv_t *sv);
+static apx_error_t apx_vmSerializer_packValueFloat32(apx_vmSerializer_t *self, const dtl_sv_t *sv);
+static apx_error_t apx_vmSerializer_packValueFloat64(apx_vmSerializer_t *self, const dtl_sv_t *sv);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -390,6 +394,112 @@ apx_error_t apx_vmSerializer_packS32(apx_vmSerializer_t *self, int32_t s32Value)
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+apx_error_t apx_vmSerializer_packU64(apx_vmSerializer_t *self, uint64_t u64Value)
+{
+   if ( self != 0)
+   {
+      if (self->hasValidWriteBuf)
+      {
+         if (self->buf.pNext+7u < self->buf.pEnd)
+         {
+            packLE(self->buf.pNext, (uint32_t) (u64Value & 0xFFFFFFFFu), UINT32_SIZE);
+            packLE(self->buf.pNext+UINT32_SIZE, (uint32_t) (u64Value >> 32), UINT32_SIZE);
+            self->buf.pNext += UINT64_SIZE;
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmSerializer_packS64(apx_vmSerializer_t *self, int64_t s64Value)
+{
+   if ( self != 0)
+   {
+      if (self->hasValidWriteBuf)
+      {
+         if (self->buf.pNext+7u < self->buf.pEnd)
+         {
+            packLE(self->buf.pNext, (uint32_t) (((uint64_t) s64Value) & 0xFFFFFFFFu), UINT32_SIZE);
+            packLE(self->buf.pNext+UINT32_SIZE, (uint32_t) (((uint64_t) s64Value) >> 32), UINT32_SIZE);
+            self->buf.pNext += SINT64_SIZE;
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmSerializer_packFloat32(apx_vmSerializer_t *self, float f32Value)
+{
+   if ( self != 0)
+   {
+      if (self->hasValidWriteBuf)
+      {
+         if (self->buf.pNext+3u < self->buf.pEnd)
+         {
+            uint32_t tmp;
+            memcpy(&tmp, &f32Value, FLOAT32_SIZE);
+            packU32LE(self->buf.pNext, tmp);
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmSerializer_packFloat64(apx_vmSerializer_t *self, double f64Value)
+{
+   if ( self != 0)
+   {
+      if (self->hasValidWriteBuf)
+      {
+         if (self->buf.pNext+7u < self->buf.pEnd)
+         {
+            uint64_t tmp;
+            memcpy(&tmp, &f64Value, FLOAT64_SIZE);
+            packLE(self->buf.pNext, (uint32_t) (tmp & 0xFFFFFFFFu), UINT32_SIZE);
+            packLE(self->buf.pNext+UINT32_SIZE, (uint32_t) (tmp >> 32), UINT32_SIZE);
+            self->buf.pNext += FLOAT64_SIZE;
+            return APX_NO_ERROR;
+         }
+         else
+         {
+            return APX_BUFFER_BOUNDARY_ERROR;
+         }
+      }
+      else
+      {
+         return APX_MISSING_BUFFER_ERROR;
+      }
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_error_t apx_vmSerializer_packFixedStr(apx_vmSerializer_t *self, const adt_str_t *str, int32_t writeLen)
 {
    if ( (self != 0) && (str != 0) && (writeLen > 0) )
@@ -503,6 +613,42 @@ apx_error_t apx_vmSerializer_packValueAsS32(apx_vmSerializer_t *self, uint32_t a
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+apx_error_t apx_vmSerializer_packValueAsU64(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmSerializer_packValueInternal(self, arrayLen, dynLenType, APX_VARIANT_U64);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmSerializer_packValueAsS64(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmSerializer_packValueInternal(self, arrayLen, dynLenType, APX_VARIANT_S64);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmSerializer_packValueAsFloat32(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmSerializer_packValueInternal(self, arrayLen, dynLenType, APX_VARIANT_FLOAT32);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_vmSerializer_packValueAsFloat64(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType)
+{
+   if (self != 0)
+   {
+      return apx_vmSerializer_packValueInternal(self, arrayLen, dynLenType, APX_VARIANT_FLOAT64);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
 apx_error_t apx_vmSerializer_packValueAsString(apx_vmSerializer_t *self, uint32_t arrayLen, apx_dynLenType_t dynLenType)
 {
    return apx_vmSerializer_packValueInternal(self, arrayLen, dynLenType, APX_VARIANT_STR);
@@ -736,6 +882,18 @@ static apx_error_t apx_vmSerializer_packValueInternal(apx_vmSerializer_t *self,
    case APX_VARIANT_S32:
       elemSize = SINT32_SIZE;
       break;
+   case APX_VARIANT_U64:
+      elemSize = UINT64_SIZE;
+      break;
+   case APX_VARIANT_S64:
+      elemSize = SINT64_SIZE;
+      break;
+   case APX_VARIANT_FLOAT32:
+      elemSize = FLOAT32_SIZE;
+      break;
+   case APX_VARIANT_FLOAT64:
+      elemSize = FLOAT64_SIZE;
+      break;
    case APX_VARIANT_STR:
       elemSize = UINT8_SIZE;
       break;
@@ -771,6 +929,18 @@ static apx_error_t apx_vmSerializer_packValueInternal(apx_vmSerializer_t *self,
          case APX_VARIANT_S32:
             rc = apx_vmSerializer_packValueS32(self, state->value.sv);
             break;
+         case APX_VARIANT_U64:
+            rc = apx_vmSerializer_packValueU64(self, state->value.sv);
+            break;
+         case APX_VARIANT_S64:
+            rc = apx_vmSerializer_packValueS64(self, state->value.sv);
+            break;
+         case APX_VARIANT_FLOAT32:
+            rc = apx_vmSerializer_packValueFloat32(self, state->value.sv);
+            break;
+         case APX_VARIANT_FLOAT64:
+            rc = apx_vmSerializer_packValueFloat64(self, state->value.sv);
+            break;
          }
          if (rc != APX_NO_ERROR)
          {
@@ -850,6 +1020,18 @@ static apx_error_t apx_vmSerializer_packValueInternal(apx_vmSerializer_t *self,
                   case APX_VARIANT_S32:
                      rc = apx_vmSerializer_packValueS32(self, (dtl_sv_t*) childValue);
                      break;
+                  case APX_VARIANT_U64:
+                     rc = apx_vmSerializer_packValueU64(self, (dtl_sv_t*) childValue);
+                     break;
+                  case APX_VARIANT_S64:
+                     rc = apx_vmSerializer_packValueS64(self, (dtl_sv_t*) childValue);
+                     break;
+                  case APX_VARIANT_FLOAT32:
+                     rc = apx_vmSerializer_packValueFloat32(self, (dtl_sv_t*) childValue);
+                     break;
+                  case APX_VARIANT_FLOAT64:
+                     rc = apx_vmSerializer_packValueFloat64(self, (dtl_sv_t*) childValue);
+                     break;
                   }
                   if (rc != APX_NO_ERROR)
                   {
@@ -991,3 +1173,79 @@ static apx_error_t apx_vmSerializer_packValueS32(apx_vmSerializer_t *self, const
    }
    return APX_NO_ERROR;
 }
+
+static apx_error_t apx_vmSerializer_packValueU64(apx_vmSerializer_t *self, const dtl_sv_t *sv)
+{
+   bool valueOk = false;
+   uint64_t u64Value = dtl_sv_to_u64(sv, &valueOk);
+   if (valueOk)
+   {
+      apx_error_t rc = apx_vmSerializer_packU64(self, u64Value);
+      if ( rc != APX_NO_ERROR )
+      {
+         return rc;
+      }
+   }
+   else
+   {
+      return APX_VALUE_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_vmSerializer_packValueS64(apx_vmSerializer_t *self, const dtl_sv_t *sv)
+{
+   bool valueOk = false;
+   int64_t s64Value = dtl_sv_to_i64(sv, &valueOk);
+   if (valueOk)
+   {
+      apx_error_t rc = apx_vmSerializer_packS64(self, s64Value);
+      if ( rc != APX_NO_ERROR )
+      {
+         return rc;
+      }
+   }
+   else
+   {
+      return APX_VALUE_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_vmSerializer_packValueFloat32(apx_vmSerializer_t *self, const dtl_sv_t *sv)
+{
+   bool valueOk = false;
+   float f32Value = dtl_sv_to_flt(sv, &valueOk);
+   if (valueOk)
+   {
+      apx_error_t rc = apx_vmSerializer_packFloat32(self, f32Value);
+      if ( rc != APX_NO_ERROR )
+      {
+         return rc;
+      }
+   }
+   else
+   {
+      return APX_VALUE_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static apx_error_t apx_vmSerializer_packValueFloat64(apx_vmSerializer_t *self, const dtl_sv_t *sv)
+{
+   bool valueOk = false;
+   double f64Value = dtl_sv_to_dbl(sv, &valueOk);
+   if (valueOk)
+   {
+      apx_error_t rc = apx_vmSerializer_packFloat64(self, f64Value);
+      if ( rc != APX_NO_ERROR )
+      {
+         return rc;
+      }
+   }
+   else
+   {
+      return APX_VALUE_ERROR;
+   }
+   return APX_NO_ERROR;
+}
@@ -0,0 +1,547 @@
+/*****************************************************************************
+* \file      apx_writeCoalescer.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Latest-value-wins table of pending dynamic data writes
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "apx_writeCoalescer.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define MIN_CAPACITY 16u
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static uint32_t apx_writeCoalescer_hash(uint32_t address);
+static apx_writeCoalescerEntry_t *apx_writeCoalescer_findEntry(const apx_writeCoalescer_t *self, uint32_t address, bool findNewest);
+static uint32_t apx_writeCoalescer_findOrderPos(const apx_writeCoalescer_t *self, uint32_t address, uint32_t sequence);
+static bool apx_writeCoalescer_scanOverlaps(apx_writeCoalescer_t *self, uint32_t pos, uint32_t begin, uint32_t end, bool markOlder);
+static bool apx_writeCoalescer_isOverlapping(const apx_writeCoalescerEntry_t *entry, uint32_t begin, uint32_t end);
+static bool apx_writeCoalescer_isNewer(uint32_t sequence, uint32_t other);
+static apx_error_t apx_writeCoalescer_grow(apx_writeCoalescer_t *self);
+static uint8_t *apx_writeCoalescerEntry_data(apx_writeCoalescerEntry_t *entry);
+static apx_error_t apx_writeCoalescerEntry_reserve(apx_writeCoalescerEntry_t *entry, uint32_t len);
+static void apx_writeCoalescer_removeEntry(apx_writeCoalescer_t *self, apx_writeCoalescerEntry_t *entry);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+void apx_writeCoalescer_create(apx_writeCoalescer_t *self)
+{
+   if (self != 0)
+   {
+      self->entries = (apx_writeCoalescerEntry_t*) 0;
+      self->order = (uint32_t*) 0;
+      self->capacity = 0u;
+      self->length = 0u;
+      self->maxLen = 0u;
+      self->numWrites = 0u;
+      self->numMerged = 0u;
+      self->nextSequence = 0u;
+   }
+}
+
+void apx_writeCoalescer_destroy(apx_writeCoalescer_t *self)
+{
+   if (self != 0)
+   {
+      apx_writeCoalescer_clear(self);
+      if (self->entries != 0)
+      {
+         free(self->entries);
+         self->entries = (apx_writeCoalescerEntry_t*) 0;
+      }
+      if (self->order != 0)
+      {
+         free(self->order);
+         self->order = (uint32_t*) 0;
+      }
+      self->capacity = 0u;
+   }
+}
+
+apx_writeCoalescer_t *apx_writeCoalescer_new(void)
+{
+   apx_writeCoalescer_t *self = (apx_writeCoalescer_t*) malloc(sizeof(apx_writeCoalescer_t));
+   if (self != 0)
+   {
+      apx_writeCoalescer_create(self);
+   }
+   return self;
+}
+
+void apx_writeCoalescer_delete(apx_writeCoalescer_t *self)
+{
+   if (self != 0)
+   {
+      apx_writeCoalescer_destroy(self);
+      free(self);
+   }
+}
+
+/**
+ * Stores the newest bytes written to address.
+ * isMerged is set to true when the write was merged into a pending entry, the caller shall then not queue another message.
+ * When isMerged is false a new entry was created and the caller shall queue one message for it.
+ */
+apx_error_t apx_writeCoalescer_write(apx_writeCoalescer_t *self, uint32_t address, const uint8_t *data, uint32_t len, bool *isMerged)
+{
+   if ( (self != 0) && (data != 0) && (isMerged != 0) )
+   {
+      apx_writeCoalescerEntry_t *entry = apx_writeCoalescer_findEntry(self, address, true);
+      uint32_t pos = 0u;
+      if ( (entry != 0) && entry->hasNewerOverlap )
+      {
+         entry = (apx_writeCoalescerEntry_t*) 0;
+      }
+      if ( (entry != 0) && (len > entry->len) )
+      {
+         //only the bytes beyond the current end can overlap entries the flag doesn't know about yet
+         pos = apx_writeCoalescer_findOrderPos(self, address, entry->sequence);
+         if (apx_writeCoalescer_scanOverlaps(self, pos, address + entry->len, address + len, false))
+         {
+            entry = (apx_writeCoalescerEntry_t*) 0;
+         }
+      }
+      if (entry != 0)
+      {
+         if (len > entry->len)
+         {
+            uint32_t oldLen = entry->len;
+            if (apx_writeCoalescerEntry_reserve(entry, len) != APX_NO_ERROR)
+            {
+               return APX_MEM_ERROR;
+            }
+            entry->len = len;
+            if (len > self->maxLen)
+            {
+               self->maxLen = len;
+            }
+            (void) apx_writeCoalescer_scanOverlaps(self, pos, address + oldLen, address + len, true);
+         }
+         memcpy(apx_writeCoalescerEntry_data(entry), data, len);
+         self->numMerged++;
+         *isMerged = true;
+      }
+      else
+      {
+         uint32_t i;
+         if ( (self->length + 1u) * 4u > self->capacity * 3u )
+         {
+            apx_error_t rc = apx_writeCoalescer_grow(self);
+            if (rc != APX_NO_ERROR)
+            {
+               return rc;
+            }
+         }
+         i = apx_writeCoalescer_hash(address) & (self->capacity - 1u);
+         while (self->entries[i].isUsed)
+         {
+            i = (i + 1u) & (self->capacity - 1u);
+         }
+         entry = &self->entries[i];
+         entry->address = address;
+         entry->sequence = self->nextSequence++;
+         entry->len = 0u;
+         entry->capacity = 0u;
+         entry->heapData = (uint8_t*) 0;
+         if (apx_writeCoalescerEntry_reserve(entry, len) != APX_NO_ERROR)
+         {
+            return APX_MEM_ERROR;
+         }
+         entry->len = len;
+         entry->isUsed = true;
+         entry->hasNewerOverlap = false;
+         memcpy(apx_writeCoalescerEntry_data(entry), data, len);
+         //entry has the newest sequence, it goes after all other entries with the same address
+         pos = apx_writeCoalescer_findOrderPos(self, address, entry->sequence);
+         memmove(&self->order[pos + 1u], &self->order[pos], (self->length - pos) * sizeof(uint32_t));
+         self->order[pos] = i;
+         self->length++;
+         if (len > self->maxLen)
+         {
+            self->maxLen = len;
+         }
+         (void) apx_writeCoalescer_scanOverlaps(self, pos, address, address + len, true);
+         *isMerged = false;
+      }
+      self->numWrites++;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Returns number of bytes pending in the oldest entry for address, -1 when there is no pending entry
+ */
+int32_t apx_writeCoalescer_getLength(const apx_writeCoalescer_t *self, uint32_t address)
+{
+   apx_writeCoalescerEntry_t *entry = apx_writeCoalescer_findEntry(self, address, false);
+   return (entry != 0)? (int32_t) entry->len : -1;
+}
+
+/**
+ * Copies pending bytes of the oldest entry for address into dest and removes the entry. Returns number of bytes copied.
+ * Returns -1 when there is no pending entry and -2 when dest is too small (entry is then left untouched).
+ */
+int32_t apx_writeCoalescer_take(apx_writeCoalescer_t *self, uint32_t address, uint8_t *dest, uint32_t destLen)
+{
+   int32_t retval;
+   apx_writeCoalescerEntry_t *entry = apx_writeCoalescer_findEntry(self, address, false);
+   if (entry == 0)
+   {
+      return -1;
+   }
+   if ( (dest == 0) || (entry->len > destLen) )
+   {
+      return -2;
+   }
+   retval = (int32_t) entry->len;
+   memcpy(dest, apx_writeCoalescerEntry_data(entry), entry->len);
+   apx_writeCoalescer_removeEntry(self, entry);
+   return retval;
+}
+
+/**
+ * Removes the oldest entry for address, use when its queued message is dropped
+ */
+void apx_writeCoalescer_remove(apx_writeCoalescer_t *self, uint32_t address)
+{
+   apx_writeCoalescerEntry_t *entry = apx_writeCoalescer_findEntry(self, address, false);
+   if (entry != 0)
+   {
+      apx_writeCoalescer_removeEntry(self, entry);
+   }
+}
+
+/**
+ * Removes the newest entry for address, use when the message for a write that wasn't merged couldn't be queued
+ */
+void apx_writeCoalescer_removeNewest(apx_writeCoalescer_t *self, uint32_t address)
+{
+   apx_writeCoalescerEntry_t *entry = apx_writeCoalescer_findEntry(self, address, true);
+   if (entry != 0)
+   {
+      apx_writeCoalescer_removeEntry(self, entry);
+   }
+}
+
+/**
+ * Drops all pending writes, statistics are kept
+ */
+void apx_writeCoalescer_clear(apx_writeCoalescer_t *self)
+{
+   if ( (self != 0) && (self->entries != 0) )
+   {
+      uint32_t i;
+      for (i = 0u; i < self->capacity; i++)
+      {
+         apx_writeCoalescerEntry_t *entry = &self->entries[i];
+         if ( entry->isUsed && (entry->heapData != 0) )
+         {
+            free(entry->heapData);
+         }
+         entry->isUsed = false;
+      }
+      self->length = 0u;
+      self->maxLen = 0u;
+   }
+}
+
+uint32_t apx_writeCoalescer_length(const apx_writeCoalescer_t *self)
+{
+   if (self != 0)
+   {
+      return self->length;
+   }
+   return 0u;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Addresses of ports in the same file are close together, mix the bits before using the low bits as index
+ */
+static uint32_t apx_writeCoalescer_hash(uint32_t address)
+{
+   address ^= address >> 16;
+   address *= 0x7feb352dU;
+   address ^= address >> 15;
+   address *= 0x846ca68bU;
+   address ^= address >> 16;
+   return address;
+}
+
+/**
+ * There is normally at most one entry per address. All entries of the probe sequence are checked since an overlapping write
+ * can add another entry for the same address.
+ */
+static apx_writeCoalescerEntry_t *apx_writeCoalescer_findEntry(const apx_writeCoalescer_t *self, uint32_t address, bool findNewest)
+{
+   apx_writeCoalescerEntry_t *retval = (apx_writeCoalescerEntry_t*) 0;
+   if ( (self != 0) && (self->length > 0u) )
+   {
+      uint32_t i = apx_writeCoalescer_hash(address) & (self->capacity - 1u);
+      while (self->entries[i].isUsed)
+      {
+         apx_writeCoalescerEntry_t *entry = &self->entries[i];
+         if (entry->address == address)
+         {
+            if ( (retval == 0) || (apx_writeCoalescer_isNewer(entry->sequence, retval->sequence) == findNewest) )
+            {
+               retval = entry;
+            }
+         }
+         i = (i + 1u) & (self->capacity - 1u);
+      }
+   }
+   return retval;
+}
+
+/**
+ * Binary search in order. Returns the position of the entry with the given address and sequence, or the position where
+ * such an entry would be inserted.
+ */
+static uint32_t apx_writeCoalescer_findOrderPos(const apx_writeCoalescer_t *self, uint32_t address, uint32_t sequence)
+{
+   uint32_t low = 0u;
+   uint32_t high = self->length;
+   while (low < high)
+   {
+      uint32_t mid = low + ((high - low) / 2u);
+      const apx_writeCoalescerEntry_t *entry = &self->entries[self->order[mid]];
+      if ( (entry->address < address) || ( (entry->address == address) && apx_writeCoalescer_isNewer(sequence, entry->sequence) ) )
+      {
+         low = mid + 1u;
+      }
+      else
+      {
+         high = mid;
+      }
+   }
+   return low;
+}
+
+/**
+ * Visits the entries around order position pos (the entry itself is skipped) whose bytes overlap [begin, end).
+ * Returns true when one of them was created after the entry at pos, merging newer bytes into that entry would send them
+ * ahead of the other entry's older bytes. When markOlder is true, overlapping entries created before the entry at pos are
+ * flagged for the same reason.
+ * Entries before pos start at or below begin, none of them can reach begin when they start maxLen bytes or more below it.
+ */
+static bool apx_writeCoalescer_scanOverlaps(apx_writeCoalescer_t *self, uint32_t pos, uint32_t begin, uint32_t end, bool markOlder)
+{
+   apx_writeCoalescerEntry_t *entry = &self->entries[self->order[pos]];
+   bool retval = false;
+   uint32_t i;
+   for (i = pos; i > 0u; i--)
+   {
+      apx_writeCoalescerEntry_t *other = &self->entries[self->order[i - 1u]];
+      if ( (begin - other->address) >= self->maxLen )
+      {
+         break;
+      }
+      if (apx_writeCoalescer_isOverlapping(other, begin, end))
+      {
+         if (apx_writeCoalescer_isNewer(other->sequence, entry->sequence))
+         {
+            retval = true;
+         }
+         else if (markOlder)
+         {
+            other->hasNewerOverlap = true;
+         }
+      }
+   }
+   for (i = pos + 1u; i < self->length; i++)
+   {
+      apx_writeCoalescerEntry_t *other = &self->entries[self->order[i]];
+      if (other->address >= end)
+      {
+         break;
+      }
+      if (apx_writeCoalescer_isOverlapping(other, begin, end))
+      {
+         if (apx_writeCoalescer_isNewer(other->sequence, entry->sequence))
+         {
+            retval = true;
+         }
+         else if (markOlder)
+         {
+            other->hasNewerOverlap = true;
+         }
+      }
+   }
+   return retval;
+}
+
+static bool apx_writeCoalescer_isOverlapping(const apx_writeCoalescerEntry_t *entry, uint32_t begin, uint32_t end)
+{
+   if (begin >= end)
+   {
+      return false;
+   }
+   return (entry->address >= begin)? (entry->address - begin < end - begin) : (begin - entry->address < entry->len);
+}
+
+static bool apx_writeCoalescer_isNewer(uint32_t sequence, uint32_t other)
+{
+   return ((int32_t) (sequence - other) > 0)? true : false;
+}
+
+static apx_error_t apx_writeCoalescer_grow(apx_writeCoalescer_t *self)
+{
+   uint32_t i;
+   uint32_t oldCapacity = self->capacity;
+   apx_writeCoalescerEntry_t *oldEntries = self->entries;
+   uint32_t newCapacity = (oldCapacity == 0u)? MIN_CAPACITY : oldCapacity * 2u;
+   apx_writeCoalescerEntry_t *newEntries = (apx_writeCoalescerEntry_t*) malloc(newCapacity * sizeof(apx_writeCoalescerEntry_t));
+   uint32_t *newOrder;
+   if (newEntries == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   newOrder = (uint32_t*) malloc(newCapacity * sizeof(uint32_t));
+   if (newOrder == 0)
+   {
+      free(newEntries);
+      return APX_MEM_ERROR;
+   }
+   for (i = 0u; i < newCapacity; i++)
+   {
+      newEntries[i].isUsed = false;
+   }
+   //rehash in sorted order so the new order array can be filled in the same pass
+   for (i = 0u; i < self->length; i++)
+   {
+      const apx_writeCoalescerEntry_t *oldEntry = &oldEntries[self->order[i]];
+      uint32_t j = apx_writeCoalescer_hash(oldEntry->address) & (newCapacity - 1u);
+      while (newEntries[j].isUsed)
+      {
+         j = (j + 1u) & (newCapacity - 1u);
+      }
+      newEntries[j] = *oldEntry;
+      newOrder[i] = j;
+   }
+   if (oldEntries != 0)
+   {
+      free(oldEntries);
+   }
+   if (self->order != 0)
+   {
+      free(self->order);
+   }
+   self->entries = newEntries;
+   self->order = newOrder;
+   self->capacity = newCapacity;
+   return APX_NO_ERROR;
+}
+
+static uint8_t *apx_writeCoalescerEntry_data(apx_writeCoalescerEntry_t *entry)
+{
+   return (entry->heapData != 0)? entry->heapData : &entry->inlineData[0];
+}
+
+/**
+ * Makes room for len bytes, keeping current content
+ */
+static apx_error_t apx_writeCoalescerEntry_reserve(apx_writeCoalescerEntry_t *entry, uint32_t len)
+{
+   if (len <= APX_WRITE_COALESCER_INLINE_SIZE)
+   {
+      return APX_NO_ERROR;
+   }
+   if (len > entry->capacity)
+   {
+      uint8_t *heapData = (uint8_t*) malloc(len);
+      if (heapData == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      memcpy(heapData, apx_writeCoalescerEntry_data(entry), entry->len);
+      if (entry->heapData != 0)
+      {
+         free(entry->heapData);
+      }
+      entry->heapData = heapData;
+      entry->capacity = len;
+   }
+   return APX_NO_ERROR;
+}
+
+/**
+ * Backward-shift deletion, keeps probe sequences intact without tombstones
+ */
+static void apx_writeCoalescer_removeEntry(apx_writeCoalescer_t *self, apx_writeCoalescerEntry_t *entry)
+{
+   uint32_t mask = self->capacity - 1u;
+   uint32_t i = (uint32_t) (entry - self->entries);
+   uint32_t j = i;
+   uint32_t pos = apx_writeCoalescer_findOrderPos(self, entry->address, entry->sequence);
+   assert(self->order[pos] == i);
+   memmove(&self->order[pos], &self->order[pos + 1u], (self->length - pos - 1u) * sizeof(uint32_t));
+   self->length--;
+   if (entry->heapData != 0)
+   {
+      free(entry->heapData);
+   }
+   for (;;)
+   {
+      uint32_t home;
+      j = (j + 1u) & mask;
+      if (!self->entries[j].isUsed)
+      {
+         break;
+      }
+      home = apx_writeCoalescer_hash(self->entries[j].address) & mask;
+      //move entry j into the hole at i unless its home slot lies cyclically in (i, j]
+      if ( ( (j > i) && ( (home <= i) || (home > j) ) ) ||
+           ( (j < i) && ( (home <= i) && (home > j) ) ) )
+      {
+         self->order[apx_writeCoalescer_findOrderPos(self, self->entries[j].address, self->entries[j].sequence)] = i;
+         self->entries[i] = self->entries[j];
+         i = j;
+      }
+   }
+   self->entries[i].isUsed = false;
+   if (self->length == 0u)
+   {
+      self->maxLen = 0u;
+   }
+}
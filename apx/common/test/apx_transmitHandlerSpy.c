@@ -110,6 +110,22 @@ int32_t apx_transmitHandlerSpy_send(void *arg, int32_t offset, int32_t msgLen)
    return -1;
 }
 
+int32_t apx_transmitHandlerSpy_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   apx_transmitHandlerSpy_t* self = (apx_transmitHandlerSpy_t*) arg;
+   if ( (self != 0) && (data != 0) && (dataLen > 0) )
+   {
+      adt_bytearray_t *batch = adt_bytearray_new(ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+      if (batch != 0)
+      {
+         adt_bytearray_append(batch, data, (uint32_t) dataLen);
+         adt_ary_push(self->transmitted, batch);
+         return dataLen;
+      }
+   }
+   return -1;
+}
+
 
 
 //////////////////////////////////////////////////////////////////////////////
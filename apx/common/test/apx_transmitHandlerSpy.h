@@ -54,5 +54,6 @@ adt_bytearray_t *apx_transmitHandlerSpy_next(apx_transmitHandlerSpy_t *self);
 
 uint8_t* apx_transmitHandlerSpy_getSendBuffer(void *arg, int32_t msgLen);
 int32_t apx_transmitHandlerSpy_send(void *arg, int32_t offset, int32_t msgLen);
+int32_t apx_transmitHandlerSpy_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
 
 #endif //TRANSMIT_HANDLER_SPY_H
@@ -17,6 +17,7 @@ CuSuite* testSuite_apx_compiler(void);
 CuSuite* testSuite_apx_dataElement(void);
 CuSuite* testsuite_apx_dataSignature(void);
 CuSuite* testsuite_apx_datatype(void);
+CuSuite* testSuite_apx_epoch(void);
 CuSuite* testSuite_apx_eventLoop(void);
 CuSuite* testSuite_apx_file2(void);
 CuSuite* testSuite_apx_fileManagerShared(void);
@@ -26,6 +27,8 @@ CuSuite* testSuite_apx_fileManager(void);
 CuSuite* testSuite_apx_fileMap(void);
 CuSuite* testSuite_apx_node(void);
 CuSuite* testSuite_apx_nodeData2(void);
+CuSuite* testSuite_apx_definitionCache(void);
+CuSuite* testSuite_apx_nodeImage(void);
 CuSuite* testSuite_apx_nodeManager(void);
 CuSuite* testSuite_apx_nodeInfo(void);
 CuSuite* testSuite_apx_nodeInstance(void);
@@ -34,20 +37,30 @@ CuSuite* testsuite_apx_port(void);
 CuSuite* testSuite_apx_portConnectorChangeEntry(void);
 CuSuite* testSuite_apx_portConnectorChangeTable(void);
 CuSuite* testSuite_apx_portSignatureMap(void);
+CuSuite* testSuite_apx_portWriteFilter(void);
+CuSuite* testSuite_apx_routingPlan(void);
+CuSuite* testSuite_apx_signatureTable(void);
+CuSuite* testSuite_apx_writeCoalescer(void);
+CuSuite* testSuite_apx_mpscRing(void);
+CuSuite* testSuite_apx_shmChannel(void);
+CuSuite* testSuite_apx_sha256(void);
 CuSuite* testSuite_apx_vm(void);
 CuSuite* testSuite_apx_vmSerializer(void);
 CuSuite* testSuite_apx_vmDeserializer(void);
+CuSuite* testSuite_apx_vmOpTable(void);
 CuSuite* testSuite_apx_connectionBase(void);
 CuSuite* testSuite_apx_util(void);
 
 /** APX Server **/
 CuSuite* testSuite_apx_serverConnection(void);
+CuSuite* testSuite_apx_dataPlane(void);
 CuSuite* testSuite_apx_dataRouting(void);
 
 
 /** APX Server Extensions **/
 CuSuite* testSuite_apx_serverSocketConnection(void);
 CuSuite* testsuite_apx_socketServerExtension(void);
+CuSuite* testSuite_apx_socketReactor(void);
 CuSuite* testsuite_apx_serverTextLogExtension(void);
 
 /** APX Client **/
@@ -70,16 +83,19 @@ void RunAllTests(void)
    CuSuiteAddSuite(suite, testSuite_apx_dataElement());
    CuSuiteAddSuite(suite, testsuite_apx_dataSignature());
    CuSuiteAddSuite(suite, testsuite_apx_datatype());
+   CuSuiteAddSuite(suite, testSuite_apx_epoch());
    CuSuiteAddSuite(suite, testSuite_apx_eventLoop());
 
    CuSuiteAddSuite(suite, testSuite_apx_node());
    CuSuiteAddSuite(suite, testSuite_apx_nodeData2());
    CuSuiteAddSuite(suite, testSuite_apx_nodeInfo());
    CuSuiteAddSuite(suite, testSuite_apx_nodeInstance());
+   CuSuiteAddSuite(suite, testSuite_apx_nodeImage());
    CuSuiteAddSuite(suite, testSuite_apx_parser());
    CuSuiteAddSuite(suite, testsuite_apx_port());
    CuSuiteAddSuite(suite, testSuite_apx_vm());
    CuSuiteAddSuite(suite, testSuite_apx_nodeManager());
+   CuSuiteAddSuite(suite, testSuite_apx_definitionCache());
    CuSuiteAddSuite(suite, testSuite_apx_connectionBase());
 
 
@@ -87,6 +103,7 @@ void RunAllTests(void)
    CuSuiteAddSuite(suite, testSuite_apx_fileMap());
    CuSuiteAddSuite(suite, testSuite_apx_vmSerializer());
    CuSuiteAddSuite(suite, testSuite_apx_vmDeserializer());
+   CuSuiteAddSuite(suite, testSuite_apx_vmOpTable());
 
    //File Manager
    CuSuiteAddSuite(suite, testSuite_apx_fileManagerShared());
@@ -98,14 +115,22 @@ void RunAllTests(void)
    CuSuiteAddSuite(suite, testSuite_apx_portConnectorChangeEntry());
    CuSuiteAddSuite(suite, testSuite_apx_portConnectorChangeTable());
    CuSuiteAddSuite(suite, testSuite_apx_portSignatureMap());
+   CuSuiteAddSuite(suite, testSuite_apx_portWriteFilter());
+   CuSuiteAddSuite(suite, testSuite_apx_routingPlan());
+   CuSuiteAddSuite(suite, testSuite_apx_signatureTable());
+   CuSuiteAddSuite(suite, testSuite_apx_writeCoalescer());
+   CuSuiteAddSuite(suite, testSuite_apx_mpscRing());
+   CuSuiteAddSuite(suite, testSuite_apx_shmChannel());
 
    //Util
    CuSuiteAddSuite(suite, testSuite_apx_util());
+   CuSuiteAddSuite(suite, testSuite_apx_sha256());
 
 
    // APX Server
    CuSuiteAddSuite(suite, testSuite_apx_serverConnection());
    CuSuiteAddSuite(suite, testSuite_apx_dataRouting());
+   CuSuiteAddSuite(suite, testSuite_apx_dataPlane());
 
    // APX Client
    CuSuiteAddSuite(suite, testSuite_apx_client());
@@ -120,6 +145,7 @@ void RunAllTests(void)
 
 // APX Server Extensions
    CuSuiteAddSuite(suite, testsuite_apx_socketServerExtension());
+   CuSuiteAddSuite(suite, testSuite_apx_socketReactor());
 /*
    CuSuiteAddSuite(suite, testsuite_apx_serverTextLogExtension());
 */
@@ -22,6 +22,10 @@
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
 static void test_apx_allocator_create(CuTest* tc);
+static void test_apx_allocator_freedBlocksAreReused(CuTest* tc);
+static void test_apx_allocator_addSizeClass(CuTest* tc);
+static void test_apx_allocator_blockMovesToNewSizeClass(CuTest* tc);
+static void test_apx_allocator_largeAlloc(CuTest* tc);
 
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
@@ -42,6 +46,10 @@ CuSuite* testSuite_apx_allocator(void)
    CuSuite* suite = CuSuiteNew();
 
    SUITE_ADD_TEST(suite, test_apx_allocator_create);
+   SUITE_ADD_TEST(suite, test_apx_allocator_freedBlocksAreReused);
+   SUITE_ADD_TEST(suite, test_apx_allocator_addSizeClass);
+   SUITE_ADD_TEST(suite, test_apx_allocator_blockMovesToNewSizeClass);
+   SUITE_ADD_TEST(suite, test_apx_allocator_largeAlloc);
 
    return suite;
 }
@@ -57,9 +65,9 @@ static void test_apx_allocator_create(CuTest* tc)
    uint8_t *data3;
    uint8_t *data4;
    uint8_t *data128;
+   apx_allocatorStats_t stats;
    apx_allocator_t allocator;
-   apx_allocator_create(&allocator,100);
-   apx_allocator_start(&allocator);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_allocator_create(&allocator));
    data1 = apx_allocator_alloc(&allocator,1);
    CuAssertPtrNotNull(tc,data1);
    data2 = apx_allocator_alloc(&allocator,2);
@@ -69,14 +77,100 @@ static void test_apx_allocator_create(CuTest* tc)
    data4 = apx_allocator_alloc(&allocator,4);
    data128 = apx_allocator_alloc(&allocator,128);
    CuAssertPtrNotNull(tc,data4);
+   CuAssertPtrNotNull(tc,data128);
    apx_allocator_free(&allocator,data1, 1);
    apx_allocator_free(&allocator,data2, 2);
    apx_allocator_free(&allocator,data3, 3);
    apx_allocator_free(&allocator,data4, 4);
    apx_allocator_free(&allocator,data128, 128);
-   CuAssertIntEquals(tc, 5, apx_allocator_numPendingMessages(&allocator));
-   apx_allocator_processAll(&allocator);
-   apx_allocator_stop(&allocator);
+   apx_allocator_getStats(&allocator, &stats);
+   CuAssertUIntEquals(tc, 3, stats.numHits);
+   CuAssertUIntEquals(tc, 2, stats.numMisses);
+   CuAssertUIntEquals(tc, 0, stats.numLargeAllocs);
+   CuAssertUIntEquals(tc, 5, stats.numFrees);
    apx_allocator_destroy(&allocator);
 }
 
+static void test_apx_allocator_freedBlocksAreReused(CuTest* tc)
+{
+   apx_allocatorStats_t stats;
+   apx_allocator_t allocator;
+   int i;
+   apx_allocator_create(&allocator);
+   for (i = 0; i < 100; i++)
+   {
+      uint8_t *data = apx_allocator_alloc(&allocator, APX_ALLOCATOR_MAX_BLOCK_SIZE);
+      CuAssertPtrNotNull(tc, data);
+      memset(data, 0xff, APX_ALLOCATOR_MAX_BLOCK_SIZE);
+      apx_allocator_free(&allocator, data, APX_ALLOCATOR_MAX_BLOCK_SIZE);
+   }
+   apx_allocator_getStats(&allocator, &stats);
+   CuAssertUIntEquals(tc, 1, stats.numMisses);
+   CuAssertUIntEquals(tc, 99, stats.numHits);
+   CuAssertUIntEquals(tc, 100, stats.numFrees);
+   apx_allocator_destroy(&allocator);
+}
+
+static void test_apx_allocator_addSizeClass(CuTest* tc)
+{
+   apx_allocatorStats_t stats;
+   apx_allocator_t allocator;
+   uint32_t numDefaultClasses;
+   apx_allocator_create(&allocator);
+   apx_allocator_getStats(&allocator, &stats);
+   numDefaultClasses = stats.numSizeClasses;
+   CuAssertUIntEquals(tc, 32, apx_allocator_getBlockSize(&allocator, 24));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_allocator_addSizeClass(&allocator, 20));
+   CuAssertUIntEquals(tc, 16, apx_allocator_getBlockSize(&allocator, 16));
+   CuAssertUIntEquals(tc, 24, apx_allocator_getBlockSize(&allocator, 17));
+   CuAssertUIntEquals(tc, 24, apx_allocator_getBlockSize(&allocator, 24));
+   CuAssertUIntEquals(tc, 32, apx_allocator_getBlockSize(&allocator, 25));
+   apx_allocator_getStats(&allocator, &stats);
+   CuAssertUIntEquals(tc, numDefaultClasses + 1, stats.numSizeClasses);
+   //adding an existing size class does nothing
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_allocator_addSizeClass(&allocator, 24));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_allocator_addSizeClass(&allocator, 64));
+   apx_allocator_getStats(&allocator, &stats);
+   CuAssertUIntEquals(tc, numDefaultClasses + 1, stats.numSizeClasses);
+   //sizes above APX_ALLOCATOR_MAX_BLOCK_SIZE are served by malloc
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_allocator_addSizeClass(&allocator, APX_ALLOCATOR_MAX_BLOCK_SIZE + 1));
+   CuAssertUIntEquals(tc, 0, apx_allocator_getBlockSize(&allocator, APX_ALLOCATOR_MAX_BLOCK_SIZE + 1));
+   apx_allocator_getStats(&allocator, &stats);
+   CuAssertUIntEquals(tc, numDefaultClasses + 1, stats.numSizeClasses);
+   apx_allocator_destroy(&allocator);
+}
+
+static void test_apx_allocator_blockMovesToNewSizeClass(CuTest* tc)
+{
+   uint8_t *data1;
+   uint8_t *data2;
+   apx_allocator_t allocator;
+   apx_allocator_create(&allocator);
+   data1 = apx_allocator_alloc(&allocator, 20);
+   CuAssertPtrNotNull(tc, data1);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_allocator_addSizeClass(&allocator, 20));
+   //data1 came from the 32-byte class but is now returned to the 24-byte class
+   apx_allocator_free(&allocator, data1, 20);
+   data2 = apx_allocator_alloc(&allocator, 20);
+   CuAssertPtrEquals(tc, data1, data2);
+   apx_allocator_free(&allocator, data2, 20);
+   apx_allocator_destroy(&allocator);
+}
+
+static void test_apx_allocator_largeAlloc(CuTest* tc)
+{
+   uint8_t *data;
+   apx_allocatorStats_t stats;
+   apx_allocator_t *allocator = apx_allocator_new();
+   CuAssertPtrNotNull(tc, allocator);
+   data = apx_allocator_alloc(allocator, APX_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+   CuAssertPtrNotNull(tc, data);
+   apx_allocator_free(allocator, data, APX_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+   CuAssertPtrEquals(tc, 0, apx_allocator_alloc(allocator, 0));
+   apx_allocator_getStats(allocator, &stats);
+   CuAssertUIntEquals(tc, 0, stats.numHits);
+   CuAssertUIntEquals(tc, 0, stats.numMisses);
+   CuAssertUIntEquals(tc, 1, stats.numLargeAllocs);
+   CuAssertUIntEquals(tc, 1, stats.numFrees);
+   apx_allocator_delete(allocator);
+}
@@ -28,6 +28,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #include <stddef.h>
 #include <stdio.h>
+#include <malloc.h>
 #include "CuTest.h"
 #include "apx_bytePortMap.h"
 #include "apx_nodeInfo.h"
@@ -45,6 +46,11 @@
 //////////////////////////////////////////////////////////////////////////////
 static void test_apx_bytePortMap_createClientBytePortMap(CuTest* tc);
 static void test_apx_bytePortMap_createServerBytePortMap(CuTest* tc);
+static void test_apx_bytePortMap_intervalMatchesDense(CuTest* tc);
+static void test_apx_bytePortMap_pagedMatchesDense(CuTest* tc);
+static void test_apx_bytePortMap_selectType(CuTest* tc);
+static apx_portDataProps_t *createPropsArray(const apx_size_t *dataSizes, apx_portCount_t numPorts);
+static void verifyAgainstDense(CuTest* tc, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -59,6 +65,9 @@ CuSuite* testSuite_apx_bytePortMap(void)
 
 //   SUITE_ADD_TEST(suite, test_apx_bytePortMap_createClientBytePortMap);
 //   SUITE_ADD_TEST(suite, test_apx_bytePortMap_createServerBytePortMap);
+   SUITE_ADD_TEST(suite, test_apx_bytePortMap_intervalMatchesDense);
+   SUITE_ADD_TEST(suite, test_apx_bytePortMap_pagedMatchesDense);
+   SUITE_ADD_TEST(suite, test_apx_bytePortMap_selectType);
 
    return suite;
 }
@@ -133,4 +142,90 @@ static void test_apx_bytePortMap_createServerBytePortMap(CuTest* tc)
 
 }
 
+static void test_apx_bytePortMap_intervalMatchesDense(CuTest* tc)
+{
+   const apx_size_t dataSizes[] = {8u, 1u, 0u, 2u, 21u, 0u, 0u, 4096u, 3u, 0u};
+   apx_portCount_t numPorts = (apx_portCount_t) (sizeof(dataSizes) / sizeof(dataSizes[0]));
+   apx_portDataProps_t *props = createPropsArray(&dataSizes[0], numPorts);
+   verifyAgainstDense(tc, props, numPorts, APX_BYTE_PORT_MAP_INTERVAL);
+   free(props);
+}
+
+static void test_apx_bytePortMap_pagedMatchesDense(CuTest* tc)
+{
+   apx_portCount_t numPorts = 2000;
+   apx_size_t *dataSizes = (apx_size_t*) malloc(numPorts * sizeof(apx_size_t));
+   apx_portDataProps_t *props;
+   int32_t i;
+   for (i = 0; i < numPorts; i++)
+   {
+      dataSizes[i] = (i % 97 == 0)? 300u : (apx_size_t) (i % 7);
+   }
+   props = createPropsArray(dataSizes, numPorts);
+   verifyAgainstDense(tc, props, numPorts, APX_BYTE_PORT_MAP_PAGED);
+   verifyAgainstDense(tc, props, numPorts, APX_BYTE_PORT_MAP_INTERVAL);
+   free(props);
+   free(dataSizes);
+}
+
+static void test_apx_bytePortMap_selectType(CuTest* tc)
+{
+   const apx_size_t largePorts[] = {2048u, 2048u, 2048u, 8u};
+   apx_portCount_t numPorts = (apx_portCount_t) (sizeof(largePorts) / sizeof(largePorts[0]));
+   apx_portDataProps_t *props = createPropsArray(&largePorts[0], numPorts);
+   apx_bytePortMap_t *bytePortMap;
+   apx_bytePortMap_t *denseMap;
+
+   CuAssertIntEquals(tc, APX_BYTE_PORT_MAP_DENSE, apx_bytePortMap_selectType(32u, 4));
+   CuAssertIntEquals(tc, APX_BYTE_PORT_MAP_DENSE, apx_bytePortMap_selectType(APX_BYTE_PORT_MAP_DENSE_MAX_LEN, 1));
+   CuAssertIntEquals(tc, APX_BYTE_PORT_MAP_DENSE, apx_bytePortMap_selectType(20000u, 10000));
+   CuAssertIntEquals(tc, APX_BYTE_PORT_MAP_INTERVAL, apx_bytePortMap_selectType(20000u, 10));
+   CuAssertIntEquals(tc, APX_BYTE_PORT_MAP_PAGED, apx_bytePortMap_selectType(APX_BYTE_PORT_MAP_PAGED_MIN_PORTS * 16u, APX_BYTE_PORT_MAP_PAGED_MIN_PORTS));
+
+   bytePortMap = apx_bytePortMap_new(props, numPorts, (apx_error_t*) 0);
+   denseMap = apx_bytePortMap_newWithType(props, numPorts, APX_BYTE_PORT_MAP_DENSE, (apx_error_t*) 0);
+   CuAssertPtrNotNull(tc, bytePortMap);
+   CuAssertPtrNotNull(tc, denseMap);
+   CuAssertIntEquals(tc, APX_BYTE_PORT_MAP_INTERVAL, apx_bytePortMap_getType(bytePortMap));
+   CuAssertUIntEquals(tc, 6152u, apx_bytePortMap_length(bytePortMap));
+   CuAssertTrue(tc, apx_bytePortMap_getMemoryUsage(bytePortMap) < apx_bytePortMap_getMemoryUsage(denseMap));
+   CuAssertIntEquals(tc, 3, apx_bytePortMap_lookup(bytePortMap, 6144));
+   CuAssertIntEquals(tc, -1, apx_bytePortMap_lookup(bytePortMap, 6152));
+   apx_bytePortMap_delete(bytePortMap);
+   apx_bytePortMap_delete(denseMap);
+   free(props);
+}
 
+static apx_portDataProps_t *createPropsArray(const apx_size_t *dataSizes, apx_portCount_t numPorts)
+{
+   apx_portDataProps_t *props = (apx_portDataProps_t*) malloc(numPorts * sizeof(apx_portDataProps_t));
+   apx_offset_t offset = 0;
+   apx_portId_t portId;
+   for (portId = 0; portId < numPorts; portId++)
+   {
+      apx_portDataProps_create(&props[portId], APX_REQUIRE_PORT, portId, offset, dataSizes[portId]);
+      offset += (apx_offset_t) dataSizes[portId];
+   }
+   return props;
+}
+
+static void verifyAgainstDense(CuTest* tc, const apx_portDataProps_t *props, apx_portCount_t numPorts, apx_bytePortMapType_t mapType)
+{
+   apx_bytePortMap_t denseMap;
+   apx_bytePortMap_t bytePortMap;
+   int32_t mapLen;
+   int32_t i;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_bytePortMap_createWithType(&denseMap, props, numPorts, APX_BYTE_PORT_MAP_DENSE));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_bytePortMap_createWithType(&bytePortMap, props, numPorts, mapType));
+   CuAssertIntEquals(tc, mapType, apx_bytePortMap_getType(&bytePortMap));
+   mapLen = (int32_t) apx_bytePortMap_length(&denseMap);
+   CuAssertIntEquals(tc, mapLen, (int32_t) apx_bytePortMap_length(&bytePortMap));
+   for (i = -1; i <= mapLen; i++)
+   {
+      char msg[ERROR_SIZE];
+      sprintf(msg, "i=%d",i);
+      CuAssertIntEquals_Msg(tc, msg, apx_bytePortMap_lookup(&denseMap, i), apx_bytePortMap_lookup(&bytePortMap, i));
+   }
+   apx_bytePortMap_destroy(&bytePortMap);
+   apx_bytePortMap_destroy(&denseMap);
+}
@@ -82,6 +82,8 @@ static void test_apx_compiler_encodeInstruction_unpackS64(CuTest* tc);
 static void test_apx_compiler_compileUnpackDataElement_U8(CuTest* tc);
 static void test_apx_compiler_compileUnpackDataElement_U16(CuTest* tc);
 static void test_apx_compiler_compileUnpackDataElement_U32(CuTest* tc);
+static void test_apx_compiler_compilePackDataElement_Float64(CuTest* tc);
+static void test_apx_compiler_compileUnpackDataElement_U64(CuTest* tc);
 static void test_apx_compiler_compileUnpackDataElement_U8FixArrayU8(CuTest* tc);
 static void test_apx_compiler_compileUnpackDataElement_U8FixArrayU16(CuTest* tc);
 static void test_apx_compiler_compileUnpackDataElement_U8FixArrayU32(CuTest* tc);
@@ -137,6 +139,8 @@ CuSuite* testSuite_apx_compiler(void)
    SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U8);
    SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U16);
    SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U32);
+   SUITE_ADD_TEST(suite, test_apx_compiler_compilePackDataElement_Float64);
+   SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U64);
    SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U8FixArrayU8);
    SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U8FixArrayU16);
    SUITE_ADD_TEST(suite, test_apx_compiler_compileUnpackDataElement_U8FixArrayU32);
@@ -1019,3 +1023,51 @@ static void test_apx_compiler_compileUnpackDataElement_RecordContainingU16AndU8V
    adt_bytearray_delete(program);
 
 }
+
+static void test_apx_compiler_compilePackDataElement_Float64(CuTest* tc)
+{
+   uint8_t opcode, variant, flags;
+   uint8_t *code;
+   adt_bytearray_t *program = adt_bytearray_new(APX_PROGRAM_GROW_SIZE);
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_FLOAT64, NULL);
+   apx_compiler_t *compiler = apx_compiler_new();
+   CuAssertPtrNotNull(tc, compiler);
+
+   apx_compiler_begin(compiler, program);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_compiler_compilePackDataElement(compiler, element));
+   CuAssertIntEquals(tc, UINT8_SIZE, adt_bytearray_length(program));
+   code = adt_bytearray_data(program);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_decodeInstruction(code[0], &opcode, &variant, &flags));
+   CuAssertUIntEquals(tc, APX_OPCODE_PACK2, opcode);
+   CuAssertUIntEquals(tc, APX_VARIANT2_FLOAT64, variant);
+   CuAssertUIntEquals(tc, 0, flags);
+   CuAssertUIntEquals(tc, FLOAT64_SIZE, *compiler->dataOffset);
+
+   apx_compiler_delete(compiler);
+   apx_dataElement_delete(element);
+   adt_bytearray_delete(program);
+}
+
+static void test_apx_compiler_compileUnpackDataElement_U64(CuTest* tc)
+{
+   uint8_t opcode, variant, flags;
+   uint8_t *code;
+   adt_bytearray_t *program = adt_bytearray_new(APX_PROGRAM_GROW_SIZE);
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_UINT64, NULL);
+   apx_compiler_t *compiler = apx_compiler_new();
+   CuAssertPtrNotNull(tc, compiler);
+
+   apx_compiler_begin(compiler, program);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_compiler_compileUnpackDataElement(compiler, element));
+   CuAssertIntEquals(tc, UINT8_SIZE, adt_bytearray_length(program));
+   code = adt_bytearray_data(program);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_decodeInstruction(code[0], &opcode, &variant, &flags));
+   CuAssertUIntEquals(tc, APX_OPCODE_UNPACK, opcode);
+   CuAssertUIntEquals(tc, APX_VARIANT_U64, variant);
+   CuAssertUIntEquals(tc, 0, flags);
+   CuAssertUIntEquals(tc, UINT64_SIZE, *compiler->dataOffset);
+
+   apx_compiler_delete(compiler);
+   apx_dataElement_delete(element);
+   adt_bytearray_delete(program);
+}
@@ -52,6 +52,8 @@ static void test_apx_dataSignature_uint8(CuTest* tc);
 static void test_apx_dataSignature_uint16(CuTest* tc);
 static void test_apx_dataSignature_uint16(CuTest* tc);
 static void test_apx_dataSignature_uint32(CuTest* tc);
+static void test_apx_dataSignature_uint64(CuTest* tc);
+static void test_apx_dataSignature_float(CuTest* tc);
 static void test_apx_dataSignature_record(CuTest* tc);
 static void test_apx_dataSignature_string(CuTest* tc);
 static void test_apx_dataSignature_typeReferenceById(CuTest *tc);
@@ -84,6 +86,8 @@ CuSuite* testsuite_apx_dataSignature(void)
    SUITE_ADD_TEST(suite, test_apx_dataSignature_uint8);
    SUITE_ADD_TEST(suite, test_apx_dataSignature_uint16);
    SUITE_ADD_TEST(suite, test_apx_dataSignature_uint32);
+   SUITE_ADD_TEST(suite, test_apx_dataSignature_uint64);
+   SUITE_ADD_TEST(suite, test_apx_dataSignature_float);
    SUITE_ADD_TEST(suite, test_apx_dataSignature_string);
    SUITE_ADD_TEST(suite, test_apx_dataSignature_record);
    SUITE_ADD_TEST(suite, test_apx_dataSignature_typeReferenceById);
@@ -602,3 +606,49 @@ static void test_apx_dataSignature_u8DynamicArray(CuTest* tc)
    CuAssertUIntEquals(tc, UINT16_SIZE+UINT8_SIZE*arrayLen, packLen);
    apx_dataSignature_delete(pSignature);
 }
+
+static void test_apx_dataSignature_uint64(CuTest* tc)
+{
+   apx_error_t err;
+   apx_dataSignature_t *pSignature;
+   apx_size_t packLen = 0;
+
+   pSignature = apx_dataSignature_new("U", &err);
+   CuAssertPtrNotNull(tc, pSignature);
+   CuAssertIntEquals(tc,APX_BASE_TYPE_UINT64,pSignature->dataElement->baseType);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataSignature_calcPackLen(pSignature, &packLen));
+   CuAssertUIntEquals(tc, UINT64_SIZE, packLen);
+   apx_dataSignature_delete(pSignature);
+
+   pSignature = apx_dataSignature_new("u(-1000,1000)[4]", &err);
+   CuAssertPtrNotNull(tc, pSignature);
+   CuAssertIntEquals(tc,APX_BASE_TYPE_SINT64,pSignature->dataElement->baseType);
+   CuAssertUIntEquals(tc,4,pSignature->dataElement->arrayLen);
+   CuAssertTrue(tc, pSignature->dataElement->lowerLimit.s64 == -1000);
+   CuAssertTrue(tc, pSignature->dataElement->upperLimit.s64 == 1000);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataSignature_calcPackLen(pSignature, &packLen));
+   CuAssertUIntEquals(tc, SINT64_SIZE*4, packLen);
+   apx_dataSignature_delete(pSignature);
+}
+
+static void test_apx_dataSignature_float(CuTest* tc)
+{
+   apx_error_t err;
+   apx_dataSignature_t *pSignature;
+   apx_size_t packLen = 0;
+
+   pSignature = apx_dataSignature_new("f", &err);
+   CuAssertPtrNotNull(tc, pSignature);
+   CuAssertIntEquals(tc,APX_BASE_TYPE_FLOAT32,pSignature->dataElement->baseType);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataSignature_calcPackLen(pSignature, &packLen));
+   CuAssertUIntEquals(tc, FLOAT32_SIZE, packLen);
+   CuAssertStrEquals(tc, "f", apx_dataSignature_getDerivedString(pSignature));
+   apx_dataSignature_delete(pSignature);
+
+   pSignature = apx_dataSignature_new("d[3]", &err);
+   CuAssertPtrNotNull(tc, pSignature);
+   CuAssertIntEquals(tc,APX_BASE_TYPE_FLOAT64,pSignature->dataElement->baseType);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataSignature_calcPackLen(pSignature, &packLen));
+   CuAssertUIntEquals(tc, FLOAT64_SIZE*3, packLen);
+   apx_dataSignature_delete(pSignature);
+}
@@ -0,0 +1,284 @@
+/*****************************************************************************
+* \file      testsuite_apx_definitionCache.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_definitionCache
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_definitionCache.h"
+#include "apx_sha256.h"
+#include "apx_nodeImage.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#define TEST_IMAGE_DIRECTORY "."
+#else
+#define TEST_IMAGE_DIRECTORY "/tmp"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_definitionCache_insertAndFind(CuTest* tc);
+static void test_apx_definitionCache_lengthMismatchIsMiss(CuTest* tc);
+static void test_apx_definitionCache_evictsLeastRecentlyUsed(CuTest* tc);
+static void test_apx_definitionCache_nodeInfoOutlivesEviction(CuTest* tc);
+static void test_apx_definitionCache_disabledWhenMaxEntriesIsZero(CuTest* tc);
+static void test_apx_definitionCache_loadsMissFromImageDirectory(CuTest* tc);
+static apx_nodeInfo_t *buildNodeInfo(const char *definition, uint8_t *digest);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const char *m_apx_definition1 = "APX/1.2\n"
+      "N\"TestNode1\"\n"
+      "P\"VehicleSpeed\"S:=65535\n"
+      "\n";
+
+static const char *m_apx_definition2 = "APX/1.2\n"
+      "N\"TestNode2\"\n"
+      "R\"VehicleSpeed\"S:=65535\n"
+      "\n";
+
+static const char *m_apx_definition3 = "APX/1.2\n"
+      "N\"TestNode3\"\n"
+      "P\"EngineSpeed\"S:=65535\n"
+      "\n";
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_definitionCache(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_definitionCache_insertAndFind);
+   SUITE_ADD_TEST(suite, test_apx_definitionCache_lengthMismatchIsMiss);
+   SUITE_ADD_TEST(suite, test_apx_definitionCache_evictsLeastRecentlyUsed);
+   SUITE_ADD_TEST(suite, test_apx_definitionCache_nodeInfoOutlivesEviction);
+   SUITE_ADD_TEST(suite, test_apx_definitionCache_disabledWhenMaxEntriesIsZero);
+   SUITE_ADD_TEST(suite, test_apx_definitionCache_loadsMissFromImageDirectory);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_definitionCache_insertAndFind(CuTest* tc)
+{
+   apx_definitionCache_t cache;
+   apx_definitionCacheStats_t stats;
+   uint8_t digest1[APX_SHA256_DIGEST_SIZE];
+   uint8_t digest2[APX_SHA256_DIGEST_SIZE];
+   uint32_t len1 = (uint32_t) strlen(m_apx_definition1);
+   apx_nodeInfo_t *nodeInfo1 = buildNodeInfo(m_apx_definition1, &digest1[0]);
+   apx_nodeInfo_t *nodeInfo2 = buildNodeInfo(m_apx_definition2, &digest2[0]);
+   apx_nodeInfo_t *result;
+   CuAssertPtrNotNull(tc, nodeInfo1);
+   CuAssertPtrNotNull(tc, nodeInfo2);
+   apx_definitionCache_create(&cache, 4u);
+
+   CuAssertPtrEquals(tc, NULL, apx_definitionCache_find(&cache, &digest1[0], len1));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest1[0], len1, nodeInfo1));
+   CuAssertUIntEquals(tc, 2u, nodeInfo1->refCount);
+   result = apx_definitionCache_find(&cache, &digest1[0], len1);
+   CuAssertPtrEquals(tc, nodeInfo1, result);
+   CuAssertUIntEquals(tc, 3u, nodeInfo1->refCount);
+   apx_nodeInfo_release(result);
+   CuAssertPtrEquals(tc, NULL, apx_definitionCache_find(&cache, &digest2[0], (uint32_t) strlen(m_apx_definition2)));
+
+   //inserting the same digest twice keeps the first entry
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest1[0], len1, nodeInfo2));
+   CuAssertUIntEquals(tc, 1u, nodeInfo2->refCount);
+
+   apx_definitionCache_getStats(&cache, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numEntries);
+   CuAssertUIntEquals(tc, 1u, stats.numHits);
+   CuAssertUIntEquals(tc, 2u, stats.numMisses);
+
+   apx_definitionCache_destroy(&cache);
+   CuAssertUIntEquals(tc, 1u, nodeInfo1->refCount);
+   apx_nodeInfo_release(nodeInfo1);
+   apx_nodeInfo_release(nodeInfo2);
+}
+
+static void test_apx_definitionCache_lengthMismatchIsMiss(CuTest* tc)
+{
+   apx_definitionCache_t cache;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t len = (uint32_t) strlen(m_apx_definition1);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(m_apx_definition1, &digest[0]);
+   CuAssertPtrNotNull(tc, nodeInfo);
+   apx_definitionCache_create(&cache, 4u);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest[0], len, nodeInfo));
+   CuAssertPtrEquals(tc, NULL, apx_definitionCache_find(&cache, &digest[0], len + 1u));
+
+   apx_definitionCache_destroy(&cache);
+   apx_nodeInfo_release(nodeInfo);
+}
+
+static void test_apx_definitionCache_evictsLeastRecentlyUsed(CuTest* tc)
+{
+   apx_definitionCache_t cache;
+   apx_definitionCacheStats_t stats;
+   uint8_t digest1[APX_SHA256_DIGEST_SIZE];
+   uint8_t digest2[APX_SHA256_DIGEST_SIZE];
+   uint8_t digest3[APX_SHA256_DIGEST_SIZE];
+   uint32_t len1 = (uint32_t) strlen(m_apx_definition1);
+   uint32_t len2 = (uint32_t) strlen(m_apx_definition2);
+   uint32_t len3 = (uint32_t) strlen(m_apx_definition3);
+   apx_nodeInfo_t *nodeInfo1 = buildNodeInfo(m_apx_definition1, &digest1[0]);
+   apx_nodeInfo_t *nodeInfo2 = buildNodeInfo(m_apx_definition2, &digest2[0]);
+   apx_nodeInfo_t *nodeInfo3 = buildNodeInfo(m_apx_definition3, &digest3[0]);
+   apx_nodeInfo_t *result;
+   apx_definitionCache_create(&cache, 2u);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest1[0], len1, nodeInfo1));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest2[0], len2, nodeInfo2));
+   //touch first entry, second entry is now the least recently used
+   result = apx_definitionCache_find(&cache, &digest1[0], len1);
+   CuAssertPtrEquals(tc, nodeInfo1, result);
+   apx_nodeInfo_release(result);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest3[0], len3, nodeInfo3));
+
+   CuAssertPtrEquals(tc, NULL, apx_definitionCache_find(&cache, &digest2[0], len2));
+   result = apx_definitionCache_find(&cache, &digest1[0], len1);
+   CuAssertPtrEquals(tc, nodeInfo1, result);
+   apx_nodeInfo_release(result);
+   result = apx_definitionCache_find(&cache, &digest3[0], len3);
+   CuAssertPtrEquals(tc, nodeInfo3, result);
+   apx_nodeInfo_release(result);
+   apx_definitionCache_getStats(&cache, &stats);
+   CuAssertUIntEquals(tc, 2u, stats.numEntries);
+   CuAssertUIntEquals(tc, 1u, stats.numEvictions);
+
+   apx_definitionCache_destroy(&cache);
+   apx_nodeInfo_release(nodeInfo1);
+   apx_nodeInfo_release(nodeInfo2);
+   apx_nodeInfo_release(nodeInfo3);
+}
+
+static void test_apx_definitionCache_nodeInfoOutlivesEviction(CuTest* tc)
+{
+   apx_definitionCache_t cache;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t len = (uint32_t) strlen(m_apx_definition1);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(m_apx_definition1, &digest[0]);
+   apx_nodeInfo_t *result;
+   apx_definitionCache_create(&cache, 4u);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest[0], len, nodeInfo));
+   apx_nodeInfo_release(nodeInfo); //cache is now the only owner
+   result = apx_definitionCache_find(&cache, &digest[0], len);
+   CuAssertPtrEquals(tc, nodeInfo, result);
+   apx_definitionCache_clear(&cache);
+   CuAssertUIntEquals(tc, 1u, result->refCount);
+   CuAssertStrEquals(tc, "TestNode1", apx_nodeInfo_getName(result));
+   apx_nodeInfo_release(result);
+
+   apx_definitionCache_destroy(&cache);
+}
+
+static void test_apx_definitionCache_disabledWhenMaxEntriesIsZero(CuTest* tc)
+{
+   apx_definitionCache_t cache;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t len = (uint32_t) strlen(m_apx_definition1);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(m_apx_definition1, &digest[0]);
+   apx_definitionCache_create(&cache, 0u);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache, &digest[0], len, nodeInfo));
+   CuAssertPtrEquals(tc, NULL, apx_definitionCache_find(&cache, &digest[0], len));
+   CuAssertUIntEquals(tc, 1u, nodeInfo->refCount);
+
+   apx_definitionCache_destroy(&cache);
+   apx_nodeInfo_release(nodeInfo);
+}
+
+/**
+ * A second cache (think: the next process start) finds the nodeInfo saved by the first one without anyone building it
+ */
+static void test_apx_definitionCache_loadsMissFromImageDirectory(CuTest* tc)
+{
+   apx_definitionCache_t cache1;
+   apx_definitionCache_t cache2;
+   apx_definitionCacheStats_t stats;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t len = (uint32_t) strlen(m_apx_definition3);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(m_apx_definition3, &digest[0]);
+   apx_nodeInfo_t *result;
+   char *path = apx_nodeImage_makeFilePath(TEST_IMAGE_DIRECTORY, &digest[0]);
+   CuAssertPtrNotNull(tc, path);
+   remove(path);
+   apx_definitionCache_create(&cache1, 4u);
+   apx_definitionCache_create(&cache2, 4u);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_setImageDirectory(&cache1, TEST_IMAGE_DIRECTORY, APX_SERVER_MODE));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_setImageDirectory(&cache2, TEST_IMAGE_DIRECTORY, APX_SERVER_MODE));
+
+   CuAssertPtrEquals(tc, NULL, apx_definitionCache_find(&cache1, &digest[0], len));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_definitionCache_insert(&cache1, &digest[0], len, nodeInfo));
+   apx_definitionCache_getStats(&cache1, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numImageSaves);
+
+   result = apx_definitionCache_find(&cache2, &digest[0], len);
+   CuAssertPtrNotNull(tc, result);
+   CuAssertTrue(tc, result != nodeInfo);
+   CuAssertStrEquals(tc, "TestNode3", apx_nodeInfo_getName(result));
+   CuAssertIntEquals(tc, APX_SERVER_MODE, result->mode);
+   CuAssertUIntEquals(tc, apx_nodeInfo_getProvidePortSignatureId(nodeInfo, 0), apx_nodeInfo_getProvidePortSignatureId(result, 0));
+   apx_nodeInfo_release(result);
+   //now it's cached in memory as well
+   result = apx_definitionCache_find(&cache2, &digest[0], len);
+   CuAssertPtrNotNull(tc, result);
+   apx_nodeInfo_release(result);
+   apx_definitionCache_getStats(&cache2, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numImageLoads);
+   CuAssertUIntEquals(tc, 1u, stats.numHits);
+   CuAssertUIntEquals(tc, 1u, stats.numEntries);
+
+   apx_definitionCache_destroy(&cache1);
+   apx_definitionCache_destroy(&cache2);
+   apx_nodeInfo_release(nodeInfo);
+   remove(path);
+   free(path);
+}
+
+static apx_nodeInfo_t *buildNodeInfo(const char *definition, uint8_t *digest)
+{
+   apx_nodeInfo_t *nodeInfo = apx_nodeInfo_make_from_cstr(definition, APX_SERVER_MODE);
+   apx_sha256_calc((const uint8_t*) definition, strlen(definition), digest);
+   return nodeInfo;
+}
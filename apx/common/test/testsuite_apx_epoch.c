@@ -0,0 +1,159 @@
+/*****************************************************************************
+* \file      testsuite_apx_epoch.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_epoch
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include "CuTest.h"
+#include "apx_epoch.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_epoch_reclaimWithoutReaders(CuTest* tc);
+static void test_apx_epoch_activeReaderDelaysReclaim(CuTest* tc);
+static void test_apx_epoch_lateReaderDoesNotDelayReclaim(CuTest* tc);
+static void test_apx_epoch_synchronize(CuTest* tc);
+static void test_apx_epoch_destroyReclaimsAll(CuTest* tc);
+static void countReclaim(void *arg);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_epoch(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_epoch_reclaimWithoutReaders);
+   SUITE_ADD_TEST(suite, test_apx_epoch_activeReaderDelaysReclaim);
+   SUITE_ADD_TEST(suite, test_apx_epoch_lateReaderDoesNotDelayReclaim);
+   SUITE_ADD_TEST(suite, test_apx_epoch_synchronize);
+   SUITE_ADD_TEST(suite, test_apx_epoch_destroyReclaimsAll);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_epoch_reclaimWithoutReaders(CuTest* tc)
+{
+   apx_epoch_t epoch;
+   int32_t numReclaimed = 0;
+   apx_epoch_create(&epoch);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_epoch_retire(&epoch, &numReclaimed, countReclaim));
+   CuAssertUIntEquals(tc, 0u, apx_epoch_reclaim(&epoch));
+   CuAssertIntEquals(tc, 1, numReclaimed);
+   CuAssertUIntEquals(tc, 0u, apx_epoch_getNumRetired(&epoch));
+   apx_epoch_destroy(&epoch);
+   CuAssertIntEquals(tc, 1, numReclaimed);
+}
+
+static void test_apx_epoch_activeReaderDelaysReclaim(CuTest* tc)
+{
+   apx_epoch_t epoch;
+   int32_t numReclaimed = 0;
+   int32_t i;
+   uint32_t readerEpoch;
+   apx_epoch_create(&epoch);
+   readerEpoch = apx_epoch_enter(&epoch);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_epoch_retire(&epoch, &numReclaimed, countReclaim));
+   for (i = 0; i < 10; i++)
+   {
+      CuAssertUIntEquals(tc, 1u, apx_epoch_reclaim(&epoch));
+   }
+   CuAssertIntEquals(tc, 0, numReclaimed);
+   apx_epoch_exit(&epoch, readerEpoch);
+   CuAssertUIntEquals(tc, 0u, apx_epoch_reclaim(&epoch));
+   CuAssertIntEquals(tc, 1, numReclaimed);
+   apx_epoch_destroy(&epoch);
+}
+
+static void test_apx_epoch_lateReaderDoesNotDelayReclaim(CuTest* tc)
+{
+   apx_epoch_t epoch;
+   int32_t numReclaimed = 0;
+   uint32_t readerEpoch;
+   apx_epoch_create(&epoch);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_epoch_retire(&epoch, &numReclaimed, countReclaim));
+   //This reader entered after the object was retired and can not have seen it
+   readerEpoch = apx_epoch_enter(&epoch);
+   CuAssertUIntEquals(tc, 0u, apx_epoch_reclaim(&epoch));
+   CuAssertIntEquals(tc, 1, numReclaimed);
+   apx_epoch_exit(&epoch, readerEpoch);
+   apx_epoch_destroy(&epoch);
+}
+
+static void test_apx_epoch_synchronize(CuTest* tc)
+{
+   apx_epoch_t epoch;
+   int32_t numReclaimed = 0;
+   int32_t i;
+   apx_epoch_create(&epoch);
+   for (i = 0; i < 5; i++)
+   {
+      uint32_t readerEpoch = apx_epoch_enter(&epoch);
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_epoch_retire(&epoch, &numReclaimed, countReclaim));
+      apx_epoch_exit(&epoch, readerEpoch);
+   }
+   apx_epoch_synchronize(&epoch);
+   CuAssertIntEquals(tc, 5, numReclaimed);
+   CuAssertUIntEquals(tc, 0u, apx_epoch_getNumRetired(&epoch));
+   apx_epoch_destroy(&epoch);
+}
+
+static void test_apx_epoch_destroyReclaimsAll(CuTest* tc)
+{
+   apx_epoch_t *epoch = apx_epoch_new();
+   int32_t numReclaimed = 0;
+   uint32_t readerEpoch;
+   CuAssertPtrNotNull(tc, epoch);
+   readerEpoch = apx_epoch_enter(epoch);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_epoch_retire(epoch, &numReclaimed, countReclaim));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_epoch_retire(epoch, &numReclaimed, countReclaim));
+   CuAssertUIntEquals(tc, 2u, apx_epoch_getNumRetired(epoch));
+   apx_epoch_exit(epoch, readerEpoch);
+   apx_epoch_delete(epoch);
+   CuAssertIntEquals(tc, 2, numReclaimed);
+}
+
+static void countReclaim(void *arg)
+{
+   int32_t *numReclaimed = (int32_t*) arg;
+   (*numReclaimed)++;
+}
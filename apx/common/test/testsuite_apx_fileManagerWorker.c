@@ -13,6 +13,9 @@
 #include "rmf.h"
 #include "apx_file.h"
 #include "adt_bytearray.h"
+#include "apx_transmitHandlerSpy.h"
+#include "apx_cfg.h"
+#include "numheader.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -32,6 +35,30 @@ typedef struct fileManagerRemoteSpy_tag
 //////////////////////////////////////////////////////////////////////////////
 
 static void test_apx_fileManagerWorker_create(CuTest* tc);
+static void test_apx_fileManagerWorker_batchMessages(CuTest* tc);
+static void test_apx_fileManagerWorker_batchMessagesWithSizeLimit(CuTest* tc);
+static void test_apx_fileManagerWorker_batchingDisabled(CuTest* tc);
+static void test_apx_fileManagerWorker_sendDynamicDataDirect(CuTest* tc);
+static void test_apx_fileManagerWorker_sendDynamicDataDirectPreservesOrder(CuTest* tc);
+static void test_apx_fileManagerWorker_sendDynamicDataDirectNotSupported(CuTest* tc);
+static void test_apx_fileManagerWorker_coalesceWritesToSameAddress(CuTest* tc);
+static void test_apx_fileManagerWorker_coalesceWithoutBatching(CuTest* tc);
+static void test_apx_fileManagerWorker_coalesceWhileDisconnected(CuTest* tc);
+static void test_apx_fileManagerWorker_backpressureDropOldest(CuTest* tc);
+static void test_apx_fileManagerWorker_backpressureCoalesce(CuTest* tc);
+static void test_apx_fileManagerWorker_backpressureDisconnect(CuTest* tc);
+static void test_apx_fileManagerWorker_sendDynamicDataDirectFragmented(CuTest* tc);
+static void test_apx_fileManagerWorker_runScheduled(CuTest* tc);
+static void test_apx_fileManagerWorker_failedBatchIsNotCountedAsSent(CuTest* tc);
+static void test_apx_fileManagerWorker_runScheduledRateLimited(CuTest* tc);
+static void test_apx_fileManagerWorker_scheduleFailureIsRetried(CuTest* tc);
+static void test_apx_fileManagerWorker_transmitWouldBlock(CuTest* tc);
+static void overloadNotify(void *arg);
+static int32_t failingSendBatch(void *arg, const uint8_t *data, int32_t dataLen);
+static int32_t wouldBlockSendBatch(void *arg, const uint8_t *data, int32_t dataLen);
+static apx_error_t scheduleNotify(void *arg, apx_fileManagerWorker_t *worker);
+static apx_error_t failingScheduleNotify(void *arg, apx_fileManagerWorker_t *worker);
+static void setupTransmitHandler(apx_fileManagerWorker_t *worker, apx_transmitHandlerSpy_t *spy, bool enableBatch);
 //static void test_apx_fileManagerWorker_processFileInfo(CuTest* tc);
 //static void test_apx_fileManagerWorker_processFileOpenRequest(CuTest* tc);
 //static void test_apx_fileManagerWorker_serializeFileInfo(CuTest *tc);
@@ -51,6 +78,24 @@ CuSuite* testSuite_apx_fileManagerWorker(void)
    CuSuite* suite = CuSuiteNew();
 
    SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_create);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_batchMessages);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_batchMessagesWithSizeLimit);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_batchingDisabled);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_sendDynamicDataDirect);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_sendDynamicDataDirectPreservesOrder);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_sendDynamicDataDirectNotSupported);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_coalesceWritesToSameAddress);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_coalesceWithoutBatching);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_coalesceWhileDisconnected);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_backpressureDropOldest);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_backpressureCoalesce);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_backpressureDisconnect);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_sendDynamicDataDirectFragmented);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_runScheduled);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_failedBatchIsNotCountedAsSent);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_runScheduledRateLimited);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_scheduleFailureIsRetried);
+   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_transmitWouldBlock);
    //SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_processFileInfo);
    //SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_processFileOpenRequest);
 //   SUITE_ADD_TEST(suite, test_apx_fileManagerWorker_serializeFileInfo);
@@ -72,6 +117,758 @@ static void test_apx_fileManagerWorker_create(CuTest* tc)
    apx_fileManagerShared_destroy(&shared);
 }
 
+static void test_apx_fileManagerWorker_batchMessages(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   adt_bytearray_t *batch;
+   const uint8_t *data;
+   const int32_t ackMsgLen = RMF_CMD_ADDRESS_LEN+RMF_CMD_ACK_LEN;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, 3, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 0, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertPtrNotNull(tc, batch);
+   CuAssertIntEquals(tc, 3*(1+ackMsgLen), adt_bytearray_length(batch));
+   data = adt_bytearray_data(batch);
+   CuAssertUIntEquals(tc, ackMsgLen, data[0]);
+   CuAssertUIntEquals(tc, ackMsgLen, data[1+ackMsgLen]);
+   CuAssertUIntEquals(tc, ackMsgLen, data[2*(1+ackMsgLen)]);
+   adt_bytearray_delete(batch);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 1, stats.numFlushes);
+   CuAssertUIntEquals(tc, 3, stats.numMessages);
+   CuAssertUIntEquals(tc, 3, stats.maxMessagesPerFlush);
+   CuAssertUIntEquals(tc, 0, stats.queueDepth);
+   CuAssertUIntEquals(tc, 3, stats.maxQueueDepth);
+   CuAssertUIntEquals(tc, 0, stats.numWakeups);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_batchMessagesWithSizeLimit(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   adt_bytearray_t *batch;
+   const int32_t ackMsgLen = RMF_CMD_ADDRESS_LEN+RMF_CMD_ACK_LEN;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setBatchConfig(&worker, 2*(1+ackMsgLen), 0u);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 1, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 0, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertIntEquals(tc, 2, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 2*(1+ackMsgLen), adt_bytearray_length(batch));
+   adt_bytearray_delete(batch);
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 1+ackMsgLen, adt_bytearray_length(batch));
+   adt_bytearray_delete(batch);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 2, stats.numFlushes);
+   CuAssertUIntEquals(tc, 3, stats.numMessages);
+   CuAssertUIntEquals(tc, 2, stats.maxMessagesPerFlush);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_batchingDisabled(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, false);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 2, apx_transmitHandlerSpy_length(&spy));
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 0, stats.numFlushes);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_sendDynamicDataDirect(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   adt_bytearray_t *batch;
+   const uint8_t data1[3] = {1, 2, 3};
+   const uint8_t data2[3] = {4, 5, 6};
+   const uint8_t expected[12] = {5, 0x00, 0x10, 1, 2, 3, 5, 0x00, 0x13, 4, 5, 6};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data1), &data1[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x13, sizeof(data2), &data2[0]));
+   CuAssertIntEquals(tc, 2, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 0, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, sizeof(expected), adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch), &expected[0], sizeof(expected)));
+   adt_bytearray_delete(batch);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 1, stats.numFlushes);
+   CuAssertUIntEquals(tc, 2, stats.numMessages);
+   CuAssertUIntEquals(tc, 6, stats.numBytesCopied);
+
+   //buffers are reused for the next round of messages
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data2), &data2[0]));
+   CuAssertTrue(tc, apx_fileManagerWorker_run(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 6, adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch), &expected[0], 3));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch)+3, &data2[0], 3));
+   adt_bytearray_delete(batch);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_sendDynamicDataDirectPreservesOrder(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   adt_bytearray_t *batch;
+   const uint8_t data[3] = {1, 2, 3};
+   const int32_t ackMsgLen = RMF_CMD_ADDRESS_LEN+RMF_CMD_ACK_LEN;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data), &data[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 3, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 1+ackMsgLen, adt_bytearray_length(batch));
+   adt_bytearray_delete(batch);
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 6, adt_bytearray_length(batch));
+   adt_bytearray_delete(batch);
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 1+ackMsgLen, adt_bytearray_length(batch));
+   adt_bytearray_delete(batch);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_sendDynamicDataDirectNotSupported(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   const uint8_t data[3] = {1, 2, 3};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, false);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NOT_IMPLEMENTED_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data), &data[0]));
+   CuAssertIntEquals(tc, 0, apx_fileManagerWorker_numPendingMessages(&worker));
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_coalesceWritesToSameAddress(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   adt_bytearray_t *batch;
+   const uint8_t data1[3] = {1, 2, 3};
+   const uint8_t data2[3] = {4, 5, 6};
+   const uint8_t data3[3] = {7, 8, 9};
+   const uint8_t expected[12] = {5, 0x00, 0x10, 7, 8, 9, 5, 0x00, 0x13, 4, 5, 6};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setCoalesceConfig(&worker, true, 0u);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data1), &data1[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x13, sizeof(data2), &data2[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data2), &data2[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data3), &data3[0]));
+   CuAssertIntEquals(tc, 2, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 0, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, sizeof(expected), adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch), &expected[0], sizeof(expected)));
+   adt_bytearray_delete(batch);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 2, stats.numMessages);
+   CuAssertUIntEquals(tc, 2, stats.numCoalescedWrites);
+   CuAssertUIntEquals(tc, 0, stats.numRateLimitWaits);
+
+   //a write after the message was sent queues a new message
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data1), &data1[0]));
+   CuAssertIntEquals(tc, 1, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 6, adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch)+3, &data1[0], 3));
+   adt_bytearray_delete(batch);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_coalesceWithoutBatching(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   adt_bytearray_t *msg;
+   const uint8_t data1[3] = {1, 2, 3};
+   const uint8_t data2[3] = {4, 5, 6};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, false);
+   apx_fileManagerWorker_setCoalesceConfig(&worker, true, 0u);
+   apx_fileManagerShared_connect(&shared);
+   //coalescing does not need sendBatch
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data1), &data1[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data2), &data2[0]));
+   CuAssertIntEquals(tc, 1, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_run(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   msg = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 5, adt_bytearray_length(msg));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(msg)+2, &data2[0], 3));
+   adt_bytearray_delete(msg);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_coalesceWhileDisconnected(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   const uint8_t data[3] = {1, 2, 3};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setCoalesceConfig(&worker, true, 0u);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data), &data[0]));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 0, apx_transmitHandlerSpy_length(&spy));
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&worker.coalescer));
+   //the dropped entry does not swallow later writes
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, sizeof(data), &data[0]));
+   CuAssertIntEquals(tc, 1, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   adt_bytearray_delete(apx_transmitHandlerSpy_next(&spy));
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_backpressureDropOldest(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   adt_bytearray_t *batch;
+   uint32_t i;
+   const uint8_t data[5][1] = { {1}, {2}, {3}, {4}, {5} };
+   const uint8_t expected[8] = {3, 0x00, 0x08, 3, 3, 0x00, 0x0C, 4};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setBackpressureConfig(&worker, APX_BACKPRESSURE_POLICY_DROP_OLDEST, 2u);
+   apx_fileManagerShared_connect(&shared);
+   for (i = 0; i < 5; i++)
+   {
+      //the fifth write finds the queue at twice the high-water mark and is discarded
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, i*4u, 1u, &data[i][0]));
+   }
+   CuAssertIntEquals(tc, 4, apx_fileManagerWorker_numPendingMessages(&worker));
+   //the two oldest messages are discarded by the worker
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, sizeof(expected), adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch), &expected[0], sizeof(expected)));
+   adt_bytearray_delete(batch);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 2u, stats.queueHighWaterMark);
+   CuAssertUIntEquals(tc, 3u, stats.numHighWaterMarkHits);
+   CuAssertUIntEquals(tc, 3u, stats.numDroppedMessages);
+   CuAssertUIntEquals(tc, 0u, stats.numOverloads);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_backpressureCoalesce(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   adt_bytearray_t *batch;
+   const uint8_t data1[1] = {1};
+   const uint8_t data2[1] = {2};
+   const uint8_t data3[1] = {3};
+   const uint8_t expected[16] = {3, 0x00, 0x10, 1, 3, 0x00, 0x14, 1, 3, 0x00, 0x10, 3, 3, 0x00, 0x18, 1};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setBackpressureConfig(&worker, APX_BACKPRESSURE_POLICY_COALESCE, 2u);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, 1u, &data1[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x14, 1u, &data1[0]));
+   //queue is at the high-water mark, writes are coalesced from now on
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, 1u, &data2[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, 1u, &data3[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x18, 1u, &data1[0]));
+   CuAssertIntEquals(tc, 4, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   //direct frames and coalesced messages are sent in queue order
+   CuAssertIntEquals(tc, 2, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 8, adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch), &expected[0], 8));
+   adt_bytearray_delete(batch);
+   batch = apx_transmitHandlerSpy_next(&spy);
+   CuAssertIntEquals(tc, 8, adt_bytearray_length(batch));
+   CuAssertIntEquals(tc, 0, memcmp(adt_bytearray_data(batch), &expected[8], 8));
+   adt_bytearray_delete(batch);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numCoalescedWrites);
+   CuAssertUIntEquals(tc, 0u, stats.numDroppedMessages);
+   //back below the high-water mark with an empty coalescer, writes are queued as usual
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, 1u, &data1[0]));
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&worker.coalescer));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   adt_bytearray_delete(apx_transmitHandlerSpy_next(&spy));
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_backpressureDisconnect(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   int32_t numOverloadNotifications = 0;
+   const uint8_t data[1] = {1};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   shared.arg = (void*) &numOverloadNotifications;
+   shared.overloadNotify = overloadNotify;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setBackpressureConfig(&worker, APX_BACKPRESSURE_POLICY_DISCONNECT, 2u);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, 1u, &data[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x14, 1u, &data[0]));
+   CuAssertIntEquals(tc, 0, numOverloadNotifications);
+   CuAssertTrue(tc, apx_fileManagerShared_isConnected(&shared));
+   //writes are discarded without error once the high-water mark is reached
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x18, 1u, &data[0]));
+   CuAssertIntEquals(tc, 1, numOverloadNotifications);
+   CuAssertTrue(tc, !apx_fileManagerShared_isConnected(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x1C, 1u, &data[0]));
+   CuAssertIntEquals(tc, 1, numOverloadNotifications);
+   CuAssertIntEquals(tc, 2, apx_fileManagerWorker_numPendingMessages(&worker));
+   //messages queued before the overload are never sent
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 0, apx_transmitHandlerSpy_length(&spy));
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numOverloads);
+   CuAssertUIntEquals(tc, 2u, stats.numDroppedMessages);
+   CuAssertUIntEquals(tc, 2u, stats.numHighWaterMarkHits);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_sendDynamicDataDirectFragmented(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   adt_bytearray_t *batch;
+   const uint32_t dataLen = APX_WORKER_MAX_FRAGMENT_SIZE + 10u;
+   const uint32_t address = 0x10;
+   uint8_t *data;
+   const uint8_t *pNext;
+   const uint8_t *pEnd;
+   uint32_t msgLen;
+   uint32_t i;
+   rmf_msg_t msg;
+   data = (uint8_t*) malloc(dataLen);
+   CuAssertPtrNotNull(tc, data);
+   for (i = 0u; i < dataLen; i++)
+   {
+      data[i] = (uint8_t) i;
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, address, dataLen, data));
+   CuAssertIntEquals(tc, 1, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 1, apx_transmitHandlerSpy_length(&spy));
+   batch = apx_transmitHandlerSpy_next(&spy);
+   pNext = adt_bytearray_data(batch);
+   pEnd = pNext + adt_bytearray_length(batch);
+
+   //first fragment has the more bit set
+   pNext = numheader_decode32(pNext, pEnd, &msgLen);
+   CuAssertPtrNotNull(tc, pNext);
+   CuAssertIntEquals(tc, (int32_t) msgLen, rmf_unpackMsg(pNext, (int32_t) msgLen, &msg));
+   CuAssertUIntEquals(tc, address, msg.address);
+   CuAssertIntEquals(tc, APX_WORKER_MAX_FRAGMENT_SIZE, msg.dataLen);
+   CuAssertTrue(tc, msg.more_bit);
+   CuAssertIntEquals(tc, 0, memcmp(msg.data, &data[0], APX_WORKER_MAX_FRAGMENT_SIZE));
+   pNext += msgLen;
+
+   //last fragment continues where the first one ended
+   pNext = numheader_decode32(pNext, pEnd, &msgLen);
+   CuAssertPtrNotNull(tc, pNext);
+   CuAssertIntEquals(tc, (int32_t) msgLen, rmf_unpackMsg(pNext, (int32_t) msgLen, &msg));
+   CuAssertUIntEquals(tc, address + APX_WORKER_MAX_FRAGMENT_SIZE, msg.address);
+   CuAssertIntEquals(tc, 10, msg.dataLen);
+   CuAssertTrue(tc, !msg.more_bit);
+   CuAssertIntEquals(tc, 0, memcmp(msg.data, &data[APX_WORKER_MAX_FRAGMENT_SIZE], 10));
+   pNext += msgLen;
+   CuAssertPtrEquals(tc, (void*) pEnd, (void*) pNext);
+   adt_bytearray_delete(batch);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+   free(data);
+}
+
+static void test_apx_fileManagerWorker_runScheduled(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   int32_t numScheduleNotifications = 0;
+   uint32_t delayMs;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setScheduler(&worker, scheduleNotify, &numScheduleNotifications);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_start(&worker));
+   apx_fileManagerShared_connect(&shared);
+
+   //Only the first message of an idle worker notifies the scheduler
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, 1, numScheduleNotifications);
+
+   //The scheduler is the only consumer
+   CuAssertTrue(tc, !apx_fileManagerWorker_runBatch(&worker));
+   CuAssertIntEquals(tc, 3, apx_fileManagerWorker_numPendingMessages(&worker));
+
+   //A worker that used its budget must be run again
+   CuAssertTrue(tc, apx_fileManagerWorker_runScheduled(&worker, 2u, &delayMs));
+   CuAssertUIntEquals(tc, 0u, delayMs);
+   CuAssertIntEquals(tc, 1, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertTrue(tc, !apx_fileManagerWorker_runScheduled(&worker, 2u, &delayMs));
+   CuAssertIntEquals(tc, 0, apx_fileManagerWorker_numPendingMessages(&worker));
+   CuAssertIntEquals(tc, 2, apx_transmitHandlerSpy_length(&spy));
+
+   //Idle worker notifies the scheduler again
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, 2, numScheduleNotifications);
+   CuAssertTrue(tc, !apx_fileManagerWorker_runScheduled(&worker, 2u, &delayMs));
+   CuAssertIntEquals(tc, 3, apx_transmitHandlerSpy_length(&spy));
+
+   apx_fileManagerWorker_stop(&worker);
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_failedBatchIsNotCountedAsSent(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_transmitHandler_t handler;
+   apx_fileManagerWorkerStats_t stats;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   memset(&handler, 0, sizeof(handler));
+   handler.arg = &spy;
+   handler.getSendBuffer = apx_transmitHandlerSpy_getSendBuffer;
+   handler.send = apx_transmitHandlerSpy_send;
+   handler.sendBatch = failingSendBatch;
+   apx_fileManagerWorker_setTransmitHandler(&worker, &handler);
+   apx_fileManagerWorker_setNumHeaderSize(&worker, 32u);
+   apx_fileManagerShared_connect(&shared);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 0, stats.numFlushes);
+   CuAssertUIntEquals(tc, 0, stats.numMessages);
+   CuAssertUIntEquals(tc, 1, stats.numTransmitErrors);
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_runScheduledRateLimited(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_fileManagerWorkerStats_t stats;
+   int32_t numScheduleNotifications = 0;
+   uint32_t delayMs = 0u;
+   uint32_t i;
+   const uint8_t data[4] = {1, 2, 3, 4};
+   const uint32_t addressStep = 16u;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setCoalesceConfig(&worker, true, 1u);
+   apx_fileManagerWorker_setScheduler(&worker, scheduleNotify, &numScheduleNotifications);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_start(&worker));
+   apx_fileManagerShared_connect(&shared);
+   for (i = 0u; i <= APX_WORKER_COALESCE_BURST; i++)
+   {
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, i * addressStep, sizeof(data), &data[0]));
+   }
+   CuAssertIntEquals(tc, 1, numScheduleNotifications);
+
+   //Out of tokens, the scheduler gets a delay instead of a blocked thread
+   CuAssertTrue(tc, apx_fileManagerWorker_runScheduled(&worker, 100u, &delayMs));
+   CuAssertTrue(tc, delayMs > 0u);
+   CuAssertTrue(tc, delayMs <= 1000u);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, APX_WORKER_COALESCE_BURST, stats.numMessages);
+   CuAssertUIntEquals(tc, 1u, stats.numRateLimitWaits);
+
+   //The held back write is kept, writes to the same address merge into it and do not notify the scheduler
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, APX_WORKER_COALESCE_BURST * addressStep, sizeof(data), &data[0]));
+   CuAssertIntEquals(tc, 1, numScheduleNotifications);
+   apx_fileManagerWorker_setCoalesceConfig(&worker, true, 0u);
+   CuAssertTrue(tc, !apx_fileManagerWorker_runScheduled(&worker, 100u, &delayMs));
+   CuAssertUIntEquals(tc, 0u, delayMs);
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, APX_WORKER_COALESCE_BURST + 1, stats.numMessages);
+   CuAssertUIntEquals(tc, 1u, stats.numCoalescedWrites);
+
+   apx_fileManagerWorker_stop(&worker);
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_scheduleFailureIsRetried(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   int32_t numScheduleNotifications = 0;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   setupTransmitHandler(&worker, &spy, true);
+   apx_fileManagerWorker_setScheduler(&worker, failingScheduleNotify, &numScheduleNotifications);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_start(&worker));
+   apx_fileManagerShared_connect(&shared);
+
+   //Every push to a worker the scheduler refused tries again, the messages stay queued
+   CuAssertIntEquals(tc, APX_MEM_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, APX_MEM_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertIntEquals(tc, 2, numScheduleNotifications);
+   CuAssertIntEquals(tc, 2, apx_fileManagerWorker_numPendingMessages(&worker));
+
+   //Nothing holds on to the worker, it stops without waiting for the scheduler
+   apx_fileManagerWorker_stop(&worker);
+   CuAssertUIntEquals(tc, 1u, worker.isExited);
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static void test_apx_fileManagerWorker_transmitWouldBlock(CuTest* tc)
+{
+   apx_fileManagerWorker_t worker;
+   apx_fileManagerShared_t shared;
+   apx_transmitHandlerSpy_t spy;
+   apx_transmitHandler_t handler;
+   apx_fileManagerWorkerStats_t stats;
+   int32_t numOverloadNotifications = 0;
+   const uint8_t data[1] = {1};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerShared_create(&shared));
+   shared.arg = (void*) &numOverloadNotifications;
+   shared.overloadNotify = overloadNotify;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_create(&worker, &shared, APX_SERVER_MODE));
+   apx_transmitHandlerSpy_create(&spy);
+   memset(&handler, 0, sizeof(handler));
+   handler.arg = &spy;
+   handler.getSendBuffer = apx_transmitHandlerSpy_getSendBuffer;
+   handler.send = apx_transmitHandlerSpy_send;
+   handler.sendBatch = wouldBlockSendBatch;
+   apx_fileManagerWorker_setTransmitHandler(&worker, &handler);
+   apx_fileManagerWorker_setNumHeaderSize(&worker, 32u);
+   apx_fileManagerWorker_setBackpressureConfig(&worker, APX_BACKPRESSURE_POLICY_DROP_OLDEST, 100u);
+   apx_fileManagerShared_connect(&shared);
+
+   //refused data messages are dropped, the connection stays up
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x10, 1u, &data[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendDynamicDataDirect(&worker, 0x14, 1u, &data[0]));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numTransmitOverloads);
+   CuAssertUIntEquals(tc, 2u, stats.numDroppedMessages);
+   CuAssertUIntEquals(tc, 0u, stats.numOverloads);
+   CuAssertUIntEquals(tc, 0u, stats.numTransmitErrors);
+   CuAssertIntEquals(tc, 0, numOverloadNotifications);
+   CuAssertTrue(tc, apx_fileManagerShared_isConnected(&shared));
+
+   //anything else cannot be dropped, the connection is given up
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_fileManagerWorker_sendHeaderAckMsg(&worker));
+   CuAssertTrue(tc, apx_fileManagerWorker_runBatch(&worker));
+   apx_fileManagerWorker_getStats(&worker, &stats);
+   CuAssertUIntEquals(tc, 2u, stats.numTransmitOverloads);
+   CuAssertUIntEquals(tc, 1u, stats.numOverloads);
+   CuAssertUIntEquals(tc, 0u, stats.numFlushes);
+   CuAssertIntEquals(tc, 1, numOverloadNotifications);
+   CuAssertTrue(tc, !apx_fileManagerShared_isConnected(&shared));
+
+   apx_fileManagerWorker_destroy(&worker);
+   apx_fileManagerShared_destroy(&shared);
+   apx_transmitHandlerSpy_destroy(&spy);
+}
+
+static int32_t failingSendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   (void) arg;
+   (void) data;
+   (void) dataLen;
+   return -1;
+}
+
+static int32_t wouldBlockSendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   (void) arg;
+   (void) data;
+   (void) dataLen;
+   return APX_TRANSMIT_HANDLER_WOULD_BLOCK;
+}
+
+static void overloadNotify(void *arg)
+{
+   int32_t *numOverloadNotifications = (int32_t*) arg;
+   (*numOverloadNotifications)++;
+}
+
+static apx_error_t scheduleNotify(void *arg, apx_fileManagerWorker_t *worker)
+{
+   int32_t *numScheduleNotifications = (int32_t*) arg;
+   (void) worker;
+   (*numScheduleNotifications)++;
+   return APX_NO_ERROR;
+}
+
+static apx_error_t failingScheduleNotify(void *arg, apx_fileManagerWorker_t *worker)
+{
+   (void) scheduleNotify(arg, worker);
+   return APX_MEM_ERROR;
+}
+
+static void setupTransmitHandler(apx_fileManagerWorker_t *worker, apx_transmitHandlerSpy_t *spy, bool enableBatch)
+{
+   apx_transmitHandler_t handler;
+   memset(&handler, 0, sizeof(handler));
+   handler.arg = spy;
+   handler.getSendBuffer = apx_transmitHandlerSpy_getSendBuffer;
+   handler.send = apx_transmitHandlerSpy_send;
+   if (enableBatch)
+   {
+      handler.sendBatch = apx_transmitHandlerSpy_sendBatch;
+   }
+   apx_fileManagerWorker_setTransmitHandler(worker, &handler);
+   apx_fileManagerWorker_setNumHeaderSize(worker, 32u);
+}
+
 /*
 static void test_apx_fileManagerWorker_processFileInfo(CuTest* tc)
 {
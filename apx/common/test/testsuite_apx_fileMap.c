@@ -25,6 +25,9 @@ static void test_apx_fileMap_createRemoteDefinitionFile(CuTest* tc);
 static void test_apx_fileMap_autoInsert(CuTest* tc);
 static void test_apx_fileMap_manualInsert(CuTest* tc);
 static void test_apx_fileMap_makeFileInfoArray(CuTest* tc);
+static void test_apx_fileMap_findByAddress(CuTest* tc);
+static void test_apx_fileMap_rejectOverlappingFiles(CuTest* tc);
+static void test_apx_fileMap_removeFile(CuTest* tc);
 
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES
@@ -49,6 +52,9 @@ CuSuite* testSuite_apx_fileMap(void)
    SUITE_ADD_TEST(suite, test_apx_fileMap_autoInsert);
    SUITE_ADD_TEST(suite, test_apx_fileMap_manualInsert);
    SUITE_ADD_TEST(suite, test_apx_fileMap_makeFileInfoArray);
+   SUITE_ADD_TEST(suite, test_apx_fileMap_findByAddress);
+   SUITE_ADD_TEST(suite, test_apx_fileMap_rejectOverlappingFiles);
+   SUITE_ADD_TEST(suite, test_apx_fileMap_removeFile);
 
    return suite;
 }
@@ -114,7 +120,6 @@ static void test_apx_fileMap_autoInsert(CuTest* tc)
    uint8_t def1[256];
    uint8_t def2[256];
    uint8_t def3[256];
-   adt_list_elem_t *iter;
    apx_file_t *pFile;
 
    apx_fileManagerShared_create(&shared);
@@ -136,36 +141,31 @@ static void test_apx_fileMap_autoInsert(CuTest* tc)
    CuAssertPtrNotNull(tc, file4);
    CuAssertPtrNotNull(tc, file5);
    CuAssertPtrNotNull(tc, file6);
-   iter = adt_list_iter_first(apx_fileMap_getList(&shared.localFileMap));
-   pFile = (apx_file_t*) iter->pItem;
-   CuAssertPtrEquals(tc, iter->pItem, file1 );
+   pFile = apx_fileMap_get(&shared.localFileMap, 0);
+   CuAssertPtrEquals(tc, pFile, file1 );
    CuAssertStrEquals(tc, "TestNode1.out", pFile->fileInfo.name);
    CuAssertUIntEquals(tc, 0, pFile->fileInfo.address);
-   iter = adt_list_iter_next(iter);
-   pFile = (apx_file_t*) iter->pItem;
+   pFile = apx_fileMap_get(&shared.localFileMap, 1);
    CuAssertStrEquals(tc, "TestNode2.out", pFile->fileInfo.name);
    CuAssertUIntEquals(tc, 1024, pFile->fileInfo.address);
-   CuAssertPtrEquals(tc, iter->pItem, file3 );
-   iter = adt_list_iter_next(iter);
-   pFile = (apx_file_t*) iter->pItem;
+   CuAssertPtrEquals(tc, pFile, file3 );
+   pFile = apx_fileMap_get(&shared.localFileMap, 2);
    CuAssertStrEquals(tc, "TestNode3.out", pFile->fileInfo.name);
    CuAssertUIntEquals(tc, 1024*3, pFile->fileInfo.address);
-   CuAssertPtrEquals(tc, iter->pItem, file5 );
-   iter = adt_list_iter_next(iter);
-   pFile = (apx_file_t*) iter->pItem;
+   CuAssertPtrEquals(tc, pFile, file5 );
+   pFile = apx_fileMap_get(&shared.localFileMap, 3);
    CuAssertStrEquals(tc, "TestNode1.apx", pFile->fileInfo.name);
    CuAssertUIntEquals(tc, 64*1024*1024, pFile->fileInfo.address);
-   CuAssertPtrEquals(tc, iter->pItem, file2 );
-   iter = adt_list_iter_next(iter);
-   pFile = (apx_file_t*) iter->pItem;
+   CuAssertPtrEquals(tc, pFile, file2 );
+   pFile = apx_fileMap_get(&shared.localFileMap, 4);
    CuAssertStrEquals(tc, "TestNode2.apx", pFile->fileInfo.name);
    CuAssertUIntEquals(tc, 65*1024*1024, pFile->fileInfo.address);
-   CuAssertPtrEquals(tc, iter->pItem, file4 );
-   iter = adt_list_iter_next(iter);
-   pFile = (apx_file_t*) iter->pItem;
+   CuAssertPtrEquals(tc, pFile, file4 );
+   pFile = apx_fileMap_get(&shared.localFileMap, 5);
    CuAssertStrEquals(tc, "TestNode3.apx", pFile->fileInfo.name);
    CuAssertUIntEquals(tc, 66*1024*1024, pFile->fileInfo.address);
-   CuAssertPtrEquals(tc, iter->pItem, file6 );
+   CuAssertPtrEquals(tc, pFile, file6 );
+   CuAssertPtrEquals(tc, 0, apx_fileMap_get(&shared.localFileMap, 6));
    apx_fileManagerShared_destroy(&shared);
    apx_fileInfo_destroy(&fileInfo1);
    apx_fileInfo_destroy(&fileInfo2);
@@ -183,7 +183,6 @@ static void test_apx_fileMap_manualInsert(CuTest* tc)
    apx_file_t *file2;
    apx_fileInfo_t fileInfo1;
    apx_fileInfo_t fileInfo2;
-   adt_list_elem_t *iter;
    apx_file_t *pFile;
 
    CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo1, 10000, 10, "file1.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
@@ -192,25 +191,18 @@ static void test_apx_fileMap_manualInsert(CuTest* tc)
    file1 = apx_file_new(&fileInfo1);
    apx_fileMap_create(&fileMap);
    apx_fileMap_insertFile(&fileMap, file1);
-   iter = adt_list_iter_first(&fileMap.fileList);
-   pFile = (apx_file_t*) iter->pItem;
-   CuAssertPtrEquals(tc, iter->pItem, file1 );
+   pFile = apx_fileMap_get(&fileMap, 0);
+   CuAssertPtrEquals(tc, pFile, file1 );
    CuAssertUIntEquals(tc, 10000, pFile->fileInfo.address);
-   iter = adt_list_iter_next(iter);
-   CuAssertPtrEquals(tc, 0, iter);
+   CuAssertPtrEquals(tc, 0, apx_fileMap_get(&fileMap, 1));
 
    file2 = apx_file_new(&fileInfo2);
    apx_fileMap_insertFile(&fileMap, file2);
-   iter = adt_list_iter_first(&fileMap.fileList);
-   CuAssertPtrNotNull(tc, iter);
-   CuAssertPtrEquals(tc, iter->pItem, file2 );
-   pFile = (apx_file_t*) iter->pItem;
+   pFile = apx_fileMap_get(&fileMap, 0);
+   CuAssertPtrEquals(tc, pFile, file2 );
    CuAssertUIntEquals(tc, 2000, pFile->fileInfo.address);
-   iter = adt_list_iter_next(iter);
-   CuAssertPtrNotNull(tc, iter);
-   CuAssertPtrEquals(tc, iter->pItem, file1 );
-   iter = adt_list_iter_next(iter);
-   CuAssertPtrEquals(tc, 0, iter);
+   CuAssertPtrEquals(tc, file1, apx_fileMap_get(&fileMap, 1));
+   CuAssertPtrEquals(tc, 0, apx_fileMap_get(&fileMap, 2));
    apx_fileMap_destroy(&fileMap);
    apx_fileInfo_destroy(&fileInfo1);
    apx_fileInfo_destroy(&fileInfo2);
@@ -248,3 +240,110 @@ static void test_apx_fileMap_makeFileInfoArray(CuTest* tc)
 
 }
 
+static void test_apx_fileMap_findByAddress(CuTest* tc)
+{
+   apx_fileMap_t fileMap;
+   apx_fileInfo_t fileInfo;
+   apx_file_t *files[100];
+   char name[RMF_MAX_FILE_NAME+1];
+   int32_t i;
+
+   apx_fileMap_create(&fileMap);
+   for (i = 0; i < 100; i++)
+   {
+      sprintf(name, "TestNode%d.out", (int) i);
+      CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, RMF_INVALID_ADDRESS, 100u + (uint32_t) i, name, RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+      files[i] = apx_file_new(&fileInfo);
+      apx_fileInfo_destroy(&fileInfo);
+      CuAssertIntEquals(tc, 0, apx_fileMap_insertFile(&fileMap, files[i]));
+      CuAssertUIntEquals(tc, ((uint32_t) i) * 1024u, files[i]->fileInfo.address);
+   }
+   CuAssertIntEquals(tc, 100, apx_fileMap_length(&fileMap));
+   for (i = 0; i < 100; i++)
+   {
+      uint32_t startAddress = ((uint32_t) i) * 1024u;
+      uint32_t endAddress = startAddress + 100u + (uint32_t) i;
+      CuAssertPtrEquals(tc, files[i], apx_fileMap_findByAddress(&fileMap, startAddress));
+      CuAssertPtrEquals(tc, files[i], apx_fileMap_findByAddress(&fileMap, endAddress - 1u));
+      CuAssertPtrEquals(tc, 0, apx_fileMap_findByAddress(&fileMap, endAddress));
+   }
+   CuAssertPtrEquals(tc, files[42], apx_fileMap_findByAddress(&fileMap, 42u * 1024u + 10u));
+   CuAssertPtrEquals(tc, files[42], apx_fileMap_findByAddress(&fileMap, 42u * 1024u + 11u));
+   CuAssertPtrEquals(tc, files[7], apx_fileMap_findByAddress(&fileMap, 7u * 1024u));
+   CuAssertPtrEquals(tc, 0, apx_fileMap_findByAddress(&fileMap, 100u * 1024u));
+   CuAssertPtrEquals(tc, 0, apx_fileMap_findByAddress(&fileMap, APX_ADDRESS_DEFINITION_START));
+   apx_fileMap_destroy(&fileMap);
+}
+
+static void test_apx_fileMap_rejectOverlappingFiles(CuTest* tc)
+{
+   apx_fileMap_t fileMap;
+   apx_fileInfo_t fileInfo;
+   apx_file_t *file1;
+   apx_file_t *file2;
+   apx_file_t *file3;
+   apx_file_t *file4;
+
+   apx_fileMap_create(&fileMap);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, 1000, 100, "file1.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file1 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, 1099, 10, "file2.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file2 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, 950, 51, "file3.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file3 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, 950, 50, "file4.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file4 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+
+   CuAssertIntEquals(tc, 0, apx_fileMap_insertFile(&fileMap, file1));
+   CuAssertIntEquals(tc, -1, apx_fileMap_insertFile(&fileMap, file2));
+   CuAssertIntEquals(tc, -1, apx_fileMap_insertFile(&fileMap, file3));
+   CuAssertIntEquals(tc, 0, apx_fileMap_insertFile(&fileMap, file4));
+   CuAssertIntEquals(tc, 2, apx_fileMap_length(&fileMap));
+   CuAssertPtrEquals(tc, file4, apx_fileMap_get(&fileMap, 0));
+   CuAssertPtrEquals(tc, file1, apx_fileMap_get(&fileMap, 1));
+
+   apx_fileMap_destroy(&fileMap);
+   apx_file_delete(file2);
+   apx_file_delete(file3);
+}
+
+static void test_apx_fileMap_removeFile(CuTest* tc)
+{
+   apx_fileMap_t fileMap;
+   apx_fileInfo_t fileInfo;
+   apx_file_t *file1;
+   apx_file_t *file2;
+   apx_file_t *file3;
+
+   apx_fileMap_create(&fileMap);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, RMF_INVALID_ADDRESS, 10, "file1.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file1 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, RMF_INVALID_ADDRESS, 10, "file2.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file2 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_fileInfo_create(&fileInfo, RMF_INVALID_ADDRESS, 10, "file3.out", RMF_FILE_TYPE_FIXED, RMF_DIGEST_TYPE_NONE, NULL));
+   file3 = apx_file_new(&fileInfo);
+   apx_fileInfo_destroy(&fileInfo);
+   CuAssertIntEquals(tc, 0, apx_fileMap_insertFile(&fileMap, file1));
+   CuAssertIntEquals(tc, 0, apx_fileMap_insertFile(&fileMap, file2));
+   CuAssertIntEquals(tc, 0, apx_fileMap_insertFile(&fileMap, file3));
+   CuAssertPtrEquals(tc, file2, apx_fileMap_findByAddress(&fileMap, 1024u));
+
+   CuAssertIntEquals(tc, 0, apx_fileMap_removeFile(&fileMap, file2));
+   CuAssertIntEquals(tc, -1, apx_fileMap_removeFile(&fileMap, file2));
+   CuAssertIntEquals(tc, 2, apx_fileMap_length(&fileMap));
+   CuAssertTrue(tc, !apx_fileMap_exist(&fileMap, file2));
+   CuAssertTrue(tc, apx_fileMap_exist(&fileMap, file3));
+   CuAssertPtrEquals(tc, 0, apx_fileMap_findByAddress(&fileMap, 1024u));
+   CuAssertPtrEquals(tc, file3, apx_fileMap_findByAddress(&fileMap, 2048u));
+   CuAssertPtrEquals(tc, file1, apx_fileMap_get(&fileMap, 0));
+   CuAssertPtrEquals(tc, file3, apx_fileMap_get(&fileMap, 1));
+
+   apx_fileMap_destroy(&fileMap);
+   apx_file_delete(file2);
+}
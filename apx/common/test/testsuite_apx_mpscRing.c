@@ -0,0 +1,244 @@
+/*****************************************************************************
+* \file      testsuite_apx_mpscRing.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_mpscRing
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_mpscRing.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define SEQUENCE_SIZE ((uint32_t) sizeof(uint32_t))
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_mpscRing_create(CuTest *tc);
+static void test_apx_mpscRing_pushAndPop(CuTest *tc);
+static void test_apx_mpscRing_wrapAround(CuTest *tc);
+static void test_apx_mpscRing_overflowKeepsOrder(CuTest *tc);
+static void test_apx_mpscRing_unpublishedSlotBlocksOverflow(CuTest *tc);
+static void test_apx_mpscRing_waitWithoutBlocking(CuTest *tc);
+static void test_apx_mpscRing_interrupt(CuTest *tc);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_mpscRing(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_create);
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_pushAndPop);
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_wrapAround);
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_overflowKeepsOrder);
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_unpublishedSlotBlocksOverflow);
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_waitWithoutBlocking);
+   SUITE_ADD_TEST(suite, test_apx_mpscRing_interrupt);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_mpscRing_create(CuTest *tc)
+{
+   apx_mpscRing_t ring;
+   apx_mpscRingStats_t stats;
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_mpscRing_create(&ring, 0u, 8u));
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 0u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 5u));
+   CuAssertUIntEquals(tc, 8u, ring.capacity);
+   CuAssertUIntEquals(tc, 0u, apx_mpscRing_length(&ring));
+   CuAssertTrue(tc, !apx_mpscRing_isInterrupted(&ring));
+   apx_mpscRing_getStats(&ring, &stats);
+   CuAssertUIntEquals(tc, 0u, stats.depth);
+   CuAssertUIntEquals(tc, 0u, stats.maxDepth);
+   CuAssertUIntEquals(tc, 0u, stats.numWakeups);
+   CuAssertUIntEquals(tc, 0u, stats.numParks);
+   CuAssertUIntEquals(tc, 0u, stats.numOverflows);
+   apx_mpscRing_destroy(&ring);
+}
+
+static void test_apx_mpscRing_pushAndPop(CuTest *tc)
+{
+   apx_mpscRing_t *ring = apx_mpscRing_new(sizeof(uint32_t), 8u);
+   apx_mpscRingStats_t stats;
+   uint32_t value;
+   CuAssertPtrNotNull(tc, ring);
+   CuAssertTrue(tc, !apx_mpscRing_pop(ring, &value));
+   value = 1u;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(ring, &value));
+   value = 2u;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(ring, &value));
+   value = 3u;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(ring, &value));
+   CuAssertUIntEquals(tc, 3u, apx_mpscRing_length(ring));
+   CuAssertTrue(tc, apx_mpscRing_pop(ring, &value));
+   CuAssertUIntEquals(tc, 1u, value);
+   CuAssertTrue(tc, apx_mpscRing_pop(ring, &value));
+   CuAssertUIntEquals(tc, 2u, value);
+   CuAssertTrue(tc, apx_mpscRing_pop(ring, &value));
+   CuAssertUIntEquals(tc, 3u, value);
+   CuAssertTrue(tc, !apx_mpscRing_pop(ring, &value));
+   CuAssertUIntEquals(tc, 0u, apx_mpscRing_length(ring));
+   apx_mpscRing_getStats(ring, &stats);
+   CuAssertUIntEquals(tc, 3u, stats.maxDepth);
+   CuAssertUIntEquals(tc, 0u, stats.numWakeups); //consumer never parked
+   apx_mpscRing_delete(ring);
+}
+
+static void test_apx_mpscRing_wrapAround(CuTest *tc)
+{
+   apx_mpscRing_t ring;
+   apx_mpscRingStats_t stats;
+   uint32_t i;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 4u));
+   for (i = 0u; i < 100u; i++)
+   {
+      uint32_t value = 0u;
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &i));
+      CuAssertTrue(tc, apx_mpscRing_pop(&ring, &value));
+      CuAssertUIntEquals(tc, i, value);
+   }
+   apx_mpscRing_getStats(&ring, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.maxDepth);
+   CuAssertUIntEquals(tc, 0u, stats.numOverflows);
+   apx_mpscRing_destroy(&ring);
+}
+
+static void test_apx_mpscRing_overflowKeepsOrder(CuTest *tc)
+{
+   apx_mpscRing_t ring;
+   apx_mpscRingStats_t stats;
+   uint32_t i;
+   uint32_t value;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 4u));
+   for (i = 0u; i < 10u; i++)
+   {
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &i));
+   }
+   CuAssertUIntEquals(tc, 10u, apx_mpscRing_length(&ring));
+   apx_mpscRing_getStats(&ring, &stats);
+   CuAssertUIntEquals(tc, 6u, stats.numOverflows);
+   //Free a slot in the ring, new elements must still be placed after the ones in overflow
+   CuAssertTrue(tc, apx_mpscRing_pop(&ring, &value));
+   CuAssertUIntEquals(tc, 0u, value);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &i));
+   for (i = 1u; i <= 10u; i++)
+   {
+      CuAssertTrue(tc, apx_mpscRing_pop(&ring, &value));
+      CuAssertUIntEquals(tc, i, value);
+   }
+   CuAssertTrue(tc, !apx_mpscRing_pop(&ring, &value));
+   //overflow queue is empty, ring is used again
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &i));
+   apx_mpscRing_getStats(&ring, &stats);
+   CuAssertUIntEquals(tc, 7u, stats.numOverflows);
+   CuAssertUIntEquals(tc, 1u, stats.depth);
+   apx_mpscRing_destroy(&ring);
+}
+
+/**
+ * Emulates a producer that has reserved a slot (moved tail) but not yet copied its element into it
+ * while other producers push past it into the overflow queue.
+ */
+static void test_apx_mpscRing_unpublishedSlotBlocksOverflow(CuTest *tc)
+{
+   apx_mpscRing_t ring;
+   uint32_t i;
+   uint32_t value;
+   uint32_t reservedPos;
+   uint8_t *reservedSlot;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 4u));
+   for (i = 0u; i < 2u; i++)
+   {
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &i));
+   }
+   reservedPos = ring.tail;
+   reservedSlot = ring.slots + ((reservedPos & (ring.capacity - 1u)) * ring.slotSize);
+   ring.tail = reservedPos + 1u;
+   for (i = 3u; i < 6u; i++)
+   {
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &i));
+   }
+   CuAssertUIntEquals(tc, 2u, ring.overflowCount);
+   CuAssertTrue(tc, apx_mpscRing_pop(&ring, &value));
+   CuAssertUIntEquals(tc, 0u, value);
+   CuAssertTrue(tc, apx_mpscRing_pop(&ring, &value));
+   CuAssertUIntEquals(tc, 1u, value);
+   //The reserved slot is older than the elements in overflow
+   CuAssertTrue(tc, !apx_mpscRing_wait(&ring, 0u));
+   CuAssertTrue(tc, !apx_mpscRing_pop(&ring, &value));
+   value = 2u;
+   memcpy(reservedSlot + SEQUENCE_SIZE, &value, sizeof(value));
+   *((volatile uint32_t*) reservedSlot) = reservedPos + 1u;
+   for (i = 2u; i < 6u; i++)
+   {
+      CuAssertTrue(tc, apx_mpscRing_pop(&ring, &value));
+      CuAssertUIntEquals(tc, i, value);
+   }
+   CuAssertTrue(tc, !apx_mpscRing_pop(&ring, &value));
+   apx_mpscRing_destroy(&ring);
+}
+
+static void test_apx_mpscRing_waitWithoutBlocking(CuTest *tc)
+{
+   apx_mpscRing_t ring;
+   apx_mpscRingStats_t stats;
+   uint32_t value = 7u;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 4u));
+   CuAssertTrue(tc, !apx_mpscRing_wait(&ring, 0u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_push(&ring, &value));
+   CuAssertTrue(tc, apx_mpscRing_wait(&ring, 0u));
+   CuAssertTrue(tc, apx_mpscRing_wait(&ring, APX_MPSC_RING_WAIT_FOREVER));
+   apx_mpscRing_getStats(&ring, &stats);
+   CuAssertUIntEquals(tc, 0u, stats.numParks);
+   CuAssertUIntEquals(tc, 0u, stats.numWakeups);
+   apx_mpscRing_destroy(&ring);
+}
+
+static void test_apx_mpscRing_interrupt(CuTest *tc)
+{
+   apx_mpscRing_t ring;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_mpscRing_create(&ring, sizeof(uint32_t), 4u));
+   apx_mpscRing_interrupt(&ring);
+   CuAssertTrue(tc, apx_mpscRing_isInterrupted(&ring));
+   CuAssertTrue(tc, !apx_mpscRing_wait(&ring, APX_MPSC_RING_WAIT_FOREVER));
+   apx_mpscRing_destroy(&ring);
+}
@@ -39,11 +39,28 @@
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+typedef struct forwardSpy_tag
+{
+   apx_nodeData_t *nodeData;
+   uint8_t data[2];
+   uint8_t bufferData[2]; //provide-port buffer contents seen from inside the forward
+   uint32_t offset;
+   int32_t numCalls;
+   apx_error_t result;
+} forwardSpy_t;
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
 static void test_apx_nodeData_writeDefinitionBuffer(CuTest *tc);
+static void test_apx_nodeData_writeProvidePortDataOnChange(CuTest *tc);
+static void test_apx_nodeData_portDataSequence(CuTest *tc);
+static void test_apx_nodeData_writeProvidePortDataForwardsUnderLock(CuTest *tc);
+static apx_error_t forwardSpy_forward(void *arg, const uint8_t *data, uint32_t offset, apx_size_t len);
+static void test_apx_nodeData_packProvidePortData(CuTest *tc);
+static void test_apx_nodeData_unpackRequirePortData(CuTest *tc);
+static void packReversed(void *arg, uint8_t *dest, apx_size_t len);
+static void unpackReversed(void *arg, const uint8_t *src, apx_size_t len);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -57,6 +74,11 @@ CuSuite* testSuite_apx_nodeData2(void)
    CuSuite* suite = CuSuiteNew();
 
    SUITE_ADD_TEST(suite, test_apx_nodeData_writeDefinitionBuffer);
+   SUITE_ADD_TEST(suite, test_apx_nodeData_writeProvidePortDataOnChange);
+   SUITE_ADD_TEST(suite, test_apx_nodeData_portDataSequence);
+   SUITE_ADD_TEST(suite, test_apx_nodeData_writeProvidePortDataForwardsUnderLock);
+   SUITE_ADD_TEST(suite, test_apx_nodeData_packProvidePortData);
+   SUITE_ADD_TEST(suite, test_apx_nodeData_unpackRequirePortData);
 
    return suite;
 }
@@ -82,3 +104,206 @@ static void test_apx_nodeData_writeDefinitionBuffer(CuTest *tc)
 
 }
 
+static void test_apx_nodeData_writeProvidePortDataOnChange(CuTest *tc)
+{
+   const uint8_t value1[2] = {0x12, 0x34};
+   const uint8_t value2[2] = {0x56, 0x78};
+   uint8_t rawData[2];
+   bool isForwarded = false;
+   apx_nodeData_t *nodeData =  apx_nodeData_new();
+   CuAssertPtrNotNull(tc, nodeData);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortBuffer(nodeData, 4u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortWriteFilterBuffer(nodeData, 2));
+
+   //Default mode forwards every write
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 0, &value1[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   isForwarded = false;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 0, &value1[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   CuAssertUIntEquals(tc, 0u, apx_nodeData_getProvidePortSuppressedWriteCount(nodeData, 0));
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_setProvidePortWriteMode(nodeData, 0, APX_PORT_WRITE_MODE_ON_CHANGE, 0u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 0, &value1[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, !isForwarded);
+   CuAssertUIntEquals(tc, 1u, apx_nodeData_getProvidePortSuppressedWriteCount(nodeData, 0));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 0, &value2[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_readProvidePortData(nodeData, &rawData[0], 0u, 2u));
+   CuAssertIntEquals(tc, 0, memcmp(&value2[0], &rawData[0], 2u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 0, &value2[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, !isForwarded);
+   CuAssertUIntEquals(tc, 2u, apx_nodeData_getProvidePortSuppressedWriteCount(nodeData, 0));
+
+   //Other ports are not affected
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 1, &value2[0], 2u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 1, &value2[0], 2u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   CuAssertUIntEquals(tc, 0u, apx_nodeData_getProvidePortSuppressedWriteCount(nodeData, 1));
+
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_nodeData_setProvidePortWriteMode(nodeData, 2, APX_PORT_WRITE_MODE_ON_CHANGE, 0u));
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 1, &value2[0], 3u, 2u, 0, 0, &isForwarded));
+   apx_nodeData_delete(nodeData);
+}
+
+/**
+ * Every completed write leaves the sequence counter even and two steps further, rejected or suppressed writes leave it alone
+ */
+static void test_apx_nodeData_portDataSequence(CuTest *tc)
+{
+   const uint8_t value1[2] = {0x12, 0x34};
+   const uint8_t value2[2] = {0x56, 0x78};
+   uint8_t rawData[2];
+   bool isForwarded = false;
+   apx_portDataProps_t requirePortDataProps;
+   apx_portDataProps_t providePortDataProps;
+   apx_nodeData_t *requireNodeData = apx_nodeData_new();
+   apx_nodeData_t *provideNodeData = apx_nodeData_new();
+   CuAssertPtrNotNull(tc, requireNodeData);
+   CuAssertPtrNotNull(tc, provideNodeData);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createRequirePortBuffer(requireNodeData, 4u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortBuffer(provideNodeData, 2u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortWriteFilterBuffer(provideNodeData, 1));
+   CuAssertUIntEquals(tc, 0u, requireNodeData->requirePortDataSequence);
+   CuAssertUIntEquals(tc, 0u, provideNodeData->providePortDataSequence);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortData(provideNodeData, &value1[0], 0u, 2u));
+   CuAssertUIntEquals(tc, 2u, provideNodeData->providePortDataSequence);
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_nodeData_writeProvidePortData(provideNodeData, &value1[0], 1u, 2u));
+   CuAssertUIntEquals(tc, 2u, provideNodeData->providePortDataSequence);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_setProvidePortWriteMode(provideNodeData, 0, APX_PORT_WRITE_MODE_ON_CHANGE, 0u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(provideNodeData, 0, &value1[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, !isForwarded);
+   CuAssertUIntEquals(tc, 2u, provideNodeData->providePortDataSequence);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(provideNodeData, 0, &value2[0], 0u, 2u, 0, 0, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   CuAssertUIntEquals(tc, 4u, provideNodeData->providePortDataSequence);
+
+   //Routing a provide-port into a require-port only writes the require-port buffer
+   apx_portDataProps_create(&providePortDataProps, APX_PROVIDE_PORT, 0, 0u, 2u);
+   apx_portDataProps_create(&requirePortDataProps, APX_REQUIRE_PORT, 1, 2u, 2u);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_updatePortDataDirect(requireNodeData, &requirePortDataProps, provideNodeData, &providePortDataProps));
+   CuAssertUIntEquals(tc, 2u, requireNodeData->requirePortDataSequence);
+   CuAssertUIntEquals(tc, 4u, provideNodeData->providePortDataSequence);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_readRequirePortData(requireNodeData, &rawData[0], 2u, 2u));
+   CuAssertIntEquals(tc, 0, memcmp(&value2[0], &rawData[0], 2u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeRequirePortData(requireNodeData, &value1[0], 0u, 2u));
+   CuAssertUIntEquals(tc, 4u, requireNodeData->requirePortDataSequence);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_readRequirePortData(requireNodeData, &rawData[0], 0u, 2u));
+   CuAssertIntEquals(tc, 0, memcmp(&value1[0], &rawData[0], 2u));
+
+   apx_nodeData_delete(requireNodeData);
+   apx_nodeData_delete(provideNodeData);
+}
+
+static void test_apx_nodeData_writeProvidePortDataForwardsUnderLock(CuTest *tc)
+{
+   const uint8_t value1[2] = {0x12, 0x34};
+   const uint8_t value2[2] = {0x56, 0x78};
+   forwardSpy_t spy;
+   bool isForwarded = false;
+   apx_nodeData_t *nodeData =  apx_nodeData_new();
+   CuAssertPtrNotNull(tc, nodeData);
+   memset(&spy, 0, sizeof(spy));
+   spy.nodeData = nodeData;
+   spy.result = APX_NO_ERROR;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortBuffer(nodeData, 4u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortWriteFilterBuffer(nodeData, 2));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_setProvidePortWriteMode(nodeData, 1, APX_PORT_WRITE_MODE_ON_CHANGE, 0u));
+
+   //The forward sees the data it forwards already stored in the buffer
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 1, &value1[0], 2u, 2u, forwardSpy_forward, &spy, &isForwarded));
+   CuAssertTrue(tc, isForwarded);
+   CuAssertIntEquals(tc, 1, spy.numCalls);
+   CuAssertUIntEquals(tc, 2u, spy.offset);
+   CuAssertIntEquals(tc, 0, memcmp(&value1[0], &spy.data[0], 2u));
+   CuAssertIntEquals(tc, 0, memcmp(&value1[0], &spy.bufferData[0], 2u));
+
+   //Suppressed writes are not forwarded
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 1, &value1[0], 2u, 2u, forwardSpy_forward, &spy, &isForwarded));
+   CuAssertTrue(tc, !isForwarded);
+   CuAssertIntEquals(tc, 1, spy.numCalls);
+
+   //Errors from the forward are returned to the writer
+   spy.result = APX_TRANSMIT_ERROR;
+   CuAssertIntEquals(tc, APX_TRANSMIT_ERROR, apx_nodeData_writeProvidePortDataFiltered(nodeData, 1, &value2[0], 2u, 2u, forwardSpy_forward, &spy, (bool*) 0));
+   CuAssertIntEquals(tc, 2, spy.numCalls);
+   CuAssertIntEquals(tc, 0, memcmp(&value2[0], &spy.bufferData[0], 2u));
+
+   apx_nodeData_delete(nodeData);
+}
+
+static apx_error_t forwardSpy_forward(void *arg, const uint8_t *data, uint32_t offset, apx_size_t len)
+{
+   forwardSpy_t *spy = (forwardSpy_t*) arg;
+   if (len == 2u)
+   {
+      memcpy(&spy->data[0], data, len);
+      memcpy(&spy->bufferData[0], &spy->nodeData->providePortDataBuf[offset], len);
+   }
+   spy->offset = offset;
+   spy->numCalls++;
+   return spy->result;
+}
+
+static void test_apx_nodeData_packProvidePortData(CuTest *tc)
+{
+   const uint8_t value[2] = {0x12, 0x34};
+   const uint8_t expected[2] = {0x34, 0x12};
+   forwardSpy_t spy;
+   apx_nodeData_t *nodeData =  apx_nodeData_new();
+   CuAssertPtrNotNull(tc, nodeData);
+   memset(&spy, 0, sizeof(spy));
+   spy.nodeData = nodeData;
+   spy.result = APX_NO_ERROR;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortBuffer(nodeData, 4u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortWriteFilterBuffer(nodeData, 2));
+   //Packing needs the scratch buffer
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_nodeData_packProvidePortDataFiltered(nodeData, 1, 2u, 2u, packReversed, (void*) &value[0], forwardSpy_forward, &spy));
+   CuAssertIntEquals(tc, 0, spy.numCalls);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createProvidePortPackBuffer(nodeData, 2u));
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_nodeData_packProvidePortDataFiltered(nodeData, 0, 0u, 4u, packReversed, (void*) &value[0], forwardSpy_forward, &spy));
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_setProvidePortWriteMode(nodeData, 1, APX_PORT_WRITE_MODE_ON_CHANGE, 0u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_packProvidePortDataFiltered(nodeData, 1, 2u, 2u, packReversed, (void*) &value[0], forwardSpy_forward, &spy));
+   CuAssertIntEquals(tc, 1, spy.numCalls);
+   CuAssertIntEquals(tc, 0, memcmp(&expected[0], &spy.data[0], 2u));
+   CuAssertIntEquals(tc, 0, memcmp(&expected[0], &spy.bufferData[0], 2u));
+   //The write filter compares the packed data
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_packProvidePortDataFiltered(nodeData, 1, 2u, 2u, packReversed, (void*) &value[0], forwardSpy_forward, &spy));
+   CuAssertIntEquals(tc, 1, spy.numCalls);
+   CuAssertUIntEquals(tc, 1u, apx_nodeData_getProvidePortSuppressedWriteCount(nodeData, 1));
+
+   apx_nodeData_delete(nodeData);
+}
+
+static void test_apx_nodeData_unpackRequirePortData(CuTest *tc)
+{
+   const uint8_t value[2] = {0x12, 0x34};
+   uint8_t result[2] = {0, 0};
+   apx_nodeData_t *nodeData =  apx_nodeData_new();
+   CuAssertPtrNotNull(tc, nodeData);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_createRequirePortBuffer(nodeData, 4u));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_writeRequirePortData(nodeData, &value[0], 2u, 2u));
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_nodeData_unpackRequirePortData(nodeData, 3u, 2u, unpackReversed, (void*) &result[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeData_unpackRequirePortData(nodeData, 2u, 2u, unpackReversed, (void*) &result[0]));
+   CuAssertUIntEquals(tc, 0x34, result[0]);
+   CuAssertUIntEquals(tc, 0x12, result[1]);
+   apx_nodeData_delete(nodeData);
+}
+
+static void packReversed(void *arg, uint8_t *dest, apx_size_t len)
+{
+   const uint8_t *src = (const uint8_t*) arg;
+   apx_size_t i;
+   for (i = 0u; i < len; i++)
+   {
+      dest[i] = src[len - 1u - i];
+   }
+}
+
+static void unpackReversed(void *arg, const uint8_t *src, apx_size_t len)
+{
+   packReversed((void*) src, (uint8_t*) arg, len);
+}
@@ -0,0 +1,293 @@
+/*****************************************************************************
+* \file      testsuite_apx_nodeImage.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_nodeImage
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_nodeImage.h"
+#include "apx_sha256.h"
+#include "apx_test_nodes.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#define TEST_IMAGE_DIRECTORY "."
+#else
+#define TEST_IMAGE_DIRECTORY "/tmp"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_nodeImage_roundTripClientMode(CuTest* tc);
+static void test_apx_nodeImage_roundTripServerMode(CuTest* tc);
+static void test_apx_nodeImage_rejectsWrongDefinitionDigest(CuTest* tc);
+static void test_apx_nodeImage_rejectsDamagedImage(CuTest* tc);
+static void test_apx_nodeImage_rejectsUnsupportedVersion(CuTest* tc);
+static void test_apx_nodeImage_saveAndLoadFile(CuTest* tc);
+static void test_apx_nodeImage_loadMissingFile(CuTest* tc);
+static apx_nodeInfo_t *buildNodeInfo(const char *definition, apx_mode_t mode, uint8_t *digest);
+static void verifyNodeInfoEquals(CuTest* tc, const apx_nodeInfo_t *expected, const apx_nodeInfo_t *actual);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_nodeImage(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_roundTripClientMode);
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_roundTripServerMode);
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_rejectsWrongDefinitionDigest);
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_rejectsDamagedImage);
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_rejectsUnsupportedVersion);
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_saveAndLoadFile);
+   SUITE_ADD_TEST(suite, test_apx_nodeImage_loadMissingFile);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_nodeImage_roundTripClientMode(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t definitionLen = (uint32_t) strlen(g_apx_test_node1);
+   apx_nodeInfo_t *expected = buildNodeInfo(g_apx_test_node1, APX_CLIENT_MODE, &digest[0]);
+   apx_nodeInfo_t *actual;
+   adt_bytearray_t image;
+   apx_error_t rc = APX_NO_ERROR;
+   CuAssertPtrNotNull(tc, expected);
+   adt_bytearray_create(&image, ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeImage_write(&image, expected, &digest[0], definitionLen));
+   actual = apx_nodeImage_read(adt_bytearray_constData(&image), adt_bytearray_length(&image), &digest[0], definitionLen, APX_CLIENT_MODE, &rc);
+   CuAssertIntEquals(tc, APX_NO_ERROR, rc);
+   CuAssertPtrNotNull(tc, actual);
+   verifyNodeInfoEquals(tc, expected, actual);
+   CuAssertPtrNotNull(tc, apx_nodeInfo_getClientBytePortMap(actual));
+   CuAssertPtrEquals(tc, NULL, apx_nodeInfo_getServerBytePortMap(actual));
+   CuAssertIntEquals(tc, 0, apx_nodeInfo_findRequirePortIdFromByteOffset(actual, 0));
+   CuAssertIntEquals(tc, 1 | APX_PORT_ID_PROVIDE_PORT, apx_nodeInfo_findPortIdByName(actual, "CabTiltLockWarning"));
+
+   apx_nodeInfo_release(actual);
+   apx_nodeInfo_release(expected);
+   adt_bytearray_destroy(&image);
+}
+
+static void test_apx_nodeImage_roundTripServerMode(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t definitionLen = (uint32_t) strlen(g_apx_test_node2);
+   apx_nodeInfo_t *expected = buildNodeInfo(g_apx_test_node2, APX_SERVER_MODE, &digest[0]);
+   apx_nodeInfo_t *actual;
+   adt_bytearray_t image;
+   apx_portId_t portId;
+   CuAssertPtrNotNull(tc, expected);
+   adt_bytearray_create(&image, ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeImage_write(&image, expected, &digest[0], definitionLen));
+   actual = apx_nodeImage_read(adt_bytearray_constData(&image), adt_bytearray_length(&image), &digest[0], definitionLen, APX_SERVER_MODE, (apx_error_t*) 0);
+   CuAssertPtrNotNull(tc, actual);
+   verifyNodeInfoEquals(tc, expected, actual);
+   CuAssertPtrNotNull(tc, apx_nodeInfo_getServerBytePortMap(actual));
+   CuAssertIntEquals(tc, 1, apx_nodeInfo_findProvidePortIdFromByteOffset(actual, 2));
+   for (portId = 0; portId < expected->numProvidePorts; portId++)
+   {
+      CuAssertUIntEquals(tc, apx_nodeInfo_getProvidePortSignatureId(expected, portId), apx_nodeInfo_getProvidePortSignatureId(actual, portId));
+   }
+   CuAssertUIntEquals(tc, apx_nodeInfo_getRequirePortSignatureId(expected, 0), apx_nodeInfo_getRequirePortSignatureId(actual, 0));
+
+   apx_nodeInfo_release(actual);
+   apx_nodeInfo_release(expected);
+   adt_bytearray_destroy(&image);
+}
+
+static void test_apx_nodeImage_rejectsWrongDefinitionDigest(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint8_t otherDigest[APX_SHA256_DIGEST_SIZE];
+   uint32_t definitionLen = (uint32_t) strlen(g_apx_test_node1);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(g_apx_test_node1, APX_CLIENT_MODE, &digest[0]);
+   adt_bytearray_t image;
+   apx_error_t rc = APX_NO_ERROR;
+   adt_bytearray_create(&image, ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+   apx_sha256_calc((const uint8_t*) g_apx_test_node2, strlen(g_apx_test_node2), &otherDigest[0]);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeImage_write(&image, nodeInfo, &digest[0], definitionLen));
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(adt_bytearray_constData(&image), adt_bytearray_length(&image), &otherDigest[0], definitionLen, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_INVALID_FILE_ERROR, rc);
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(adt_bytearray_constData(&image), adt_bytearray_length(&image), &digest[0], definitionLen + 1u, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_INVALID_FILE_ERROR, rc);
+
+   apx_nodeInfo_release(nodeInfo);
+   adt_bytearray_destroy(&image);
+}
+
+static void test_apx_nodeImage_rejectsDamagedImage(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t definitionLen = (uint32_t) strlen(g_apx_test_node1);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(g_apx_test_node1, APX_CLIENT_MODE, &digest[0]);
+   adt_bytearray_t image;
+   apx_error_t rc = APX_NO_ERROR;
+   uint8_t *data;
+   uint32_t imageLen;
+   adt_bytearray_create(&image, ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeImage_write(&image, nodeInfo, &digest[0], definitionLen));
+   data = adt_bytearray_data(&image);
+   imageLen = adt_bytearray_length(&image);
+   //truncated
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(data, imageLen - 1u, &digest[0], definitionLen, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_INVALID_FILE_ERROR, rc);
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(data, APX_NODE_IMAGE_HEADER_SIZE - 1u, &digest[0], definitionLen, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_INVALID_FILE_ERROR, rc);
+   //flipped bit in the body
+   data[imageLen - 1u] ^= 0x01u;
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(data, imageLen, &digest[0], definitionLen, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_INVALID_FILE_ERROR, rc);
+   data[imageLen - 1u] ^= 0x01u;
+   //bad magic
+   data[0] = 'X';
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(data, imageLen, &digest[0], definitionLen, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_INVALID_FILE_ERROR, rc);
+
+   apx_nodeInfo_release(nodeInfo);
+   adt_bytearray_destroy(&image);
+}
+
+static void test_apx_nodeImage_rejectsUnsupportedVersion(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t definitionLen = (uint32_t) strlen(g_apx_test_node1);
+   apx_nodeInfo_t *nodeInfo = buildNodeInfo(g_apx_test_node1, APX_CLIENT_MODE, &digest[0]);
+   adt_bytearray_t image;
+   apx_error_t rc = APX_NO_ERROR;
+   adt_bytearray_create(&image, ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeImage_write(&image, nodeInfo, &digest[0], definitionLen));
+   packLE(adt_bytearray_data(&image) + 4, APX_NODE_IMAGE_VERSION + 1u, UINT16_SIZE);
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_read(adt_bytearray_constData(&image), adt_bytearray_length(&image), &digest[0], definitionLen, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_UNSUPPORTED_ERROR, rc);
+
+   apx_nodeInfo_release(nodeInfo);
+   adt_bytearray_destroy(&image);
+}
+
+static void test_apx_nodeImage_saveAndLoadFile(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   uint32_t definitionLen = (uint32_t) strlen(g_apx_test_node5);
+   apx_nodeInfo_t *expected = buildNodeInfo(g_apx_test_node5, APX_CLIENT_MODE, &digest[0]);
+   apx_nodeInfo_t *actual;
+   apx_error_t rc = APX_NO_ERROR;
+   char *path = apx_nodeImage_makeFilePath(TEST_IMAGE_DIRECTORY, &digest[0]);
+   CuAssertPtrNotNull(tc, path);
+   CuAssertIntEquals(tc, (int) (strlen(TEST_IMAGE_DIRECTORY) + 1u + 64u + strlen(APX_NODE_IMAGE_FILE_SUFFIX)), (int) strlen(path));
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeImage_saveFile(path, expected, &digest[0], definitionLen));
+   actual = apx_nodeImage_loadFile(path, &digest[0], definitionLen, APX_CLIENT_MODE, &rc);
+   CuAssertIntEquals(tc, APX_NO_ERROR, rc);
+   CuAssertPtrNotNull(tc, actual);
+   verifyNodeInfoEquals(tc, expected, actual);
+
+   remove(path);
+   free(path);
+   apx_nodeInfo_release(actual);
+   apx_nodeInfo_release(expected);
+}
+
+static void test_apx_nodeImage_loadMissingFile(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_error_t rc = APX_NO_ERROR;
+   memset(&digest[0], 0, sizeof(digest));
+   CuAssertPtrEquals(tc, NULL, apx_nodeImage_loadFile(TEST_IMAGE_DIRECTORY "/no_such_image.apxi", &digest[0], 0u, APX_CLIENT_MODE, &rc));
+   CuAssertIntEquals(tc, APX_FILE_NOT_FOUND_ERROR, rc);
+}
+
+static apx_nodeInfo_t *buildNodeInfo(const char *definition, apx_mode_t mode, uint8_t *digest)
+{
+   apx_nodeInfo_t *nodeInfo = apx_nodeInfo_make_from_cstr(definition, mode);
+   apx_sha256_calc((const uint8_t*) definition, strlen(definition), digest);
+   return nodeInfo;
+}
+
+static void verifyNodeInfoEquals(CuTest* tc, const apx_nodeInfo_t *expected, const apx_nodeInfo_t *actual)
+{
+   apx_portId_t portId;
+   CuAssertStrEquals(tc, apx_nodeInfo_getName(expected), apx_nodeInfo_getName(actual));
+   CuAssertIntEquals(tc, expected->mode, actual->mode);
+   CuAssertIntEquals(tc, apx_nodeInfo_getNumRequirePorts(expected), apx_nodeInfo_getNumRequirePorts(actual));
+   CuAssertIntEquals(tc, apx_nodeInfo_getNumProvidePorts(expected), apx_nodeInfo_getNumProvidePorts(actual));
+   CuAssertUIntEquals(tc, apx_nodeInfo_getRequirePortDataLen(expected), apx_nodeInfo_getRequirePortDataLen(actual));
+   CuAssertUIntEquals(tc, apx_nodeInfo_getProvidePortDataLen(expected), apx_nodeInfo_getProvidePortDataLen(actual));
+   for (portId = 0; portId < expected->numRequirePorts; portId++)
+   {
+      const apx_portDataProps_t *expectedProps = apx_nodeInfo_getRequirePortDataProps(expected, portId);
+      const apx_portDataProps_t *actualProps = apx_nodeInfo_getRequirePortDataProps(actual, portId);
+      CuAssertUIntEquals(tc, expectedProps->offset, actualProps->offset);
+      CuAssertUIntEquals(tc, expectedProps->dataSize, actualProps->dataSize);
+      CuAssertTrue(tc, adt_bytes_equals(apx_nodeInfo_getRequirePortPackProgram(expected, portId), apx_nodeInfo_getRequirePortPackProgram(actual, portId)));
+      CuAssertTrue(tc, adt_bytes_equals(apx_nodeInfo_getRequirePortUnpackProgram(expected, portId), apx_nodeInfo_getRequirePortUnpackProgram(actual, portId)));
+      CuAssertStrEquals(tc, apx_nodeInfo_getRequirePortSignature(expected, portId), apx_nodeInfo_getRequirePortSignature(actual, portId));
+   }
+   for (portId = 0; portId < expected->numProvidePorts; portId++)
+   {
+      const apx_portDataProps_t *expectedProps = apx_nodeInfo_getProvidePortDataProps(expected, portId);
+      const apx_portDataProps_t *actualProps = apx_nodeInfo_getProvidePortDataProps(actual, portId);
+      CuAssertUIntEquals(tc, expectedProps->offset, actualProps->offset);
+      CuAssertUIntEquals(tc, expectedProps->dataSize, actualProps->dataSize);
+      CuAssertTrue(tc, adt_bytes_equals(apx_nodeInfo_getProvidePortPackProgram(expected, portId), apx_nodeInfo_getProvidePortPackProgram(actual, portId)));
+      CuAssertTrue(tc, adt_bytes_equals(apx_nodeInfo_getProvidePortUnpackProgram(expected, portId), apx_nodeInfo_getProvidePortUnpackProgram(actual, portId)));
+      CuAssertStrEquals(tc, apx_nodeInfo_getProvidePortSignature(expected, portId), apx_nodeInfo_getProvidePortSignature(actual, portId));
+   }
+   CuAssertUIntEquals(tc, apx_nodeInfo_getRequirePortInitDataSize(expected), apx_nodeInfo_getRequirePortInitDataSize(actual));
+   CuAssertUIntEquals(tc, apx_nodeInfo_getProvidePortInitDataSize(expected), apx_nodeInfo_getProvidePortInitDataSize(actual));
+   if (apx_nodeInfo_getRequirePortInitDataSize(expected) > 0u)
+   {
+      CuAssertTrue(tc, memcmp(apx_nodeInfo_getRequirePortInitDataPtr(expected), apx_nodeInfo_getRequirePortInitDataPtr(actual), apx_nodeInfo_getRequirePortInitDataSize(expected)) == 0);
+   }
+   if (apx_nodeInfo_getProvidePortInitDataSize(expected) > 0u)
+   {
+      CuAssertTrue(tc, memcmp(apx_nodeInfo_getProvidePortInitDataPtr(expected), apx_nodeInfo_getProvidePortInitDataPtr(actual), apx_nodeInfo_getProvidePortInitDataSize(expected)) == 0);
+   }
+}
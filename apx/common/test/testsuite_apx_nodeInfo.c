@@ -54,6 +54,8 @@ static void test_apx_nodeInfo_buildDerivedPortSignatures1(CuTest *tc);
 static void test_apx_nodeInfo_getClientPortNamesFromSignatures(CuTest *tc);
 static void test_apx_nodeInfo_getRequirePortName(CuTest *tc);
 static void test_apx_nodeInfo_getProvidePortName(CuTest *tc);
+static void test_apx_nodeInfo_portOpTablesInClientMode(CuTest *tc);
+static void test_apx_nodeInfo_noPortOpTablesInServerMode(CuTest *tc);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -77,6 +79,8 @@ CuSuite* testSuite_apx_nodeInfo(void)
    SUITE_ADD_TEST(suite, test_apx_nodeInfo_getClientPortNamesFromSignatures);
    SUITE_ADD_TEST(suite, test_apx_nodeInfo_getRequirePortName);
    SUITE_ADD_TEST(suite, test_apx_nodeInfo_getProvidePortName);
+   SUITE_ADD_TEST(suite, test_apx_nodeInfo_portOpTablesInClientMode);
+   SUITE_ADD_TEST(suite, test_apx_nodeInfo_noPortOpTablesInServerMode);
 
    return suite;
 }
@@ -257,3 +261,35 @@ static void test_apx_nodeInfo_getProvidePortName(CuTest *tc)
 
    apx_nodeInfo_delete(nodeInfo);
 }
+
+static void test_apx_nodeInfo_portOpTablesInClientMode(CuTest *tc)
+{
+   const char *apx_node1 = "APX/1.2\n"
+   "N\"Node\"\n"
+   "P\"VehicleSpeed\"S\n"
+   "P\"DriverName\"a[8]\n"
+   "R\"GearSelectionMode\"C(0,7)\n";
+   const apx_vmOpTable_t *opTable;
+
+   apx_nodeInfo_t *nodeInfo = apx_nodeInfo_make_from_cstr(apx_node1, APX_CLIENT_MODE);
+   CuAssertPtrNotNull(tc, nodeInfo);
+   opTable = apx_nodeInfo_getProvidePortPackOpTable(nodeInfo, 0);
+   CuAssertPtrNotNull(tc, opTable);
+   CuAssertIntEquals(tc, 1, opTable->numOps);
+   CuAssertUIntEquals(tc, 2u, opTable->dataSize);
+   CuAssertPtrEquals(tc, 0, (void*) apx_nodeInfo_getProvidePortPackOpTable(nodeInfo, 1));
+   CuAssertPtrEquals(tc, 0, (void*) apx_nodeInfo_getProvidePortPackOpTable(nodeInfo, 2));
+   opTable = apx_nodeInfo_getRequirePortUnpackOpTable(nodeInfo, 0);
+   CuAssertPtrNotNull(tc, opTable);
+   CuAssertUIntEquals(tc, 1u, opTable->dataSize);
+   apx_nodeInfo_delete(nodeInfo);
+}
+
+static void test_apx_nodeInfo_noPortOpTablesInServerMode(CuTest *tc)
+{
+   apx_nodeInfo_t *nodeInfo = apx_nodeInfo_make_from_cstr(g_apx_test_node1, APX_SERVER_MODE);
+   CuAssertPtrNotNull(tc, nodeInfo);
+   CuAssertPtrEquals(tc, 0, (void*) apx_nodeInfo_getProvidePortPackOpTable(nodeInfo, 0));
+   CuAssertPtrEquals(tc, 0, (void*) apx_nodeInfo_getRequirePortUnpackOpTable(nodeInfo, 0));
+   apx_nodeInfo_delete(nodeInfo);
+}
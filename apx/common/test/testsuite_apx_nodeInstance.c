@@ -50,6 +50,7 @@ static void test_apx_nodeInstance_manuallyCreateClientNodeUsingAPI(CuTest *tc);
 static void test_apx_nodeInstance_manuallyCreateServerNodeUsingAPI(CuTest *tc);
 static void test_apx_nodeInstance_buildPortReferences(CuTest *tc);
 static void test_apx_nodeInstance_buildConnectorTable(CuTest *tc);
+static void test_apx_nodeInstance_unlockPublishesRoutingPlan(CuTest *tc);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -66,6 +67,7 @@ CuSuite* testSuite_apx_nodeInstance(void)
    SUITE_ADD_TEST(suite, test_apx_nodeInstance_manuallyCreateServerNodeUsingAPI);
    SUITE_ADD_TEST(suite, test_apx_nodeInstance_buildPortReferences);
    SUITE_ADD_TEST(suite, test_apx_nodeInstance_buildConnectorTable);
+   SUITE_ADD_TEST(suite, test_apx_nodeInstance_unlockPublishesRoutingPlan);
 
    return suite;
 }
@@ -202,3 +204,48 @@ static void test_apx_nodeInstance_buildConnectorTable(CuTest *tc)
    apx_nodeInstance_delete(inst);
 
 }
+
+static void test_apx_nodeInstance_unlockPublishesRoutingPlan(CuTest *tc)
+{
+   apx_nodeInstance_t *inst;
+   apx_programType_t errProgramType;
+   apx_uniquePortId_t errPortId;
+   apx_portRef_t *requirePortRef;
+   apx_routingPlan_t *firstPlan;
+   apx_parser_t *parser = apx_parser_new();
+   apx_size_t apx_len = (apx_size_t) strlen(g_apx_test_node1);
+
+   inst = apx_nodeInstance_new(APX_SERVER_MODE);
+   CuAssertPtrNotNull(tc, inst);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_createDefinitionBuffer(inst, apx_len));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_writeDefinitionData(inst, (const uint8_t*) g_apx_test_node1, 0u, apx_len));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_parseDefinition(inst, parser));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_buildNodeInfo(inst, &errProgramType, &errPortId));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_buildPortRefs(inst));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_buildConnectorTable(inst));
+   requirePortRef = apx_nodeInstance_getRequirePortRef(inst, 0);
+   CuAssertPtrNotNull(tc, requirePortRef);
+   CuAssertPtrEquals(tc, NULL, inst->routingPlan);
+
+   //CabTiltLockWarning -> GearSelectionMode, both are one byte
+   apx_nodeInstance_lockPortConnectorTable(inst);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_insertProvidePortConnector(inst, 1, requirePortRef));
+   CuAssertPtrEquals(tc, NULL, inst->routingPlan);
+   apx_nodeInstance_unlockPortConnectorTable(inst);
+   firstPlan = inst->routingPlan;
+   CuAssertPtrNotNull(tc, firstPlan);
+   CuAssertIntEquals(tc, 1, firstPlan->numRanges);
+   CuAssertIntEquals(tc, 1, firstPlan->numEntries);
+
+   apx_nodeInstance_lockPortConnectorTable(inst);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_removeProvidePortConnector(inst, 1, requirePortRef));
+   apx_nodeInstance_unlockPortConnectorTable(inst);
+   CuAssertPtrNotNull(tc, inst->routingPlan);
+   CuAssertTrue(tc, inst->routingPlan != firstPlan);
+   CuAssertIntEquals(tc, 0, inst->routingPlan->numRanges);
+   apx_nodeInstance_synchronizeRouting(inst);
+   CuAssertUIntEquals(tc, 0u, apx_epoch_getNumRetired(&inst->routingEpoch));
+
+   apx_parser_delete(parser);
+   apx_nodeInstance_delete(inst);
+}
@@ -31,6 +31,7 @@
 #include <string.h>
 #include "CuTest.h"
 #include "apx_nodeManager.h"
+#include "apx_definitionCache.h"
 #include "apx_test_nodes.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
@@ -56,6 +57,9 @@ static void test_apx_nodeManager_createNode(CuTest *tc);
 static void test_apx_nodeManager_buildNode(CuTest *tc);
 static void test_apx_nodeManager_copyNodeReference(CuTest *tc);
 static void test_apx_nodeManager_copyMultipleNodeReference(CuTest *tc);
+static void test_apx_nodeManager_identicalNodesShareNodeInfo(CuTest *tc);
+static void test_apx_nodeManager_differentNodesDoNotShareNodeInfo(CuTest *tc);
+static void test_apx_nodeManager_sharedNodeInfoOutlivesCache(CuTest *tc);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -72,6 +76,9 @@ CuSuite* testSuite_apx_nodeManager(void)
    SUITE_ADD_TEST(suite, test_apx_nodeManager_buildNode);
    SUITE_ADD_TEST(suite, test_apx_nodeManager_copyNodeReference);
    SUITE_ADD_TEST(suite, test_apx_nodeManager_copyMultipleNodeReference);
+   SUITE_ADD_TEST(suite, test_apx_nodeManager_identicalNodesShareNodeInfo);
+   SUITE_ADD_TEST(suite, test_apx_nodeManager_differentNodesDoNotShareNodeInfo);
+   SUITE_ADD_TEST(suite, test_apx_nodeManager_sharedNodeInfoOutlivesCache);
 
    return suite;
 }
@@ -140,3 +147,85 @@ static void test_apx_nodeManager_copyMultipleNodeReference(CuTest *tc)
    apx_nodeManager_delete(manager2);
 }
 
+static void test_apx_nodeManager_identicalNodesShareNodeInfo(CuTest *tc)
+{
+   apx_definitionCache_t cache;
+   apx_definitionCacheStats_t stats;
+   apx_nodeManager_t *manager1 = apx_nodeManager_new(APX_CLIENT_MODE, false);
+   apx_nodeManager_t *manager2 = apx_nodeManager_new(APX_CLIENT_MODE, false);
+   apx_nodeInstance_t *node1;
+   apx_nodeInstance_t *node2;
+   apx_nodeInfo_t *nodeInfo;
+
+   apx_definitionCache_create(&cache, 4u);
+   apx_nodeManager_setDefinitionCache(manager1, &cache);
+   apx_nodeManager_setDefinitionCache(manager2, &cache);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(manager1, m_apx_definition1));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(manager2, m_apx_definition1));
+   node1 = apx_nodeManager_getLastAttached(manager1);
+   node2 = apx_nodeManager_getLastAttached(manager2);
+   CuAssertPtrNotNull(tc, node1);
+   CuAssertPtrNotNull(tc, node2);
+   CuAssertTrue(tc, node1 != node2);
+   nodeInfo = apx_nodeInstance_getNodeInfo(node1);
+   CuAssertPtrEquals(tc, nodeInfo, apx_nodeInstance_getNodeInfo(node2));
+   CuAssertUIntEquals(tc, 3u, nodeInfo->refCount); //two node instances and the cache
+   CuAssertTrue(tc, apx_nodeInstance_getNodeData(node1) != apx_nodeInstance_getNodeData(node2));
+   CuAssertPtrEquals(tc, node2, apx_nodeInstance_getProvidePortRef(node2, 0)->nodeInstance);
+   CuAssertPtrEquals(tc, (void*) apx_nodeInstance_getProvidePortRef(node1, 0)->portDataProps, (void*) apx_nodeInstance_getProvidePortRef(node2, 0)->portDataProps);
+   CuAssertStrEquals(tc, "TestNode1", apx_nodeInstance_getName(node2));
+   apx_definitionCache_getStats(&cache, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numEntries);
+   CuAssertUIntEquals(tc, 1u, stats.numHits);
+   CuAssertUIntEquals(tc, 1u, stats.numMisses);
+
+   apx_nodeManager_delete(manager1);
+   CuAssertUIntEquals(tc, 2u, nodeInfo->refCount);
+   apx_nodeManager_delete(manager2);
+   apx_definitionCache_destroy(&cache);
+}
+
+static void test_apx_nodeManager_differentNodesDoNotShareNodeInfo(CuTest *tc)
+{
+   apx_definitionCache_t cache;
+   apx_definitionCacheStats_t stats;
+   apx_nodeManager_t *manager = apx_nodeManager_new(APX_CLIENT_MODE, false);
+   apx_nodeInstance_t *node1;
+   apx_nodeInstance_t *node2;
+
+   apx_definitionCache_create(&cache, 4u);
+   apx_nodeManager_setDefinitionCache(manager, &cache);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(manager, m_apx_definition1));
+   node1 = apx_nodeManager_getLastAttached(manager);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(manager, m_apx_definition2));
+   node2 = apx_nodeManager_getLastAttached(manager);
+   CuAssertTrue(tc, apx_nodeInstance_getNodeInfo(node1) != apx_nodeInstance_getNodeInfo(node2));
+   apx_definitionCache_getStats(&cache, &stats);
+   CuAssertUIntEquals(tc, 2u, stats.numEntries);
+   CuAssertUIntEquals(tc, 0u, stats.numHits);
+
+   apx_nodeManager_delete(manager);
+   apx_definitionCache_destroy(&cache);
+}
+
+static void test_apx_nodeManager_sharedNodeInfoOutlivesCache(CuTest *tc)
+{
+   apx_definitionCache_t cache;
+   apx_nodeManager_t *manager1 = apx_nodeManager_new(APX_CLIENT_MODE, false);
+   apx_nodeManager_t *manager2 = apx_nodeManager_new(APX_CLIENT_MODE, false);
+   apx_nodeInfo_t *nodeInfo;
+
+   apx_definitionCache_create(&cache, 4u);
+   apx_nodeManager_setDefinitionCache(manager1, &cache);
+   apx_nodeManager_setDefinitionCache(manager2, &cache);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(manager1, m_apx_definition1));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(manager2, m_apx_definition1));
+   apx_nodeManager_setDefinitionCache(manager1, (apx_definitionCache_t*) 0);
+   apx_nodeManager_setDefinitionCache(manager2, (apx_definitionCache_t*) 0);
+   apx_definitionCache_destroy(&cache);
+   nodeInfo = apx_nodeInstance_getNodeInfo(apx_nodeManager_getLastAttached(manager1));
+   CuAssertUIntEquals(tc, 2u, nodeInfo->refCount);
+   apx_nodeManager_delete(manager1);
+   CuAssertStrEquals(tc, "TestNode1", apx_nodeInstance_getName(apx_nodeManager_getLastAttached(manager2)));
+   apx_nodeManager_delete(manager2);
+}
@@ -29,6 +29,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include <malloc.h>
 #include "CuTest.h"
 #include "apx_portSignatureMap.h"
 #include "apx_nodeManager.h"
@@ -55,6 +56,13 @@ static const char *m_node_text3 =
       "N\"Provider1\"\n"
       "P\"VehicleSpeed\"S:=65535\n";
 
+static const char *m_node_text4 =
+      "APX/1.2\n"
+      "N\"Provider2\"\n"
+      "P\"VehicleSpeed\"S:=65535\n"
+      "P\"EngineSpeed\"S:=65535\n"
+      "P\"FuelLevel\"C\n";
+
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTION PROTOTYPES
@@ -65,6 +73,9 @@ static void test_apx_portSignatureMap_connectingRequrePortWhenProvidePortsIsAvai
 static void test_apx_portSignatureMap_disconnectingRequirePortWhenConnectedToProvidePort(CuTest* tc);
 static void test_apx_portSignatureMap_disconnectingProvidePortWhenConnectedToRequireProvidePort(CuTest* tc);
 static void test_apx_portSignatureMap_disconnectingProvidePortWhenNotConnectedToAnything(CuTest* tc);
+static void test_apx_portSignatureMap_nodeStripeMask(CuTest* tc);
+static void test_apx_portSignatureMap_affectedStripesIncludeConnectedNodes(CuTest* tc);
+static void test_apx_portSignatureMap_connectAndDisconnectManySignatures(CuTest* tc);
 
 
 
@@ -85,6 +96,9 @@ CuSuite* testSuite_apx_portSignatureMap(void)
    SUITE_ADD_TEST(suite, test_apx_portSignatureMap_disconnectingRequirePortWhenConnectedToProvidePort);
    SUITE_ADD_TEST(suite, test_apx_portSignatureMap_disconnectingProvidePortWhenConnectedToRequireProvidePort);
    SUITE_ADD_TEST(suite, test_apx_portSignatureMap_disconnectingProvidePortWhenNotConnectedToAnything);
+   SUITE_ADD_TEST(suite, test_apx_portSignatureMap_nodeStripeMask);
+   SUITE_ADD_TEST(suite, test_apx_portSignatureMap_affectedStripesIncludeConnectedNodes);
+   SUITE_ADD_TEST(suite, test_apx_portSignatureMap_connectAndDisconnectManySignatures);
 
 
    return suite;
@@ -469,3 +483,117 @@ static void test_apx_portSignatureMap_disconnectingProvidePortWhenNotConnectedTo
    apx_portSignatureMap_delete(map);
    apx_nodeManager_delete(nodeManager);
 }
+
+static void test_apx_portSignatureMap_nodeStripeMask(CuTest* tc)
+{
+   apx_nodeManager_t *nodeManager;
+   apx_nodeInstance_t *nodeInstance;
+   apx_nodeInfo_t *nodeInfo;
+   uint32_t expected;
+
+   nodeManager = apx_nodeManager_new(APX_SERVER_MODE, false);
+   CuAssertPtrNotNull(tc, nodeManager);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(nodeManager, m_node_text4));
+   nodeInstance = apx_nodeManager_getLastAttached(nodeManager);
+   CuAssertPtrNotNull(tc, nodeInstance);
+   nodeInfo = apx_nodeInstance_getNodeInfo(nodeInstance);
+
+   CuAssertTrue(tc, apx_portSignatureMap_getStripeIndex(apx_nodeInfo_getProvidePortSignatureId(nodeInfo, 0)) < APX_PORT_SIGNATURE_MAP_NUM_STRIPES);
+   expected = (1u << apx_portSignatureMap_getStripeIndex(apx_nodeInfo_getProvidePortSignatureId(nodeInfo, 0))) |
+              (1u << apx_portSignatureMap_getStripeIndex(apx_nodeInfo_getProvidePortSignatureId(nodeInfo, 1))) |
+              (1u << apx_portSignatureMap_getStripeIndex(apx_nodeInfo_getProvidePortSignatureId(nodeInfo, 2)));
+   CuAssertUIntEquals(tc, expected, apx_portSignatureMap_calcStripeMask(nodeInfo));
+   CuAssertUIntEquals(tc, expected, apx_nodeInstance_getPortSignatureStripes(nodeInstance));
+
+   apx_nodeManager_delete(nodeManager);
+}
+
+static void test_apx_portSignatureMap_affectedStripesIncludeConnectedNodes(CuTest* tc)
+{
+   apx_nodeManager_t *nodeManager;
+   apx_nodeInstance_t *requireNodeInstance;
+   apx_nodeInstance_t *provideNodeInstance;
+   apx_portSignatureMap_t *map;
+   uint32_t requireStripes;
+   uint32_t provideStripes;
+
+   nodeManager = apx_nodeManager_new(APX_SERVER_MODE, false);
+   CuAssertPtrNotNull(tc, nodeManager);
+   map = apx_portSignatureMap_new();
+   CuAssertPtrNotNull(tc, map);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(nodeManager, m_node_text1));
+   requireNodeInstance = apx_nodeManager_getLastAttached(nodeManager);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(nodeManager, m_node_text4));
+   provideNodeInstance = apx_nodeManager_getLastAttached(nodeManager);
+   requireStripes = apx_nodeInstance_getPortSignatureStripes(requireNodeInstance);
+   provideStripes = apx_nodeInstance_getPortSignatureStripes(provideNodeInstance);
+
+   apx_portSignatureMap_lockStripes(map, APX_PORT_SIGNATURE_MAP_ALL_STRIPES);
+   //Before Provider2 is connected the requester only depends on its own stripes
+   CuAssertUIntEquals(tc, requireStripes, apx_portSignatureMap_calcAffectedStripes(map, requireNodeInstance));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portSignatureMap_connectRequirePorts(map, requireNodeInstance));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portSignatureMap_connectProvidePorts(map, provideNodeInstance));
+   //Provider2 shares VehicleSpeed with the requester, all stripes used by Provider2 are now affected
+   CuAssertUIntEquals(tc, requireStripes | provideStripes, apx_portSignatureMap_calcAffectedStripes(map, requireNodeInstance));
+   CuAssertUIntEquals(tc, requireStripes | provideStripes, apx_portSignatureMap_calcAffectedStripes(map, provideNodeInstance));
+   apx_nodeInstance_clearRequirePortConnectorChanges(requireNodeInstance, true);
+   apx_nodeInstance_clearProvidePortConnectorChanges(provideNodeInstance, true);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portSignatureMap_disconnectProvidePorts(map, provideNodeInstance));
+   CuAssertUIntEquals(tc, requireStripes, apx_portSignatureMap_calcAffectedStripes(map, requireNodeInstance));
+   apx_nodeInstance_clearRequirePortConnectorChanges(requireNodeInstance, true);
+   apx_nodeInstance_clearProvidePortConnectorChanges(provideNodeInstance, true);
+   apx_portSignatureMap_unlockStripes(map, APX_PORT_SIGNATURE_MAP_ALL_STRIPES);
+
+   apx_portSignatureMap_delete(map);
+   apx_nodeManager_delete(nodeManager);
+}
+
+static void test_apx_portSignatureMap_connectAndDisconnectManySignatures(CuTest* tc)
+{
+   const int32_t numPorts = 500;
+   apx_nodeManager_t *nodeManager;
+   apx_nodeInstance_t *nodeInstance;
+   apx_nodeInfo_t *nodeInfo;
+   apx_portSignatureMap_t *map;
+   char *definition;
+   char *p;
+   int32_t i;
+
+   definition = (char*) malloc(numPorts * 32 + 32);
+   CuAssertPtrNotNull(tc, definition);
+   p = definition;
+   p += sprintf(p, "APX/1.2\nN\"Provider\"\n");
+   for (i = 0; i < numPorts; i++)
+   {
+      p += sprintf(p, "P\"Signal%d\"C\n", (int) i);
+   }
+   nodeManager = apx_nodeManager_new(APX_SERVER_MODE, false);
+   CuAssertPtrNotNull(tc, nodeManager);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeManager_buildNode_cstr(nodeManager, definition));
+   free(definition);
+   nodeInstance = apx_nodeManager_getLastAttached(nodeManager);
+   CuAssertPtrNotNull(tc, nodeInstance);
+   nodeInfo = apx_nodeInstance_getNodeInfo(nodeInstance);
+   map = apx_portSignatureMap_new();
+   CuAssertPtrNotNull(tc, map);
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portSignatureMap_connectProvidePorts(map, nodeInstance));
+   CuAssertIntEquals(tc, numPorts, apx_portSignatureMap_length(map));
+   for (i = 0; i < numPorts; i++)
+   {
+      apx_signatureId_t signatureId = apx_nodeInfo_getProvidePortSignatureId(nodeInfo, (apx_portId_t) i);
+      CuAssertTrue(tc, signatureId != APX_INVALID_SIGNATURE_ID);
+      CuAssertPtrNotNull(tc, apx_portSignatureMap_findById(map, signatureId));
+      CuAssertPtrEquals(tc, apx_portSignatureMap_findById(map, signatureId), apx_portSignatureMap_find(map, apx_nodeInfo_getProvidePortSignature(nodeInfo, (apx_portId_t) i)));
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_portSignatureMap_disconnectProvidePorts(map, nodeInstance));
+   CuAssertIntEquals(tc, 0, apx_portSignatureMap_length(map));
+   for (i = 0; i < numPorts; i++)
+   {
+      CuAssertPtrEquals(tc, NULL, apx_portSignatureMap_findById(map, apx_nodeInfo_getProvidePortSignatureId(nodeInfo, (apx_portId_t) i)));
+   }
+
+   apx_portSignatureMap_delete(map);
+   apx_nodeManager_delete(nodeManager);
+}
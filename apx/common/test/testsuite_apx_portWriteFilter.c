@@ -0,0 +1,133 @@
+/*****************************************************************************
+* \file      testsuite_apx_portWriteFilter.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_portWriteFilter
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include "CuTest.h"
+#include "apx_portWriteFilter.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_portWriteFilter_create(CuTest* tc);
+static void test_apx_portWriteFilter_alwaysMode(CuTest* tc);
+static void test_apx_portWriteFilter_onChangeMode(CuTest* tc);
+static void test_apx_portWriteFilter_heartbeat(CuTest* tc);
+static void test_apx_portWriteFilter_heartbeatAfterTickWrapAround(CuTest* tc);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_portWriteFilter(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_portWriteFilter_create);
+   SUITE_ADD_TEST(suite, test_apx_portWriteFilter_alwaysMode);
+   SUITE_ADD_TEST(suite, test_apx_portWriteFilter_onChangeMode);
+   SUITE_ADD_TEST(suite, test_apx_portWriteFilter_heartbeat);
+   SUITE_ADD_TEST(suite, test_apx_portWriteFilter_heartbeatAfterTickWrapAround);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_portWriteFilter_create(CuTest* tc)
+{
+   apx_portWriteFilter_t filter;
+   apx_portWriteFilter_create(&filter);
+   CuAssertUIntEquals(tc, APX_PORT_WRITE_MODE_ALWAYS, filter.mode);
+   CuAssertUIntEquals(tc, 0u, filter.heartbeatInterval);
+   CuAssertUIntEquals(tc, 0u, filter.numSuppressedWrites);
+   CuAssertUIntEquals(tc, 0u, filter.numHeartbeatWrites);
+}
+
+static void test_apx_portWriteFilter_alwaysMode(CuTest* tc)
+{
+   apx_portWriteFilter_t filter;
+   apx_portWriteFilter_create(&filter);
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, false, 0u));
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, true, 1u));
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, false, 2u));
+   CuAssertUIntEquals(tc, 0u, filter.numSuppressedWrites);
+}
+
+static void test_apx_portWriteFilter_onChangeMode(CuTest* tc)
+{
+   apx_portWriteFilter_t filter;
+   apx_portWriteFilter_create(&filter);
+   apx_portWriteFilter_setMode(&filter, APX_PORT_WRITE_MODE_ON_CHANGE, 0u, 0u);
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 10u));
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, true, 20u));
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 100000u));
+   CuAssertUIntEquals(tc, 2u, filter.numSuppressedWrites);
+   CuAssertUIntEquals(tc, 0u, filter.numHeartbeatWrites);
+   apx_portWriteFilter_setMode(&filter, APX_PORT_WRITE_MODE_ALWAYS, 0u, 0u);
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, false, 100001u));
+   CuAssertUIntEquals(tc, 2u, filter.numSuppressedWrites);
+}
+
+static void test_apx_portWriteFilter_heartbeat(CuTest* tc)
+{
+   apx_portWriteFilter_t filter;
+   apx_portWriteFilter_create(&filter);
+   apx_portWriteFilter_setMode(&filter, APX_PORT_WRITE_MODE_ON_CHANGE, 100u, 1000u);
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 1050u));
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 1099u));
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, false, 1100u));
+   CuAssertUIntEquals(tc, 1u, filter.numHeartbeatWrites);
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 1150u));
+   //A changed value restarts the heartbeat period
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, true, 1180u));
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 1250u));
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, false, 1280u));
+   CuAssertUIntEquals(tc, 2u, filter.numHeartbeatWrites);
+   CuAssertUIntEquals(tc, 4u, filter.numSuppressedWrites);
+}
+
+static void test_apx_portWriteFilter_heartbeatAfterTickWrapAround(CuTest* tc)
+{
+   apx_portWriteFilter_t filter;
+   apx_portWriteFilter_create(&filter);
+   apx_portWriteFilter_setMode(&filter, APX_PORT_WRITE_MODE_ON_CHANGE, 100u, 0xFFFFFFC0u);
+   CuAssertTrue(tc, !apx_portWriteFilter_update(&filter, false, 0x10u));
+   CuAssertTrue(tc, apx_portWriteFilter_update(&filter, false, 0x24u));
+}
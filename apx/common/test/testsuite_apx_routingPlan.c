@@ -0,0 +1,202 @@
+/*****************************************************************************
+* \file      testsuite_apx_routingPlan.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_routingPlan
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "CuTest.h"
+#include <stdio.h>
+#include "apx_routingPlan.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_PROVIDE_PORTS 3
+#define NUM_REQUIRE_PORTS 3
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_routingPlan_create(CuTest *tc);
+static void test_apx_routingPlan_buildSkipsUnconnectedPorts(CuTest *tc);
+static void test_apx_routingPlan_findFirstRange(CuTest *tc);
+static void test_apx_routingPlan_rebuildAfterConnectorChange(CuTest *tc);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static int m_dummyNode1; //only the address is used
+static int m_dummyNode2; //only the address is used
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_routingPlan(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_routingPlan_create);
+   SUITE_ADD_TEST(suite, test_apx_routingPlan_buildSkipsUnconnectedPorts);
+   SUITE_ADD_TEST(suite, test_apx_routingPlan_findFirstRange);
+   SUITE_ADD_TEST(suite, test_apx_routingPlan_rebuildAfterConnectorChange);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Provide ports: P0 (offset 0, size 2), P1 (offset 2, size 1), P2 (offset 3, size 4)
+ * Require ports: R0 (node1, offset 0, size 2), R1 (node2, offset 4, size 2), R2 (node2, offset 0, size 4)
+ * Connectors: P0 -> R0, P0 -> R1, P2 -> R2
+ */
+typedef struct routingPlanFixture_tag
+{
+   apx_portDataProps_t provideProps[NUM_PROVIDE_PORTS];
+   apx_portDataProps_t requireProps[NUM_REQUIRE_PORTS];
+   apx_portRef_t provideRefs[NUM_PROVIDE_PORTS];
+   apx_portRef_t requireRefs[NUM_REQUIRE_PORTS];
+   apx_portConnectorList_t connectorTable[NUM_PROVIDE_PORTS];
+} routingPlanFixture_t;
+
+static void routingPlanFixture_create(routingPlanFixture_t *self)
+{
+   int32_t i;
+   struct apx_nodeInstance_tag *node1 = (struct apx_nodeInstance_tag*) &m_dummyNode1;
+   struct apx_nodeInstance_tag *node2 = (struct apx_nodeInstance_tag*) &m_dummyNode2;
+   apx_portDataProps_create(&self->provideProps[0], APX_PROVIDE_PORT, 0, 0, 2);
+   apx_portDataProps_create(&self->provideProps[1], APX_PROVIDE_PORT, 1, 2, 1);
+   apx_portDataProps_create(&self->provideProps[2], APX_PROVIDE_PORT, 2, 3, 4);
+   apx_portDataProps_create(&self->requireProps[0], APX_REQUIRE_PORT, 0, 0, 2);
+   apx_portDataProps_create(&self->requireProps[1], APX_REQUIRE_PORT, 1, 4, 2);
+   apx_portDataProps_create(&self->requireProps[2], APX_REQUIRE_PORT, 0, 0, 4);
+   for (i = 0; i < NUM_PROVIDE_PORTS; i++)
+   {
+      apx_portRef_create(&self->provideRefs[i], node1, i | APX_PORT_ID_PROVIDE_PORT, &self->provideProps[i]);
+      apx_portConnectorList_create(&self->connectorTable[i]);
+   }
+   apx_portRef_create(&self->requireRefs[0], node1, 0, &self->requireProps[0]);
+   apx_portRef_create(&self->requireRefs[1], node2, 1, &self->requireProps[1]);
+   apx_portRef_create(&self->requireRefs[2], node2, 0, &self->requireProps[2]);
+   apx_portConnectorList_insert(&self->connectorTable[0], &self->requireRefs[0]);
+   apx_portConnectorList_insert(&self->connectorTable[0], &self->requireRefs[1]);
+   apx_portConnectorList_insert(&self->connectorTable[2], &self->requireRefs[2]);
+}
+
+static void routingPlanFixture_destroy(routingPlanFixture_t *self)
+{
+   int32_t i;
+   for (i = 0; i < NUM_PROVIDE_PORTS; i++)
+   {
+      apx_portConnectorList_destroy(&self->connectorTable[i]);
+   }
+}
+
+static void test_apx_routingPlan_create(CuTest *tc)
+{
+   apx_routingPlan_t plan;
+   apx_routingPlan_create(&plan);
+   CuAssertIntEquals(tc, 0, plan.numRanges);
+   CuAssertIntEquals(tc, 0, plan.numEntries);
+   CuAssertTrue(tc, apx_routingPlan_findFirstRange(&plan, 0u) == apx_routingPlan_rangeEnd(&plan));
+   apx_routingPlan_destroy(&plan);
+}
+
+static void test_apx_routingPlan_buildSkipsUnconnectedPorts(CuTest *tc)
+{
+   apx_routingPlan_t plan;
+   routingPlanFixture_t fixture;
+   const apx_routingPlanEntry_t *entry;
+   routingPlanFixture_create(&fixture);
+   apx_routingPlan_create(&plan);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_routingPlan_build(&plan, &fixture.provideRefs[0], &fixture.connectorTable[0], NUM_PROVIDE_PORTS));
+   CuAssertIntEquals(tc, 2, plan.numRanges);
+   CuAssertIntEquals(tc, 3, plan.numEntries);
+   CuAssertUIntEquals(tc, 0, plan.ranges[0].offset);
+   CuAssertUIntEquals(tc, 2, plan.ranges[0].dataSize);
+   CuAssertIntEquals(tc, 0, plan.ranges[0].beginEntry);
+   CuAssertIntEquals(tc, 2, plan.ranges[0].endEntry);
+   CuAssertUIntEquals(tc, 3, plan.ranges[1].offset);
+   CuAssertUIntEquals(tc, 4, plan.ranges[1].dataSize);
+   CuAssertIntEquals(tc, 2, plan.ranges[1].beginEntry);
+   CuAssertIntEquals(tc, 3, plan.ranges[1].endEntry);
+   entry = apx_routingPlan_getEntry(&plan, 0);
+   CuAssertPtrEquals(tc, &m_dummyNode1, entry->destNodeInstance);
+   CuAssertUIntEquals(tc, 0, entry->destOffset);
+   entry = apx_routingPlan_getEntry(&plan, 1);
+   CuAssertPtrEquals(tc, &m_dummyNode2, entry->destNodeInstance);
+   CuAssertUIntEquals(tc, 4, entry->destOffset);
+   CuAssertUIntEquals(tc, 2, entry->dataSize);
+   entry = apx_routingPlan_getEntry(&plan, 2);
+   CuAssertPtrEquals(tc, &m_dummyNode2, entry->destNodeInstance);
+   CuAssertUIntEquals(tc, 0, entry->destOffset);
+   CuAssertUIntEquals(tc, 4, entry->dataSize);
+   CuAssertPtrEquals(tc, 0, (void*) apx_routingPlan_getEntry(&plan, 3));
+   apx_routingPlan_destroy(&plan);
+   routingPlanFixture_destroy(&fixture);
+}
+
+static void test_apx_routingPlan_findFirstRange(CuTest *tc)
+{
+   apx_routingPlan_t plan;
+   routingPlanFixture_t fixture;
+   routingPlanFixture_create(&fixture);
+   apx_routingPlan_create(&plan);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_routingPlan_build(&plan, &fixture.provideRefs[0], &fixture.connectorTable[0], NUM_PROVIDE_PORTS));
+   CuAssertPtrEquals(tc, &plan.ranges[0], (void*) apx_routingPlan_findFirstRange(&plan, 0u));
+   CuAssertPtrEquals(tc, &plan.ranges[0], (void*) apx_routingPlan_findFirstRange(&plan, 1u));
+   CuAssertPtrEquals(tc, &plan.ranges[1], (void*) apx_routingPlan_findFirstRange(&plan, 2u)); //P1 has no connectors
+   CuAssertPtrEquals(tc, &plan.ranges[1], (void*) apx_routingPlan_findFirstRange(&plan, 6u));
+   CuAssertPtrEquals(tc, (void*) apx_routingPlan_rangeEnd(&plan), (void*) apx_routingPlan_findFirstRange(&plan, 7u));
+   apx_routingPlan_destroy(&plan);
+   routingPlanFixture_destroy(&fixture);
+}
+
+static void test_apx_routingPlan_rebuildAfterConnectorChange(CuTest *tc)
+{
+   apx_routingPlan_t plan;
+   routingPlanFixture_t fixture;
+   routingPlanFixture_create(&fixture);
+   apx_routingPlan_create(&plan);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_routingPlan_build(&plan, &fixture.provideRefs[0], &fixture.connectorTable[0], NUM_PROVIDE_PORTS));
+   apx_portConnectorList_remove(&fixture.connectorTable[0], &fixture.requireRefs[0]);
+   apx_portConnectorList_remove(&fixture.connectorTable[0], &fixture.requireRefs[1]);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_routingPlan_build(&plan, &fixture.provideRefs[0], &fixture.connectorTable[0], NUM_PROVIDE_PORTS));
+   CuAssertIntEquals(tc, 1, plan.numRanges);
+   CuAssertIntEquals(tc, 1, plan.numEntries);
+   CuAssertUIntEquals(tc, 3, plan.ranges[0].offset);
+   apx_portConnectorList_remove(&fixture.connectorTable[2], &fixture.requireRefs[2]);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_routingPlan_build(&plan, &fixture.provideRefs[0], &fixture.connectorTable[0], NUM_PROVIDE_PORTS));
+   CuAssertIntEquals(tc, 0, plan.numRanges);
+   CuAssertIntEquals(tc, 0, plan.numEntries);
+   apx_routingPlan_destroy(&plan);
+   routingPlanFixture_destroy(&fixture);
+}
@@ -0,0 +1,137 @@
+/*****************************************************************************
+* \file      testsuite_apx_sha256.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_sha256
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_sha256.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_sha256_emptyString(CuTest* tc);
+static void test_apx_sha256_abc(CuTest* tc);
+static void test_apx_sha256_twoBlockMessage(CuTest* tc);
+static void test_apx_sha256_incrementalUpdate(CuTest* tc);
+static void test_apx_sha256_millionA(CuTest* tc);
+static void assertDigestEquals(CuTest* tc, const char *expectedHex, const uint8_t *digest);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+static const char *m_twoBlockMessage = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_sha256(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_sha256_emptyString);
+   SUITE_ADD_TEST(suite, test_apx_sha256_abc);
+   SUITE_ADD_TEST(suite, test_apx_sha256_twoBlockMessage);
+   SUITE_ADD_TEST(suite, test_apx_sha256_incrementalUpdate);
+   SUITE_ADD_TEST(suite, test_apx_sha256_millionA);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_sha256_emptyString(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_sha256_calc((const uint8_t*) "", 0u, &digest[0]);
+   assertDigestEquals(tc, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", &digest[0]);
+}
+
+static void test_apx_sha256_abc(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_sha256_calc((const uint8_t*) "abc", 3u, &digest[0]);
+   assertDigestEquals(tc, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", &digest[0]);
+}
+
+static void test_apx_sha256_twoBlockMessage(CuTest* tc)
+{
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_sha256_calc((const uint8_t*) m_twoBlockMessage, strlen(m_twoBlockMessage), &digest[0]);
+   assertDigestEquals(tc, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", &digest[0]);
+}
+
+static void test_apx_sha256_incrementalUpdate(CuTest* tc)
+{
+   apx_sha256_t ctx;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   size_t len = strlen(m_twoBlockMessage);
+   size_t i;
+   apx_sha256_init(&ctx);
+   for (i = 0u; i < len; i++)
+   {
+      apx_sha256_update(&ctx, (const uint8_t*) &m_twoBlockMessage[i], 1u);
+   }
+   apx_sha256_final(&ctx, &digest[0]);
+   assertDigestEquals(tc, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", &digest[0]);
+}
+
+static void test_apx_sha256_millionA(CuTest* tc)
+{
+   apx_sha256_t ctx;
+   uint8_t chunk[1000];
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   int i;
+   memset(&chunk[0], 'a', sizeof(chunk));
+   apx_sha256_init(&ctx);
+   for (i = 0; i < 1000; i++)
+   {
+      apx_sha256_update(&ctx, &chunk[0], sizeof(chunk));
+   }
+   apx_sha256_final(&ctx, &digest[0]);
+   assertDigestEquals(tc, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", &digest[0]);
+}
+
+static void assertDigestEquals(CuTest* tc, const char *expectedHex, const uint8_t *digest)
+{
+   char actualHex[APX_SHA256_DIGEST_SIZE * 2 + 1];
+   uint32_t i;
+   for (i = 0u; i < APX_SHA256_DIGEST_SIZE; i++)
+   {
+      sprintf(&actualHex[i * 2u], "%02x", digest[i]);
+   }
+   CuAssertStrEquals(tc, expectedHex, &actualHex[0]);
+}
@@ -0,0 +1,400 @@
+/*****************************************************************************
+* \file      testsuite_apx_shmChannel.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_shmChannel
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_shmChannel.h"
+#if APX_SHM_SUPPORTED
+#include <unistd.h>
+#include <sys/socket.h>
+#include "numheader.h"
+#include "rmf.h"
+#endif
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#if APX_SHM_SUPPORTED
+#define RECEIVE_BUFFER_SIZE 4096u
+
+typedef struct receiveSpy_tag
+{
+   uint8_t data[RECEIVE_BUFFER_SIZE];
+   uint32_t dataLen;
+   uint32_t numCalls;
+} receiveSpy_t;
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+#if APX_SHM_SUPPORTED
+static void test_apx_shmChannel_create(CuTest *tc);
+static void test_apx_shmChannel_portDataWriteUsesWindow(CuTest *tc);
+static void test_apx_shmChannel_commandIsSentInline(CuTest *tc);
+static void test_apx_shmChannel_windowDisabled(CuTest *tc);
+static void test_apx_shmChannel_windowKeepsLatestValue(CuTest *tc);
+static void test_apx_shmChannel_wrapAround(CuTest *tc);
+static void test_apx_shmChannel_handlesOverSocket(CuTest *tc);
+static void test_apx_shmChannel_waitAfterClose(CuTest *tc);
+static void test_apx_shmChannel_corruptHeadIsProtocolError(CuTest *tc);
+static void test_apx_shmChannel_corruptRecordLengthIsProtocolError(CuTest *tc);
+static void test_apx_shmChannel_stalledWindowIsRetriedAfterWait(CuTest *tc);
+static void attachPeer(CuTest *tc, apx_shmChannel_t *server, apx_shmChannel_t *client);
+static uint32_t packMessage(uint8_t *buf, uint32_t address, const uint8_t *data, uint32_t dataLen);
+static void receiveSpy_data(void *arg, const uint8_t *data, uint32_t dataLen);
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_shmChannel(void)
+{
+   CuSuite* suite = CuSuiteNew();
+#if APX_SHM_SUPPORTED
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_create);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_portDataWriteUsesWindow);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_commandIsSentInline);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_windowDisabled);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_windowKeepsLatestValue);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_wrapAround);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_handlesOverSocket);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_waitAfterClose);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_corruptHeadIsProtocolError);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_corruptRecordLengthIsProtocolError);
+   SUITE_ADD_TEST(suite, test_apx_shmChannel_stalledWindowIsRetriedAfterWait);
+#endif
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+#if APX_SHM_SUPPORTED
+static void test_apx_shmChannel_create(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   CuAssertUIntEquals(tc, APX_SHM_DIRECTION_SERVER_TO_CLIENT, server.txIndex);
+   CuAssertUIntEquals(tc, APX_SHM_DIRECTION_CLIENT_TO_SERVER, client.txIndex);
+   CuAssertPtrEquals(tc, server.tx, &server.region->direction[APX_SHM_DIRECTION_SERVER_TO_CLIENT]);
+   CuAssertTrue(tc, !apx_shmChannel_isClosed(&client));
+   apx_shmChannel_destroy(&client);
+   CuAssertTrue(tc, apx_shmChannel_isClosed(&server));
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_portDataWriteUsesWindow(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   apx_shmChannelStats_t stats;
+   receiveSpy_t spy;
+   uint8_t msg[32];
+   const uint8_t data[4] = {0x12, 0x34, 0x56, 0x78};
+   uint32_t msgLen = packMessage(&msg[0], 0x400u, &data[0], (uint32_t) sizeof(data));
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&server, &msg[0], msgLen));
+   apx_shmChannel_getStats(&server, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numWindowWrites);
+   CuAssertUIntEquals(tc, 0u, stats.numInlineWrites);
+   CuAssertIntEquals(tc, 0, memcmp(&server.region->direction[APX_SHM_DIRECTION_SERVER_TO_CLIENT].window[0x400], &data[0], sizeof(data)));
+   CuAssertIntEquals(tc, 1, apx_shmChannel_read(&client, receiveSpy_data, &spy));
+   CuAssertUIntEquals(tc, msgLen, spy.dataLen);
+   CuAssertIntEquals(tc, 0, memcmp(&msg[0], &spy.data[0], msgLen));
+   CuAssertIntEquals(tc, 0, apx_shmChannel_read(&client, receiveSpy_data, &spy));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_commandIsSentInline(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   apx_shmChannelStats_t stats;
+   receiveSpy_t spy;
+   uint8_t msg[64];
+   uint8_t cmd[RMF_CMD_ACK_LEN];
+   const uint8_t data[2] = {0xAA, 0xBB};
+   uint32_t msgLen;
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, RMF_CMD_ACK_LEN, rmf_serialize_acknowledge(&cmd[0], (int32_t) sizeof(cmd)));
+   msgLen = packMessage(&msg[0], RMF_CMD_START_ADDR, &cmd[0], (uint32_t) sizeof(cmd));
+   msgLen += packMessage(&msg[msgLen], RMF_CMD_START_ADDR, &cmd[0], (uint32_t) sizeof(cmd));
+   msgLen += packMessage(&msg[msgLen], 0u, &data[0], (uint32_t) sizeof(data));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&client, &msg[0], msgLen));
+   apx_shmChannel_getStats(&client, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numInlineWrites); //both commands share one record
+   CuAssertUIntEquals(tc, 1u, stats.numWindowWrites);
+   CuAssertIntEquals(tc, 2, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertUIntEquals(tc, 2u, spy.numCalls);
+   CuAssertUIntEquals(tc, msgLen, spy.dataLen);
+   CuAssertIntEquals(tc, 0, memcmp(&msg[0], &spy.data[0], msgLen));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_windowDisabled(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   apx_shmChannelStats_t stats;
+   receiveSpy_t spy;
+   uint8_t msg[32];
+   const uint8_t data[3] = {1, 2, 3};
+   uint32_t msgLen = packMessage(&msg[0], 0u, &data[0], (uint32_t) sizeof(data));
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   apx_shmChannel_setWindowEnabled(&client, false);
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&client, &msg[0], msgLen));
+   apx_shmChannel_getStats(&client, &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numInlineWrites);
+   CuAssertUIntEquals(tc, 0u, stats.numWindowWrites);
+   CuAssertIntEquals(tc, 1, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertIntEquals(tc, 0, memcmp(&msg[0], &spy.data[0], msgLen));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_windowKeepsLatestValue(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   receiveSpy_t spy;
+   uint8_t msg[32];
+   uint8_t expected[32];
+   uint8_t value = 1u;
+   uint32_t msgLen = packMessage(&msg[0], 8u, &value, 1u);
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&server, &msg[0], msgLen));
+   value = 2u;
+   msgLen = packMessage(&expected[0], 8u, &value, 1u);
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&server, &expected[0], msgLen));
+   //both notifications are delivered but the receiver only observes the latest value
+   CuAssertIntEquals(tc, 2, apx_shmChannel_read(&client, receiveSpy_data, &spy));
+   CuAssertUIntEquals(tc, 2u*msgLen, spy.dataLen);
+   CuAssertIntEquals(tc, 0, memcmp(&expected[0], &spy.data[0], msgLen));
+   CuAssertIntEquals(tc, 0, memcmp(&expected[0], &spy.data[msgLen], msgLen));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_wrapAround(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   receiveSpy_t spy;
+   uint8_t data[1000];
+   uint8_t *msg = (uint8_t*) malloc(sizeof(data) + 16u);
+   uint32_t i;
+   uint32_t numMessages = (3u * APX_SHM_RING_SIZE) / (uint32_t) sizeof(data);
+   CuAssertPtrNotNull(tc, msg);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   for (i = 0u; i < numMessages; i++)
+   {
+      uint32_t msgLen;
+      memset(&data[0], (int) (i & 0xFFu), sizeof(data));
+      msgLen = packMessage(msg, 0x4000000u, &data[0], (uint32_t) sizeof(data)); //outside the window
+      CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&server, msg, msgLen));
+      memset(&spy, 0, sizeof(spy));
+      CuAssertIntEquals(tc, 1, apx_shmChannel_read(&client, receiveSpy_data, &spy));
+      CuAssertUIntEquals(tc, msgLen, spy.dataLen);
+      CuAssertIntEquals(tc, 0, memcmp(msg, &spy.data[0], msgLen));
+   }
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+   free(msg);
+}
+
+static void test_apx_shmChannel_handlesOverSocket(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   receiveSpy_t spy;
+   int sv[2];
+   uint8_t msg[32];
+   const uint8_t data[2] = {0x55, 0x66};
+   uint32_t msgLen = packMessage(&msg[0], 2u, &data[0], (uint32_t) sizeof(data));
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, 0, socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_sendHandles(&server, sv[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_createFromSocket(&client, sv[1]));
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&client, &msg[0], msgLen));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_wait(&server, sv[0], 0));
+   CuAssertIntEquals(tc, 1, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertIntEquals(tc, 0, memcmp(&msg[0], &spy.data[0], msgLen));
+   close(sv[1]); //client goes away
+   CuAssertIntEquals(tc, APX_CONNECTION_ERROR, apx_shmChannel_wait(&server, sv[0], 1000));
+   close(sv[0]);
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_waitAfterClose(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_wait(&client, -1, 0));
+   apx_shmChannel_close(&server);
+   CuAssertIntEquals(tc, APX_CONNECTION_ERROR, apx_shmChannel_wait(&client, -1, APX_SHM_WAIT_FOREVER));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_corruptHeadIsProtocolError(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   receiveSpy_t spy;
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   client.tx->head = client.tx->tail + APX_SHM_RING_SIZE + 8u; //a producer can never be more than one ring ahead
+   CuAssertIntEquals(tc, -1, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertUIntEquals(tc, 0u, spy.numCalls);
+   CuAssertTrue(tc, apx_shmChannel_isClosed(&server));
+   server.region->isClosed = 0u; //the peer can reopen the shared flag, the server must still drop the connection
+   CuAssertIntEquals(tc, APX_CONNECTION_ERROR, apx_shmChannel_wait(&server, -1, 0));
+   CuAssertIntEquals(tc, -1, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_corruptRecordLengthIsProtocolError(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   receiveSpy_t spy;
+   uint8_t msg[32];
+   uint8_t cmd[RMF_CMD_ACK_LEN];
+   uint32_t msgLen;
+   uint32_t badLen = APX_SHM_RING_SIZE;
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, RMF_CMD_ACK_LEN, rmf_serialize_acknowledge(&cmd[0], (int32_t) sizeof(cmd)));
+   msgLen = packMessage(&msg[0], RMF_CMD_START_ADDR, &cmd[0], (uint32_t) sizeof(cmd));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   attachPeer(tc, &server, &client);
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&client, &msg[0], msgLen));
+   memcpy(&client.tx->ring[sizeof(uint32_t)], &badLen, sizeof(badLen)); //len field of the first record
+   CuAssertIntEquals(tc, -1, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertUIntEquals(tc, 0u, spy.numCalls);
+   CuAssertUIntEquals(tc, 0u, server.rx->tail);
+   CuAssertIntEquals(tc, APX_CONNECTION_ERROR, apx_shmChannel_wait(&server, -1, 0));
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void test_apx_shmChannel_stalledWindowIsRetriedAfterWait(CuTest *tc)
+{
+   apx_shmChannel_t server;
+   apx_shmChannel_t client;
+   receiveSpy_t spy;
+   int sv[2];
+   uint8_t msg[32];
+   const uint8_t data[2] = {0x11, 0x22};
+   uint32_t msgLen = packMessage(&msg[0], 0x10u, &data[0], (uint32_t) sizeof(data));
+   memset(&spy, 0, sizeof(spy));
+   CuAssertIntEquals(tc, 0, socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_create(&server));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_sendHandles(&server, sv[0]));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_createFromSocket(&client, sv[1]));
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&client, &msg[0], msgLen));
+   client.tx->windowSeq++; //client stops in the middle of its next window write
+   CuAssertIntEquals(tc, 0, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertUIntEquals(tc, 0u, spy.numCalls);
+   CuAssertUIntEquals(tc, 0u, server.rx->tail);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_wait(&server, sv[0], APX_SHM_WAIT_FOREVER));
+   client.tx->windowSeq++; //client finishes the write
+   CuAssertIntEquals(tc, 1, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   CuAssertIntEquals(tc, 0, memcmp(&msg[0], &spy.data[0], msgLen));
+   //a client that crashes with the window locked is detected through the socket
+   CuAssertIntEquals(tc, (int) msgLen, apx_shmChannel_write(&client, &msg[0], msgLen));
+   client.tx->windowSeq++;
+   CuAssertIntEquals(tc, 0, apx_shmChannel_read(&server, receiveSpy_data, &spy));
+   close(sv[1]);
+   CuAssertIntEquals(tc, APX_CONNECTION_ERROR, apx_shmChannel_wait(&server, sv[0], APX_SHM_WAIT_FOREVER));
+   close(sv[0]);
+   apx_shmChannel_destroy(&client);
+   apx_shmChannel_destroy(&server);
+}
+
+static void attachPeer(CuTest *tc, apx_shmChannel_t *server, apx_shmChannel_t *client)
+{
+   int handles[APX_SHM_NUM_HANDLES];
+   uint32_t i;
+   apx_shmChannel_getHandles(server, &handles[0]);
+   for (i = 0u; i < APX_SHM_NUM_HANDLES; i++)
+   {
+      handles[i] = dup(handles[i]);
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_shmChannel_createFromHandles(client, &handles[0]));
+}
+
+static uint32_t packMessage(uint8_t *buf, uint32_t address, const uint8_t *data, uint32_t dataLen)
+{
+   uint8_t header[RMF_MAX_HEADER_SIZE];
+   int32_t headerLen = rmf_packHeader(&header[0], (int32_t) sizeof(header), address, false);
+   int32_t numHeaderLen = numheader_encode32(buf, (int32_t) sizeof(uint32_t), (uint32_t) headerLen + dataLen);
+   memcpy(&buf[numHeaderLen], &header[0], (size_t) headerLen);
+   memcpy(&buf[numHeaderLen + headerLen], data, dataLen);
+   return (uint32_t) (numHeaderLen + headerLen) + dataLen;
+}
+
+static void receiveSpy_data(void *arg, const uint8_t *data, uint32_t dataLen)
+{
+   receiveSpy_t *spy = (receiveSpy_t*) arg;
+   if (spy->dataLen + dataLen <= RECEIVE_BUFFER_SIZE)
+   {
+      memcpy(&spy->data[spy->dataLen], data, dataLen);
+      spy->dataLen += dataLen;
+   }
+   spy->numCalls++;
+}
+#endif
@@ -0,0 +1,176 @@
+/*****************************************************************************
+* \file      testsuite_apx_signatureTable.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_signatureTable
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_signatureTable.h"
+#include "apx_nodeInfo.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+static const char *m_node_text1 =
+      "APX/1.2\n"
+      "N\"TestNode1\"\n"
+      "T\"InterningTest_T\"{\"Id\"L\"Value\"S}\n"
+      "R\"InterningTestSignal1\"T[0]\n"
+      "P\"InterningTestSignal2\"T[0]\n";
+
+static const char *m_node_text2 =
+      "APX/1.2\n"
+      "N\"TestNode2\"\n"
+      "P\"InterningTestSignal1\"{\"Id\"L\"Value\"S}\n";
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_signatureTable_internSameSignatureTwice(CuTest* tc);
+static void test_apx_signatureTable_internDifferentSignatures(CuTest* tc);
+static void test_apx_signatureTable_releaseLastReference(CuTest* tc);
+static void test_apx_signatureTable_globalTable(CuTest* tc);
+static void test_apx_signatureTable_nodeInfoInternsInServerMode(CuTest* tc);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_signatureTable(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_signatureTable_internSameSignatureTwice);
+   SUITE_ADD_TEST(suite, test_apx_signatureTable_internDifferentSignatures);
+   SUITE_ADD_TEST(suite, test_apx_signatureTable_releaseLastReference);
+   SUITE_ADD_TEST(suite, test_apx_signatureTable_globalTable);
+   SUITE_ADD_TEST(suite, test_apx_signatureTable_nodeInfoInternsInServerMode);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_signatureTable_internSameSignatureTwice(CuTest* tc)
+{
+   apx_signatureTable_t table;
+   apx_signatureId_t id1;
+   apx_signatureId_t id2;
+   apx_signatureTable_create(&table);
+   id1 = apx_signatureTable_intern(&table, "\"VehicleSpeed\"S");
+   id2 = apx_signatureTable_intern(&table, "\"VehicleSpeed\"S");
+   CuAssertTrue(tc, id1 != APX_INVALID_SIGNATURE_ID);
+   CuAssertTrue(tc, id1 == id2);
+   CuAssertIntEquals(tc, 1, apx_signatureTable_length(&table));
+   apx_signatureTable_release(&table, "\"VehicleSpeed\"S");
+   apx_signatureTable_release(&table, "\"VehicleSpeed\"S");
+   apx_signatureTable_destroy(&table);
+}
+
+static void test_apx_signatureTable_internDifferentSignatures(CuTest* tc)
+{
+   apx_signatureTable_t table;
+   apx_signatureId_t id1;
+   apx_signatureId_t id2;
+   apx_signatureTable_create(&table);
+   id1 = apx_signatureTable_intern(&table, "\"VehicleSpeed\"S");
+   id2 = apx_signatureTable_intern(&table, "\"VehicleSpeed\"L");
+   CuAssertTrue(tc, id1 != APX_INVALID_SIGNATURE_ID);
+   CuAssertTrue(tc, id2 != APX_INVALID_SIGNATURE_ID);
+   CuAssertTrue(tc, id1 != id2);
+   CuAssertIntEquals(tc, 2, apx_signatureTable_length(&table));
+   CuAssertTrue(tc, apx_signatureTable_find(&table, "\"VehicleSpeed\"S") == id1);
+   CuAssertTrue(tc, apx_signatureTable_find(&table, "\"VehicleSpeed\"L") == id2);
+   CuAssertTrue(tc, apx_signatureTable_find(&table, "\"EngineSpeed\"S") == APX_INVALID_SIGNATURE_ID);
+   apx_signatureTable_destroy(&table);
+}
+
+static void test_apx_signatureTable_releaseLastReference(CuTest* tc)
+{
+   apx_signatureTable_t table;
+   apx_signatureId_t id1;
+   apx_signatureId_t id2;
+   apx_signatureTable_create(&table);
+   id1 = apx_signatureTable_intern(&table, "\"VehicleSpeed\"S");
+   CuAssertTrue(tc, apx_signatureTable_intern(&table, "\"VehicleSpeed\"S") == id1);
+   apx_signatureTable_release(&table, "\"VehicleSpeed\"S");
+   CuAssertTrue(tc, apx_signatureTable_find(&table, "\"VehicleSpeed\"S") == id1);
+   apx_signatureTable_release(&table, "\"VehicleSpeed\"S");
+   CuAssertTrue(tc, apx_signatureTable_find(&table, "\"VehicleSpeed\"S") == APX_INVALID_SIGNATURE_ID);
+   CuAssertIntEquals(tc, 0, apx_signatureTable_length(&table));
+   //Ids are never reused
+   id2 = apx_signatureTable_intern(&table, "\"VehicleSpeed\"S");
+   CuAssertTrue(tc, id2 != APX_INVALID_SIGNATURE_ID);
+   CuAssertTrue(tc, id2 != id1);
+   apx_signatureTable_destroy(&table);
+}
+
+static void test_apx_signatureTable_globalTable(CuTest* tc)
+{
+   apx_signatureTable_t *table = apx_signatureTable_getGlobal();
+   CuAssertPtrNotNull(tc, table);
+   CuAssertPtrEquals(tc, table, apx_signatureTable_getGlobal());
+}
+
+static void test_apx_signatureTable_nodeInfoInternsInServerMode(CuTest* tc)
+{
+   apx_signatureTable_t *table = apx_signatureTable_getGlobal();
+   apx_nodeInfo_t *nodeInfo1;
+   apx_nodeInfo_t *nodeInfo2;
+   int32_t lengthBefore = apx_signatureTable_length(table);
+
+   nodeInfo1 = apx_nodeInfo_make_from_cstr(m_node_text1, APX_SERVER_MODE);
+   CuAssertPtrNotNull(tc, nodeInfo1);
+   nodeInfo2 = apx_nodeInfo_make_from_cstr(m_node_text2, APX_SERVER_MODE);
+   CuAssertPtrNotNull(tc, nodeInfo2);
+   CuAssertIntEquals(tc, lengthBefore + 2, apx_signatureTable_length(table));
+   //The type reference and the inline record derive the same port signature
+   CuAssertTrue(tc, apx_nodeInfo_getRequirePortSignatureId(nodeInfo1, 0) != APX_INVALID_SIGNATURE_ID);
+   CuAssertTrue(tc, apx_nodeInfo_getRequirePortSignatureId(nodeInfo1, 0) == apx_nodeInfo_getProvidePortSignatureId(nodeInfo2, 0));
+   CuAssertTrue(tc, apx_nodeInfo_getRequirePortSignatureId(nodeInfo1, 0) != apx_nodeInfo_getProvidePortSignatureId(nodeInfo1, 0));
+   CuAssertTrue(tc, apx_signatureTable_find(table, apx_nodeInfo_getProvidePortSignature(nodeInfo1, 0)) == apx_nodeInfo_getProvidePortSignatureId(nodeInfo1, 0));
+
+   apx_nodeInfo_delete(nodeInfo1);
+   CuAssertIntEquals(tc, lengthBefore + 1, apx_signatureTable_length(table));
+   apx_nodeInfo_delete(nodeInfo2);
+   CuAssertIntEquals(tc, lengthBefore, apx_signatureTable_length(table));
+
+   //Client mode does not use the signature table
+   nodeInfo1 = apx_nodeInfo_make_from_cstr(m_node_text1, APX_CLIENT_MODE);
+   CuAssertPtrNotNull(tc, nodeInfo1);
+   CuAssertIntEquals(tc, lengthBefore, apx_signatureTable_length(table));
+   CuAssertTrue(tc, apx_nodeInfo_getRequirePortSignatureId(nodeInfo1, 0) == APX_INVALID_SIGNATURE_ID);
+   apx_nodeInfo_delete(nodeInfo1);
+}
@@ -60,6 +60,8 @@ static void test_apx_vm_packS16(CuTest* tc);
 static void test_apx_vm_unpackS16(CuTest* tc);
 static void test_apx_vm_packS32(CuTest* tc);
 static void test_apx_vm_unpackS32(CuTest* tc);
+static void test_apx_vm_packS64(CuTest* tc);
+static void test_apx_vm_unpackFloat32(CuTest* tc);
 static void test_apx_vm_packU8FixArray(CuTest* tc);
 static void test_apx_vm_packU8DynArray(CuTest* tc);
 static void test_apx_vm_packRecordContainingU16AndU8Value(CuTest* tc);
@@ -93,6 +95,8 @@ CuSuite* testSuite_apx_vm(void)
    SUITE_ADD_TEST(suite, test_apx_vm_unpackS16);
    SUITE_ADD_TEST(suite, test_apx_vm_packS32);
    SUITE_ADD_TEST(suite, test_apx_vm_unpackS32);
+   SUITE_ADD_TEST(suite, test_apx_vm_packS64);
+   SUITE_ADD_TEST(suite, test_apx_vm_unpackFloat32);
    SUITE_ADD_TEST(suite, test_apx_vm_packU8FixArray);
    SUITE_ADD_TEST(suite, test_apx_vm_packU8DynArray);
    SUITE_ADD_TEST(suite, test_apx_vm_packRecordContainingU16AndU8Value);
@@ -839,3 +843,67 @@ static void test_apc_vm_unpackStringValue(CuTest* tc)
    apx_dataElement_delete(element);
    adt_bytes_delete(storedProgram);
 }
+
+static void test_apx_vm_packS64(CuTest* tc)
+{
+   adt_bytes_t *storedProgram;
+   apx_vm_t *vm = apx_vm_new();
+   adt_bytearray_t *compiledProgram = adt_bytearray_new(APX_PROGRAM_GROW_SIZE);
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_SINT64, NULL);
+   apx_compiler_t *compiler = apx_compiler_new();
+   dtl_sv_t *sv = dtl_sv_make_i64(-2);
+   uint8_t dataBuffer[SINT64_SIZE];
+   uint8_t verificationData[SINT64_SIZE] = {0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_compiler_begin_packProgram(compiler, compiledProgram));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_compiler_compilePackDataElement(compiler, element));
+   apx_compiler_end(compiler);
+   apx_compiler_delete(compiler);
+   storedProgram = adt_bytearray_bytes(compiledProgram);
+   memset(dataBuffer, 0, sizeof(dataBuffer));
+
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_vm_selectProgram(vm, storedProgram));
+   CuAssertUIntEquals(tc, SINT64_SIZE, apx_vm_getProgDataSize(vm));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_setWriteBuffer(vm, dataBuffer, (apx_size_t) sizeof(dataBuffer)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_packValue(vm, (dtl_dv_t*) sv));
+   CuAssertUIntEquals(tc, SINT64_SIZE, apx_vm_getBytesWritten(vm));
+   CuAssertIntEquals(tc, 0, memcmp(dataBuffer, verificationData, sizeof(dataBuffer)));
+
+   apx_vm_delete(vm);
+   adt_bytearray_delete(compiledProgram);
+   apx_dataElement_delete(element);
+   dtl_dec_ref(sv);
+   adt_bytes_delete(storedProgram);
+}
+
+static void test_apx_vm_unpackFloat32(CuTest* tc)
+{
+   adt_bytes_t *storedProgram;
+   apx_vm_t *vm = apx_vm_new();
+   adt_bytearray_t *compiledProgram = adt_bytearray_new(APX_PROGRAM_GROW_SIZE);
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_FLOAT32, NULL);
+   apx_compiler_t *compiler = apx_compiler_new();
+   dtl_dv_t *dv;
+   uint8_t dataBuffer[FLOAT32_SIZE] = {0x00, 0x00, 0xc0, 0x3f}; //1.5
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_compiler_begin_unpackProgram(compiler, compiledProgram));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_compiler_compileUnpackDataElement(compiler, element));
+   apx_compiler_end(compiler);
+   apx_compiler_delete(compiler);
+
+   storedProgram = adt_bytearray_bytes(compiledProgram);
+   CuAssertUIntEquals(tc, APX_NO_ERROR, apx_vm_selectProgram(vm, storedProgram));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_setReadBuffer(vm, &dataBuffer[0], (apx_size_t) FLOAT32_SIZE));
+   dv = (dtl_dv_t*) 0;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_unpackValue(vm, &dv));
+   CuAssertUIntEquals(tc, FLOAT32_SIZE, apx_vm_getBytesRead(vm));
+   CuAssertPtrNotNull(tc, dv);
+   CuAssertUIntEquals(tc, DTL_DV_SCALAR, dtl_dv_type(dv));
+   CuAssertDblEquals(tc, 1.5, dtl_sv_to_flt((dtl_sv_t*) dv, NULL), 0.0);
+   dtl_dec_ref(dv);
+
+   apx_vm_delete(vm);
+   adt_bytearray_delete(compiledProgram);
+   apx_dataElement_delete(element);
+   adt_bytes_delete(storedProgram);
+}
@@ -62,6 +62,10 @@ static void test_apx_vmDeserializer_unpackU32LEArray(CuTest* tc);
 static void test_apx_vmDeserializer_unpackS8Array(CuTest* tc);
 static void test_apx_vmDeserializer_unpackS16LEArray(CuTest* tc);
 static void test_apx_vmDeserializer_unpackS32LEArray(CuTest* tc);
+static void test_apx_vmDeserializer_unpackU64LE(CuTest* tc);
+static void test_apx_vmDeserializer_unpackS64LE(CuTest* tc);
+static void test_apx_vmDeserializer_unpackFloat64Value(CuTest* tc);
+static void test_apx_vmDeserializer_unpackFloat32LEArray(CuTest* tc);
 static void test_apx_vmDeserializer_unpackU8Record(CuTest* tc);
 static void test_apx_vmDeserializer_unpackRecordStrU32(CuTest* tc);
 static void test_apx_vmDeserializer_unpackBytesValue(CuTest* tc);
@@ -93,6 +97,10 @@ CuSuite* testSuite_apx_vmDeserializer(void)
    SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackS8Array);
    SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackS16LEArray);
    SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackS32LEArray);
+   SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackU64LE);
+   SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackS64LE);
+   SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackFloat64Value);
+   SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackFloat32LEArray);
    SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackU8Record);
    SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackRecordStrU32);
    SUITE_ADD_TEST(suite, test_apx_vmDeserializer_unpackBytes);
@@ -572,3 +580,68 @@ static void test_apx_vmDeserializer_selectRecordElement(CuTest* tc)
 
    apx_vmDeserializer_delete(dsr);
 }
+
+static void test_apx_vmDeserializer_unpackU64LE(CuTest* tc)
+{
+   uint8_t data[2*UINT64_SIZE] = {0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+   uint64_t u64Value = 0u;
+   apx_vmDeserializer_t *sr = apx_vmDeserializer_new();
+   CuAssertPtrNotNull(tc, sr);
+   CuAssertIntEquals(tc, APX_MISSING_BUFFER_ERROR, apx_vmDeserializer_unpackU64(sr, &u64Value));
+   apx_vmDeserializer_begin(sr, &data[0], sizeof(data));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmDeserializer_unpackU64(sr, &u64Value));
+   CuAssertTrue(tc, u64Value == 0x123456789abcdef0ull);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmDeserializer_unpackU64(sr, &u64Value));
+   CuAssertTrue(tc, u64Value == 0xffffffffffffffffull);
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_vmDeserializer_unpackU64(sr, &u64Value));
+   apx_vmDeserializer_delete(sr);
+}
+
+static void test_apx_vmDeserializer_unpackS64LE(CuTest* tc)
+{
+   uint8_t data[2*SINT64_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+   int64_t s64Value = 0;
+   apx_vmDeserializer_t *sr = apx_vmDeserializer_new();
+   CuAssertPtrNotNull(tc, sr);
+   apx_vmDeserializer_begin(sr, &data[0], sizeof(data));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmDeserializer_unpackS64(sr, &s64Value));
+   CuAssertTrue(tc, s64Value == INT64_MIN);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmDeserializer_unpackS64(sr, &s64Value));
+   CuAssertTrue(tc, s64Value == -2);
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_vmDeserializer_unpackS64(sr, &s64Value));
+   apx_vmDeserializer_delete(sr);
+}
+
+static void test_apx_vmDeserializer_unpackFloat64Value(CuTest* tc)
+{
+   uint8_t packedData[FLOAT64_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f}; //1.5
+   dtl_dv_t *dv = 0;
+   apx_vmDeserializer_t *sr = apx_vmDeserializer_new();
+   apx_vmDeserializer_begin(sr, &packedData[0], sizeof(packedData));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmDeserializer_unpackFloat64Value(sr, 0, APX_DYN_LEN_NONE));
+   CuAssertConstPtrEquals(tc, packedData+FLOAT64_SIZE, apx_vmDeserializer_getReadPtr(sr));
+   dv = apx_vmDeserializer_getValue(sr, false);
+   CuAssertIntEquals(tc, DTL_DV_SCALAR, dtl_dv_type(dv));
+   CuAssertDblEquals(tc, 1.5, dtl_sv_to_dbl((dtl_sv_t*) dv, NULL), 0.0);
+   apx_vmDeserializer_delete(sr);
+}
+
+static void test_apx_vmDeserializer_unpackFloat32LEArray(CuTest* tc)
+{
+   const uint32_t arrayLen = 3u;
+   uint8_t packedData[3*FLOAT32_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x20, 0xc1}; //0.0, 1.0, -10.0
+   dtl_dv_t *dv = 0;
+   dtl_av_t *av;
+   apx_vmDeserializer_t *sr = apx_vmDeserializer_new();
+   apx_vmDeserializer_begin(sr, &packedData[0], sizeof(packedData));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmDeserializer_unpackFloat32Value(sr, arrayLen, APX_DYN_LEN_NONE));
+   CuAssertConstPtrEquals(tc, packedData+FLOAT32_SIZE*arrayLen, apx_vmDeserializer_getReadPtr(sr));
+   dv = apx_vmDeserializer_getValue(sr, false);
+   CuAssertIntEquals(tc, DTL_DV_ARRAY, dtl_dv_type(dv));
+   av = (dtl_av_t*) dv;
+   CuAssertIntEquals(tc, arrayLen, dtl_av_length(av));
+   CuAssertDblEquals(tc, 0.0, dtl_sv_to_flt((dtl_sv_t*) dtl_av_value(av, 0), NULL), 0.0);
+   CuAssertDblEquals(tc, 1.0, dtl_sv_to_flt((dtl_sv_t*) dtl_av_value(av, 1), NULL), 0.0);
+   CuAssertDblEquals(tc, -10.0, dtl_sv_to_flt((dtl_sv_t*) dtl_av_value(av, 2), NULL), 0.0);
+   apx_vmDeserializer_delete(sr);
+}
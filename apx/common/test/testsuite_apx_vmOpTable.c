@@ -0,0 +1,344 @@
+/*****************************************************************************
+* \file      testsuite_apx_vmOpTable.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_vmOpTable
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_compiler.h"
+#include "apx_vm.h"
+#include "apx_vmOpTable.h"
+#include "pack.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_vmOpTable_compileScalar(CuTest* tc);
+static void test_apx_vmOpTable_compileRecord(CuTest* tc);
+static void test_apx_vmOpTable_compileStringIsUnsupported(CuTest* tc);
+static void test_apx_vmOpTable_compileDynamicArrayIsUnsupported(CuTest* tc);
+static void test_apx_vmOpTable_packRecordSameAsInterpreter(CuTest* tc);
+static void test_apx_vmOpTable_unpackRecord(CuTest* tc);
+static void test_apx_vmOpTable_packMissingRecordKey(CuTest* tc);
+static void test_apx_vmOpTable_selectCompiledProgram(CuTest* tc);
+static adt_bytes_t *compileProgram(apx_dataElement_t *element, bool isPackProgram);
+static apx_dataElement_t *createTestRecord(void);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_vmOpTable(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_compileScalar);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_compileRecord);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_compileStringIsUnsupported);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_compileDynamicArrayIsUnsupported);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_packRecordSameAsInterpreter);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_unpackRecord);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_packMissingRecordKey);
+   SUITE_ADD_TEST(suite, test_apx_vmOpTable_selectCompiledProgram);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_vmOpTable_compileScalar(CuTest* tc)
+{
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_SINT16, 0);
+   adt_bytes_t *program = compileProgram(element, true);
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   CuAssertIntEquals(tc, 1, opTable.numOps);
+   CuAssertUIntEquals(tc, UINT16_SIZE, opTable.dataSize);
+   CuAssertTrue(tc, !opTable.isRecord);
+   CuAssertPtrEquals(tc, 0, (void*) opTable.ops[0].key);
+   CuAssertUIntEquals(tc, 0u, opTable.ops[0].offset);
+   CuAssertUIntEquals(tc, 0u, opTable.ops[0].count);
+   CuAssertUIntEquals(tc, UINT16_SIZE, opTable.ops[0].width);
+   CuAssertUIntEquals(tc, APX_VARIANT_S16, opTable.ops[0].variant);
+   apx_vmOpTable_destroy(&opTable);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_compileRecord(CuTest* tc)
+{
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = createTestRecord();
+   adt_bytes_t *program = compileProgram(element, false);
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   CuAssertTrue(tc, opTable.isRecord);
+   CuAssertIntEquals(tc, 4, opTable.numOps);
+   CuAssertUIntEquals(tc, UINT16_SIZE+UINT8_SIZE+UINT32_SIZE*3+FLOAT64_SIZE, opTable.dataSize);
+   CuAssertStrEquals(tc, "DTCId", opTable.ops[0].key);
+   CuAssertUIntEquals(tc, 0u, opTable.ops[0].offset);
+   CuAssertStrEquals(tc, "FTB", opTable.ops[1].key);
+   CuAssertUIntEquals(tc, 2u, opTable.ops[1].offset);
+   CuAssertStrEquals(tc, "Counters", opTable.ops[2].key);
+   CuAssertUIntEquals(tc, 3u, opTable.ops[2].offset);
+   CuAssertUIntEquals(tc, 3u, opTable.ops[2].count);
+   CuAssertUIntEquals(tc, APX_VARIANT_S32, opTable.ops[2].variant);
+   CuAssertStrEquals(tc, "Ratio", opTable.ops[3].key);
+   CuAssertUIntEquals(tc, 15u, opTable.ops[3].offset);
+   CuAssertUIntEquals(tc, APX_VARIANT_FLOAT64, opTable.ops[3].variant);
+   apx_vmOpTable_destroy(&opTable);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_compileStringIsUnsupported(CuTest* tc)
+{
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_STRING, 0);
+   adt_bytes_t *program;
+   apx_dataElement_setArrayLen(element, 10u);
+   program = compileProgram(element, true);
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_UNSUPPORTED_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   CuAssertIntEquals(tc, 0, opTable.numOps);
+   apx_vmOpTable_destroy(&opTable);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_compileDynamicArrayIsUnsupported(CuTest* tc)
+{
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_UINT8, 0);
+   adt_bytes_t *program;
+   apx_dataElement_setArrayLen(element, 10u);
+   apx_dataElement_setDynamicArray(element);
+   program = compileProgram(element, true);
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_UNSUPPORTED_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   apx_vmOpTable_destroy(&opTable);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_packRecordSameAsInterpreter(CuTest* tc)
+{
+   apx_vm_t *vm = apx_vm_new();
+   apx_dataElement_t *element = createTestRecord();
+   adt_bytes_t *program = compileProgram(element, true);
+   dtl_hv_t *hv = dtl_hv_new();
+   dtl_av_t *av = dtl_av_new();
+   uint8_t expected[UINT16_SIZE+UINT8_SIZE+UINT32_SIZE*3+FLOAT64_SIZE];
+   uint8_t result[UINT16_SIZE+UINT8_SIZE+UINT32_SIZE*3+FLOAT64_SIZE];
+
+   dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_i32(-1), false);
+   dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_i32(0x12345678), false);
+   dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_i32(-100000), false);
+   dtl_hv_set_cstr(hv, "DTCId", (dtl_dv_t*) dtl_sv_make_u32(0x1234), false);
+   dtl_hv_set_cstr(hv, "FTB", (dtl_dv_t*) dtl_sv_make_u32(0x15), false);
+   dtl_hv_set_cstr(hv, "Counters", (dtl_dv_t*) av, false);
+   dtl_hv_set_cstr(hv, "Ratio", (dtl_dv_t*) dtl_sv_make_dbl(0.125), false);
+   memset(&expected[0], 0xff, sizeof(expected));
+   memset(&result[0], 0, sizeof(result));
+
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_selectProgram(vm, program));
+   CuAssertTrue(tc, apx_vm_hasOpTable(vm));
+   apx_vm_enableOpTable(vm, false);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_setWriteBuffer(vm, &expected[0], (apx_size_t) sizeof(expected)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_packValue(vm, (dtl_dv_t*) hv));
+   CuAssertUIntEquals(tc, sizeof(expected), apx_vm_getBytesWritten(vm));
+   apx_vm_enableOpTable(vm, true);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_setWriteBuffer(vm, &result[0], (apx_size_t) sizeof(result)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_packValue(vm, (dtl_dv_t*) hv));
+   CuAssertUIntEquals(tc, sizeof(result), apx_vm_getBytesWritten(vm));
+   CuAssertIntEquals(tc, 0, memcmp(&expected[0], &result[0], sizeof(result)));
+
+   apx_vm_delete(vm);
+   dtl_dec_ref(hv);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_unpackRecord(CuTest* tc)
+{
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = createTestRecord();
+   adt_bytes_t *program = compileProgram(element, false);
+   dtl_dv_t *dv = (dtl_dv_t*) 0;
+   dtl_hv_t *hv;
+   dtl_av_t *av;
+   dtl_sv_t *sv;
+   uint8_t dataBuffer[UINT16_SIZE+UINT8_SIZE+UINT32_SIZE*3+FLOAT64_SIZE];
+   bool ok = false;
+
+   memset(&dataBuffer[0], 0, sizeof(dataBuffer));
+   packLE(&dataBuffer[0], 0x1234u, UINT16_SIZE);
+   packLE(&dataBuffer[2], 0x15u, UINT8_SIZE);
+   packLE(&dataBuffer[3], 0xFFFFFFFFu, UINT32_SIZE);
+   packLE(&dataBuffer[7], 7u, UINT32_SIZE);
+   packLE(&dataBuffer[11], 0u, UINT32_SIZE);
+   packLE(&dataBuffer[19], 0x3FC00000u, UINT32_SIZE); //1.5 (upper half of IEEE-754 double)
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_vmOpTable_unpack(&opTable, &dataBuffer[0], (apx_size_t) sizeof(dataBuffer)-1u, &dv));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmOpTable_unpack(&opTable, &dataBuffer[0], (apx_size_t) sizeof(dataBuffer), &dv));
+   CuAssertPtrNotNull(tc, dv);
+   CuAssertIntEquals(tc, DTL_DV_HASH, dtl_dv_type(dv));
+   hv = (dtl_hv_t*) dv;
+   CuAssertIntEquals(tc, 4, dtl_hv_length(hv));
+   sv = (dtl_sv_t*) dtl_hv_get_cstr(hv, "DTCId");
+   CuAssertPtrNotNull(tc, sv);
+   CuAssertUIntEquals(tc, 0x1234, dtl_sv_to_u32(sv, &ok));
+   sv = (dtl_sv_t*) dtl_hv_get_cstr(hv, "FTB");
+   CuAssertPtrNotNull(tc, sv);
+   CuAssertUIntEquals(tc, 0x15, dtl_sv_to_u32(sv, &ok));
+   av = (dtl_av_t*) dtl_hv_get_cstr(hv, "Counters");
+   CuAssertPtrNotNull(tc, av);
+   CuAssertIntEquals(tc, 3, dtl_av_length(av));
+   CuAssertIntEquals(tc, -1, dtl_sv_to_i32((dtl_sv_t*) dtl_av_value(av, 0), &ok));
+   CuAssertIntEquals(tc, 7, dtl_sv_to_i32((dtl_sv_t*) dtl_av_value(av, 1), &ok));
+   CuAssertIntEquals(tc, 0, dtl_sv_to_i32((dtl_sv_t*) dtl_av_value(av, 2), &ok));
+   sv = (dtl_sv_t*) dtl_hv_get_cstr(hv, "Ratio");
+   CuAssertPtrNotNull(tc, sv);
+   CuAssertTrue(tc, dtl_sv_to_dbl(sv, &ok) == 1.5);
+
+   dtl_dec_ref(dv);
+   apx_vmOpTable_destroy(&opTable);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_packMissingRecordKey(CuTest* tc)
+{
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = createTestRecord();
+   adt_bytes_t *program = compileProgram(element, true);
+   dtl_hv_t *hv = dtl_hv_new();
+   dtl_sv_t *sv = dtl_sv_make_u32(1u);
+   uint8_t dataBuffer[UINT16_SIZE+UINT8_SIZE+UINT32_SIZE*3+FLOAT64_SIZE];
+
+   dtl_hv_set_cstr(hv, "DTCId", (dtl_dv_t*) dtl_sv_make_u32(0x1234), false);
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   CuAssertIntEquals(tc, APX_NOT_FOUND_ERROR, apx_vmOpTable_pack(&opTable, &dataBuffer[0], (apx_size_t) sizeof(dataBuffer), (dtl_dv_t*) hv));
+   CuAssertIntEquals(tc, APX_DV_TYPE_ERROR, apx_vmOpTable_pack(&opTable, &dataBuffer[0], (apx_size_t) sizeof(dataBuffer), (dtl_dv_t*) sv));
+
+   dtl_dec_ref(hv);
+   dtl_dec_ref(sv);
+   apx_vmOpTable_destroy(&opTable);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static void test_apx_vmOpTable_selectCompiledProgram(CuTest* tc)
+{
+   apx_vm_t *vm = apx_vm_new();
+   apx_vmOpTable_t opTable;
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_UINT16, 0);
+   adt_bytes_t *program = compileProgram(element, true);
+   dtl_sv_t *sv = dtl_sv_make_u32(0x1234);
+   uint8_t dataBuffer[UINT16_SIZE];
+
+   apx_vmOpTable_create(&opTable);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmOpTable_compile(&opTable, adt_bytes_constData(program), adt_bytes_constData(program) + adt_bytes_length(program)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_selectCompiledProgram(vm, program, &opTable));
+   CuAssertTrue(tc, apx_vm_hasOpTable(vm));
+   CuAssertIntEquals(tc, 0, vm->opTable.numOps); //the VM didn't compile its own copy
+   memset(&dataBuffer[0], 0, sizeof(dataBuffer));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_setWriteBuffer(vm, &dataBuffer[0], (apx_size_t) sizeof(dataBuffer)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_packValue(vm, (dtl_dv_t*) sv));
+   CuAssertUIntEquals(tc, UINT16_SIZE, apx_vm_getBytesWritten(vm));
+   CuAssertUIntEquals(tc, 0x34, dataBuffer[0]);
+   CuAssertUIntEquals(tc, 0x12, dataBuffer[1]);
+
+   //no table falls back to the interpreter
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_selectCompiledProgram(vm, program, (const apx_vmOpTable_t*) 0));
+   CuAssertTrue(tc, !apx_vm_hasOpTable(vm));
+   memset(&dataBuffer[0], 0, sizeof(dataBuffer));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_setWriteBuffer(vm, &dataBuffer[0], (apx_size_t) sizeof(dataBuffer)));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vm_packValue(vm, (dtl_dv_t*) sv));
+   CuAssertUIntEquals(tc, 0x34, dataBuffer[0]);
+   CuAssertUIntEquals(tc, 0x12, dataBuffer[1]);
+
+   dtl_dec_ref(sv);
+   apx_vmOpTable_destroy(&opTable);
+   apx_vm_delete(vm);
+   adt_bytes_delete(program);
+   apx_dataElement_delete(element);
+}
+
+static adt_bytes_t *compileProgram(apx_dataElement_t *element, bool isPackProgram)
+{
+   adt_bytes_t *program;
+   adt_bytearray_t *compiledProgram = adt_bytearray_new(APX_PROGRAM_GROW_SIZE);
+   apx_compiler_t *compiler = apx_compiler_new();
+   if (isPackProgram)
+   {
+      apx_compiler_begin_packProgram(compiler, compiledProgram);
+      apx_compiler_compilePackDataElement(compiler, element);
+   }
+   else
+   {
+      apx_compiler_begin_unpackProgram(compiler, compiledProgram);
+      apx_compiler_compileUnpackDataElement(compiler, element);
+   }
+   apx_compiler_end(compiler);
+   apx_compiler_delete(compiler);
+   program = adt_bytearray_bytes(compiledProgram);
+   adt_bytearray_delete(compiledProgram);
+   return program;
+}
+
+/**
+ * {"DTCId"S"FTB"C"Counters"l[3]"Ratio"d}
+ */
+static apx_dataElement_t *createTestRecord(void)
+{
+   apx_dataElement_t *element = apx_dataElement_new(APX_BASE_TYPE_RECORD, 0);
+   apx_dataElement_t *child;
+   apx_dataElement_appendChild(element, apx_dataElement_new(APX_BASE_TYPE_UINT16, "DTCId"));
+   apx_dataElement_appendChild(element, apx_dataElement_new(APX_BASE_TYPE_UINT8, "FTB"));
+   child = apx_dataElement_new(APX_BASE_TYPE_SINT32, "Counters");
+   apx_dataElement_setArrayLen(child, 3u);
+   apx_dataElement_appendChild(element, child);
+   apx_dataElement_appendChild(element, apx_dataElement_new(APX_BASE_TYPE_FLOAT64, "Ratio"));
+   return element;
+}
@@ -52,6 +52,10 @@ static void test_apx_vmSerializer_packU32LE(CuTest* tc);
 static void test_apx_vmSerializer_packS8(CuTest* tc);
 static void test_apx_vmSerializer_packS16(CuTest* tc);
 static void test_apx_vmSerializer_packS32(CuTest* tc);
+static void test_apx_vmSerializer_packU64LE(CuTest* tc);
+static void test_apx_vmSerializer_packS64LE(CuTest* tc);
+static void test_apx_vmSerializer_packFloat64LE(CuTest* tc);
+static void test_apx_vmSerializer_packFloat32LEArray(CuTest* tc);
 static void test_apx_vmSerializer_packValueAsString(CuTest* tc);
 static void test_apx_vmSerializer_packRecordU8(CuTest* tc);
 static void test_apx_vmSerializer_packRecordStrU32(CuTest* tc);
@@ -84,6 +88,10 @@ CuSuite* testSuite_apx_vmSerializer(void)
    SUITE_ADD_TEST(suite, test_apx_vmSerializer_packS8);
    SUITE_ADD_TEST(suite, test_apx_vmSerializer_packS16);
    SUITE_ADD_TEST(suite, test_apx_vmSerializer_packS32);
+   SUITE_ADD_TEST(suite, test_apx_vmSerializer_packU64LE);
+   SUITE_ADD_TEST(suite, test_apx_vmSerializer_packS64LE);
+   SUITE_ADD_TEST(suite, test_apx_vmSerializer_packFloat64LE);
+   SUITE_ADD_TEST(suite, test_apx_vmSerializer_packFloat32LEArray);
 
    SUITE_ADD_TEST(suite, test_apx_vmSerializer_packValueAsString);
    SUITE_ADD_TEST(suite, test_apx_vmSerializer_packRecordU8);
@@ -563,3 +571,71 @@ static void test_apx_vmSerializer_selectRecordElement(CuTest* tc)
    dtl_dec_ref(hv);
 }
 
+static void test_apx_vmSerializer_packU64LE(CuTest* tc)
+{
+   uint8_t data[2*UINT64_SIZE];
+   uint8_t verificationData[2*UINT64_SIZE] = {0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+   memset(&data[0], 0, sizeof(data));
+   apx_vmSerializer_t *st = apx_vmSerializer_new();
+   CuAssertPtrNotNull(tc, st);
+   CuAssertIntEquals(tc, APX_MISSING_BUFFER_ERROR, apx_vmSerializer_packU64(st, 0u));
+   apx_vmSerializer_begin(st, &data[0], sizeof(data));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_packU64(st, 0x123456789abcdef0ull));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_packU64(st, 0xffffffffffffffffull));
+   CuAssertIntEquals(tc, 0, memcmp(data, verificationData, sizeof(data)));
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_vmSerializer_packU64(st, 1u));
+   apx_vmSerializer_delete(st);
+}
+
+static void test_apx_vmSerializer_packS64LE(CuTest* tc)
+{
+   uint8_t data[2*SINT64_SIZE];
+   uint8_t verificationData[2*SINT64_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+   memset(&data[0], 0, sizeof(data));
+   apx_vmSerializer_t *st = apx_vmSerializer_new();
+   CuAssertPtrNotNull(tc, st);
+   apx_vmSerializer_begin(st, &data[0], sizeof(data));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_packS64(st, INT64_MIN));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_packS64(st, (int64_t) -1));
+   CuAssertIntEquals(tc, 0, memcmp(data, verificationData, sizeof(data)));
+   CuAssertIntEquals(tc, APX_BUFFER_BOUNDARY_ERROR, apx_vmSerializer_packS64(st, 0));
+   apx_vmSerializer_delete(st);
+}
+
+static void test_apx_vmSerializer_packFloat64LE(CuTest* tc)
+{
+   uint8_t data[FLOAT64_SIZE];
+   uint8_t verificationData[FLOAT64_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f}; //1.5
+   dtl_sv_t *sv = dtl_sv_make_dbl(1.5);
+   apx_vmSerializer_t *st = apx_vmSerializer_new();
+   memset(&data[0], 0, sizeof(data));
+   apx_vmSerializer_begin(st, &data[0], sizeof(data));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_setValue(st, (dtl_dv_t*) sv));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_packValueAsFloat64(st, 0, APX_DYN_LEN_NONE));
+   CuAssertPtrEquals(tc, data+sizeof(data), apx_vmSerializer_getWritePtr(st));
+   CuAssertIntEquals(tc, 0, memcmp(data, verificationData, sizeof(data)));
+   apx_vmSerializer_delete(st);
+   dtl_dec_ref(sv);
+}
+
+static void test_apx_vmSerializer_packFloat32LEArray(CuTest* tc)
+{
+   uint8_t packedData[3*FLOAT32_SIZE];
+   uint8_t verificationData[3*FLOAT32_SIZE] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x20, 0xc1}; //0.0, 1.0, -10.0
+   dtl_av_t *av = dtl_av_new();
+   apx_vmSerializer_t *sr = apx_vmSerializer_new();
+
+   memset(&packedData[0], 0xff, sizeof(packedData));
+   dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_flt(0.0f), false);
+   dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_flt(1.0f), false);
+   dtl_av_push(av, (dtl_dv_t*) dtl_sv_make_flt(-10.0f), false);
+
+   apx_vmSerializer_begin(sr, &packedData[0], sizeof(packedData));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_setValue(sr, (dtl_dv_t*) av));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_vmSerializer_packValueAsFloat32(sr, 3, APX_DYN_LEN_NONE));
+   CuAssertPtrEquals(tc, packedData+sizeof(packedData), apx_vmSerializer_getWritePtr(sr));
+   CuAssertIntEquals(tc, 0, memcmp(packedData, verificationData, sizeof(packedData)));
+
+   apx_vmSerializer_delete(sr);
+   dtl_dec_ref(av);
+}
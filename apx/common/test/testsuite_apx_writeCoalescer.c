@@ -0,0 +1,392 @@
+/*****************************************************************************
+* \file      testsuite_apx_writeCoalescer.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_writeCoalescer
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_writeCoalescer.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_writeCoalescer_create(CuTest* tc);
+static void test_apx_writeCoalescer_writeAndTake(CuTest* tc);
+static void test_apx_writeCoalescer_mergeWrites(CuTest* tc);
+static void test_apx_writeCoalescer_takeTooSmallBuffer(CuTest* tc);
+static void test_apx_writeCoalescer_longerWriteKeepsTail(CuTest* tc);
+static void test_apx_writeCoalescer_largeData(CuTest* tc);
+static void test_apx_writeCoalescer_manyAddresses(CuTest* tc);
+static void test_apx_writeCoalescer_removeKeepsProbeChain(CuTest* tc);
+static void test_apx_writeCoalescer_overlappingWriteIsNotMerged(CuTest* tc);
+static void test_apx_writeCoalescer_overlapWithOlderEntryIsMerged(CuTest* tc);
+static void test_apx_writeCoalescer_longerWriteOverlappingNewerIsNotMerged(CuTest* tc);
+static void test_apx_writeCoalescer_overlapSurvivesRehash(CuTest* tc);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_writeCoalescer(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_create);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_writeAndTake);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_mergeWrites);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_takeTooSmallBuffer);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_longerWriteKeepsTail);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_largeData);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_manyAddresses);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_removeKeepsProbeChain);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_overlappingWriteIsNotMerged);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_overlapWithOlderEntryIsMerged);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_longerWriteOverlappingNewerIsNotMerged);
+   SUITE_ADD_TEST(suite, test_apx_writeCoalescer_overlapSurvivesRehash);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_writeCoalescer_create(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&coalescer));
+   CuAssertUIntEquals(tc, 0u, coalescer.numWrites);
+   CuAssertUIntEquals(tc, 0u, coalescer.numMerged);
+   CuAssertIntEquals(tc, -1, apx_writeCoalescer_getLength(&coalescer, 0u));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_writeAndTake(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   const uint8_t data[3] = {1, 2, 3};
+   uint8_t buf[3] = {0, 0, 0};
+   bool isMerged = true;
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data[0], sizeof(data), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertUIntEquals(tc, 1u, apx_writeCoalescer_length(&coalescer));
+   CuAssertIntEquals(tc, 3, apx_writeCoalescer_getLength(&coalescer, 0x10));
+   CuAssertIntEquals(tc, -1, apx_writeCoalescer_getLength(&coalescer, 0x11));
+   CuAssertIntEquals(tc, 3, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data[0], sizeof(data)));
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&coalescer));
+   CuAssertIntEquals(tc, -1, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_mergeWrites(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   const uint8_t data1[3] = {1, 2, 3};
+   const uint8_t data2[3] = {4, 5, 6};
+   const uint8_t data3[3] = {7, 8, 9};
+   uint8_t buf[3] = {0, 0, 0};
+   bool isMerged = false;
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x13, &data2[0], sizeof(data2), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data3[0], sizeof(data3), &isMerged));
+   CuAssertTrue(tc, isMerged);
+   CuAssertUIntEquals(tc, 2u, apx_writeCoalescer_length(&coalescer));
+   CuAssertUIntEquals(tc, 3u, coalescer.numWrites);
+   CuAssertUIntEquals(tc, 1u, coalescer.numMerged);
+   CuAssertIntEquals(tc, 3, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data3[0], sizeof(data3)));
+   CuAssertIntEquals(tc, 3, apx_writeCoalescer_take(&coalescer, 0x13, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data2[0], sizeof(data2)));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_takeTooSmallBuffer(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   bool isMerged = false;
+   const uint8_t data[4] = {1, 2, 3, 4};
+   uint8_t buf[4] = {0, 0, 0, 0};
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x20, &data[0], sizeof(data), &isMerged));
+   CuAssertIntEquals(tc, -2, apx_writeCoalescer_take(&coalescer, 0x20, &buf[0], 3u));
+   //the entry is left in place
+   CuAssertUIntEquals(tc, 1u, apx_writeCoalescer_length(&coalescer));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x20, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data[0], sizeof(data)));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_longerWriteKeepsTail(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   bool isMerged = false;
+   const uint8_t data1[4] = {1, 2, 3, 4};
+   const uint8_t data2[2] = {5, 6};
+   const uint8_t expected[4] = {5, 6, 3, 4};
+   uint8_t buf[4] = {0, 0, 0, 0};
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x20, &data1[0], sizeof(data1), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x20, &data2[0], sizeof(data2), &isMerged));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_getLength(&coalescer, 0x20));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x20, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &expected[0], sizeof(expected)));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_largeData(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   bool isMerged = false;
+   uint8_t data[APX_WRITE_COALESCER_INLINE_SIZE*4];
+   uint8_t buf[APX_WRITE_COALESCER_INLINE_SIZE*4];
+   uint32_t i;
+   for (i = 0; i < sizeof(data); i++)
+   {
+      data[i] = (uint8_t) i;
+   }
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x100, &data[0], APX_WRITE_COALESCER_INLINE_SIZE, &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x100, &data[0], sizeof(data), &isMerged));
+   CuAssertIntEquals(tc, (int32_t) sizeof(data), apx_writeCoalescer_getLength(&coalescer, 0x100));
+   CuAssertIntEquals(tc, (int32_t) sizeof(data), apx_writeCoalescer_take(&coalescer, 0x100, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data[0], sizeof(data)));
+   //the same slot can take inline data again
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x100, &data[1], 2u, &isMerged));
+   CuAssertIntEquals(tc, 2, apx_writeCoalescer_take(&coalescer, 0x100, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data[1], 2u));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_manyAddresses(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   bool isMerged = false;
+   uint32_t address;
+   const uint32_t numAddresses = 1000u;
+   apx_writeCoalescer_create(&coalescer);
+   for (address = 0u; address < numAddresses; address++)
+   {
+      uint8_t value = (uint8_t) address;
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, address*4u, &value, 1u, &isMerged));
+   }
+   CuAssertUIntEquals(tc, numAddresses, apx_writeCoalescer_length(&coalescer));
+   for (address = 0u; address < numAddresses; address++)
+   {
+      uint8_t value = 0u;
+      CuAssertIntEquals(tc, 1, apx_writeCoalescer_take(&coalescer, address*4u, &value, 1u));
+      CuAssertUIntEquals(tc, (uint8_t) address, value);
+   }
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&coalescer));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_removeKeepsProbeChain(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   bool isMerged = false;
+   uint32_t address;
+   const uint32_t numAddresses = 200u;
+   apx_writeCoalescer_create(&coalescer);
+   for (address = 0u; address < numAddresses; address++)
+   {
+      uint8_t value = (uint8_t) address;
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, address, &value, 1u, &isMerged));
+   }
+   for (address = 0u; address < numAddresses; address += 2u)
+   {
+      apx_writeCoalescer_remove(&coalescer, address);
+   }
+   CuAssertUIntEquals(tc, numAddresses/2u, apx_writeCoalescer_length(&coalescer));
+   for (address = 0u; address < numAddresses; address++)
+   {
+      int32_t expected = ( (address & 1u) != 0u )? 1 : -1;
+      CuAssertIntEquals(tc, expected, apx_writeCoalescer_getLength(&coalescer, address));
+   }
+   apx_writeCoalescer_clear(&coalescer);
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&coalescer));
+   CuAssertIntEquals(tc, -1, apx_writeCoalescer_getLength(&coalescer, 1u));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_overlappingWriteIsNotMerged(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   const uint8_t data1[4] = {1, 2, 3, 4};
+   const uint8_t data2[4] = {5, 6, 7, 8};
+   const uint8_t data3[4] = {9, 10, 11, 12};
+   const uint8_t data4[4] = {13, 14, 15, 16};
+   uint8_t buf[4] = {0, 0, 0, 0};
+   bool isMerged = false;
+   apx_writeCoalescer_create(&coalescer);
+   //queued messages: 0x10, 0x12
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data2[0], sizeof(data2), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   //Merging into 0x10 would send bytes 0x12-0x13 before the older ones of 0x12, a new entry (and message) is needed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data3[0], sizeof(data3), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertUIntEquals(tc, 3u, apx_writeCoalescer_length(&coalescer));
+   //The newest entry for 0x10 is the one behind 0x12, it accepts merges
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data4[0], sizeof(data4), &isMerged));
+   CuAssertTrue(tc, isMerged);
+   CuAssertUIntEquals(tc, 3u, apx_writeCoalescer_length(&coalescer));
+   //entries are taken in the same order as their messages were queued
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data1[0], sizeof(data1)));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x12, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data2[0], sizeof(data2)));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data4[0], sizeof(data4)));
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&coalescer));
+   //removeNewest rolls back the write that created the second entry
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x13, &data2[0], 1u, &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data3[0], sizeof(data3), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   apx_writeCoalescer_removeNewest(&coalescer, 0x10);
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data1[0], sizeof(data1)));
+   CuAssertIntEquals(tc, -1, apx_writeCoalescer_getLength(&coalescer, 0x10));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_overlapWithOlderEntryIsMerged(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   const uint8_t data1[4] = {1, 2, 3, 4};
+   const uint8_t data2[4] = {5, 6, 7, 8};
+   const uint8_t data3[4] = {9, 10, 11, 12};
+   uint8_t buf[4] = {0, 0, 0, 0};
+   bool isMerged = false;
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data2[0], sizeof(data2), &isMerged));
+   //0x10 is sent before 0x12 so the newer bytes of 0x12 still win
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data3[0], sizeof(data3), &isMerged));
+   CuAssertTrue(tc, isMerged);
+   CuAssertUIntEquals(tc, 2u, apx_writeCoalescer_length(&coalescer));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x12, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data3[0], sizeof(data3)));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_longerWriteOverlappingNewerIsNotMerged(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   const uint8_t data1[2] = {1, 2};
+   const uint8_t data2[2] = {3, 4};
+   const uint8_t data3[4] = {5, 6, 7, 8};
+   uint8_t buf[4] = {0, 0, 0, 0};
+   bool isMerged = false;
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data2[0], sizeof(data2), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   //growing 0x10 would reach into the newer entry at 0x12
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data3[0], sizeof(data3), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertUIntEquals(tc, 3u, apx_writeCoalescer_length(&coalescer));
+   CuAssertIntEquals(tc, 2, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data1[0], sizeof(data1)));
+   CuAssertIntEquals(tc, 2, apx_writeCoalescer_take(&coalescer, 0x12, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data3[0], sizeof(data3)));
+   //the grown entry is newest and overlaps the older 0x12 entry created after this point
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data2[0], sizeof(data2), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data3[0], sizeof(data3), &isMerged));
+   CuAssertTrue(tc, isMerged);
+   //0x12 is overlapped by the newer (grown) 0x10 entry and no longer accepts merges
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data1[0], sizeof(data1), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertUIntEquals(tc, 3u, apx_writeCoalescer_length(&coalescer));
+   apx_writeCoalescer_destroy(&coalescer);
+}
+
+static void test_apx_writeCoalescer_overlapSurvivesRehash(CuTest* tc)
+{
+   apx_writeCoalescer_t coalescer;
+   const uint8_t data1[4] = {1, 2, 3, 4};
+   const uint8_t data2[4] = {5, 6, 7, 8};
+   uint8_t buf[4] = {0, 0, 0, 0};
+   bool isMerged = false;
+   uint32_t address;
+   const uint32_t numAddresses = 200u;
+   apx_writeCoalescer_create(&coalescer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data1[0], sizeof(data1), &isMerged));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data2[0], sizeof(data2), &isMerged));
+   //the table grows several times and entries are moved around by removals
+   for (address = 0u; address < numAddresses; address++)
+   {
+      uint8_t value = (uint8_t) address;
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x1000u + address, &value, 1u, &isMerged));
+      CuAssertTrue(tc, !isMerged);
+   }
+   for (address = 0u; address < numAddresses; address += 2u)
+   {
+      apx_writeCoalescer_remove(&coalescer, 0x1000u + address);
+   }
+   //0x10 was flagged when 0x12 was created, the new 0x10 entry in turn flags the older 0x12 entry
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x10, &data2[0], sizeof(data2), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x12, &data1[0], sizeof(data1), &isMerged));
+   CuAssertTrue(tc, !isMerged);
+   for (address = 1u; address < numAddresses; address += 2u)
+   {
+      uint8_t value = 0u;
+      CuAssertIntEquals(tc, APX_NO_ERROR, apx_writeCoalescer_write(&coalescer, 0x1000u + address, &value, 1u, &isMerged));
+      CuAssertTrue(tc, isMerged);
+      CuAssertIntEquals(tc, 1, apx_writeCoalescer_take(&coalescer, 0x1000u + address, &value, 1u));
+   }
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data1[0], sizeof(data1)));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x12, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data2[0], sizeof(data2)));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x10, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data2[0], sizeof(data2)));
+   CuAssertIntEquals(tc, 4, apx_writeCoalescer_take(&coalescer, 0x12, &buf[0], sizeof(buf)));
+   CuAssertIntEquals(tc, 0, memcmp(&buf[0], &data1[0], sizeof(data1)));
+   CuAssertUIntEquals(tc, 0u, apx_writeCoalescer_length(&coalescer));
+   apx_writeCoalescer_destroy(&coalescer);
+}
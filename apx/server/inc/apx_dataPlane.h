@@ -0,0 +1,111 @@
+/*****************************************************************************
+* \file      apx_dataPlane.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Fixed pool of (optionally core-pinned) threads that runs the transmit side of server connections
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_DATA_PLANE_H
+#define APX_DATA_PLANE_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#else
+# include <pthread.h>
+#endif
+#include "osmacro.h"
+#include "apx_types.h"
+#include "apx_error.h"
+#include "apx_cfg.h"
+#include "apx_mpscRing.h"
+#include "apx_serverConnectionBase.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+struct apx_dataPlane_tag;
+
+typedef struct apx_dataPlaneLaneStats_tag
+{
+   uint32_t numConnections; //number of connections currently assigned to the lane
+   uint32_t numRuns; //number of times the lane has run a scheduled worker
+   uint32_t numRequeues; //number of times a worker used its full budget and was put back in the mailbox
+   uint32_t numDelays; //number of times a worker had to wait for its maximum update rate before being run again
+   uint32_t mailboxDepth; //number of workers waiting in the mailbox
+} apx_dataPlaneLaneStats_t;
+
+/**
+ * One data plane thread. Workers that have pending messages are pushed into the lane mailbox by whichever thread
+ * queued the message (typically the thread that routed port data to the connection). The lane is the only consumer.
+ */
+typedef struct apx_dataPlaneLane_tag
+{
+   struct apx_dataPlane_tag *parent;
+   apx_mpscRing_t mailbox; //elements are apx_fileManagerWorker_t pointers
+   THREAD_T thread;
+   volatile bool isThreadValid;
+   uint32_t laneId;
+   uint32_t cpu; //CPU the thread is pinned to (when pinning is enabled)
+   uint32_t numConnections; //protected by parent->lock
+   volatile uint32_t numRuns; //written by lane thread only
+   volatile uint32_t numRequeues; //written by lane thread only
+   volatile uint32_t numDelays; //written by lane thread only
+   struct apx_fileManagerWorker_tag *delayedHead; //workers waiting for their wakeup time, earliest first (lane thread only)
+#ifdef _MSC_VER
+   unsigned int threadId;
+#endif
+} apx_dataPlaneLane_t;
+
+typedef struct apx_dataPlane_tag
+{
+   apx_dataPlaneLane_t *lanes;
+   uint32_t numLanes;
+   bool pinThreads;
+   SPINLOCK_T lock; //protects lane assignment
+} apx_dataPlane_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_dataPlane_create(apx_dataPlane_t *self, int32_t numLanes, bool pinThreads);
+void apx_dataPlane_destroy(apx_dataPlane_t *self);
+apx_dataPlane_t *apx_dataPlane_new(int32_t numLanes, bool pinThreads);
+void apx_dataPlane_delete(apx_dataPlane_t *self);
+
+apx_error_t apx_dataPlane_start(apx_dataPlane_t *self);
+void apx_dataPlane_stop(apx_dataPlane_t *self);
+uint32_t apx_dataPlane_getNumLanes(apx_dataPlane_t *self);
+int32_t apx_dataPlane_attachConnection(apx_dataPlane_t *self, apx_serverConnectionBase_t *connection);
+void apx_dataPlane_detachConnection(apx_dataPlane_t *self, int32_t laneId);
+apx_error_t apx_dataPlane_getLaneStats(apx_dataPlane_t *self, int32_t laneId, apx_dataPlaneLaneStats_t *stats);
+uint32_t apx_dataPlane_getNumCpus(void);
+
+#ifdef UNIT_TEST
+int32_t apx_dataPlane_runLane(apx_dataPlane_t *self, int32_t laneId);
+#endif
+
+#endif //APX_DATA_PLANE_H
@@ -17,6 +17,8 @@
 #include "apx_portSignatureMap.h"
 #include "apx_eventListener.h"
 #include "apx_connectionManager.h"
+#include "apx_dataPlane.h"
+#include "apx_definitionCache.h"
 #include "apx_eventLoop.h"
 #include "apx_nodeInstance.h"
 #include "soa.h"
@@ -34,18 +36,21 @@ typedef struct apx_server_tag
 {
    adt_list_t serverEventListeners; //weak references to apx_serverEventListener_t
    apx_portSignatureMap_t portSignatureMap; //This is the global map that is used to build all port connectors.
-                                            //Any access to this structure must be protected by acquiring the globalLock.
+                                            //Any access to this structure must be protected by locking the affected stripes,
+                                            //see apx_server_lockPortSignatures.
    apx_connectionManager_t connectionManager; //server connections
+   apx_dataPlane_t *dataPlane; //optional. When set, connection workers run on the data plane lanes instead of their own threads
+   apx_definitionCache_t definitionCache; //node definitions already built by this server, shared by all connections
    adt_list_t extensionManager; //TODO: replace with extensionManager class
    adt_ary_t modifiedNodes; //weak references to apx_nodeInstance_t. Used to keep track of which nodes have modified port connectors.
+                            //Nodes of concurrent connect/disconnect operations are kept apart by their portSignatureStripes.
    THREAD_T eventThread; //local worker thread (for playing server-global events such as log events)
    bool isEventThreadValid; //true if workerThread is a valid variable
    soa_t soa; //small object allocator
    apx_eventLoop_t eventLoop; //event loop used by workerThread
    MUTEX_T eventLoopLock; //for protecting the event loop
-   MUTEX_T globalLock; //Protects the portSignatureMap and connectionManager
-                       //synchronize data routing execution as well as
-                       //controlling access to the global portSignatureMap.
+   MUTEX_T globalLock; //Protects the connectionManager and server shutdown
+   MUTEX_T modifiedNodesLock; //Protects modifiedNodes
    SPINLOCK_T eventListenerLock; //Used to protect access to serverEventListeners
 #ifdef _MSC_VER
    unsigned int threadId;
@@ -66,6 +71,8 @@ apx_server_t *apx_server_new(void);
 void apx_server_delete(apx_server_t *self);
 void apx_server_start(apx_server_t *self);
 void apx_server_stop(apx_server_t *self);
+apx_error_t apx_server_setDataPlaneConfig(apx_server_t *self, int32_t numLanes, bool pinThreads);
+apx_error_t apx_server_setNodeImageDirectory(apx_server_t *self, const char *directory);
 void* apx_server_registerEventListener(apx_server_t *self, apx_serverEventListener_t *eventListener);
 void apx_server_unregisterEventListener(apx_server_t *self, void *handle);
 void apx_server_acceptConnection(apx_server_t *self, apx_serverConnectionBase_t *serverConnection);
@@ -74,6 +81,9 @@ apx_error_t apx_server_addExtension(apx_server_t *self, const char *name, apx_se
 void apx_server_logEvent(apx_server_t *self, apx_logLevel_t level, const char *label, const char *msg);
 void apx_server_takeGlobalLock(apx_server_t *self);
 void apx_server_releaseGlobalLock(apx_server_t *self);
+uint32_t apx_server_lockPortSignatures(apx_server_t *self, apx_nodeInstance_t *nodeInstance);
+uint32_t apx_server_lockPortSignaturesForNodes(apx_server_t *self, adt_ary_t *nodeInstanceArray);
+void apx_server_unlockPortSignatures(apx_server_t *self, uint32_t stripeMask);
 apx_error_t apx_server_connectNodeInstanceProvidePorts(apx_server_t *self, apx_nodeInstance_t *nodeInstance);
 apx_error_t apx_server_connectNodeInstanceRequirePorts(apx_server_t *self, apx_nodeInstance_t *nodeInstance);
 apx_error_t apx_server_disconnectNodeInstanceProvidePorts(apx_server_t *self, apx_nodeInstance_t *nodeInstance);
@@ -82,7 +92,8 @@ apx_error_t apx_server_processRequirePortConnectorChanges(apx_server_t *self, ap
 apx_error_t apx_server_processProvidePortConnectorChanges(apx_server_t *self, apx_nodeInstance_t *provideNodeInstance, apx_portConnectorChangeTable_t *connectorChanges);
 apx_error_t apx_server_insertModifiedNode(apx_server_t *self, apx_nodeInstance_t *nodeInstance);
 adt_ary_t *apx_server_getModifiedNodes(const apx_server_t *self);
-void apx_server_clearPortConnectorChanges(apx_server_t *self);
+void apx_server_clearPortConnectorChanges(apx_server_t *self, uint32_t stripeMask);
+apx_definitionCache_t *apx_server_getDefinitionCache(apx_server_t *self);
 
 
 #ifdef UNIT_TEST
@@ -54,6 +54,7 @@ typedef struct apx_serverConnectionBase_tag
    bool isGreetingParsed;
    bool isActive;
    adt_str_t *tag; //optional tag
+   int32_t dataPlaneLane; //index of the data plane lane running this connection's worker, -1 when it has its own worker thread
 }apx_serverConnectionBase_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -70,6 +71,8 @@ void apx_serverConnectionBase_defaultEventHandler(void *arg, apx_event_t *event)
 void apx_serverConnectionBase_connectNotify(apx_serverConnectionBase_t *self, uint32_t connectionId);
 void apx_serverConnectionBase_disconnectNotify(apx_serverConnectionBase_t *self);
 void apx_serverConnectionBase_setServer(apx_serverConnectionBase_t *self, struct apx_server_tag *server);
+apx_error_t apx_serverConnectionBase_setTag(apx_serverConnectionBase_t *self, const char *tag);
+const char *apx_serverConnectionBase_getTag(apx_serverConnectionBase_t *self);
 uint32_t apx_serverConnectionBase_getConnectionId(apx_serverConnectionBase_t *self);
 void apx_serverConnectionBase_close(apx_serverConnectionBase_t *self);
 
@@ -0,0 +1,533 @@
+/*****************************************************************************
+* \file      apx_dataPlane.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Fixed pool of (optionally core-pinned) threads that runs the transmit side of server connections
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef __linux__
+# ifndef _GNU_SOURCE
+# define _GNU_SOURCE //needed for pthread_setaffinity_np
+# endif
+# include <sched.h>
+#endif
+#include <stdio.h>
+#include <malloc.h>
+#include <assert.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include "apx_dataPlane.h"
+#include "apx_fileManagerWorker.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#ifdef _MSC_VER
+# define ATOMIC_LOAD(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+# define ATOMIC_STORE(p, v) ((void) InterlockedExchange((volatile LONG*) (p), (LONG) (v)))
+#else
+# define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_dataPlaneLane_create(apx_dataPlaneLane_t *self, apx_dataPlane_t *parent, uint32_t laneId, uint32_t cpu);
+static void apx_dataPlaneLane_destroy(apx_dataPlaneLane_t *self);
+static apx_error_t apx_dataPlaneLane_startThread(apx_dataPlaneLane_t *self);
+static void apx_dataPlaneLane_stopThread(apx_dataPlaneLane_t *self);
+static bool apx_dataPlaneLane_runNext(apx_dataPlaneLane_t *self);
+static void apx_dataPlaneLane_delayWorker(apx_dataPlaneLane_t *self, apx_fileManagerWorker_t *worker, uint32_t delayMs);
+static apx_fileManagerWorker_t *apx_dataPlaneLane_popDueWorker(apx_dataPlaneLane_t *self);
+static uint32_t apx_dataPlaneLane_timeUntilDue(apx_dataPlaneLane_t *self);
+static uint32_t apx_dataPlane_getTickCount(void);
+static void apx_dataPlaneLane_pinThread(apx_dataPlaneLane_t *self);
+static apx_error_t apx_dataPlane_scheduleWorker(void *arg, apx_fileManagerWorker_t *worker);
+static THREAD_PROTO(laneThread, arg);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates a data plane with numLanes lanes. A negative numLanes creates one lane per online CPU.
+ */
+apx_error_t apx_dataPlane_create(apx_dataPlane_t *self, int32_t numLanes, bool pinThreads)
+{
+   if ( (self != 0) && (numLanes != 0) )
+   {
+      uint32_t i;
+      uint32_t numCpus = apx_dataPlane_getNumCpus();
+      uint32_t laneCount = (numLanes < 0)? numCpus : (uint32_t) numLanes;
+      if (laneCount > APX_DATA_PLANE_MAX_LANES)
+      {
+         laneCount = APX_DATA_PLANE_MAX_LANES;
+      }
+      self->lanes = (apx_dataPlaneLane_t*) malloc(laneCount * sizeof(apx_dataPlaneLane_t));
+      if (self->lanes == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      for (i = 0u; i < laneCount; i++)
+      {
+         apx_error_t result = apx_dataPlaneLane_create(&self->lanes[i], self, i, i % numCpus);
+         if (result != APX_NO_ERROR)
+         {
+            while (i > 0u)
+            {
+               apx_dataPlaneLane_destroy(&self->lanes[--i]);
+            }
+            free(self->lanes);
+            self->lanes = (apx_dataPlaneLane_t*) 0;
+            return result;
+         }
+      }
+      self->numLanes = laneCount;
+      self->pinThreads = pinThreads;
+      SPINLOCK_INIT(self->lock);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * All connections attached to the data plane must have been stopped (or deleted) before this is called
+ */
+void apx_dataPlane_destroy(apx_dataPlane_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      apx_dataPlane_stop(self);
+      for (i = 0u; i < self->numLanes; i++)
+      {
+         apx_dataPlaneLane_destroy(&self->lanes[i]);
+      }
+      free(self->lanes);
+      self->lanes = (apx_dataPlaneLane_t*) 0;
+      self->numLanes = 0u;
+      SPINLOCK_DESTROY(self->lock);
+   }
+}
+
+apx_dataPlane_t *apx_dataPlane_new(int32_t numLanes, bool pinThreads)
+{
+   apx_dataPlane_t *self = (apx_dataPlane_t*) malloc(sizeof(apx_dataPlane_t));
+   if (self != 0)
+   {
+      apx_error_t result = apx_dataPlane_create(self, numLanes, pinThreads);
+      if (result != APX_NO_ERROR)
+      {
+         free(self);
+         self = (apx_dataPlane_t*) 0;
+      }
+   }
+   return self;
+}
+
+void apx_dataPlane_delete(apx_dataPlane_t *self)
+{
+   if (self != 0)
+   {
+      apx_dataPlane_destroy(self);
+      free(self);
+   }
+}
+
+apx_error_t apx_dataPlane_start(apx_dataPlane_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      for (i = 0u; i < self->numLanes; i++)
+      {
+         apx_error_t result = apx_dataPlaneLane_startThread(&self->lanes[i]);
+         if (result != APX_NO_ERROR)
+         {
+            apx_dataPlane_stop(self);
+            return result;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_dataPlane_stop(apx_dataPlane_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      for (i = 0u; i < self->numLanes; i++)
+      {
+         apx_dataPlaneLane_stopThread(&self->lanes[i]);
+      }
+   }
+}
+
+uint32_t apx_dataPlane_getNumLanes(apx_dataPlane_t *self)
+{
+   if (self != 0)
+   {
+      return self->numLanes;
+   }
+   return 0u;
+}
+
+/**
+ * Assigns the connection to the lane with the fewest connections and lets that lane run its file manager worker.
+ * Must be called before the connection is started. Returns the lane ID or -1 on failure.
+ */
+int32_t apx_dataPlane_attachConnection(apx_dataPlane_t *self, apx_serverConnectionBase_t *connection)
+{
+   if ( (self != 0) && (connection != 0) && (self->numLanes > 0u) )
+   {
+      uint32_t i;
+      apx_dataPlaneLane_t *lane = &self->lanes[0];
+      SPINLOCK_ENTER(self->lock);
+      for (i = 1u; i < self->numLanes; i++)
+      {
+         if (self->lanes[i].numConnections < lane->numConnections)
+         {
+            lane = &self->lanes[i];
+         }
+      }
+      lane->numConnections++;
+      SPINLOCK_LEAVE(self->lock);
+      apx_connectionBase_setWorkerScheduler(&connection->base, apx_dataPlane_scheduleWorker, (void*) lane);
+      return (int32_t) lane->laneId;
+   }
+   return -1;
+}
+
+/**
+ * Releases the lane slot of a connection. The connection keeps using the lane until its worker has been stopped.
+ */
+void apx_dataPlane_detachConnection(apx_dataPlane_t *self, int32_t laneId)
+{
+   if ( (self != 0) && (laneId >= 0) && ((uint32_t) laneId < self->numLanes) )
+   {
+      apx_dataPlaneLane_t *lane = &self->lanes[laneId];
+      SPINLOCK_ENTER(self->lock);
+      assert(lane->numConnections > 0u);
+      lane->numConnections--;
+      SPINLOCK_LEAVE(self->lock);
+   }
+}
+
+apx_error_t apx_dataPlane_getLaneStats(apx_dataPlane_t *self, int32_t laneId, apx_dataPlaneLaneStats_t *stats)
+{
+   if ( (self != 0) && (laneId >= 0) && ((uint32_t) laneId < self->numLanes) && (stats != 0) )
+   {
+      apx_dataPlaneLane_t *lane = &self->lanes[laneId];
+      SPINLOCK_ENTER(self->lock);
+      stats->numConnections = lane->numConnections;
+      SPINLOCK_LEAVE(self->lock);
+      stats->numRuns = ATOMIC_LOAD(&lane->numRuns);
+      stats->numRequeues = ATOMIC_LOAD(&lane->numRequeues);
+      stats->numDelays = ATOMIC_LOAD(&lane->numDelays);
+      stats->mailboxDepth = apx_mpscRing_length(&lane->mailbox);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+uint32_t apx_dataPlane_getNumCpus(void)
+{
+#ifdef _WIN32
+   SYSTEM_INFO info;
+   GetSystemInfo(&info);
+   return (info.dwNumberOfProcessors > 0)? (uint32_t) info.dwNumberOfProcessors : 1u;
+#else
+   long result = sysconf(_SC_NPROCESSORS_ONLN);
+   return (result > 0)? (uint32_t) result : 1u;
+#endif
+}
+
+#ifdef UNIT_TEST
+/**
+ * Runs scheduled workers on the calling thread until the lane mailbox is empty. Returns the number of worker runs.
+ * Only use this on data planes that have not been started.
+ */
+int32_t apx_dataPlane_runLane(apx_dataPlane_t *self, int32_t laneId)
+{
+   int32_t numRuns = 0;
+   if ( (self != 0) && (laneId >= 0) && ((uint32_t) laneId < self->numLanes) )
+   {
+      apx_dataPlaneLane_t *lane = &self->lanes[laneId];
+      assert(lane->isThreadValid == false);
+      while (apx_dataPlaneLane_runNext(lane))
+      {
+         numRuns++;
+      }
+   }
+   return numRuns;
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_dataPlaneLane_create(apx_dataPlaneLane_t *self, apx_dataPlane_t *parent, uint32_t laneId, uint32_t cpu)
+{
+   apx_error_t result = apx_mpscRing_create(&self->mailbox, (uint32_t) sizeof(apx_fileManagerWorker_t*), APX_DATA_PLANE_MAILBOX_SIZE);
+   if (result == APX_NO_ERROR)
+   {
+      self->parent = parent;
+      self->isThreadValid = false;
+      self->laneId = laneId;
+      self->cpu = cpu;
+      self->numConnections = 0u;
+      self->numRuns = 0u;
+      self->numRequeues = 0u;
+      self->numDelays = 0u;
+      self->delayedHead = (apx_fileManagerWorker_t*) 0;
+#ifdef _MSC_VER
+      self->threadId = 0u;
+#endif
+   }
+   return result;
+}
+
+static void apx_dataPlaneLane_destroy(apx_dataPlaneLane_t *self)
+{
+   apx_mpscRing_destroy(&self->mailbox);
+}
+
+static apx_error_t apx_dataPlaneLane_startThread(apx_dataPlaneLane_t *self)
+{
+   if (self->isThreadValid == false)
+   {
+#ifdef _WIN32
+      THREAD_CREATE(self->thread, laneThread, self, self->threadId);
+      if (self->thread == INVALID_HANDLE_VALUE)
+      {
+         return APX_THREAD_CREATE_ERROR;
+      }
+#else
+      if (THREAD_CREATE(self->thread, laneThread, self) != 0)
+      {
+         return APX_THREAD_CREATE_ERROR;
+      }
+#endif
+      self->isThreadValid = true;
+   }
+   return APX_NO_ERROR;
+}
+
+static void apx_dataPlaneLane_stopThread(apx_dataPlaneLane_t *self)
+{
+   if (self->isThreadValid == true)
+   {
+#ifdef _MSC_VER
+      DWORD result;
+#endif
+      apx_mpscRing_interrupt(&self->mailbox);
+#ifdef _MSC_VER
+      result = WaitForSingleObject(self->thread, 5000);
+      if (result == WAIT_TIMEOUT)
+      {
+         fprintf(stderr, "[APX_DATA_PLANE] timeout while joining lane %u\n", (unsigned int) self->laneId);
+      }
+      CloseHandle(self->thread);
+      self->thread = INVALID_HANDLE_VALUE;
+#else
+      if (pthread_equal(pthread_self(), self->thread) == 0)
+      {
+         void *status;
+         int s = pthread_join(self->thread, &status);
+         if (s != 0)
+         {
+            printf("[APX_DATA_PLANE] pthread_join error %d\n", s);
+         }
+      }
+      else
+      {
+         printf("[APX_DATA_PLANE] pthread_join attempted on pthread_self()\n");
+      }
+#endif
+      self->isThreadValid = false;
+   }
+}
+
+/**
+ * Runs the first delayed worker whose wakeup time has passed, otherwise pops one worker from the mailbox and runs it.
+ * A worker that still has messages after using its budget goes to the back of the mailbox so that one busy connection
+ * cannot starve the other connections on the same lane. A worker held back by its maximum update rate is put in the
+ * delayed list instead, the lane keeps running other workers meanwhile.
+ * Returns false when there was no worker to run.
+ */
+static bool apx_dataPlaneLane_runNext(apx_dataPlaneLane_t *self)
+{
+   apx_fileManagerWorker_t *worker = apx_dataPlaneLane_popDueWorker(self);
+   if ( (worker != 0) || apx_mpscRing_pop(&self->mailbox, &worker) )
+   {
+      uint32_t delayMs = 0u;
+      ATOMIC_STORE(&self->numRuns, self->numRuns + 1u);
+      if (apx_fileManagerWorker_runScheduled(worker, APX_DATA_PLANE_RUN_BUDGET, &delayMs))
+      {
+         if (delayMs > 0u)
+         {
+            ATOMIC_STORE(&self->numDelays, self->numDelays + 1u);
+            apx_dataPlaneLane_delayWorker(self, worker, delayMs);
+         }
+         else
+         {
+            ATOMIC_STORE(&self->numRequeues, self->numRequeues + 1u);
+            if (apx_mpscRing_push(&self->mailbox, &worker) != APX_NO_ERROR)
+            {
+               //The worker is still scheduled, it must not get lost. The delayed list never fails.
+               apx_dataPlaneLane_delayWorker(self, worker, 0u);
+            }
+         }
+      }
+      return true;
+   }
+   return false;
+}
+
+/**
+ * Inserts worker into the delayed list, which is sorted by wakeup time. The list links through the worker itself,
+ * which belongs to the lane for as long as it stays scheduled.
+ */
+static void apx_dataPlaneLane_delayWorker(apx_dataPlaneLane_t *self, apx_fileManagerWorker_t *worker, uint32_t delayMs)
+{
+   apx_fileManagerWorker_t **link = &self->delayedHead;
+   worker->schedulerWakeupTime = apx_dataPlane_getTickCount() + delayMs;
+   while ( (*link != 0) && ( (int32_t) (worker->schedulerWakeupTime - (*link)->schedulerWakeupTime) >= 0) )
+   {
+      link = &(*link)->schedulerNext;
+   }
+   worker->schedulerNext = *link;
+   *link = worker;
+}
+
+static apx_fileManagerWorker_t *apx_dataPlaneLane_popDueWorker(apx_dataPlaneLane_t *self)
+{
+   apx_fileManagerWorker_t *worker = self->delayedHead;
+   if ( (worker != 0) && ( (int32_t) (apx_dataPlane_getTickCount() - worker->schedulerWakeupTime) >= 0) )
+   {
+      self->delayedHead = worker->schedulerNext;
+      worker->schedulerNext = (apx_fileManagerWorker_t*) 0;
+      return worker;
+   }
+   return (apx_fileManagerWorker_t*) 0;
+}
+
+/**
+ * Returns how long the lane may wait for its mailbox before the first delayed worker is due
+ */
+static uint32_t apx_dataPlaneLane_timeUntilDue(apx_dataPlaneLane_t *self)
+{
+   if (self->delayedHead != 0)
+   {
+      int32_t remaining = (int32_t) (self->delayedHead->schedulerWakeupTime - apx_dataPlane_getTickCount());
+      return (remaining > 0)? (uint32_t) remaining : 0u;
+   }
+   return APX_MPSC_RING_WAIT_FOREVER;
+}
+
+static uint32_t apx_dataPlane_getTickCount(void)
+{
+#ifdef _MSC_VER
+   return (uint32_t) GetTickCount();
+#else
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (uint32_t) ( ((uint64_t) now.tv_sec) * 1000u + ((uint64_t) now.tv_nsec) / 1000000u );
+#endif
+}
+
+static void apx_dataPlaneLane_pinThread(apx_dataPlaneLane_t *self)
+{
+   if (self->parent->pinThreads)
+   {
+#if defined(_WIN32)
+      if (SetThreadAffinityMask(GetCurrentThread(), ((DWORD_PTR) 1u) << self->cpu) == 0)
+      {
+         fprintf(stderr, "[APX_DATA_PLANE] failed to pin lane %u to CPU %u\n", (unsigned int) self->laneId, (unsigned int) self->cpu);
+      }
+#elif defined(__linux__)
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(self->cpu, &cpuSet);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)
+      {
+         fprintf(stderr, "[APX_DATA_PLANE] failed to pin lane %u to CPU %u\n", (unsigned int) self->laneId, (unsigned int) self->cpu);
+      }
+#endif
+   }
+}
+
+/**
+ * Called by the thread that queued a message for an idle worker. This is the only cross-thread handoff in the data plane.
+ * The mailbox only fails when its overflow queue cannot grow, the worker then stays idle until its next message.
+ */
+static apx_error_t apx_dataPlane_scheduleWorker(void *arg, apx_fileManagerWorker_t *worker)
+{
+   apx_dataPlaneLane_t *lane = (apx_dataPlaneLane_t*) arg;
+   apx_error_t result;
+   assert(lane != 0);
+   result = apx_mpscRing_push(&lane->mailbox, &worker);
+   if (result != APX_NO_ERROR)
+   {
+      fprintf(stderr, "[APX_DATA_PLANE] lane %u failed to schedule worker, error %d\n", (unsigned int) lane->laneId, (int) result);
+   }
+   return result;
+}
+
+static THREAD_PROTO(laneThread, arg)
+{
+   apx_dataPlaneLane_t *self = (apx_dataPlaneLane_t*) arg;
+   if (self != 0)
+   {
+      apx_dataPlaneLane_pinThread(self);
+      for (;;)
+      {
+         if (!apx_dataPlaneLane_runNext(self))
+         {
+            if (apx_mpscRing_isInterrupted(&self->mailbox))
+            {
+               break;
+            }
+            (void) apx_mpscRing_wait(&self->mailbox, apx_dataPlaneLane_timeUntilDue(self));
+         }
+      }
+   }
+   THREAD_RETURN(0);
+}
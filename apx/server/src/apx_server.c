@@ -8,6 +8,7 @@
 #include "apx_eventListener.h"
 #include "apx_logEvent.h"
 #include <string.h>
+#include <stdlib.h>
 #include <malloc.h>
 #include <stdio.h> //DEBUG ONLY
 #include <assert.h>
@@ -23,6 +24,13 @@
 //////////////////////////////////////////////////////////////////////////////
 #define MAX_LOG_LEN 1024
 
+typedef struct apx_server_resyncRange_tag
+{
+   apx_nodeInstance_t *nodeInstance;
+   uint32_t beginOffset;
+   uint32_t endOffset;
+} apx_server_resyncRange_t;
+
 //////////////////////////////////////////////////////////////////////////////
 // LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////////
@@ -33,6 +41,11 @@ static void apx_server_triggerLogEvent(apx_server_t *self, apx_logLevel_t level,
 static void apx_server_initExtensions(apx_server_t *self);
 static void apx_server_shutdownExtensions(apx_server_t *self);
 static void apx_server_handleEvent(void *arg, apx_event_t *event);
+static apx_error_t apx_server_processNewProvidePortConnectors(apx_portRef_t *providePortRef, apx_portConnectorChangeEntry_t *entry);
+static apx_error_t apx_server_resyncRequirePorts(apx_nodeInstance_t *provideNodeInstance, apx_portConnectorChangeTable_t *connectorChanges);
+static int apx_server_compareResyncRanges(const void *a, const void *b);
+static uint32_t apx_server_lockPortSignaturesInternal(apx_server_t *self, apx_nodeInstance_t *nodeInstance, adt_ary_t *nodeInstanceArray);
+static uint32_t apx_server_calcAffectedStripes(apx_server_t *self, apx_nodeInstance_t *nodeInstance, adt_ary_t *nodeInstanceArray);
 #ifndef UNIT_TEST
 static apx_error_t apx_server_startThread(apx_server_t *self);
 static apx_error_t apx_server_stopThread(apx_server_t *self);
@@ -58,6 +71,8 @@ void apx_server_create(apx_server_t *self)
       adt_list_create(&self->serverEventListeners, apx_serverEventListener_vdelete);
       apx_portSignatureMap_create(&self->portSignatureMap);
       apx_connectionManager_create(&self->connectionManager);
+      self->dataPlane = (apx_dataPlane_t*) 0;
+      apx_definitionCache_create(&self->definitionCache, APX_DEFINITION_CACHE_MAX_ENTRIES);
       adt_list_create(&self->extensionManager, apx_serverExtension_vdelete);
       adt_ary_create(&self->modifiedNodes, (void(*)(void*)) 0);
       soa_init(&self->soa);
@@ -65,6 +80,7 @@ void apx_server_create(apx_server_t *self)
       self->isEventThreadValid = false;
       MUTEX_INIT(self->eventLoopLock);
       MUTEX_INIT(self->globalLock);
+      MUTEX_INIT(self->modifiedNodesLock);
       SPINLOCK_INIT(self->eventListenerLock);
 #ifdef _MSC_VER
       self->threadId = 0u;
@@ -85,11 +101,19 @@ void apx_server_destroy(apx_server_t *self)
       adt_list_destroy(&self->serverEventListeners);
       SPINLOCK_LEAVE(self->eventListenerLock);
       apx_connectionManager_destroy(&self->connectionManager);
+      if (self->dataPlane != 0)
+      {
+         //deleted after the connections since each connection worker is stopped through its lane
+         apx_dataPlane_delete(self->dataPlane);
+         self->dataPlane = (apx_dataPlane_t*) 0;
+      }
       apx_portSignatureMap_destroy(&self->portSignatureMap);
+      apx_definitionCache_destroy(&self->definitionCache);
       MUTEX_UNLOCK(self->globalLock);
       apx_eventLoop_destroy(&self->eventLoop);
       MUTEX_DESTROY(self->eventLoopLock);
       MUTEX_DESTROY(self->globalLock);
+      MUTEX_DESTROY(self->modifiedNodesLock);
       SPINLOCK_DESTROY(self->eventListenerLock);
    }
 }
@@ -119,6 +143,14 @@ void apx_server_start(apx_server_t *self)
    if( self != 0 )
    {
       apx_server_initExtensions(self);
+      if (self->dataPlane != 0)
+      {
+         apx_error_t result = apx_dataPlane_start(self->dataPlane);
+         if (result != APX_NO_ERROR)
+         {
+            fprintf(stderr, "[SERVER] Failed to start data plane (error %d)\n", (int) result);
+         }
+      }
 #ifndef UNIT_TEST
       apx_connectionManager_start(&self->connectionManager);
       if (self->isEventThreadValid == false)
@@ -148,9 +180,48 @@ void apx_server_stop(apx_server_t *self)
    }
 }
 
+/**
+ * Runs the transmit side of all connections on a data plane with numLanes threads instead of one worker thread
+ * per connection. A negative numLanes creates one lane per CPU, 0 disables the data plane.
+ * When pinThreads is true each lane is pinned to its own CPU. Must be called before apx_server_start.
+ */
+apx_error_t apx_server_setDataPlaneConfig(apx_server_t *self, int32_t numLanes, bool pinThreads)
+{
+   if (self != 0)
+   {
+      if (self->dataPlane != 0)
+      {
+         return APX_INVALID_STATE_ERROR;
+      }
+      if (numLanes != 0)
+      {
+         self->dataPlane = apx_dataPlane_new(numLanes, pinThreads);
+         if (self->dataPlane == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
 
-
-
+/**
+ * Saves node definitions parsed by the server as compiled images in directory and loads them from there
+ * when a node announces a definition digest that is not in memory. NULL or an empty string turns it off.
+ */
+apx_error_t apx_server_setNodeImageDirectory(apx_server_t *self, const char *directory)
+{
+   if (self != 0)
+   {
+      if ( (directory != 0) && (directory[0] == '\0') )
+      {
+         directory = (const char*) 0;
+      }
+      return apx_definitionCache_setImageDirectory(&self->definitionCache, directory, APX_SERVER_MODE);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
 
 void* apx_server_registerEventListener(apx_server_t *self, apx_serverEventListener_t *eventListener)
 {
@@ -196,6 +267,11 @@ void apx_server_detachConnection(apx_server_t *self, apx_serverConnectionBase_t
    if ( (self != 0) && (serverConnection != 0))
    {
       apx_connectionManager_detach(&self->connectionManager, serverConnection);
+      if (serverConnection->dataPlaneLane >= 0)
+      {
+         apx_dataPlane_detachConnection(self->dataPlane, serverConnection->dataPlaneLane);
+         serverConnection->dataPlaneLane = -1;
+      }
       apx_serverConnectionBase_disconnectNotify(serverConnection);
       apx_server_triggerDisconnectedEvent(self, serverConnection);
    }
@@ -279,6 +355,42 @@ void apx_server_releaseGlobalLock(apx_server_t *self)
    }
 }
 
+/**
+ * Locks the portSignatureMap stripes needed to connect or disconnect the ports of nodeInstance.
+ * Besides the stripes used by nodeInstance itself this also includes the stripes of every node sharing a port signature with it,
+ * since the port connector change tables of those nodes are modified as well.
+ * Operations on nodes with unrelated port signatures can therefore run in parallel.
+ * Returns the stripe mask that must later be passed to apx_server_clearPortConnectorChanges and apx_server_unlockPortSignatures.
+ */
+uint32_t apx_server_lockPortSignatures(apx_server_t *self, apx_nodeInstance_t *nodeInstance)
+{
+   if ( (self != 0) && (nodeInstance != 0) )
+   {
+      return apx_server_lockPortSignaturesInternal(self, nodeInstance, (adt_ary_t*) 0);
+   }
+   return 0u;
+}
+
+/**
+ * Same as apx_server_lockPortSignatures but for all nodes in nodeInstanceArray (weak references to apx_nodeInstance_t)
+ */
+uint32_t apx_server_lockPortSignaturesForNodes(apx_server_t *self, adt_ary_t *nodeInstanceArray)
+{
+   if ( (self != 0) && (nodeInstanceArray != 0) )
+   {
+      return apx_server_lockPortSignaturesInternal(self, (apx_nodeInstance_t*) 0, nodeInstanceArray);
+   }
+   return 0u;
+}
+
+void apx_server_unlockPortSignatures(apx_server_t *self, uint32_t stripeMask)
+{
+   if (self != 0)
+   {
+      apx_portSignatureMap_unlockStripes(&self->portSignatureMap, stripeMask);
+   }
+}
+
 apx_error_t apx_server_connectNodeInstanceProvidePorts(apx_server_t *self, apx_nodeInstance_t *nodeInstance)
 {
    if ( (self != 0) && (nodeInstance != 0) )
@@ -316,7 +428,7 @@ apx_error_t apx_server_disconnectNodeInstanceRequirePorts(apx_server_t *self, ap
 }
 
 /**
- * Is is assumed that the server global lock is held by the caller of this function
+ * Is is assumed that the caller holds the port signature stripes of requireNodeInstance (see apx_server_lockPortSignatures)
  */
 apx_error_t apx_server_processRequirePortConnectorChanges(apx_server_t *self, apx_nodeInstance_t *requireNodeInstance, apx_portConnectorChangeTable_t *connectorChanges)
 {
@@ -362,7 +474,9 @@ apx_error_t apx_server_processRequirePortConnectorChanges(apx_server_t *self, ap
 }
 
 /**
- * Is is assumed that the server global lock is held by the caller of this function
+ * Is is assumed that the caller holds the port signature stripes of provideNodeInstance (see apx_server_lockPortSignatures).
+ * All new connectors are inserted before the connector table is unlocked, publishing a single new routing plan.
+ * Initial values are copied to the require ports after that, using one write per connected require node.
  */
 apx_error_t apx_server_processProvidePortConnectorChanges(apx_server_t *self, apx_nodeInstance_t *provideNodeInstance, apx_portConnectorChangeTable_t *connectorChanges)
 {
@@ -370,63 +484,36 @@ apx_error_t apx_server_processProvidePortConnectorChanges(apx_server_t *self, ap
    {
       apx_portCount_t numProvidePorts;
       apx_portId_t providePortId;
+      apx_error_t rc = APX_NO_ERROR;
       numProvidePorts = apx_nodeInstance_getNumProvidePorts(provideNodeInstance);
       assert(connectorChanges->numPorts == numProvidePorts);
       apx_nodeInstance_lockPortConnectorTable(provideNodeInstance);
-      for (providePortId = 0u; providePortId < numProvidePorts; providePortId++)
+      for (providePortId = 0u; (providePortId < numProvidePorts) && (rc == APX_NO_ERROR); providePortId++)
       {
-         apx_portRef_t *providePortRef;
-         apx_portConnectorChangeEntry_t *entry;
-         entry = apx_portConnectorChangeTable_getEntry(connectorChanges, providePortId);
-         providePortRef = apx_nodeInstance_getProvidePortRef(provideNodeInstance, providePortId);
-         assert(entry != 0);
-         assert(providePortRef != 0);
-         if (entry->count > 0)
-         {
-            if (entry->count == 1)
-            {
-               apx_error_t rc;
-               apx_portRef_t *requirePortRef = entry->data.portRef;
-               assert(requirePortRef != 0);
-               rc = apx_nodeInstance_handleProvidePortWasConnectedToRequirePort(providePortRef, requirePortRef);
-               if (rc != APX_NO_ERROR)
-               {
-                  apx_nodeInstance_unlockPortConnectorTable(provideNodeInstance);
-                  return rc;
-               }
-            }
-            else
-            {
-               int32_t i;
-               for(i=0; i < entry->count; i++)
-               {
-                  apx_error_t rc;
-                  apx_portRef_t *requirePortRef = adt_ary_value(entry->data.array, i);
-                  assert(requirePortRef != 0);
-                  rc = apx_nodeInstance_handleProvidePortWasConnectedToRequirePort(providePortRef, requirePortRef);
-                  if (rc != APX_NO_ERROR)
-                  {
-                     apx_nodeInstance_unlockPortConnectorTable(provideNodeInstance);
-                     return rc;
-                  }
-               }
-            }
-         }
+         rc = apx_server_processNewProvidePortConnectors(apx_nodeInstance_getProvidePortRef(provideNodeInstance, providePortId),
+               apx_portConnectorChangeTable_getEntry(connectorChanges, providePortId));
       }
       apx_nodeInstance_unlockPortConnectorTable(provideNodeInstance);
-      return APX_NO_ERROR;
+      if (rc == APX_NO_ERROR)
+      {
+         rc = apx_server_resyncRequirePorts(provideNodeInstance, connectorChanges);
+      }
+      return rc;
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
 /**
- * Note: Should only be used when caller holds globalLock
+ * Note: Should only be used when caller holds the port signature stripes of nodeInstance
  */
 apx_error_t apx_server_insertModifiedNode(apx_server_t *self, apx_nodeInstance_t *nodeInstance)
 {
    if (self != 0)
    {
-      adt_error_t rc = adt_ary_push_unique(&self->modifiedNodes, (void*) nodeInstance);
+      adt_error_t rc;
+      MUTEX_LOCK(self->modifiedNodesLock);
+      rc = adt_ary_push_unique(&self->modifiedNodes, (void*) nodeInstance);
+      MUTEX_UNLOCK(self->modifiedNodesLock);
       if (rc == ADT_MEM_ERROR)
       {
          return APX_MEM_ERROR;
@@ -441,7 +528,7 @@ apx_error_t apx_server_insertModifiedNode(apx_server_t *self, apx_nodeInstance_t
 }
 
 /**
- * Note: Should only be used when caller holds globalLock
+ * Note: The array is shared by all connections. Should only be used when no other connection is connecting or disconnecting nodes.
  */
 adt_ary_t *apx_server_getModifiedNodes(const apx_server_t *self)
 {
@@ -453,26 +540,38 @@ adt_ary_t *apx_server_getModifiedNodes(const apx_server_t *self)
 }
 
 /**
- * Note: Should only be used when caller holds globalLock
+ * Clears port connector changes of all modified nodes having ports in stripeMask.
+ * Modified nodes belonging to other ongoing connect/disconnect operations are left untouched.
+ * Note: Should only be used when caller holds the stripes in stripeMask
  */
-void apx_server_clearPortConnectorChanges(apx_server_t *self)
+void apx_server_clearPortConnectorChanges(apx_server_t *self, uint32_t stripeMask)
 {
    if (self != 0)
    {
       int32_t i;
-      int32_t numNodes = adt_ary_length(&self->modifiedNodes);
-      for(i=0; i<numNodes; i++)
+      MUTEX_LOCK(self->modifiedNodesLock);
+      for(i = adt_ary_length(&self->modifiedNodes) - 1; i >= 0; i--)
       {
          apx_nodeInstance_t *nodeInstance = (apx_nodeInstance_t*) adt_ary_value(&self->modifiedNodes, i);
          assert(nodeInstance != 0);
-         apx_nodeInstance_clearProvidePortConnectorChanges(nodeInstance, true);
-         apx_nodeInstance_clearRequirePortConnectorChanges(nodeInstance, true);
-      }
-      if (numNodes > 0)
-      {
-         adt_ary_clear(&self->modifiedNodes);
+         if ( (apx_nodeInstance_getPortSignatureStripes(nodeInstance) & stripeMask) != 0u)
+         {
+            apx_nodeInstance_clearProvidePortConnectorChanges(nodeInstance, true);
+            apx_nodeInstance_clearRequirePortConnectorChanges(nodeInstance, true);
+            adt_ary_remove(&self->modifiedNodes, i);
+         }
       }
+      MUTEX_UNLOCK(self->modifiedNodesLock);
+   }
+}
+
+apx_definitionCache_t *apx_server_getDefinitionCache(apx_server_t *self)
+{
+   if (self != 0)
+   {
+      return &self->definitionCache;
    }
+   return (apx_definitionCache_t*) 0;
 }
 
 
@@ -516,6 +615,10 @@ static void apx_server_attach_and_start_connection(apx_server_t *self, apx_serve
    {
       apx_connectionManager_attach(&self->connectionManager, newConnection);
       apx_serverConnectionBase_setServer(newConnection, self);
+      if (self->dataPlane != 0)
+      {
+         newConnection->dataPlaneLane = apx_dataPlane_attachConnection(self->dataPlane, newConnection);
+      }
       apx_server_triggerConnectedEvent(self, newConnection);
       apx_connectionBase_start(&newConnection->base);
    }
@@ -655,6 +758,194 @@ static void apx_server_handleEvent(void *arg, apx_event_t *event)
       }
    }
 }
+
+/**
+ * Inserts the new connectors of a provide port into the connector table of its node instance.
+ */
+static apx_error_t apx_server_processNewProvidePortConnectors(apx_portRef_t *providePortRef, apx_portConnectorChangeEntry_t *entry)
+{
+   int32_t i;
+   assert(entry != 0);
+   assert(providePortRef != 0);
+   for (i = 0; i < entry->count; i++)
+   {
+      apx_error_t rc;
+      apx_portRef_t *requirePortRef = (entry->count == 1)? entry->data.portRef : (apx_portRef_t*) adt_ary_value(entry->data.array, i);
+      assert(requirePortRef != 0);
+      rc = apx_nodeInstance_insertProvidePortConnector(providePortRef->nodeInstance, apx_portRef_getPortId(providePortRef), requirePortRef);
+      if (rc != APX_NO_ERROR)
+      {
+         return rc;
+      }
+   }
+   return APX_NO_ERROR;
+}
+
+/**
+ * Copies provide port data into all newly connected require ports, then sends the updated require port data to each
+ * require node using one write per run of adjacent newly connected ports. Runs are never joined across a port that
+ * isn't part of connectorChanges, that port may be routed from another provider and its bytes could be stale in the snapshot.
+ * When all ports of a require node are connected to provideNodeInstance this is a single write of its entire require port data.
+ */
+static apx_error_t apx_server_resyncRequirePorts(apx_nodeInstance_t *provideNodeInstance, apx_portConnectorChangeTable_t *connectorChanges)
+{
+   apx_portCount_t numProvidePorts;
+   apx_portId_t providePortId;
+   apx_server_resyncRange_t *ranges;
+   int32_t maxRanges = 0;
+   int32_t numRanges = 0;
+   int32_t i;
+   apx_error_t rc = APX_NO_ERROR;
+   numProvidePorts = apx_nodeInstance_getNumProvidePorts(provideNodeInstance);
+   for (providePortId = 0u; providePortId < numProvidePorts; providePortId++)
+   {
+      apx_portConnectorChangeEntry_t *entry = apx_portConnectorChangeTable_getEntry(connectorChanges, providePortId);
+      if (entry->count > 0)
+      {
+         maxRanges += entry->count;
+      }
+   }
+   if (maxRanges == 0)
+   {
+      return APX_NO_ERROR;
+   }
+   ranges = (apx_server_resyncRange_t*) malloc(maxRanges * sizeof(apx_server_resyncRange_t));
+   if (ranges == 0)
+   {
+      return APX_MEM_ERROR;
+   }
+   for (providePortId = 0u; (providePortId < numProvidePorts) && (rc == APX_NO_ERROR); providePortId++)
+   {
+      apx_portRef_t *providePortRef = apx_nodeInstance_getProvidePortRef(provideNodeInstance, providePortId);
+      apx_portConnectorChangeEntry_t *entry = apx_portConnectorChangeTable_getEntry(connectorChanges, providePortId);
+      for (i = 0; (i < entry->count) && (rc == APX_NO_ERROR); i++)
+      {
+         apx_portRef_t *requirePortRef = (entry->count == 1)? entry->data.portRef : (apx_portRef_t*) adt_ary_value(entry->data.array, i);
+         const apx_portDataProps_t *requirePortDataProps = requirePortRef->portDataProps;
+         apx_nodeInstance_t *requireNodeInstance = requirePortRef->nodeInstance;
+         uint32_t beginOffset = requirePortDataProps->offset;
+         uint32_t endOffset = beginOffset + requirePortDataProps->dataSize;
+         if (!apx_portDataProps_isPlainOldData(requirePortDataProps))
+         {
+            rc = APX_NOT_IMPLEMENTED_ERROR;
+            break;
+         }
+         rc = apx_nodeInstance_updatePortDataDirect(requireNodeInstance, requirePortDataProps, provideNodeInstance, providePortRef->portDataProps);
+         if (rc != APX_NO_ERROR)
+         {
+            break;
+         }
+         ranges[numRanges].nodeInstance = requireNodeInstance;
+         ranges[numRanges].beginOffset = beginOffset;
+         ranges[numRanges].endOffset = endOffset;
+         numRanges++;
+      }
+   }
+   if ( (rc == APX_NO_ERROR) && (numRanges > 1) )
+   {
+      int32_t rangeIndex = 0;
+      //Port data of a node has no gaps, two ranges only touch when no other port sits between them
+      qsort(ranges, (size_t) numRanges, sizeof(apx_server_resyncRange_t), apx_server_compareResyncRanges);
+      for (i = 1; i < numRanges; i++)
+      {
+         if ( (ranges[i].nodeInstance == ranges[rangeIndex].nodeInstance) && (ranges[i].beginOffset <= ranges[rangeIndex].endOffset) )
+         {
+            if (ranges[i].endOffset > ranges[rangeIndex].endOffset)
+            {
+               ranges[rangeIndex].endOffset = ranges[i].endOffset;
+            }
+         }
+         else
+         {
+            ranges[++rangeIndex] = ranges[i];
+         }
+      }
+      numRanges = rangeIndex + 1;
+   }
+   for (i = 0; (i < numRanges) && (rc == APX_NO_ERROR); i++)
+   {
+      if (apx_nodeInstance_getConnection(ranges[i].nodeInstance) != 0)
+      {
+         rc = apx_nodeInstance_sendRequirePortDataRange(ranges[i].nodeInstance, ranges[i].beginOffset, ranges[i].endOffset - ranges[i].beginOffset);
+      }
+   }
+   free(ranges);
+   return rc;
+}
+
+/**
+ * Orders ranges by require node, then by offset
+ */
+static int apx_server_compareResyncRanges(const void *a, const void *b)
+{
+   const apx_server_resyncRange_t *lhs = (const apx_server_resyncRange_t*) a;
+   const apx_server_resyncRange_t *rhs = (const apx_server_resyncRange_t*) b;
+   if (lhs->nodeInstance != rhs->nodeInstance)
+   {
+      return ( (uintptr_t) lhs->nodeInstance < (uintptr_t) rhs->nodeInstance )? -1 : 1;
+   }
+   if (lhs->beginOffset != rhs->beginOffset)
+   {
+      return (lhs->beginOffset < rhs->beginOffset)? -1 : 1;
+   }
+   return 0;
+}
+
+/**
+ * Lock stripes of the node(s) first, then check which stripes their neighbors (nodes sharing a port signature) are in.
+ * If the neighbors need more stripes, release and retry with the extended mask. Neighbors can only attach to or detach from
+ * the signatures of our own nodes while holding those stripes, so the result is stable once it's covered by the locked mask.
+ */
+static uint32_t apx_server_lockPortSignaturesInternal(apx_server_t *self, apx_nodeInstance_t *nodeInstance, adt_ary_t *nodeInstanceArray)
+{
+   uint32_t lockMask = 0u;
+   if (nodeInstance != 0)
+   {
+      lockMask = apx_nodeInstance_getPortSignatureStripes(nodeInstance);
+   }
+   else
+   {
+      int32_t i;
+      int32_t numNodes = adt_ary_length(nodeInstanceArray);
+      for (i = 0; i < numNodes; i++)
+      {
+         lockMask |= apx_nodeInstance_getPortSignatureStripes((apx_nodeInstance_t*) adt_ary_value(nodeInstanceArray, i));
+      }
+   }
+   for (;;)
+   {
+      uint32_t affectedMask;
+      apx_portSignatureMap_lockStripes(&self->portSignatureMap, lockMask);
+      affectedMask = apx_server_calcAffectedStripes(self, nodeInstance, nodeInstanceArray);
+      if ( (affectedMask & ~lockMask) == 0u)
+      {
+         break;
+      }
+      apx_portSignatureMap_unlockStripes(&self->portSignatureMap, lockMask);
+      lockMask |= affectedMask;
+   }
+   return lockMask;
+}
+
+static uint32_t apx_server_calcAffectedStripes(apx_server_t *self, apx_nodeInstance_t *nodeInstance, adt_ary_t *nodeInstanceArray)
+{
+   uint32_t affectedMask = 0u;
+   if (nodeInstance != 0)
+   {
+      affectedMask = apx_portSignatureMap_calcAffectedStripes(&self->portSignatureMap, nodeInstance);
+   }
+   else
+   {
+      int32_t i;
+      int32_t numNodes = adt_ary_length(nodeInstanceArray);
+      for (i = 0; i < numNodes; i++)
+      {
+         affectedMask |= apx_portSignatureMap_calcAffectedStripes(&self->portSignatureMap, (apx_nodeInstance_t*) adt_ary_value(nodeInstanceArray, i));
+      }
+   }
+   return affectedMask;
+}
+
 #ifndef UNIT_TEST
 static apx_error_t apx_server_startThread(apx_server_t *self)
 {
@@ -723,3 +1014,4 @@ static THREAD_PROTO(threadTask,arg)
    THREAD_RETURN(0);
 }
 #endif
+
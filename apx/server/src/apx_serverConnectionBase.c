@@ -43,6 +43,7 @@
 #include "apx_portConnectorChangeTable.h"
 #include "apx_portConnectorChangeRef.h"
 #include "apx_util.h"
+#include "apx_sha256.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -61,7 +62,10 @@ static uint8_t apx_serverConnectionBase_parseMessage(apx_serverConnectionBase_t
 static void apx_serverConnectionBase_fileInfoNotifyImpl(void *arg, const apx_fileInfo_t *fileInfo);
 static apx_error_t apx_serverConnectionBase_processNewDefinitionFile(apx_serverConnectionBase_t *self, const apx_fileInfo_t *fileInfo);
 static void apx_serverConnectionBase_processNewOutPortDataFile(apx_serverConnectionBase_t *self, const apx_fileInfo_t *fileInfo);
+static apx_nodeInfo_t *apx_serverConnectionBase_findCachedDefinition(apx_serverConnectionBase_t *self, const apx_fileInfo_t *fileInfo, const char *nodeName);
+static void apx_serverConnectionBase_cacheDefinition(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance);
 static void apx_serverConnectionBase_definitionDataWriteNotify(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance, uint32_t offset, uint32_t len);
+static apx_error_t apx_serverConnectionBase_prepareNodeInstance(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance);
 static apx_error_t apx_serverConnectionBase_providePortDataWriteNotify(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance, uint32_t offset, const uint8_t *data, uint32_t len);
 static apx_error_t apx_serverConnectionBase_openOutPortDataFileIfExists(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance);
 static apx_error_t  apx_serverConnectionBase_createRequirePortDataFileIfNeeded(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance);
@@ -102,6 +106,8 @@ apx_error_t apx_serverConnectionBase_create(apx_serverConnectionBase_t *self, ap
       self->server = (apx_server_t*) 0;
       self->isGreetingParsed = false;
       self->isActive = false;
+      self->tag = (adt_str_t*) 0;
+      self->dataPlaneLane = -1;
       apx_connectionBase_setEventHandler(&self->base, apx_serverConnectionBase_defaultEventHandler, (void*) self);
       return result;
    }
@@ -113,6 +119,10 @@ void apx_serverConnectionBase_destroy(apx_serverConnectionBase_t *self)
    if (self != 0)
    {
       apx_connectionBase_destroy(&self->base);
+      if (self->tag != 0)
+      {
+         adt_str_delete(self->tag);
+      }
    }
 }
 
@@ -267,6 +277,44 @@ void apx_serverConnectionBase_setServer(apx_serverConnectionBase_t *self, struct
    }
 }
 
+/**
+ * Sets the tag of the server socket the connection was accepted on (e.g. "tcp"). NULL or an empty string removes it.
+ */
+apx_error_t apx_serverConnectionBase_setTag(apx_serverConnectionBase_t *self, const char *tag)
+{
+   if (self != 0)
+   {
+      adt_str_t *newTag = (adt_str_t*) 0;
+      if ( (tag != 0) && (tag[0] != '\0') )
+      {
+         newTag = adt_str_new_cstr(tag);
+         if (newTag == 0)
+         {
+            return APX_MEM_ERROR;
+         }
+      }
+      if (self->tag != 0)
+      {
+         adt_str_delete(self->tag);
+      }
+      self->tag = newTag;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Returns the connection tag or NULL when the connection has none.
+ */
+const char *apx_serverConnectionBase_getTag(apx_serverConnectionBase_t *self)
+{
+   if ( (self != 0) && (self->tag != 0) )
+   {
+      return adt_str_cstr(self->tag);
+   }
+   return (const char*) 0;
+}
+
 void apx_serverConnectionBase_close(apx_serverConnectionBase_t *self)
 {
    if (self != 0)
@@ -475,9 +523,24 @@ static apx_error_t apx_serverConnectionBase_processNewDefinitionFile(apx_serverC
             if (nodeInstance != 0)
             {
                apx_nodeData_t *nodeData;
+               apx_nodeInfo_t *cachedNodeInfo;
                apx_nodeInstance_setConnection(nodeInstance, &self->base);
                nodeData = apx_nodeInstance_getNodeData(nodeInstance);
-               if (nodeData != 0)
+               cachedNodeInfo = apx_serverConnectionBase_findCachedDefinition(self, fileInfo, nodeName);
+               if ( (nodeData != 0) && (fileInfo->digestType == RMF_DIGEST_TYPE_SHA256) )
+               {
+                  apx_nodeData_setDefinitionChecksumData(nodeData, APX_CHECKSUM_SHA256, fileInfo->digestData);
+               }
+               if ( (nodeData != 0) && (cachedNodeInfo != 0) )
+               {
+                  //Definition already built for another connection. No need to download, parse or compile it again.
+                  retval = apx_nodeInstance_attachNodeInfo(nodeInstance, cachedNodeInfo);
+                  if (retval == APX_NO_ERROR)
+                  {
+                     retval = apx_serverConnectionBase_prepareNodeInstance(self, nodeInstance);
+                  }
+               }
+               else if (nodeData != 0)
                {
                   retval = apx_nodeInstance_createDefinitionBuffer(nodeInstance, fileInfo->length);
                   if (retval == APX_NO_ERROR)
@@ -494,6 +557,14 @@ static apx_error_t apx_serverConnectionBase_processNewDefinitionFile(apx_serverC
                      }
                   }
                }
+               else
+               {
+                  //MISRA
+               }
+               if (cachedNodeInfo != 0)
+               {
+                  apx_nodeInfo_release(cachedNodeInfo);
+               }
             }
          }
          free(nodeName);
@@ -503,11 +574,49 @@ static apx_error_t apx_serverConnectionBase_processNewDefinitionFile(apx_serverC
    return APX_INVALID_ARGUMENT_ERROR;
 }
 
+/**
+ * Returns a new reference to an already built nodeInfo when the client announced the definition digest and the server has seen it before.
+ */
+static apx_nodeInfo_t *apx_serverConnectionBase_findCachedDefinition(apx_serverConnectionBase_t *self, const apx_fileInfo_t *fileInfo, const char *nodeName)
+{
+   if ( (self->server != 0) && (fileInfo->digestType == RMF_DIGEST_TYPE_SHA256) && (fileInfo->digestData != 0) )
+   {
+      apx_nodeInfo_t *nodeInfo = apx_definitionCache_find(apx_server_getDefinitionCache(self->server), fileInfo->digestData, fileInfo->length);
+      if ( (nodeInfo != 0) && (strcmp(apx_nodeInfo_getName(nodeInfo), nodeName) != 0) )
+      {
+         apx_nodeInfo_release(nodeInfo);
+         nodeInfo = (apx_nodeInfo_t*) 0;
+      }
+      return nodeInfo;
+   }
+   return (apx_nodeInfo_t*) 0;
+}
+
+/**
+ * Adds a freshly built nodeInfo to the server definition cache.
+ * The digest comes from the client so it's verified against the received definition before other connections are allowed to reuse it.
+ */
+static void apx_serverConnectionBase_cacheDefinition(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance)
+{
+   apx_nodeData_t *nodeData = apx_nodeInstance_getNodeData(nodeInstance);
+   if ( (self->server != 0) && (nodeData != 0) && (apx_nodeData_getDefinitionChecksumType(nodeData) == APX_CHECKSUM_SHA256) )
+   {
+      uint8_t digest[APX_SHA256_DIGEST_SIZE];
+      apx_size_t definitionLen = apx_nodeData_getDefinitionDataLen(nodeData);
+      apx_nodeData_lockDefinitionData(nodeData);
+      apx_sha256_calc(apx_nodeData_getDefinitionDataBuf(nodeData), definitionLen, &digest[0]);
+      apx_nodeData_unlockDefinitionData(nodeData);
+      if (memcmp(&digest[0], apx_nodeData_getDefinitionChecksumData(nodeData), APX_SHA256_DIGEST_SIZE) == 0)
+      {
+         apx_definitionCache_insert(apx_server_getDefinitionCache(self->server), &digest[0], (uint32_t) definitionLen, apx_nodeInstance_getNodeInfo(nodeInstance));
+      }
+   }
+}
+
 static void apx_serverConnectionBase_definitionDataWriteNotify(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance, uint32_t offset, uint32_t len)
 {
    apx_programType_t errProgramType;
    apx_uniquePortId_t errPortId;
-   apx_portCount_t numProvidePorts;
    apx_error_t rc;
 #if APX_DEBUG_ENABLE
    printf("Calling APX parser\n");
@@ -530,18 +639,29 @@ static void apx_serverConnectionBase_definitionDataWriteNotify(apx_serverConnect
 #if APX_DEBUG_ENABLE
    printf("%s.apx: Parse Success (%d bytes)\n", apx_nodeInstance_getName(nodeInstance), len);
 #endif
+   apx_serverConnectionBase_cacheDefinition(self, nodeInstance);
+   (void) apx_serverConnectionBase_prepareNodeInstance(self, nodeInstance);
+}
+
+/**
+ * Creates the per-instance data of a node whose nodeInfo is ready and opens/creates its port data files.
+ */
+static apx_error_t apx_serverConnectionBase_prepareNodeInstance(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance)
+{
+   apx_portCount_t numProvidePorts;
+   apx_error_t rc;
    rc = apx_nodeInstance_createPortDataBuffers(nodeInstance);
    if (rc != APX_NO_ERROR)
    {
       printf("APX buffer creation failed with (%d)\n", (int) rc);
       ///TODO: send error code back to client
-      return;
+      return rc;
    }
    rc = apx_nodeInstance_buildPortRefs(nodeInstance);
    if (rc != APX_NO_ERROR)
    {
       ///TODO: send error code back to client
-      return;
+      return rc;
    }
    numProvidePorts = apx_nodeInstance_getNumProvidePorts(nodeInstance);
    if (numProvidePorts > 0)
@@ -550,7 +670,7 @@ static void apx_serverConnectionBase_definitionDataWriteNotify(apx_serverConnect
       if (rc != APX_NO_ERROR)
       {
          ///TODO: send error code back to client
-         return;
+         return rc;
       }
    }
    rc = apx_serverConnectionBase_openOutPortDataFileIfExists(self, nodeInstance);
@@ -558,15 +678,16 @@ static void apx_serverConnectionBase_definitionDataWriteNotify(apx_serverConnect
    {
       printf("Opening OutPortData file failed with (%d)\n", (int) rc);
       ///TODO: send error code back to client
-      return;
+      return rc;
    }
    rc = apx_serverConnectionBase_createRequirePortDataFileIfNeeded(self, nodeInstance);
    if (rc != APX_NO_ERROR)
    {
       printf("Creation of requirePortDataFile failed with (%d)\n", (int) rc);
       ///TODO: send error code back to client
-      return;
+      return rc;
    }
+   return APX_NO_ERROR;
 }
 
 static apx_error_t apx_serverConnectionBase_providePortDataWriteNotify(apx_serverConnectionBase_t *self, apx_nodeInstance_t *nodeInstance, uint32_t offset, const uint8_t *data, uint32_t len)
@@ -592,7 +713,7 @@ static apx_error_t apx_serverConnectionBase_providePortDataWriteNotify(apx_serve
       }
       if (self->server != 0)
       {
-         apx_server_takeGlobalLock(self->server);
+         uint32_t stripeMask = apx_server_lockPortSignatures(self->server, nodeInstance);
          rc = apx_server_connectNodeInstanceProvidePorts(self->server, nodeInstance);
          if (rc == APX_NO_ERROR)
          {
@@ -604,20 +725,20 @@ static apx_error_t apx_serverConnectionBase_providePortDataWriteNotify(apx_serve
                rc = apx_server_processProvidePortConnectorChanges(self->server, nodeInstance, providePortChanges);
                if (rc != APX_NO_ERROR)
                {
-                  apx_server_releaseGlobalLock(self->server);
+                  apx_server_unlockPortSignatures(self->server, stripeMask);
                   return rc;
                }
             }
          }
          else
          {
-            apx_server_releaseGlobalLock(self->server);
+            apx_server_unlockPortSignatures(self->server, stripeMask);
             return rc;
          }
          apx_nodeInstance_clearProvidePortConnectorChanges(nodeInstance, true); ///TODO: switch this to false once event handlers are working again
          //TODO: Update port count in all affected nodes and trigger sending of port count deltas to clients
-         apx_server_clearPortConnectorChanges(self->server);
-         apx_server_releaseGlobalLock(self->server);
+         apx_server_clearPortConnectorChanges(self->server, stripeMask);
+         apx_server_unlockPortSignatures(self->server, stripeMask);
       }
       break;
    case APX_PROVIDE_PORT_DATA_STATE_CONNECTED:
@@ -776,11 +897,11 @@ static apx_error_t apx_serverConnectionBase_RequirePortDataFileOpenNotify(apx_se
    {
       apx_error_t rc;
       apx_portConnectorChangeTable_t *requirePortChanges;
-      apx_server_takeGlobalLock(self->server);
+      uint32_t stripeMask = apx_server_lockPortSignatures(self->server, nodeInstance);
       rc = apx_server_connectNodeInstanceRequirePorts(self->server, nodeInstance);
       if (rc != APX_NO_ERROR)
       {
-         apx_server_releaseGlobalLock(self->server);
+         apx_server_unlockPortSignatures(self->server, stripeMask);
          return rc;
       }
       requirePortChanges = apx_nodeInstance_getRequirePortConnectorChanges(nodeInstance, false);
@@ -789,16 +910,16 @@ static apx_error_t apx_serverConnectionBase_RequirePortDataFileOpenNotify(apx_se
          rc = apx_server_processRequirePortConnectorChanges(self->server, nodeInstance, requirePortChanges);
          if (rc != APX_NO_ERROR)
          {
-            apx_server_releaseGlobalLock(self->server);
+            apx_server_unlockPortSignatures(self->server, stripeMask);
             return rc;
          }
       }
       apx_nodeInstance_setRequirePortDataState(nodeInstance, APX_REQUIRE_PORT_DATA_STATE_CONNECTED);
       //TODO: update port counts and trigger transmission of port count delta
-      apx_server_clearPortConnectorChanges(self->server);
+      apx_server_clearPortConnectorChanges(self->server, stripeMask);
       //Trigger transmission of .in file back to client
       rc = apx_nodeInstance_sendRequirePortDataToFileManager(nodeInstance);
-      apx_server_releaseGlobalLock(self->server);
+      apx_server_unlockPortSignatures(self->server, stripeMask);
       return rc;
    }
    return APX_NO_ERROR;
@@ -809,9 +930,30 @@ static void apx_serverConnectionBase_vnodeInstanceFileOpenNotify(void *arg, apx_
    apx_serverConnectionBase_nodeInstanceFileOpenNotify((apx_serverConnectionBase_t*) arg, nodeInstance, fileType);
 }
 
+/**
+ * Opens the provide port data file of a node that was built before the client announced the file (happens when the definition was found in the definition cache)
+ */
 static void apx_serverConnectionBase_processNewOutPortDataFile(apx_serverConnectionBase_t *self, const apx_fileInfo_t *fileInfo)
 {
-   //NOT IMPLEMENTED
+   if ( (fileInfo->fileType == RMF_FILE_TYPE_FIXED) && ( (fileInfo->address & RMF_REMOTE_ADDRESS_BIT) != 0))
+   {
+      char *nodeName = apx_fileInfo_getBaseName(fileInfo);
+      if (nodeName != 0)
+      {
+         apx_nodeInstance_t *nodeInstance = apx_nodeManager_find(&self->base.nodeManager, nodeName);
+         if ( (nodeInstance != 0) && (apx_nodeInstance_getProvidePortDataState(nodeInstance) == APX_PROVIDE_PORT_DATE_STATE_WAITING_FOR_FILE_INFO) )
+         {
+            apx_file_t *file = apx_fileManager_findFileByAddress(&self->base.fileManager, fileInfo->address);
+            if (file != 0)
+            {
+               apx_nodeInstance_registerProvidePortFileHandler(nodeInstance, file);
+               apx_nodeInstance_setProvidePortDataState(nodeInstance, APX_PROVIDE_PORT_DATA_STATE_WAITING_FOR_FILE_DATA);
+               (void) apx_fileManager_requestOpenFile(&self->base.fileManager, fileInfo->address);
+            }
+         }
+         free(nodeName);
+      }
+   }
 }
 
 static void apx_serverConnectionBase_disconnectAllNodePorts(apx_serverConnectionBase_t *self)
@@ -821,15 +963,16 @@ static void apx_serverConnectionBase_disconnectAllNodePorts(apx_serverConnection
       if (self->server != 0)
       {
          int32_t numNodes;
+         uint32_t stripeMask;
          adt_ary_t nodeInstanceArray;
          adt_ary_t providerConnectorChangeArray;
          adt_ary_t requesterConnectorChangeArray;
          adt_ary_create(&nodeInstanceArray, (void (*)(void*)) 0);
          adt_ary_create(&providerConnectorChangeArray, apx_portConnectorChangeRef_vdelete);
          adt_ary_create(&requesterConnectorChangeArray, apx_portConnectorChangeRef_vdelete);
-         //Take global lock server while calculating which nodes will be affected by disconnect event
-         apx_server_takeGlobalLock(self->server);
+         //Lock the port signatures of our nodes (and their neighbors) while calculating which nodes will be affected by disconnect event
          numNodes = apx_nodeManager_values(&self->base.nodeManager, &nodeInstanceArray);
+         stripeMask = apx_server_lockPortSignaturesForNodes(self->server, &nodeInstanceArray);
          if (numNodes > 0)
          {
             apx_serverConnectionBase_removeNodesFromSignatureMap(self, &nodeInstanceArray);
@@ -842,10 +985,10 @@ static void apx_serverConnectionBase_disconnectAllNodePorts(apx_serverConnection
          // and requesterConnectorChangeArray.
          // All other nodes that happened to be affected by port connector changes now need to have their port connector tables cleared.
          // TODO: before clearing the tables we should actually update the port count and also send out update port count deltas to clients
-         apx_server_clearPortConnectorChanges(self->server);
+         apx_server_clearPortConnectorChanges(self->server, stripeMask);
          //All information we need is now located in providerConnectorChangeArray and requesterConnectorChangeArray respectively
-         //We can do further processing after releasing global lock
-         apx_server_releaseGlobalLock(self->server);
+         //We can do further processing after releasing the port signature locks
+         apx_server_unlockPortSignatures(self->server, stripeMask);
          adt_ary_destroy(&nodeInstanceArray);
          apx_serverConnectionBase_processDisconnectedProviderNodes(&providerConnectorChangeArray);
          apx_serverConnectionBase_processDisconnectedRequesterNodes(&requesterConnectorChangeArray);
@@ -29,6 +29,7 @@
 #include <malloc.h>
 #include <stdio.h> //debug only
 #include "apx_serverTestConnection.h"
+#include "numheader.h"
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -45,6 +46,7 @@ static apx_error_t apx_serverTestConnection_fillTransmitHandler(apx_serverTestCo
 static apx_error_t apx_serverTestConnection_vfillTransmitHandler(void *arg, apx_transmitHandler_t *handler);
 static uint8_t *apx_serverTestConnection_getSendBuffer(void *arg, int32_t msgLen);
 static int32_t apx_serverTestConnection_send(void *arg, int32_t offset, int32_t msgLen);
+static int32_t apx_serverTestConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
 //////////////////////////////////////////////////////////////////////////////
@@ -272,6 +274,7 @@ static apx_error_t apx_serverTestConnection_fillTransmitHandler(apx_serverTestCo
       handler->send = apx_serverTestConnection_send;
       handler->getSendAvail = 0;
       handler->getSendBuffer = apx_serverTestConnection_getSendBuffer;
+      handler->sendBatch = apx_serverTestConnection_sendBatch;
       return APX_NO_ERROR;
    }
    return APX_INVALID_ARGUMENT_ERROR;
@@ -323,3 +326,36 @@ static int32_t apx_serverTestConnection_send(void *arg, int32_t offset, int32_t
    }
    return -1;
 }
+
+/**
+ * Splits the batch into separate messages (numheader removed) so that the transmit log looks the same as when using send.
+ */
+static int32_t apx_serverTestConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   apx_serverTestConnection_t *self = (apx_serverTestConnection_t*) arg;
+   if ( (self != 0) && (data != 0) && (dataLen > 0) )
+   {
+      const uint8_t *pNext = data;
+      const uint8_t *pEnd = data + dataLen;
+      while (pNext < pEnd)
+      {
+         uint32_t msgLen = 0u;
+         adt_bytearray_t *msg;
+         const uint8_t *pResult = numheader_decode32(pNext, pEnd, &msgLen);
+         if ( (pResult == 0) || (pResult == pNext) || (pResult + msgLen > pEnd) )
+         {
+            return -1;
+         }
+         msg = adt_bytearray_new(ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+         if (msg == 0)
+         {
+            return -1;
+         }
+         adt_bytearray_append(msg, pResult, msgLen);
+         adt_ary_push(self->transmitLog, msg);
+         pNext = pResult + msgLen;
+      }
+      return dataLen;
+   }
+   return -1;
+}
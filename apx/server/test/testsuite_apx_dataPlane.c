@@ -0,0 +1,151 @@
+/*****************************************************************************
+* \file      testsuite_apx_dataPlane.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_dataPlane
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTest.h"
+#include "apx_dataPlane.h"
+#include "apx_server.h"
+#include "apx_serverTestConnection.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define NUM_CONNECTIONS 4
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_dataPlane_create(CuTest* tc);
+static void test_apx_dataPlane_attachConnectionToLeastLoadedLane(CuTest* tc);
+static void test_apx_dataPlane_laneRunsConnectionWorker(CuTest* tc);
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_dataPlane(void)
+{
+   CuSuite* suite = CuSuiteNew();
+
+   SUITE_ADD_TEST(suite, test_apx_dataPlane_create);
+   SUITE_ADD_TEST(suite, test_apx_dataPlane_attachConnectionToLeastLoadedLane);
+   SUITE_ADD_TEST(suite, test_apx_dataPlane_laneRunsConnectionWorker);
+
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static void test_apx_dataPlane_create(CuTest* tc)
+{
+   apx_dataPlane_t dataPlane;
+   uint32_t numCpus = apx_dataPlane_getNumCpus();
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_dataPlane_create(&dataPlane, 0, false));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_create(&dataPlane, 3, false));
+   CuAssertUIntEquals(tc, 3u, apx_dataPlane_getNumLanes(&dataPlane));
+   apx_dataPlane_destroy(&dataPlane);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_create(&dataPlane, -1, false));
+   CuAssertUIntEquals(tc, (numCpus < APX_DATA_PLANE_MAX_LANES)? numCpus : APX_DATA_PLANE_MAX_LANES, apx_dataPlane_getNumLanes(&dataPlane));
+   apx_dataPlane_destroy(&dataPlane);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_create(&dataPlane, APX_DATA_PLANE_MAX_LANES+1, false));
+   CuAssertUIntEquals(tc, APX_DATA_PLANE_MAX_LANES, apx_dataPlane_getNumLanes(&dataPlane));
+   apx_dataPlane_destroy(&dataPlane);
+}
+
+static void test_apx_dataPlane_attachConnectionToLeastLoadedLane(CuTest* tc)
+{
+   apx_dataPlane_t dataPlane;
+   apx_serverTestConnection_t *connections[NUM_CONNECTIONS];
+   apx_serverTestConnection_t *extraConnection;
+   apx_dataPlaneLaneStats_t stats;
+   int32_t i;
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_create(&dataPlane, 2, false));
+   for (i = 0; i < NUM_CONNECTIONS; i++)
+   {
+      connections[i] = apx_serverTestConnection_new();
+      CuAssertIntEquals(tc, i % 2, apx_dataPlane_attachConnection(&dataPlane, (apx_serverConnectionBase_t*) connections[i]));
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_getLaneStats(&dataPlane, 0, &stats));
+   CuAssertUIntEquals(tc, 2u, stats.numConnections);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_getLaneStats(&dataPlane, 1, &stats));
+   CuAssertUIntEquals(tc, 2u, stats.numConnections);
+   CuAssertIntEquals(tc, APX_INVALID_ARGUMENT_ERROR, apx_dataPlane_getLaneStats(&dataPlane, 2, &stats));
+
+   //Lane 1 has the fewest connections after a detach
+   apx_dataPlane_detachConnection(&dataPlane, 1);
+   extraConnection = apx_serverTestConnection_new();
+   CuAssertIntEquals(tc, 1, apx_dataPlane_attachConnection(&dataPlane, (apx_serverConnectionBase_t*) extraConnection));
+
+   apx_serverTestConnection_delete(extraConnection);
+   for (i = 0; i < NUM_CONNECTIONS; i++)
+   {
+      apx_serverTestConnection_delete(connections[i]);
+   }
+   apx_dataPlane_destroy(&dataPlane);
+}
+
+static void test_apx_dataPlane_laneRunsConnectionWorker(CuTest* tc)
+{
+   apx_server_t *server;
+   apx_serverTestConnection_t *connection;
+   apx_dataPlaneLaneStats_t stats;
+   int32_t laneId;
+
+   server = apx_server_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_server_setDataPlaneConfig(server, 2, false));
+   CuAssertIntEquals(tc, APX_INVALID_STATE_ERROR, apx_server_setDataPlaneConfig(server, 2, false));
+   connection = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection);
+   laneId = connection->base.dataPlaneLane;
+   CuAssertIntEquals(tc, 0, laneId);
+
+   //The headerAck is queued in the connection worker, which is handed over to its lane
+   apx_serverTestConnection_onProtocolHeaderReceived(connection);
+   apx_serverTestConnection_runEventLoop(connection);
+   CuAssertIntEquals(tc, 0, apx_serverTestConnection_getTransmitLogLen(connection));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_getLaneStats(server->dataPlane, laneId, &stats));
+   CuAssertUIntEquals(tc, 1u, stats.mailboxDepth);
+
+   CuAssertIntEquals(tc, 1, apx_dataPlane_runLane(server->dataPlane, laneId));
+   CuAssertIntEquals(tc, 1, apx_serverTestConnection_getTransmitLogLen(connection));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_dataPlane_getLaneStats(server->dataPlane, laneId, &stats));
+   CuAssertUIntEquals(tc, 0u, stats.mailboxDepth);
+   CuAssertUIntEquals(tc, 1u, stats.numRuns);
+   CuAssertUIntEquals(tc, 0u, stats.numRequeues);
+
+   apx_server_delete(server);
+}
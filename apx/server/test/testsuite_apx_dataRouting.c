@@ -60,6 +60,9 @@ static void test_connectors_nodeWithRequirePortIsConnectedAfterNodeWithProvidePo
 static void test_connectors_nodeWithProvidePortIsConnectedAfterMultipleRequireNodesAreWaiting(CuTest* tc);
 static void test_connectors_nodeWithProvidePortIsDisconnectedFromMultipleRequireNodes(CuTest* tc);
 static void test_connectors_nodeWithRequirePortIsDisconnectedFromProviderNodeInDifferentApxConnection(CuTest* tc);
+static void test_routing_writeSpanningMultipleProvidePorts(CuTest* tc);
+static void test_routing_requireNodeIsResyncedWithSingleWriteWhenProviderConnects(CuTest* tc);
+static void test_routing_resyncWriteIsSplitAtPortNotConnectedToProvider(CuTest* tc);
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -81,6 +84,19 @@ static const char *m_apx_definition3 = "APX/1.2\n"
       "R\"VehicleSpeed\"S:=65535\n"
       "\n";
 
+static const char *m_apx_definition4 = "APX/1.2\n"
+      "N\"TestNode4\"\n"
+      "P\"VehicleSpeed\"S:=65535\n"
+      "P\"EngineSpeed\"S:=65535\n"
+      "\n";
+
+static const char *m_apx_definition5 = "APX/1.2\n"
+      "N\"TestNode5\"\n"
+      "R\"EngineSpeed\"S:=65535\n"
+      "R\"FuelLevel\"C:=255\n"
+      "R\"VehicleSpeed\"S:=65535\n"
+      "\n";
+
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////////
@@ -96,6 +112,9 @@ CuSuite* testSuite_apx_dataRouting(void)
    SUITE_ADD_TEST(suite, test_connectors_nodeWithProvidePortIsConnectedAfterMultipleRequireNodesAreWaiting);
    SUITE_ADD_TEST(suite, test_connectors_nodeWithProvidePortIsDisconnectedFromMultipleRequireNodes);
    SUITE_ADD_TEST(suite, test_connectors_nodeWithRequirePortIsDisconnectedFromProviderNodeInDifferentApxConnection);
+   SUITE_ADD_TEST(suite, test_routing_writeSpanningMultipleProvidePorts);
+   SUITE_ADD_TEST(suite, test_routing_requireNodeIsResyncedWithSingleWriteWhenProviderConnects);
+   SUITE_ADD_TEST(suite, test_routing_resyncWriteIsSplitAtPortNotConnectedToProvider);
 
    return suite;
 }
@@ -980,3 +999,256 @@ static void test_connectors_nodeWithRequirePortIsDisconnectedFromProviderNodeInD
    apx_serverTestConnection_runEventLoop(connection2);
    apx_server_delete(server);
 }
+
+static void test_routing_writeSpanningMultipleProvidePorts(CuTest* tc)
+{
+   apx_serverTestConnection_t *connection;
+   rmf_fileInfo_t fileInfo;
+   uint8_t *buffer;
+   apx_server_t *server;
+   apx_size_t definitionLen;
+   apx_nodeInstance_t *nodeInstance3; //Associated with TestNode3 (require ports)
+   apx_nodeInstance_t *nodeInstance4; //Associated with TestNode4 (provide ports)
+   uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE*2];
+   uint8_t rawRequirePortData[UINT16_SIZE*2];
+
+   //Init
+   server = apx_server_new();
+   connection = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection);
+   apx_serverTestConnection_onProtocolHeaderReceived(connection);
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //Client sends file info about TestNode4 to server
+   definitionLen = strlen(m_apx_definition4);
+   rmf_fileInfo_create(&fileInfo, "TestNode4.apx", APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   rmf_fileInfo_create(&fileInfo, "TestNode4.out", 0u, UINT16_SIZE*2, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //Client sends contents of TestNode4.apx
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], &m_apx_definition4[0], definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+
+   //Send initial contents of TestNode4.out
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE, rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, 0u, false));
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0, UINT16_SIZE); //VehicleSpeed
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE], 0, UINT16_SIZE); //EngineSpeed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], sizeof(msg)));
+   nodeInstance4 = apx_serverTestConnection_findNodeInstance(connection, "TestNode4");
+   CuAssertPtrNotNull(tc, nodeInstance4);
+   CuAssertIntEquals(tc, APX_PROVIDE_PORT_DATA_STATE_CONNECTED, apx_nodeInstance_getProvidePortDataState(nodeInstance4));
+
+   //Client sends info and contents of TestNode3.apx
+   definitionLen = strlen(m_apx_definition3);
+   rmf_fileInfo_create(&fileInfo, "TestNode3.apx", APX_ADDRESS_DEFINITION_START+APX_ADDRESS_DEFINITION_BOUNDARY, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START+APX_ADDRESS_DEFINITION_BOUNDARY, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], &m_apx_definition3[0], definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onFileOpenMsgReceived(connection, 0u));
+   nodeInstance3 = apx_serverTestConnection_findNodeInstance(connection, "TestNode3");
+   CuAssertPtrNotNull(tc, nodeInstance3);
+   CuAssertIntEquals(tc, APX_REQUIRE_PORT_DATA_STATE_CONNECTED, apx_nodeInstance_getRequirePortDataState(nodeInstance3));
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //Single write covering both provide ports of TestNode4
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0x1234, UINT16_SIZE); //VehicleSpeed
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE], 0x5678, UINT16_SIZE); //EngineSpeed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], sizeof(msg)));
+   //TestNode3 has EngineSpeed at offset 0 and VehicleSpeed at offset 2
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readRequirePortData(nodeInstance3, &rawRequirePortData[0], 0u, UINT16_SIZE*2));
+   CuAssertUIntEquals(tc, 0x5678, unpackLE(&rawRequirePortData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&rawRequirePortData[UINT16_SIZE], UINT16_SIZE));
+
+   //Write covering only the second provide port
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE, rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, UINT16_SIZE, false));
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0x9ABC, UINT16_SIZE); //EngineSpeed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], RMF_LOW_ADDRESS_SIZE+UINT16_SIZE));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readRequirePortData(nodeInstance3, &rawRequirePortData[0], 0u, UINT16_SIZE*2));
+   CuAssertUIntEquals(tc, 0x9ABC, unpackLE(&rawRequirePortData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&rawRequirePortData[UINT16_SIZE], UINT16_SIZE));
+
+   //Cleanup
+   apx_serverTestConnection_runEventLoop(connection);
+   apx_server_delete(server);
+}
+
+static void test_routing_requireNodeIsResyncedWithSingleWriteWhenProviderConnects(CuTest* tc)
+{
+   apx_serverTestConnection_t *connection;
+   rmf_fileInfo_t fileInfo;
+   uint8_t *buffer;
+   apx_server_t *server;
+   apx_size_t definitionLen;
+   apx_nodeInstance_t *nodeInstance3; //Associated with TestNode3 (require ports)
+   uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE*2];
+   uint8_t rawRequirePortData[UINT16_SIZE*2];
+   adt_bytearray_t *transmittedMsg;
+   const uint8_t *transmittedBytes;
+
+   //Init
+   server = apx_server_new();
+   connection = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection);
+   apx_serverTestConnection_onProtocolHeaderReceived(connection);
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //Client sends info and contents of TestNode3.apx, then opens TestNode3.in
+   definitionLen = strlen(m_apx_definition3);
+   rmf_fileInfo_create(&fileInfo, "TestNode3.apx", APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], &m_apx_definition3[0], definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onFileOpenMsgReceived(connection, 0u));
+   apx_serverTestConnection_runEventLoop(connection);
+   nodeInstance3 = apx_serverTestConnection_findNodeInstance(connection, "TestNode3");
+   CuAssertPtrNotNull(tc, nodeInstance3);
+   CuAssertIntEquals(tc, APX_REQUIRE_PORT_DATA_STATE_CONNECTED, apx_nodeInstance_getRequirePortDataState(nodeInstance3));
+
+   //Client sends info and contents of TestNode4.apx
+   definitionLen = strlen(m_apx_definition4);
+   rmf_fileInfo_create(&fileInfo, "TestNode4.apx", APX_ADDRESS_DEFINITION_START+APX_ADDRESS_DEFINITION_BOUNDARY, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   rmf_fileInfo_create(&fileInfo, "TestNode4.out", APX_ADDRESS_PORT_DATA_BOUNDARY, UINT16_SIZE*2, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START+APX_ADDRESS_DEFINITION_BOUNDARY, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], &m_apx_definition4[0], definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+
+   //Send initial contents of TestNode4.out, this connects both require ports of TestNode3
+   apx_serverTestConnection_clearTransmitLogMsg(connection);
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE, rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_BOUNDARY, false));
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0x1234, UINT16_SIZE); //VehicleSpeed
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE], 0x5678, UINT16_SIZE); //EngineSpeed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], sizeof(msg)));
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //TestNode3 has EngineSpeed at offset 0 and VehicleSpeed at offset 2
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readRequirePortData(nodeInstance3, &rawRequirePortData[0], 0u, UINT16_SIZE*2));
+   CuAssertUIntEquals(tc, 0x5678, unpackLE(&rawRequirePortData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&rawRequirePortData[UINT16_SIZE], UINT16_SIZE));
+
+   //Verify that TestNode3.in was updated using a single write
+   CuAssertIntEquals(tc, 1, apx_serverTestConnection_getTransmitLogLen(connection));
+   transmittedMsg = apx_serverTestConnection_getTransmitLogMsg(connection, 0);
+   CuAssertPtrNotNull(tc, transmittedMsg);
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE+UINT16_SIZE*2, adt_bytearray_length(transmittedMsg));
+   transmittedBytes = adt_bytearray_data(transmittedMsg);
+   CuAssertUIntEquals(tc, APX_ADDRESS_PORT_DATA_START, rmf_unpackAddress(transmittedBytes, RMF_LOW_ADDRESS_SIZE));
+   CuAssertUIntEquals(tc, 0x5678, unpackLE(&transmittedBytes[RMF_LOW_ADDRESS_SIZE], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&transmittedBytes[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE], UINT16_SIZE));
+
+   //Cleanup
+   apx_serverTestConnection_runEventLoop(connection);
+   apx_server_delete(server);
+}
+
+static void test_routing_resyncWriteIsSplitAtPortNotConnectedToProvider(CuTest* tc)
+{
+   apx_serverTestConnection_t *connection;
+   rmf_fileInfo_t fileInfo;
+   uint8_t *buffer;
+   apx_server_t *server;
+   apx_size_t definitionLen;
+   apx_nodeInstance_t *nodeInstance5; //Associated with TestNode5 (require ports)
+   uint8_t msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE*2];
+   uint8_t rawRequirePortData[UINT16_SIZE*2+UINT8_SIZE];
+   adt_bytearray_t *transmittedMsg;
+   const uint8_t *transmittedBytes;
+
+   //Init
+   server = apx_server_new();
+   connection = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection);
+   apx_serverTestConnection_onProtocolHeaderReceived(connection);
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //Client sends info and contents of TestNode5.apx, then opens TestNode5.in
+   definitionLen = strlen(m_apx_definition5);
+   rmf_fileInfo_create(&fileInfo, "TestNode5.apx", APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], &m_apx_definition5[0], definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onFileOpenMsgReceived(connection, 0u));
+   apx_serverTestConnection_runEventLoop(connection);
+   nodeInstance5 = apx_serverTestConnection_findNodeInstance(connection, "TestNode5");
+   CuAssertPtrNotNull(tc, nodeInstance5);
+   CuAssertIntEquals(tc, APX_REQUIRE_PORT_DATA_STATE_CONNECTED, apx_nodeInstance_getRequirePortDataState(nodeInstance5));
+
+   //Client sends info and contents of TestNode4.apx
+   definitionLen = strlen(m_apx_definition4);
+   rmf_fileInfo_create(&fileInfo, "TestNode4.apx", APX_ADDRESS_DEFINITION_START+APX_ADDRESS_DEFINITION_BOUNDARY, definitionLen, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   rmf_fileInfo_create(&fileInfo, "TestNode4.out", APX_ADDRESS_PORT_DATA_BOUNDARY, UINT16_SIZE*2, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+   buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START+APX_ADDRESS_DEFINITION_BOUNDARY, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], &m_apx_definition4[0], definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+
+   //Send initial contents of TestNode4.out, this connects EngineSpeed and VehicleSpeed of TestNode5 but not FuelLevel
+   apx_serverTestConnection_clearTransmitLogMsg(connection);
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE, rmf_packHeader(&msg[0], RMF_LOW_ADDRESS_SIZE, APX_ADDRESS_PORT_DATA_BOUNDARY, false));
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE], 0x1234, UINT16_SIZE); //VehicleSpeed
+   packLE(&msg[RMF_LOW_ADDRESS_SIZE+UINT16_SIZE], 0x5678, UINT16_SIZE); //EngineSpeed
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, &msg[0], sizeof(msg)));
+   apx_serverTestConnection_runEventLoop(connection);
+
+   //TestNode5 has EngineSpeed at offset 0, FuelLevel at offset 2 and VehicleSpeed at offset 3
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_nodeInstance_readRequirePortData(nodeInstance5, &rawRequirePortData[0], 0u, UINT16_SIZE*2+UINT8_SIZE));
+   CuAssertUIntEquals(tc, 0x5678, unpackLE(&rawRequirePortData[0], UINT16_SIZE));
+   CuAssertUIntEquals(tc, 0xff, rawRequirePortData[UINT16_SIZE]);
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&rawRequirePortData[UINT16_SIZE+UINT8_SIZE], UINT16_SIZE));
+
+   //FuelLevel isn't part of the resync, one write is sent on each side of it
+   CuAssertIntEquals(tc, 2, apx_serverTestConnection_getTransmitLogLen(connection));
+   transmittedMsg = apx_serverTestConnection_getTransmitLogMsg(connection, 0);
+   CuAssertPtrNotNull(tc, transmittedMsg);
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE+UINT16_SIZE, adt_bytearray_length(transmittedMsg));
+   transmittedBytes = adt_bytearray_data(transmittedMsg);
+   CuAssertUIntEquals(tc, APX_ADDRESS_PORT_DATA_START, rmf_unpackAddress(transmittedBytes, RMF_LOW_ADDRESS_SIZE));
+   CuAssertUIntEquals(tc, 0x5678, unpackLE(&transmittedBytes[RMF_LOW_ADDRESS_SIZE], UINT16_SIZE));
+   transmittedMsg = apx_serverTestConnection_getTransmitLogMsg(connection, 1);
+   CuAssertPtrNotNull(tc, transmittedMsg);
+   CuAssertIntEquals(tc, RMF_LOW_ADDRESS_SIZE+UINT16_SIZE, adt_bytearray_length(transmittedMsg));
+   transmittedBytes = adt_bytearray_data(transmittedMsg);
+   CuAssertUIntEquals(tc, APX_ADDRESS_PORT_DATA_START+UINT16_SIZE+UINT8_SIZE, rmf_unpackAddress(transmittedBytes, RMF_LOW_ADDRESS_SIZE));
+   CuAssertUIntEquals(tc, 0x1234, unpackLE(&transmittedBytes[RMF_LOW_ADDRESS_SIZE], UINT16_SIZE));
+
+   //Cleanup
+   apx_serverTestConnection_runEventLoop(connection);
+   apx_server_delete(server);
+}
@@ -38,6 +38,8 @@
 #include "apx_connectionEventSpy.h"
 #include "apx_transmitHandlerSpy.h"
 #include "apx_nodeManager.h"
+#include "apx_sha256.h"
+#include "apx_nodeImage.h"
 #include "pack.h"
 
 #ifdef MEM_LEAK_CHECK
@@ -47,6 +49,12 @@
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE CONSTANTS AND DATA TYPES
 //////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#define TEST_IMAGE_DIRECTORY "."
+#else
+#define TEST_IMAGE_DIRECTORY "/tmp"
+#endif
+
 static const char *m_apx_definition1 = "APX/1.2\n"
       "N\"TestNode\"\n"
       "P\"VehicleSpeed\"S:=65535\n"
@@ -68,6 +76,13 @@ static void test_serverProcessesDefinitionAfterClientWritesDefinitionData(CuTest
 static void test_serverCreatesOutPortDataBuffersAfterProcessingNodeDefinition(CuTest* tc);
 static void test_serverDetectsOutPortDataFileAfterProcessingNodeDefinition(CuTest* tc);
 static void test_clientWritesToProvidePortDataFileAfterServerHasOpenedIt(CuTest* tc);
+static void test_serverReusesCachedDefinitionWhenDigestMatches(CuTest* tc);
+static void test_serverDoesNotCacheDefinitionWithWrongDigest(CuTest* tc);
+static void test_serverLoadsDefinitionFromNodeImageDirectory(CuTest* tc);
+static void test_connectionTag(CuTest* tc);
+static void announceNodeFiles(apx_serverTestConnection_t *connection, apx_size_t definitionLen, const uint8_t *digest);
+static void sendDefinitionData(CuTest* tc, apx_serverTestConnection_t *connection, const char *definition);
+static bool isOpenFileMsg(adt_bytearray_t *msg, uint32_t address);
 
 
 
@@ -92,6 +107,10 @@ CuSuite* testSuite_apx_serverConnection(void)
    SUITE_ADD_TEST(suite, test_serverCreatesOutPortDataBuffersAfterProcessingNodeDefinition);
    SUITE_ADD_TEST(suite, test_serverDetectsOutPortDataFileAfterProcessingNodeDefinition);
    SUITE_ADD_TEST(suite, test_clientWritesToProvidePortDataFileAfterServerHasOpenedIt);
+   SUITE_ADD_TEST(suite, test_serverReusesCachedDefinitionWhenDigestMatches);
+   SUITE_ADD_TEST(suite, test_serverDoesNotCacheDefinitionWithWrongDigest);
+   SUITE_ADD_TEST(suite, test_serverLoadsDefinitionFromNodeImageDirectory);
+   SUITE_ADD_TEST(suite, test_connectionTag);
 
    return suite;
 }
@@ -415,3 +434,189 @@ static void test_clientWritesToProvidePortDataFileAfterServerHasOpenedIt(CuTest*
    apx_server_delete(server);
    free(buffer);
 }
+
+static void test_serverReusesCachedDefinitionWhenDigestMatches(CuTest* tc)
+{
+   apx_server_t *server;
+   apx_serverTestConnection_t *connection1;
+   apx_serverTestConnection_t *connection2;
+   apx_nodeInstance_t *nodeInstance1;
+   apx_nodeInstance_t *nodeInstance2;
+   apx_definitionCacheStats_t stats;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_size_t definitionLen = strlen(m_apx_definition1);
+
+   apx_sha256_calc((const uint8_t*) m_apx_definition1, definitionLen, &digest[0]);
+   server = apx_server_new();
+   connection1 = apx_serverTestConnection_new();
+   connection2 = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection1);
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection2);
+
+   //First client: definition is downloaded, built and then cached
+   announceNodeFiles(connection1, definitionLen, &digest[0]);
+   CuAssertIntEquals(tc, 1, apx_serverTestConnection_getTransmitLogLen(connection1));
+   CuAssertTrue(tc, isOpenFileMsg(apx_serverTestConnection_getTransmitLogMsg(connection1, 0), APX_ADDRESS_DEFINITION_START));
+   sendDefinitionData(tc, connection1, m_apx_definition1);
+   CuAssertIntEquals(tc, 2, apx_serverTestConnection_getTransmitLogLen(connection1));
+   nodeInstance1 = apx_serverTestConnection_findNodeInstance(connection1, "TestNode");
+   CuAssertPtrNotNull(tc, nodeInstance1);
+   CuAssertPtrNotNull(tc, apx_nodeInstance_getNodeInfo(nodeInstance1));
+   apx_definitionCache_getStats(apx_server_getDefinitionCache(server), &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numEntries);
+
+   //Second client: definition file is never opened, only the provide port data file
+   announceNodeFiles(connection2, definitionLen, &digest[0]);
+   CuAssertIntEquals(tc, 1, apx_serverTestConnection_getTransmitLogLen(connection2));
+   CuAssertTrue(tc, isOpenFileMsg(apx_serverTestConnection_getTransmitLogMsg(connection2, 0), 0u));
+   nodeInstance2 = apx_serverTestConnection_findNodeInstance(connection2, "TestNode");
+   CuAssertPtrNotNull(tc, nodeInstance2);
+   CuAssertPtrEquals(tc, apx_nodeInstance_getNodeInfo(nodeInstance1), apx_nodeInstance_getNodeInfo(nodeInstance2));
+   CuAssertUIntEquals(tc, UINT16_SIZE, apx_nodeData_getProvidePortDataLen(apx_nodeInstance_getNodeData(nodeInstance2)));
+   CuAssertIntEquals(tc, APX_PROVIDE_PORT_DATA_STATE_WAITING_FOR_FILE_DATA, apx_nodeInstance_getProvidePortDataState(nodeInstance2));
+   apx_definitionCache_getStats(apx_server_getDefinitionCache(server), &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numHits);
+
+   apx_server_delete(server);
+}
+
+static void test_serverDoesNotCacheDefinitionWithWrongDigest(CuTest* tc)
+{
+   apx_server_t *server;
+   apx_serverTestConnection_t *connection1;
+   apx_serverTestConnection_t *connection2;
+   apx_definitionCacheStats_t stats;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_size_t definitionLen = strlen(m_apx_definition1);
+
+   memset(&digest[0], 0xAA, sizeof(digest));
+   server = apx_server_new();
+   connection1 = apx_serverTestConnection_new();
+   connection2 = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection1);
+   apx_server_acceptConnection(server, (apx_serverConnectionBase_t*) connection2);
+
+   announceNodeFiles(connection1, definitionLen, &digest[0]);
+   sendDefinitionData(tc, connection1, m_apx_definition1);
+   CuAssertPtrNotNull(tc, apx_nodeInstance_getNodeInfo(apx_serverTestConnection_findNodeInstance(connection1, "TestNode")));
+   apx_definitionCache_getStats(apx_server_getDefinitionCache(server), &stats);
+   CuAssertUIntEquals(tc, 0u, stats.numEntries);
+
+   announceNodeFiles(connection2, definitionLen, &digest[0]);
+   CuAssertIntEquals(tc, 1, apx_serverTestConnection_getTransmitLogLen(connection2));
+   CuAssertTrue(tc, isOpenFileMsg(apx_serverTestConnection_getTransmitLogMsg(connection2, 0), APX_ADDRESS_DEFINITION_START));
+
+   apx_server_delete(server);
+}
+
+static void test_serverLoadsDefinitionFromNodeImageDirectory(CuTest* tc)
+{
+   apx_server_t *server1;
+   apx_server_t *server2;
+   apx_serverTestConnection_t *connection1;
+   apx_serverTestConnection_t *connection2;
+   apx_nodeInstance_t *nodeInstance;
+   apx_definitionCacheStats_t stats;
+   uint8_t digest[APX_SHA256_DIGEST_SIZE];
+   apx_size_t definitionLen = strlen(m_apx_definition1);
+   char *imagePath;
+
+   apx_sha256_calc((const uint8_t*) m_apx_definition1, definitionLen, &digest[0]);
+   imagePath = apx_nodeImage_makeFilePath(TEST_IMAGE_DIRECTORY, &digest[0]);
+   CuAssertPtrNotNull(tc, imagePath);
+   remove(imagePath);
+
+   //First server process: definition is downloaded, built and saved as an image
+   server1 = apx_server_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_server_setNodeImageDirectory(server1, TEST_IMAGE_DIRECTORY));
+   connection1 = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server1, (apx_serverConnectionBase_t*) connection1);
+   announceNodeFiles(connection1, definitionLen, &digest[0]);
+   CuAssertTrue(tc, isOpenFileMsg(apx_serverTestConnection_getTransmitLogMsg(connection1, 0), APX_ADDRESS_DEFINITION_START));
+   sendDefinitionData(tc, connection1, m_apx_definition1);
+   apx_definitionCache_getStats(apx_server_getDefinitionCache(server1), &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numImageSaves);
+   apx_server_delete(server1);
+
+   //Second server process: definition is loaded from the image, the definition file is never opened
+   server2 = apx_server_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_server_setNodeImageDirectory(server2, TEST_IMAGE_DIRECTORY));
+   connection2 = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server2, (apx_serverConnectionBase_t*) connection2);
+   announceNodeFiles(connection2, definitionLen, &digest[0]);
+   CuAssertIntEquals(tc, 1, apx_serverTestConnection_getTransmitLogLen(connection2));
+   CuAssertTrue(tc, isOpenFileMsg(apx_serverTestConnection_getTransmitLogMsg(connection2, 0), 0u));
+   nodeInstance = apx_serverTestConnection_findNodeInstance(connection2, "TestNode");
+   CuAssertPtrNotNull(tc, nodeInstance);
+   CuAssertPtrNotNull(tc, apx_nodeInstance_getNodeInfo(nodeInstance));
+   apx_definitionCache_getStats(apx_server_getDefinitionCache(server2), &stats);
+   CuAssertUIntEquals(tc, 1u, stats.numImageLoads);
+   apx_server_delete(server2);
+
+   //An empty directory turns it off
+   server1 = apx_server_new();
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_server_setNodeImageDirectory(server1, ""));
+   connection1 = apx_serverTestConnection_new();
+   apx_server_acceptConnection(server1, (apx_serverConnectionBase_t*) connection1);
+   announceNodeFiles(connection1, definitionLen, &digest[0]);
+   CuAssertTrue(tc, isOpenFileMsg(apx_serverTestConnection_getTransmitLogMsg(connection1, 0), APX_ADDRESS_DEFINITION_START));
+   apx_server_delete(server1);
+
+   remove(imagePath);
+   free(imagePath);
+}
+
+static void test_connectionTag(CuTest* tc)
+{
+   apx_serverTestConnection_t *connection = apx_serverTestConnection_new();
+   apx_serverConnectionBase_t *base = (apx_serverConnectionBase_t*) connection;
+   CuAssertPtrEquals(tc, NULL, (void*) apx_serverConnectionBase_getTag(base));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverConnectionBase_setTag(base, "shm"));
+   CuAssertStrEquals(tc, "shm", apx_serverConnectionBase_getTag(base));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverConnectionBase_setTag(base, "tcp"));
+   CuAssertStrEquals(tc, "tcp", apx_serverConnectionBase_getTag(base));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverConnectionBase_setTag(base, ""));
+   CuAssertPtrEquals(tc, NULL, (void*) apx_serverConnectionBase_getTag(base));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverConnectionBase_setTag(base, "unix"));
+   apx_serverTestConnection_delete(connection);
+}
+
+static void announceNodeFiles(apx_serverTestConnection_t *connection, apx_size_t definitionLen, const uint8_t *digest)
+{
+   rmf_fileInfo_t fileInfo;
+   rmf_fileInfo_create(&fileInfo, "TestNode.apx", APX_ADDRESS_DEFINITION_START, definitionLen, RMF_FILE_TYPE_FIXED);
+   rmf_fileInfo_setDigestData(&fileInfo, RMF_DIGEST_TYPE_SHA256, digest, RMF_DIGEST_SIZE);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   rmf_fileInfo_create(&fileInfo, "TestNode.out", 0u, UINT16_SIZE, RMF_FILE_TYPE_FIXED);
+   apx_serverTestConnection_onFileInfoMsgReceived(connection, &fileInfo);
+   apx_serverTestConnection_runEventLoop(connection);
+}
+
+static void sendDefinitionData(CuTest* tc, apx_serverTestConnection_t *connection, const char *definition)
+{
+   apx_size_t definitionLen = strlen(definition);
+   uint8_t *buffer = (uint8_t*) malloc(RMF_HIGH_ADDRESS_SIZE+definitionLen);
+   assert(buffer != 0);
+   CuAssertIntEquals(tc, RMF_HIGH_ADDRESS_SIZE, rmf_packHeader(&buffer[0], RMF_HIGH_ADDRESS_SIZE, APX_ADDRESS_DEFINITION_START, false));
+   memcpy(&buffer[RMF_HIGH_ADDRESS_SIZE], definition, definitionLen);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_serverTestConnection_onSerializedMsgReceived(connection, buffer, RMF_HIGH_ADDRESS_SIZE+definitionLen));
+   apx_serverTestConnection_runEventLoop(connection);
+   free(buffer);
+}
+
+static bool isOpenFileMsg(adt_bytearray_t *msg, uint32_t address)
+{
+   bool retval;
+   rmf_cmdOpenFile_t fileOpenCmd;
+   int32_t msgLen = RMF_HIGH_ADDRESS_SIZE+RMF_CMD_TYPE_LEN+UINT32_SIZE;
+   adt_bytearray_t *expectedMsg = adt_bytearray_new(ADT_BYTE_ARRAY_DEFAULT_GROW_SIZE);
+   uint8_t *expectedData;
+   adt_bytearray_resize(expectedMsg, msgLen);
+   expectedData = adt_bytearray_data(expectedMsg);
+   rmf_packHeader(expectedData, RMF_HIGH_ADDRESS_SIZE, RMF_CMD_START_ADDR, false);
+   fileOpenCmd.address = address;
+   rmf_serialize_cmdOpenFile(expectedData+RMF_HIGH_ADDRESS_SIZE, msgLen-RMF_HIGH_ADDRESS_SIZE, &fileOpenCmd);
+   retval = adt_bytearray_equals(msg, expectedMsg);
+   adt_bytearray_delete(expectedMsg);
+   return retval;
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************
+* \file      apx_serverShmConnection.h
+* \author    agent
+* \date      2026-10-18
+* \brief     Server connection using the shared-memory transport
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_SERVER_SHM_CONNECTION_H
+#define APX_SERVER_SHM_CONNECTION_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_shmChannel.h"
+#if APX_SHM_SUPPORTED
+#include "adt_bytearray.h"
+#include "apx_serverConnectionBase.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+typedef struct apx_serverShmConnection_tag
+{
+   apx_serverConnectionBase_t base;
+   adt_bytearray_t sendBuffer;
+   adt_bytearray_t receiveBuffer; //holds a partial message when a large message was split over several ring records
+   apx_shmChannel_t channel;
+   int sockFd; //accepted rendezvous socket, kept open to detect when the client goes away
+   THREAD_T receiveThread;
+   bool isThreadRunning;
+   volatile bool isDestroying;
+}apx_serverShmConnection_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_serverShmConnection_create(apx_serverShmConnection_t *self, int sockFd);
+void apx_serverShmConnection_destroy(apx_serverShmConnection_t *self);
+void apx_serverShmConnection_vdestroy(void *arg);
+apx_serverShmConnection_t *apx_serverShmConnection_new(int sockFd);
+void apx_serverShmConnection_delete(apx_serverShmConnection_t *self);
+void apx_serverShmConnection_vdelete(void *arg);
+void apx_serverShmConnection_start(apx_serverShmConnection_t *self);
+void apx_serverShmConnection_vstart(void *arg);
+void apx_serverShmConnection_close(apx_serverShmConnection_t *self);
+void apx_serverShmConnection_vclose(void *arg);
+
+#endif //APX_SHM_SUPPORTED
+#endif //APX_SERVER_SHM_CONNECTION_H
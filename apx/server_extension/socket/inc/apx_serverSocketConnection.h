@@ -31,6 +31,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "adt_bytearray.h"
 #include "apx_serverConnectionBase.h"
+#include "apx_socketReactor.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // PUBLIC CONSTANTS AND DATA TYPES
@@ -47,6 +48,9 @@ typedef struct apx_serverSocketConnection_tag
    apx_serverConnectionBase_t base;
    adt_bytearray_t sendBuffer;
    SOCKET_TYPE *socketObject;
+#if APX_SOCKET_REACTOR_SUPPORTED
+   apx_reactorSocket_t *reactorSocket; //used instead of socketObject when the connection is served by apx_socketReactor
+#endif
 }apx_serverSocketConnection_t;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -58,6 +62,10 @@ void apx_serverSocketConnection_vdestroy(void *arg);
 apx_serverSocketConnection_t *apx_serverSocketConnection_new(SOCKET_TYPE *socketObject);
 void apx_serverSocketConnection_delete(apx_serverSocketConnection_t *self);
 void apx_serverSocketConnection_vdelete(void *arg);
+#if APX_SOCKET_REACTOR_SUPPORTED
+apx_error_t apx_serverSocketConnection_createFromReactor(apx_serverSocketConnection_t *self, apx_reactorSocket_t *reactorSocket);
+apx_serverSocketConnection_t *apx_serverSocketConnection_newFromReactor(apx_reactorSocket_t *reactorSocket);
+#endif
 void apx_serverSocketConnection_start(apx_serverSocketConnection_t *self);
 void apx_serverSocketConnection_vstart(void *arg);
 void apx_serverSocketConnection_close(apx_serverSocketConnection_t *self);
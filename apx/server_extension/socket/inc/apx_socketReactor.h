@@ -0,0 +1,150 @@
+/*****************************************************************************
+* \file      apx_socketReactor.h
+* \author    agent
+* \date      2026-10-18
+* \brief     epoll-based reactor that multiplexes server sockets over a small pool of threads
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+#ifndef APX_SOCKET_REACTOR_H
+#define APX_SOCKET_REACTOR_H
+
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stdbool.h>
+#include "apx_error.h"
+
+#ifdef __linux__
+# define APX_SOCKET_REACTOR_SUPPORTED 1
+#else
+# define APX_SOCKET_REACTOR_SUPPORTED 0
+#endif
+
+#if APX_SOCKET_REACTOR_SUPPORTED
+#include <pthread.h>
+#include "osmacro.h"
+#include "apx_cfg.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+//Forward declarations
+struct apx_socketReactor_tag;
+struct apx_reactorThread_tag;
+struct apx_reactorSocket_tag;
+
+#define APX_REACTOR_SOCKET_WOULD_BLOCK (-2) //returned by apx_reactorSocket_send when the data would exceed the pending send limit
+
+//same signature and semantics as msocket tcp_data: return 0 on success, set *parseLen to number of bytes consumed
+typedef int8_t (apx_reactorSocketDataFunc_t)(void *arg, const uint8_t *dataBuf, uint32_t dataLen, uint32_t *parseLen);
+typedef void (apx_reactorSocketDisconnectedFunc_t)(void *arg);
+typedef void (apx_socketReactorAcceptFunc_t)(void *arg, struct apx_reactorSocket_tag *sock);
+
+typedef struct apx_reactorSocketHandler_tag
+{
+   apx_reactorSocketDataFunc_t *data;
+   apx_reactorSocketDisconnectedFunc_t *disconnected;
+} apx_reactorSocketHandler_t;
+
+typedef struct apx_reactorSocket_tag
+{
+   uint8_t kind; //must be first, used to tell sockets and listeners apart in epoll events
+   int fd;
+   struct apx_socketReactor_tag *reactor;
+   struct apx_reactorThread_tag *thread; //owning epoll thread, set by apx_reactorSocket_start
+   struct apx_reactorSocket_tag *nextGarbage;
+   apx_reactorSocketHandler_t handler;
+   void *handlerArg;
+   //receive side, only touched by the owning epoll thread
+   uint8_t *rxBuf;
+   uint32_t rxCapacity;
+   uint32_t rxLen;
+   //send side, protected by txLock
+   MUTEX_T txLock;
+   uint8_t *txBuf; //ring buffer of data waiting for the socket to become writable
+   uint32_t txCapacity;
+   uint32_t txHead; //position of the oldest pending byte in txBuf
+   uint32_t txLen; //number of pending bytes in txBuf
+   bool isRegistered; //true while fd is part of the owning thread's epoll set
+   bool isWriteArmed; //true while EPOLLOUT is requested
+   bool isClosed; //true after disconnect or close, no more data is sent
+   volatile bool isDeleted; //true once apx_reactorSocket_delete has been called, no more handler callbacks are made
+} apx_reactorSocket_t;
+
+typedef struct apx_reactorListener_tag
+{
+   uint8_t kind; //must be first
+   int fd;
+   apx_socketReactorAcceptFunc_t *acceptFunc;
+   void *acceptArg;
+   char *unixPath; //non-NULL for unix domain socket listeners, removed when the listener is closed
+} apx_reactorListener_t;
+
+typedef struct apx_reactorThread_tag
+{
+   struct apx_socketReactor_tag *reactor;
+   THREAD_T thread;
+   int epollFd;
+   int wakeFd; //eventfd used to wake the thread for shutdown and garbage collection
+   SPINLOCK_T garbageLock;
+   apx_reactorSocket_t *garbage; //sockets waiting to be freed by this thread once its current batch of events is done
+   volatile uint32_t loopCount; //incremented each time the thread has finished processing a batch of events
+   volatile bool isThreadValid;
+} apx_reactorThread_t;
+
+typedef struct apx_socketReactor_tag
+{
+   apx_reactorThread_t *threads;
+   uint32_t numThreads;
+   volatile uint32_t nextThread; //round-robin thread assignment for new sockets
+   uint32_t maxPendingSendLen; //apx_reactorSocket_send refuses data once this many bytes are waiting to be sent, 0 means unlimited
+   apx_reactorListener_t tcpListener;
+   apx_reactorListener_t unixListener;
+   volatile bool isRunning;
+} apx_socketReactor_t;
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_socketReactor_create(apx_socketReactor_t *self, uint32_t numThreads);
+void apx_socketReactor_destroy(apx_socketReactor_t *self);
+apx_socketReactor_t *apx_socketReactor_new(uint32_t numThreads);
+void apx_socketReactor_delete(apx_socketReactor_t *self);
+
+apx_error_t apx_socketReactor_start(apx_socketReactor_t *self);
+void apx_socketReactor_stop(apx_socketReactor_t *self);
+uint32_t apx_socketReactor_getNumThreads(apx_socketReactor_t *self);
+void apx_socketReactor_setMaxPendingSendLen(apx_socketReactor_t *self, uint32_t maxPendingSendLen);
+apx_error_t apx_socketReactor_listenTcp(apx_socketReactor_t *self, uint16_t tcpPort, apx_socketReactorAcceptFunc_t *acceptFunc, void *arg);
+apx_error_t apx_socketReactor_listenUnix(apx_socketReactor_t *self, const char *filePath, apx_socketReactorAcceptFunc_t *acceptFunc, void *arg);
+void apx_socketReactor_closeTcpListener(apx_socketReactor_t *self);
+void apx_socketReactor_closeUnixListener(apx_socketReactor_t *self);
+apx_reactorSocket_t *apx_socketReactor_adoptSocket(apx_socketReactor_t *self, int fd);
+
+apx_error_t apx_reactorSocket_start(apx_reactorSocket_t *self, const apx_reactorSocketHandler_t *handler, void *arg);
+int32_t apx_reactorSocket_send(apx_reactorSocket_t *self, const uint8_t *data, uint32_t dataLen);
+void apx_reactorSocket_close(apx_reactorSocket_t *self);
+void apx_reactorSocket_delete(apx_reactorSocket_t *self);
+uint32_t apx_reactorSocket_getPendingSendLen(apx_reactorSocket_t *self);
+
+#endif //APX_SOCKET_REACTOR_SUPPORTED
+#endif //APX_SOCKET_REACTOR_H
@@ -36,6 +36,8 @@
 #include "msocket_server.h"
 #include "testsocket.h"
 #include "dtl_type.h"
+#include "apx_socketReactor.h"
+#include "apx_shmChannel.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // PUBLIC CONSTANTS AND DATA TYPES
@@ -54,6 +56,17 @@ typedef struct apx_socketServer_tag
    char *unixConnectionTag; //Optional tag to set on new Unix socket connections
    bool isTcpServerStarted;
    bool isUnixServerStarted;
+#if APX_SOCKET_REACTOR_SUPPORTED
+   uint32_t numReactorThreads; //0 means that each connection gets its own msocket receive thread
+   apx_socketReactor_t *reactor; //created on demand when numReactorThreads > 0
+#endif
+#if APX_SHM_SUPPORTED
+   char *shmServerFile; //path to rendezvous socket for shared-memory connections
+   char *shmConnectionTag; //Optional tag to set on new shared-memory connections
+   int shmListenFd;
+   THREAD_T shmAcceptThread;
+   bool isShmServerStarted;
+#endif
 } apx_socketServer_t;
 
 #define APX_SOCKET_SERVER_LABEL "SOCKET"
@@ -66,11 +79,19 @@ void apx_socketServer_destroy(apx_socketServer_t *self);
 apx_socketServer_t* apx_socketServer_new(struct apx_server_tag *apx_server);
 void apx_socketServer_delete(apx_socketServer_t *self);
 
+#if APX_SOCKET_REACTOR_SUPPORTED
+void apx_socketServer_setReactorThreads(apx_socketServer_t *self, uint32_t numThreads);
+uint32_t apx_socketServer_getReactorThreads(apx_socketServer_t *self);
+#endif
 void apx_socketServer_startTcpServer(apx_socketServer_t *self, uint16_t tcpPort, const char *tag);
 #ifndef _WIN32
 void apx_socketServer_startUnixServer(apx_socketServer_t *self, const char *filePath, const char *tag);
 void apx_socketServer_stopUnixServer(apx_socketServer_t *self);
 #endif
+#if APX_SHM_SUPPORTED
+void apx_socketServer_startShmServer(apx_socketServer_t *self, const char *filePath, const char *tag);
+void apx_socketServer_stopShmServer(apx_socketServer_t *self);
+#endif
 void apx_socketServer_stopAll(apx_socketServer_t *self);
 void apx_socketServer_stopTcpServer(apx_socketServer_t *self);
 
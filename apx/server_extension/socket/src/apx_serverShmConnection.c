@@ -0,0 +1,389 @@
+/*****************************************************************************
+* \file      apx_serverShmConnection.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Server connection using the shared-memory transport
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_serverShmConnection.h"
+#if APX_SHM_SUPPORTED
+#include <errno.h>
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#include <stdio.h> //Debug only
+#include <unistd.h>
+#include <sys/socket.h>
+#include "apx_logging.h"
+#include "apx_transmitHandler.h"
+#include "numheader.h"
+#include "apx_server.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define SEND_BUFFER_GROW_SIZE 4096 //4KB
+#define RECEIVE_BUFFER_GROW_SIZE 4096 //4KB
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_serverShmConnection_fillTransmitHandler(apx_serverShmConnection_t *self, apx_transmitHandler_t *handler);
+static apx_error_t apx_serverShmConnection_vfillTransmitHandler(void *arg, apx_transmitHandler_t *handler);
+static uint8_t *apx_serverShmConnection_getSendBuffer(void *arg, int32_t msgLen);
+static int32_t apx_serverShmConnection_send(void *arg, int32_t offset, int32_t msgLen);
+static int32_t apx_serverShmConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
+static void apx_serverShmConnection_data(void *arg, const uint8_t *data, uint32_t dataLen);
+static void apx_serverShmConnection_disconnected(apx_serverShmConnection_t *self);
+static THREAD_PROTO(apx_serverShmConnection_receiveTask, arg);
+static void apx_serverShmConnection_stopThread(apx_serverShmConnection_t *self);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates a new shared region for the client connected on sockFd and hands it over. On success the connection owns sockFd.
+ */
+apx_error_t apx_serverShmConnection_create(apx_serverShmConnection_t *self, int sockFd)
+{
+   if ( (self != 0) && (sockFd >= 0) )
+   {
+      apx_connectionBaseVTable_t vtable;
+      apx_error_t result;
+      result = apx_shmChannel_create(&self->channel);
+      if (result != APX_NO_ERROR)
+      {
+         return result;
+      }
+      result = apx_shmChannel_sendHandles(&self->channel, sockFd);
+      if (result != APX_NO_ERROR)
+      {
+         apx_shmChannel_destroy(&self->channel);
+         return result;
+      }
+      apx_connectionBaseVTable_create(&vtable,
+            apx_serverShmConnection_vdestroy,
+            apx_serverShmConnection_vstart,
+            apx_serverShmConnection_vclose,
+            apx_serverShmConnection_vfillTransmitHandler);
+      result = apx_serverConnectionBase_create(&self->base, &vtable);
+      if (result != APX_NO_ERROR)
+      {
+         apx_shmChannel_destroy(&self->channel);
+         return result;
+      }
+      adt_bytearray_create(&self->sendBuffer, SEND_BUFFER_GROW_SIZE);
+      adt_bytearray_create(&self->receiveBuffer, RECEIVE_BUFFER_GROW_SIZE);
+      self->sockFd = sockFd;
+      self->isThreadRunning = false;
+      self->isDestroying = false;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_serverShmConnection_destroy(apx_serverShmConnection_t *self)
+{
+   if (self != 0)
+   {
+      self->isDestroying = true;
+      apx_serverShmConnection_stopThread(self);
+      apx_serverConnectionBase_destroy(&self->base);
+      adt_bytearray_destroy(&self->sendBuffer);
+      adt_bytearray_destroy(&self->receiveBuffer);
+      apx_shmChannel_destroy(&self->channel);
+      close(self->sockFd);
+   }
+}
+
+void apx_serverShmConnection_vdestroy(void *arg)
+{
+   apx_serverShmConnection_destroy((apx_serverShmConnection_t*) arg);
+}
+
+apx_serverShmConnection_t *apx_serverShmConnection_new(int sockFd)
+{
+   if (sockFd >= 0)
+   {
+      apx_serverShmConnection_t *self = (apx_serverShmConnection_t*) malloc(sizeof(apx_serverShmConnection_t));
+      if (self != 0)
+      {
+         apx_error_t result = apx_serverShmConnection_create(self, sockFd);
+         if (result != APX_NO_ERROR)
+         {
+            free(self);
+            self = (apx_serverShmConnection_t*) 0;
+         }
+      }
+      return self;
+   }
+   return (apx_serverShmConnection_t*) 0;
+}
+
+void apx_serverShmConnection_delete(apx_serverShmConnection_t *self)
+{
+   if (self != 0)
+   {
+      apx_serverShmConnection_destroy(self);
+      free(self);
+   }
+}
+
+void apx_serverShmConnection_vdelete(void *arg)
+{
+   apx_serverShmConnection_delete((apx_serverShmConnection_t*) arg);
+}
+
+void apx_serverShmConnection_start(apx_serverShmConnection_t *self)
+{
+   if ( (self != 0) && (!self->isThreadRunning) )
+   {
+      apx_serverConnectionBase_start(&self->base);
+      if (THREAD_CREATE(self->receiveThread, apx_serverShmConnection_receiveTask, self) != 0)
+      {
+         APX_LOG_ERROR("[APX_SERVER_SHM_CONNECTION] Failed to create receive thread");
+         return;
+      }
+      self->isThreadRunning = true;
+   }
+}
+
+void apx_serverShmConnection_vstart(void *arg)
+{
+   apx_serverShmConnection_start((apx_serverShmConnection_t*) arg);
+}
+
+/**
+ * Closes the shared region. The receive thread notices and detaches the connection from the server.
+ */
+void apx_serverShmConnection_close(apx_serverShmConnection_t *self)
+{
+   if (self != 0)
+   {
+      apx_shmChannel_close(&self->channel);
+      shutdown(self->sockFd, SHUT_RDWR);
+   }
+}
+
+void apx_serverShmConnection_vclose(void *arg)
+{
+   apx_serverShmConnection_close((apx_serverShmConnection_t*) arg);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_serverShmConnection_fillTransmitHandler(apx_serverShmConnection_t *self, apx_transmitHandler_t *handler)
+{
+   if (self != 0 && handler != 0)
+   {
+      handler->arg = self;
+      handler->send = apx_serverShmConnection_send;
+      handler->getSendAvail = 0;
+      handler->getSendBuffer = apx_serverShmConnection_getSendBuffer;
+      handler->sendBatch = apx_serverShmConnection_sendBatch;
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+static apx_error_t apx_serverShmConnection_vfillTransmitHandler(void *arg, apx_transmitHandler_t *handler)
+{
+   return apx_serverShmConnection_fillTransmitHandler( (apx_serverShmConnection_t*) arg, handler);
+}
+
+static uint8_t *apx_serverShmConnection_getSendBuffer(void *arg, int32_t msgLen)
+{
+   apx_serverShmConnection_t *self = (apx_serverShmConnection_t*) arg;
+   if (self != 0)
+   {
+      int8_t result=0;
+      int32_t requestedLen;
+      //create a buffer where we have room to encode the message header (the length of the message) in addition to the user requested length
+      int32_t currentLen = adt_bytearray_length(&self->sendBuffer);
+      requestedLen= msgLen + self->base.base.numHeaderLen;
+      if (currentLen<requestedLen)
+      {
+         result = adt_bytearray_resize(&self->sendBuffer, (uint32_t) requestedLen);
+      }
+      if (result == 0)
+      {
+         uint8_t *data = adt_bytearray_data(&self->sendBuffer);
+         assert(data != 0);
+         return &data[self->base.base.numHeaderLen];
+      }
+   }
+   return 0;
+}
+
+static int32_t apx_serverShmConnection_send(void *arg, int32_t offset, int32_t msgLen)
+{
+   apx_serverShmConnection_t *self = (apx_serverShmConnection_t*) arg;
+   if ( (self != 0) && (offset>=0) && (msgLen>=0))
+   {
+      int32_t sendBufferLen;
+      uint8_t *sendBuffer = adt_bytearray_data(&self->sendBuffer);
+      sendBufferLen = adt_bytearray_length(&self->sendBuffer);
+      if ((sendBuffer != 0) && (msgLen+self->base.base.numHeaderLen<=sendBufferLen) )
+      {
+         uint8_t header[sizeof(uint32_t)];
+         uint8_t headerLen;
+         uint8_t *headerEnd;
+         uint8_t *pBegin;
+         if (self->base.base.numHeaderLen == (uint8_t) sizeof(uint32_t))
+         {
+            headerEnd = header+numheader_encode32(header, (uint32_t) sizeof(header), msgLen);
+            if (headerEnd>header)
+            {
+               headerLen=headerEnd-header;
+            }
+            else
+            {
+               assert(0);
+               return -1; //header buffer too small
+            }
+         }
+         else
+         {
+            return -1; //not yet implemented
+         }
+         //place header just before user data begin
+         pBegin = sendBuffer+(self->base.base.numHeaderLen+offset-headerLen); //the part in the parenthesis is where the user data begins
+         memcpy(pBegin, header, headerLen);
+#if APX_DEBUG_ENABLE
+         printf("[SERVER-SHM] Sending %d+%d bytes\n", (int)headerLen, (int)msgLen);
+#endif
+         if (apx_shmChannel_write(&self->channel, pBegin, (uint32_t) (msgLen+headerLen)) < 0)
+         {
+            return -1;
+         }
+         return msgLen;
+      }
+      else
+      {
+         assert(0);
+      }
+   }
+   return -1;
+}
+
+/**
+ * Sends one or more messages already framed with numheader by the caller
+ */
+static int32_t apx_serverShmConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   apx_serverShmConnection_t *self = (apx_serverShmConnection_t*) arg;
+   if ( (self != 0) && (data != 0) && (dataLen >= 0) )
+   {
+#if APX_DEBUG_ENABLE
+      printf("[SERVER-SHM] Sending batch of %d bytes\n", (int)dataLen);
+#endif
+      return apx_shmChannel_write(&self->channel, data, (uint32_t) dataLen);
+   }
+   return -1;
+}
+
+static void apx_serverShmConnection_data(void *arg, const uint8_t *data, uint32_t dataLen)
+{
+   apx_serverShmConnection_t *self = (apx_serverShmConnection_t*) arg;
+   uint32_t parseLen = 0u;
+   if (adt_bytearray_length(&self->receiveBuffer) == 0u)
+   {
+      if ( (apx_serverConnectionBase_dataReceived(&self->base, data, dataLen, &parseLen) == 0) && (parseLen < dataLen) )
+      {
+         adt_bytearray_append(&self->receiveBuffer, data + parseLen, dataLen - parseLen);
+      }
+   }
+   else
+   {
+      adt_bytearray_append(&self->receiveBuffer, data, dataLen);
+      if (apx_serverConnectionBase_dataReceived(&self->base, adt_bytearray_data(&self->receiveBuffer), adt_bytearray_length(&self->receiveBuffer), &parseLen) == 0)
+      {
+         adt_bytearray_trimLeft(&self->receiveBuffer, adt_bytearray_data(&self->receiveBuffer) + parseLen);
+      }
+   }
+}
+
+static void apx_serverShmConnection_disconnected(apx_serverShmConnection_t *self)
+{
+#if APX_DEBUG_ENABLE
+   printf("[SERVER-SHM] Client disconnected\n");
+#endif
+   assert(self->base.server != 0);
+   apx_server_detachConnection(self->base.server, &self->base);
+}
+
+static THREAD_PROTO(apx_serverShmConnection_receiveTask, arg)
+{
+   apx_serverShmConnection_t *self = (apx_serverShmConnection_t*) arg;
+   if (self != 0)
+   {
+      for (;;)
+      {
+         (void) apx_shmChannel_read(&self->channel, apx_serverShmConnection_data, self);
+         if (apx_shmChannel_wait(&self->channel, self->sockFd, APX_SHM_WAIT_FOREVER) != APX_NO_ERROR)
+         {
+            break;
+         }
+      }
+      if (!self->isDestroying)
+      {
+         apx_serverShmConnection_disconnected(self);
+      }
+   }
+   THREAD_RETURN(0);
+}
+
+static void apx_serverShmConnection_stopThread(apx_serverShmConnection_t *self)
+{
+   if (self->isThreadRunning)
+   {
+      if (pthread_equal(pthread_self(), self->receiveThread) == 0)
+      {
+         void *status;
+         int s;
+         apx_shmChannel_close(&self->channel);
+         s = pthread_join(self->receiveThread, &status);
+         if (s != 0)
+         {
+            APX_LOG_ERROR("[APX_SERVER_SHM_CONNECTION] pthread_join error %d", s);
+         }
+      }
+      else
+      {
+         APX_LOG_ERROR("[APX_SERVER_SHM_CONNECTION] pthread_join attempted on pthread_self()");
+      }
+      self->isThreadRunning = false;
+   }
+}
+
+#endif //APX_SHM_SUPPORTED
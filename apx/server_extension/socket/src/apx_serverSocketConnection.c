@@ -86,8 +86,11 @@ static apx_error_t apx_serverSocketConnection_fillTransmitHandler(apx_serverSock
 static apx_error_t apx_serverSocketConnection_vfillTransmitHandler(void *arg, apx_transmitHandler_t *handler);
 static uint8_t *apx_serverSocketConnection_getSendBuffer(void *arg, int32_t msgLen);
 static int32_t apx_serverSocketConnection_send(void *arg, int32_t offset, int32_t msgLen);
+static int32_t apx_serverSocketConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen);
 static int8_t apx_serverSocketConnection_data(void *arg, const uint8_t *dataBuf, uint32_t dataLen, uint32_t *parseLen);
 static void apx_serverSocketConnection_disconnected(void *arg);
+static apx_error_t apx_serverSocketConnection_createCommon(apx_serverSocketConnection_t *self);
+static int32_t apx_serverSocketConnection_transmit(apx_serverSocketConnection_t *self, const uint8_t *data, uint32_t dataLen);
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -100,31 +103,46 @@ apx_error_t apx_serverSocketConnection_create(apx_serverSocketConnection_t *self
 {
    if ( (self != 0) && (socketObject != 0) )
    {
-      apx_connectionBaseVTable_t vtable;
-      apx_connectionBaseVTable_create(&vtable,
-            apx_serverSocketConnection_vdestroy,
-            apx_serverSocketConnection_vstart,
-            apx_serverSocketConnection_vclose,
-            apx_serverSocketConnection_vfillTransmitHandler);
-      apx_error_t result = apx_serverConnectionBase_create(&self->base, &vtable);
-      if (result != APX_NO_ERROR)
-      {
-         return result;
-      }
-      adt_bytearray_create(&self->sendBuffer, SEND_BUFFER_GROW_SIZE);
       self->socketObject = socketObject;
-      return APX_NO_ERROR;
+#if APX_SOCKET_REACTOR_SUPPORTED
+      self->reactorSocket = (apx_reactorSocket_t*) 0;
+#endif
+      return apx_serverSocketConnection_createCommon(self);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+#if APX_SOCKET_REACTOR_SUPPORTED
+apx_error_t apx_serverSocketConnection_createFromReactor(apx_serverSocketConnection_t *self, apx_reactorSocket_t *reactorSocket)
+{
+   if ( (self != 0) && (reactorSocket != 0) )
+   {
+      self->socketObject = (SOCKET_TYPE*) 0;
+      self->reactorSocket = reactorSocket;
+      return apx_serverSocketConnection_createCommon(self);
    }
    return APX_INVALID_ARGUMENT_ERROR;
 }
+#endif
 
 void apx_serverSocketConnection_destroy(apx_serverSocketConnection_t *self)
 {
    if (self != 0)
    {
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->reactorSocket != 0)
+      {
+         //Must be deleted before base is destroyed since the reactor thread may still be inside one of our handlers
+         apx_reactorSocket_delete(self->reactorSocket);
+         self->reactorSocket = (apx_reactorSocket_t*) 0;
+      }
+#endif
       apx_serverConnectionBase_destroy(&self->base);
       adt_bytearray_destroy(&self->sendBuffer);
-      SOCKET_DELETE(self->socketObject);
+      if (self->socketObject != 0)
+      {
+         SOCKET_DELETE(self->socketObject);
+      }
    }
 }
 
@@ -152,6 +170,27 @@ apx_serverSocketConnection_t *apx_serverSocketConnection_new(SOCKET_TYPE *socket
    return (apx_serverSocketConnection_t*) 0;
 }
 
+#if APX_SOCKET_REACTOR_SUPPORTED
+apx_serverSocketConnection_t *apx_serverSocketConnection_newFromReactor(apx_reactorSocket_t *reactorSocket)
+{
+   if (reactorSocket != 0)
+   {
+      apx_serverSocketConnection_t *self = (apx_serverSocketConnection_t*) malloc(sizeof(apx_serverSocketConnection_t));
+      if (self != 0)
+      {
+         apx_error_t result = apx_serverSocketConnection_createFromReactor(self, reactorSocket);
+         if (result != APX_NO_ERROR)
+         {
+            free(self);
+            self = (apx_serverSocketConnection_t*) 0;
+         }
+      }
+      return self;
+   }
+   return (apx_serverSocketConnection_t*) 0;
+}
+#endif
+
 void apx_serverSocketConnection_delete(apx_serverSocketConnection_t *self)
 {
    if (self != 0)
@@ -168,6 +207,17 @@ void apx_serverSocketConnection_vdelete(void *arg)
 
 void apx_serverSocketConnection_start(apx_serverSocketConnection_t *self)
 {
+#if APX_SOCKET_REACTOR_SUPPORTED
+   if ( (self != 0) && (self->reactorSocket != 0) )
+   {
+      apx_reactorSocketHandler_t reactorHandler;
+      apx_serverConnectionBase_start(&self->base);
+      reactorHandler.data = apx_serverSocketConnection_data;
+      reactorHandler.disconnected = apx_serverSocketConnection_disconnected;
+      apx_reactorSocket_start(self->reactorSocket, &reactorHandler, self);
+      return;
+   }
+#endif
    if ( (self != 0) && (self->socketObject != 0))
    {
       msocket_handler_t handlerTable;
@@ -189,6 +239,13 @@ void apx_serverSocketConnection_close(apx_serverSocketConnection_t *self)
 {
    if (self != 0)
    {
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->reactorSocket != 0)
+      {
+         apx_reactorSocket_close(self->reactorSocket);
+         return;
+      }
+#endif
       SOCKET_OBJECT_CLOSE(self->socketObject);
    }
 }
@@ -209,6 +266,7 @@ static apx_error_t apx_serverSocketConnection_fillTransmitHandler(apx_serverSock
       handler->send = apx_serverSocketConnection_send;
       handler->getSendAvail = 0;
       handler->getSendBuffer = apx_serverSocketConnection_getSendBuffer;
+      handler->sendBatch = apx_serverSocketConnection_sendBatch;
       return APX_NO_ERROR;
    }
    return APX_INVALID_ARGUMENT_ERROR;
@@ -254,6 +312,7 @@ static int32_t apx_serverSocketConnection_send(void *arg, int32_t offset, int32_
       sendBufferLen = adt_bytearray_length(&self->sendBuffer);
       if ((sendBuffer != 0) && (msgLen+self->base.base.numHeaderLen<=sendBufferLen) )
       {
+         int32_t result;
          uint8_t header[sizeof(uint32_t)];
          uint8_t headerLen;
          uint8_t *headerEnd;
@@ -281,7 +340,11 @@ static int32_t apx_serverSocketConnection_send(void *arg, int32_t offset, int32_
 #if APX_DEBUG_ENABLE
          printf("[SERVER-SOCKET] Sending %d+%d bytes\n", (int)headerLen, (int)msgLen);
 #endif
-         SOCKET_SEND(self->socketObject, pBegin, msgLen+headerLen);
+         result = apx_serverSocketConnection_transmit(self, pBegin, msgLen+headerLen);
+         if (result < 0)
+         {
+            return result;
+         }
          return msgLen;
       }
       else
@@ -292,6 +355,22 @@ static int32_t apx_serverSocketConnection_send(void *arg, int32_t offset, int32_
    return -1;
 }
 
+/**
+ * Sends one or more messages already framed with numheader by the caller
+ */
+static int32_t apx_serverSocketConnection_sendBatch(void *arg, const uint8_t *data, int32_t dataLen)
+{
+   apx_serverSocketConnection_t *self = (apx_serverSocketConnection_t*) arg;
+   if ( (self != 0) && (data != 0) && (dataLen >= 0) )
+   {
+#if APX_DEBUG_ENABLE
+      printf("[SERVER-SOCKET] Sending batch of %d bytes\n", (int)dataLen);
+#endif
+      return apx_serverSocketConnection_transmit(self, data, (uint32_t) dataLen);
+   }
+   return -1;
+}
+
 static int8_t apx_serverSocketConnection_data(void *arg, const uint8_t *dataBuf, uint32_t dataLen, uint32_t *parseLen)
 {
    apx_serverSocketConnection_t *self = (apx_serverSocketConnection_t*) arg;
@@ -318,4 +397,36 @@ static void apx_serverSocketConnection_disconnected(void *arg)
    }
 }
 
+static apx_error_t apx_serverSocketConnection_createCommon(apx_serverSocketConnection_t *self)
+{
+   apx_connectionBaseVTable_t vtable;
+   apx_error_t result;
+   apx_connectionBaseVTable_create(&vtable,
+         apx_serverSocketConnection_vdestroy,
+         apx_serverSocketConnection_vstart,
+         apx_serverSocketConnection_vclose,
+         apx_serverSocketConnection_vfillTransmitHandler);
+   result = apx_serverConnectionBase_create(&self->base, &vtable);
+   if (result != APX_NO_ERROR)
+   {
+      return result;
+   }
+   adt_bytearray_create(&self->sendBuffer, SEND_BUFFER_GROW_SIZE);
+   return APX_NO_ERROR;
+}
 
+static int32_t apx_serverSocketConnection_transmit(apx_serverSocketConnection_t *self, const uint8_t *data, uint32_t dataLen)
+{
+#if APX_SOCKET_REACTOR_SUPPORTED
+   if (self->reactorSocket != 0)
+   {
+      int32_t result = apx_reactorSocket_send(self->reactorSocket, data, dataLen);
+      return (result == APX_REACTOR_SOCKET_WOULD_BLOCK)? APX_TRANSMIT_HANDLER_WOULD_BLOCK : result;
+   }
+#endif
+   if (SOCKET_SEND(self->socketObject, data, dataLen) != 0)
+   {
+      return -1;
+   }
+   return (int32_t) dataLen;
+}
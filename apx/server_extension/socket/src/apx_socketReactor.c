@@ -0,0 +1,1034 @@
+/*****************************************************************************
+* \file      apx_socketReactor.c
+* \author    agent
+* \date      2026-10-18
+* \brief     epoll-based reactor that multiplexes server sockets over a small pool of threads
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include "apx_socketReactor.h"
+#if APX_SOCKET_REACTOR_SUPPORTED
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "apx_logging.h"
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#define KIND_SOCKET   1u
+#define KIND_LISTENER 2u
+
+#define READ_EVENTS (EPOLLIN | EPOLLRDHUP)
+#define ERROR_EVENTS (EPOLLRDHUP | EPOLLHUP | EPOLLERR)
+
+#define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define ATOMIC_INCREMENT_RELEASE(p) ((void) __atomic_fetch_add((p), 1u, __ATOMIC_RELEASE))
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_reactorThread_create(apx_reactorThread_t *self, apx_socketReactor_t *reactor);
+static void apx_reactorThread_destroy(apx_reactorThread_t *self);
+static void apx_reactorThread_wakeup(apx_reactorThread_t *self);
+static void apx_reactorThread_collectGarbage(apx_reactorThread_t *self);
+static THREAD_PROTO(apx_reactorThread_run, arg);
+static void apx_reactorListener_create(apx_reactorListener_t *self);
+static apx_error_t apx_reactorListener_open(apx_reactorListener_t *self, apx_socketReactor_t *reactor, int fd, apx_socketReactorAcceptFunc_t *acceptFunc, void *arg);
+static void apx_reactorListener_close(apx_reactorListener_t *self, apx_socketReactor_t *reactor);
+static void apx_reactorListener_accept(apx_reactorListener_t *self, apx_socketReactor_t *reactor);
+static void apx_reactorSocket_free(apx_reactorSocket_t *self);
+static void apx_reactorSocket_handleEvents(apx_reactorSocket_t *self, uint32_t events);
+static bool apx_reactorSocket_receive(apx_reactorSocket_t *self);
+static bool apx_reactorSocket_dispatch(apx_reactorSocket_t *self);
+static bool apx_reactorSocket_flush(apx_reactorSocket_t *self);
+static bool apx_reactorSocket_appendTxData(apx_reactorSocket_t *self, const uint8_t *data, uint32_t dataLen);
+static bool apx_reactorSocket_growTxBuf(apx_reactorSocket_t *self, uint32_t requiredCapacity);
+static bool apx_reactorSocket_isTxLimitReached(apx_reactorSocket_t *self, uint32_t dataLen);
+static void apx_reactorSocket_armWrite(apx_reactorSocket_t *self, bool enable);
+static void apx_reactorSocket_disconnect(apx_reactorSocket_t *self);
+static int apx_socketReactor_setNonBlocking(int fd);
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+apx_error_t apx_socketReactor_create(apx_socketReactor_t *self, uint32_t numThreads)
+{
+   if ( (self != 0) && (numThreads > 0u) )
+   {
+      uint32_t i;
+      if (numThreads > APX_SOCKET_REACTOR_MAX_THREADS)
+      {
+         numThreads = APX_SOCKET_REACTOR_MAX_THREADS;
+      }
+      self->threads = (apx_reactorThread_t*) malloc(numThreads * sizeof(apx_reactorThread_t));
+      if (self->threads == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      for (i = 0u; i < numThreads; i++)
+      {
+         apx_error_t result = apx_reactorThread_create(&self->threads[i], self);
+         if (result != APX_NO_ERROR)
+         {
+            while (i > 0u)
+            {
+               apx_reactorThread_destroy(&self->threads[--i]);
+            }
+            free(self->threads);
+            self->threads = (apx_reactorThread_t*) 0;
+            return result;
+         }
+      }
+      self->numThreads = numThreads;
+      self->nextThread = 0u;
+      self->maxPendingSendLen = APX_SOCKET_REACTOR_MAX_PENDING_SEND;
+      self->isRunning = false;
+      apx_reactorListener_create(&self->tcpListener);
+      apx_reactorListener_create(&self->unixListener);
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_socketReactor_destroy(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      apx_socketReactor_stop(self);
+      apx_reactorListener_close(&self->tcpListener, self);
+      apx_reactorListener_close(&self->unixListener, self);
+      for (i = 0u; i < self->numThreads; i++)
+      {
+         apx_reactorThread_destroy(&self->threads[i]);
+      }
+      free(self->threads);
+      self->threads = (apx_reactorThread_t*) 0;
+      self->numThreads = 0u;
+   }
+}
+
+apx_socketReactor_t *apx_socketReactor_new(uint32_t numThreads)
+{
+   apx_socketReactor_t *self = (apx_socketReactor_t*) malloc(sizeof(apx_socketReactor_t));
+   if (self != 0)
+   {
+      apx_error_t result = apx_socketReactor_create(self, numThreads);
+      if (result != APX_NO_ERROR)
+      {
+         free(self);
+         self = (apx_socketReactor_t*) 0;
+      }
+   }
+   return self;
+}
+
+void apx_socketReactor_delete(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      apx_socketReactor_destroy(self);
+      free(self);
+   }
+}
+
+apx_error_t apx_socketReactor_start(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      if (self->isRunning)
+      {
+         return APX_NO_ERROR;
+      }
+      ATOMIC_STORE(&self->isRunning, true);
+      for (i = 0u; i < self->numThreads; i++)
+      {
+         apx_reactorThread_t *thread = &self->threads[i];
+         if (THREAD_CREATE(thread->thread, apx_reactorThread_run, thread) != 0)
+         {
+            apx_socketReactor_stop(self);
+            return APX_THREAD_CREATE_ERROR;
+         }
+         ATOMIC_STORE(&thread->isThreadValid, true);
+      }
+      return APX_NO_ERROR;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_socketReactor_stop(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      uint32_t i;
+      ATOMIC_STORE(&self->isRunning, false);
+      for (i = 0u; i < self->numThreads; i++)
+      {
+         apx_reactorThread_t *thread = &self->threads[i];
+         if (thread->isThreadValid)
+         {
+            apx_reactorThread_wakeup(thread);
+            if (pthread_equal(pthread_self(), thread->thread) == 0)
+            {
+               void *status;
+               int s = pthread_join(thread->thread, &status);
+               if (s != 0)
+               {
+                  APX_LOG_ERROR("[APX_SOCKET_REACTOR] pthread_join error %d", s);
+               }
+            }
+            else
+            {
+               APX_LOG_ERROR("[APX_SOCKET_REACTOR] pthread_join attempted on pthread_self()");
+            }
+            ATOMIC_STORE(&thread->isThreadValid, false);
+         }
+         apx_reactorThread_collectGarbage(thread);
+      }
+   }
+}
+
+uint32_t apx_socketReactor_getNumThreads(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      return self->numThreads;
+   }
+   return 0u;
+}
+
+/**
+ * Limits how much data each socket buffers for a peer that does not keep up. Should be set before any socket is started.
+ * A single send to a socket with nothing pending is always accepted, even when it is larger than the limit.
+ */
+void apx_socketReactor_setMaxPendingSendLen(apx_socketReactor_t *self, uint32_t maxPendingSendLen)
+{
+   if (self != 0)
+   {
+      self->maxPendingSendLen = maxPendingSendLen;
+   }
+}
+
+apx_error_t apx_socketReactor_listenTcp(apx_socketReactor_t *self, uint16_t tcpPort, apx_socketReactorAcceptFunc_t *acceptFunc, void *arg)
+{
+   if ( (self != 0) && (acceptFunc != 0) )
+   {
+      struct sockaddr_in addr;
+      int optval = 1;
+      int fd;
+      if (self->tcpListener.fd >= 0)
+      {
+         return APX_INVALID_STATE_ERROR;
+      }
+      fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      (void) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+      memset(&addr, 0, sizeof(addr));
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_ANY);
+      addr.sin_port = htons(tcpPort);
+      if ( (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) || (listen(fd, SOMAXCONN) != 0) )
+      {
+         APX_LOG_ERROR("[APX_SOCKET_REACTOR] Failed to listen on TCP port %d, errno=%d", (int) tcpPort, errno);
+         close(fd);
+         return APX_CONNECTION_ERROR;
+      }
+      return apx_reactorListener_open(&self->tcpListener, self, fd, acceptFunc, arg);
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+apx_error_t apx_socketReactor_listenUnix(apx_socketReactor_t *self, const char *filePath, apx_socketReactorAcceptFunc_t *acceptFunc, void *arg)
+{
+   if ( (self != 0) && (filePath != 0) && (acceptFunc != 0) )
+   {
+      struct sockaddr_un addr;
+      apx_error_t result;
+      int fd;
+      if (self->unixListener.fd >= 0)
+      {
+         return APX_INVALID_STATE_ERROR;
+      }
+      if (strlen(filePath) >= sizeof(addr.sun_path))
+      {
+         return APX_NAME_TOO_LONG_ERROR;
+      }
+      fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+      {
+         return APX_CONNECTION_ERROR;
+      }
+      memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      strcpy(addr.sun_path, filePath);
+      (void) unlink(filePath);
+      if ( (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) || (listen(fd, SOMAXCONN) != 0) )
+      {
+         APX_LOG_ERROR("[APX_SOCKET_REACTOR] Failed to listen on %s, errno=%d", filePath, errno);
+         close(fd);
+         return APX_CONNECTION_ERROR;
+      }
+      result = apx_reactorListener_open(&self->unixListener, self, fd, acceptFunc, arg);
+      if (result == APX_NO_ERROR)
+      {
+         self->unixListener.unixPath = STRDUP(filePath);
+      }
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+void apx_socketReactor_closeTcpListener(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      apx_reactorListener_close(&self->tcpListener, self);
+   }
+}
+
+void apx_socketReactor_closeUnixListener(apx_socketReactor_t *self)
+{
+   if (self != 0)
+   {
+      apx_reactorListener_close(&self->unixListener, self);
+   }
+}
+
+/**
+ * Wraps an already connected socket. The socket is switched to non-blocking mode.
+ * No events are processed for the socket until apx_reactorSocket_start has been called.
+ */
+apx_reactorSocket_t *apx_socketReactor_adoptSocket(apx_socketReactor_t *self, int fd)
+{
+   if ( (self != 0) && (fd >= 0) )
+   {
+      apx_reactorSocket_t *sock;
+      if (apx_socketReactor_setNonBlocking(fd) != 0)
+      {
+         return (apx_reactorSocket_t*) 0;
+      }
+      sock = (apx_reactorSocket_t*) malloc(sizeof(apx_reactorSocket_t));
+      if (sock != 0)
+      {
+         memset(sock, 0, sizeof(apx_reactorSocket_t));
+         sock->kind = KIND_SOCKET;
+         sock->fd = fd;
+         sock->reactor = self;
+         MUTEX_INIT(sock->txLock);
+      }
+      return sock;
+   }
+   return (apx_reactorSocket_t*) 0;
+}
+
+/**
+ * Assigns the socket to one of the reactor threads (round-robin) and starts receiving data.
+ * All handler callbacks are made from the assigned reactor thread.
+ */
+apx_error_t apx_reactorSocket_start(apx_reactorSocket_t *self, const apx_reactorSocketHandler_t *handler, void *arg)
+{
+   if ( (self != 0) && (handler != 0) )
+   {
+      apx_socketReactor_t *reactor = self->reactor;
+      struct epoll_event event;
+      apx_error_t result = APX_NO_ERROR;
+      MUTEX_LOCK(self->txLock);
+      if (self->isRegistered || self->isClosed)
+      {
+         result = APX_INVALID_STATE_ERROR;
+      }
+      else
+      {
+         self->handler = *handler;
+         self->handlerArg = arg;
+         self->thread = &reactor->threads[ATOMIC_FETCH_ADD(&reactor->nextThread, 1u) % reactor->numThreads];
+         memset(&event, 0, sizeof(event));
+         self->isWriteArmed = (self->txLen > 0u);
+         event.events = self->isWriteArmed? (READ_EVENTS | EPOLLOUT) : READ_EVENTS;
+         event.data.ptr = (void*) self;
+         if (epoll_ctl(self->thread->epollFd, EPOLL_CTL_ADD, self->fd, &event) == 0)
+         {
+            self->isRegistered = true;
+         }
+         else
+         {
+            result = APX_CONNECTION_ERROR;
+         }
+      }
+      MUTEX_UNLOCK(self->txLock);
+      return result;
+   }
+   return APX_INVALID_ARGUMENT_ERROR;
+}
+
+/**
+ * Sends data without blocking. Whatever the kernel does not accept right away is buffered and written by the reactor
+ * thread once the socket becomes writable again. Data is always sent in the same order as it was given to this function.
+ * Returns dataLen on success and -1 if the socket has been closed. Returns APX_REACTOR_SOCKET_WOULD_BLOCK without sending
+ * anything when the data does not fit below the reactor's pending send limit, so messages are never cut in half.
+ */
+int32_t apx_reactorSocket_send(apx_reactorSocket_t *self, const uint8_t *data, uint32_t dataLen)
+{
+   int32_t retval = -1;
+   if ( (self != 0) && ( (data != 0) || (dataLen == 0u) ) )
+   {
+      uint32_t numSent = 0u;
+      MUTEX_LOCK(self->txLock);
+      if (!self->isClosed)
+      {
+         retval = (int32_t) dataLen;
+         if (apx_reactorSocket_isTxLimitReached(self, dataLen))
+         {
+            retval = APX_REACTOR_SOCKET_WOULD_BLOCK;
+         }
+         else if (self->txLen == 0u)
+         {
+            while (numSent < dataLen)
+            {
+               ssize_t n = send(self->fd, &data[numSent], dataLen - numSent, MSG_NOSIGNAL | MSG_DONTWAIT);
+               if (n > 0)
+               {
+                  numSent += (uint32_t) n;
+               }
+               else if ( (n < 0) && (errno == EINTR) )
+               {
+                  continue;
+               }
+               else
+               {
+                  if ( (n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) )
+                  {
+                     retval = -1; //the reactor thread will see the error and report the disconnect
+                  }
+                  break;
+               }
+            }
+         }
+         if ( (retval >= 0) && (numSent < dataLen) )
+         {
+            if (apx_reactorSocket_appendTxData(self, &data[numSent], dataLen - numSent))
+            {
+               apx_reactorSocket_armWrite(self, true);
+            }
+            else
+            {
+               retval = -1;
+            }
+         }
+      }
+      MUTEX_UNLOCK(self->txLock);
+   }
+   return retval;
+}
+
+/**
+ * Shuts down the connection. The disconnected handler is called from the reactor thread once the shutdown has been observed.
+ */
+void apx_reactorSocket_close(apx_reactorSocket_t *self)
+{
+   if (self != 0)
+   {
+      MUTEX_LOCK(self->txLock);
+      if (!self->isClosed)
+      {
+         (void) shutdown(self->fd, SHUT_RDWR);
+         if (!self->isRegistered)
+         {
+            self->isClosed = true;
+         }
+      }
+      MUTEX_UNLOCK(self->txLock);
+   }
+}
+
+/**
+ * Closes the socket and releases its memory. When called from a thread other than the owning reactor thread this function
+ * waits until the reactor thread has finished its current batch of events, after which no more handler callbacks will be made.
+ * When called from within a handler callback the memory is released once the current batch of events has been processed.
+ */
+void apx_reactorSocket_delete(apx_reactorSocket_t *self)
+{
+   if (self != 0)
+   {
+      apx_reactorThread_t *thread = self->thread;
+      MUTEX_LOCK(self->txLock);
+      ATOMIC_STORE(&self->isDeleted, true);
+      self->isClosed = true;
+      if (self->isRegistered)
+      {
+         (void) epoll_ctl(thread->epollFd, EPOLL_CTL_DEL, self->fd, (struct epoll_event*) 0);
+         self->isRegistered = false;
+      }
+      MUTEX_UNLOCK(self->txLock);
+      if ( (thread != 0) && ATOMIC_LOAD(&thread->isThreadValid) )
+      {
+         if (pthread_equal(pthread_self(), thread->thread) != 0)
+         {
+            SPINLOCK_ENTER(thread->garbageLock);
+            self->nextGarbage = thread->garbage;
+            thread->garbage = self;
+            SPINLOCK_LEAVE(thread->garbageLock);
+            return;
+         }
+         else
+         {
+            uint32_t loopCount = ATOMIC_LOAD(&thread->loopCount);
+            apx_reactorThread_wakeup(thread);
+            while ( (ATOMIC_LOAD(&thread->loopCount) == loopCount) && ATOMIC_LOAD(&thread->isThreadValid) )
+            {
+               sched_yield();
+            }
+         }
+      }
+      apx_reactorSocket_free(self);
+   }
+}
+
+uint32_t apx_reactorSocket_getPendingSendLen(apx_reactorSocket_t *self)
+{
+   uint32_t retval = 0u;
+   if (self != 0)
+   {
+      MUTEX_LOCK(self->txLock);
+      retval = self->txLen;
+      MUTEX_UNLOCK(self->txLock);
+   }
+   return retval;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+static apx_error_t apx_reactorThread_create(apx_reactorThread_t *self, apx_socketReactor_t *reactor)
+{
+   struct epoll_event event;
+   self->reactor = reactor;
+   self->garbage = (apx_reactorSocket_t*) 0;
+   self->loopCount = 0u;
+   self->isThreadValid = false;
+   self->epollFd = epoll_create1(EPOLL_CLOEXEC);
+   if (self->epollFd < 0)
+   {
+      return APX_GENERIC_ERROR;
+   }
+   self->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+   if (self->wakeFd < 0)
+   {
+      close(self->epollFd);
+      return APX_GENERIC_ERROR;
+   }
+   memset(&event, 0, sizeof(event));
+   event.events = EPOLLIN;
+   event.data.ptr = (void*) 0; //a NULL pointer identifies the wakeup event
+   if (epoll_ctl(self->epollFd, EPOLL_CTL_ADD, self->wakeFd, &event) != 0)
+   {
+      close(self->wakeFd);
+      close(self->epollFd);
+      return APX_GENERIC_ERROR;
+   }
+   SPINLOCK_INIT(self->garbageLock);
+   return APX_NO_ERROR;
+}
+
+static void apx_reactorThread_destroy(apx_reactorThread_t *self)
+{
+   apx_reactorThread_collectGarbage(self);
+   close(self->wakeFd);
+   close(self->epollFd);
+   SPINLOCK_DESTROY(self->garbageLock);
+}
+
+static void apx_reactorThread_wakeup(apx_reactorThread_t *self)
+{
+   uint64_t value = 1u;
+   ssize_t result = write(self->wakeFd, &value, sizeof(value));
+   (void) result;
+}
+
+static void apx_reactorThread_collectGarbage(apx_reactorThread_t *self)
+{
+   apx_reactorSocket_t *garbage;
+   SPINLOCK_ENTER(self->garbageLock);
+   garbage = self->garbage;
+   self->garbage = (apx_reactorSocket_t*) 0;
+   SPINLOCK_LEAVE(self->garbageLock);
+   while (garbage != 0)
+   {
+      apx_reactorSocket_t *next = garbage->nextGarbage;
+      apx_reactorSocket_free(garbage);
+      garbage = next;
+   }
+}
+
+static THREAD_PROTO(apx_reactorThread_run, arg)
+{
+   apx_reactorThread_t *self = (apx_reactorThread_t*) arg;
+   if (self != 0)
+   {
+      struct epoll_event events[APX_SOCKET_REACTOR_MAX_EVENTS];
+      while (ATOMIC_LOAD(&self->reactor->isRunning))
+      {
+         int i;
+         int numEvents = epoll_wait(self->epollFd, &events[0], APX_SOCKET_REACTOR_MAX_EVENTS, -1);
+         if (numEvents < 0)
+         {
+            if (errno == EINTR)
+            {
+               continue;
+            }
+            APX_LOG_ERROR("[APX_SOCKET_REACTOR] epoll_wait failed, errno=%d", errno);
+            break;
+         }
+         for (i = 0; i < numEvents; i++)
+         {
+            void *ptr = events[i].data.ptr;
+            if (ptr == 0)
+            {
+               uint64_t value;
+               ssize_t result = read(self->wakeFd, &value, sizeof(value));
+               (void) result;
+            }
+            else if ( *((uint8_t*) ptr) == KIND_LISTENER )
+            {
+               apx_reactorListener_accept((apx_reactorListener_t*) ptr, self->reactor);
+            }
+            else
+            {
+               apx_reactorSocket_handleEvents((apx_reactorSocket_t*) ptr, events[i].events);
+            }
+         }
+         apx_reactorThread_collectGarbage(self);
+         ATOMIC_INCREMENT_RELEASE(&self->loopCount);
+      }
+      ATOMIC_INCREMENT_RELEASE(&self->loopCount);
+   }
+   THREAD_RETURN(0);
+}
+
+static void apx_reactorListener_create(apx_reactorListener_t *self)
+{
+   self->kind = KIND_LISTENER;
+   self->fd = -1;
+   self->acceptFunc = (apx_socketReactorAcceptFunc_t*) 0;
+   self->acceptArg = (void*) 0;
+   self->unixPath = (char*) 0;
+}
+
+/**
+ * Listeners are always served by the first reactor thread
+ */
+static apx_error_t apx_reactorListener_open(apx_reactorListener_t *self, apx_socketReactor_t *reactor, int fd, apx_socketReactorAcceptFunc_t *acceptFunc, void *arg)
+{
+   struct epoll_event event;
+   if (self->fd >= 0)
+   {
+      close(fd);
+      return APX_INVALID_STATE_ERROR;
+   }
+   self->acceptFunc = acceptFunc;
+   self->acceptArg = arg;
+   self->fd = fd;
+   memset(&event, 0, sizeof(event));
+   event.events = EPOLLIN;
+   event.data.ptr = (void*) self;
+   if (epoll_ctl(reactor->threads[0].epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+   {
+      self->fd = -1;
+      close(fd);
+      return APX_CONNECTION_ERROR;
+   }
+   return APX_NO_ERROR;
+}
+
+static void apx_reactorListener_close(apx_reactorListener_t *self, apx_socketReactor_t *reactor)
+{
+   if (self->fd >= 0)
+   {
+      int fd = self->fd;
+      (void) epoll_ctl(reactor->threads[0].epollFd, EPOLL_CTL_DEL, fd, (struct epoll_event*) 0);
+      ATOMIC_STORE(&self->fd, -1);
+      close(fd);
+   }
+   if (self->unixPath != 0)
+   {
+      (void) unlink(self->unixPath);
+      free(self->unixPath);
+      self->unixPath = (char*) 0;
+   }
+}
+
+static void apx_reactorListener_accept(apx_reactorListener_t *self, apx_socketReactor_t *reactor)
+{
+   for (;;)
+   {
+      apx_reactorSocket_t *sock;
+      int listenFd = ATOMIC_LOAD(&self->fd);
+      int fd;
+      if (listenFd < 0)
+      {
+         break;
+      }
+      fd = accept(listenFd, (struct sockaddr*) 0, (socklen_t*) 0); //apx_socketReactor_adoptSocket makes it non-blocking
+      if (fd < 0)
+      {
+         if (errno == EINTR)
+         {
+            continue;
+         }
+         if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) )
+         {
+            APX_LOG_ERROR("[APX_SOCKET_REACTOR] accept failed, errno=%d", errno);
+         }
+         break;
+      }
+      if (self->unixPath == 0)
+      {
+         int optval = 1;
+         (void) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(optval));
+      }
+      sock = apx_socketReactor_adoptSocket(reactor, fd);
+      if (sock == 0)
+      {
+         close(fd);
+         continue;
+      }
+      self->acceptFunc(self->acceptArg, sock);
+   }
+}
+
+static void apx_reactorSocket_free(apx_reactorSocket_t *self)
+{
+   close(self->fd);
+   if (self->rxBuf != 0)
+   {
+      free(self->rxBuf);
+   }
+   if (self->txBuf != 0)
+   {
+      free(self->txBuf);
+   }
+   MUTEX_DESTROY(self->txLock);
+   free(self);
+}
+
+static void apx_reactorSocket_handleEvents(apx_reactorSocket_t *self, uint32_t events)
+{
+   bool isConnected = true;
+   if (ATOMIC_LOAD(&self->isDeleted))
+   {
+      return;
+   }
+   if ( (events & EPOLLOUT) != 0u )
+   {
+      isConnected = apx_reactorSocket_flush(self);
+   }
+   if ( isConnected && ( (events & (EPOLLIN | ERROR_EVENTS)) != 0u ) )
+   {
+      isConnected = apx_reactorSocket_receive(self);
+   }
+   if (!isConnected)
+   {
+      apx_reactorSocket_disconnect(self);
+   }
+}
+
+/**
+ * Reads available data and hands it to the data handler. Returns false when the connection has been lost.
+ */
+static bool apx_reactorSocket_receive(apx_reactorSocket_t *self)
+{
+   ssize_t n;
+   if ( (self->rxCapacity - self->rxLen) < APX_SOCKET_REACTOR_READ_SIZE)
+   {
+      uint32_t newCapacity = self->rxCapacity + APX_SOCKET_REACTOR_READ_SIZE;
+      uint8_t *newBuf = (uint8_t*) realloc(self->rxBuf, newCapacity);
+      if (newBuf == 0)
+      {
+         return false;
+      }
+      self->rxBuf = newBuf;
+      self->rxCapacity = newCapacity;
+   }
+   do
+   {
+      n = recv(self->fd, &self->rxBuf[self->rxLen], self->rxCapacity - self->rxLen, 0);
+   } while ( (n < 0) && (errno == EINTR) );
+   if (n > 0)
+   {
+      self->rxLen += (uint32_t) n;
+      return apx_reactorSocket_dispatch(self);
+   }
+   else if ( (n < 0) && ( (errno == EAGAIN) || (errno == EWOULDBLOCK) ) )
+   {
+      return true;
+   }
+   return false;
+}
+
+static bool apx_reactorSocket_dispatch(apx_reactorSocket_t *self)
+{
+   uint32_t offset = 0u;
+   bool retval = true;
+   while ( (offset < self->rxLen) && (!ATOMIC_LOAD(&self->isDeleted)) )
+   {
+      uint32_t parseLen = 0u;
+      uint32_t remain = self->rxLen - offset;
+      int8_t result = self->handler.data(self->handlerArg, &self->rxBuf[offset], remain, &parseLen);
+      if ( (result != 0) || (parseLen > remain) )
+      {
+         retval = false;
+         break;
+      }
+      if (parseLen == 0u)
+      {
+         break; //wait for more data
+      }
+      offset += parseLen;
+   }
+   if (offset > 0u)
+   {
+      self->rxLen -= offset;
+      if (self->rxLen > 0u)
+      {
+         memmove(&self->rxBuf[0], &self->rxBuf[offset], self->rxLen);
+      }
+   }
+   return retval;
+}
+
+/**
+ * Writes buffered data from the reactor thread. Returns false when the connection has been lost.
+ */
+static bool apx_reactorSocket_flush(apx_reactorSocket_t *self)
+{
+   bool retval = true;
+   MUTEX_LOCK(self->txLock);
+   while (self->txLen > 0u)
+   {
+      struct iovec iov[2];
+      struct msghdr msg;
+      ssize_t n;
+      uint32_t firstLen = self->txCapacity - self->txHead;
+      if (firstLen > self->txLen)
+      {
+         firstLen = self->txLen;
+      }
+      iov[0].iov_base = &self->txBuf[self->txHead];
+      iov[0].iov_len = firstLen;
+      iov[1].iov_base = &self->txBuf[0];
+      iov[1].iov_len = self->txLen - firstLen;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov[0];
+      msg.msg_iovlen = (iov[1].iov_len > 0u)? 2 : 1;
+      n = sendmsg(self->fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+      if (n > 0)
+      {
+         self->txHead += (uint32_t) n;
+         if (self->txHead >= self->txCapacity)
+         {
+            self->txHead -= self->txCapacity;
+         }
+         self->txLen -= (uint32_t) n;
+      }
+      else if ( (n < 0) && (errno == EINTR) )
+      {
+         continue;
+      }
+      else
+      {
+         if ( (n == 0) || ( (errno != EAGAIN) && (errno != EWOULDBLOCK) ) )
+         {
+            retval = false;
+         }
+         break;
+      }
+   }
+   if (self->txLen == 0u)
+   {
+      self->txHead = 0u;
+      apx_reactorSocket_armWrite(self, false);
+   }
+   MUTEX_UNLOCK(self->txLock);
+   return retval;
+}
+
+/**
+ * Caller must hold txLock
+ */
+static bool apx_reactorSocket_appendTxData(apx_reactorSocket_t *self, const uint8_t *data, uint32_t dataLen)
+{
+   uint32_t tail;
+   uint32_t firstLen;
+   if ( (self->txCapacity - self->txLen) < dataLen)
+   {
+      if ( (dataLen > (UINT32_MAX - self->txLen)) || (!apx_reactorSocket_growTxBuf(self, self->txLen + dataLen)) )
+      {
+         return false;
+      }
+   }
+   tail = self->txHead + self->txLen;
+   if (tail >= self->txCapacity)
+   {
+      tail -= self->txCapacity;
+   }
+   firstLen = self->txCapacity - tail;
+   if (firstLen > dataLen)
+   {
+      firstLen = dataLen;
+   }
+   memcpy(&self->txBuf[tail], data, firstLen);
+   if (firstLen < dataLen)
+   {
+      memcpy(&self->txBuf[0], &data[firstLen], dataLen - firstLen);
+   }
+   self->txLen += dataLen;
+   return true;
+}
+
+/**
+ * Caller must hold txLock. Capacity is doubled so that each pending byte is copied a bounded number of times.
+ */
+static bool apx_reactorSocket_growTxBuf(apx_reactorSocket_t *self, uint32_t requiredCapacity)
+{
+   uint32_t newCapacity = (self->txCapacity > 0u)? self->txCapacity : APX_SOCKET_REACTOR_READ_SIZE;
+   uint8_t *newBuf;
+   while (newCapacity < requiredCapacity)
+   {
+      if (newCapacity > (UINT32_MAX / 2u))
+      {
+         newCapacity = requiredCapacity;
+         break;
+      }
+      newCapacity *= 2u;
+   }
+   newBuf = (uint8_t*) malloc(newCapacity);
+   if (newBuf == 0)
+   {
+      return false;
+   }
+   if (self->txLen > 0u)
+   {
+      uint32_t firstLen = self->txCapacity - self->txHead;
+      if (firstLen > self->txLen)
+      {
+         firstLen = self->txLen;
+      }
+      memcpy(&newBuf[0], &self->txBuf[self->txHead], firstLen);
+      memcpy(&newBuf[firstLen], &self->txBuf[0], self->txLen - firstLen);
+   }
+   if (self->txBuf != 0)
+   {
+      free(self->txBuf);
+   }
+   self->txBuf = newBuf;
+   self->txCapacity = newCapacity;
+   self->txHead = 0u;
+   return true;
+}
+
+/**
+ * Caller must hold txLock. Data is only refused while something is already pending, a single large message to an idle
+ * socket is accepted so that it can make progress.
+ */
+static bool apx_reactorSocket_isTxLimitReached(apx_reactorSocket_t *self, uint32_t dataLen)
+{
+   uint32_t limit = self->reactor->maxPendingSendLen;
+   if ( (limit == 0u) || (self->txLen == 0u) )
+   {
+      return false;
+   }
+   return ( (self->txLen >= limit) || (dataLen > (limit - self->txLen)) )? true : false;
+}
+
+/**
+ * Caller must hold txLock
+ */
+static void apx_reactorSocket_armWrite(apx_reactorSocket_t *self, bool enable)
+{
+   if ( self->isRegistered && (self->isWriteArmed != enable) )
+   {
+      struct epoll_event event;
+      memset(&event, 0, sizeof(event));
+      event.events = enable? (READ_EVENTS | EPOLLOUT) : READ_EVENTS;
+      event.data.ptr = (void*) self;
+      if (epoll_ctl(self->thread->epollFd, EPOLL_CTL_MOD, self->fd, &event) == 0)
+      {
+         self->isWriteArmed = enable;
+      }
+   }
+}
+
+static void apx_reactorSocket_disconnect(apx_reactorSocket_t *self)
+{
+   bool notify = false;
+   MUTEX_LOCK(self->txLock);
+   if (self->isRegistered)
+   {
+      (void) epoll_ctl(self->thread->epollFd, EPOLL_CTL_DEL, self->fd, (struct epoll_event*) 0);
+      self->isRegistered = false;
+      notify = true;
+   }
+   self->isClosed = true;
+   MUTEX_UNLOCK(self->txLock);
+   if ( notify && (self->handler.disconnected != 0) && (!ATOMIC_LOAD(&self->isDeleted)) )
+   {
+      self->handler.disconnected(self->handlerArg);
+   }
+}
+
+static int apx_socketReactor_setNonBlocking(int fd)
+{
+   int flags = fcntl(fd, F_GETFL, 0);
+   if (flags < 0)
+   {
+      return -1;
+   }
+   return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+#endif //APX_SOCKET_REACTOR_SUPPORTED
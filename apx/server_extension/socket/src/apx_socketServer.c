@@ -34,6 +34,13 @@
 #include "apx_socketServer.h"
 #include "apx_server.h"
 #include "apx_serverSocketConnection.h"
+#if APX_SHM_SUPPORTED
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "apx_serverShmConnection.h"
+#endif
 #ifdef MEM_LEAK_CHECK
 #include "CMemLeak.h"
 #endif
@@ -68,6 +75,18 @@ static void apx_socketServer_tcpAccept(void *arg, struct msocket_server_tag *srv
 #ifndef UNIT_TEST
 static void apx_socketServer_unixAccept(void *arg, struct msocket_server_tag *srv, SOCKET_TYPE *sock);
 #endif
+#if APX_SOCKET_REACTOR_SUPPORTED
+static apx_error_t apx_socketServer_prepareReactor(apx_socketServer_t *self);
+static void apx_socketServer_reactorTcpAccept(void *arg, apx_reactorSocket_t *sock);
+#ifndef _WIN32
+static void apx_socketServer_reactorUnixAccept(void *arg, apx_reactorSocket_t *sock);
+#endif
+static void apx_socketServer_reactorAccept(apx_socketServer_t *self, apx_reactorSocket_t *sock, const char *tag);
+#endif
+#if APX_SHM_SUPPORTED
+static THREAD_PROTO(apx_socketServer_shmAcceptTask, arg);
+static void apx_socketServer_shmAccept(apx_socketServer_t *self, int sockFd);
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 // PRIVATE VARIABLES
@@ -87,6 +106,16 @@ void apx_socketServer_create(apx_socketServer_t *self, struct apx_server_tag *ap
       self->isUnixServerStarted = false;
       self->tcpConnectionTag = (char*) 0;
       self->unixConnectionTag = (char*) 0;
+#if APX_SOCKET_REACTOR_SUPPORTED
+      self->numReactorThreads = 0u;
+      self->reactor = (apx_socketReactor_t*) 0;
+#endif
+#if APX_SHM_SUPPORTED
+      self->shmServerFile = (char*) 0;
+      self->shmConnectionTag = (char*) 0;
+      self->shmListenFd = -1;
+      self->isShmServerStarted = false;
+#endif
    }
 }
 
@@ -106,6 +135,22 @@ void apx_socketServer_destroy(apx_socketServer_t *self)
       {
          free(self->unixConnectionTag);
       }
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->reactor != 0)
+      {
+         apx_socketReactor_delete(self->reactor);
+      }
+#endif
+#if APX_SHM_SUPPORTED
+      if (self->shmServerFile != 0)
+      {
+         free(self->shmServerFile);
+      }
+      if (self->shmConnectionTag != 0)
+      {
+         free(self->shmConnectionTag);
+      }
+#endif
    }
 }
 
@@ -128,6 +173,29 @@ void apx_socketServer_delete(apx_socketServer_t *self)
    }
 }
 
+#if APX_SOCKET_REACTOR_SUPPORTED
+/**
+ * Selects reactor mode when numThreads > 0. In reactor mode all client sockets are multiplexed over numThreads epoll threads
+ * instead of getting one receive thread each. Must be called before the first server is started.
+ */
+void apx_socketServer_setReactorThreads(apx_socketServer_t *self, uint32_t numThreads)
+{
+   if ( (self != 0) && (self->reactor == 0) )
+   {
+      self->numReactorThreads = (numThreads > APX_SOCKET_REACTOR_MAX_THREADS)? APX_SOCKET_REACTOR_MAX_THREADS : numThreads;
+   }
+}
+
+uint32_t apx_socketServer_getReactorThreads(apx_socketServer_t *self)
+{
+   if (self != 0)
+   {
+      return self->numReactorThreads;
+   }
+   return 0u;
+}
+#endif
+
 void apx_socketServer_startTcpServer(apx_socketServer_t *self, uint16_t tcpPort, const char *tag)
 {
    if (self != 0)
@@ -139,6 +207,26 @@ void apx_socketServer_startTcpServer(apx_socketServer_t *self, uint16_t tcpPort,
       {
          self->tcpConnectionTag = STRDUP(tag);
       }
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->numReactorThreads > 0u)
+      {
+         apx_error_t result = apx_socketServer_prepareReactor(self);
+         if (result == APX_NO_ERROR)
+         {
+            result = apx_socketReactor_listenTcp(self->reactor, self->tcpPort, apx_socketServer_reactorTcpAccept, self);
+         }
+         if (result == APX_NO_ERROR)
+         {
+            self->isTcpServerStarted = true;
+            printf("Listening on TCP port %d (%u reactor threads)\n", (int) self->tcpPort, (unsigned int) self->numReactorThreads);
+         }
+         else
+         {
+            printf("Failed to listen on TCP port %d (%d)\n", (int) self->tcpPort, (int) result);
+         }
+         return;
+      }
+#endif
       memset(&serverHandler,0,sizeof(serverHandler));
 #ifndef UNIT_TEST
       serverHandler.tcp_accept = apx_socketServer_tcpAccept;
@@ -167,6 +255,26 @@ void apx_socketServer_startUnixServer(apx_socketServer_t *self, const char *file
       {
          self->unixConnectionTag = STRDUP(tag);
       }
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->numReactorThreads > 0u)
+      {
+         apx_error_t result = apx_socketServer_prepareReactor(self);
+         if (result == APX_NO_ERROR)
+         {
+            result = apx_socketReactor_listenUnix(self->reactor, self->unixServerFile, apx_socketServer_reactorUnixAccept, self);
+         }
+         if (result == APX_NO_ERROR)
+         {
+            self->isUnixServerStarted = true;
+            printf("Listening on UNIX socket %s (%u reactor threads)\n", self->unixServerFile, (unsigned int) self->numReactorThreads);
+         }
+         else
+         {
+            printf("Failed to listen on UNIX socket %s (%d)\n", self->unixServerFile, (int) result);
+         }
+         return;
+      }
+#endif
       memset(&serverHandler,0,sizeof(serverHandler));
 #ifndef UNIT_TEST
       serverHandler.tcp_accept = apx_socketServer_unixAccept;
@@ -183,6 +291,79 @@ void apx_socketServer_startUnixServer(apx_socketServer_t *self, const char *file
 }
 #endif
 
+#if APX_SHM_SUPPORTED
+/**
+ * Listens for same-host clients on a unix domain socket. Each accepted client is handed a private shared-memory region
+ * (see apx_shmChannel) and the socket itself is only kept open to detect when either side goes away.
+ */
+void apx_socketServer_startShmServer(apx_socketServer_t *self, const char *filePath, const char *tag)
+{
+   if ( (self != 0) && (filePath != 0) && (!self->isShmServerStarted) )
+   {
+      struct sockaddr_un addr;
+      int fd;
+      if (strlen(filePath) >= sizeof(addr.sun_path))
+      {
+         printf("Shared memory socket path is too long: %s\n", filePath);
+         return;
+      }
+      if (self->shmServerFile != 0)
+      {
+         free(self->shmServerFile);
+      }
+      self->shmServerFile = STRDUP(filePath);
+      if (tag != 0)
+      {
+         if (self->shmConnectionTag != 0)
+         {
+            free(self->shmConnectionTag);
+         }
+         self->shmConnectionTag = STRDUP(tag);
+      }
+      memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      strcpy(addr.sun_path, filePath);
+      unlink(filePath);
+      fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+      {
+         printf("Failed to create shared memory socket (%d)\n", errno);
+         return;
+      }
+      if ( (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) || (listen(fd, SOMAXCONN) != 0) )
+      {
+         printf("Failed to listen on shared memory socket %s (%d)\n", filePath, errno);
+         close(fd);
+         return;
+      }
+      self->shmListenFd = fd;
+      if (THREAD_CREATE(self->shmAcceptThread, apx_socketServer_shmAcceptTask, self) != 0)
+      {
+         printf("Failed to create shared memory accept thread\n");
+         close(fd);
+         self->shmListenFd = -1;
+         return;
+      }
+      self->isShmServerStarted = true;
+      printf("Listening on shared memory socket %s\n", self->shmServerFile);
+   }
+}
+
+void apx_socketServer_stopShmServer(apx_socketServer_t *self)
+{
+   if ( (self != 0) && (self->isShmServerStarted) )
+   {
+      void *status;
+      shutdown(self->shmListenFd, SHUT_RDWR); //wakes up the accept thread
+      pthread_join(self->shmAcceptThread, &status);
+      close(self->shmListenFd);
+      self->shmListenFd = -1;
+      unlink(self->shmServerFile);
+      self->isShmServerStarted = false;
+   }
+}
+#endif
+
 void apx_socketServer_stopAll(apx_socketServer_t *self)
 {
    if (self != 0)
@@ -190,6 +371,9 @@ void apx_socketServer_stopAll(apx_socketServer_t *self)
       apx_socketServer_stopTcpServer(self);
 #ifndef _WIN32
       apx_socketServer_stopUnixServer(self);
+#endif
+#if APX_SHM_SUPPORTED
+      apx_socketServer_stopShmServer(self);
 #endif
    }
 }
@@ -198,7 +382,16 @@ void apx_socketServer_stopTcpServer(apx_socketServer_t *self)
 {
    if ( (self != 0) && (self->isTcpServerStarted) )
    {
-      msocket_server_destroy(&self->tcpServer);
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->reactor != 0)
+      {
+         apx_socketReactor_closeTcpListener(self->reactor);
+      }
+      else
+#endif
+      {
+         msocket_server_destroy(&self->tcpServer);
+      }
       self->isTcpServerStarted = false;
    }
 }
@@ -208,9 +401,18 @@ void apx_socketServer_stopUnixServer(apx_socketServer_t *self)
 {
    if ( (self != 0) && (self->isUnixServerStarted) )
    {
+#if APX_SOCKET_REACTOR_SUPPORTED
+      if (self->reactor != 0)
+      {
+         apx_socketReactor_closeUnixListener(self->reactor);
+      }
+      else
+#endif
+      {
 #ifndef _MSC_VER
-      msocket_server_destroy(&self->unixServer);
+         msocket_server_destroy(&self->unixServer);
 #endif
+      }
       self->isUnixServerStarted = false;
    }
 }
@@ -236,9 +438,9 @@ static void apx_socketServer_tcpAccept(void *arg, struct msocket_server_tag *srv
    if (self != 0)
    {
       apx_serverSocketConnection_t *newConnection = apx_serverSocketConnection_new(sock);
-      ///TODO: Add support for connection tag
       if (newConnection != 0)
       {
+         apx_serverConnectionBase_setTag((apx_serverConnectionBase_t*) newConnection, self->tcpConnectionTag);
          apx_server_acceptConnection(self->parent, (apx_serverConnectionBase_t*) newConnection);
       }
       else
@@ -259,9 +461,9 @@ static void apx_socketServer_unixAccept(void *arg, struct msocket_server_tag *sr
    if (self != 0)
    {
       apx_serverSocketConnection_t *newConnection = apx_serverSocketConnection_new(sock);
-      ///TODO: Add support for connection tag
       if (newConnection != 0)
       {
+         apx_serverConnectionBase_setTag((apx_serverConnectionBase_t*) newConnection, self->unixConnectionTag);
          apx_server_acceptConnection(self->parent, (apx_serverConnectionBase_t*) newConnection);
       }
       else
@@ -273,3 +475,101 @@ static void apx_socketServer_unixAccept(void *arg, struct msocket_server_tag *sr
 }
 #endif
 
+#if APX_SOCKET_REACTOR_SUPPORTED
+static apx_error_t apx_socketServer_prepareReactor(apx_socketServer_t *self)
+{
+   if (self->reactor == 0)
+   {
+      apx_error_t result;
+      self->reactor = apx_socketReactor_new(self->numReactorThreads);
+      if (self->reactor == 0)
+      {
+         return APX_MEM_ERROR;
+      }
+      result = apx_socketReactor_start(self->reactor);
+      if (result != APX_NO_ERROR)
+      {
+         apx_socketReactor_delete(self->reactor);
+         self->reactor = (apx_socketReactor_t*) 0;
+         return result;
+      }
+   }
+   return APX_NO_ERROR;
+}
+
+static void apx_socketServer_reactorTcpAccept(void *arg, apx_reactorSocket_t *sock)
+{
+   apx_socketServer_t *self = (apx_socketServer_t*) arg;
+   apx_socketServer_reactorAccept(self, sock, (self != 0)? self->tcpConnectionTag : (const char*) 0);
+}
+
+#ifndef _WIN32
+static void apx_socketServer_reactorUnixAccept(void *arg, apx_reactorSocket_t *sock)
+{
+   apx_socketServer_t *self = (apx_socketServer_t*) arg;
+   apx_socketServer_reactorAccept(self, sock, (self != 0)? self->unixConnectionTag : (const char*) 0);
+}
+#endif
+
+static void apx_socketServer_reactorAccept(apx_socketServer_t *self, apx_reactorSocket_t *sock, const char *tag)
+{
+#if APX_DEBUG_ENABLE
+   printf("[SOCKET-SERVER] New reactor connection\n");
+#endif
+   if (self != 0)
+   {
+      apx_serverSocketConnection_t *newConnection = apx_serverSocketConnection_newFromReactor(sock);
+      if (newConnection != 0)
+      {
+         apx_serverConnectionBase_setTag((apx_serverConnectionBase_t*) newConnection, tag);
+         apx_server_acceptConnection(self->parent, (apx_serverConnectionBase_t*) newConnection);
+      }
+      else
+      {
+         apx_reactorSocket_delete(sock);
+      }
+   }
+}
+#endif
+
+#if APX_SHM_SUPPORTED
+static THREAD_PROTO(apx_socketServer_shmAcceptTask, arg)
+{
+   apx_socketServer_t *self = (apx_socketServer_t*) arg;
+   if (self != 0)
+   {
+      for (;;)
+      {
+         int fd = accept(self->shmListenFd, (struct sockaddr*) 0, (socklen_t*) 0);
+         if (fd < 0)
+         {
+            if ( (errno == EINTR) || (errno == ECONNABORTED) )
+            {
+               continue;
+            }
+            break; //listener was shut down
+         }
+         apx_socketServer_shmAccept(self, fd);
+      }
+   }
+   THREAD_RETURN(0);
+}
+
+static void apx_socketServer_shmAccept(apx_socketServer_t *self, int sockFd)
+{
+   apx_serverShmConnection_t *newConnection;
+#if APX_DEBUG_ENABLE
+   printf("[SOCKET-SERVER] New shared memory connection\n");
+#endif
+   newConnection = apx_serverShmConnection_new(sockFd);
+   if (newConnection != 0)
+   {
+      apx_serverConnectionBase_setTag((apx_serverConnectionBase_t*) newConnection, self->shmConnectionTag);
+      apx_server_acceptConnection(self->parent, (apx_serverConnectionBase_t*) newConnection);
+   }
+   else
+   {
+      close(sockFd);
+   }
+}
+#endif
@@ -118,6 +118,13 @@ static apx_error_t apx_socketServerExtension_configure(apx_socketServer_t *serve
 #endif
    dtl_sv_t *svTcpTag;
    dtl_sv_t *svUnixTag;
+#if APX_SOCKET_REACTOR_SUPPORTED
+   dtl_sv_t *svReactorThreads;
+#endif
+#if APX_SHM_SUPPORTED
+   dtl_sv_t *svShmFile;
+   dtl_sv_t *svShmTag;
+#endif
    bool conversionOk;
    svTcpPort = (dtl_sv_t*) dtl_hv_get_cstr(cfg, "tcp-port");
 #ifndef _WIN32
@@ -125,6 +132,21 @@ static apx_error_t apx_socketServerExtension_configure(apx_socketServer_t *serve
 #endif
    svTcpTag = (dtl_sv_t*) dtl_hv_get_cstr(cfg, "tcp-tag");
    svUnixTag = (dtl_sv_t*) dtl_hv_get_cstr(cfg, "unix-tag");
+#if APX_SHM_SUPPORTED
+   svShmFile = (dtl_sv_t*) dtl_hv_get_cstr(cfg, "shm-file");
+   svShmTag = (dtl_sv_t*) dtl_hv_get_cstr(cfg, "shm-tag");
+#endif
+#if APX_SOCKET_REACTOR_SUPPORTED
+   svReactorThreads = (dtl_sv_t*) dtl_hv_get_cstr(cfg, "reactor-threads");
+   if (svReactorThreads != 0)
+   {
+      uint32_t numThreads = dtl_sv_to_u32(svReactorThreads, &conversionOk);
+      if (conversionOk)
+      {
+         apx_socketServer_setReactorThreads(m_instance, numThreads);
+      }
+   }
+#endif
    if (svTcpPort != 0)
    {
       uint16_t tcpPort = (uint16_t) dtl_sv_to_u32(svTcpPort, &conversionOk);
@@ -152,6 +174,21 @@ static apx_error_t apx_socketServerExtension_configure(apx_socketServer_t *serve
          apx_socketServer_startUnixServer(m_instance, unixFilePath, tag);
       }
    }
+#endif
+#if APX_SHM_SUPPORTED
+   if (svShmFile != 0)
+   {
+      const char *shmFilePath = dtl_sv_to_cstr(svShmFile);
+      if (strlen(shmFilePath) > 0)
+      {
+         const char *tag = "";
+         if (svShmTag != 0)
+         {
+            tag = dtl_sv_to_cstr(svShmTag);
+         }
+         apx_socketServer_startShmServer(m_instance, shmFilePath, tag);
+      }
+   }
 #endif
    return APX_NO_ERROR;
 }
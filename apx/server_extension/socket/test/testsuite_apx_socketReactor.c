@@ -0,0 +1,374 @@
+/*****************************************************************************
+* \file      testsuite_apx_socketReactor.c
+* \author    agent
+* \date      2026-10-18
+* \brief     Unit tests for apx_socketReactor
+*
+* Copyright (c) 2026 agent
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+//////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+//////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+#include <stdlib.h>
+#include "CuTest.h"
+#include "apx_socketReactor.h"
+#if APX_SOCKET_REACTOR_SUPPORTED
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+#ifdef MEM_LEAK_CHECK
+#include "CMemLeak.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE CONSTANTS AND DATA TYPES
+//////////////////////////////////////////////////////////////////////////////
+#if APX_SOCKET_REACTOR_SUPPORTED
+#define RECORD_SIZE 4u
+#define LARGE_DATA_SIZE (1024u*1024u)
+#define CHUNK_SIZE (16u*1024u)
+#define MAX_PENDING_SEND (64u*1024u)
+#define WAIT_TIMEOUT_MS 2000
+#define UNIX_SOCKET_PATH "/tmp/apx_socketReactor_test.socket"
+
+typedef struct reactorTestContext_tag
+{
+   volatile uint32_t numBytesReceived;
+   volatile uint32_t numRecords;
+   volatile uint32_t numDisconnects;
+   volatile uint32_t numAccepted;
+   apx_reactorSocket_t * volatile acceptedSocket;
+} reactorTestContext_t;
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////////
+#if APX_SOCKET_REACTOR_SUPPORTED
+static void test_apx_socketReactor_receiveRecords(CuTest* tc);
+static void test_apx_socketReactor_sendLargeData(CuTest* tc);
+static void test_apx_socketReactor_pendingSendLimit(CuTest* tc);
+static void test_apx_socketReactor_disconnect(CuTest* tc);
+static void test_apx_socketReactor_acceptUnixConnection(CuTest* tc);
+static void test_apx_socketReactor_deleteWhileRunning(CuTest* tc);
+static int8_t reactorTest_data(void *arg, const uint8_t *dataBuf, uint32_t dataLen, uint32_t *parseLen);
+static void reactorTest_disconnected(void *arg);
+static void reactorTest_accept(void *arg, apx_reactorSocket_t *sock);
+static bool reactorTest_waitFor(volatile uint32_t *value, uint32_t expected);
+static apx_reactorSocket_t *reactorTest_startSocketPair(apx_socketReactor_t *reactor, reactorTestContext_t *context, int *peerFd);
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE VARIABLES
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+CuSuite* testSuite_apx_socketReactor(void)
+{
+   CuSuite* suite = CuSuiteNew();
+#if APX_SOCKET_REACTOR_SUPPORTED
+   SUITE_ADD_TEST(suite, test_apx_socketReactor_receiveRecords);
+   SUITE_ADD_TEST(suite, test_apx_socketReactor_sendLargeData);
+   SUITE_ADD_TEST(suite, test_apx_socketReactor_pendingSendLimit);
+   SUITE_ADD_TEST(suite, test_apx_socketReactor_disconnect);
+   SUITE_ADD_TEST(suite, test_apx_socketReactor_acceptUnixConnection);
+   SUITE_ADD_TEST(suite, test_apx_socketReactor_deleteWhileRunning);
+#endif
+   return suite;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////
+#if APX_SOCKET_REACTOR_SUPPORTED
+static void test_apx_socketReactor_receiveRecords(CuTest* tc)
+{
+   apx_socketReactor_t reactor;
+   reactorTestContext_t context;
+   apx_reactorSocket_t *sock;
+   int peerFd;
+   const uint8_t data[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_create(&reactor, 2));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_start(&reactor));
+   sock = reactorTest_startSocketPair(&reactor, &context, &peerFd);
+   CuAssertPtrNotNull(tc, sock);
+   CuAssertIntEquals(tc, 10, (int) write(peerFd, &data[0], sizeof(data)));
+   CuAssertTrue(tc, reactorTest_waitFor(&context.numBytesReceived, 8u));
+   CuAssertUIntEquals(tc, 2u, context.numRecords);
+   //the remaining 2 bytes stay in the receive buffer until the rest of the record arrives
+   CuAssertIntEquals(tc, 2, (int) write(peerFd, &data[0], 2));
+   CuAssertTrue(tc, reactorTest_waitFor(&context.numBytesReceived, 12u));
+   CuAssertUIntEquals(tc, 3u, context.numRecords);
+   CuAssertUIntEquals(tc, 0u, context.numDisconnects);
+   apx_reactorSocket_delete(sock);
+   close(peerFd);
+   apx_socketReactor_destroy(&reactor);
+}
+
+static void test_apx_socketReactor_sendLargeData(CuTest* tc)
+{
+   apx_socketReactor_t reactor;
+   reactorTestContext_t context;
+   apx_reactorSocket_t *sock;
+   int peerFd;
+   uint8_t *sendData = (uint8_t*) malloc(LARGE_DATA_SIZE);
+   uint8_t *receiveData = (uint8_t*) malloc(LARGE_DATA_SIZE);
+   uint32_t i;
+   uint32_t received = 0u;
+   CuAssertPtrNotNull(tc, sendData);
+   CuAssertPtrNotNull(tc, receiveData);
+   for (i = 0u; i < LARGE_DATA_SIZE; i++)
+   {
+      sendData[i] = (uint8_t) (i * 7u);
+   }
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_create(&reactor, 1));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_start(&reactor));
+   sock = reactorTest_startSocketPair(&reactor, &context, &peerFd);
+   CuAssertPtrNotNull(tc, sock);
+   //much larger than the socket buffer, most of it must be queued and written by the reactor thread
+   CuAssertIntEquals(tc, (int) LARGE_DATA_SIZE, apx_reactorSocket_send(sock, sendData, LARGE_DATA_SIZE));
+   while (received < LARGE_DATA_SIZE)
+   {
+      ssize_t n = read(peerFd, &receiveData[received], LARGE_DATA_SIZE - received);
+      CuAssertTrue(tc, n > 0);
+      received += (uint32_t) n;
+   }
+   CuAssertTrue(tc, memcmp(sendData, receiveData, LARGE_DATA_SIZE) == 0);
+   CuAssertUIntEquals(tc, 0u, apx_reactorSocket_getPendingSendLen(sock));
+   apx_reactorSocket_delete(sock);
+   close(peerFd);
+   apx_socketReactor_destroy(&reactor);
+   free(sendData);
+   free(receiveData);
+}
+
+static void test_apx_socketReactor_pendingSendLimit(CuTest* tc)
+{
+   apx_socketReactor_t reactor;
+   reactorTestContext_t context;
+   apx_reactorSocket_t *sock;
+   int peerFd;
+   uint8_t sendData[CHUNK_SIZE];
+   uint8_t *receiveData = (uint8_t*) malloc(LARGE_DATA_SIZE);
+   uint32_t i;
+   uint32_t numChunks = 0u;
+   uint32_t received = 0u;
+   int32_t result;
+   CuAssertPtrNotNull(tc, receiveData);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_create(&reactor, 1));
+   apx_socketReactor_setMaxPendingSendLen(&reactor, MAX_PENDING_SEND);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_start(&reactor));
+   sock = reactorTest_startSocketPair(&reactor, &context, &peerFd);
+   CuAssertPtrNotNull(tc, sock);
+   //peer does not read, sends are refused once the pending data reaches the limit
+   do
+   {
+      for (i = 0u; i < CHUNK_SIZE; i++)
+      {
+         sendData[i] = (uint8_t) (numChunks + i);
+      }
+      result = apx_reactorSocket_send(sock, sendData, CHUNK_SIZE);
+      if (result == (int32_t) CHUNK_SIZE)
+      {
+         numChunks++;
+      }
+   } while ( (result == (int32_t) CHUNK_SIZE) && ( (numChunks * CHUNK_SIZE) < LARGE_DATA_SIZE) );
+   CuAssertIntEquals(tc, APX_REACTOR_SOCKET_WOULD_BLOCK, result);
+   CuAssertTrue(tc, apx_reactorSocket_getPendingSendLen(sock) <= MAX_PENDING_SEND);
+   CuAssertTrue(tc, apx_reactorSocket_getPendingSendLen(sock) > (MAX_PENDING_SEND - CHUNK_SIZE));
+   //refused data was not sent at all, the peer receives every accepted chunk intact and in order
+   while (received < (numChunks * CHUNK_SIZE))
+   {
+      ssize_t n = read(peerFd, &receiveData[received], (numChunks * CHUNK_SIZE) - received);
+      CuAssertTrue(tc, n > 0);
+      received += (uint32_t) n;
+   }
+   for (i = 0u; i < received; i++)
+   {
+      if (receiveData[i] != (uint8_t) ((i / CHUNK_SIZE) + (i % CHUNK_SIZE)))
+      {
+         break;
+      }
+   }
+   CuAssertUIntEquals(tc, received, i);
+   for (i = 0u; (i < WAIT_TIMEOUT_MS) && (apx_reactorSocket_getPendingSendLen(sock) > 0u); i++)
+   {
+      usleep(1000);
+   }
+   CuAssertUIntEquals(tc, 0u, apx_reactorSocket_getPendingSendLen(sock));
+   CuAssertIntEquals(tc, (int) CHUNK_SIZE, apx_reactorSocket_send(sock, sendData, CHUNK_SIZE));
+   apx_reactorSocket_delete(sock);
+   close(peerFd);
+   apx_socketReactor_destroy(&reactor);
+   free(receiveData);
+}
+
+static void test_apx_socketReactor_disconnect(CuTest* tc)
+{
+   apx_socketReactor_t reactor;
+   reactorTestContext_t context;
+   apx_reactorSocket_t *sock;
+   int peerFd;
+   const uint8_t data[4] = {1, 2, 3, 4};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_create(&reactor, 2));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_start(&reactor));
+   sock = reactorTest_startSocketPair(&reactor, &context, &peerFd);
+   CuAssertPtrNotNull(tc, sock);
+   close(peerFd);
+   CuAssertTrue(tc, reactorTest_waitFor(&context.numDisconnects, 1u));
+   CuAssertIntEquals(tc, -1, apx_reactorSocket_send(sock, &data[0], sizeof(data)));
+   apx_reactorSocket_delete(sock);
+   CuAssertUIntEquals(tc, 1u, context.numDisconnects);
+   apx_socketReactor_destroy(&reactor);
+}
+
+static void test_apx_socketReactor_acceptUnixConnection(CuTest* tc)
+{
+   apx_socketReactor_t reactor;
+   reactorTestContext_t context;
+   struct sockaddr_un addr;
+   apx_reactorSocketHandler_t handler = {reactorTest_data, reactorTest_disconnected};
+   const uint8_t data[4] = {1, 2, 3, 4};
+   int clientFd;
+   memset(&context, 0, sizeof(context));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_create(&reactor, 2));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_start(&reactor));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_listenUnix(&reactor, UNIX_SOCKET_PATH, reactorTest_accept, &context));
+   CuAssertIntEquals(tc, APX_INVALID_STATE_ERROR, apx_socketReactor_listenUnix(&reactor, UNIX_SOCKET_PATH, reactorTest_accept, &context));
+   clientFd = socket(AF_UNIX, SOCK_STREAM, 0);
+   CuAssertTrue(tc, clientFd >= 0);
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   strcpy(addr.sun_path, UNIX_SOCKET_PATH);
+   CuAssertIntEquals(tc, 0, connect(clientFd, (struct sockaddr*) &addr, sizeof(addr)));
+   CuAssertTrue(tc, reactorTest_waitFor(&context.numAccepted, 1u));
+   CuAssertPtrNotNull(tc, context.acceptedSocket);
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_reactorSocket_start(context.acceptedSocket, &handler, &context));
+   CuAssertIntEquals(tc, 4, (int) write(clientFd, &data[0], sizeof(data)));
+   CuAssertTrue(tc, reactorTest_waitFor(&context.numRecords, 1u));
+   apx_reactorSocket_close(context.acceptedSocket);
+   CuAssertTrue(tc, reactorTest_waitFor(&context.numDisconnects, 1u));
+   apx_reactorSocket_delete(context.acceptedSocket);
+   close(clientFd);
+   apx_socketReactor_destroy(&reactor);
+   CuAssertIntEquals(tc, -1, access(UNIX_SOCKET_PATH, F_OK));
+}
+
+static void test_apx_socketReactor_deleteWhileRunning(CuTest* tc)
+{
+   apx_socketReactor_t reactor;
+   reactorTestContext_t context;
+   apx_reactorSocket_t *sock;
+   int peerFd;
+   int i;
+   const uint8_t data[4] = {1, 2, 3, 4};
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_create(&reactor, 1));
+   CuAssertIntEquals(tc, APX_NO_ERROR, apx_socketReactor_start(&reactor));
+   sock = reactorTest_startSocketPair(&reactor, &context, &peerFd);
+   CuAssertPtrNotNull(tc, sock);
+   for (i = 0; i < 100; i++)
+   {
+      CuAssertIntEquals(tc, 4, (int) write(peerFd, &data[0], sizeof(data)));
+   }
+   apx_reactorSocket_delete(sock);
+   //no callbacks are allowed after delete has returned
+   i = (int) context.numRecords;
+   close(peerFd);
+   usleep(10000);
+   CuAssertIntEquals(tc, i, (int) context.numRecords);
+   CuAssertUIntEquals(tc, 0u, context.numDisconnects);
+   apx_socketReactor_destroy(&reactor);
+}
+
+static int8_t reactorTest_data(void *arg, const uint8_t *dataBuf, uint32_t dataLen, uint32_t *parseLen)
+{
+   reactorTestContext_t *context = (reactorTestContext_t*) arg;
+   (void) dataBuf;
+   if (dataLen >= RECORD_SIZE)
+   {
+      *parseLen = RECORD_SIZE;
+      __atomic_fetch_add(&context->numRecords, 1u, __ATOMIC_RELEASE);
+      __atomic_fetch_add(&context->numBytesReceived, RECORD_SIZE, __ATOMIC_RELEASE);
+   }
+   else
+   {
+      *parseLen = 0u;
+   }
+   return 0;
+}
+
+static void reactorTest_disconnected(void *arg)
+{
+   reactorTestContext_t *context = (reactorTestContext_t*) arg;
+   __atomic_fetch_add(&context->numDisconnects, 1u, __ATOMIC_RELEASE);
+}
+
+static void reactorTest_accept(void *arg, apx_reactorSocket_t *sock)
+{
+   reactorTestContext_t *context = (reactorTestContext_t*) arg;
+   context->acceptedSocket = sock;
+   __atomic_fetch_add(&context->numAccepted, 1u, __ATOMIC_RELEASE);
+}
+
+static bool reactorTest_waitFor(volatile uint32_t *value, uint32_t expected)
+{
+   int elapsed;
+   for (elapsed = 0; elapsed < WAIT_TIMEOUT_MS; elapsed++)
+   {
+      if (__atomic_load_n(value, __ATOMIC_ACQUIRE) >= expected)
+      {
+         return true;
+      }
+      usleep(1000);
+   }
+   return false;
+}
+
+static apx_reactorSocket_t *reactorTest_startSocketPair(apx_socketReactor_t *reactor, reactorTestContext_t *context, int *peerFd)
+{
+   int fds[2];
+   apx_reactorSocket_t *sock;
+   apx_reactorSocketHandler_t handler = {reactorTest_data, reactorTest_disconnected};
+   memset(context, 0, sizeof(reactorTestContext_t));
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+   {
+      return (apx_reactorSocket_t*) 0;
+   }
+   sock = apx_socketReactor_adoptSocket(reactor, fds[0]);
+   if (sock == 0)
+   {
+      close(fds[0]);
+      close(fds[1]);
+      return (apx_reactorSocket_t*) 0;
+   }
+   if (apx_reactorSocket_start(sock, &handler, context) != APX_NO_ERROR)
+   {
+      apx_reactorSocket_delete(sock);
+      close(fds[1]);
+      return (apx_reactorSocket_t*) 0;
+   }
+   *peerFd = fds[1];
+   return sock;
+}
+#endif
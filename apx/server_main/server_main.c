@@ -66,6 +66,9 @@ int m_runFlag = 1;
 //////////////////////////////////////////////////////////////////////////////
 static apx_server_t m_server;
 static int32_t m_shutdownTimer;
+static int32_t m_dataPlaneThreads;
+static bool m_dataPlanePinThreads;
+static const char *m_nodeImageDirectory;
 static const char *SW_VERSION_STR = SW_VERSION_LITERAL;
 //////////////////////////////////////////////////////////////////////////////
 // GLOBAL FUNCTIONS
@@ -76,6 +79,9 @@ int main(int argc, char **argv)
    dtl_hv_t *server_config = (dtl_hv_t*) 0;
 
    m_shutdownTimer = SHUTDOWN_TIMER_INIT;
+   m_dataPlaneThreads = 0;
+   m_dataPlanePinThreads = false;
+   m_nodeImageDirectory = (const char*) 0;
    g_debug = 0;
    m_runFlag = 1;
 
@@ -110,6 +116,25 @@ int main(int argc, char **argv)
                m_shutdownTimer = i32;
             }
          }
+         dtl_sv_t *svDataPlaneThreads = (dtl_sv_t*) dtl_hv_get_cstr(serverCfg, "data-plane-threads");
+         if (svDataPlaneThreads != 0)
+         {
+            i32 = dtl_sv_to_i32(svDataPlaneThreads, &ok);
+            if (ok)
+            {
+               m_dataPlaneThreads = i32;
+            }
+         }
+         dtl_sv_t *svDataPlanePinThreads = (dtl_sv_t*) dtl_hv_get_cstr(serverCfg, "data-plane-pin-threads");
+         if (svDataPlanePinThreads != 0)
+         {
+            m_dataPlanePinThreads = dtl_sv_to_bool(svDataPlanePinThreads);
+         }
+         dtl_sv_t *svNodeImageDir = (dtl_sv_t*) dtl_hv_get_cstr(serverCfg, "node-image-dir");
+         if (svNodeImageDir != 0)
+         {
+            m_nodeImageDirectory = dtl_sv_to_cstr(svNodeImageDir);
+         }
       }
    }
 
@@ -124,6 +149,22 @@ int main(int argc, char **argv)
    signal_handler_setup();
 #endif
    apx_server_create(&m_server);
+   if (m_dataPlaneThreads != 0)
+   {
+      result = apx_server_setDataPlaneConfig(&m_server, m_dataPlaneThreads, m_dataPlanePinThreads);
+      if (result != APX_NO_ERROR)
+      {
+         fprintf(stderr, "Failed to create data plane: error %d\n", (int) result);
+      }
+   }
+   if ( (m_nodeImageDirectory != 0) && (strlen(m_nodeImageDirectory) > 0) )
+   {
+      result = apx_server_setNodeImageDirectory(&m_server, m_nodeImageDirectory);
+      if (result != APX_NO_ERROR)
+      {
+         fprintf(stderr, "Failed to set node image directory: error %d\n", (int) result);
+      }
+   }
    if (server_config != 0)
    {
       dtl_dv_t *extension_config = (dtl_dv_t*) 0;